@@ -24,6 +24,7 @@ DBIN_TILER = join(BUILD_ROOT, "Debug-x86_64/tools/grc/grc-tiler")
 DBIN_GRC_IN_MEMORY = join(BUILD_ROOT, "Debug-x86_64/tools/grc/grc-in-memory")
 DBIN_RMAT_TILER = join(BUILD_ROOT, "Debug-x86_64/tools/grc/grc-rmat-tiler")
 DBIN_RMAT_GENERATOR = join(BUILD_ROOT, "Debug-x86_64/tools/grc/grc-rmat-generator")
+DBIN_RMAT_STREAM_TILER = join(BUILD_ROOT, "Debug-x86_64/tools/grc/grc-rmat-stream-tiler")
 DBIN_TILE_INDEXER = join(BUILD_ROOT, "Debug-x86_64/tools/post-grc/post-grc-indexer")
 DBIN_EDGE_ENGINE = join(BUILD_ROOT, "Debug-x86_64/lib/core/edge-engine")
 DBIN_VERTEX_ENGINE = join(BUILD_ROOT, "Debug-x86_64/lib/core/vertex-engine")
@@ -34,6 +35,7 @@ RBIN_TILER = join(BUILD_ROOT, "Release-x86_64/tools/grc/grc-tiler")
 RBIN_GRC_IN_MEMORY = join(BUILD_ROOT, "Release-x86_64/tools/grc/grc-in-memory")
 RBIN_RMAT_TILER = join(BUILD_ROOT, "Release-x86_64/tools/grc/grc-rmat-tiler")
 RBIN_RMAT_GENERATOR = join(BUILD_ROOT, "Release-x86_64/tools/grc/grc-rmat-generator")
+RBIN_RMAT_STREAM_TILER = join(BUILD_ROOT, "Release-x86_64/tools/grc/grc-rmat-stream-tiler")
 RBIN_TILE_INDEXER = join(BUILD_ROOT, "Release-x86_64/tools/post-grc/post-grc-indexer")
 RBIN_EDGE_ENGINE = join(BUILD_ROOT, "Release-x86_64/lib/core/edge-engine")
 RBIN_VERTEX_ENGINE = join(BUILD_ROOT, "Release-x86_64/lib/core/vertex-engine")
@@ -134,6 +136,8 @@ SG_GRC_RMAT_RUN_ON_MIC = True
 SG_GRC_RMAT_GEN_THREADS = 228
 SG_GRC_RMAT_TILER_DEGREES_NPARTITION_MANAGERS = 16
 SG_GRC_RMAT_TILER_TILING_NPARTITION_MANAGERS = 16
+SG_GRC_RMAT_STREAM = False                          # Use the host-only streaming tiler instead of generator + tiler.
+SG_GRC_RMAT_STREAM_MAX_EDGES_PER_ROUND = 1 << 30    # Edges buffered per tiling round of the streaming tiler.
 
 # input
 SG_ORIG_DATA_PATH = DATA_ROOT
@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+#include <util/util.h>
+#include <string.h>
+
+#include "micro-benchmark.h"
+
+namespace util = scalable_graphs::util;
+namespace core = scalable_graphs::core;
+
+// The bool arrays the engines keep per vertex and per tile, over count bits.
+static void BM_SetBoolArraySequential(benchmark::State& state) {
+  uint64_t count = state.range(0);
+  char* array = new char[(size_t)size_bool_array(count)]();
+
+  for (auto _ : state) {
+    for (uint64_t i = 0; i < count; ++i) {
+      set_bool_array(array, i, i & 1);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  delete[] array;
+}
+BENCHMARK(BM_SetBoolArraySequential)
+    ->RangeMultiplier(16)
+    ->Range(1 << 16, 1 << 24);
+
+static void BM_SetBoolArrayRandom(benchmark::State& state) {
+  uint64_t count = state.range(0);
+  char* array = new char[(size_t)size_bool_array(count)]();
+  uint32_t* ids = new uint32_t[count];
+  for (uint64_t i = 0; i < count; ++i) {
+    ids[i] = core::benchmarkVertexId(i, count);
+  }
+
+  for (auto _ : state) {
+    for (uint64_t i = 0; i < count; ++i) {
+      set_bool_array(array, ids[i], true);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  delete[] ids;
+  delete[] array;
+}
+BENCHMARK(BM_SetBoolArrayRandom)
+    ->RangeMultiplier(16)
+    ->Range(1 << 16, 1 << 24);
+
+static void BM_EvalBoolArrayRandom(benchmark::State& state) {
+  uint64_t count = state.range(0);
+  size_t size = size_bool_array(count);
+  char* array = new char[size];
+  memset(array, 0x55, size);
+  uint32_t* ids = new uint32_t[count];
+  for (uint64_t i = 0; i < count; ++i) {
+    ids[i] = core::benchmarkVertexId(i, count);
+  }
+
+  for (auto _ : state) {
+    uint64_t count_set = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+      count_set += eval_bool_array(array, ids[i]);
+    }
+    benchmark::DoNotOptimize(count_set);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  delete[] ids;
+  delete[] array;
+}
+BENCHMARK(BM_EvalBoolArrayRandom)
+    ->RangeMultiplier(16)
+    ->Range(1 << 16, 1 << 24);
+
+static void BM_CountBoolArray(benchmark::State& state) {
+  uint64_t count = state.range(0);
+  size_t size = size_bool_array(count);
+  char* array = new char[size];
+  memset(array, 0x55, size);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(util::countBoolArray(array, size));
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+  delete[] array;
+}
+BENCHMARK(BM_CountBoolArray)
+    ->RangeMultiplier(16)
+    ->Range(1 << 16, 1 << 24);
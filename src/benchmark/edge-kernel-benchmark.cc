@@ -0,0 +1,127 @@
+#include <benchmark/benchmark.h>
+#include <core/tile-processor.h>
+#include <core/edge-processor.h>
+#include "../lib/core/algorithms/pagerank.h"
+#include <core/datatypes.h>
+
+#include "micro-benchmark.h"
+
+namespace scalable_graphs {
+namespace core {
+  // Targets of the synthetic tiles, the density is the count of edges per
+  // target, i.e. the length of the runs of the RLE-encoded target block.
+  static const uint32_t kCountTargets = 16384;
+
+  static const uint32_t kCountSources = MAX_VERTICES_PER_TILE;
+
+  // A tile of kCountTargets * density edges, sorted by target like the tiles
+  // written by the grc, with pseudo-random sources.
+  class SyntheticTile {
+  public:
+    SyntheticTile(uint32_t density, bool is_rle)
+        : count_edges_(kCountTargets * density) {
+      size_t size_src_block = sizeof(local_vertex_id_t) * count_edges_;
+      size_t size_tgt_block =
+          is_rle ? sizeof(vertex_count_t) * kCountTargets
+                 : sizeof(local_vertex_id_t) * count_edges_;
+      edge_block_ = (edge_block_t*)malloc(sizeof(edge_block_t) +
+                                          size_src_block + size_tgt_block);
+      edge_block_->offset_src = sizeof(edge_block_t);
+      edge_block_->offset_tgt = edge_block_->offset_src + size_src_block;
+
+      local_vertex_id_t* src_block =
+          get_array(local_vertex_id_t*, edge_block_, edge_block_->offset_src);
+      for (uint32_t i = 0; i < count_edges_; ++i) {
+        src_block[i] = benchmarkVertexId(i, kCountSources);
+      }
+
+      if (is_rle) {
+        vertex_count_t* tgt_block =
+            get_array(vertex_count_t*, edge_block_, edge_block_->offset_tgt);
+        for (uint32_t i = 0; i < kCountTargets; ++i) {
+          tgt_block[i].id = i;
+          tgt_block[i].count = density;
+        }
+      } else {
+        local_vertex_id_t* tgt_block =
+            get_array(local_vertex_id_t*, edge_block_, edge_block_->offset_tgt);
+        for (uint32_t i = 0; i < count_edges_; ++i) {
+          tgt_block[i] = i / density;
+        }
+      }
+
+      src_degrees_ = new vertex_degree_t[kCountSources];
+      src_vertices_ = new float[kCountSources];
+      for (uint32_t i = 0; i < kCountSources; ++i) {
+        src_degrees_[i].in_degree = 1;
+        src_degrees_[i].out_degree = 1 + i % 16;
+        src_vertices_[i] = 0.15;
+      }
+      tgt_vertices_ = new float[kCountTargets]();
+    }
+
+    ~SyntheticTile() {
+      free(edge_block_);
+      delete[] src_degrees_;
+      delete[] src_vertices_;
+      delete[] tgt_vertices_;
+    }
+
+    template <class TTileProcessor>
+    void attach(TTileProcessor& tile_processor) {
+      MicroBenchmark::setEdgeBlock(tile_processor, edge_block_, src_degrees_,
+                                   src_vertices_, tgt_vertices_);
+    }
+
+    uint32_t count_edges_;
+
+  private:
+    edge_block_t* edge_block_;
+    vertex_degree_t* src_degrees_;
+    float* src_vertices_;
+    float* tgt_vertices_;
+  };
+
+  // The edge engine the tile processors are built against. It is never torn
+  // down, its destructor expects the tiles of a started run.
+  static EdgeProcessor<PageRank, float, false>& edgeProcessor() {
+    static EdgeProcessor<PageRank, float, false>* edge_processor =
+        new EdgeProcessor<PageRank, float, false>(config_edge_processor_t());
+    return *edge_processor;
+  }
+
+  static void BM_ProcessEdgesRangeList(benchmark::State& state) {
+    TileProcessor<PageRank, float, false> tile_processor(edgeProcessor(),
+                                                         thread_index_t());
+    SyntheticTile tile(state.range(0), false);
+    tile.attach(tile_processor);
+
+    for (auto _ : state) {
+      MicroBenchmark::processEdgesRangeList(tile_processor, 0,
+                                            tile.count_edges_);
+    }
+    state.SetItemsProcessed(state.iterations() * tile.count_edges_);
+  }
+  BENCHMARK(BM_ProcessEdgesRangeList)
+      ->ArgName("density")
+      ->RangeMultiplier(4)
+      ->Range(1, 256);
+
+  static void BM_ProcessEdgesRangeRle(benchmark::State& state) {
+    TileProcessor<PageRank, float, false> tile_processor(edgeProcessor(),
+                                                         thread_index_t());
+    SyntheticTile tile(state.range(0), true);
+    tile.attach(tile_processor);
+
+    for (auto _ : state) {
+      MicroBenchmark::processEdgesRangeRle(tile_processor, 0,
+                                           tile.count_edges_);
+    }
+    state.SetItemsProcessed(state.iterations() * tile.count_edges_);
+  }
+  BENCHMARK(BM_ProcessEdgesRangeRle)
+      ->ArgName("density")
+      ->RangeMultiplier(4)
+      ->Range(1, 256);
+}
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <core/datatypes.h>
+#include <util/util.h>
+
+namespace scalable_graphs {
+namespace core {
+  template <class APP, typename TVertexType, bool is_weighted>
+  class TileProcessor;
+
+  template <class APP, typename TVertexType, typename TVertexIdType>
+  class VertexProcessor;
+
+  template <class APP, typename TVertexType, typename TVertexIdType>
+  class VertexReducer;
+
+  template <class APP, typename TVertexType, typename TVertexIdType>
+  class GlobalReducer;
+
+  template <class APP, typename TVertexType, typename TVertexIdType>
+  class VertexFetcher;
+
+  // Drives the private kernels of the engine components on synthetic input,
+  // every component it touches declares it a friend. Only the fields a kernel
+  // reads are set up, the components are never started.
+  class MicroBenchmark {
+  public:
+    template <class APP, typename TVertexType, bool is_weighted>
+    static void
+    setEdgeBlock(TileProcessor<APP, TVertexType, is_weighted>& tile_processor,
+                 edge_block_t* edge_block, vertex_degree_t* src_degrees,
+                 TVertexType* src_vertices, TVertexType* tgt_vertices) {
+      tile_processor.edge_block_ = edge_block;
+      tile_processor.src_degrees_ = src_degrees;
+      tile_processor.src_vertices_ = src_vertices;
+      tile_processor.tgt_vertices_ = tgt_vertices;
+    }
+
+    template <class APP, typename TVertexType, bool is_weighted>
+    static void processEdgesRangeList(
+        TileProcessor<APP, TVertexType, is_weighted>& tile_processor,
+        uint32_t start, uint32_t end) {
+      tile_processor.template process_edges_range_list<false>(start, end);
+    }
+
+    template <class APP, typename TVertexType, bool is_weighted>
+    static void processEdgesRangeRle(
+        TileProcessor<APP, TVertexType, is_weighted>& tile_processor,
+        uint32_t start, uint32_t end) {
+      tile_processor.template process_edges_range_rle<false>(start, end);
+    }
+
+    // The VertexFetcher copies the tile stats of its VertexProcessor in
+    // init().
+    template <class APP, typename TVertexType, typename TVertexIdType>
+    static void setTileStats(
+        VertexProcessor<APP, TVertexType, TVertexIdType>& vertex_processor,
+        tile_stats_t* tile_stats) {
+      vertex_processor.tile_stats_ = tile_stats;
+    }
+
+    // Allocates the fetch requests and the tile block of tile 0.
+    template <class APP, typename TVertexType, typename TVertexIdType>
+    static void
+    initFetcher(VertexFetcher<APP, TVertexType, TVertexIdType>& fetcher) {
+      fetcher.init();
+      fetcher.fill_tile_block_header(0);
+    }
+
+    template <class APP, typename TVertexType, typename TVertexIdType>
+    static void
+    fetchIndices(VertexFetcher<APP, TVertexType, TVertexIdType>& fetcher,
+                 edge_block_index_t* edge_block_index) {
+      fetcher.fetch_indices(edge_block_index, 0);
+    }
+
+    template <class APP, typename TVertexType, typename TVertexIdType>
+    static void
+    fillSourceFields(VertexFetcher<APP, TVertexType, TVertexIdType>& fetcher,
+                     edge_block_index_t* edge_block_index) {
+      fetcher.fill_source_fields(edge_block_index);
+    }
+
+    // Allocates the blocks for the global reducers and hands the reducer the
+    // target vertices of a processed tile.
+    template <class APP, typename TVertexType, typename TVertexIdType>
+    static void
+    initReducer(VertexReducer<APP, TVertexType, TVertexIdType>& reducer,
+                edge_block_index_t* edge_block_index,
+                TVertexType* tgt_vertices) {
+      reducer.preallocate();
+      reducer.response_block_->block_id = 0;
+      reducer.edge_block_index_ = edge_block_index;
+      reducer.tgt_vertices_ = tgt_vertices;
+      reducer.active_vertices_src_next_ = NULL;
+      reducer.active_vertices_tgt_next_ = NULL;
+    }
+
+    template <class APP, typename TVertexType, typename TVertexIdType>
+    static void processTargetVertices(
+        VertexReducer<APP, TVertexType, TVertexIdType>& reducer) {
+      reducer.initPreallocatedBlocks();
+      reducer.processTargetVertices();
+    }
+
+    template <class APP, typename TVertexType, typename TVertexIdType>
+    static void
+    setReduceBlock(GlobalReducer<APP, TVertexType, TVertexIdType>& reducer,
+                   processed_vertex_index_block_t* reduce_block) {
+      reducer.reduce_block_ = reduce_block;
+      reducer.parse_arrays_from_response();
+    }
+
+    template <class APP, typename TVertexType, typename TVertexIdType>
+    static void processTargetVertices(
+        GlobalReducer<APP, TVertexType, TVertexIdType>& reducer) {
+      reducer.process_target_vertices();
+    }
+  };
+
+  // A pseudo-random vertex id in [0, count), the same for the same seed.
+  inline uint32_t benchmarkVertexId(uint32_t seed, uint64_t count) {
+    return util::hash(seed) % count;
+  }
+
+  // Edge block index of count_vertices source and target vertices with
+  // pseudo-random 32 bit ids below count_global_vertices, free() it.
+  inline edge_block_index_t*
+  createEdgeBlockIndex(uint32_t count_vertices,
+                       uint64_t count_global_vertices) {
+    size_t size_index = sizeof(uint32_t) * count_vertices;
+    size_t size_bit_extension = size_bool_array(count_vertices);
+    edge_block_index_t* edge_block_index = (edge_block_index_t*)calloc(
+        1, sizeof(edge_block_index_t) + 2 * size_index +
+               2 * size_bit_extension);
+
+    edge_block_index->count_src_vertices = count_vertices;
+    edge_block_index->count_tgt_vertices = count_vertices;
+    edge_block_index->offset_src_index = sizeof(edge_block_index_t);
+    edge_block_index->offset_tgt_index =
+        edge_block_index->offset_src_index + size_index;
+    edge_block_index->offset_src_index_bit_extension =
+        edge_block_index->offset_tgt_index + size_index;
+    edge_block_index->offset_tgt_index_bit_extension =
+        edge_block_index->offset_src_index_bit_extension + size_bit_extension;
+
+    uint32_t* src_index = get_array(uint32_t*, edge_block_index,
+                                    edge_block_index->offset_src_index);
+    uint32_t* tgt_index = get_array(uint32_t*, edge_block_index,
+                                    edge_block_index->offset_tgt_index);
+    for (uint32_t i = 0; i < count_vertices; ++i) {
+      src_index[i] = benchmarkVertexId(2 * i, count_global_vertices);
+      tgt_index[i] = benchmarkVertexId(2 * i + 1, count_global_vertices);
+    }
+    return edge_block_index;
+  }
+}
+}
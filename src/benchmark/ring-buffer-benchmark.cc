@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+#include <ring_buffer.h>
+#include <util/util.h>
+
+#include <stdint.h>
+
+static const size_t kSizeRingBuffer = 4 * 1024 * 1024;
+
+// Shared by the threads of a run, created and destroyed by thread 0 outside
+// of the timed loop, which the threads enter and leave together.
+static ring_buffer_t* rb_;
+
+static void createRingBuffer(benchmark::State& state, int flags) {
+  if (state.thread_index() == 0 &&
+      ring_buffer_create(kSizeRingBuffer, 64, flags, NULL, NULL, &rb_) != 0) {
+    sg_err("Could not create a ring buffer of %lu bytes\n", kSizeRingBuffer);
+    scalable_graphs::util::die(1);
+  }
+}
+
+static void destroyRingBuffer(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    ring_buffer_destroy(rb_);
+  }
+}
+
+// Every thread puts an element and gets one, all threads contend for both
+// ends of the ring buffer. The argument is the size of an element.
+static void BM_RingBufferPutGet(benchmark::State& state) {
+  size_t size = state.range(0);
+  createRingBuffer(state, RING_BUFFER_BLOCKING);
+
+  ring_buffer_req_t req;
+  for (auto _ : state) {
+    ring_buffer_put_req_init(&req, BLOCKING, size);
+    ring_buffer_put(rb_, &req);
+    ring_buffer_elm_set_ready(rb_, req.data);
+
+    ring_buffer_get_req_init(&req, BLOCKING);
+    ring_buffer_get(rb_, &req);
+    ring_buffer_elm_set_done(rb_, req.data);
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  destroyRingBuffer(state);
+}
+BENCHMARK(BM_RingBufferPutGet)
+    ->ArgName("size")
+    ->Arg(64)
+    ->Arg(4096)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+// Half of the threads put batches of elements, the other half gets them, as
+// the tile readers and tile processors do. The arguments are the size of an
+// element and the count of elements per batch.
+static void runProducersConsumers(benchmark::State& state, int flags) {
+  size_t size = state.range(0);
+  unsigned int batch = state.range(1);
+  createRingBuffer(state, flags);
+
+  ring_buffer_req_t reqs[16];
+  bool is_producer = state.thread_index() % 2 == 0;
+  for (auto _ : state) {
+    if (is_producer) {
+      for (unsigned int i = 0; i < batch; ++i) {
+        ring_buffer_put_req_init(&reqs[i], BLOCKING, size);
+      }
+      ring_buffer_put_batch(rb_, reqs, batch);
+      for (unsigned int i = 0; i < batch; ++i) {
+        ring_buffer_elm_set_ready(rb_, reqs[i].data);
+      }
+    } else {
+      // a batch get returns as soon as one element is ready
+      for (unsigned int count = 0; count < batch;) {
+        ring_buffer_get_req_init(&reqs[0], BLOCKING);
+        int count_got = ring_buffer_get_batch(rb_, reqs, batch - count);
+        for (int i = 0; i < count_got; ++i) {
+          ring_buffer_elm_set_done(rb_, reqs[i].data);
+        }
+        count += count_got;
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * batch);
+
+  destroyRingBuffer(state);
+}
+
+static void BM_RingBufferProducersConsumers(benchmark::State& state) {
+  runProducersConsumers(state, RING_BUFFER_BLOCKING);
+}
+BENCHMARK(BM_RingBufferProducersConsumers)
+    ->ArgNames({"size", "batch"})
+    ->ArgsProduct({{64, 4096}, {1, 16}})
+    ->ThreadRange(2, 16)
+    ->UseRealTime();
+
+// A single producer and consumer, on the lock-free ring buffer for the
+// single-producer single-consumer case.
+static void BM_RingBufferSPSC(benchmark::State& state) {
+  runProducersConsumers(state, RING_BUFFER_BLOCKING | RING_BUFFER_SPSC);
+}
+BENCHMARK(BM_RingBufferSPSC)
+    ->ArgNames({"size", "batch"})
+    ->ArgsProduct({{64, 4096}, {1, 16}})
+    ->Threads(2)
+    ->UseRealTime();
@@ -0,0 +1,193 @@
+#include <benchmark/benchmark.h>
+#include <core/vertex-domain.h>
+#include "../lib/core/algorithms/pagerank.h"
+#include <core/datatypes.h>
+
+#include "micro-benchmark.h"
+
+namespace scalable_graphs {
+namespace core {
+  typedef VertexDomain<PageRank, float, uint32_t> BenchmarkDomain;
+  typedef VertexProcessor<PageRank, float, uint32_t> BenchmarkProcessor;
+
+  // Large enough for the vertex arrays to miss in the last level cache.
+  static const uint64_t kCountVertices = 1ul << 22;
+
+  // The vertex engine the components are built against, with the vertex
+  // arrays of PageRank. It is never torn down, the destructors of the domain
+  // and the processor expect the tiles of a started run.
+  class BenchmarkEngine {
+  public:
+    static BenchmarkEngine& get() {
+      static BenchmarkEngine engine;
+      return engine;
+    }
+
+    config_vertex_domain_t config_;
+    BenchmarkDomain* domain_;
+    BenchmarkProcessor* processor_;
+    vertex_array_t<float> vertices_;
+
+  private:
+    BenchmarkEngine() : config_(config_vertex_domain_t()) {
+      config_.count_vertices = kCountVertices;
+      config_.count_tiles = 1;
+      config_.count_edge_processors = 1;
+      config_.count_vertex_fetchers = 1;
+      config_.count_index_readers = 1;
+      config_.count_global_reducers = 4;
+      config_.count_global_fetchers = 4;
+      config_.is_index_32_bits = true;
+      config_.local_fetcher_mode = LocalFetcherMode::LFM_DirectAccess;
+
+      domain_ = new BenchmarkDomain(config_);
+      processor_ = new BenchmarkProcessor(*domain_, config_, 0, 0);
+
+      tile_stats_t* tile_stats = new tile_stats_t[1];
+      memset(tile_stats, 0, sizeof(tile_stats_t));
+      tile_stats->count_vertex_src = MAX_VERTICES_PER_TILE;
+      tile_stats->count_vertex_tgt = MAX_VERTICES_PER_TILE;
+      MicroBenchmark::setTileStats(*processor_, tile_stats);
+
+      size_t size_active = size_bool_array(kCountVertices);
+      vertices_.count = kCountVertices;
+      vertices_.size_active = size_active;
+      vertices_.degrees = new vertex_degree_t[kCountVertices];
+      vertices_.current = new float[kCountVertices];
+      vertices_.next = new float[kCountVertices];
+      vertices_.active_current = new char[size_active];
+      vertices_.active_next = new char[size_active];
+      vertices_.changed = new char[size_active];
+      vertices_.buckets = NULL;
+      for (uint64_t i = 0; i < kCountVertices; ++i) {
+        vertices_.degrees[i].in_degree = 1;
+        vertices_.degrees[i].out_degree = 1 + i % 16;
+        vertices_.current[i] = 0.15;
+        vertices_.next[i] = 0.;
+      }
+      memset(vertices_.active_current, 0xff, size_active);
+      memset(vertices_.active_next, 0, size_active);
+      memset(vertices_.changed, 0, size_active);
+    }
+  };
+
+  static void BM_VertexFetcherFetchIndices(benchmark::State& state) {
+    BenchmarkEngine& engine = BenchmarkEngine::get();
+    uint32_t count_vertices = state.range(0);
+    edge_block_index_t* edge_block_index =
+        createEdgeBlockIndex(count_vertices, kCountVertices);
+    tile_stats_t tile_stats;
+    VertexFetcher<PageRank, float, uint32_t> fetcher(
+        *engine.processor_, &engine.vertices_, &tile_stats, thread_index_t());
+    MicroBenchmark::initFetcher(fetcher);
+
+    for (auto _ : state) {
+      MicroBenchmark::fetchIndices(fetcher, edge_block_index);
+    }
+    state.SetItemsProcessed(state.iterations() * count_vertices);
+
+    ring_buffer_destroy(fetcher.response_rb_);
+    free(edge_block_index);
+  }
+  BENCHMARK(BM_VertexFetcherFetchIndices)
+      ->ArgName("vertices")
+      ->RangeMultiplier(8)
+      ->Range(1 << 10, MAX_VERTICES_PER_TILE);
+
+  static void BM_VertexFetcherFillSourceFields(benchmark::State& state) {
+    BenchmarkEngine& engine = BenchmarkEngine::get();
+    uint32_t count_vertices = state.range(0);
+    edge_block_index_t* edge_block_index =
+        createEdgeBlockIndex(count_vertices, kCountVertices);
+    tile_stats_t tile_stats;
+    VertexFetcher<PageRank, float, uint32_t> fetcher(
+        *engine.processor_, &engine.vertices_, &tile_stats, thread_index_t());
+    MicroBenchmark::initFetcher(fetcher);
+
+    for (auto _ : state) {
+      MicroBenchmark::fillSourceFields(fetcher, edge_block_index);
+    }
+    state.SetItemsProcessed(state.iterations() * count_vertices);
+
+    ring_buffer_destroy(fetcher.response_rb_);
+    free(edge_block_index);
+  }
+  BENCHMARK(BM_VertexFetcherFillSourceFields)
+      ->ArgName("vertices")
+      ->RangeMultiplier(8)
+      ->Range(1 << 10, MAX_VERTICES_PER_TILE);
+
+  static void BM_VertexReducerProcessTargetVertices(benchmark::State& state) {
+    BenchmarkEngine& engine = BenchmarkEngine::get();
+    uint32_t count_vertices = state.range(0);
+    edge_block_index_t* edge_block_index =
+        createEdgeBlockIndex(count_vertices, kCountVertices);
+    // every target was touched by the edge engine
+    float* tgt_vertices = new float[count_vertices];
+    for (uint32_t i = 0; i < count_vertices; ++i) {
+      tgt_vertices[i] = 0.5;
+    }
+    VertexReducer<PageRank, float, uint32_t> reducer(
+        *engine.processor_, &engine.vertices_, thread_index_t());
+    MicroBenchmark::initReducer(reducer, edge_block_index, tgt_vertices);
+
+    for (auto _ : state) {
+      MicroBenchmark::processTargetVertices(reducer);
+    }
+    state.SetItemsProcessed(state.iterations() * count_vertices);
+
+    delete[] tgt_vertices;
+    free(edge_block_index);
+  }
+  BENCHMARK(BM_VertexReducerProcessTargetVertices)
+      ->ArgName("vertices")
+      ->RangeMultiplier(8)
+      ->Range(1 << 10, MAX_VERTICES_PER_TILE);
+
+  static void BM_GlobalReducerProcessTargetVertices(benchmark::State& state) {
+    BenchmarkEngine& engine = BenchmarkEngine::get();
+    uint32_t count_vertices = state.range(0);
+
+    // A reduce block of PageRank, without active or source blocks.
+    size_t size_vertices = sizeof(float) * count_vertices;
+    size_t size_tgt_indices = sizeof(uint32_t) * count_vertices;
+    processed_vertex_index_block_t* reduce_block =
+        (processed_vertex_index_block_t*)calloc(
+            1, sizeof(processed_vertex_index_block_t) + size_vertices +
+                   size_tgt_indices);
+    reduce_block->count_tgt_vertex_block = count_vertices;
+    reduce_block->offset_active_vertices_src =
+        sizeof(processed_vertex_index_block_t);
+    reduce_block->offset_active_vertices_tgt =
+        reduce_block->offset_active_vertices_src;
+    reduce_block->offset_vertices = reduce_block->offset_active_vertices_tgt;
+    reduce_block->offset_src_indices =
+        reduce_block->offset_vertices + size_vertices;
+    reduce_block->offset_tgt_indices = reduce_block->offset_src_indices;
+
+    float* vertices =
+        get_array(float*, reduce_block, reduce_block->offset_vertices);
+    uint32_t* tgt_indices =
+        get_array(uint32_t*, reduce_block, reduce_block->offset_tgt_indices);
+    for (uint32_t i = 0; i < count_vertices; ++i) {
+      vertices[i] = 0.5;
+      tgt_indices[i] = benchmarkVertexId(i, kCountVertices);
+    }
+
+    GlobalReducer<PageRank, float, uint32_t> reducer(
+        *engine.domain_, &engine.vertices_, thread_index_t());
+    MicroBenchmark::setReduceBlock(reducer, reduce_block);
+
+    for (auto _ : state) {
+      MicroBenchmark::processTargetVertices(reducer);
+    }
+    state.SetItemsProcessed(state.iterations() * count_vertices);
+
+    free(reduce_block);
+  }
+  BENCHMARK(BM_GlobalReducerProcessTargetVertices)
+      ->ArgName("vertices")
+      ->RangeMultiplier(8)
+      ->Range(1 << 10, MAX_VERTICES_PER_TILE);
+}
+}
@@ -0,0 +1,378 @@
+#if defined(CLANG_COMPLETE_ONLY) || defined(__JETBRAINS_IDE__)
+#include "csr-engine.h"
+#endif
+#pragma once
+
+#include <string.h>
+#include <algorithm>
+#include <util/arch.h>
+#include <util/util.h>
+#include <core/util.h>
+
+namespace scalable_graphs {
+namespace core {
+  // Target vertices per chunk, a multiple of 8 so that no two workers set
+  // bits in the same byte of the bool arrays.
+  static const uint64_t COUNT_CSR_CHUNK_VERTICES = 1024;
+
+  template <class APP, bool is_weighted>
+  CsrWorker<APP, is_weighted>::CsrWorker(CsrEngine<APP, is_weighted>& ctx,
+                                         const thread_index_t& thread_index)
+      : ctx_(ctx), thread_index_(thread_index),
+        accumulators_(COUNT_CSR_CHUNK_VERTICES), count_edges_(0),
+        local_residual_(0.), local_partial_sums_(APP::count_partial_sums) {}
+
+  template <class APP, bool is_weighted>
+  void CsrWorker<APP, is_weighted>::gatherChunk(uint64_t start, uint64_t end) {
+    const vertex_array_t<typename APP::VertexType>& vertices = ctx_.vertices_;
+    void* extension_fields = APP::need_vertex_block_extension_fields
+                                 ? ctx_.extension_fields_.data()
+                                 : NULL;
+    APP::reset_vertices_tile_processor(accumulators_.data(), end - start);
+
+    auto gatherAlong = [&](const CsrGraph::Adjacency& adjacency, uint64_t tgt,
+                           typename APP::VertexType& accumulator) {
+      bool touched = false;
+      uint64_t end_edges = adjacency.offsets[tgt + 1];
+      for (uint64_t i = adjacency.offsets[tgt]; i < end_edges; ++i) {
+        uint32_t src = adjacency.neighbors[i];
+        if (APP::need_active_source_input &&
+            !eval_bool_array(vertices.active_current, src)) {
+          continue;
+        }
+        if (is_weighted) {
+          APP::pullGatherWeighted(vertices.current[src], accumulator,
+                                  adjacency.weights[i], 0, 0,
+                                  &vertices.degrees[src],
+                                  &vertices.degrees[tgt], NULL, NULL,
+                                  ctx_.config_edge_, extension_fields);
+        } else {
+          APP::pullGather(vertices.current[src], accumulator, 0, 0,
+                          &vertices.degrees[src], &vertices.degrees[tgt], NULL,
+                          NULL, ctx_.config_edge_, extension_fields);
+        }
+        touched = true;
+      }
+      count_edges_ += end_edges - adjacency.offsets[tgt];
+      return touched;
+    };
+
+    for (uint64_t tgt = start; tgt < end; ++tgt) {
+      typename APP::VertexType& accumulator = accumulators_[tgt - start];
+      bool touched = false;
+      if (ctx_.gather_forward_) {
+        touched |= gatherAlong(ctx_.graph_.columns(), tgt, accumulator);
+      }
+      if (ctx_.gather_transposed_) {
+        touched |= gatherAlong(ctx_.graph_.rows(), tgt, accumulator);
+      }
+      if (touched) {
+        APP::reduceVertex(vertices.next[tgt], accumulator, vertices.next[tgt],
+                          tgt, vertices.degrees[tgt], vertices.active_next,
+                          ctx_.config_);
+      }
+    }
+  }
+
+  template <class APP, bool is_weighted>
+  void CsrWorker<APP, is_weighted>::applyChunk(uint64_t start, uint64_t end) {
+    for (uint64_t id = start; id < end; ++id) {
+      APP::apply(&ctx_.vertices_, id, ctx_.config_, ctx_.iteration_);
+      if (APP::need_residual) {
+        local_residual_ += APP::residual(&ctx_.vertices_, id);
+      }
+      if (APP::count_partial_sums > 0) {
+        APP::accumulatePartialSums(&ctx_.vertices_, id,
+                                   local_partial_sums_.data());
+      }
+    }
+  }
+
+  template <class APP, bool is_weighted>
+  void CsrWorker<APP, is_weighted>::run() {
+    uint64_t count_vertices = ctx_.vertices_.count;
+    while (true) {
+      count_edges_ = 0;
+      for (uint64_t chunk = smp_faa(&ctx_.gather_progress_, 1);
+           chunk < ctx_.count_chunks_;
+           chunk = smp_faa(&ctx_.gather_progress_, 1)) {
+        uint64_t start = chunk * COUNT_CSR_CHUNK_VERTICES;
+        gatherChunk(start,
+                    std::min(start + COUNT_CSR_CHUNK_VERTICES, count_vertices));
+      }
+      smp_faa(&ctx_.count_edges_round_, count_edges_);
+
+      // all targets are reduced before any vertex is applied
+      int barrier_rc = pthread_barrier_wait(&ctx_.round_barrier_);
+      if (barrier_rc == PTHREAD_BARRIER_SERIAL_THREAD) {
+        ctx_.time_gather_end_ns_ = util::get_time_nsec();
+      }
+
+      local_residual_ = 0.;
+      std::fill(local_partial_sums_.begin(), local_partial_sums_.end(), 0.);
+      for (uint64_t chunk = smp_faa(&ctx_.apply_progress_, 1);
+           chunk < ctx_.count_chunks_;
+           chunk = smp_faa(&ctx_.apply_progress_, 1)) {
+        uint64_t start = chunk * COUNT_CSR_CHUNK_VERTICES;
+        applyChunk(start,
+                   std::min(start + COUNT_CSR_CHUNK_VERTICES, count_vertices));
+      }
+      pthread_mutex_lock(&ctx_.reduce_mutex_);
+      ctx_.residual_ += local_residual_;
+      for (size_t i = 0; i < APP::count_partial_sums; ++i) {
+        ctx_.vertices_.partial_sums[i] += local_partial_sums_[i];
+      }
+      pthread_mutex_unlock(&ctx_.reduce_mutex_);
+
+      // if last thread, end the round
+      barrier_rc = pthread_barrier_wait(&ctx_.round_barrier_);
+      if (barrier_rc == PTHREAD_BARRIER_SERIAL_THREAD) {
+        ctx_.resetRound();
+      }
+      pthread_barrier_wait(&ctx_.round_barrier_);
+
+      if (ctx_.shutdown_) {
+        break;
+      }
+    }
+  }
+
+  template <class APP, bool is_weighted>
+  CsrEngine<APP, is_weighted>::CsrEngine(const config_vertex_domain_t& config,
+                                         const CsrGraph& graph,
+                                         int count_threads)
+      : config_(config), graph_(graph),
+        count_threads_(std::max(count_threads, 1)),
+        extension_fields_(APP::max_size_extension_fields_vertex_block),
+        gather_forward_(true), gather_transposed_(false), gather_progress_(0),
+        apply_progress_(0), shutdown_(false), iteration_(0), residual_(0.),
+        residual_last_(0.), count_edges_round_(0), count_edges_total_(0),
+        time_round_start_ns_(0), time_gather_end_ns_(0),
+        time_apply_end_ns_(0), time_run_ms_(0.) {
+    if (graph.isWeighted() != is_weighted && graph.countEdges() > 0) {
+      sg_err("The algorithm %s a weighted graph\n",
+             is_weighted ? "needs" : "does not take");
+      util::die(1);
+    }
+    if (APP::need_transposed_tiles && graph.rows().offsets.empty()) {
+      sg_err("Gathering along the transposed edges needs the rows of the "
+             "graph, %lu vertices\n",
+             graph.countVertices());
+      util::die(1);
+    }
+    config_edge_.max_iterations = config_.max_iterations;
+
+    uint64_t count_vertices = graph.countVertices();
+    size_t size_active_array = size_bool_array(count_vertices);
+    vertices_.count = count_vertices;
+    vertices_.size_active = size_active_array;
+    vertices_.degrees = new vertex_degree_t[count_vertices];
+    memcpy(vertices_.degrees, graph.degrees(),
+           sizeof(vertex_degree_t) * count_vertices);
+    vertices_.current = new VertexType[count_vertices];
+    vertices_.next = new VertexType[count_vertices];
+    vertices_.active_current = new char[size_active_array]();
+    vertices_.active_next = new char[size_active_array]();
+    vertices_.changed = new char[size_active_array]();
+    vertices_.buckets = NULL;
+    if (APP::need_buckets) {
+      buckets_.pending = new char[size_active_array]();
+      buckets_.bucket = new uint32_t[count_vertices];
+      buckets_.current = 0;
+      vertices_.buckets = &buckets_;
+    }
+    vertices_.direction = TileDirection::TD_Forward;
+    vertices_.partial_sums = NULL;
+    if (APP::count_partial_sums > 0) {
+      vertices_.partial_sums = new double[APP::count_partial_sums]();
+    }
+
+    count_chunks_ = (count_vertices + COUNT_CSR_CHUNK_VERTICES - 1) /
+                    COUNT_CSR_CHUNK_VERTICES;
+    pthread_barrier_init(&round_barrier_, NULL, count_threads_);
+    pthread_mutex_init(&reduce_mutex_, NULL);
+
+    if (!config_.path_to_metrics.empty()) {
+      metrics_.open(config_.path_to_metrics + "csr_engine.json");
+    }
+  }
+
+  template <class APP, bool is_weighted>
+  CsrEngine<APP, is_weighted>::~CsrEngine() {
+    delete[] vertices_.degrees;
+    delete[] vertices_.current;
+    delete[] vertices_.next;
+    delete[] vertices_.active_current;
+    delete[] vertices_.active_next;
+    delete[] vertices_.changed;
+    if (APP::need_buckets) {
+      delete[] buckets_.pending;
+      delete[] buckets_.bucket;
+    }
+    delete[] vertices_.partial_sums;
+    pthread_barrier_destroy(&round_barrier_);
+    pthread_mutex_destroy(&reduce_mutex_);
+  }
+
+  template <class APP, bool is_weighted>
+  void CsrEngine<APP, is_weighted>::init() {
+    for (uint64_t root : config_.roots) {
+      if (root >= vertices_.count) {
+        sg_err("Root %lu out of range of %lu vertices\n", root,
+               vertices_.count);
+        util::die(1);
+      }
+    }
+    if (!config_.features.empty() &&
+        config_.features.size() != vertices_.count) {
+      sg_err("Got %lu features for %lu vertices\n", config_.features.size(),
+             vertices_.count);
+      util::die(1);
+    }
+    init_args_t args;
+    args.roots = config_.roots.data();
+    args.count_roots = config_.roots.size();
+    args.incremental = NULL;
+    args.features = config_.features.data();
+    args.count_features = config_.features.size();
+    APP::init_vertices(&vertices_, &args);
+
+    // give APP the chance to initialize before the first round as well
+    APP::pre_processing_per_round(&vertices_, config_, iteration_);
+    if (APP::need_vertex_block_extension_fields) {
+      APP::fillExtensionFieldsVertexBlock(extension_fields_.data(), NULL, NULL,
+                                          NULL, &vertices_);
+    }
+    gather_forward_ = !APP::need_transposed_tiles ||
+                      vertices_.direction != TileDirection::TD_Transposed;
+    gather_transposed_ = APP::need_transposed_tiles &&
+                         vertices_.direction != TileDirection::TD_Forward;
+  }
+
+  template <class APP, bool is_weighted>
+  size_t CsrEngine<APP, is_weighted>::run() {
+    std::vector<CsrWorker<APP, is_weighted>*> workers;
+    for (int i = 0; i < count_threads_; ++i) {
+      thread_index_t thread_index;
+      thread_index.count = count_threads_;
+      thread_index.id = i;
+      workers.push_back(new CsrWorker<APP, is_weighted>(*this, thread_index));
+    }
+
+    uint64_t time_run_start_ns = util::get_time_nsec();
+    time_round_start_ns_ = time_run_start_ns;
+    for (size_t i = 0; i < workers.size(); ++i) {
+      workers[i]->start();
+      workers[i]->setName("CsrWorker_" + std::to_string(i));
+    }
+    for (auto worker : workers) {
+      worker->join();
+      delete worker;
+    }
+    time_run_ms_ = (util::get_time_nsec() - time_run_start_ns) / 1e6;
+
+    sg_log("Finished with execution after %lu iterations in %.3fmsec, %lu "
+           "edges\n",
+           iteration_, time_run_ms_, count_edges_total_);
+    if (!config_.path_to_result.empty()) {
+      sg_log("Writing result to %s\n", config_.path_to_result.c_str());
+      util::writeDataToFile(config_.path_to_result, vertices_.current,
+                            sizeof(VertexType) * vertices_.count);
+    }
+    return iteration_;
+  }
+
+  template <class APP, bool is_weighted>
+  void CsrEngine<APP, is_weighted>::resetRound() {
+    time_apply_end_ns_ = util::get_time_nsec();
+    double time_round_ms = (time_apply_end_ns_ - time_round_start_ns_) / 1e6;
+    sg_log("Round Time for iteration %lu %.3fmsec\n", (iteration_ + 1),
+           time_round_ms);
+
+    // allow application to vote against switching the current and next
+    // fields, i.e. for more than one iteration per super-step:
+    bool switch_current_next = true;
+    APP::reset_vertices(&vertices_, &switch_current_next);
+    if (APP::count_partial_sums > 0) {
+      memset(vertices_.partial_sums, 0,
+             sizeof(double) * APP::count_partial_sums);
+    }
+    if (switch_current_next) {
+      std::swap(vertices_.current, vertices_.next);
+      std::swap(vertices_.active_current, vertices_.active_next);
+    }
+    memset(vertices_.changed, 0, vertices_.size_active);
+
+    // delta-stepping: continue with the next bucket once the current one is
+    // settled, instead of ending the run
+    if (APP::need_buckets) {
+      // not converged while buckets are pending
+      residual_ += advanceBucket(&vertices_, [](size_t) {});
+    }
+
+    size_t count_active_vertices =
+        util::countBoolArray(vertices_.active_current, vertices_.size_active);
+    if (metrics_.isOpen()) {
+      writeMetrics(count_active_vertices);
+    }
+    time_round_start_ns_ = time_apply_end_ns_;
+    count_edges_total_ += count_edges_round_;
+    count_edges_round_ = 0;
+    residual_last_ = residual_;
+
+    ++iteration_;
+    bool end_condition_selective_scheduling =
+        config_.use_selective_scheduling && count_active_vertices == 0;
+    bool end_condition_residual = false;
+    if (APP::need_residual) {
+      sg_log("Residual: %f, tolerance %f\n", residual_,
+             config_.convergence_tolerance);
+      end_condition_residual = residual_ <= config_.convergence_tolerance;
+    }
+    residual_ = 0.;
+
+    if (iteration_ >= (size_t)config_.max_iterations ||
+        end_condition_selective_scheduling || end_condition_residual) {
+      shutdown_ = true;
+      return;
+    }
+
+    // next round starts after this, expose preProcessing to APP:
+    APP::pre_processing_per_round(&vertices_, config_, iteration_);
+    if (APP::need_vertex_block_extension_fields) {
+      APP::fillExtensionFieldsVertexBlock(extension_fields_.data(), NULL, NULL,
+                                          NULL, &vertices_);
+    }
+    // the APP picked the direction of the next round in reset_vertices
+    gather_forward_ = !APP::need_transposed_tiles ||
+                      vertices_.direction != TileDirection::TD_Transposed;
+    gather_transposed_ = APP::need_transposed_tiles &&
+                         vertices_.direction != TileDirection::TD_Forward;
+    gather_progress_ = 0;
+    apply_progress_ = 0;
+  }
+
+  template <class APP, bool is_weighted>
+  void CsrEngine<APP, is_weighted>::writeMetrics(
+      size_t count_active_vertices) {
+    double time_round_ms = (time_apply_end_ns_ - time_round_start_ns_) / 1e6;
+    util::MetricsRecord record;
+    record.addCount("iteration", iteration_ + 1);
+    record.addValue("time_ms", time_round_ms);
+    // gathering includes the reduce into next, applying ends the round
+    record.addValue("gather_ms",
+                    (time_gather_end_ns_ - time_round_start_ns_) / 1e6);
+    record.addValue("apply_ms",
+                    (time_apply_end_ns_ - time_gather_end_ns_) / 1e6);
+    record.addCount("active_vertices", count_active_vertices);
+    if (APP::need_residual) {
+      record.addValue("residual", residual_);
+    }
+    record.addCount("edges", count_edges_round_);
+    record.addValue("edges_per_sec",
+                    time_round_ms > 0 ? count_edges_round_ / time_round_ms * 1e3
+                                      : 0.);
+    metrics_.write(record);
+  }
+}
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <pthread.h>
+#include <vector>
+#include <util/runnable.h>
+#include <util/metrics.h>
+#include <core/datatypes.h>
+#include <core/csr-graph.h>
+
+namespace scalable_graphs {
+namespace core {
+  template <class APP, bool is_weighted>
+  class CsrEngine;
+
+  // Runs all phases of every round on chunks of target vertices grabbed from
+  // the shared counters of the CsrEngine.
+  template <class APP, bool is_weighted>
+  class CsrWorker : public scalable_graphs::util::Runnable {
+  public:
+    CsrWorker(CsrEngine<APP, is_weighted>& ctx,
+              const thread_index_t& thread_index);
+
+  private:
+    virtual void run();
+
+    // Gathers along the in-edges of the chunk, and the out-edges for the
+    // transposed direction, then reduces every touched target into next.
+    void gatherChunk(uint64_t start, uint64_t end);
+
+    void applyChunk(uint64_t start, uint64_t end);
+
+  private:
+    CsrEngine<APP, is_weighted>& ctx_;
+    thread_index_t thread_index_;
+
+    std::vector<typename APP::VertexType> accumulators_;
+    uint64_t count_edges_;
+    double local_residual_;
+    std::vector<double> local_partial_sums_;
+  };
+
+  // Reference engine on an in-memory CsrGraph, running the same APP through
+  // pullGather, reduceVertex and apply as the vertex domain and the edge
+  // engines do, without tiles, ring buffers, fetchers and reducers in
+  // between. A target vertex gathers along all of its edges into a single
+  // accumulator, which is reduced into next once. Without the tile index,
+  // extension fields are filled once per round, which suits APPs filling them
+  // from global state only. Rounds end the way they end in the vertex domain:
+  // On max_iterations, on the residual or, with selective scheduling, once no
+  // vertex is active.
+  template <class APP, bool is_weighted>
+  class CsrEngine {
+  public:
+    typedef typename APP::VertexType VertexType;
+
+    CsrEngine(const config_vertex_domain_t& config, const CsrGraph& graph,
+              int count_threads);
+
+    ~CsrEngine();
+
+    // Initializes the vertices from the roots of the config.
+    void init();
+
+    // Runs until convergence, returns the count of rounds.
+    size_t run();
+
+    inline const VertexType* current() const { return vertices_.current; }
+
+    // edges gathered along over all rounds
+    inline uint64_t countEdges() const { return count_edges_total_; }
+
+    inline double timeRunMs() const { return time_run_ms_; }
+
+    // residual of the last round run
+    inline double residual() const { return residual_last_; }
+
+  private:
+    friend class CsrWorker<APP, is_weighted>;
+
+    // Ends the round, on the serial thread of the round barrier.
+    void resetRound();
+
+    void writeMetrics(size_t count_active_vertices);
+
+  private:
+    config_vertex_domain_t config_;
+    config_edge_processor_t config_edge_;
+    const CsrGraph& graph_;
+    int count_threads_;
+
+    vertex_array_t<VertexType> vertices_;
+    vertex_buckets_t buckets_;
+    std::vector<char> extension_fields_;
+    bool gather_forward_;
+    bool gather_transposed_;
+
+    // chunks of target vertices grabbed by the workers, per phase
+    volatile uint64_t gather_progress_ __attribute__((aligned(64)));
+    volatile uint64_t apply_progress_ __attribute__((aligned(64)));
+    uint64_t count_chunks_;
+
+    pthread_barrier_t round_barrier_;
+    pthread_mutex_t reduce_mutex_;
+    bool shutdown_;
+
+    size_t iteration_;
+    double residual_;
+    double residual_last_;
+    uint64_t count_edges_round_;
+    uint64_t count_edges_total_;
+    uint64_t time_round_start_ns_;
+    uint64_t time_gather_end_ns_;
+    uint64_t time_apply_end_ns_;
+    double time_run_ms_;
+
+    util::MetricsWriter metrics_;
+  };
+}
+}
+
+#if !defined(CLANG_COMPLETE_ONLY) && !defined(__JETBRAINS_IDE__)
+#include "csr-engine.cc"
+#endif
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+#include <core/datatypes.h>
+
+namespace scalable_graphs {
+namespace core {
+  // A graph in compressed sparse columns, the in-edges of every vertex sorted
+  // by source, and optionally compressed sparse rows, the out-edges sorted by
+  // target. The reference engine gathers along the columns, and along the
+  // rows for the transposed direction. Degrees are counted from the edges, so
+  // they match the ones of the tiler.
+  class CsrGraph {
+  public:
+    // Edges of one direction: the neighbors of vertex i are
+    // [offsets[i], offsets[i + 1]), weights is empty for unweighted graphs.
+    struct Adjacency {
+      std::vector<uint64_t> offsets;
+      std::vector<uint32_t> neighbors;
+      std::vector<float> weights;
+    };
+
+    CsrGraph();
+
+    // Weights is either empty or holds the weight of every edge.
+    void build(uint64_t count_vertices, const std::vector<edge_t>& edges,
+               const std::vector<float>& weights, bool with_rows);
+
+    // Builds the graph from the tiles of all edge engines, packed into tile
+    // containers or as written by the tiler. Like the edge engines, it adds
+    // the delta tiles of post-grc-delta and drops the edges of the
+    // tombstones.
+    void loadTiles(const config_t& config, const scenario_stats_t& stats,
+                   bool with_rows);
+
+    inline uint64_t countVertices() const { return count_vertices_; }
+
+    inline uint64_t countEdges() const { return columns_.neighbors.size(); }
+
+    inline bool isWeighted() const { return !columns_.weights.empty(); }
+
+    inline const Adjacency& columns() const { return columns_; }
+
+    // empty unless built with_rows
+    inline const Adjacency& rows() const { return rows_; }
+
+    inline const vertex_degree_t* degrees() const { return degrees_.data(); }
+
+  private:
+    uint64_t count_vertices_;
+    Adjacency columns_;
+    Adjacency rows_;
+    std::vector<vertex_degree_t> degrees_;
+  };
+}
+}
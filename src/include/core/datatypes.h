@@ -141,14 +141,32 @@ struct vertex_count_t {
   local_vertex_id_t id;
 };
 
+// Encoding of the src- and tgt-block of a tile, chosen per tile by the tiler.
+// The values match the former use_rle-flag, i.e. tiles from before remain
+// readable.
+enum class TileEncoding : uint8_t {
+  // src- and tgt-block are arrays of local_vertex_id_t's
+  TE_List = 0,
+  // the tgt-block is run-length-encoded as an array of vertex_count_t's
+  TE_RLE = 1,
+  // the src-block is an adjacency bitmap with one row of
+  // BITMAP_WORDS_PER_ROW uint64_t's per target, bit i of a row denotes an
+  // edge from source i, the tgt-block holds the id of the first edge of every
+  // row as uint32_t, edges are numbered row by row
+  TE_Bitmap = 2,
+};
+
+#define BITMAP_WORDS_PER_ROW(count_vertex_src) (((count_vertex_src) + 63) / 64)
+
 struct edge_block_t {
   uint64_t block_id;
 
   // these three blocks symbolize the edges (weight is only set for weighted
   // graphs):
   // e_0 = (src[0], tgt[0], (weight[0]))
-  uint32_t offset_src;    // local_vertex_id_t*
-  uint32_t offset_tgt;    // local_vertex_id_t* or vertex_count_t* with RLE
+  uint32_t offset_src;    // local_vertex_id_t* or uint64_t* with a bitmap
+  uint32_t offset_tgt;    // local_vertex_id_t*, vertex_count_t* with RLE or
+                          // uint32_t* with a bitmap
   uint32_t offset_weight; // float*
 };
 
@@ -233,9 +251,74 @@ struct tile_stats_t {
   uint32_t count_vertex_src;
   uint32_t count_vertex_tgt;
   uint32_t count_edges;
-  // indicates whether the target-block is encoded using run-length-encoding
-  // if using RLE, the tgt-block is encoded as an array of vertex_count_t's
-  bool use_rle;
+  // indicates how the edge block of this tile is encoded
+  TileEncoding encoding;
+};
+
+// Single-file tile container, one per edge engine, replacing tiles.dat,
+// meta.dat and tile_stats.dat. Layout:
+//   [header][entry table][edge blocks][edge block indices]
+// The edge block and index regions start and end at a TILE_READ_ALIGN
+// boundary, every block inside starts at a PAGE_SIZE boundary.
+#define TILE_CONTAINER_MAGIC 0x3154434941534f4dul // "MOSAICT1"
+#define TILE_CONTAINER_VERSION 1
+
+struct tile_container_header_t {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t alignment;
+  uint64_t count_tiles;
+  uint64_t offset_entries;
+  uint64_t offset_edge_blocks;
+  uint64_t offset_indices;
+  uint64_t size_file;
+  bool is_weighted_graph;
+  bool is_index_32_bits;
+  uint32_t checksum_entries;
+  // covers all preceding fields
+  uint32_t checksum_header;
+};
+
+struct tile_container_entry_t {
+  tile_stats_t stats;
+  // absolute offsets into the container file
+  uint64_t offset_edge_block;
+  uint64_t offset_index;
+  // unpadded sizes
+  uint64_t size_edge_block;
+  uint64_t size_index;
+  // crc32c of the unpadded blocks
+  uint32_t checksum_edge_block;
+  uint32_t checksum_index;
+};
+
+// Deleted edges of the base tiles of one edge engine, kept next to the tile
+// container until the next compaction. Layout:
+//   [header][tile_tombstone_t * count_tombstones]
+// The entries are sorted by tile and edge, the edge id is the position of the
+// edge in the src-block of the tile.
+#define TILE_TOMBSTONES_MAGIC 0x3153424d4f54534dul // "MSTOMBS1"
+
+struct tile_tombstones_header_t {
+  uint64_t magic;
+  uint64_t count_tiles;
+  uint64_t count_tombstones;
+};
+
+struct tile_tombstone_t {
+  uint32_t tile_id;
+  uint32_t edge_id;
+
+  bool operator<(const tile_tombstone_t& other) const {
+    if (tile_id == other.tile_id) {
+      return edge_id < other.edge_id;
+    }
+    return tile_id < other.tile_id;
+  }
+
+  bool operator==(const tile_tombstone_t& other) const {
+    return tile_id == other.tile_id && edge_id == other.edge_id;
+  }
 };
 
 struct command_line_args_grc_t {
@@ -248,6 +331,25 @@ struct command_line_args_grc_t {
   std::vector<std::string> paths_to_partition;
 };
 
+// Distance buckets for delta-stepping, allocated by the VertexDomain for APPs
+// with need_buckets set. APP::apply parks vertices improved beyond the current
+// bucket as pending instead of keeping them active. Once no vertex is active
+// anymore, the smallest pending bucket becomes the current one, see
+// core::advanceBucket.
+struct vertex_buckets_t {
+  // bool-array of the parked vertices
+  char* pending;
+  // bucket of each parked vertex
+  uint32_t* bucket;
+  // the bucket being settled
+  uint32_t current;
+};
+
+// Tiles gathered along in a round by APPs with need_transposed_tiles set. The
+// transposed tiles hold every edge with source and target swapped, global tile
+// id count_tiles + g is the transposed copy of forward tile g.
+enum class TileDirection { TD_Forward, TD_Transposed, TD_Both };
+
 // intuition: The current-array is of step T, the next-array of step T+1, they
 // will get swapped when step T is done.
 template <typename T>
@@ -265,6 +367,85 @@ struct vertex_array_t {
 
   // Keep track of the vertices which have changed in the current iteration.
   char* changed;
+
+  // NULL unless APP::need_buckets
+  vertex_buckets_t* buckets;
+
+  // TD_Forward unless the APP picks the tiles of the next round in
+  // init_vertices or reset_vertices, requires APP::need_transposed_tiles
+  TileDirection direction;
+
+  // APP::count_partial_sums sums over all vertices of the round, NULL if
+  // there are none. Complete in reset_vertices, zeroed afterwards.
+  double* partial_sums;
+};
+
+// Restarts an algorithm from a previous result instead of from scratch.
+// previous_vertices is the raw vertex array of the earlier run, the edges are
+// the changes applied to the graph since then, in global ids. The degrees of
+// the vertex array already include the changes.
+struct incremental_args_t {
+  const void* previous_vertices;
+  size_t size_previous_vertices;
+  const edge_t* insertions;
+  size_t count_insertions;
+  const edge_t* deletions;
+  size_t count_deletions;
+};
+
+// Passed to APP::init_vertices, may be NULL if there are no arguments at all.
+struct init_args_t {
+  // start vertices of traversals in global ids, none if count_roots is 0
+  const uint64_t* roots;
+  size_t count_roots;
+  // NULL for a regular run
+  const incremental_args_t* incremental;
+  // a feature per vertex in global ids, none if count_features is 0
+  const float* features;
+  size_t count_features;
+};
+
+namespace scalable_graphs {
+namespace core {
+  class TileContainer;
+  class TileTombstones;
+}
+}
+
+// The tile containers of one edge engine, opened and, in the in-memory mode,
+// mapped once by the query server. The engines borrow them.
+struct resident_tiles_t {
+  // NULL if the tiles are not stored in a tile container
+  scalable_graphs::core::TileContainer* tile_container;
+  // NULL unless written by post-grc-delta
+  scalable_graphs::core::TileContainer* delta_tile_container;
+  scalable_graphs::core::TileTombstones* tile_tombstones;
+  // NULL unless written by post-grc-transposer
+  scalable_graphs::core::TileContainer* transposed_tile_container;
+};
+
+// The static data of a graph, loaded once by the query server and shared by
+// the engines of all queries instead of being read for every run.
+struct resident_graph_t {
+  vertex_degree_t* degrees;
+  // only loaded for selective scheduling, NULL otherwise
+  size_t* vertex_to_tiles_offset;
+  uint32_t* vertex_to_tiles_count;
+  uint32_t* vertex_to_tiles_index;
+  // per edge engine
+  resident_tiles_t tiles[MAX_EDGE_ENGINES];
+};
+
+// One line of the query server protocol:
+//   <algorithm> [roots=<id>,<id>,...] [max-iterations=<n>] [output=<file>]
+struct query_t {
+  std::string algorithm;
+  // in global ids
+  std::vector<uint64_t> roots;
+  // 0 keeps the limit the server was started with
+  int max_iterations;
+  // raw vertex array after the last round, not written if empty
+  std::string path_to_output;
 };
 
 struct processed_vertex_block_t {
@@ -347,12 +528,12 @@ struct fetch_vertices_response_t {
 };
 
 struct tile_data_t {
-  // Indicates whether the data is currently in use, if false this data can be
-  // reclaimed.
-  volatile bool data_active;
+  // Indicates whether the data is currently in use, a slot of
+  // ring_buffer_wait.h, if free this data can be reclaimed.
+  volatile int data_active;
   // Indicates that the data is ready to be read, i.e. all necessary fields have
-  // been written.
-  volatile bool data_ready;
+  // been written, an event of ring_buffer_wait.h.
+  volatile int data_ready;
 
   volatile void* bundle_raw;      // raw start of a bundle of tiles
   volatile size_t* bundle_refcnt; // pointer to a batch reference counter
@@ -362,6 +543,9 @@ struct tile_data_edge_engine_t : public tile_data_t {
   uint32_t fetch_refcnt;
   uint32_t process_refcnt;
   volatile vertex_edge_tiles_block_t* tile_block;
+  // Indicates that the leader of a partitioned tile has set tile_block, an
+  // event of ring_buffer_wait.h.
+  volatile int tile_block_ready;
 };
 
 struct tile_data_vertex_engine_t : public tile_data_t {
@@ -511,6 +695,39 @@ struct profiling_transport_t {
   profiling_data_t data;
 };
 
+// A duration event in a per-thread trace buffer, timestamps are raw TSC values
+// and the name is interned.
+struct trace_event_t {
+  uint64_t tsc_start;
+  uint64_t tsc_end;
+  uint64_t metadata;
+  int64_t local_id;
+  int64_t global_id;
+  uint32_t name_id;
+  // Appended to the name if not negative.
+  int32_t tile_id;
+  ComponentType component;
+};
+
+enum class PerfCounter {
+  PC_Cycles,
+  PC_Instructions,
+  // Last level cache misses, times the cacheline size approximates the memory
+  // traffic of a thread.
+  PC_LLCMisses,
+  PC_DTLBMisses,
+  // Loads served by a memory node, not available on every CPU.
+  PC_NodeLoads,
+};
+
+#define COUNT_PERF_COUNTERS 5
+
+struct profiling_counters_t {
+  uint64_t values[COUNT_PERF_COUNTERS];
+  // Whether the counter could be opened at all.
+  bool available[COUNT_PERF_COUNTERS];
+};
+
 enum class PerfEventMode { PEM_Host, PEM_Client };
 
 #define VERTEX_LOCK_TABLE_SIZE 223
@@ -103,11 +103,17 @@ struct config_t {
   bool is_index_32_bits;
   bool is_graph_weighted;
   bool in_memory_mode;
+  // Check the checksums of all tiles once when the in-memory mode maps the
+  // tile containers.
+  bool verify_tiles = false;
   bool run_on_mic;
   bool use_smt;
   bool use_selective_scheduling;
   bool do_perfmon;
   bool enable_perf_event_collection;
+  // Count cycles, instructions, cache and TLB misses per component, needs
+  // enable_perf_event_collection.
+  bool enable_perf_counters = false;
   bool enable_local_reducer;
   bool enable_local_fetcher;
 
@@ -119,10 +125,19 @@ struct config_t {
   std::string path_to_globals;
   std::string algorithm;
   std::string path_to_perf_events;
+  // Where to write one JSON record of metrics per round to, none if empty.
+  std::string path_to_metrics;
+  // Port on 127.0.0.1 or unix socket path to serve live metrics on, in the
+  // Prometheus text format, none if empty.
+  std::string metrics_address;
   std::vector<std::string> paths_to_meta;
   std::vector<std::string> paths_to_tile;
 };
 
+// see datatypes.h
+struct resident_graph_t;
+struct resident_tiles_t;
+
 struct config_vertex_domain_t : public config_t {
   size_t count_vertices;
   int count_vertex_appliers;
@@ -134,6 +149,23 @@ struct config_vertex_domain_t : public config_t {
   GlobalFetcherMode global_fetcher_mode;
   std::string fault_tolerance_ouput_path;
   std::string path_to_log;
+  // incremental mode, see incremental_args_t
+  std::string path_to_incremental_input;
+  std::string path_to_incremental_insertions;
+  std::string path_to_incremental_deletions;
+  // start vertices of traversals, in global ids
+  std::vector<uint64_t> roots;
+  // (optional) a feature per vertex of kmc, in global ids
+  std::vector<float> features;
+  // width of the distance buckets of sssp-delta
+  float bucket_width = 1.0f;
+  // the run ends once the residual summed up over all vertices (see
+  // APP::residual) is at most this
+  double convergence_tolerance = 0.;
+  // (optional) raw vertex array written after the last round
+  std::string path_to_result;
+  // set by the query server, NULL if every run loads the graph by itself
+  const resident_graph_t* resident_graph = NULL;
   std::vector<int> edge_engine_to_mic;
   ringbuffer_config_t ringbuffer_configs[MAX_EDGE_ENGINES];
 };
@@ -155,6 +187,8 @@ struct config_edge_processor_t : public config_t {
   TileProcessorMode tile_processor_mode;
   TileProcessorInputMode tile_processor_input_mode;
   TileProcessorOutputMode tile_processor_output_mode;
+  // set by the query server, NULL if the engine opens the tiles by itself
+  const resident_tiles_t* resident_tiles = NULL;
 };
 
 enum class PartitionMode {
@@ -183,6 +217,7 @@ struct config_grc_t {
 struct config_tiler_t : public config_grc_t {
   bool output_weighted;
   bool use_rle;
+  bool use_bitmap;
   grc_tile_traversals_t traversal;
   std::vector<std::string> paths_to_meta;
   std::vector<std::string> paths_to_tile;
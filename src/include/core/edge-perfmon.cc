@@ -9,7 +9,8 @@ namespace core {
       : tick_(tick), forced_to_stop_(false), count_edges_read_(0),
         count_edges_processed_(0), count_bytes_read_(0), count_tiles_read_(0),
         count_tiles_processed_(0), count_active_tiles_(0),
-        count_inactive_tiles_(0) {
+        count_inactive_tiles_(0), time_tile_readers_barrier_ns_(0),
+        time_tile_processors_barrier_ns_(0) {
     // do nothing
   }
 
@@ -37,6 +37,10 @@ namespace core {
 
     uint64_t count_active_tiles_ __attribute__((aligned(64)));
     uint64_t count_inactive_tiles_ __attribute__((aligned(64)));
+
+    // time all threads spent waiting at the barriers of a round
+    uint64_t time_tile_readers_barrier_ns_ __attribute__((aligned(64)));
+    uint64_t time_tile_processors_barrier_ns_ __attribute__((aligned(64)));
     // __cacheline_aligned;
   };
 }
@@ -10,9 +10,20 @@ namespace core {
   template <class APP, typename TVertexType, bool is_weighted>
   EdgeProcessor<APP, TVertexType, is_weighted>::EdgeProcessor(
       const config_edge_processor_t& config)
-      : shutdown_(false), config_(config),
+      : shutdown_(false),
+        config_(APP::need_transposed_tiles ? withTransposedTiles(config)
+                                           : config),
+        delta_tiles_fd_(-1), count_base_tiles_(SIZE_MAX),
+        transposed_tiles_fd_(-1), count_forward_tiles_(SIZE_MAX),
+        tile_container_(NULL), delta_tile_container_(NULL),
+        tile_tombstones_(NULL), transposed_tile_container_(NULL),
         tile_reader_progress_(config_.count_tile_readers),
-        fake_block_id_counter_(config_.count_tile_processors) {
+        fake_block_id_counter_(config_.count_tile_processors),
+        time_round_start_ns_(0), count_edges_read_last_(0),
+        count_edges_processed_last_(0), count_bytes_read_last_(0),
+        count_tiles_read_last_(0), count_tiles_processed_last_(0),
+        time_tile_readers_barrier_ns_last_(0),
+        time_tile_processors_barrier_ns_last_(0), metrics_source_id_(-1) {
     // init barrier for each iteration, this only for selective scheduling
     if (config_.use_selective_scheduling) {
       pthread_barrier_init(&barrier_tile_readers_, NULL,
@@ -24,55 +35,169 @@ namespace core {
 
   template <class APP, typename TVertexType, bool is_weighted>
   int EdgeProcessor<APP, TVertexType, is_weighted>::init() {
-    // init fd of tiles-file
-    std::string tiles_file_name = core::getEdgeTileFileName(config_, 0);
-    tiles_fd_ = util::openFileDirectly(tiles_file_name);
-
-    // init tile_stats_
-    std::string global_tile_stats_file_name =
-        core::getGlobalTileStatsFileName(config_, 0);
-
     int count_tiles_for_mic =
         core::countTilesPerMic(config_, config_.mic_index);
 
     tile_stats_ = new tile_stats_t[count_tiles_for_mic];
+    tile_offsets_ = new size_t[count_tiles_for_mic];
 
-    size_t size_tile_stats = sizeof(tile_stats_t) * count_tiles_for_mic;
-    util::readDataFromFile(global_tile_stats_file_name, size_tile_stats,
-                           tile_stats_);
+    // prefer the single-file tile container if one was packed for this edge
+    // engine, the query server opens it once for all runs
+    const resident_tiles_t* resident_tiles = config_.resident_tiles;
+    std::string tile_container_file_name =
+        core::getTileContainerFileName(config_, 0);
+    if (resident_tiles != NULL ? resident_tiles->tile_container != NULL
+                               : TileContainer::exists(
+                                     tile_container_file_name)) {
+      if (resident_tiles != NULL) {
+        tile_container_ = resident_tiles->tile_container;
+        delta_tile_container_ = resident_tiles->delta_tile_container;
+      } else {
+        tile_container_ = new TileContainer();
+        tile_container_->open(tile_container_file_name);
+
+        // delta tiles written by post-grc-delta follow the base tiles
+        std::string delta_tile_container_file_name =
+            core::getDeltaTileContainerFileName(config_, 0);
+        if (TileContainer::exists(delta_tile_container_file_name)) {
+          delta_tile_container_ = new TileContainer();
+          delta_tile_container_->open(delta_tile_container_file_name);
+        }
+      }
+      count_base_tiles_ = tile_container_->countTiles();
+      size_t count_delta_tiles = delta_tile_container_ != NULL
+                                     ? delta_tile_container_->countTiles()
+                                     : 0;
+      count_forward_tiles_ = count_base_tiles_ + count_delta_tiles;
+
+      // the transposed tiles written by post-grc-transposer follow the
+      // forward ones
+      size_t count_transposed_tiles = 0;
+      if (APP::need_transposed_tiles) {
+        if (resident_tiles == NULL) {
+          transposed_tile_container_ = openTransposedTileContainer(config_, 0);
+        } else if (resident_tiles->transposed_tile_container != NULL) {
+          transposed_tile_container_ =
+              resident_tiles->transposed_tile_container;
+        } else {
+          sg_err("Transposed tiles %s missing, run post-grc-transposer "
+                 "first\n",
+                 core::getTransposedTileContainerFileName(config_, 0).c_str());
+          util::die(1);
+        }
+        count_transposed_tiles = transposed_tile_container_->countTiles();
+      }
 
-    // pre-calculate the individual tile-offsets
-    tile_offsets_ = new size_t[count_tiles_for_mic];
-    tile_offsets_[0] = 0;
-    for (int i = 1; i < count_tiles_for_mic; ++i) {
-      // offset is the offset of the previous block plus the size of the
-      // previous block:
-      tile_stats_t tile_stats = tile_stats_[i - 1];
-
-      // step 2: calculate required space to fetch the tile
-      size_t size_edge_src_block =
-          sizeof(local_vertex_id_t) * tile_stats.count_edges;
-
-      size_t size_edge_tgt_block = size_edge_src_block;
-
-      // if using rle, take the tgt-block as the size times the
-      // vertex-count-struct
-      if (tile_stats.use_rle) {
-        size_edge_tgt_block =
-            sizeof(vertex_count_t) * tile_stats.count_vertex_tgt;
+      const tile_container_header_t& header = tile_container_->header();
+      if (count_forward_tiles_ + count_transposed_tiles !=
+              (uint64_t)count_tiles_for_mic ||
+          header.is_weighted_graph != is_weighted ||
+          (delta_tile_container_ != NULL &&
+           delta_tile_container_->header().is_weighted_graph != is_weighted) ||
+          (transposed_tile_container_ != NULL &&
+           transposed_tile_container_->header().is_weighted_graph !=
+               is_weighted)) {
+        sg_err("Tile container %s does not match the graph (%lu + %lu + %lu "
+               "tiles)\n",
+               tile_container_file_name.c_str(), count_base_tiles_,
+               count_delta_tiles, count_transposed_tiles);
+        util::die(1);
+      }
+      sg_log("Using tile container %s with %lu delta and %lu transposed "
+             "tiles\n",
+             tile_container_file_name.c_str(), count_delta_tiles,
+             count_transposed_tiles);
+
+      tiles_fd_ = tile_container_->fd();
+      tile_container_->copyTileStats(tile_stats_);
+      for (size_t i = 0; i < count_base_tiles_; ++i) {
+        tile_offsets_[i] = tile_container_->entry(i).offset_edge_block;
+      }
+      if (delta_tile_container_ != NULL) {
+        delta_tiles_fd_ = delta_tile_container_->fd();
+        delta_tile_container_->copyTileStats(tile_stats_ + count_base_tiles_);
+        for (size_t i = 0; i < count_delta_tiles; ++i) {
+          tile_offsets_[count_base_tiles_ + i] =
+              delta_tile_container_->entry(i).offset_edge_block;
+        }
+      }
+      if (transposed_tile_container_ != NULL) {
+        transposed_tiles_fd_ = transposed_tile_container_->fd();
+        transposed_tile_container_->copyTileStats(tile_stats_ +
+                                                  count_forward_tiles_);
+        for (size_t i = 0; i < count_transposed_tiles; ++i) {
+          tile_offsets_[count_forward_tiles_ + i] =
+              transposed_tile_container_->entry(i).offset_edge_block;
+        }
       }
 
-      // only include weight-block if necessary
-      size_t size_edge_weights_block = 0;
-      if (is_weighted) {
-        size_edge_weights_block = sizeof(float) * tile_stats.count_edges;
+      // deleted edges of the base tiles are masked out while processing
+      std::string tombstones_file_name =
+          core::getTileTombstonesFileName(config_, 0);
+      if (resident_tiles != NULL) {
+        tile_tombstones_ = resident_tiles->tile_tombstones;
+      } else if (TileTombstones::exists(tombstones_file_name)) {
+        tile_tombstones_ = new TileTombstones();
+        tile_tombstones_->open(tombstones_file_name, tile_stats_,
+                               count_base_tiles_);
+      }
+      if (tile_tombstones_ != NULL) {
+        sg_log("Masking %lu deleted edges\n",
+               tile_tombstones_->countTombstones());
       }
 
-      size_t size_edge_block = sizeof(edge_block_t) + size_edge_src_block +
-                               size_edge_tgt_block + size_edge_weights_block;
+      // in the in-memory-mode, the tiles are served from the mapping
+      // directly instead of being copied into the local tiles ring buffer,
+      // resident containers are mapped already
+      if (config_.in_memory_mode && !tile_container_->isMapped()) {
+        for (TileContainer* container :
+             {tile_container_, delta_tile_container_,
+              transposed_tile_container_}) {
+          if (container != NULL) {
+            container->map();
+            if (config_.verify_tiles) {
+              container->verify();
+            }
+          }
+        }
+      }
+    } else {
+      std::string delta_tile_container_file_name =
+          core::getDeltaTileContainerFileName(config_, 0);
+      if (TileContainer::exists(delta_tile_container_file_name)) {
+        sg_err("Delta tiles %s require the base tiles in a tile container\n",
+               delta_tile_container_file_name.c_str());
+        util::die(1);
+      }
+      if (APP::need_transposed_tiles) {
+        sg_err("Transposed tiles require the tiles in a tile container, "
+               "missing %s\n",
+               tile_container_file_name.c_str());
+        util::die(1);
+      }
 
-      size_t size_rb_block = int_ceil(size_edge_block, PAGE_SIZE);
-      tile_offsets_[i] = tile_offsets_[i - 1] + size_rb_block;
+      // init fd of tiles-file
+      std::string tiles_file_name = core::getEdgeTileFileName(config_, 0);
+      tiles_fd_ = util::openFileDirectly(tiles_file_name);
+
+      // init tile_stats_
+      std::string global_tile_stats_file_name =
+          core::getGlobalTileStatsFileName(config_, 0);
+
+      size_t size_tile_stats = sizeof(tile_stats_t) * count_tiles_for_mic;
+      util::readDataFromFile(global_tile_stats_file_name, size_tile_stats,
+                             tile_stats_);
+
+      // pre-calculate the individual tile-offsets
+      tile_offsets_[0] = 0;
+      for (int i = 1; i < count_tiles_for_mic; ++i) {
+        // offset is the offset of the previous block plus the size of the
+        // previous block:
+        size_t size_edge_block =
+            core::getSizeEdgeBlock(tile_stats_[i - 1], is_weighted);
+        size_t size_rb_block = int_ceil(size_edge_block, PAGE_SIZE);
+        tile_offsets_[i] = tile_offsets_[i - 1] + size_rb_block;
+      }
     }
 
     // create ring buffers
@@ -147,9 +272,10 @@ namespace core {
           size_bool_array(((config_.count_tiles / config_.count_edge_processors) + 1));
 
 #if defined(MOSAIC_HOST_ONLY)
+      // a single VertexProcessor sends, a single TileReader receives
       rc = ring_buffer_create(size_tile_active_,
                               L1D_CACHELINE_SIZE,
-                              RING_BUFFER_BLOCKING,
+                              RING_BUFFER_BLOCKING | RING_BUFFER_SPSC,
                               NULL,
                               NULL,
                               &active_tiles_rb_);
@@ -159,8 +285,9 @@ namespace core {
 #else
       port += 10;
       rc = ring_buffer_scif_create_master(
-          size_tile_active_, L1D_CACHELINE_SIZE, RING_BUFFER_BLOCKING,
-          RING_BUFFER_SCIF_CONSUMER, NULL, NULL, &active_tiles_rb_);
+          size_tile_active_, L1D_CACHELINE_SIZE,
+          RING_BUFFER_BLOCKING | RING_BUFFER_SPSC, RING_BUFFER_SCIF_CONSUMER,
+          NULL, NULL, &active_tiles_rb_);
       if (rc) {
         scalable_graphs::util::die(1);
       }
@@ -212,8 +339,136 @@ namespace core {
     return count_active_tiles;
   }
 
+  template <class APP, typename TVertexType, bool is_weighted>
+  void
+  EdgeProcessor<APP, TVertexType, is_weighted>::writeMetrics(size_t iteration) {
+    uint64_t time_round_end_ns = util::get_time_nsec();
+    double time_round_sec = (time_round_end_ns - time_round_start_ns_) / 1e9;
+
+    uint64_t count_edges_read = perfmon_.count_edges_read_;
+    uint64_t count_edges_processed = perfmon_.count_edges_processed_;
+    uint64_t count_bytes_read = perfmon_.count_bytes_read_;
+    uint64_t count_tiles_read = perfmon_.count_tiles_read_;
+    uint64_t count_tiles_processed = perfmon_.count_tiles_processed_;
+    uint64_t edges_processed =
+        count_edges_processed - count_edges_processed_last_;
+
+    util::MetricsRecord record;
+    record.addCount("iteration", iteration);
+    record.addCount("mic_index", config_.mic_index);
+    record.addValue("time_ms", time_round_sec * 1000.);
+    record.addCount("edges_read", count_edges_read - count_edges_read_last_);
+    record.addCount("edges_processed", edges_processed);
+    record.addValue("edges_per_sec",
+                    time_round_sec > 0. ? edges_processed / time_round_sec
+                                        : 0.);
+    record.addCount("bytes_read", count_bytes_read - count_bytes_read_last_);
+    record.addCount("tiles_read", count_tiles_read - count_tiles_read_last_);
+    record.addCount("tiles_processed",
+                    count_tiles_processed - count_tiles_processed_last_);
+    record.addCount("active_tiles", perfmon_.count_active_tiles_);
+    record.addCount("inactive_tiles", perfmon_.count_inactive_tiles_);
+
+    // Only the producer side of a ring buffer tracks its high-water mark.
+    record.addCount("local_tiles_rb_high_water",
+                    ring_buffer_high_water(local_tiles_rb_));
+    ring_buffer_reset_high_water(local_tiles_rb_);
+#if defined(MOSAIC_HOST_ONLY)
+    record.addCount("processed_rb_high_water",
+                    ring_buffer_high_water(processed_rb_));
+    ring_buffer_reset_high_water(processed_rb_);
+#else
+    record.addCount("processed_rb_high_water",
+                    ring_buffer_scif_high_water(&processed_rb_));
+    ring_buffer_scif_reset_high_water(&processed_rb_);
+#endif
+
+    // Summed up over all waiting threads.
+    uint64_t time_tile_readers_barrier_ns =
+        perfmon_.time_tile_readers_barrier_ns_;
+    uint64_t time_tile_processors_barrier_ns =
+        perfmon_.time_tile_processors_barrier_ns_;
+    util::MetricsRecord barriers;
+    barriers.addValue("tile_readers_ms", (time_tile_readers_barrier_ns -
+                                          time_tile_readers_barrier_ns_last_) /
+                                             1e6);
+    barriers.addValue("tile_processors_ms",
+                      (time_tile_processors_barrier_ns -
+                       time_tile_processors_barrier_ns_last_) /
+                          1e6);
+    record.addRecord("barrier_wait", barriers);
+
+    metrics_.write(record);
+
+    time_round_start_ns_ = time_round_end_ns;
+    count_edges_read_last_ = count_edges_read;
+    count_edges_processed_last_ = count_edges_processed;
+    count_bytes_read_last_ = count_bytes_read;
+    count_tiles_read_last_ = count_tiles_read;
+    count_tiles_processed_last_ = count_tiles_processed;
+    time_tile_readers_barrier_ns_last_ = time_tile_readers_barrier_ns;
+    time_tile_processors_barrier_ns_last_ = time_tile_processors_barrier_ns;
+  }
+
+  template <class APP, typename TVertexType, bool is_weighted>
+  void EdgeProcessor<APP, TVertexType, is_weighted>::exportMetrics(
+      util::PrometheusText* text) {
+    std::string engine =
+        "edge_engine=\"" + std::to_string(config_.mic_index) + "\"";
+    text->addCounter("mosaic_edge_edges_read_total",
+                     "Edges read by the tile readers.", engine,
+                     perfmon_.count_edges_read_);
+    text->addCounter("mosaic_edge_edges_processed_total",
+                     "Edges processed by the tile processors.", engine,
+                     perfmon_.count_edges_processed_);
+    text->addCounter("mosaic_edge_bytes_read_total",
+                     "Bytes of tiles read by the tile readers.", engine,
+                     perfmon_.count_bytes_read_);
+    text->addCounter("mosaic_edge_tiles_read_total",
+                     "Tiles read by the tile readers.", engine,
+                     perfmon_.count_tiles_read_);
+    text->addCounter("mosaic_edge_tiles_processed_total",
+                     "Tiles processed by the tile processors.", engine,
+                     perfmon_.count_tiles_processed_);
+
+    const char* barrier_help =
+        "Time all threads waited at a barrier of the edge engine.";
+    text->addCounter("mosaic_edge_barrier_wait_seconds_total", barrier_help,
+                     engine + ",barrier=\"tile_readers\"",
+                     perfmon_.time_tile_readers_barrier_ns_ / 1e9);
+    text->addCounter("mosaic_edge_barrier_wait_seconds_total", barrier_help,
+                     engine + ",barrier=\"tile_processors\"",
+                     perfmon_.time_tile_processors_barrier_ns_ / 1e9);
+
+#if defined(MOSAIC_HOST_ONLY)
+    ring_buffer_t* processed_rb = processed_rb_;
+    ring_buffer_t* tiles_rb = tiles_rb_;
+#else
+    ring_buffer_t* processed_rb = processed_rb_.rb;
+    ring_buffer_t* tiles_rb = tiles_rb_.rb;
+#endif
+    std::pair<const char*, ring_buffer_t*> ring_buffers[] = {
+        {"local_tiles", local_tiles_rb_},
+        {"processed", processed_rb},
+        {"tiles", tiles_rb},
+    };
+    for (const auto& it : ring_buffers) {
+      std::string labels = engine + ",ring_buffer=\"" + it.first + "\"";
+      text->addGauge("mosaic_ring_buffer_used_bytes",
+                     "Bytes in use of a ring buffer.", labels,
+                     it.second->size - ring_buffer_free_space(it.second));
+      text->addGauge("mosaic_ring_buffer_size_bytes", "Size of a ring buffer.",
+                     labels, it.second->size);
+    }
+  }
+
   template <class APP, typename TVertexType, bool is_weighted>
   EdgeProcessor<APP, TVertexType, is_weighted>::~EdgeProcessor() {
+    if (metrics_source_id_ >= 0) {
+      util::MetricsExporter::getInstance(config_.metrics_address)
+          ->removeSource(metrics_source_id_);
+    }
+
     // destroy tile offset table
     munmap(tiles_offset_table_.data_info,
            sizeof(tiles_offset_table_.data_info[0]) * config_.count_tiles);
@@ -243,7 +498,15 @@ namespace core {
       delete[] tile_active_;
     }
 
-    close(tiles_fd_);
+    // the container owns the tiles-fd, resident ones outlive the engine
+    if (tile_container_ == NULL) {
+      close(tiles_fd_);
+    } else if (config_.resident_tiles == NULL) {
+      delete tile_container_;
+      delete delta_tile_container_;
+      delete transposed_tile_container_;
+      delete tile_tombstones_;
+    }
   }
 
   template <class APP, typename TVertexType, bool is_weighted>
@@ -258,6 +521,20 @@ namespace core {
       pe::PerfEventManager::getInstance(config_)->start();
     }
 
+    if (!config_.path_to_metrics.empty()) {
+      metrics_.open(config_.path_to_metrics + "edge_processor_" +
+                    std::to_string(config_.mic_index) + ".json");
+      time_round_start_ns_ = util::get_time_nsec();
+    }
+
+    if (!config_.metrics_address.empty()) {
+      metrics_source_id_ =
+          util::MetricsExporter::getInstance(config_.metrics_address)
+              ->addSource([this](util::PrometheusText* text) {
+                exportMetrics(text);
+              });
+    }
+
     scalable_graphs::util::cpu_id_t cpu_id(0, 0, 0);
     if (config_.run_on_mic) {
       // When running on the MIC, simply start from the offset CPU:
@@ -357,6 +634,7 @@ namespace core {
                          std::to_string(i));
       threads_.push_back(processor);
     }
+    return 0;
   }
 
   template <class APP, typename TVertexType, bool is_weighted>
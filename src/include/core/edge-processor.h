@@ -6,9 +6,12 @@
 #include <sys/mman.h>
 #include <util/runnable.h>
 #include <util/atomic_counter.h>
+#include <util/metrics.h>
+#include <util/metrics-exporter.h>
 #include <core/util.h>
 #include <ring_buffer.h>
 #include <core/datatypes.h>
+#include <core/tile-container.h>
 #include <core/tile-reader.h>
 #include <core/tile-processor.h>
 #include <core/edge-perfmon.h>
@@ -34,6 +37,13 @@ namespace core {
     void join();
     size_t updateActiveTiles();
 
+    // Writes the metrics record of the round that just ended, called by a
+    // single TileReader once all of them are done with the round.
+    void writeMetrics(size_t iteration);
+
+    // Adds the live metrics, called by the exporter thread.
+    void exportMetrics(util::PrometheusText* text);
+
     void shutdown();
 
     bool isShutdown();
@@ -64,6 +74,24 @@ namespace core {
     int tiles_fd_;
     size_t* tile_offsets_;
 
+    // delta tiles, local ids from count_base_tiles_ on
+    int delta_tiles_fd_;
+    size_t count_base_tiles_;
+
+    // transposed tiles, local ids from count_forward_tiles_ on
+    int transposed_tiles_fd_;
+    size_t count_forward_tiles_;
+
+    // set if the tiles are stored in a single-file container
+    TileContainer* tile_container_;
+
+    // set if post-grc-delta added tiles or deleted edges
+    TileContainer* delta_tile_container_;
+    TileTombstones* tile_tombstones_;
+
+    // set if APP::need_transposed_tiles
+    TileContainer* transposed_tile_container_;
+
     /*<--- selective sched */
     pthread_barrier_t barrier_tile_readers_;
 
@@ -88,6 +116,20 @@ namespace core {
     // In case of using the Fake or ConstantValue TileProcessor, the block ids
     // need to be distributed as an atomic counter.
     scalable_graphs::util::AtomicCounter fake_block_id_counter_;
+
+    // per-round metrics, if config_.path_to_metrics is set
+    util::MetricsWriter metrics_;
+    uint64_t time_round_start_ns_;
+    uint64_t count_edges_read_last_;
+    uint64_t count_edges_processed_last_;
+    uint64_t count_bytes_read_last_;
+    uint64_t count_tiles_read_last_;
+    uint64_t count_tiles_processed_last_;
+    uint64_t time_tile_readers_barrier_ns_last_;
+    uint64_t time_tile_processors_barrier_ns_last_;
+
+    // live metrics, if config_.metrics_address is set
+    int metrics_source_id_;
   };
 }
 }
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <core/datatypes.h>
+#include <core/vertex-domain.h>
+#include <core/edge-processor.h>
+
+namespace scalable_graphs {
+namespace core {
+  // Runs APP once on the host: starts one edge processor per edge engine and
+  // the vertex domain, waits for the run to end and tears all of them down
+  // again, so that the query server can call this once per query. Returns
+  // the count of iterations run.
+  template <class APP, typename TVertexType, typename TVertexIdType,
+            bool is_weighted>
+  size_t executeEngine(config_vertex_domain_t& config_vertex,
+                       const config_edge_processor_t& config_edge) {
+    // Start up all edge engines, then start vertex engine.
+    auto edge_processors = new EdgeProcessor<APP, TVertexType, is_weighted>*
+        [config_vertex.count_edge_processors];
+
+    // Start all edge processors.
+    for (int i = 0; i < config_vertex.count_edge_processors; ++i) {
+      config_edge_processor_t local_config_edge = config_edge;
+      local_config_edge.mic_index = i;
+      local_config_edge.paths_to_meta = {config_edge.paths_to_meta[i]};
+      local_config_edge.paths_to_tile = {config_edge.paths_to_tile[i]};
+      if (config_vertex.resident_graph != NULL) {
+        local_config_edge.resident_tiles =
+            &config_vertex.resident_graph->tiles[i];
+      }
+      auto edge_processor =
+          new EdgeProcessor<APP, TVertexType, is_weighted>(local_config_edge);
+      edge_processors[i] = edge_processor;
+
+      edge_processor->init();
+
+      ringbuffer_config_t ringbuffer_config =
+          edge_processor->getRingbufferConfig();
+      config_vertex.ringbuffer_configs[i] = ringbuffer_config;
+
+      sg_log("Started edge processor %d.\n", i);
+    }
+    sg_log2("Started all edge processors.\n");
+
+    VertexDomain<APP, TVertexType, TVertexIdType> vertex_domain(
+        config_vertex);
+    vertex_domain.init();
+    sg_log2("Init done\n");
+    vertex_domain.start();
+    sg_log2("Start done\n");
+
+    for (int i = 0; i < config_vertex.count_edge_processors; ++i) {
+      edge_processors[i]->initActiveTiles();
+      edge_processors[i]->start();
+    }
+
+    sg_log2("Started vertex processor.\n");
+
+    // Join all edge processors.
+    for (int i = 0; i < config_vertex.count_edge_processors; ++i) {
+      edge_processors[i]->join();
+    }
+    sg_log2("Joined all edge processors.\n");
+
+    vertex_domain.join();
+
+    sg_log2("Joined vertex processor.\n");
+
+    for (int i = 0; i < config_vertex.count_edge_processors; ++i) {
+      delete edge_processors[i];
+    }
+    delete[] edge_processors;
+
+    return vertex_domain.countIterations();
+  }
+}
+}
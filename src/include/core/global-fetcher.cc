@@ -48,8 +48,8 @@ namespace core {
       ctx_.initTimers();
     }
 
-    // wait for requests
-    ring_buffer_req_t request_fetch;
+    // wait for requests, claimed in batches and served one by one
+    ring_buffer_req_t requests_fetch[max_batch_requests_];
     ring_buffer_req_t request_response;
 
     size_t max_response_size =
@@ -65,54 +65,58 @@ namespace core {
 
     while (true) {
       sg_print("Waiting for fetch-request to global-array\n");
-      ring_buffer_get_req_init(&request_fetch, BLOCKING);
-      ring_buffer_get(request_rb_, &request_fetch);
-      sg_rb_check(&request_fetch);
-      sg_print("Got request to fetch vertices\n");
-
-      fetch_vertices_request_t* fetch_request =
-          (fetch_vertices_request_t*)request_fetch.data;
-
-      local_response->count_vertices = fetch_request->count_vertices;
-      local_response->block_id = fetch_request->block_id;
-
-      // allocate response
-      size_t size_response =
-          sizeof(fetch_vertices_response_t) +
-          sizeof(TVertexType) * fetch_request->count_vertices;
-
-      ring_buffer_put_req_init(&request_response, BLOCKING, size_response);
-      ring_buffer_put(fetch_request->response_ring_buffer, &request_response);
-      sg_rb_check(&request_response);
-      sg_dbg("Allocated response to fetch vertices into for block %lu\n",
-             fetch_request->block_id);
-
-      TVertexIdType* vertices =
-          get_array(TVertexIdType*, fetch_request,
-                    fetch_request->offset_request_vertices);
-
-      if (ctx_.config_.global_fetcher_mode == GlobalFetcherMode::GFM_Active) {
-        for (uint32_t i = 0; i < fetch_request->count_vertices; ++i) {
-          local_response_vertices[i] = vertices_->current[vertices[i]];
+      ring_buffer_get_req_init(&requests_fetch[0], BLOCKING);
+      int count_requests = ring_buffer_get_batch(request_rb_, requests_fetch,
+                                                 max_batch_requests_);
+      sg_rb_check(&requests_fetch[0]);
+      sg_dbg("Got %d requests to fetch vertices\n", count_requests);
+
+      for (int r = 0; r < count_requests; ++r) {
+        fetch_vertices_request_t* fetch_request =
+            (fetch_vertices_request_t*)requests_fetch[r].data;
+
+        local_response->count_vertices = fetch_request->count_vertices;
+        local_response->block_id = fetch_request->block_id;
+
+        // allocate response
+        size_t size_response =
+            sizeof(fetch_vertices_response_t) +
+            sizeof(TVertexType) * fetch_request->count_vertices;
+
+        ring_buffer_put_req_init(&request_response, BLOCKING, size_response);
+        ring_buffer_put(fetch_request->response_ring_buffer, &request_response);
+        sg_rb_check(&request_response);
+        sg_dbg("Allocated response to fetch vertices into for block %lu\n",
+               fetch_request->block_id);
+
+        TVertexIdType* vertices =
+            get_array(TVertexIdType*, fetch_request,
+                      fetch_request->offset_request_vertices);
+
+        if (ctx_.config_.global_fetcher_mode == GlobalFetcherMode::GFM_Active) {
+          for (uint32_t i = 0; i < fetch_request->count_vertices; ++i) {
+            local_response_vertices[i] = vertices_->current[vertices[i]];
+          }
+        } else if (ctx_.config_.global_fetcher_mode ==
+                   GlobalFetcherMode::GFM_ConstantValue) {
+          for (uint32_t i = 0; i < fetch_request->count_vertices; ++i) {
+            local_response_vertices[i] = 0.5;
+          }
         }
-      } else if (ctx_.config_.global_fetcher_mode ==
-                 GlobalFetcherMode::GFM_ConstantValue) {
-        for (uint32_t i = 0; i < fetch_request->count_vertices; ++i) {
-          local_response_vertices[i] = 0.5;
-        }
-      }
 
-      sg_dbg("Sending back response to fetch-request for block %lu \n",
-             fetch_request->block_id);
-      ring_buffer_elm_set_done(request_rb_, request_fetch.data);
-      copy_to_ring_buffer(fetch_request->response_ring_buffer,
-                          request_response.data, local_response, size_response);
-      ring_buffer_elm_set_ready(fetch_request->response_ring_buffer,
-                                request_response.data);
+        sg_dbg("Sending back response to fetch-request for block %lu \n",
+               fetch_request->block_id);
+        ring_buffer_elm_set_done(request_rb_, requests_fetch[r].data);
+        copy_to_ring_buffer(fetch_request->response_ring_buffer,
+                            request_response.data, local_response,
+                            size_response);
+        ring_buffer_elm_set_ready(fetch_request->response_ring_buffer,
+                                  request_response.data);
 #if !DO_PROCESSING_GF
-      ring_buffer_elm_set_done(fetch_request->response_ring_buffer,
-                               request_response.data);
+        ring_buffer_elm_set_done(fetch_request->response_ring_buffer,
+                                 request_response.data);
 #endif
+      }
     }
   }
 }
@@ -31,6 +31,7 @@ namespace core {
     thread_index_t thread_index_;
 
     const static size_t request_rb_size_ = 1ul * GB;
+    const static uint32_t max_batch_requests_ = 16;
   };
 }
 }
@@ -95,15 +95,16 @@ namespace core {
   }
 
   template <class APP, typename TVertexType, typename TVertexIdType>
-  void GlobalReducer<APP, TVertexType, TVertexIdType>::receive_reduce_block() {
+  int GlobalReducer<APP, TVertexType, TVertexIdType>::receive_reduce_blocks(
+      ring_buffer_req_t* requests) {
     // wait for responses
-    ring_buffer_req_t request_processed;
     sg_print("Waiting for aggregated responses\n");
-    ring_buffer_get_req_init(&request_processed, BLOCKING);
-    ring_buffer_get(response_rb_, &request_processed);
+    ring_buffer_get_req_init(&requests[0], BLOCKING);
+    int count_requests =
+        ring_buffer_get_batch(response_rb_, requests, max_batch_requests_);
 
-    sg_rb_check(&request_processed);
-    reduce_block_ = (processed_vertex_index_block_t*)request_processed.data;
+    sg_rb_check(&requests[0]);
+    return count_requests;
   }
 
   template <class APP, typename TVertexType, typename TVertexIdType>
@@ -249,16 +250,26 @@ namespace core {
     bool shutdown = false;
     int iteration = 0;
 
+    // reduce blocks are claimed in batches and processed one by one
+    ring_buffer_req_t requests[max_batch_requests_];
+    int count_requests = 0;
+    int index_request = 0;
+
     while (true) {
       int responses_received = 0;
 
       // make sure exactly $count_tiles many response-processors are waiting
       // on response per round
       while (responses_received < config_.count_tiles) {
-        receive_reduce_block();
+        if (index_request == count_requests) {
+          count_requests = receive_reduce_blocks(requests);
+          index_request = 0;
+        }
+        reduce_block_ =
+            (processed_vertex_index_block_t*)requests[index_request++].data;
 
         PerfEventScoped perf_event(
-            PerfEventManager::getInstance(config_)->getRingBuffer(), "tile",
+            PerfEventManager::getInstance(config_), "tile",
             ComponentType::CT_GlobalReducer, 0, thread_index_.id,
             reduce_block_->count_tgt_vertex_block, reduce_block_->block_id,
             config_.enable_perf_event_collection);
@@ -307,7 +318,8 @@ namespace core {
       sg_dbg("GlobalReducer %lu: Done for round %d\n", thread_index_.id,
              iteration);
 
-      pthread_barrier_wait(&ctx_.end_reduce_barrier_);
+      core::timedBarrierWait(&ctx_.end_reduce_barrier_,
+                             &ctx_.perfmon_.time_end_reduce_barrier_ns_);
     }
 
     sg_log("Shutdown GlobalReducer %lu\n", thread_index_.id);
@@ -11,6 +11,8 @@ namespace core {
   template <class APP, typename TVertexType, typename TVertexIdType>
   class VertexDomain;
 
+  class MicroBenchmark;
+
   template <class APP, typename TVertexType, typename TVertexIdType>
   class GlobalReducer : public scalable_graphs::util::Runnable {
   public:
@@ -28,11 +30,18 @@ namespace core {
     double average_processing_rate_;
 
   private:
+#ifndef TARGET_ARCH_K1OM
+    // enable the micro benchmarks to drive the kernels
+    friend class MicroBenchmark;
+#endif
+
     virtual void run();
 
     void init_memory();
 
-    void receive_reduce_block();
+    // Claim up to max_batch_requests_ reduce blocks with a single get, blocks
+    // until at least one is ready, returns the count claimed.
+    int receive_reduce_blocks(ring_buffer_req_t* requests);
 
     void process_source_vertices();
 
@@ -58,6 +67,7 @@ namespace core {
     uint32_t count_processing_times_;
 
     const static size_t processed_rb_size_ = 1ul * GB;
+    const static uint32_t max_batch_requests_ = 16;
   };
 }
 }
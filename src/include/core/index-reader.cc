@@ -52,6 +52,10 @@ namespace core {
     tiles_offset_table_ = ctx_.index_offset_table_;
     rb_ = ctx_.index_rb_;
     fd_ = ctx_.meta_fd_;
+    count_base_tiles_ = ctx_.count_base_tiles_;
+    delta_fd_ = ctx_.delta_meta_fd_;
+    count_forward_tiles_ = ctx_.count_forward_tiles_;
+    transposed_fd_ = ctx_.transposed_meta_fd_;
     reader_progress_ = &ctx_.index_reader_progress_;
   }
 
@@ -109,10 +113,18 @@ namespace core {
         // done with all tiles, wait for next round:
         sg_dbg("Index Reader Done with round %lu\n", prev_iter);
 
+        // In the in-memory-mode, all indices are read in the first round, this
+        // thread is not needed anymore and does not join the apply-barrier.
+        if (config_.in_memory_mode) {
+          break;
+        }
+
         if (config_.use_selective_scheduling) {
           // in selective scheduling, wait for the apply-period to end before
           // advancing to the next round
-          pthread_barrier_wait(&ctx_.vd_.end_apply_barrier_);
+          core::timedBarrierWait(
+              &ctx_.vd_.end_apply_barrier_,
+              &ctx_.vd_.perfmon_.time_end_apply_barrier_ns_);
 
           // In case of shutdown, break after the end_apply_barrier, set by the
           // VertexApplier.
@@ -126,19 +138,15 @@ namespace core {
           break;
         }
 
-        if (config_.in_memory_mode) {
-          fprintf(stderr, "[SG-LOG] break index reader");
-          break;
-        }
-
         // greeting a new iteration!
         sg_dbg("Index Reader Starting round %lu\n", cur_iter);
       }
       prev_iter = cur_iter;
 
       // if selective-scheduling is enabled,
-      // check if the file even should be read
-      if (config_.use_selective_scheduling) {
+      // check if the file even should be read, the in-memory-mode keeps all
+      // tiles
+      if (config_.use_selective_scheduling && !config_.in_memory_mode) {
         if (!eval_bool_array(ctx_.tile_active_current_, tile_id))
           continue;
         sg_dbg("index reader %d, active tiles %lu\n", ctx_.edge_engine_index_,
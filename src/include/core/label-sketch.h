@@ -0,0 +1,116 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <ostream>
+
+namespace scalable_graphs {
+namespace core {
+  // Vertex value of label propagation: the label of the vertex, the one it
+  // held before, and a heavy-hitter sketch of the labels voted for by its
+  // neighbors. The sketch keeps at most K labels (Space-Saving): a label not
+  // tracked yet takes over the entry with the smallest count and adds to that
+  // count, so every label occurring more than 1/K of all votes is tracked and
+  // its count is overestimated by at most the smallest count. Entries with a
+  // count of 0 are empty, an all-zero sketch is the empty one.
+  //
+  // Votes are withdrawn with a negative count. A withdrawn vote for a label
+  // not tracked is kept in an empty entry, so that it cancels out against the
+  // sketch it is merged into, and dropped if there is none. Entries with
+  // negative counts are never taken over and never win the majority.
+  template <size_t K>
+  struct label_sketch_t {
+    uint32_t label;
+    uint32_t previous_label;
+    uint32_t labels[K];
+    int32_t counts[K];
+
+    // all votes are dropped, the label stays
+    label_sketch_t& operator=(float value) {
+      clear();
+      return *this;
+    }
+
+    bool operator==(const label_sketch_t& other) const {
+      if (label != other.label || previous_label != other.previous_label) {
+        return false;
+      }
+      for (size_t i = 0; i < K; ++i) {
+        if (labels[i] != other.labels[i] || counts[i] != other.counts[i]) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    bool operator!=(const label_sketch_t& other) const {
+      return !(*this == other);
+    }
+
+    inline void clear() {
+      for (size_t i = 0; i < K; ++i) {
+        labels[i] = 0;
+        counts[i] = 0;
+      }
+    }
+
+    inline void add(uint32_t vote, int32_t count) {
+      size_t min_index = K;
+      for (size_t i = 0; i < K; ++i) {
+        if (counts[i] != 0 && labels[i] == vote) {
+          counts[i] += count;
+          return;
+        }
+        if (counts[i] >= 0 &&
+            (min_index == K || counts[i] < counts[min_index])) {
+          min_index = i;
+        }
+      }
+      if (min_index == K || (count < 0 && counts[min_index] != 0)) {
+        return;
+      }
+      labels[min_index] = vote;
+      counts[min_index] += count;
+    }
+
+    inline void merge(const label_sketch_t& other) {
+      for (size_t i = 0; i < K; ++i) {
+        if (other.counts[i] != 0) {
+          add(other.labels[i], other.counts[i]);
+        }
+      }
+    }
+
+    inline int32_t count(uint32_t vote) const {
+      for (size_t i = 0; i < K; ++i) {
+        if (counts[i] != 0 && labels[i] == vote) {
+          return counts[i];
+        }
+      }
+      return 0;
+    }
+
+    // Label with the most votes, ties go to the smaller label. Returns
+    // fallback if there are no votes at all.
+    inline uint32_t majority(uint32_t fallback) const {
+      uint32_t best_label = fallback;
+      int32_t best_count = 0;
+      for (size_t i = 0; i < K; ++i) {
+        if (counts[i] > best_count ||
+            (counts[i] == best_count && counts[i] > 0 &&
+             labels[i] < best_label)) {
+          best_label = labels[i];
+          best_count = counts[i];
+        }
+      }
+      return best_label;
+    }
+  };
+
+  // only the label, for the text output of the results
+  template <size_t K>
+  std::ostream& operator<<(std::ostream& stream, const label_sketch_t<K>& v) {
+    return stream << v.label;
+  }
+}
+}
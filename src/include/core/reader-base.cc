@@ -10,6 +10,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <util/arch.h>
+#include <ring_buffer_wait.h>
 
 #define DO_TILE_PROCESSING 1
 
@@ -18,7 +19,8 @@ namespace core {
 
   template <typename TData, typename TMetaData>
   ReaderBase<TData, TMetaData>::ReaderBase(const thread_index_t& thread_index)
-      : thread_index_(thread_index) {}
+      : thread_index_(thread_index), count_base_tiles_(SIZE_MAX),
+        delta_fd_(-1), count_forward_tiles_(SIZE_MAX), transposed_fd_(-1) {}
 
   template <typename TData, typename TMetaData>
   ReaderBase<TData, TMetaData>::~ReaderBase() {}
@@ -27,6 +29,19 @@ namespace core {
   size_t
   ReaderBase<TData, TMetaData>::read_a_batch_of_tiles(size_t start_tile_id,
                                                       size_t end_tile_id) {
+    // base, delta and transposed tiles live in different files, never mix
+    // them in one read
+    for (size_t boundary : {count_base_tiles_, count_forward_tiles_}) {
+      if (start_tile_id < boundary && end_tile_id > boundary) {
+        return read_a_batch_of_tiles(start_tile_id, boundary) +
+               read_a_batch_of_tiles(boundary, end_tile_id);
+      }
+    }
+    int fd = start_tile_id < count_base_tiles_
+                 ? fd_
+                 : start_tile_id < count_forward_tiles_ ? delta_fd_
+                                                        : transposed_fd_;
+
     // collect the information of tiles
     rdctx_.init();
     for (size_t tile_id = start_tile_id; tile_id < end_tile_id; ++tile_id) {
@@ -45,7 +60,7 @@ namespace core {
 
     // read a buldle of tiles from file
     void* bundle_raw = tiles_req.data;
-    util::readFileOffset(fd_, bundle_raw, rdctx_.total_len_,
+    util::readFileOffset(fd, bundle_raw, rdctx_.total_len_,
                          rdctx_.start_offset_);
 
     ring_buffer_elm_set_ready(rb_, tiles_req.data);
@@ -71,9 +86,7 @@ namespace core {
           &tiles_offset_table_.data_info[tile_id];
 
       // wait until previous tile_data is completely consumed
-      while (!smp_cas(&tile_info->meta.data_active, false, true)) {
-        pthread_yield();
-      }
+      rb_slot_acquire(&tile_info->meta.data_active);
       tile_info->data = data_block;
 
       // wait until previsous data is completely consumed
@@ -86,7 +99,7 @@ namespace core {
       tile_info->meta.bundle_refcnt = bundle_refcnt;
       tile_info->meta.bundle_raw = bundle_raw;
 
-      tile_info->meta.data_ready = true;
+      rb_event_set(&tile_info->meta.data_ready);
 
       sg_dbg("TR: Tile %lu ready for consumption (tid: %lu)\n", tile_id,
              thread_index_.id);
@@ -45,6 +45,17 @@ namespace core {
 
     int fd_;
 
+    // Tiles from count_base_tiles_ on are delta tiles, read from delta_fd_.
+    size_t count_base_tiles_;
+
+    int delta_fd_;
+
+    // Tiles from count_forward_tiles_ on are transposed tiles, read from
+    // transposed_fd_.
+    size_t count_forward_tiles_;
+
+    int transposed_fd_;
+
     size_t count_tiles_for_current_mic_;
 
     size_t num_batch_per_iter_;
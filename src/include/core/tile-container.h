@@ -0,0 +1,133 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <core/datatypes.h>
+
+namespace scalable_graphs {
+namespace core {
+  // Read-side of the single-file tile container (see tile_container_header_t).
+  // Out-of-core readers use fd() together with the entry offsets, in-memory
+  // mode maps the whole container and hands out pointers into the mapping.
+  class TileContainer {
+  public:
+    TileContainer();
+    ~TileContainer();
+
+    static bool exists(const std::string& file_name);
+
+    // Opens the container and validates header and entry table, dies on a
+    // corrupt or incompatible container.
+    void open(const std::string& file_name);
+
+    // Maps the complete container read-only, sharing the pages with the page
+    // cache, and asks the kernel to read it ahead.
+    void map();
+
+    // Checks the edge block and the index of a tile against the checksums of
+    // the entry table, requires map().
+    bool verifyTile(size_t tile_id) const;
+
+    // Checks all tiles with verifyTile(), dies on the first mismatch.
+    void verify() const;
+
+    void copyTileStats(tile_stats_t* tile_stats) const;
+
+    const edge_block_t* getEdgeBlock(size_t tile_id) const;
+
+    const edge_block_index_t* getEdgeBlockIndex(size_t tile_id) const;
+
+    // Buffered reads of single blocks for the offline tools, buffer has to
+    // hold the unpadded size of the block.
+    void readEdgeBlock(size_t tile_id, void* buffer) const;
+
+    void readEdgeBlockIndex(size_t tile_id, void* buffer) const;
+
+    inline const tile_container_header_t& header() const { return header_; }
+
+    inline const tile_container_entry_t& entry(size_t tile_id) const {
+      return entries_[tile_id];
+    }
+
+    inline size_t countTiles() const { return header_.count_tiles; }
+
+    inline bool isMapped() const { return mapping_ != NULL; }
+
+    // O_DIRECT file descriptor for aligned reads.
+    inline int fd() const { return direct_fd_; }
+
+  private:
+    std::string file_name_;
+    tile_container_header_t header_;
+    tile_container_entry_t* entries_;
+    int fd_;
+    int direct_fd_;
+    uint8_t* mapping_;
+  };
+
+  // Deleted edges of the base tiles of one edge engine (see
+  // tile_tombstones_header_t), expanded into one bool array per tile.
+  class TileTombstones {
+  public:
+    TileTombstones();
+    ~TileTombstones();
+
+    static bool exists(const std::string& file_name);
+
+    // Reads the tombstones and builds the masks, dies on a corrupt file or on
+    // tombstones outside of the given tiles.
+    void open(const std::string& file_name, const tile_stats_t* tile_stats,
+              size_t count_tiles);
+
+    // Returns NULL if no edge of the tile is deleted, the mask is indexed by
+    // the position of the edge in the src-block.
+    inline const char* getMask(size_t tile_id) const {
+      return tile_id < count_tiles_ ? masks_[tile_id] : NULL;
+    }
+
+    inline size_t countTombstones() const { return count_tombstones_; }
+
+    // Returns the count of tiles the tombstones were written for.
+    static size_t read(const std::string& file_name,
+                       std::vector<tile_tombstone_t>* tombstones);
+
+    // Sorts the tombstones and writes them.
+    static void write(const std::string& file_name, size_t count_tiles,
+                      std::vector<tile_tombstone_t>* tombstones);
+
+  private:
+    char** masks_;
+    size_t count_tiles_;
+    size_t count_tombstones_;
+  };
+
+  // Opens the transposed tiles of an edge engine (see post-grc-transposer),
+  // dies if they were not written.
+  TileContainer* openTransposedTileContainer(const config_t& config,
+                                             int meta_index);
+
+  // Write-side of the tile container. The layout is fully determined by the
+  // tile stats, so blocks can be written in any order.
+  class TileContainerWriter {
+  public:
+    TileContainerWriter(const std::string& file_name,
+                        const tile_stats_t* tile_stats, size_t count_tiles,
+                        bool is_weighted, bool is_index_32_bits);
+    ~TileContainerWriter();
+
+    void writeEdgeBlock(size_t tile_id, const edge_block_t* edge_block);
+
+    void writeEdgeBlockIndex(size_t tile_id,
+                             const edge_block_index_t* edge_block_index);
+
+    // Writes entry table and header, after all blocks have been written.
+    void close();
+
+  private:
+    std::string file_name_;
+    tile_container_header_t header_;
+    tile_container_entry_t* entries_;
+    int fd_;
+  };
+}
+}
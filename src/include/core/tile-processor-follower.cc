@@ -56,6 +56,7 @@ namespace core {
     extension_fields_ = tp_->extension_fields_;
 
     edge_block_ = tp_->edge_block_;
+    tombstones_ = tp_->tombstones_;
   }
 
   template <class APP, typename TVertexType, bool is_weighted>
@@ -134,10 +135,31 @@ namespace core {
     gettimeofday(&process_start, NULL);
 #endif
 
-    if (tile_stats_.use_rle) {
-      process_edges_range_rle(start, end);
-    } else {
-      process_edges_range_list(start, end);
+    if (tombstones_ != NULL) {
+      switch (tile_stats_.encoding) {
+      case TileEncoding::TE_RLE:
+        process_edges_range_rle<true>(start, end);
+        break;
+      case TileEncoding::TE_Bitmap:
+        process_edges_range_bitmap<true>(start, end);
+        break;
+      default:
+        process_edges_range_list<true>(start, end);
+        break;
+      }
+      return;
+    }
+
+    switch (tile_stats_.encoding) {
+    case TileEncoding::TE_RLE:
+      process_edges_range_rle<false>(start, end);
+      break;
+    case TileEncoding::TE_Bitmap:
+      process_edges_range_bitmap<false>(start, end);
+      break;
+    default:
+      process_edges_range_list<false>(start, end);
+      break;
     }
   }
 
@@ -171,6 +193,7 @@ namespace core {
   }
 
   template <class APP, typename TVertexType, bool is_weighted>
+  template <bool has_tombstones>
   void
   TileProcessorFollower<APP, TVertexType, is_weighted>::process_edges_range_rle(
       uint32_t start, uint32_t end) {
@@ -209,6 +232,13 @@ namespace core {
 
       // Loop all edges.
       for (uint32_t i = start_index; i < end_index; ++i) {
+        // Skip edges deleted since the last compaction.
+        if (has_tombstones && eval_bool_array(tombstones_, i)) {
+          core::advance_rle_offset_once(&tgt_count, &rle_offset,
+                                        tgt_block_rle);
+          continue;
+        }
+
         // get args
         local_vertex_id_t src_id = src_block[i];
 
@@ -250,6 +280,71 @@ namespace core {
   }
 
   template <class APP, typename TVertexType, bool is_weighted>
+  template <bool has_tombstones>
+  void TileProcessorFollower<APP, TVertexType, is_weighted>::
+      process_edges_range_bitmap(uint32_t start, uint32_t end) {
+    uint64_t* bitmap = get_array(uint64_t*, edge_block_, edge_block_->offset_src);
+    uint32_t* row_offsets =
+        get_array(uint32_t*, edge_block_, edge_block_->offset_tgt);
+    float* weight_block =
+        is_weighted ? get_array(float*, edge_block_, edge_block_->offset_weight)
+                    : NULL;
+    uint32_t words_per_row = BITMAP_WORDS_PER_ROW(tile_stats_.count_vertex_src);
+
+    // With the followers scheme, every thread operates on chunks of size
+    // EDGES_STRIPE_SIZE.
+    int thread_count = 1 + config_.count_followers;
+
+    uint32_t start_index = start + (1 + thread_index_.id) * EDGES_STRIPE_SIZE;
+    uint32_t end_index;
+    uint32_t offset = thread_count * EDGES_STRIPE_SIZE;
+    while (start_index < end) {
+      end_index = std::min(start_index + EDGES_STRIPE_SIZE, end);
+
+      // Loop all edges.
+      core::for_each_bitmap_edge(
+          bitmap, row_offsets, tile_stats_.count_vertex_tgt, words_per_row,
+          start_index, end_index,
+          [&](uint32_t i, local_vertex_id_t src_id, local_vertex_id_t tgt_id) {
+            // Skip edges deleted since the last compaction.
+            if (has_tombstones && eval_bool_array(tombstones_, i)) {
+              return;
+            }
+
+            if (APP::need_active_source_input) {
+              // Skip if source is inactive.
+              if (!eval_bool_array(active_vertices_src_, src_id)) {
+                return;
+              }
+            }
+
+            TVertexType& src = src_vertices_[src_id];
+            TVertexType& tgt = tgt_vertices_[tgt_id];
+            vertex_degree_t* src_degree =
+                APP::need_degrees_source_block ? &src_degrees_[src_id] : NULL;
+            vertex_degree_t* tgt_degree =
+                APP::need_degrees_target_block ? &tgt_degrees_[tgt_id] : NULL;
+
+            // pull-gather
+            if (is_weighted) {
+              APP::pullGatherWeighted(src, tgt, weight_block[i], src_id,
+                                      tgt_id, src_degree, tgt_degree,
+                                      active_vertices_src_next_,
+                                      active_vertices_tgt_next_, config_,
+                                      extension_fields_);
+            } else {
+              APP::pullGather(src, tgt, src_id, tgt_id, src_degree,
+                              tgt_degree, active_vertices_src_next_,
+                              active_vertices_tgt_next_, config_,
+                              extension_fields_);
+            }
+          });
+      start_index = start_index + offset;
+    }
+  }
+
+  template <class APP, typename TVertexType, bool is_weighted>
+  template <bool has_tombstones>
   void
   TileProcessorFollower<APP, TVertexType,
                         is_weighted>::process_edges_range_list(uint32_t start,
@@ -274,6 +369,11 @@ namespace core {
 
       // Loop all edges.
       for (uint32_t i = start_index; i < end_index; ++i) {
+        // Skip edges deleted since the last compaction.
+        if (has_tombstones && eval_bool_array(tombstones_, i)) {
+          continue;
+        }
+
         // get args
         local_vertex_id_t src_id = src_block[i];
 
@@ -328,10 +428,10 @@ namespace core {
       nedges_ = 0;
       {
         PerfEventScoped perf_event(
-            PerfEventManager::getInstance(config_)->getRingBuffer(),
-            "process_edges_follower", ComponentType::CT_TileProcessor,
-            config_.mic_index, tp_->thread_index_.id,
-            vertex_edge_block_->block_id, config_.enable_perf_event_collection);
+            PerfEventManager::getInstance(config_), "process_edges_follower",
+            ComponentType::CT_TileProcessor, config_.mic_index,
+            tp_->thread_index_.id, vertex_edge_block_->block_id,
+            config_.enable_perf_event_collection);
         nedges_ = process_edges();
       }
 
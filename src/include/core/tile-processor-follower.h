@@ -36,8 +36,13 @@ namespace core {
     void initData();
     uint32_t process_edges();
     void process_edges_range(uint32_t start, uint32_t end);
+    // see TileProcessor
+    template <bool has_tombstones>
     void process_edges_range_list(uint32_t start, uint32_t end);
+    template <bool has_tombstones>
     void process_edges_range_rle(uint32_t start, uint32_t end);
+    template <bool has_tombstones>
+    void process_edges_range_bitmap(uint32_t start, uint32_t end);
     uint32_t get_rle_offset(uint32_t start, uint32_t& tgt_count);
 
     void advance_rle_offset(uint32_t advance, uint32_t* tgt_count,
@@ -63,6 +68,7 @@ namespace core {
     TVertexType* src_vertices_;
     void* extension_fields_;
     edge_block_t* edge_block_;
+    const char* tombstones_;
   };
 }
 }
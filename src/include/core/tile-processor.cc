@@ -6,6 +6,7 @@
 #include <time.h>
 #include <sys/time.h>
 #include <unistd.h>
+#include <ring_buffer_wait.h>
 
 #include <util/perf-event/perf-event-manager.h>
 #include <util/perf-event/perf-event-scoped.h>
@@ -21,6 +22,8 @@ namespace core {
       EdgeProcessor<APP, TVertexType, is_weighted>& ctx,
       const thread_index_t& thread_index)
       : ctx_(ctx), thread_index_(thread_index), config_(ctx_.config_) {
+    tombstones_ = NULL;
+
     // Init the followers barrier, adding the TileProcessor and all its
     // followers.
     int count_barrier = 1 + config_.count_followers;
@@ -247,10 +250,7 @@ namespace core {
 
     // to avoid deadlock(starvation) sequence
     // wait until tile reader has filled ringbuffer
-    while (!tile_info_->meta.data_ready) {
-      pthread_yield();
-      smp_rmb();
-    }
+    rb_event_wait(&tile_info_->meta.data_ready);
 
     // if this processor is a leader, init the pointer offset table
     if (tile_partition_id_ == 0) {
@@ -262,7 +262,7 @@ namespace core {
       tile_info_->meta.fetch_refcnt = vertex_edge_block_->num_tile_partition;
       tile_info_->meta.process_refcnt = vertex_edge_block_->num_tile_partition;
       tile_info_->meta.tile_block = vertex_edge_block_;
-      smp_wmb();
+      rb_event_set(&tile_info_->meta.tile_block_ready);
     }
     // otherwise fetch the original
     else {
@@ -274,21 +274,18 @@ namespace core {
 #endif
 
       // fetch the tile block read by the leader, waiting for the leader to
-      // fill
-      // in the block
+      // fill in the block
+      rb_event_wait(&tile_info_->meta.tile_block_ready);
       vertex_edge_block_ =
           (vertex_edge_tiles_block_t*)tile_info_->meta.tile_block;
-      while (vertex_edge_block_ == NULL) {
-        pthread_yield();
-        smp_rmb();
-        vertex_edge_block_ =
-            (vertex_edge_tiles_block_t*)tile_info_->meta.tile_block;
-      }
     }
 
     // Now, we got a tile block
     sg_dbg("TP:Got tiles-block %lu!\n", block_id_);
     tile_stats_ = ctx_.tile_stats_[block_id_];
+    tombstones_ = ctx_.tile_tombstones_ != NULL
+                      ? ctx_.tile_tombstones_->getMask(block_id_)
+                      : NULL;
 
     // fix offset pointers
     size_active_vertex_src_block_ =
@@ -344,31 +341,33 @@ namespace core {
 
     sg_dbg("Got edges for block %lu\n", block_id_);
 
-    // only throw away loaded tile if not using the in-memory-mode
-    if (!config_.in_memory_mode) {
-      bool reset_cache = false;
-      // if a vertex_edge_block is completely fetched, reset the tile_info table
-      if (vertex_edge_block_->num_tile_partition > 1) {
-        // decrement fetch refcnt if there are multiple processors for this tile
-        uint32_t refcnt = smp_faa(&tile_info_->meta.fetch_refcnt, -1);
-        if (refcnt == 1) {
-          reset_cache = true;
-        }
-      } else {
-        // if it is the only one processor for this tile, reset is implied
+    bool reset_cache = false;
+    // if a vertex_edge_block is completely fetched, reset the tile_info table
+    if (vertex_edge_block_->num_tile_partition > 1) {
+      // decrement fetch refcnt if there are multiple processors for this tile
+      uint32_t refcnt = smp_faa(&tile_info_->meta.fetch_refcnt, -1);
+      if (refcnt == 1) {
         reset_cache = true;
       }
+    } else {
+      // if it is the only one processor for this tile, reset is implied
+      reset_cache = true;
+    }
 
-      // reset cache immediately, we only need the pointer once
-      if (reset_cache) {
-        tile_info_->meta.data_ready = false;
-        tile_info_->meta.data_active = false;
-        tile_info_->meta.tile_block = NULL;
-        sg_dbg("TP:tile %lu will be processed by %d processors\n", block_id_,
-               vertex_edge_block_->num_tile_partition);
+    // reset cache immediately, we only need the pointer once, the tile block
+    // is a new one every round also in the in-memory-mode
+    if (reset_cache) {
+      rb_event_reset(&tile_info_->meta.tile_block_ready);
+      tile_info_->meta.tile_block = NULL;
+      // only throw away loaded tile if not using the in-memory-mode
+      if (!config_.in_memory_mode) {
+        rb_event_reset(&tile_info_->meta.data_ready);
+        rb_slot_release(&tile_info_->meta.data_active);
       }
-      smp_wmb();
+      sg_dbg("TP:tile %lu will be processed by %d processors\n", block_id_,
+             vertex_edge_block_->num_tile_partition);
     }
+    smp_wmb();
 
 #if PROC_TIME_PROF
     gettimeofday(&get_tile_end, NULL);
@@ -420,10 +419,31 @@ namespace core {
     gettimeofday(&process_start, NULL);
 #endif
 
-    if (tile_stats_.use_rle) {
-      process_edges_range_rle(start, end);
-    } else {
-      process_edges_range_list(start, end);
+    if (tombstones_ != NULL) {
+      switch (tile_stats_.encoding) {
+      case TileEncoding::TE_RLE:
+        process_edges_range_rle<true>(start, end);
+        break;
+      case TileEncoding::TE_Bitmap:
+        process_edges_range_bitmap<true>(start, end);
+        break;
+      default:
+        process_edges_range_list<true>(start, end);
+        break;
+      }
+      return;
+    }
+
+    switch (tile_stats_.encoding) {
+    case TileEncoding::TE_RLE:
+      process_edges_range_rle<false>(start, end);
+      break;
+    case TileEncoding::TE_Bitmap:
+      process_edges_range_bitmap<false>(start, end);
+      break;
+    default:
+      process_edges_range_list<false>(start, end);
+      break;
     }
   }
 
@@ -457,6 +477,7 @@ namespace core {
   }
 
   template <class APP, typename TVertexType, bool is_weighted>
+  template <bool has_tombstones>
   void TileProcessor<APP, TVertexType, is_weighted>::process_edges_range_rle(
       uint32_t start, uint32_t end) {
     local_vertex_id_t* src_block =
@@ -487,6 +508,13 @@ namespace core {
 
       // Loop all edges.
       for (uint32_t i = start_index; i < end_index; ++i) {
+        // Skip edges deleted since the last compaction.
+        if (has_tombstones && eval_bool_array(tombstones_, i)) {
+          core::advance_rle_offset_once(&tgt_count, &rle_offset,
+                                        tgt_block_rle);
+          continue;
+        }
+
         // get args
         local_vertex_id_t src_id = src_block[i];
 
@@ -528,6 +556,71 @@ namespace core {
   }
 
   template <class APP, typename TVertexType, bool is_weighted>
+  template <bool has_tombstones>
+  void TileProcessor<APP, TVertexType, is_weighted>::process_edges_range_bitmap(
+      uint32_t start, uint32_t end) {
+    uint64_t* bitmap = get_array(uint64_t*, edge_block_, edge_block_->offset_src);
+    uint32_t* row_offsets =
+        get_array(uint32_t*, edge_block_, edge_block_->offset_tgt);
+    float* weight_block =
+        is_weighted ? get_array(float*, edge_block_, edge_block_->offset_weight)
+                    : NULL;
+    uint32_t words_per_row = BITMAP_WORDS_PER_ROW(tile_stats_.count_vertex_src);
+
+    // With the followers scheme, every thread operates on chunks of size
+    // EDGES_STRIPE_SIZE.
+    int thread_count = 1 + config_.count_followers;
+
+    uint32_t start_index = start;
+    uint32_t end_index;
+    uint32_t offset = thread_count * EDGES_STRIPE_SIZE;
+    while (start_index < end) {
+      end_index = std::min(start_index + EDGES_STRIPE_SIZE, end);
+
+      // Loop all edges.
+      core::for_each_bitmap_edge(
+          bitmap, row_offsets, tile_stats_.count_vertex_tgt, words_per_row,
+          start_index, end_index,
+          [&](uint32_t i, local_vertex_id_t src_id, local_vertex_id_t tgt_id) {
+            // Skip edges deleted since the last compaction.
+            if (has_tombstones && eval_bool_array(tombstones_, i)) {
+              return;
+            }
+
+            if (APP::need_active_source_input) {
+              // Skip if source is inactive.
+              if (!eval_bool_array(active_vertices_src_, src_id)) {
+                return;
+              }
+            }
+
+            TVertexType& src = src_vertices_[src_id];
+            TVertexType& tgt = tgt_vertices_[tgt_id];
+            vertex_degree_t* src_degree =
+                APP::need_degrees_source_block ? &src_degrees_[src_id] : NULL;
+            vertex_degree_t* tgt_degree =
+                APP::need_degrees_target_block ? &tgt_degrees_[tgt_id] : NULL;
+
+            // pull-gather
+            if (is_weighted) {
+              APP::pullGatherWeighted(src, tgt, weight_block[i], src_id,
+                                      tgt_id, src_degree, tgt_degree,
+                                      active_vertices_src_next_,
+                                      active_vertices_tgt_next_, config_,
+                                      extension_fields_);
+            } else {
+              APP::pullGather(src, tgt, src_id, tgt_id, src_degree,
+                              tgt_degree, active_vertices_src_next_,
+                              active_vertices_tgt_next_, config_,
+                              extension_fields_);
+            }
+          });
+      start_index = start_index + offset;
+    }
+  }
+
+  template <class APP, typename TVertexType, bool is_weighted>
+  template <bool has_tombstones>
   void TileProcessor<APP, TVertexType, is_weighted>::process_edges_range_list(
       uint32_t start, uint32_t end) {
     local_vertex_id_t* src_block =
@@ -550,6 +643,11 @@ namespace core {
 
       // Loop all edges.
       for (uint32_t i = start_index; i < end_index; ++i) {
+        // Skip edges deleted since the last compaction.
+        if (has_tombstones && eval_bool_array(tombstones_, i)) {
+          continue;
+        }
+
         // get args
         local_vertex_id_t src_id = src_block[i];
 
@@ -745,7 +843,7 @@ namespace core {
       uint32_t edges_for_partition = count_edges_current_tile();
 
       PerfEventScoped perf_event_tile(
-          PerfEventManager::getInstance(config_)->getRingBuffer(), "tile",
+          PerfEventManager::getInstance(config_), "tile",
           ComponentType::CT_TileProcessor, config_.mic_index, thread_index_.id,
           edges_for_partition, vertex_edge_block_->block_id,
           config_.enable_perf_event_collection);
@@ -760,7 +858,7 @@ namespace core {
 
       {
         PerfEventScoped perf_event(
-            PerfEventManager::getInstance(config_)->getRingBuffer(),
+            PerfEventManager::getInstance(config_),
             "get_vertex_edge_block", ComponentType::CT_TileProcessor,
             config_.mic_index, thread_index_.id, vertex_edge_block_->block_id,
             config_.enable_perf_event_collection);
@@ -768,7 +866,7 @@ namespace core {
       }
       {
         PerfEventScoped perf_event(
-            PerfEventManager::getInstance(config_)->getRingBuffer(),
+            PerfEventManager::getInstance(config_),
             "prepare_response", ComponentType::CT_TileProcessor,
             config_.mic_index, thread_index_.id, vertex_edge_block_->block_id,
             config_.enable_perf_event_collection);
@@ -776,7 +874,7 @@ namespace core {
       }
       {
         PerfEventScoped perf_event(
-            PerfEventManager::getInstance(config_)->getRingBuffer(),
+            PerfEventManager::getInstance(config_),
             "get_tile_data", ComponentType::CT_TileProcessor, config_.mic_index,
             thread_index_.id, vertex_edge_block_->block_id,
             config_.enable_perf_event_collection);
@@ -787,7 +885,7 @@ namespace core {
       uint32_t nedges;
       {
         PerfEventScoped perf_event(
-            PerfEventManager::getInstance(config_)->getRingBuffer(),
+            PerfEventManager::getInstance(config_),
             "process_edges", ComponentType::CT_TileProcessor, config_.mic_index,
             thread_index_.id, vertex_edge_block_->block_id,
             config_.enable_perf_event_collection);
@@ -795,7 +893,8 @@ namespace core {
       }
 
       // Wait for all the followers to be done.
-      pthread_barrier_wait(&tile_processor_barrier_);
+      core::timedBarrierWait(&tile_processor_barrier_,
+                             &ctx_.perfmon_.time_tile_processors_barrier_ns_);
       nedges += gather_follower_output();
 
       // Sample the end time, if instructed to do so, and copy the result to the
@@ -810,7 +909,7 @@ namespace core {
       }
       {
         PerfEventScoped perf_event(
-            PerfEventManager::getInstance(config_)->getRingBuffer(), "wrap_up",
+            PerfEventManager::getInstance(config_), "wrap_up",
             ComponentType::CT_TileProcessor, config_.mic_index,
             thread_index_.id, vertex_edge_block_->block_id,
             config_.enable_perf_event_collection);
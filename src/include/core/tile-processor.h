@@ -18,6 +18,8 @@ namespace core {
   template <class APP, typename TVertexType, bool is_weighted>
   class EdgeProcessor;
 
+  class MicroBenchmark;
+
   template <class APP, typename TVertexType, bool is_weighted>
   class TileProcessor : public scalable_graphs::util::Runnable {
   public:
@@ -31,6 +33,10 @@ namespace core {
     FRIEND_TEST(TileProcessorTest, GetRleOffset);
     FRIEND_TEST(TileProcessorTest, ProcessEdgesRangeList);
     FRIEND_TEST(TileProcessorTest, ProcessEdgesRangeRle);
+    FRIEND_TEST(TileProcessorTest, ProcessEdgesRangeBitmap);
+    FRIEND_TEST(TileProcessorTest, ProcessEdgesRangeTombstones);
+    // enable the micro benchmarks to drive the kernels
+    friend class MicroBenchmark;
 #endif
 
     virtual void run();
@@ -40,8 +46,14 @@ namespace core {
     void get_tile_data();
     uint32_t process_edges();
     void process_edges_range(uint32_t start, uint32_t end);
+    // The kernels only look at the tombstones if has_tombstones is set, tiles
+    // without deleted edges run the plain loops.
+    template <bool has_tombstones>
     void process_edges_range_list(uint32_t start, uint32_t end);
+    template <bool has_tombstones>
     void process_edges_range_rle(uint32_t start, uint32_t end);
+    template <bool has_tombstones>
+    void process_edges_range_bitmap(uint32_t start, uint32_t end);
     uint32_t get_rle_offset(uint32_t start, uint32_t& tgt_count);
     void wrap_up(uint32_t nedges);
 
@@ -83,6 +95,8 @@ namespace core {
     volatile size_t* bundle_refcnt_;
     edge_block_t* edge_block_;
     pointer_offset_t<edge_block_t, tile_data_edge_engine_t>* tile_info_;
+    // deleted edges of the current tile, NULL if there are none
+    const char* tombstones_;
 
     config_edge_processor_t config_;
 
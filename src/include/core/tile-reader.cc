@@ -4,6 +4,7 @@
 #pragma once
 
 #include <arch.h>
+#include <ring_buffer_wait.h>
 #include <assert.h>
 #include <util/read-context.h>
 
@@ -28,6 +29,14 @@ namespace core {
 
     fd_ = ctx_.tiles_fd_;
 
+    count_base_tiles_ = ctx_.count_base_tiles_;
+
+    delta_fd_ = ctx_.delta_tiles_fd_;
+
+    count_forward_tiles_ = ctx_.count_forward_tiles_;
+
+    transposed_fd_ = ctx_.transposed_tiles_fd_;
+
     count_tiles_for_current_mic_ =
         core::countTilesPerMic(config_, config_.mic_index);
 
@@ -63,26 +72,7 @@ namespace core {
     tile_stats_t tile_stats = ctx_.tile_stats_[tile_id];
 
     // calculate required space to fetch the tile
-    size_t size_edge_src_block =
-        sizeof(local_vertex_id_t) * tile_stats.count_edges;
-
-    size_t size_edge_tgt_block = size_edge_src_block;
-
-    // if using rle, take the tgt-block as the size times the
-    // vertex-count-struct
-    if (tile_stats.use_rle) {
-      size_edge_tgt_block =
-          sizeof(vertex_count_t) * tile_stats.count_vertex_tgt;
-    }
-
-    // only include weight-block if necessary
-    size_t size_edge_weights_block = 0;
-    if (is_weighted) {
-      size_edge_weights_block = sizeof(float) * tile_stats.count_edges;
-    }
-
-    size_t size_edge_block = sizeof(edge_block_t) + size_edge_src_block +
-                             size_edge_tgt_block + size_edge_weights_block;
+    size_t size_edge_block = core::getSizeEdgeBlock(tile_stats, is_weighted);
     size_t size_rb_block = int_ceil(size_edge_block, PAGE_SIZE);
 
     return size_rb_block;
@@ -104,11 +94,11 @@ namespace core {
       size_t tile_id = grab_a_tile(iteration);
 
       PerfEventScoped perf_event(
-          PerfEventManager::getInstance(config_)->getRingBuffer(), "tile",
+          PerfEventManager::getInstance(config_), "tile",
           ComponentType::CT_TileReader, config_.mic_index, thread_index_.id,
           tile_id, config_.enable_perf_event_collection);
 
-      if (config_.use_selective_scheduling) {
+      if (config_.use_selective_scheduling && !config_.in_memory_mode) {
         if (iteration != prev_iter) {
           // iteration control - need to update active tile list in each round
           // done with all tiles, wait for next round:
@@ -125,9 +115,14 @@ namespace core {
           }
 
           /*wait all tile reader before update active tile list */
-          int res = pthread_barrier_wait(barrier_);
+          int res = core::timedBarrierWait(
+              barrier_, &ctx_.perfmon_.time_tile_readers_barrier_ns_);
 
           if (res == PTHREAD_BARRIER_SERIAL_THREAD) {
+            if (ctx_.metrics_.isOpen()) {
+              ctx_.writeMetrics(iteration);
+            }
+
             /*update active tiles and stats */
             size_t count_active_tiles = ctx_.updateActiveTiles();
             // Count active tiles, shut down if converged (iff count == 0).
@@ -164,7 +159,9 @@ namespace core {
         break;
       }
 
-      if (config_.use_selective_scheduling) {
+      // the in-memory-mode reads all tiles once, inactive ones are needed in
+      // later rounds
+      if (config_.use_selective_scheduling && !config_.in_memory_mode) {
         if (!eval_bool_array(ctx_.tile_active_, tile_id)) {
           count_inactive_tiles++;
           // skip this tile
@@ -182,12 +179,60 @@ namespace core {
       size_t end_tile_id = std::min(start_tile_id + tile_batch_size_,
                                     count_tiles_for_current_mic_);
 
-      size_t bytes_read = read_a_batch_of_tiles(start_tile_id, end_tile_id);
+      size_t bytes_read;
+      if (ctx_.tile_container_ != NULL && ctx_.tile_container_->isMapped()) {
+        bytes_read = map_a_batch_of_tiles(start_tile_id, end_tile_id);
+      } else {
+        bytes_read = read_a_batch_of_tiles(start_tile_id, end_tile_id);
+      }
       publish_perfmon(start_tile_id, end_tile_id, bytes_read);
     }
     sg_log("Shutdown TileReader %lu\n", thread_index_.id);
   }
 
+  template <class APP, typename TVertexType, bool is_weighted>
+  size_t TileReader<APP, TVertexType, is_weighted>::map_a_batch_of_tiles(
+      size_t start_tile_id, size_t end_tile_id) {
+    size_t bytes_mapped = 0;
+    for (size_t tile_id = start_tile_id; tile_id < end_tile_id; ++tile_id) {
+      const TileContainer* container = ctx_.tile_container_;
+      size_t container_tile_id = tile_id;
+      if (tile_id >= count_forward_tiles_) {
+        container = ctx_.transposed_tile_container_;
+        container_tile_id = tile_id - count_forward_tiles_;
+      } else if (tile_id >= count_base_tiles_) {
+        container = ctx_.delta_tile_container_;
+        container_tile_id = tile_id - count_base_tiles_;
+      }
+
+      // The mapping is read-only, so the block id of the container is left
+      // as packed. The tile processors find the tile by the block id of the
+      // vertex-edge block and index the offset table with it, they never
+      // look at the block id of the edge block.
+      const edge_block_t* data_block =
+          container->getEdgeBlock(container_tile_id);
+
+      pointer_offset_t<edge_block_t, tile_data_edge_engine_t>* tile_info =
+          &tiles_offset_table_.data_info[tile_id];
+
+      rb_slot_acquire(&tile_info->meta.data_active);
+      tile_info->data = const_cast<edge_block_t*>(data_block);
+
+      // mapped tiles are never handed back to the local tiles ring buffer
+      tile_info->meta.bundle_refcnt = NULL;
+      tile_info->meta.bundle_raw = NULL;
+
+      rb_event_set(&tile_info->meta.data_ready);
+
+      bytes_mapped += container->entry(container_tile_id).size_edge_block;
+    }
+
+    // flush out changes
+    smp_wmb();
+
+    return bytes_mapped;
+  }
+
   template <class APP, typename TVertexType, bool is_weighted>
   void TileReader<APP, TVertexType, is_weighted>::publish_perfmon(
       size_t start_tile_id, size_t end_tile_id, size_t bytes_read) {
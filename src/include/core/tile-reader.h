@@ -31,6 +31,10 @@ namespace core {
     void publish_perfmon(size_t start_tile_id, size_t end_tile_id,
                          size_t bytes_read);
 
+    // In-memory mode on a mapped tile container: publish the mapped tiles
+    // instead of reading them, returns the bytes mapped.
+    size_t map_a_batch_of_tiles(size_t start_tile_id, size_t end_tile_id);
+
   private:
     const config_edge_processor_t config_;
 
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <core/datatypes.h>
+
+namespace scalable_graphs {
+namespace core {
+  // Exact triangle counting on the tiled graph, ignoring edge directions,
+  // self-loops and duplicate edges.
+  //
+  // Every edge is oriented from its smaller to its larger end and appended to
+  // the spill file of the row block of its smaller end, a row block covers
+  // vertices_per_block consecutive vertices like the partitions of the tiler.
+  // A row is built into a CSR of sorted neighbor lists when needed. Triangles
+  // u < v < w are counted once, as |N(u) & N(v)| for every edge (u, v): For
+  // row block i and every row block k >= i, the lists of the tile pair (i, k)
+  // are intersected with the ones of the tiles (k, j) of row k. Row i stays
+  // resident while the rows k stream past it, rows are kept up to
+  // size_resident bytes so that graphs fitting into memory are read once.
+  class TriangleCounter {
+  public:
+    TriangleCounter(uint64_t count_vertices, uint64_t vertices_per_block,
+                    size_t size_resident, const std::string& path_to_spill,
+                    int count_threads);
+    ~TriangleCounter();
+
+    // Adds the edges of all base and delta tiles of the tile containers,
+    // skipping tombstones.
+    void addTiles(const config_t& config, const scenario_stats_t& stats);
+
+    void addEdge(uint64_t src, uint64_t tgt);
+
+    uint64_t count();
+
+    // count of rows built from the spill files during count()
+    inline size_t countRowLoads() const { return count_row_loads_; }
+
+    // |a & b| of two strictly ascending lists.
+    static size_t intersect(const uint32_t* a, size_t size_a, const uint32_t* b,
+                            size_t size_b);
+
+  private:
+    struct Row {
+      uint64_t first_vertex;
+      // neighbors of vertex first_vertex + i are [offsets[i], offsets[i + 1])
+      std::vector<uint64_t> offsets;
+      std::vector<uint32_t> neighbors;
+    };
+
+    std::string getSpillFileName(uint64_t row) const;
+
+    void flushRow(uint64_t row);
+
+    const Row* getRow(uint64_t row, uint64_t pinned_row);
+
+    void evictRows(uint64_t pinned_row, uint64_t loaded_row);
+
+    static size_t sizeRow(const Row& row);
+
+  private:
+    uint64_t count_vertices_;
+    uint64_t vertices_per_block_;
+    uint64_t count_rows_;
+    size_t size_resident_;
+    std::string path_to_spill_;
+    int count_threads_;
+
+    // oriented edges not yet written to the spill file of their row
+    std::vector<std::vector<edge_t> > pending_;
+    size_t count_pending_;
+    std::vector<bool> spilled_;
+
+    std::map<uint64_t, Row*> rows_;
+    std::vector<uint64_t> recently_used_;
+    size_t size_rows_;
+    size_t count_row_loads_;
+  };
+}
+}
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include <vector>
 #include <fstream>
 #include <unordered_map>
+#include <pthread.h>
 #include <util/util.h>
 #include <core/datatypes.h>
 
@@ -33,6 +35,12 @@ namespace core {
   std::string getVertexToTileIndexFileName(const std::string& path_to_global);
   std::string getVertexToTileIndexFileName(const config_t& config);
 
+  // vertex-to-tile index of the transposed tiles, see post-grc-transposer
+  std::string
+  getTransposedVertexToTileCountFileName(const std::string& path_to_global);
+  std::string
+  getTransposedVertexToTileIndexFileName(const std::string& path_to_global);
+
   std::string getGlobalTileStatsFileName(const std::string& path_to_meta);
   std::string getGlobalTileStatsFileName(const config_t& config,
                                          const int mic_index);
@@ -56,6 +64,21 @@ namespace core {
 
   std::string getEdgeTileIndexFileName(const config_t& config, int meta_index);
 
+  std::string getTileContainerFileName(const std::string& path_to_tile);
+  std::string getTileContainerFileName(const config_t& config, int meta_index);
+
+  std::string getDeltaTileContainerFileName(const std::string& path_to_tile);
+  std::string getDeltaTileContainerFileName(const config_t& config,
+                                            int meta_index);
+
+  std::string getTileTombstonesFileName(const std::string& path_to_tile);
+  std::string getTileTombstonesFileName(const config_t& config, int meta_index);
+
+  std::string
+  getTransposedTileContainerFileName(const std::string& path_to_tile);
+  std::string getTransposedTileContainerFileName(const config_t& config,
+                                                 int meta_index);
+
   std::string getResultFileName(const std::string& path_to_output,
                                 int iteration);
 
@@ -71,6 +94,16 @@ namespace core {
 
   int countTilesPerMic(const config_t& config, const int mic_index);
 
+  // The engines of APPs with need_transposed_tiles see the forward tiles
+  // followed by their transposed copies, global tile id count_tiles + g is the
+  // copy of forward tile g.
+  template <typename TConfig>
+  TConfig withTransposedTiles(const TConfig& config) {
+    TConfig transposed_config = config;
+    transposed_config.count_tiles *= 2;
+    return transposed_config;
+  }
+
   int countTilesLowerMics(const config_t& config, const int mic_index);
 
   void initGrcConfig(config_grc_t* config, uint64_t count_vertices,
@@ -94,8 +127,63 @@ namespace core {
 
   size_t getMaxMetaPartitionEdgeCount();
 
+  // Sizes of the src- and tgt-block of an edge block in the encoding of the
+  // tile.
+  size_t getSizeEdgeSrcBlock(const tile_stats_t& tile_stats);
+
+  size_t getSizeEdgeTgtBlock(const tile_stats_t& tile_stats);
+
+  // Unpadded on-disk size of an edge block, PAGE_SIZE-padding is up to the
+  // caller.
+  size_t getSizeEdgeBlock(const tile_stats_t& tile_stats, bool is_weighted);
+
+  // Picks the smallest encoding for a tile of the given dimensions out of the
+  // allowed ones. A bitmap cannot hold the same edge twice, callers have to
+  // disallow it for tiles with duplicate edges.
+  TileEncoding chooseTileEncoding(uint32_t count_edges,
+                                  uint32_t count_vertex_src,
+                                  uint32_t count_vertex_tgt, bool use_rle,
+                                  bool use_bitmap);
+
+  // Unpadded on-disk size of an edge block index.
+  size_t getSizeEdgeBlockIndex(const tile_stats_t& tile_stats,
+                               bool is_index_32_bits);
+
   size_t getSizeTileBlock(const vertex_edge_tiles_block_sizes_t& sizes);
 
+  // Reads a file of raw edge_t records, as used for edge updates, dies if the
+  // size is not a multiple of an edge.
+  void readEdgeListFile(const std::string& file_name,
+                        std::vector<edge_t>* edges);
+
+  // Appends the vertex ids of a list separated by commas or whitespace, dies
+  // on anything but numbers.
+  void parseVertexList(const std::string& list, std::vector<uint64_t>* ids);
+
+  // Same as parseVertexList, but returns false instead of dying.
+  bool tryParseVertexList(const std::string& list, std::vector<uint64_t>* ids);
+
+  // Parses one line of the query server protocol, see query_t. Returns false
+  // and sets error on malformed input.
+  bool parseQuery(const std::string& line, query_t* query, std::string* error);
+
+  // Reads the degrees and, for selective scheduling, the vertex-to-tiles
+  // index of a graph into memory and opens the tile containers of all edge
+  // engines, mapped in the in-memory mode.
+  void loadResidentGraph(const config_vertex_domain_t& config,
+                         resident_graph_t* graph);
+
+  void freeResidentGraph(resident_graph_t* graph);
+
+  // Appends the vertex ids of a text file in the format of parseVertexList.
+  void readVertexListFile(const std::string& file_name,
+                          std::vector<uint64_t>* ids);
+
+  // Appends the whitespace-separated features of a text file, one per vertex
+  // in the order of the ids.
+  void readFeatureFile(const std::string& file_name,
+                       std::vector<float>* features);
+
   void fillTileBlockHeader(vertex_edge_tiles_block_t* tile_block,
                            uint64_t block_id, const tile_stats_t& tile_stats,
                            const vertex_edge_tiles_block_sizes_t& sizes,
@@ -136,6 +224,27 @@ namespace core {
     return sizes;
   }
 
+  // LRM_Atomic swaps whole vertex values, which only works for values of 4 or
+  // 8 bytes, larger ones like vertex_vector_t need LRM_Locking.
+  template <typename TVertexType>
+  inline bool isAtomicVertexType() {
+    return sizeof(TVertexType) == sizeof(uint32_t) ||
+           sizeof(TVertexType) == sizeof(uint64_t);
+  }
+
+  template <typename TVertexType>
+  inline bool casVertex(TVertexType* ptr, const TVertexType& old_value,
+                        const TVertexType& new_value) {
+    if (sizeof(TVertexType) == sizeof(uint64_t)) {
+      return smp_cas(reinterpret_cast<uint64_t*>(ptr),
+                     *reinterpret_cast<const uint64_t*>(&old_value),
+                     *reinterpret_cast<const uint64_t*>(&new_value));
+    }
+    return smp_cas(reinterpret_cast<uint32_t*>(ptr),
+                   *reinterpret_cast<const uint32_t*>(&old_value),
+                   *reinterpret_cast<const uint32_t*>(&new_value));
+  }
+
   template <class APP, typename TVertexType>
   vertex_edge_tiles_block_sizes_t
   getTileBlockSizes(const tile_stats_t& tile_stats) {
@@ -410,6 +519,15 @@ namespace core {
     return src_check && tgt_check;
   }
 
+  // pthread_barrier_wait(), adds the time spent waiting to *time_waited_ns.
+  inline int timedBarrierWait(pthread_barrier_t* barrier,
+                              uint64_t* time_waited_ns) {
+    uint64_t start = util::get_time_nsec();
+    int rc = pthread_barrier_wait(barrier);
+    smp_faa(time_waited_ns, util::get_time_nsec() - start);
+    return rc;
+  }
+
   inline int getEdgeEngineIndexFromTile(const config_vertex_domain_t& config,
                                         uint32_t tile_id) {
     return tile_id % config.count_edge_processors;
@@ -442,6 +560,108 @@ namespace core {
     }
   }
 
+  inline void set_bitmap_edge(uint64_t* bitmap, uint32_t words_per_row,
+                              local_vertex_id_t src, local_vertex_id_t tgt) {
+    bitmap[(size_t)tgt * words_per_row + src / 64] |= 1ul << (src % 64);
+  }
+
+  // Calls func(edge_id, src, tgt) for the edges [start, end) of a
+  // bitmap-encoded tile, in the order of the edge ids. Finds the row of the
+  // first edge via the row offsets, skips whole words by their popcount and
+  // then walks the set bits word by word.
+  template <typename TFunc>
+  inline void for_each_bitmap_edge(const uint64_t* bitmap,
+                                   const uint32_t* row_offsets,
+                                   uint32_t count_rows, uint32_t words_per_row,
+                                   uint32_t start, uint32_t end, TFunc func) {
+    if (start >= end) {
+      return;
+    }
+    uint32_t row =
+        (std::upper_bound(row_offsets, row_offsets + count_rows, start) -
+         row_offsets) -
+        1;
+    uint32_t edge_id = row_offsets[row];
+    const uint64_t* row_words = bitmap + (size_t)row * words_per_row;
+    uint32_t word_index = 0;
+    uint64_t word = row_words[0];
+
+    // skip the edges of this row before start
+    while (edge_id + __builtin_popcountll(word) <= start) {
+      edge_id += __builtin_popcountll(word);
+      word = row_words[++word_index];
+    }
+    for (; edge_id < start; ++edge_id) {
+      word &= word - 1;
+    }
+
+    while (edge_id < end) {
+      while (word == 0) {
+        if (++word_index == words_per_row) {
+          // rows are never empty, every local target has an edge
+          ++row;
+          row_words += words_per_row;
+          word_index = 0;
+        }
+        word = row_words[word_index];
+      }
+      uint32_t bit = __builtin_ctzll(word);
+      word &= word - 1;
+      func(edge_id, (local_vertex_id_t)(word_index * 64 + bit),
+           (local_vertex_id_t)row);
+      ++edge_id;
+    }
+  }
+
+  // Activates the pending vertices in [start, end) of the given bucket in
+  // active, see advanceBucket. Returns the count of vertices activated.
+  template <typename TFunc>
+  size_t activateBucket(vertex_buckets_t* buckets, char* active, size_t start,
+                        size_t end, uint32_t bucket, TFunc activate) {
+    size_t count_activated = 0;
+    for (size_t id = start; id < end; ++id) {
+      if (eval_bool_array(buckets->pending, id) &&
+          buckets->bucket[id] == bucket) {
+        set_bool_array(buckets->pending, id, false);
+        set_bool_array(active, id, true);
+        activate(id);
+        ++count_activated;
+      }
+    }
+    return count_activated;
+  }
+
+  // Moves on to the next bucket of delta-stepping once the current one is
+  // settled, i.e. no vertex is active anymore: the smallest pending bucket
+  // becomes the current one and its vertices become active in the
+  // current-array, activate(id) is called for each of them. Returns the count
+  // of vertices activated, 0 if vertices are still active or nothing is
+  // pending. The VertexAppliers do the same in parallel, see
+  // VertexApplier::advanceBucket.
+  template <typename TVertexType, typename TFunc>
+  size_t advanceBucket(vertex_array_t<TVertexType>* vertices, TFunc activate) {
+    for (size_t i = 0; i < vertices->size_active; ++i) {
+      if (vertices->active_current[i] != 0) {
+        return 0;
+      }
+    }
+
+    vertex_buckets_t* buckets = vertices->buckets;
+    uint32_t min_bucket = UINT32_MAX;
+    for (size_t id = 0; id < vertices->count; ++id) {
+      if (eval_bool_array(buckets->pending, id)) {
+        min_bucket = std::min(min_bucket, buckets->bucket[id]);
+      }
+    }
+    if (min_bucket == UINT32_MAX) {
+      return 0;
+    }
+
+    buckets->current = min_bucket;
+    return activateBucket(vertices->buckets, vertices->active_current, 0,
+                          vertices->count, min_bucket, activate);
+  }
+
   inline pthread_spinlock_t*
   getSpinlockForVertex(const vertex_id_t& vertex_id,
                        const vertex_lock_table_t& vertex_lock_table) {
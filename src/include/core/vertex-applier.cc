@@ -33,11 +33,24 @@ namespace core {
   template <class APP, typename TVertexType, typename TVertexIdType>
   VertexApplier<APP, TVertexType, TVertexIdType>::~VertexApplier() {
     free(local_active_tiles_);
+    delete[] local_partial_sums_;
   }
 
   template <class APP, typename TVertexType, typename TVertexIdType>
-  void VertexApplier<APP, TVertexType, TVertexIdType>::reduceActiveTiles() {
-    pthread_mutex_lock(&ctx_.active_tiles_mutex_);
+  void
+  VertexApplier<APP, TVertexType, TVertexIdType>::activateLocalTilesOfVertex(
+      size_t vertex_id) {
+    // set all tiles belonging to this vertex to active
+    size_t offset = ctx_.vertex_to_tiles_offset_[vertex_id];
+    for (int j = 0; j < ctx_.vertex_to_tiles_count_[vertex_id]; ++j) {
+      size_t global_offset = offset + j;
+      uint32_t tile_id = ctx_.vertex_to_tiles_index_[global_offset];
+      set_bool_array(local_active_tiles_, tile_id, true);
+    }
+  }
+
+  template <class APP, typename TVertexType, typename TVertexIdType>
+  void VertexApplier<APP, TVertexType, TVertexIdType>::applyLocalActiveTiles() {
     for (int tile_id = 0; tile_id < config_.count_tiles; ++tile_id) {
       if (eval_bool_array(local_active_tiles_, tile_id)) {
         // calculate edge-engine of this tile plus the local-tile-id
@@ -54,10 +67,50 @@ namespace core {
                        local_tile_id, true);
       }
     }
+  }
+
+  template <class APP, typename TVertexType, typename TVertexIdType>
+  void VertexApplier<APP, TVertexType, TVertexIdType>::reduceActiveTiles() {
+    pthread_mutex_lock(&ctx_.active_tiles_mutex_);
+    applyLocalActiveTiles();
+    ctx_.residual_ += local_residual_;
+    for (size_t i = 0; i < APP::count_partial_sums; ++i) {
+      vertices_->partial_sums[i] += local_partial_sums_[i];
+    }
+    if (APP::need_buckets) {
+      ctx_.count_active_vertices_ += local_count_active_vertices_;
+      ctx_.min_pending_bucket_ =
+          std::min(ctx_.min_pending_bucket_, local_min_pending_bucket_);
+    }
 
     pthread_mutex_unlock(&ctx_.active_tiles_mutex_);
   }
 
+  template <class APP, typename TVertexType, typename TVertexIdType>
+  void VertexApplier<APP, TVertexType, TVertexIdType>::advanceBucket(
+      const size_t offset, const size_t end) {
+    // the totals of all appliers are complete after the local apply barrier
+    uint32_t bucket = ctx_.min_pending_bucket_;
+    if (ctx_.count_active_vertices_ > 0 || bucket == UINT32_MAX) {
+      return;
+    }
+
+    initLocalActiveTiles();
+    // the next-array becomes the current one in resetRound
+    size_t count_activated = core::activateBucket(
+        vertices_->buckets, vertices_->active_next, offset, end, bucket,
+        [this](size_t vertex_id) {
+          if (config_.use_selective_scheduling) {
+            activateLocalTilesOfVertex(vertex_id);
+          }
+        });
+
+    pthread_mutex_lock(&ctx_.active_tiles_mutex_);
+    applyLocalActiveTiles();
+    ctx_.count_bucket_activated_ += count_activated;
+    pthread_mutex_unlock(&ctx_.active_tiles_mutex_);
+  }
+
   template <class APP, typename TVertexType, typename TVertexIdType>
   void VertexApplier<APP, TVertexType, TVertexIdType>::initLocalActiveTiles() {
     size_t size_active_tiles = size_bool_array(ctx_.config_.count_tiles);
@@ -68,28 +121,45 @@ namespace core {
   void VertexApplier<APP, TVertexType, TVertexIdType>::allocate() {
     size_t size_active_tiles = size_bool_array(ctx_.config_.count_tiles);
     local_active_tiles_ = (char*)malloc(size_active_tiles);
+    local_partial_sums_ = new double[APP::count_partial_sums];
   }
 
   template <class APP, typename TVertexType, typename TVertexIdType>
   void
   VertexApplier<APP, TVertexType, TVertexIdType>::apply(const size_t offset,
                                                         const size_t end) {
+    local_residual_ = 0.;
+    for (size_t i = 0; i < APP::count_partial_sums; ++i) {
+      local_partial_sums_[i] = 0.;
+    }
+    local_count_active_vertices_ = 0;
+    local_min_pending_bucket_ = UINT32_MAX;
     // execute apply-function on all vertices assigned to this processor:
     for (uint64_t i = offset; i < end; ++i) {
       // only execute apply-function if vertex is active currently or in the
       // next iterations
       APP::apply(vertices_, i, ctx_.config_, ctx_.iteration_);
+      if (APP::need_residual) {
+        local_residual_ += APP::residual(vertices_, i);
+      }
+      if (APP::count_partial_sums > 0) {
+        APP::accumulatePartialSums(vertices_, i, local_partial_sums_);
+      }
+
+      if (APP::need_buckets) {
+        if (eval_bool_array(vertices_->active_next, i)) {
+          ++local_count_active_vertices_;
+        }
+        if (eval_bool_array(vertices_->buckets->pending, i)) {
+          local_min_pending_bucket_ = std::min(local_min_pending_bucket_,
+                                               vertices_->buckets->bucket[i]);
+        }
+      }
 
       if (config_.use_selective_scheduling) {
         // Check if outgoing edges active the outgoing vertices/tiles.
         if (eval_bool_array(vertices_->active_next, i)) {
-          // set all tiles belonging to this vertex to active
-          size_t offset = ctx_.vertex_to_tiles_offset_[i];
-          for (int i = 0; i < ctx_.vertex_to_tiles_count_[i]; ++i) {
-            size_t global_offset = offset + i;
-            uint32_t tile_id = ctx_.vertex_to_tiles_index_[global_offset];
-            set_bool_array(local_active_tiles_, tile_id, true);
-          }
+          activateLocalTilesOfVertex(i);
         }
       }
     }
@@ -111,11 +181,12 @@ namespace core {
 
     while (true) {
       // first wait for all responses to be collected
-      pthread_barrier_wait(&ctx_.end_reduce_barrier_);
+      core::timedBarrierWait(&ctx_.end_reduce_barrier_,
+                             &ctx_.perfmon_.time_end_reduce_barrier_ns_);
       {
         PerfEventScoped perf_event(
-            PerfEventManager::getInstance(ctx_.config_)->getRingBuffer(),
-            "apply", ComponentType::CT_VertexApplier, 0, thread_index_.id,
+            PerfEventManager::getInstance(ctx_.config_), "apply",
+            ComponentType::CT_VertexApplier, 0, thread_index_.id,
             count_iteration, ctx_.config_.enable_perf_event_collection);
 
         sg_dbg("Applying the round %d\n", count_iteration);
@@ -127,7 +198,16 @@ namespace core {
 
         sg_dbg("Done applying for round %d\n", count_iteration);
       }
-      int barrier_rc = pthread_barrier_wait(&ctx_.local_apply_barrier_);
+      int barrier_rc = core::timedBarrierWait(
+          &ctx_.local_apply_barrier_,
+          &ctx_.perfmon_.time_local_apply_barrier_ns_);
+
+      if (APP::need_buckets) {
+        advanceBucket(offset, end);
+        barrier_rc = core::timedBarrierWait(
+            &ctx_.local_apply_barrier_,
+            &ctx_.perfmon_.time_local_apply_barrier_ns_);
+      }
 
       // if last thread, reset everything via the vertex-domain
       if (barrier_rc == PTHREAD_BARRIER_SERIAL_THREAD) {
@@ -135,7 +215,8 @@ namespace core {
       }
       pthread_barrier_wait(&ctx_.local_apply_barrier_);
 
-      pthread_barrier_wait(&ctx_.end_apply_barrier_);
+      core::timedBarrierWait(&ctx_.end_apply_barrier_,
+                             &ctx_.perfmon_.time_end_apply_barrier_ns_);
 
       // End the endless loop on shutdown, done.
       if (ctx_.isShutdown()) {
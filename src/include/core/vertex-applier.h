@@ -36,9 +36,21 @@ namespace core {
 
     void apply(const size_t offset, const size_t end);
 
-    // Apply the local_active_tiles_ onto the global counterpart.
+    void activateLocalTilesOfVertex(size_t vertex_id);
+
+    // Apply the local_active_tiles_ onto the global counterpart, requires the
+    // active_tiles_mutex_.
+    void applyLocalActiveTiles();
+
+    // Apply the local_active_tiles_ onto the global counterpart, add the
+    // local_residual_ and the local_partial_sums_ to the ones of the round.
     void reduceActiveTiles();
 
+    // APP::need_buckets only: once no vertex is active anymore after apply,
+    // activates the vertices of the smallest pending bucket in the
+    // next-array, every applier its share of the vertices.
+    void advanceBucket(const size_t offset, const size_t end);
+
   private:
     config_vertex_domain_t config_;
     VertexDomain<APP, TVertexType, TVertexIdType>& ctx_;
@@ -46,6 +58,12 @@ namespace core {
     thread_index_t thread_index_;
 
     char* local_active_tiles_;
+    double local_residual_;
+    // APP::need_buckets only
+    size_t local_count_active_vertices_;
+    uint32_t local_min_pending_bucket_;
+    // this thread's share of the APP::count_partial_sums
+    double* local_partial_sums_;
   };
 }
 }
@@ -37,16 +37,34 @@ namespace core {
 
     // sync with host
     pthread_barrier_wait(args->barrier);
+    return NULL;
   }
 
   template <class APP, typename TVertexType, typename TVertexIdType>
   VertexDomain<APP, TVertexType, TVertexIdType>::VertexDomain(
       const config_vertex_domain_t& config)
-      : shutdown_(false), config_(config), iteration_(0),
-        tile_break_point_(INIT_TILE_BREAK_POINT) {
+      : shutdown_(false),
+        config_(APP::need_transposed_tiles ? withTransposedTiles(config)
+                                           : config),
+        global_reducers_(NULL), global_fetchers_(NULL), vertices_(NULL),
+        count_forward_tiles_(config.count_tiles), iteration_(0), residual_(0.),
+        count_active_vertices_(0), min_pending_bucket_(UINT32_MAX),
+        count_bucket_activated_(0),
+        tile_break_point_(INIT_TILE_BREAK_POINT),
+        time_end_reduce_barrier_ns_last_(0),
+        time_local_apply_barrier_ns_last_(0),
+        time_end_apply_barrier_ns_last_(0), metrics_source_id_(-1) {
+    memset(&round_status_, 0, sizeof(round_status_));
+    if (config_.local_reducer_mode == LocalReducerMode::LRM_Atomic &&
+        !isAtomicVertexType<TVertexType>()) {
+      sg_log("Vertex values of %lu bytes can not be swapped atomically, "
+             "falling back to locking\n",
+             sizeof(TVertexType));
+      config_.local_reducer_mode = LocalReducerMode::LRM_Locking;
+    }
     for (int i = 0; i < config.count_edge_processors; ++i) {
       // adjust the port to be spaced by 100 between different MICs
-      config_vertex_domain_t vp_config = config;
+      config_vertex_domain_t vp_config = config_;
       vp_config.port = config.port + i * 100;
       int node_id = 0;
       if (config.run_on_mic) {
@@ -64,7 +82,42 @@ namespace core {
 
   template <class APP, typename TVertexType, typename TVertexIdType>
   VertexDomain<APP, TVertexType, TVertexIdType>::~VertexDomain() {
-    // TODO: Cleanup
+    if (metrics_source_id_ >= 0) {
+      util::MetricsExporter::getInstance(config_.metrics_address)
+          ->removeSource(metrics_source_id_);
+    }
+    // the query server runs many engines in one process
+    for (auto& it : vp_) {
+      delete it;
+    }
+    delete[] global_reducers_;
+    delete[] global_fetchers_;
+    if (config_.use_selective_scheduling &&
+        config_.resident_graph == NULL) {
+      delete[] vertex_to_tiles_offset_;
+      delete[] vertex_to_tiles_count_;
+      delete[] vertex_to_tiles_index_;
+    }
+    if (config_.local_reducer_mode == LocalReducerMode::LRM_Locking) {
+      delete[] vertex_lock_table.locks;
+    }
+
+    if (vertices_ == NULL) {
+      return;
+    }
+    delete[] vertices_->degrees;
+    delete[] vertices_->current;
+    delete[] vertices_->next;
+    delete[] vertices_->active_current;
+    delete[] vertices_->active_next;
+    delete[] vertices_->changed;
+    if (vertices_->buckets != NULL) {
+      delete[] vertices_->buckets->pending;
+      delete[] vertices_->buckets->bucket;
+      delete vertices_->buckets;
+    }
+    delete[] vertices_->partial_sums;
+    delete vertices_;
   }
 
   template <class APP, typename TVertexType, typename TVertexIdType>
@@ -79,7 +132,11 @@ namespace core {
 
     // only load vertex-to-tiles indices when running in selective-scheduling
     // mode:
-    if (config_.use_selective_scheduling) {
+    if (config_.use_selective_scheduling && config_.resident_graph != NULL) {
+      vertex_to_tiles_offset_ = config_.resident_graph->vertex_to_tiles_offset;
+      vertex_to_tiles_count_ = config_.resident_graph->vertex_to_tiles_count;
+      vertex_to_tiles_index_ = config_.resident_graph->vertex_to_tiles_index;
+    } else if (config_.use_selective_scheduling) {
       vertex_to_tiles_offset_ = new size_t[config_.count_vertices];
       vertex_to_tiles_count_ = new uint32_t[config_.count_vertices];
 
@@ -95,7 +152,7 @@ namespace core {
 
       for (size_t i = 1; i < config_.count_vertices; ++i) {
         vertex_to_tiles_offset_[i] =
-            vertex_to_tiles_offset_[i - 1] + vertex_to_tiles_count_[i];
+            vertex_to_tiles_offset_[i - 1] + vertex_to_tiles_count_[i - 1];
         global_vertex_to_tiles_count += vertex_to_tiles_count_[i];
       }
 
@@ -112,6 +169,16 @@ namespace core {
                              vertex_to_tiles_index_);
     }
 
+    if (config_.use_selective_scheduling && APP::need_transposed_tiles) {
+      if (config_.resident_graph != NULL) {
+        sg_err("The resident graph holds no index of the transposed tiles "
+               "for %s\n",
+               config_.algorithm.c_str());
+        util::die(1);
+      }
+      mergeTransposedTileIndex();
+    }
+
     initVertexArray();
 
     // For the reduce-barrier we have to wait for all global reducers to arrive,
@@ -127,8 +194,9 @@ namespace core {
 
     // in selective scheduling mode,
     // index reader and reducer should wait until
-    // it update active tiles correctly
-    if (config_.use_selective_scheduling) {
+    // it update active tiles correctly, in the in-memory-mode the index
+    // readers are done after the first round
+    if (config_.use_selective_scheduling && !config_.in_memory_mode) {
       count_apply_barrier +=
           config_.count_edge_processors *
           config_.count_index_readers; // this for index readers
@@ -182,6 +250,7 @@ namespace core {
     }
 
     sg_log2("Intialization done\n");
+    return 0;
   }
 
   template <class APP, typename TVertexType, typename TVertexIdType>
@@ -196,6 +265,18 @@ namespace core {
       pe::PerfEventManager::getInstance(config_)->start();
     }
 
+    if (!config_.path_to_metrics.empty()) {
+      metrics_.open(config_.path_to_metrics + "vertex_domain.json");
+    }
+
+    if (!config_.metrics_address.empty()) {
+      metrics_source_id_ =
+          util::MetricsExporter::getInstance(config_.metrics_address)
+              ->addSource([this](util::PrometheusText* text) {
+                exportMetrics(text);
+              });
+    }
+
     // launch vertex appliers
     for (int i = 0; i < config_.count_vertex_appliers; ++i) {
       thread_index_t thread_index;
@@ -268,6 +349,7 @@ namespace core {
         it->joinIndexReaders();
       }
     }
+    return 0;
   }
 
   template <class APP, typename TVertexType, typename TVertexIdType>
@@ -322,6 +404,17 @@ namespace core {
       pe::PerfEventManager::getInstance(config_)->stop();
       sg_print("EventManager is exiting\n");
     }
+
+    if (!config_.path_to_result.empty()) {
+      sg_log("Writing result to %s\n", config_.path_to_result.c_str());
+      util::writeDataToFile(config_.path_to_result, vertices_->current,
+                            sizeof(TVertexType) * vertices_->count);
+    }
+  }
+
+  template <class APP, typename TVertexType, typename TVertexIdType>
+  size_t VertexDomain<APP, TVertexType, TVertexIdType>::countIterations() {
+    return iteration_;
   }
 
   template <class APP, typename TVertexType, typename TVertexIdType>
@@ -342,22 +435,146 @@ namespace core {
     vertices_->active_next = new char[size_active_array];
 
     vertices_->changed = new char[size_active_array];
+
+    vertices_->buckets = NULL;
+    if (APP::need_buckets) {
+      vertices_->buckets = new vertex_buckets_t;
+      vertices_->buckets->pending = new char[size_active_array];
+      vertices_->buckets->bucket = new uint32_t[config_.count_vertices];
+      vertices_->buckets->current = 0;
+      memset(vertices_->buckets->pending, 0, size_active_array);
+    }
+
+    vertices_->direction = TileDirection::TD_Forward;
+
+    vertices_->partial_sums = NULL;
+    if (APP::count_partial_sums > 0) {
+      vertices_->partial_sums = new double[APP::count_partial_sums]();
+    }
+  }
+
+  template <class APP, typename TVertexType, typename TVertexIdType>
+  void
+  VertexDomain<APP, TVertexType, TVertexIdType>::mergeTransposedTileIndex() {
+    // the transposed tiles of a vertex follow its forward tiles
+    uint32_t* transposed_count = new uint32_t[config_.count_vertices];
+    util::readDataFromFile(
+        core::getTransposedVertexToTileCountFileName(config_.path_to_globals),
+        config_.count_vertices * sizeof(uint32_t), transposed_count);
+
+    size_t count_forward = 0;
+    size_t count_transposed = 0;
+    for (size_t i = 0; i < config_.count_vertices; ++i) {
+      count_forward += vertex_to_tiles_count_[i];
+      count_transposed += transposed_count[i];
+    }
+
+    uint32_t* transposed_index = new uint32_t[count_transposed];
+    util::readDataFromFile(
+        core::getTransposedVertexToTileIndexFileName(config_.path_to_globals),
+        count_transposed * sizeof(uint32_t), transposed_index);
+
+    uint32_t* index = new uint32_t[count_forward + count_transposed];
+    size_t offset = 0;
+    size_t transposed_offset = 0;
+    for (size_t i = 0; i < config_.count_vertices; ++i) {
+      memcpy(index + offset,
+             vertex_to_tiles_index_ + vertex_to_tiles_offset_[i],
+             vertex_to_tiles_count_[i] * sizeof(uint32_t));
+      memcpy(index + offset + vertex_to_tiles_count_[i],
+             transposed_index + transposed_offset,
+             transposed_count[i] * sizeof(uint32_t));
+      vertex_to_tiles_offset_[i] = offset;
+      vertex_to_tiles_count_[i] += transposed_count[i];
+      offset += vertex_to_tiles_count_[i];
+      transposed_offset += transposed_count[i];
+    }
+
+    delete[] vertex_to_tiles_index_;
+    delete[] transposed_index;
+    delete[] transposed_count;
+    vertex_to_tiles_index_ = index;
+    sg_log("Merged %lu transposed into %lu forward vertex-to-tile entries\n",
+           count_transposed, count_forward);
   }
 
   template <class APP, typename TVertexType, typename TVertexIdType>
   void VertexDomain<APP, TVertexType, TVertexIdType>::initAlgorithm() {
     // read degrees into global array
     size_t degree_filesize = sizeof(vertex_degree_t) * config_.count_vertices;
-    std::string degree_filename = core::getVertexDegreeFileName(config_);
-    util::readDataFromFile(degree_filename, degree_filesize,
-                           vertices_->degrees);
+    if (config_.resident_graph != NULL) {
+      memcpy(vertices_->degrees, config_.resident_graph->degrees,
+             degree_filesize);
+    } else {
+      std::string degree_filename = core::getVertexDegreeFileName(config_);
+      util::readDataFromFile(degree_filename, degree_filesize,
+                             vertices_->degrees);
+    }
 
-    // let algorithm init vertex-array
-    // TODO: pass args
-    APP::init_vertices(vertices_, NULL);
+    for (uint64_t root : config_.roots) {
+      if (root >= config_.count_vertices) {
+        sg_err("Root %lu out of range of %lu vertices\n", root,
+               config_.count_vertices);
+        util::die(1);
+      }
+    }
+    if (!config_.features.empty() &&
+        config_.features.size() != config_.count_vertices) {
+      sg_err("Got %lu features for %lu vertices\n", config_.features.size(),
+             config_.count_vertices);
+      util::die(1);
+    }
+    init_args_t args;
+    args.roots = config_.roots.data();
+    args.count_roots = config_.roots.size();
+    args.incremental = NULL;
+    args.features = config_.features.data();
+    args.count_features = config_.features.size();
+
+    // let algorithm init vertex-array, either from scratch or from the result
+    // of a previous run
+    if (config_.path_to_incremental_input.empty()) {
+      APP::init_vertices(vertices_, &args);
+    } else {
+      std::vector<char> previous_vertices(
+          util::getFileSize(config_.path_to_incremental_input));
+      util::readDataFromFile(config_.path_to_incremental_input,
+                             previous_vertices.size(),
+                             previous_vertices.data());
+
+      std::vector<edge_t> insertions;
+      std::vector<edge_t> deletions;
+      if (!config_.path_to_incremental_insertions.empty()) {
+        core::readEdgeListFile(config_.path_to_incremental_insertions,
+                               &insertions);
+      }
+      if (!config_.path_to_incremental_deletions.empty()) {
+        core::readEdgeListFile(config_.path_to_incremental_deletions,
+                               &deletions);
+      }
+      sg_log("Incremental run from %s, %lu inserted and %lu deleted edges\n",
+             config_.path_to_incremental_input.c_str(), insertions.size(),
+             deletions.size());
+
+      incremental_args_t incremental;
+      incremental.previous_vertices = previous_vertices.data();
+      incremental.size_previous_vertices = previous_vertices.size();
+      incremental.insertions = insertions.data();
+      incremental.count_insertions = insertions.size();
+      incremental.deletions = deletions.data();
+      incremental.count_deletions = deletions.size();
+      args.incremental = &incremental;
+      APP::init_vertices(vertices_, &args);
+    }
 
     // give APP the chance to initialize before the first round as well
     APP::pre_processing_per_round(vertices_, config_, iteration_);
+
+    // without selective scheduling all tiles are read in every round, only
+    // checks the direction
+    if (APP::need_transposed_tiles && !config_.use_selective_scheduling) {
+      applyTileDirection(false);
+    }
   }
 
   template <class APP, typename TVertexType, typename TVertexIdType>
@@ -375,43 +592,73 @@ namespace core {
 
       // active_status = true;
       if (active_status) {
-        // set all tiles belonging to this vertex to active
-        size_t offset = vertex_to_tiles_offset_[vertex_id];
-        for (int i = 0; i < vertex_to_tiles_count_[vertex_id]; ++i) {
-          size_t global_offset = offset + i;
-          uint32_t tile_id = vertex_to_tiles_index_[global_offset];
-          // calculate edge-engine of this tile plus the local-tile-id
-
-          if (tile_id > config_.count_tiles) {
-            sg_log("tile id %u exceed count_tiles bound\n", tile_id);
-            sg_assert(0, "tile id exceed count_tiles bound");
-          }
-
-          int edge_engine_index =
-              core::getEdgeEngineIndexFromTile(config_, tile_id);
-
-          uint32_t local_tile_id = core::getLocalTileId(config_, tile_id);
-
-          set_bool_array(vp_[edge_engine_index]->tile_active_current_,
-                         local_tile_id, true);
-        }
+        activateTilesOfVertex(vertex_id, false);
       }
     }
+    if (APP::need_transposed_tiles) {
+      applyTileDirection(false);
+    }
     sg_print("Done init active tiles \n");
   }
 
   template <class APP, typename TVertexType, typename TVertexIdType>
-  size_t VertexDomain<APP, TVertexType, TVertexIdType>::countActiveVertices() {
-    size_t count_active_vertices = 0;
-
-    for (size_t vertex_id = 0; vertex_id < config_.count_vertices;
-         ++vertex_id) {
-      if (eval_bool_array(vertices_->active_current, vertex_id)) {
-        ++count_active_vertices;
+  void VertexDomain<APP, TVertexType, TVertexIdType>::activateTilesOfVertex(
+      size_t vertex_id, bool next_round) {
+    // set all tiles belonging to this vertex to active
+    size_t offset = vertex_to_tiles_offset_[vertex_id];
+    for (int i = 0; i < vertex_to_tiles_count_[vertex_id]; ++i) {
+      size_t global_offset = offset + i;
+      uint32_t tile_id = vertex_to_tiles_index_[global_offset];
+      // calculate edge-engine of this tile plus the local-tile-id
+
+      if (tile_id > config_.count_tiles) {
+        sg_log("tile id %u exceed count_tiles bound\n", tile_id);
+        sg_assert(0, "tile id exceed count_tiles bound");
       }
+
+      int edge_engine_index =
+          core::getEdgeEngineIndexFromTile(config_, tile_id);
+
+      uint32_t local_tile_id = core::getLocalTileId(config_, tile_id);
+
+      char* tile_active = next_round
+                              ? vp_[edge_engine_index]->tile_active_next_
+                              : vp_[edge_engine_index]->tile_active_current_;
+      set_bool_array(tile_active, local_tile_id, true);
     }
+  }
 
-    return count_active_vertices;
+  template <class APP, typename TVertexType, typename TVertexIdType>
+  void VertexDomain<APP, TVertexType, TVertexIdType>::applyTileDirection(
+      bool next_round) {
+    if (vertices_->direction == TileDirection::TD_Both) {
+      return;
+    }
+    if (!config_.use_selective_scheduling) {
+      sg_err("Gathering along a single tile direction (%d) requires selective "
+             "scheduling\n",
+             (int)vertices_->direction);
+      util::die(1);
+    }
+
+    // global tile ids from count_forward_tiles_ on are transposed tiles
+    size_t start_tile_id = 0;
+    size_t end_tile_id = count_forward_tiles_;
+    if (vertices_->direction == TileDirection::TD_Forward) {
+      start_tile_id = count_forward_tiles_;
+      end_tile_id = config_.count_tiles;
+    }
+    for (size_t tile_id = start_tile_id; tile_id < end_tile_id; ++tile_id) {
+      int edge_engine_index =
+          core::getEdgeEngineIndexFromTile(config_, tile_id);
+
+      uint32_t local_tile_id = core::getLocalTileId(config_, tile_id);
+
+      char* tile_active = next_round
+                              ? vp_[edge_engine_index]->tile_active_next_
+                              : vp_[edge_engine_index]->tile_active_current_;
+      set_bool_array(tile_active, local_tile_id, false);
+    }
   }
 
   template <class APP, typename TVertexType, typename TVertexIdType>
@@ -440,8 +687,14 @@ namespace core {
     gettimeofday(&current_tv, NULL);
     timersub(&current_tv, &start_tv_round_, &result_time);
 
+    double time_round_ms =
+        result_time.tv_sec * 1000 + result_time.tv_usec / 1000.0;
     sg_log("Round Time for iteration %lu %.3fmsec\n", (iteration_ + 1),
-           result_time.tv_sec * 1000 + result_time.tv_usec / 1000.0);
+           time_round_ms);
+    if (config_.enable_perf_event_collection && config_.enable_perf_counters) {
+      pe::PerfEventManager::getInstance(config_)->reportCounters(iteration_ +
+                                                                 1);
+    }
     gettimeofday(&start_tv_round_, NULL);
     sg_print("Write output, flip vertices and reset for next round\n");
 
@@ -457,6 +710,10 @@ namespace core {
     bool switchCurrentNext = true;
     // reset internal state
     APP::reset_vertices(vertices_, &switchCurrentNext);
+    if (APP::count_partial_sums > 0) {
+      memset(vertices_->partial_sums, 0,
+             sizeof(double) * APP::count_partial_sums);
+    }
 
     // in iterations other than the first one, wait for the flusher to finish
     // first:
@@ -480,6 +737,26 @@ namespace core {
     // Reset changed status.
     memset(vertices_->changed, 0, sizeof(char) * vertices_->size_active);
 
+    // delta-stepping: the VertexAppliers activated the next bucket once the
+    // current one was settled, instead of ending the run
+    if (APP::need_buckets) {
+      if (count_bucket_activated_ > 0) {
+        vertices_->buckets->current = min_pending_bucket_;
+        sg_log("Advancing to bucket %u with %lu vertices\n",
+               vertices_->buckets->current, count_bucket_activated_);
+        // not converged while buckets are pending
+        residual_ += count_bucket_activated_;
+      }
+      count_active_vertices_ = 0;
+      min_pending_bucket_ = UINT32_MAX;
+      count_bucket_activated_ = 0;
+    }
+
+    // the APP picked the tiles of the next round in reset_vertices
+    if (APP::need_transposed_tiles) {
+      applyTileDirection(true);
+    }
+
     size_t count_active_tiles;
     if (config_.use_selective_scheduling) {
       count_active_tiles = countActiveTiles();
@@ -490,6 +767,23 @@ namespace core {
     sg_log("Number of active tiles: %lu out of %lu\n", count_active_tiles,
            config_.count_tiles);
 
+    size_t count_active_vertices = 0;
+    if (metrics_.isOpen() || metrics_source_id_ >= 0) {
+      count_active_vertices = util::countBoolArray(vertices_->active_current,
+                                                   vertices_->size_active);
+    }
+
+    if (metrics_.isOpen()) {
+      writeMetrics(time_round_ms, count_active_tiles, count_active_vertices);
+    }
+
+    round_status_lock_.writeBegin();
+    round_status_.iteration = iteration_ + 1;
+    round_status_.count_active_tiles = count_active_tiles;
+    round_status_.count_active_vertices = count_active_vertices;
+    round_status_.time_round_ms = time_round_ms;
+    round_status_lock_.writeEnd();
+
     // Give VertexProcessors chance to reset internal stat.
     for (auto& it : vp_) {
       it->resetRound(count_active_tiles);
@@ -509,22 +803,21 @@ namespace core {
 
     sg_log("Wake up everyone, done for round %lu\n", (iteration_ + 1));
     ++iteration_;
-    // Converge either on number of iterations or on all tiles being inactive
-    // when using the selective scheduling.
+    // Converge either on number of iterations, on all tiles being inactive
+    // when using the selective scheduling or on the residual of the APP, e.g.
+    // the count of active vertices or the sum of the changes.
     bool end_condition_selective_scheduling =
         (config_.use_selective_scheduling && count_active_tiles == 0);
-    bool end_condition_no_selective_scheduling = false;
-    if (!config_.use_selective_scheduling &&
-        (config_.algorithm == "bfs" || config_.algorithm == "cc")) {
-      size_t count_active_vertices = countActiveVertices();
-      sg_log("Count active vertices: %lu out of %lu\n", count_active_vertices,
-             config_.count_vertices);
-      end_condition_no_selective_scheduling = (count_active_vertices == 0);
+    bool end_condition_residual = false;
+    if (APP::need_residual) {
+      sg_log("Residual: %f, tolerance %f\n", residual_,
+             config_.convergence_tolerance);
+      end_condition_residual = residual_ <= config_.convergence_tolerance;
     }
+    residual_ = 0.;
 
     if (iteration_ >= config_.max_iterations ||
-        end_condition_selective_scheduling ||
-        end_condition_no_selective_scheduling) {
+        end_condition_selective_scheduling || end_condition_residual) {
       // wait once more for flushing
       if (config_.enable_fault_tolerance) {
         sg_log2("Wait for flusher to finish\n");
@@ -542,6 +835,90 @@ namespace core {
     calculateTileBreakPoint(count_active_tiles);
   }
 
+  template <class APP, typename TVertexType, typename TVertexIdType>
+  void VertexDomain<APP, TVertexType, TVertexIdType>::writeMetrics(
+      double time_round_ms, size_t count_active_tiles,
+      size_t count_active_vertices) {
+    util::MetricsRecord record;
+    record.addCount("iteration", iteration_ + 1);
+    record.addValue("time_ms", time_round_ms);
+    record.addCount("active_tiles", count_active_tiles);
+    record.addCount("active_vertices", count_active_vertices);
+    if (APP::need_residual) {
+      record.addValue("residual", residual_);
+    }
+
+    std::vector<util::MetricsRecord> edge_engines(vp_.size());
+    for (size_t i = 0; i < vp_.size(); ++i) {
+      vp_[i]->writeMetrics(time_round_ms / 1000., &edge_engines[i]);
+    }
+    record.addRecords("edge_engines", edge_engines);
+
+    // Summed up over all waiting threads.
+    uint64_t time_end_reduce_barrier_ns = perfmon_.time_end_reduce_barrier_ns_;
+    uint64_t time_local_apply_barrier_ns =
+        perfmon_.time_local_apply_barrier_ns_;
+    uint64_t time_end_apply_barrier_ns = perfmon_.time_end_apply_barrier_ns_;
+    util::MetricsRecord barriers;
+    barriers.addValue("end_reduce_ms", (time_end_reduce_barrier_ns -
+                                        time_end_reduce_barrier_ns_last_) /
+                                           1e6);
+    barriers.addValue("local_apply_ms", (time_local_apply_barrier_ns -
+                                         time_local_apply_barrier_ns_last_) /
+                                            1e6);
+    barriers.addValue("end_apply_ms", (time_end_apply_barrier_ns -
+                                       time_end_apply_barrier_ns_last_) /
+                                          1e6);
+    record.addRecord("barrier_wait", barriers);
+    time_end_reduce_barrier_ns_last_ = time_end_reduce_barrier_ns;
+    time_local_apply_barrier_ns_last_ = time_local_apply_barrier_ns;
+    time_end_apply_barrier_ns_last_ = time_end_apply_barrier_ns;
+
+    metrics_.write(record);
+  }
+
+  template <class APP, typename TVertexType, typename TVertexIdType>
+  void VertexDomain<APP, TVertexType, TVertexIdType>::exportMetrics(
+      util::PrometheusText* text) {
+    round_status_t status;
+    uint64_t sequence;
+    do {
+      sequence = round_status_lock_.readBegin();
+      status = round_status_;
+    } while (round_status_lock_.readRetry(sequence));
+
+    text->addGauge("mosaic_vertex_iteration", "Rounds completed.", "",
+                   status.iteration);
+    text->addGauge("mosaic_vertex_active_tiles",
+                   "Active tiles of the current round.", "",
+                   status.count_active_tiles);
+    text->addGauge("mosaic_vertex_active_vertices",
+                   "Active vertices of the current round.", "",
+                   status.count_active_vertices);
+    text->addGauge("mosaic_vertex_last_round_seconds",
+                   "Time of the last round completed.", "",
+                   status.time_round_ms / 1000.);
+    text->addCounter("mosaic_vertex_tiles_fetched_total",
+                     "Tiles the vertex fetchers sent vertices for.", "",
+                     perfmon_.count_tiles_fetched_);
+
+    const char* barrier_help =
+        "Time all threads waited at a barrier of the vertex domain.";
+    text->addCounter("mosaic_vertex_barrier_wait_seconds_total", barrier_help,
+                     "barrier=\"end_reduce\"",
+                     perfmon_.time_end_reduce_barrier_ns_ / 1e9);
+    text->addCounter("mosaic_vertex_barrier_wait_seconds_total", barrier_help,
+                     "barrier=\"local_apply\"",
+                     perfmon_.time_local_apply_barrier_ns_ / 1e9);
+    text->addCounter("mosaic_vertex_barrier_wait_seconds_total", barrier_help,
+                     "barrier=\"end_apply\"",
+                     perfmon_.time_end_apply_barrier_ns_ / 1e9);
+
+    for (auto& it : vp_) {
+      it->exportMetrics(text);
+    }
+  }
+
   template <class APP, typename TVertexType, typename TVertexIdType>
   void VertexDomain<APP, TVertexType, TVertexIdType>::initTimers() {
     timeval current_tv, result_time;
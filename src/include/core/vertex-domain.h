@@ -11,6 +11,9 @@
 #include <pthread.h>
 
 #include <util/runnable.h>
+#include <util/metrics.h>
+#include <util/metrics-exporter.h>
+#include <util/seqlock.h>
 #include <core/util.h>
 #include <core/datatypes.h>
 #include <core/vertex-applier.h>
@@ -50,6 +53,9 @@ namespace core {
 
     void calculateTileBreakPoint(const size_t& count_active_tiles);
 
+    // rounds run so far, after join() the rounds of the whole run
+    size_t countIterations();
+
   public:
     config_vertex_domain_t config_;
     VertexPerfMonitor perfmon_;
@@ -70,9 +76,26 @@ namespace core {
 
     void initVertexArray();
 
+    // for selective scheduling, in the tile-active-arrays of the current or
+    // of the next round
+    void activateTilesOfVertex(size_t vertex_id, bool next_round);
+
     size_t countActiveTiles();
 
-    size_t countActiveVertices();
+    // Appends the vertex-to-tile index of the transposed tiles to the one of
+    // the forward tiles.
+    void mergeTransposedTileIndex();
+
+    // Drops the active tiles of the direction the APP does not gather along,
+    // in the tile-active-arrays of the current or of the next round.
+    void applyTileDirection(bool next_round);
+
+    // Writes the metrics record of the round that just ended.
+    void writeMetrics(double time_round_ms, size_t count_active_tiles,
+                      size_t count_active_vertices);
+
+    // Adds the live metrics, called by the exporter thread.
+    void exportMetrics(util::PrometheusText* text);
 
   private:
     bool shutdown_;
@@ -99,6 +122,10 @@ namespace core {
     vertex_array_t<TVertexType>* vertices_;
     std::unordered_map<TVertexIdType, int64_t> global_to_orig_;
 
+    // count_tiles of the graph, for APP::need_transposed_tiles the
+    // config_ holds the transposed tiles as well
+    size_t count_forward_tiles_;
+
     // selective-scheduling-arrays
     size_t* vertex_to_tiles_offset_;
     uint32_t* vertex_to_tiles_count_;
@@ -106,11 +133,42 @@ namespace core {
 
     size_t iteration_;
 
+    // residual of the current round, summed up by the VertexAppliers under
+    // the active_tiles_mutex_
+    double residual_;
+
+    // APP::need_buckets only, summed up by the VertexAppliers under the
+    // active_tiles_mutex_ as well: the vertices still active after apply, the
+    // smallest bucket pending and the count of vertices activated when
+    // advancing to it
+    size_t count_active_vertices_;
+    uint32_t min_pending_bucket_;
+    size_t count_bucket_activated_;
+
     size_t tile_break_point_;
 
     // for calculating the time spent in the current round
     struct timeval start_tv_round_;
     struct timeval init_tv_;
+
+    // per-round metrics, if config_.path_to_metrics is set
+    util::MetricsWriter metrics_;
+    uint64_t time_end_reduce_barrier_ns_last_;
+    uint64_t time_local_apply_barrier_ns_last_;
+    uint64_t time_end_apply_barrier_ns_last_;
+
+    // live metrics, if config_.metrics_address is set
+    int metrics_source_id_;
+
+    // Written once per round by resetRound(), read by the exporter thread.
+    struct round_status_t {
+      size_t iteration;
+      size_t count_active_tiles;
+      size_t count_active_vertices;
+      double time_round_ms;
+    };
+    util::SeqLock round_status_lock_;
+    round_status_t round_status_;
   };
 }
 }
@@ -10,10 +10,12 @@
 #include <string.h>
 #include <time.h>
 #include <sys/time.h>
+#include <algorithm>
 #include <cmath>
 #include <pthread.h>
 #include <sys/stat.h>
 #include <ring_buffer.h>
+#include <ring_buffer_wait.h>
 #include <util/arch.h>
 #include <core/datatypes.h>
 #include <core/util.h>
@@ -29,7 +31,8 @@ namespace core {
       VertexProcessor<APP, TVertexType, TVertexIdType>& ctx,
       vertex_array_t<TVertexType>* vertices, tile_stats_t* tile_stats,
       const thread_index_t& thread_index)
-      : ctx_(ctx), vertices_(vertices), thread_index_(thread_index),
+      : ctx_(ctx), vertices_(vertices), tile_stats_(NULL), tile_block_(NULL),
+        thread_index_(thread_index),
         offset_indices_(NULL), fetch_requests_(NULL),
         fetch_requests_vertices_(NULL), src_vertices_aggregate_block_(NULL),
         config_(ctx_.config_), tile_break_point_(0) {
@@ -64,6 +67,7 @@ namespace core {
     delete[] fetch_requests_vertices_;
     free(src_vertices_aggregate_block_);
     free(tile_block_);
+    free(tile_stats_);
   }
 
   template <class APP, typename TVertexType, typename TVertexIdType>
@@ -155,39 +159,54 @@ namespace core {
     meta_info->meta.vr_refcnt = tile_block_->num_tile_partition;
     smp_wmb();
 
-    // send partitioned tile blocks to tile-processors
-    ring_buffer_req_t tiles_req;
+    // send partitioned tile blocks to tile-processors, reserving the elements
+    // of several partitions at once, as long as they fill at most half of the
+    // ring buffer
+    ring_buffer_req_t tiles_reqs[max_batch_requests_];
     size_t local_len = len;
-    for (uint32_t tpid = 0; tpid < tile_block_->num_tile_partition; ++tpid) {
-      // fill tile processing information
-      tile_block_->tile_partition_id = tpid;
-      tile_block_->sample_execution_time = sample_current_tile();
-
-      // push a tile block
-      ring_buffer_put_req_init(&tiles_req, BLOCKING, local_len);
+    uint32_t max_batch_partitions = std::max<size_t>(
+        1, std::min<size_t>(max_batch_requests_,
+                            config_.host_tiles_rb_size / (2 * local_len)));
+    for (uint32_t offset = 0; offset < tile_block_->num_tile_partition;
+         offset += max_batch_partitions) {
+      uint32_t count_partitions = std::min(
+          max_batch_partitions, tile_block_->num_tile_partition - offset);
+
+      // push a batch of tile blocks
+      for (uint32_t i = 0; i < count_partitions; ++i) {
+        ring_buffer_put_req_init(&tiles_reqs[i], BLOCKING, local_len);
+      }
 #if defined(MOSAIC_HOST_ONLY)
-      ring_buffer_put(ctx_.tiles_data_rb_, &tiles_req);
+      ring_buffer_put_batch(ctx_.tiles_data_rb_, tiles_reqs, count_partitions);
 #else
-      ring_buffer_scif_put(&ctx_.tiles_data_rb_, &tiles_req);
+      ring_buffer_scif_put_batch(&ctx_.tiles_data_rb_, tiles_reqs,
+                                 count_partitions);
 #endif
-      sg_rb_check(&tiles_req);
+      sg_rb_check(&tiles_reqs[0]);
+
+      for (uint32_t i = 0; i < count_partitions; ++i) {
+        // fill tile processing information
+        tile_block_->tile_partition_id = offset + i;
+        tile_block_->sample_execution_time = sample_current_tile();
 
 #if defined(MOSAIC_HOST_ONLY)
-      int rc = copy_to_ring_buffer(ctx_.tiles_data_rb_, tiles_req.data,
-                                   tile_block_, local_len);
+        int rc = copy_to_ring_buffer(ctx_.tiles_data_rb_, tiles_reqs[i].data,
+                                     tile_block_, local_len);
 #else
-      int rc = copy_to_ring_buffer_scif(&ctx_.tiles_data_rb_, tiles_req.data,
-                                        tile_block_, local_len);
+        int rc = copy_to_ring_buffer_scif(
+            &ctx_.tiles_data_rb_, tiles_reqs[i].data, tile_block_, local_len);
 #endif
-      if (rc) {
-        sg_log("Copy to ringbuffer failed in VF: %d\n", rc);
-        util::die(1);
-      }
+        if (rc) {
+          sg_log("Copy to ringbuffer failed in VF: %d\n", rc);
+          util::die(1);
+        }
 #if defined(MOSAIC_HOST_ONLY)
-      ring_buffer_elm_set_ready(ctx_.tiles_data_rb_, tiles_req.data);
+        ring_buffer_elm_set_ready(ctx_.tiles_data_rb_, tiles_reqs[i].data);
 #else
-      ring_buffer_scif_elm_set_ready(&ctx_.tiles_data_rb_, tiles_req.data);
+        ring_buffer_scif_elm_set_ready(&ctx_.tiles_data_rb_,
+                                       tiles_reqs[i].data);
 #endif
+      }
     }
     smp_faa(&ctx_.vd_.perfmon_.count_tile_partitions_sent_,
             tile_block_->num_tile_partition);
@@ -207,11 +226,7 @@ namespace core {
 
     sg_dbg("Wait for index for block %d on %d\n", tile_id,
            ctx_.edge_engine_index_);
-    smp_rmb();
-    while (!meta_info->meta.data_ready) {
-      pthread_yield();
-      smp_rmb();
-    }
+    rb_event_wait(&meta_info->meta.data_ready);
     volatile edge_block_index_t* edge_block_index = meta_info->data;
     sg_dbg("Got index for block %d on %d\n", tile_id, ctx_.edge_engine_index_);
 
@@ -248,28 +263,36 @@ namespace core {
       ring_buffer_elm_set_ready(ctx_.vd_.global_fetchers_[i]->request_rb_,
                                 put_fetch_req.data);
     }
-    // wait for exactly $count_global_fetchers-many responses
-    ring_buffer_req_t req_resp;
-    for (int i = 0; i < config_.count_global_fetchers; ++i) {
-      ring_buffer_get_req_init(&req_resp, BLOCKING);
-      ring_buffer_get(response_rb_, &req_resp);
-      sg_rb_check(&req_resp);
-
-      fetch_vertices_response_t* response =
-          (fetch_vertices_response_t*)req_resp.data;
-      TVertexType* fetched_src_vertices =
-          get_array(TVertexType*, response, response->offset_vertex_responses);
-
-      // iterate response, translate contiguos array back to original
-      // position in src-vertices-block
-      for (uint32_t j = 0; j < response->count_vertices; ++j) {
-        uint16_t local_index = offset_indices_[response->global_fetcher_id][j];
+    // wait for exactly $count_global_fetchers-many responses, claiming all
+    // the ready ones at once
+    ring_buffer_req_t reqs_resp[max_batch_requests_];
+    for (int received = 0; received < config_.count_global_fetchers;) {
+      ring_buffer_get_req_init(&reqs_resp[0], BLOCKING);
+      int count_responses = ring_buffer_get_batch(
+          response_rb_, reqs_resp,
+          std::min<int>(max_batch_requests_,
+                        config_.count_global_fetchers - received));
+      sg_rb_check(&reqs_resp[0]);
+
+      for (int i = 0; i < count_responses; ++i) {
+        fetch_vertices_response_t* response =
+            (fetch_vertices_response_t*)reqs_resp[i].data;
+        TVertexType* fetched_src_vertices = get_array(
+            TVertexType*, response, response->offset_vertex_responses);
+
+        // iterate response, translate contiguos array back to original
+        // position in src-vertices-block
+        for (uint32_t j = 0; j < response->count_vertices; ++j) {
+          uint16_t local_index =
+              offset_indices_[response->global_fetcher_id][j];
+
+          src_vertices_aggregate_block_[local_index] = fetched_src_vertices[j];
+        }
 
-        src_vertices_aggregate_block_[local_index] = fetched_src_vertices[j];
+        // done with this response
+        ring_buffer_elm_set_done(response_rb_, reqs_resp[i].data);
       }
-
-      // done with this response
-      ring_buffer_elm_set_done(response_rb_, req_resp.data);
+      received += count_responses;
     }
 
     // XXX XXX XXX XXX XXX XXX XXX XXX XXX XXX XXX XXX XXX XXX XXX
@@ -495,6 +518,9 @@ namespace core {
 
     /* tile accounting */
     smp_faa(&ctx_.vd_.perfmon_.count_tiles_fetched_, 1);
+    smp_faa(&ctx_.vd_.perfmon_.count_tiles_sent_[ctx_.edge_engine_index_], 1);
+    smp_faa(&ctx_.vd_.perfmon_.count_edges_sent_[ctx_.edge_engine_index_],
+            tile_stats_[tile_id].count_edges);
   }
 
   template <class APP, typename TVertexType, typename TVertexIdType>
@@ -565,7 +591,8 @@ namespace core {
         sg_dbg("Count tile_partitions: %lu\n",
                ctx_.vd_.perfmon_.count_tile_partitions_sent_);
 
-        pthread_barrier_wait(&ctx_.vd_.end_apply_barrier_);
+        core::timedBarrierWait(&ctx_.vd_.end_apply_barrier_,
+                               &ctx_.vd_.perfmon_.time_end_apply_barrier_ns_);
         // Update the tile break point from the VertexDomain.
         updateTileBreakPoint();
 
@@ -18,6 +18,8 @@ namespace core {
   template <class APP, typename TVertexType, typename TVertexIdType>
   class VertexProcessor;
 
+  class MicroBenchmark;
+
   template <class APP, typename TVertexType, typename TVertexIdType>
   class VertexFetcher : public scalable_graphs::util::Runnable {
   public:
@@ -32,6 +34,11 @@ namespace core {
     ring_buffer_t* response_rb_;
 
   private:
+#ifndef TARGET_ARCH_K1OM
+    // enable the micro benchmarks to drive the kernels
+    friend class MicroBenchmark;
+#endif
+
     virtual void run();
     size_t grab_a_tile(size_t& iteration);
     void init();
@@ -66,6 +73,7 @@ namespace core {
     config_vertex_domain_t config_;
     size_t tile_break_point_;
     const static size_t response_rb_size_ = 1ul * GB;
+    const static uint32_t max_batch_requests_ = 16;
   };
 }
 }
@@ -7,8 +7,10 @@ namespace scalable_graphs {
 namespace core {
   VertexPerfMonitor::VertexPerfMonitor(useconds_t tick)
       : tick_(tick), forced_to_stop_(false), count_tiles_fetched_(0),
-        count_tile_partitions_sent_(0) {
-    // do nothing
+        count_tile_partitions_sent_(0), time_end_reduce_barrier_ns_(0),
+        time_local_apply_barrier_ns_(0), time_end_apply_barrier_ns_(0) {
+    memset(count_tiles_sent_, 0, sizeof(count_tiles_sent_));
+    memset(count_edges_sent_, 0, sizeof(count_edges_sent_));
   }
 
   VertexPerfMonitor::~VertexPerfMonitor() { stop(); }
@@ -27,6 +27,15 @@ namespace core {
     uint64_t count_XXX_ __attribute__((aligned(64)));
     uint64_t count_tiles_fetched_ __attribute__((aligned(64)));
     uint64_t count_tile_partitions_sent_ __attribute__((aligned(64)));
+
+    // per edge engine
+    uint64_t count_tiles_sent_[MAX_EDGE_ENGINES] __attribute__((aligned(64)));
+    uint64_t count_edges_sent_[MAX_EDGE_ENGINES] __attribute__((aligned(64)));
+
+    // time all threads spent waiting at the barriers of a round
+    uint64_t time_end_reduce_barrier_ns_ __attribute__((aligned(64)));
+    uint64_t time_local_apply_barrier_ns_ __attribute__((aligned(64)));
+    uint64_t time_end_apply_barrier_ns_ __attribute__((aligned(64)));
   };
 }
 }
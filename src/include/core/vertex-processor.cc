@@ -14,43 +14,54 @@ namespace core {
       VertexDomain<APP, TVertexType, TVertexIdType>& vd,
       const config_vertex_domain_t& config, int mic_id, int edge_engine_index)
       : vd_(vd), config_(config), mic_id_(mic_id),
-        edge_engine_index_(edge_engine_index),
+        edge_engine_index_(edge_engine_index), delta_meta_fd_(-1),
+        count_base_tiles_(SIZE_MAX), transposed_meta_fd_(-1),
+        count_forward_tiles_(SIZE_MAX), tile_container_(NULL),
+        delta_tile_container_(NULL), transposed_tile_container_(NULL),
+        count_tiles_sent_last_(0), count_edges_sent_last_(0),
         fetcher_progress_(config_.count_vertex_fetchers),
-        index_reader_progress_(config_.count_index_readers) {
+        index_reader_progress_(config_.count_index_readers),
+        count_busy_vertex_reducers_(0) {
     pthread_barrier_init(&barrier_readers_, NULL,
                          config_.count_vertex_fetchers);
     pthread_barrier_init(&fetchers_barrier_, NULL,
                          config_.count_vertex_fetchers);
+    pthread_spin_init(&dummy_blocks_lock_, PTHREAD_PROCESS_PRIVATE);
 
   }
 
   template <class APP, typename TVertexType, typename TVertexIdType>
   VertexProcessor<APP, TVertexType, TVertexIdType>::~VertexProcessor() {
-#if defined(MOSAIC_HOST_ONLY)
-    // destroy ring buffers
-    ring_buffer_destroy(response_rb_);
-    ring_buffer_destroy(tiles_data_rb_);
-#else
-    // destroy ring buffers
+#if !defined(MOSAIC_HOST_ONLY)
+    // destroy ring buffers, on the host only they belong to the edge processor
     ring_buffer_scif_destroy_shadow(&response_rb_);
     ring_buffer_scif_destroy_shadow(&tiles_data_rb_);
 #endif
     ring_buffer_destroy(index_rb_);
+    pthread_spin_destroy(&dummy_blocks_lock_);
+
+    munmap(index_offset_table_.data_info,
+           sizeof(index_offset_table_.data_info[0]) * config_.count_tiles);
 
     delete[] tile_stats_;
     delete[] tile_offsets_;
 
     if (config_.use_selective_scheduling) {
-#if defined(MOSAIC_HOST_ONLY)
-      ring_buffer_destroy(active_tiles_rb_);
-#else
+#if !defined(MOSAIC_HOST_ONLY)
       ring_buffer_scif_destroy_shadow(&active_tiles_rb_);
 #endif
       delete[] tile_active_current_;
       delete[] tile_active_next_;
     }
 
-    close(meta_fd_);
+    // the container owns the meta-fd, resident ones outlive the engine
+    if (tile_container_ == NULL) {
+      close(meta_fd_);
+    } else if (config_.resident_graph == NULL) {
+      delete tile_container_;
+      delete delta_tile_container_;
+      delete transposed_tile_container_;
+    }
   }
 
   template <class APP, typename TVertexType, typename TVertexIdType>
@@ -120,53 +131,132 @@ namespace core {
 
   template <class APP, typename TVertexType, typename TVertexIdType>
   void VertexProcessor<APP, TVertexType, TVertexIdType>::allocate() {
-    // init fd of tiles-file
-    std::string meta_file_name =
-        core::getEdgeTileIndexFileName(config_, edge_engine_index_);
-    meta_fd_ = util::openFileDirectly(meta_file_name);
-
-    // read tile_stats
-    std::string global_tile_stats_file_name =
-        core::getGlobalTileStatsFileName(config_, edge_engine_index_);
     int count_tiles_for_mic =
         core::countTilesPerMic(config_, edge_engine_index_);
 
     tile_stats_ = new tile_stats_t[count_tiles_for_mic];
+    tile_offsets_ = new size_t[count_tiles_for_mic];
 
     sg_dbg("On node: %d, countTilesForMic: %d\n", edge_engine_index_,
            count_tiles_for_mic);
-    size_t size_tile_stats = sizeof(tile_stats_t) * count_tiles_for_mic;
-    util::readDataFromFile(global_tile_stats_file_name, size_tile_stats,
-                           tile_stats_);
 
-    tile_offsets_ = new size_t[count_tiles_for_mic];
-    tile_offsets_[0] = 0;
-
-    for (int i = 1; i < count_tiles_for_mic; ++i) {
-      // offset is the offset of the previous block plus the size of the
-      // previous block:
-      tile_stats_t tile_stats = tile_stats_[i - 1];
-
-      // step 2: calculate required space to fetch the index blocks
-      size_t size_edge_index_tgt_vertex_block =
-          sizeof(uint32_t) * tile_stats.count_vertex_tgt;
-      size_t size_edge_index_src_vertex_block =
-          sizeof(uint32_t) * tile_stats.count_vertex_src;
-      size_t size_edge_index_src_extended_block =
-          vd_.config_.is_index_32_bits
-              ? 0
-              : size_bool_array(tile_stats.count_vertex_src);
-      size_t size_edge_index_tgt_extended_block =
-          vd_.config_.is_index_32_bits
-              ? 0
-              : size_bool_array(tile_stats.count_vertex_tgt);
-      size_t size_index_block = sizeof(edge_block_index_t) +
-                                size_edge_index_src_vertex_block +
-                                size_edge_index_tgt_vertex_block +
-                                size_edge_index_src_extended_block +
-                                size_edge_index_tgt_extended_block;
-      size_t size_rb_block = int_ceil(size_index_block, PAGE_SIZE);
-      tile_offsets_[i] = tile_offsets_[i - 1] + size_rb_block;
+    // prefer the single-file tile container if one was packed for this edge
+    // engine, the indices are read from the same file, the query server
+    // opens it once for all runs
+    const resident_tiles_t* resident_tiles =
+        config_.resident_graph != NULL
+            ? &config_.resident_graph->tiles[edge_engine_index_]
+            : NULL;
+    std::string tile_container_file_name =
+        core::getTileContainerFileName(config_, edge_engine_index_);
+    if (resident_tiles != NULL ? resident_tiles->tile_container != NULL
+                               : TileContainer::exists(
+                                     tile_container_file_name)) {
+      if (resident_tiles != NULL) {
+        tile_container_ = resident_tiles->tile_container;
+        delta_tile_container_ = resident_tiles->delta_tile_container;
+      } else {
+        tile_container_ = new TileContainer();
+        tile_container_->open(tile_container_file_name);
+
+        // delta tiles written by post-grc-delta follow the base tiles
+        std::string delta_tile_container_file_name =
+            core::getDeltaTileContainerFileName(config_, edge_engine_index_);
+        if (TileContainer::exists(delta_tile_container_file_name)) {
+          delta_tile_container_ = new TileContainer();
+          delta_tile_container_->open(delta_tile_container_file_name);
+        }
+      }
+      count_base_tiles_ = tile_container_->countTiles();
+      size_t count_delta_tiles = delta_tile_container_ != NULL
+                                     ? delta_tile_container_->countTiles()
+                                     : 0;
+      count_forward_tiles_ = count_base_tiles_ + count_delta_tiles;
+
+      // the transposed tiles written by post-grc-transposer follow the
+      // forward ones
+      size_t count_transposed_tiles = 0;
+      if (APP::need_transposed_tiles) {
+        if (resident_tiles == NULL) {
+          transposed_tile_container_ =
+              openTransposedTileContainer(config_, edge_engine_index_);
+        } else if (resident_tiles->transposed_tile_container != NULL) {
+          transposed_tile_container_ =
+              resident_tiles->transposed_tile_container;
+        } else {
+          sg_err("Transposed tiles %s missing, run post-grc-transposer "
+                 "first\n",
+                 core::getTransposedTileContainerFileName(config_,
+                                                          edge_engine_index_)
+                     .c_str());
+          util::die(1);
+        }
+        count_transposed_tiles = transposed_tile_container_->countTiles();
+      }
+
+      const tile_container_header_t& header = tile_container_->header();
+      if (count_forward_tiles_ + count_transposed_tiles !=
+              (uint64_t)count_tiles_for_mic ||
+          header.is_index_32_bits != vd_.config_.is_index_32_bits) {
+        sg_err("Tile container %s does not match the graph (%lu + %lu + %lu "
+               "tiles)\n",
+               tile_container_file_name.c_str(), count_base_tiles_,
+               count_delta_tiles, count_transposed_tiles);
+        util::die(1);
+      }
+
+      meta_fd_ = tile_container_->fd();
+      tile_container_->copyTileStats(tile_stats_);
+      for (size_t i = 0; i < count_base_tiles_; ++i) {
+        tile_offsets_[i] = tile_container_->entry(i).offset_index;
+      }
+      if (delta_tile_container_ != NULL) {
+        delta_meta_fd_ = delta_tile_container_->fd();
+        delta_tile_container_->copyTileStats(tile_stats_ + count_base_tiles_);
+        for (size_t i = 0; i < count_delta_tiles; ++i) {
+          tile_offsets_[count_base_tiles_ + i] =
+              delta_tile_container_->entry(i).offset_index;
+        }
+      }
+      if (transposed_tile_container_ != NULL) {
+        transposed_meta_fd_ = transposed_tile_container_->fd();
+        transposed_tile_container_->copyTileStats(tile_stats_ +
+                                                  count_forward_tiles_);
+        for (size_t i = 0; i < count_transposed_tiles; ++i) {
+          tile_offsets_[count_forward_tiles_ + i] =
+              transposed_tile_container_->entry(i).offset_index;
+        }
+      }
+    } else {
+      if (APP::need_transposed_tiles) {
+        sg_err("Transposed tiles require the tiles in a tile container, "
+               "missing %s\n",
+               tile_container_file_name.c_str());
+        util::die(1);
+      }
+
+      // init fd of tiles-file
+      std::string meta_file_name =
+          core::getEdgeTileIndexFileName(config_, edge_engine_index_);
+      meta_fd_ = util::openFileDirectly(meta_file_name);
+
+      // read tile_stats
+      std::string global_tile_stats_file_name =
+          core::getGlobalTileStatsFileName(config_, edge_engine_index_);
+
+      size_t size_tile_stats = sizeof(tile_stats_t) * count_tiles_for_mic;
+      util::readDataFromFile(global_tile_stats_file_name, size_tile_stats,
+                             tile_stats_);
+
+      tile_offsets_[0] = 0;
+      for (int i = 1; i < count_tiles_for_mic; ++i) {
+        // offset is the offset of the previous block plus the size of the
+        // previous block:
+        size_t size_index_block = core::getSizeEdgeBlockIndex(
+            tile_stats_[i - 1], vd_.config_.is_index_32_bits);
+        size_t size_rb_block = int_ceil(size_index_block, PAGE_SIZE);
+        tile_offsets_[i] = tile_offsets_[i - 1] + size_rb_block;
+      }
     }
 
     // initialize index offset table
@@ -305,6 +395,7 @@ namespace core {
                       std::to_string(i));
       threads_.push_back(thread);
     }
+    return 0;
   }
 
   template<class APP, typename TVertexType, typename TVertexIdType>
@@ -369,7 +460,10 @@ namespace core {
       tile_active_next_ = tile_active_current_;
       tile_active_current_ = temp;
 
-      sendActiveTiles(count_active_tiles);
+      // the in-memory Edge Engine holds all tiles, nobody receives the list
+      if (!config_.in_memory_mode) {
+        sendActiveTiles(count_active_tiles);
+      }
 
       // pushing to remote array:
       // reset for next round:
@@ -381,6 +475,70 @@ namespace core {
     sg_dbg("Round reset %d\n", edge_engine_index_);
   }
 
+  template <class APP, typename TVertexType, typename TVertexIdType>
+  void VertexProcessor<APP, TVertexType, TVertexIdType>::writeMetrics(
+      double time_round_sec, util::MetricsRecord* record) {
+    uint64_t count_tiles_sent =
+        vd_.perfmon_.count_tiles_sent_[edge_engine_index_];
+    uint64_t count_edges_sent =
+        vd_.perfmon_.count_edges_sent_[edge_engine_index_];
+    uint64_t count_edges = count_edges_sent - count_edges_sent_last_;
+
+    record->addCount("engine", edge_engine_index_);
+    record->addCount("tiles", count_tiles_sent - count_tiles_sent_last_);
+    record->addCount("edges", count_edges);
+    record->addValue("edges_per_sec",
+                     time_round_sec > 0. ? count_edges / time_round_sec : 0.);
+
+    // Only the producer side of a ring buffer tracks its high-water mark.
+#if defined(MOSAIC_HOST_ONLY)
+    record->addCount("tiles_data_rb_high_water",
+                     ring_buffer_high_water(tiles_data_rb_));
+    ring_buffer_reset_high_water(tiles_data_rb_);
+#else
+    record->addCount("tiles_data_rb_high_water",
+                     ring_buffer_scif_high_water(&tiles_data_rb_));
+    ring_buffer_scif_reset_high_water(&tiles_data_rb_);
+#endif
+    record->addCount("index_rb_high_water", ring_buffer_high_water(index_rb_));
+    ring_buffer_reset_high_water(index_rb_);
+
+    count_tiles_sent_last_ = count_tiles_sent;
+    count_edges_sent_last_ = count_edges_sent;
+  }
+
+  template <class APP, typename TVertexType, typename TVertexIdType>
+  void VertexProcessor<APP, TVertexType, TVertexIdType>::exportMetrics(
+      util::PrometheusText* text) {
+    std::string engine = "edge_engine=\"" +
+                         std::to_string(edge_engine_index_) + "\"";
+    text->addCounter("mosaic_vertex_tiles_sent_total",
+                     "Tiles sent to the edge engine.", engine,
+                     vd_.perfmon_.count_tiles_sent_[edge_engine_index_]);
+    text->addCounter("mosaic_vertex_edges_sent_total",
+                     "Edges of the tiles sent to the edge engine.", engine,
+                     vd_.perfmon_.count_edges_sent_[edge_engine_index_]);
+
+#if defined(MOSAIC_HOST_ONLY)
+    ring_buffer_t* tiles_data_rb = tiles_data_rb_;
+#else
+    ring_buffer_t* tiles_data_rb = tiles_data_rb_.rb;
+#endif
+    text->addGauge("mosaic_ring_buffer_used_bytes",
+                   "Bytes in use of a ring buffer.",
+                   engine + ",ring_buffer=\"tiles_data\"",
+                   tiles_data_rb->size - ring_buffer_free_space(tiles_data_rb));
+    text->addGauge("mosaic_ring_buffer_used_bytes",
+                   "Bytes in use of a ring buffer.",
+                   engine + ",ring_buffer=\"index\"",
+                   index_rb_->size - ring_buffer_free_space(index_rb_));
+    text->addGauge("mosaic_ring_buffer_size_bytes", "Size of a ring buffer.",
+                   engine + ",ring_buffer=\"tiles_data\"",
+                   tiles_data_rb->size);
+    text->addGauge("mosaic_ring_buffer_size_bytes", "Size of a ring buffer.",
+                   engine + ",ring_buffer=\"index\"", index_rb_->size);
+  }
+
   template <class APP, typename TVertexType, typename TVertexIdType>
   void VertexProcessor<APP, TVertexType, TVertexIdType>::shutdown() {
     for (auto vertex_fetcher : vertex_fetchers_) {
@@ -7,9 +7,12 @@
 #include <pthread.h>
 #include <util/runnable.h>
 #include <util/atomic_counter.h>
+#include <util/metrics.h>
+#include <util/metrics-exporter.h>
 #include <core/util.h>
 #include <ring_buffer.h>
 #include <core/datatypes.h>
+#include <core/tile-container.h>
 #include <core/vertex-reducer.h>
 #include <core/vertex-fetcher.h>
 #include <core/index-reader.h>
@@ -42,6 +45,14 @@ namespace core {
 
     void sendActiveTiles(size_t count_active_tiles);
 
+    // Adds the metrics of this edge engine since the last call, the round
+    // took time_round_sec.
+    void writeMetrics(double time_round_sec, util::MetricsRecord* record);
+
+    // Adds the live metrics of this edge engine, called by the exporter
+    // thread.
+    void exportMetrics(util::PrometheusText* text);
+
     void shutdown();
     bool isShutdown();
 
@@ -62,6 +73,10 @@ namespace core {
     friend class VertexReducer<APP, TVertexType, TVertexIdType>;
     friend class VertexFetcher<APP, TVertexType, TVertexIdType>;
     friend class IndexReader<APP, TVertexType, TVertexIdType>;
+#ifndef TARGET_ARCH_K1OM
+    // enable the micro benchmarks to set up a fetcher
+    friend class MicroBenchmark;
+#endif
 
     void initRingBuffers();
     void allocate();
@@ -80,6 +95,10 @@ namespace core {
 
     tile_stats_t* tile_stats_;
 
+    // perfmon counts of the last writeMetrics()
+    uint64_t count_tiles_sent_last_;
+    uint64_t count_edges_sent_last_;
+
     ring_buffer_type response_rb_;
     ring_buffer_type tiles_data_rb_;
 
@@ -91,6 +110,23 @@ namespace core {
     int meta_fd_;
     size_t* tile_offsets_;
 
+    // delta tiles, local ids from count_base_tiles_ on
+    int delta_meta_fd_;
+    size_t count_base_tiles_;
+
+    // transposed tiles, local ids from count_forward_tiles_ on
+    int transposed_meta_fd_;
+    size_t count_forward_tiles_;
+
+    // set if the tiles are stored in a single-file container
+    TileContainer* tile_container_;
+
+    // set if post-grc-delta added tiles
+    TileContainer* delta_tile_container_;
+
+    // set if APP::need_transposed_tiles
+    TileContainer* transposed_tile_container_;
+
     scalable_graphs::util::AtomicCounter fetcher_progress_;
 
     scalable_graphs::util::AtomicCounter index_reader_progress_;
@@ -104,6 +140,12 @@ namespace core {
         index_offset_table_;
 
     const static size_t index_rb_size_ = 5ul * GB;
+
+    // the dummy blocks of the vertex reducers for the global reducers, queued
+    // as long as one of them is busy
+    pthread_spinlock_t dummy_blocks_lock_;
+    std::vector<uint64_t> pending_dummy_block_ids_;
+    volatile int count_busy_vertex_reducers_;
   };
 }
 }
@@ -12,6 +12,7 @@
 #include <pthread.h>
 #include <sys/stat.h>
 #include <ring_buffer.h>
+#include <ring_buffer_wait.h>
 #include <util/arch.h>
 #include <core/datatypes.h>
 #include <core/util.h>
@@ -31,12 +32,20 @@ namespace core {
       VertexProcessor<APP, TVertexType, TVertexIdType>& ctx,
       vertex_array_t<TVertexType>* vertices, const thread_index_t& thread_index)
       : ctx_(ctx), config_(ctx_.config_), vertices_(vertices),
-        thread_index_(thread_index) {
+        thread_index_(thread_index), response_block_(NULL),
+        global_reducer_blocks_local_(NULL),
+        global_reducer_blocks_remote_(NULL) {
     // do nothing
   }
 
   template <class APP, typename TVertexType, typename TVertexIdType>
   VertexReducer<APP, TVertexType, TVertexIdType>::~VertexReducer() {
+    // the query server runs many engines in one process
+    if (global_reducer_blocks_local_ != NULL) {
+      for (int i = 0; i < config_.count_global_reducers; ++i) {
+        free(global_reducer_blocks_local_[i]);
+      }
+    }
     free(response_block_);
     free(global_reducer_blocks_local_);
     free(global_reducer_blocks_remote_);
@@ -67,8 +76,8 @@ namespace core {
         ring_buffer_elm_set_done(ctx_.index_rb_,
                                  (void*)meta_info->meta.bundle_raw);
       }
-      meta_info->meta.data_ready = false;
-      meta_info->meta.data_active = false;
+      rb_event_reset(&meta_info->meta.data_ready);
+      rb_slot_release(&meta_info->meta.data_active);
       sg_dbg("VR %d: Reset tile index for block %lu\n", ctx_.edge_engine_index_,
              tile_id);
     }
@@ -561,41 +570,73 @@ namespace core {
           TVertexType old_value = vertices_->next[id_tgt];
           TVertexType new_value;
 
-          APP::reduceVertex(new_value, tgt_vertices_[i], *val_ptr, id_tgt,
+          APP::reduceVertex(new_value, tgt_vertices_[i], old_value, id_tgt,
                             vertices_->degrees[id_tgt], vertices_->active_next,
                             config_);
-          successful = smp_cas(reinterpret_cast<uint32_t*>(val_ptr),
-                               *reinterpret_cast<const uint32_t*>(&old_value),
-                               *reinterpret_cast<const uint32_t*>(&new_value));
+          successful = casVertex(val_ptr, old_value, new_value);
         } while (!successful);
       }
     }
   }
 
   template <class APP, typename TVertexType, typename TVertexIdType>
-  void VertexReducer<APP, TVertexType, TVertexIdType>::sendDummyBlock(
+  void VertexReducer<APP, TVertexType, TVertexIdType>::queueDummyBlock(
       bool completed) {
-    for (int i = 0; i < config_.count_global_reducers; ++i) {
-      size_t block_size = sizeof(processed_vertex_index_block_t);
-
-      ring_buffer_req_t request_global_reducer_block;
-      ring_buffer_put_req_init(&request_global_reducer_block, BLOCKING,
-                               block_size);
-      ring_buffer_put(ctx_.vd_.global_reducers_[i]->response_rb_,
-                      &request_global_reducer_block);
+    // The global reducers only count the completed tiles.
+    if (!completed) {
+      return;
+    }
+    pthread_spin_lock(&ctx_.dummy_blocks_lock_);
+    ctx_.pending_dummy_block_ids_.push_back(response_block_->block_id);
+    if (ctx_.pending_dummy_block_ids_.size() == max_batch_dummy_blocks_) {
+      putDummyBlocks();
+    }
+    pthread_spin_unlock(&ctx_.dummy_blocks_lock_);
+  }
 
-      sg_rb_check(&request_global_reducer_block);
+  template <class APP, typename TVertexType, typename TVertexIdType>
+  void VertexReducer<APP, TVertexType, TVertexIdType>::putDummyBlocks() {
+    uint32_t count_blocks = ctx_.pending_dummy_block_ids_.size();
+    if (count_blocks == 0) {
+      return;
+    }
 
-      processed_vertex_index_block_t* block =
-          (processed_vertex_index_block_t*)request_global_reducer_block.data;
-      block->block_id = response_block_->block_id;
-      block->completed = completed;
-      block->count_src_vertex_block = 0;
-      block->count_tgt_vertex_block = 0;
-      block->sample_execution_time = false;
+    ring_buffer_req_t requests[max_batch_dummy_blocks_];
+    for (int i = 0; i < config_.count_global_reducers; ++i) {
+      for (uint32_t j = 0; j < count_blocks; ++j) {
+        ring_buffer_put_req_init(&requests[j], BLOCKING,
+                                 sizeof(processed_vertex_index_block_t));
+      }
+      ring_buffer_put_batch(ctx_.vd_.global_reducers_[i]->response_rb_,
+                            requests, count_blocks);
+      sg_rb_check(&requests[0]);
+
+      for (uint32_t j = 0; j < count_blocks; ++j) {
+        processed_vertex_index_block_t* block =
+            (processed_vertex_index_block_t*)requests[j].data;
+        block->block_id = ctx_.pending_dummy_block_ids_[j];
+        block->shutdown = false;
+        block->completed = true;
+        block->dummy = true;
+        block->count_src_vertex_block = 0;
+        block->count_tgt_vertex_block = 0;
+        block->sample_execution_time = false;
+
+        ring_buffer_elm_set_ready(ctx_.vd_.global_reducers_[i]->response_rb_,
+                                  block);
+      }
+    }
+    ctx_.pending_dummy_block_ids_.clear();
+  }
 
-      ring_buffer_elm_set_ready(ctx_.vd_.global_reducers_[i]->response_rb_,
-                                block);
+  template <class APP, typename TVertexType, typename TVertexIdType>
+  void VertexReducer<APP, TVertexType, TVertexIdType>::setIdle() {
+    // The global reducers wait for the queued tiles to finish the round, so
+    // the last vertex reducer to wait for a response puts them.
+    if (smp_faa(&ctx_.count_busy_vertex_reducers_, -1) == 1) {
+      pthread_spin_lock(&ctx_.dummy_blocks_lock_);
+      putDummyBlocks();
+      pthread_spin_unlock(&ctx_.dummy_blocks_lock_);
     }
   }
 
@@ -614,12 +655,14 @@ namespace core {
     while (true) {
       sg_print("Waiting for responses\n");
       receive_response_block();
+      smp_faa(&ctx_.count_busy_vertex_reducers_, 1);
       scoped_profile_tid_meta(ComponentType::CT_VertexReducer, "tile",
                               response_block_->block_id,
                               response_block_->count_tgt_vertex_block);
 
       // Break on shutdown.
       if (response_block_->shutdown) {
+        setIdle();
         break;
       }
 
@@ -644,10 +687,7 @@ namespace core {
           meta_info =
               &ctx_.index_offset_table_.data_info[response_block_->block_id];
 
-      while (!meta_info->meta.data_ready) {
-        pthread_yield();
-        smp_rmb();
-      }
+      rb_event_wait(&meta_info->meta.data_ready);
 
       edge_block_index_ = const_cast<edge_block_index_t*>(meta_info->data);
 
@@ -681,13 +721,14 @@ namespace core {
         }
       } else {
         // Send dummy block when GlobalReducer is not active.
-        sendDummyBlock(completed);
+        queueDummyBlock(completed);
       }
 
       // done with processing response, let it be reclaimed
       sg_dbg("Done processing response for block %lu\n",
              response_block_->block_id);
 #endif
+      setIdle();
     }
 
     sg_log("Shutdown VertexReducer %lu\n", thread_index_.id);
@@ -25,6 +25,8 @@ namespace core {
   template <class APP, typename TVertexType, typename TVertexIdType>
   class VertexProcessor;
 
+  class MicroBenchmark;
+
   template <class APP, typename TVertexType, typename TVertexIdType>
   class VertexReducer : public scalable_graphs::util::Runnable {
   public:
@@ -34,6 +36,11 @@ namespace core {
     ~VertexReducer();
 
   private:
+#ifndef TARGET_ARCH_K1OM
+    // enable the micro benchmarks to drive the kernels
+    friend class MicroBenchmark;
+#endif
+
     virtual void run();
     bool put_edge_block_index(uint64_t tile_id);
 
@@ -49,7 +56,9 @@ namespace core {
     void copyGlobalReducerFields(int index_global_reducer);
     void copyGlobalReducerBlocks(bool completed);
 
-    void sendDummyBlock(bool completed);
+    void queueDummyBlock(bool completed);
+    void putDummyBlocks();
+    void setIdle();
     void reduceTargetVertices();
 
     void processSourceVertices();
@@ -74,6 +83,8 @@ namespace core {
     processed_vertex_index_block_t** global_reducer_blocks_remote_;
 
     edge_block_index_t* edge_block_index_;
+
+    const static uint32_t max_batch_dummy_blocks_ = 16;
   };
 }
 }
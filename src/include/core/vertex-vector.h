@@ -0,0 +1,84 @@
+#pragma once
+
+#include <stddef.h>
+#include <ostream>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace scalable_graphs {
+namespace core {
+  // Vertex value of K floats for vector-valued algorithms like embedding
+  // propagation. The engines only copy vertex values and size their blocks by
+  // sizeof(TVertexType), so a vector moves through them like any scalar.
+  // Assigning a float broadcasts it, which is what LFM_ConstantValue relies
+  // on. The arrays of the engines are not aligned beyond 8 bytes, hence the
+  // unaligned loads.
+  template <size_t K>
+  struct vertex_vector_t {
+    float values[K];
+
+    vertex_vector_t& operator=(float value) {
+      for (size_t i = 0; i < K; ++i) {
+        values[i] = value;
+      }
+      return *this;
+    }
+
+    bool operator==(const vertex_vector_t& other) const {
+      for (size_t i = 0; i < K; ++i) {
+        if (values[i] != other.values[i]) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    bool operator!=(const vertex_vector_t& other) const {
+      return !(*this == other);
+    }
+
+    // this += factor * other
+    inline void addScaled(const vertex_vector_t& other, float factor) {
+      size_t i = 0;
+#ifdef __SSE2__
+      __m128 factors = _mm_set1_ps(factor);
+      for (; i + 4 <= K; i += 4) {
+        __m128 sum = _mm_add_ps(
+            _mm_loadu_ps(values + i),
+            _mm_mul_ps(_mm_loadu_ps(other.values + i), factors));
+        _mm_storeu_ps(values + i, sum);
+      }
+#endif
+      for (; i < K; ++i) {
+        values[i] += factor * other.values[i];
+      }
+    }
+
+    inline void scale(float factor) {
+      for (size_t i = 0; i < K; ++i) {
+        values[i] *= factor;
+      }
+    }
+
+    // sum of the absolute differences
+    inline float distance(const vertex_vector_t& other) const {
+      float distance = 0;
+      for (size_t i = 0; i < K; ++i) {
+        float diff = values[i] - other.values[i];
+        distance += diff < 0 ? -diff : diff;
+      }
+      return distance;
+    }
+  };
+
+  // space-separated, for the text output of the results
+  template <size_t K>
+  std::ostream& operator<<(std::ostream& stream, const vertex_vector_t<K>& v) {
+    for (size_t i = 0; i < K; ++i) {
+      stream << (i == 0 ? "" : " ") << v.values[i];
+    }
+    return stream;
+  }
+}
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <util/runnable.h>
+
+namespace scalable_graphs {
+namespace util {
+
+  // Metrics in the Prometheus text exposition format. Samples of the same
+  // metric are grouped under a single HELP and TYPE line, whatever the order
+  // they are added in.
+  class PrometheusText {
+  public:
+    // labels are given without braces, e.g. engine="0".
+    void addCounter(const std::string& name, const std::string& help,
+                    const std::string& labels, double value);
+
+    void addGauge(const std::string& name, const std::string& help,
+                  const std::string& labels, double value);
+
+    std::string toString() const;
+
+  private:
+    void addSample(const std::string& name, const char* type,
+                   const std::string& help, const std::string& labels,
+                   double value);
+
+    struct family_t {
+      const char* type;
+      std::string help;
+      std::string samples;
+    };
+
+    std::vector<std::string> names_;
+
+    std::unordered_map<std::string, family_t> families_;
+  };
+
+  // Serves the metrics of all registered sources over HTTP, either on a unix
+  // socket or on a loopback TCP port. Sources are called on every scrape from
+  // the exporter thread and only read counters, they never take a lock of the
+  // engine.
+  class MetricsExporter : public Runnable {
+  public:
+    typedef std::function<void(PrometheusText*)> source_t;
+
+    // The exporter of the process, started on the first call. address is a
+    // port number to listen on 127.0.0.1, or the path of a unix socket.
+    static MetricsExporter* getInstance(const std::string& address);
+
+    // Returns an id for removeSource().
+    int addSource(const source_t& source);
+
+    void removeSource(int id);
+
+    // The response body of a scrape.
+    std::string scrape();
+
+    // Stops serving and closes the socket, join() to wait for it.
+    void stop();
+
+  private:
+    MetricsExporter(const std::string& address);
+
+    virtual void run();
+
+    void listenOn();
+
+    void serve(int client);
+
+    static MetricsExporter* instance;
+
+    std::string address_;
+
+    bool is_unix_socket_;
+
+    int fd_;
+
+    volatile bool stop_;
+
+    std::mutex sources_mutex_;
+
+    std::map<int, source_t> sources_;
+
+    int next_source_id_;
+  };
+}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace scalable_graphs {
+namespace util {
+
+  // A flat JSON object, built up field by field in the order of the calls.
+  class MetricsRecord {
+  public:
+    void addCount(const std::string& key, uint64_t value);
+
+    void addValue(const std::string& key, double value);
+
+    void addString(const std::string& key, const std::string& value);
+
+    void addRecord(const std::string& key, const MetricsRecord& value);
+
+    void addRecords(const std::string& key,
+                    const std::vector<MetricsRecord>& values);
+
+    std::string toJson() const;
+
+  private:
+    void addField(const std::string& key, const std::string& json_value);
+
+    std::string fields_;
+  };
+
+  // Writes metrics records to a file, one JSON object per line.
+  class MetricsWriter {
+  public:
+    MetricsWriter();
+
+    ~MetricsWriter();
+
+    void open(const std::string& file_name);
+
+    bool isOpen() const;
+
+    void write(const MetricsRecord& record);
+
+  private:
+    FILE* file_;
+
+    std::mutex mutex_;
+  };
+}
+}
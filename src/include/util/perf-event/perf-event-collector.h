@@ -1,5 +1,7 @@
 #pragma once
 
+#include <map>
+
 #include <util/runnable.h>
 #include <util/util.h>
 #include <core/datatypes.h>
@@ -10,9 +12,14 @@ namespace scalable_graphs {
 namespace util {
   namespace perf_event {
 
+    class PerfEventManager;
+
+    // Drains the trace buffers of all threads and the events of the shared
+    // ring buffer to the profiling file of the process.
     class PerfEventCollector : public Runnable {
     public:
-      PerfEventCollector(ring_buffer_t* new_event_rb, const config_t& config,
+      PerfEventCollector(PerfEventManager* manager,
+                         ring_buffer_t* new_event_rb, const config_t& config,
                          PerfEventMode mode, int id);
 
       ~PerfEventCollector();
@@ -20,6 +27,11 @@ namespace util {
       virtual void run();
 
     private:
+      // Writes the hardware counters per component since the last sample.
+      void sampleCounters(FILE* file);
+
+      PerfEventManager* manager_;
+
       ring_buffer_t* new_event_rb_;
 
       const config_t config_;
@@ -27,6 +39,15 @@ namespace util {
       PerfEventMode mode_;
 
       int id_;
+
+      std::map<ComponentType, profiling_counters_t> sampled_counters_;
+
+      uint64_t time_sampled_counters_;
+
+      // Time to sleep if there is nothing to drain.
+      static const int drain_timeout_us = 1000;
+
+      static const uint64_t counter_sample_timeout_ns = 100 * 1000 * 1000;
     };
   }
 }
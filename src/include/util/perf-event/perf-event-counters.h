@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <core/datatypes.h>
+
+namespace scalable_graphs {
+namespace util {
+  namespace perf_event {
+
+    const char* getPerfCounterName(PerfCounter counter);
+
+    void resetPerfCounterValues(profiling_counters_t* values);
+
+    // Adds the available counters of from to to.
+    void addPerfCounterValues(const profiling_counters_t& from,
+                              profiling_counters_t* to);
+
+    // Counts from previous to current, counters not available in current are
+    // left out.
+    void diffPerfCounterValues(const profiling_counters_t& current,
+                               const profiling_counters_t& previous,
+                               profiling_counters_t* diff);
+
+    // Group of hardware counters of the calling thread, opened with
+    // perf_event_open(). Counters which are not supported by the CPU or the
+    // kernel are left out, if not even cycles can be counted, the group stays
+    // closed. The group may be read from any thread.
+    class PerfCounterGroup {
+    public:
+      PerfCounterGroup(ComponentType component);
+
+      ~PerfCounterGroup();
+
+      bool isOpen() const;
+
+      ComponentType getComponent() const;
+
+      // Reads the counts since the group was opened, scaled up if the kernel
+      // had to multiplex the counters. Returns false if the read fails.
+      bool read(profiling_counters_t* values) const;
+
+    private:
+      ComponentType component_;
+
+      int fds_[COUNT_PERF_COUNTERS];
+
+      // Position of each counter in the group read, -1 if not opened.
+      int positions_[COUNT_PERF_COUNTERS];
+
+      int count_opened_;
+    };
+  }
+}
+}
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <map>
+#include <mutex>
+#include <pthread.h>
 #include <vector>
 
 #include <util/runnable.h>
 #include <util/util.h>
 #include <core/datatypes.h>
 #include <util/perf-event/perf-event-collector.h>
+#include <util/perf-event/perf-event-counters.h>
+#include <util/perf-event/perf-event-trace-buffer.h>
 
 #include <ring_buffer.h>
 
@@ -27,6 +32,30 @@ namespace util {
 
       ring_buffer_t* getRingBuffer();
 
+      // Returns the trace buffer of the calling thread, registers it on the
+      // first call, recycling the buffer of an exited thread if there is one.
+      PerfEventTraceBuffer* getTraceBuffer();
+
+      // Writes all events of all trace buffers to file, returns the number of
+      // events written. The buffers of exited threads are drained one last
+      // time and recycled.
+      size_t drainTraceBuffers(FILE* file);
+
+      uint64_t getCountDroppedEvents();
+
+      bool isCountingEnabled() const;
+
+      // Opens the hardware counters of the calling thread, attributed to
+      // component. They are closed when the thread exits.
+      PerfCounterGroup* openCounters(ComponentType component);
+
+      // Sums up the hardware counters of all threads per component, including
+      // the threads that have exited.
+      void readCounters(std::map<ComponentType, profiling_counters_t>* counters);
+
+      // Logs the hardware counters per component since the last report.
+      void reportCounters(size_t iteration);
+
     public:
       static PerfEventManager*
       getInstance(const config_vertex_domain_t& config);
@@ -35,6 +64,15 @@ namespace util {
       getInstance(const config_edge_processor_t& config);
 
     private:
+      // Called on the exit of a thread with a trace buffer.
+      static void onThreadExit(void* manager);
+
+      void retireTraceBuffer(PerfEventTraceBuffer* trace_buffer);
+
+      // Adds the final counts of an exiting thread to exited_counters_ and
+      // closes its counters.
+      void closeCounters(PerfCounterGroup* counters);
+
       // Instance for the singleton, is initialized to nullptr.
       static PerfEventManager* instance;
 
@@ -45,9 +83,56 @@ namespace util {
 
       PerfEventMode mode_;
 
+      bool enable_counters_;
+
       std::vector<PerfEventCollector*> threads_;
 
+      PerfEventNameTable names_;
+
+      PerfEventClock clock_;
+
+      // Runs onThreadExit for every thread with a trace buffer.
+      pthread_key_t thread_exit_key_;
+
+      std::mutex trace_buffers_mutex_;
+
+      // Of running threads.
+      std::vector<PerfEventTraceBuffer*> trace_buffers_;
+
+      // Of exited threads, to be drained a last time.
+      std::vector<PerfEventTraceBuffer*> retired_trace_buffers_;
+
+      // Drained, waiting for a new thread.
+      std::vector<PerfEventTraceBuffer*> free_trace_buffers_;
+
+      // Dropped by the retired and free buffers.
+      uint64_t count_dropped_retired_;
+
+      // Held while draining, the buffers have a single consumer.
+      std::mutex drain_mutex_;
+
+      std::vector<trace_event_t> drained_events_;
+
+      std::mutex counters_mutex_;
+
+      // Of running threads.
+      std::vector<PerfCounterGroup*> counters_;
+
+      std::map<ComponentType, profiling_counters_t> exited_counters_;
+
+      // Whether a thread tried to open its counters yet.
+      bool opened_counters_;
+
+      std::map<ComponentType, profiling_counters_t> reported_counters_;
+
       static const int SIZE_EVENT_RB = 1 * GB;
+
+      // 1 MB per thread.
+      static const size_t COUNT_TRACE_BUFFER_EVENTS = 16 * 1024;
+
+      static const size_t COUNT_DRAIN_EVENTS = 4 * 1024;
+
+      static const uint64_t CLOCK_CALIBRATION_USEC = 20 * 1000;
     };
   }
 }
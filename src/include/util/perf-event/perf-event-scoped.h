@@ -1,26 +1,29 @@
 #pragma once
 
 #include <core/datatypes.h>
-
-#include <ring_buffer.h>
+#include <util/perf-event/perf-event-trace-buffer.h>
 
 namespace scalable_graphs {
 namespace util {
   namespace perf_event {
 
+    class PerfEventManager;
+
+    // Records the lifetime of the object as a duration event into the trace
+    // buffer of the calling thread. name has to be a string literal, it is
+    // interned by its address.
     class PerfEventScoped {
     public:
-      PerfEventScoped(ring_buffer_t* new_event_rb, const std::string& name,
-                      bool active);
+      PerfEventScoped(PerfEventManager* manager, const char* name, bool active);
 
-      PerfEventScoped(ring_buffer_t* new_event_rb, const std::string& name,
+      PerfEventScoped(PerfEventManager* manager, const char* name,
                       ComponentType component, int64_t global_id, bool active);
 
-      PerfEventScoped(ring_buffer_t* new_event_rb, const std::string& name,
+      PerfEventScoped(PerfEventManager* manager, const char* name,
                       ComponentType component, int64_t local_id,
                       int64_t global_id, int tile_id, bool active);
 
-      PerfEventScoped(ring_buffer_t* new_event_rb, const std::string& name,
+      PerfEventScoped(PerfEventManager* manager, const char* name,
                       ComponentType component, int64_t local_id,
                       int64_t global_id, uint64_t metadata, int tile_id,
                       bool active);
@@ -28,13 +31,15 @@ namespace util {
       ~PerfEventScoped();
 
     private:
-      bool active_;
+      void init(PerfEventManager* manager, const char* name,
+                ComponentType component, int64_t local_id, int64_t global_id,
+                uint64_t metadata, int tile_id);
 
-      ring_buffer_t* new_event_rb_;
+      bool active_;
 
-      profiling_data_t data_;
+      PerfEventTraceBuffer* trace_buffer_;
 
-      std::string name_;
+      trace_event_t event_;
     };
   }
 }
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <arch.h>
+#include <core/datatypes.h>
+#include <util/perf-event/perf-event-counters.h>
+
+namespace scalable_graphs {
+namespace util {
+  namespace perf_event {
+
+    // Maps event names to dense integer ids, so an event carries a 4 byte id
+    // instead of its name. Interning takes a lock, but every thread caches the
+    // ids of its names in its PerfEventTraceBuffer.
+    class PerfEventNameTable {
+    public:
+      uint32_t intern(const std::string& name);
+
+      std::string getName(uint32_t id);
+
+    private:
+      std::mutex mutex_;
+
+      std::unordered_map<std::string, uint32_t> ids_;
+
+      std::vector<std::string> names_;
+    };
+
+    // Converts rdtsc() timestamps to get_time_nsec() timestamps. Calibrated
+    // once against CLOCK_MONOTONIC, this assumes a constant and synchronized
+    // TSC, which every CPU we run on provides.
+    class PerfEventClock {
+    public:
+      PerfEventClock();
+
+      void calibrate(uint64_t duration_usec);
+
+      uint64_t toNsec(uint64_t tsc) const;
+
+      double getTicksPerNsec() const;
+
+    private:
+      uint64_t tsc_base_;
+
+      uint64_t nsec_base_;
+
+      double nsec_per_tick_;
+    };
+
+    // Append-only trace buffer of a single thread. The owning thread appends
+    // events without any lock or atomic operation, the collector drains them
+    // concurrently. If the collector falls behind, new events are dropped and
+    // counted instead of blocking the traced thread.
+    class PerfEventTraceBuffer {
+    public:
+      PerfEventTraceBuffer(PerfEventNameTable* names, size_t count_events);
+
+      ~PerfEventTraceBuffer();
+
+      // Owner only: name has to outlive the buffer, e.g. a string literal.
+      uint32_t internName(const char* name);
+
+      // Owner only.
+      inline bool append(const trace_event_t& event) {
+        if (head_ - tail_cache_ > mask_) {
+          tail_cache_ = tail_;
+          if (head_ - tail_cache_ > mask_) {
+            ++count_dropped_;
+            return false;
+          }
+        }
+        events_[head_ & mask_] = event;
+        // Publish the event before the new head.
+        smp_wmb();
+        head_ = head_ + 1;
+        return true;
+      }
+
+      // Collector only: copies at most max_events events to events, returns
+      // the number of events copied.
+      size_t drain(trace_event_t* events, size_t max_events);
+
+      uint64_t getCountDropped() const;
+
+      // Empties a drained buffer for a new owner.
+      void reset();
+
+      // Owner only: the hardware counters of the owner, if opened.
+      PerfCounterGroup* getCounters() const;
+
+      void setCounters(PerfCounterGroup* counters);
+
+    private:
+      PerfEventNameTable* names_;
+
+      PerfCounterGroup* counters_;
+
+      trace_event_t* events_;
+
+      size_t mask_;
+
+      // Written by the owner.
+      volatile size_t head_ __attribute__((aligned(L1D_CACHELINE_SIZE)));
+
+      size_t tail_cache_;
+
+      volatile uint64_t count_dropped_;
+
+      std::unordered_map<const char*, uint32_t> name_ids_;
+
+      // Written by the collector.
+      volatile size_t tail_ __attribute__((aligned(L1D_CACHELINE_SIZE)));
+    };
+  }
+}
+}
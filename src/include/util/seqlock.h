@@ -0,0 +1,50 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <arch.h>
+
+namespace scalable_graphs {
+namespace util {
+
+  // Sequence lock for a single writer: the writer never waits, readers retry
+  // if the writer was active while they read.
+  //
+  //   do {
+  //     seq = lock.readBegin();
+  //     copy = data;
+  //   } while (lock.readRetry(seq));
+  class SeqLock {
+  public:
+    SeqLock() : sequence_(0) {}
+
+    inline void writeBegin() {
+      sequence_ = sequence_ + 1;
+      smp_wmb();
+    }
+
+    inline void writeEnd() {
+      smp_wmb();
+      sequence_ = sequence_ + 1;
+    }
+
+    inline uint64_t readBegin() const {
+      uint64_t sequence;
+      // Odd while the writer is active.
+      while ((sequence = sequence_) & 1) {
+        asm volatile("pause" ::: "memory");
+      }
+      smp_rmb();
+      return sequence;
+    }
+
+    inline bool readRetry(uint64_t sequence) const {
+      smp_rmb();
+      return sequence_ != sequence;
+    }
+
+  private:
+    volatile uint64_t sequence_;
+  };
+}
+}
@@ -57,14 +57,28 @@ namespace util {
   FILE* initFileProfilingData(const config_t& config, PerfEventMode mode,
                               uint64_t id);
 
-  void writeProfilingDuration(const profiling_data_t& data, FILE* file);
+  void writeProfilingDuration(const profiling_data_t& data, const char* name,
+                              FILE* file);
 
   void writeRingBufferSizes(const profiling_data_t& data, FILE* file);
 
+  std::string getComponentName(ComponentType component);
+
+  // Writes the counters as a counter event, one series per counter.
+  void writePerfCounters(ComponentType component, uint64_t time,
+                         const profiling_counters_t& counters, FILE* file);
+
   void __die(int rc, const char* func, int line);
 
   std::vector<int> splitToIntVector(std::string input);
 
+  // CRC-32C (Castagnoli) over a buffer, chainable by passing the previous
+  // result as crc.
+  uint32_t crc32c(const void* data, size_t size, uint32_t crc = 0);
+
+  // Count of set bits in a bool array of size bytes, see set_bool_array.
+  size_t countBoolArray(const char* array, size_t size);
+
   // Hash strategy adopted from Ligra:
   // https://github.com/jshun/ligra/blob/master/utils/rMatGraph.C
   inline uint32_t hash(uint32_t a) {
@@ -173,25 +187,25 @@ namespace util {
 }
 
 #define scoped_profile_tid(__component, __identifier, __tile_id)               \
-  PerfEventScoped perf_event(                                                  \
-      PerfEventManager::getInstance(config_)->getRingBuffer(), __identifier,   \
-      __component, thread_index_.id, ctx_.edge_engine_index_, 0, (__tile_id),  \
-      config_.enable_perf_event_collection);
+  PerfEventScoped perf_event(PerfEventManager::getInstance(config_),           \
+                             __identifier, __component, thread_index_.id,      \
+                             ctx_.edge_engine_index_, 0, (__tile_id),          \
+                             config_.enable_perf_event_collection);
 
 #define scoped_profile_tid_meta(__component, __identifier, __tile_id, __meta)  \
-  PerfEventScoped perf_event(                                                  \
-      PerfEventManager::getInstance(config_)->getRingBuffer(), __identifier,   \
-      __component, thread_index_.id, ctx_.edge_engine_index_, (__meta),        \
-      (__tile_id), config_.enable_perf_event_collection);
+  PerfEventScoped perf_event(PerfEventManager::getInstance(config_),           \
+                             __identifier, __component, thread_index_.id,      \
+                             ctx_.edge_engine_index_, (__meta), (__tile_id),   \
+                             config_.enable_perf_event_collection);
 
 #define scoped_profile(__component, __identifier)                              \
-  PerfEventScoped perf_event(                                                  \
-      PerfEventManager::getInstance(config_)->getRingBuffer(), __identifier,   \
-      __component, thread_index_.id, ctx_.edge_engine_index_, 0, tile_id,      \
-      config_.enable_perf_event_collection);
+  PerfEventScoped perf_event(PerfEventManager::getInstance(config_),           \
+                             __identifier, __component, thread_index_.id,      \
+                             ctx_.edge_engine_index_, 0, tile_id,              \
+                             config_.enable_perf_event_collection);
 
 #define scoped_profile_meta(__component, __identifier, __meta)                 \
-  PerfEventScoped perf_event(                                                  \
-      PerfEventManager::getInstance(config_)->getRingBuffer(), __identifier,   \
-      __component, thread_index_.id, ctx_.edge_engine_index_, (__meta),        \
-      tile_id, config_.enable_perf_event_collection);
+  PerfEventScoped perf_event(PerfEventManager::getInstance(config_),           \
+                             __identifier, __component, thread_index_.id,      \
+                             ctx_.edge_engine_index_, (__meta), tile_id,       \
+                             config_.enable_perf_event_collection);
@@ -44,9 +44,13 @@ namespace core {
     const static bool need_degrees_source_block = false;
     const static bool need_degrees_target_block = false;
     const static bool need_vertex_block_extension_fields = true;
+    const static bool need_buckets = false;
+    const static bool need_residual = false;
+    const static bool need_transposed_tiles = false;
 
     const static size_t max_size_extension_fields_vertex_block =
         sizeof(global_information_t);
+    const static size_t count_partial_sums = 0;
 
 #ifndef TARGET_ARCH_K1OM
     constexpr const static VertexType neutral_element = {
@@ -141,6 +145,18 @@ namespace core {
       }
     }
 
+    static inline double residual(const vertex_array_t<VertexType>* vertices,
+                                  const uint64_t id) {
+      // not applicable, runs for max_iterations
+      return 0;
+    }
+
+    static inline void
+    accumulatePartialSums(const vertex_array_t<VertexType>* vertices,
+                          const uint64_t id, double* partial_sums) {
+      // not applicable
+    }
+
     static inline void
     reduceVertex(VertexType& out, const VertexType& lhs, const VertexType& rhs,
                  const uint64_t& id_tgt, const vertex_degree_t& degree,
@@ -3,6 +3,7 @@
 #include <cmath>
 #include <limits.h>
 #include <string.h>
+#include <unordered_set>
 
 #include <core/util.h>
 
@@ -21,8 +22,12 @@ namespace core {
     const static bool need_degrees_source_block = false;
     const static bool need_degrees_target_block = false;
     const static bool need_vertex_block_extension_fields = false;
+    const static bool need_buckets = false;
+    const static bool need_residual = true;
+    const static bool need_transposed_tiles = false;
 
     const static size_t max_size_extension_fields_vertex_block = 0;
+    const static size_t count_partial_sums = 0;
 
     const static VertexType neutral_element = UINT32_MAX;
 
@@ -79,6 +84,18 @@ namespace core {
       // }
     }
 
+    static inline double residual(const vertex_array_t<VertexType>* vertices,
+                                  const uint64_t id) {
+      // count of vertices still active
+      return eval_bool_array(vertices->active_next, id) ? 1 : 0;
+    }
+
+    static inline void
+    accumulatePartialSums(const vertex_array_t<VertexType>* vertices,
+                          const uint64_t id, double* partial_sums) {
+      // not applicable
+    }
+
     static inline void
     reduceVertex(VertexType& out, const VertexType& lhs, const VertexType& rhs,
                  const uint64_t& id_tgt, const vertex_degree_t& degree,
@@ -92,6 +109,11 @@ namespace core {
     static void init_vertices(vertex_array_t<VertexType>* vertices,
                               void* args) {
       sg_print("Init vertices\n");
+      init_args_t* init_args = (init_args_t*)args;
+      if (init_args != NULL && init_args->incremental != NULL) {
+        init_vertices_incremental(vertices, init_args->incremental);
+        return;
+      }
       // also need to init array for next round, otherwise everything will be 0
       for (int i = 0; i < vertices->count; ++i) {
         vertices->current[i] = i;
@@ -102,9 +124,55 @@ namespace core {
              vertices->size_active * sizeof(char));
     }
 
+    // Seeds the labels of a previous run. Inserted edges can only merge
+    // components, activating their endpoints suffices. A deleted edge may
+    // split its component, so all vertices of the components touched by
+    // deletions restart from their own id.
+    static void init_vertices_incremental(vertex_array_t<VertexType>* vertices,
+                                          const incremental_args_t* args) {
+      if (args->size_previous_vertices != sizeof(VertexType) * vertices->count) {
+        sg_err("Previous result of %lu bytes does not match %lu vertices\n",
+               args->size_previous_vertices, vertices->count);
+        util::die(1);
+      }
+      const VertexType* previous_labels =
+          (const VertexType*)args->previous_vertices;
+
+      std::unordered_set<VertexType> split_labels;
+      for (size_t i = 0; i < args->count_deletions; ++i) {
+        split_labels.insert(previous_labels[args->deletions[i].src]);
+        split_labels.insert(previous_labels[args->deletions[i].tgt]);
+      }
+
+      memset(vertices->active_current, 0x00,
+             vertices->size_active * sizeof(char));
+      size_t count_reset = 0;
+      for (size_t i = 0; i < vertices->count; ++i) {
+        if (split_labels.count(previous_labels[i]) > 0) {
+          vertices->current[i] = i;
+          set_active(vertices->active_current, i);
+          ++count_reset;
+        } else {
+          vertices->current[i] = previous_labels[i];
+        }
+        vertices->next[i] = vertices->current[i];
+      }
+      for (size_t i = 0; i < args->count_insertions; ++i) {
+        set_active(vertices->active_current, args->insertions[i].src);
+        set_active(vertices->active_current, args->insertions[i].tgt);
+      }
+
+      sg_log("Restarting %lu vertices of %lu split components\n", count_reset,
+             split_labels.size());
+    }
+
     // reset current-array for next round
     static void reset_vertices(vertex_array_t<VertexType>* vertices,
                                bool* switchCurrentNext) {
+      // the current-array becomes the next-array, reduce into the latest
+      // labels instead of the ones from two rounds ago
+      memcpy(vertices->current, vertices->next,
+             sizeof(VertexType) * vertices->count);
       memset(vertices->active_current, 0x00,
              vertices->size_active * sizeof(char));
     }
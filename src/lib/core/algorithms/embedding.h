@@ -0,0 +1,173 @@
+#pragma once
+
+#include <string.h>
+#include <core/util.h>
+#include <core/datatypes.h>
+#include <core/vertex-vector.h>
+
+#include "algorithm-common.h"
+
+// dimensions of the vertex embeddings run by the engines
+#define EMBEDDING_DIMENSIONS 16
+
+#define EMBEDDING_ALPHA 0.85
+
+#define EMBEDDING_EPSILON 0.01
+
+namespace scalable_graphs {
+namespace core {
+  // Embedding propagation: every vertex starts from a random seed vector,
+  // which is spread along the out-edges like the rank of PageRank, per
+  // dimension and normalized by the out-degree, and restarts at the seed
+  // with probability 1 - EMBEDDING_ALPHA. Vertices close in the graph end up
+  // with similar vectors. Weighted graphs scale every contribution by the
+  // edge weight.
+  template <size_t K>
+  class Embedding {
+  public:
+    typedef vertex_vector_t<K> VertexType;
+
+    const static bool need_active_block = false;
+    const static bool need_active_source_block = false;
+    const static bool need_active_source_input = false;
+    const static bool need_active_target_block = false;
+    const static bool need_degrees_source_block = true;
+    const static bool need_degrees_target_block = false;
+    const static bool need_vertex_block_extension_fields = false;
+    const static bool need_buckets = false;
+    const static bool need_residual = true;
+    const static bool need_transposed_tiles = false;
+
+    const static size_t max_size_extension_fields_vertex_block = 0;
+    const static size_t count_partial_sums = 0;
+
+#ifndef TARGET_ARCH_K1OM
+    constexpr static VertexType neutral_element = {};
+#endif
+
+    Embedding() = delete;
+    ~Embedding() = delete;
+
+    static inline size_t
+    sizeExtensionFieldsVertexBlock(const tile_stats_t& tile_stats) {
+      // not needed
+      return 0;
+    }
+
+    static inline void fillExtensionFieldsVertexBlock(
+        void* extension_fields,
+        const volatile edge_block_index_t* edge_block_index,
+        const uint32_t* src_index, const uint32_t* tgt_index,
+        const vertex_array_t<VertexType>* vertex_array) {
+      // not applicable
+    }
+
+    static inline void gather(const VertexType& u, VertexType& v, uint16_t id,
+                              void* extension_fields) {
+      v.addScaled(u, 1.);
+    }
+
+    static inline void
+    pullGather(const VertexType& u, VertexType& v, uint16_t id_src,
+               uint16_t id_tgt, const vertex_degree_t* src_degree,
+               const vertex_degree_t* tgt_degree, char* active_array_src,
+               char* active_array_tgt, const config_edge_processor_t& config,
+               void* extension_fields) {
+      v.addScaled(u, 1. / src_degree->out_degree);
+    }
+
+    static inline void pullGatherWeighted(
+        const VertexType& u, VertexType& v, const float weight, uint16_t id_src,
+        uint16_t id_tgt, const vertex_degree_t* src_degree,
+        const vertex_degree_t* tgt_degree, char* active_array_src,
+        char* active_array_tgt, const config_edge_processor_t& config,
+        void* extension_fields) {
+      v.addScaled(u, weight / src_degree->out_degree);
+    }
+
+    // Seed vector of a vertex with entries in [-1, 1), derived from the id so
+    // that apply can restart at it without storing it.
+    static inline void seed(uint64_t id, VertexType* seed) {
+      unsigned int state = (unsigned int)(id * 2654435761u + 1);
+      for (size_t i = 0; i < K; ++i) {
+        seed->values[i] = rand32(&state) / (float)(1u << 30) - 1.f;
+      }
+    }
+
+    static inline void apply(vertex_array_t<VertexType>* vertices,
+                             const uint64_t id,
+                             const config_vertex_domain_t& config,
+                             const uint32_t iteration) {
+      VertexType restart;
+      seed(id, &restart);
+      vertices->next[id].scale(EMBEDDING_ALPHA);
+      vertices->next[id].addScaled(restart, 1 - EMBEDDING_ALPHA);
+      if (vertices->current[id].distance(vertices->next[id]) >
+          EMBEDDING_EPSILON) {
+        set_active(vertices->active_next, id);
+      }
+    }
+
+    static inline double residual(const vertex_array_t<VertexType>* vertices,
+                                  const uint64_t id) {
+      // the change of the vector
+      return vertices->current[id].distance(vertices->next[id]);
+    }
+
+    static inline void
+    accumulatePartialSums(const vertex_array_t<VertexType>* vertices,
+                          const uint64_t id, double* partial_sums) {
+      // not applicable
+    }
+
+    static inline void
+    reduceVertex(VertexType& out, const VertexType& lhs, const VertexType& rhs,
+                 const uint64_t& id_tgt, const vertex_degree_t& degree,
+                 char* active_array, const config_vertex_domain_t& config) {
+      // out may be rhs
+      VertexType sum = rhs;
+      sum.addScaled(lhs, 1.);
+      out = sum;
+    }
+
+    static void init_vertices(vertex_array_t<VertexType>* vertices,
+                              void* args) {
+      sg_print("Init vertices\n");
+      for (size_t i = 0; i < vertices->count; ++i) {
+        seed(i, &vertices->current[i]);
+      }
+      // all vertices active in the beginning
+      memset(vertices->next, 0, sizeof(VertexType) * vertices->count);
+      memset(vertices->active_current, (unsigned char)255,
+             vertices->size_active * sizeof(char));
+      memset(vertices->active_next, (unsigned char)255,
+             vertices->size_active * sizeof(char));
+    }
+
+    // reset current-array for next round
+    static void reset_vertices(vertex_array_t<VertexType>* vertices,
+                               bool* switchCurrentNext) {
+      sg_print("Resetting vertices for next round\n");
+      // the current-array becomes the next-array, which is summed into
+      memset(vertices->current, 0, sizeof(VertexType) * vertices->count);
+      memset(vertices->active_current, 0x00,
+             vertices->size_active * sizeof(char));
+    }
+
+    static void pre_processing_per_round(vertex_array_t<VertexType>* vertices,
+                                         const config_vertex_domain_t& config,
+                                         const uint32_t iteration) {}
+
+    static inline void
+    reset_vertices_tile_processor(VertexType* tgt_vertices,
+                                  const size_t response_vertices) {
+      memset(tgt_vertices, 0, sizeof(VertexType) * response_vertices);
+    }
+  };
+
+#ifndef TARGET_ARCH_K1OM
+  template <size_t K>
+  constexpr typename Embedding<K>::VertexType Embedding<K>::neutral_element;
+#endif
+}
+}
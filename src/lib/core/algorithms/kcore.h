@@ -0,0 +1,196 @@
+#pragma once
+
+#include <limits.h>
+#include <string.h>
+#include <core/util.h>
+#include <core/datatypes.h>
+
+#include "algorithm-common.h"
+
+namespace scalable_graphs {
+namespace core {
+  // k-core decomposition by peeling: k is the current bucket of the
+  // VertexDomain, every vertex not peeled yet is parked in the bucket of its
+  // residual degree, starting from its in-degree. A vertex falling to k or
+  // below is peeled with coreness k and active for the next round, in which
+  // it decrements the residual degree of its out-neighbors. Once no vertex is
+  // active anymore, k advances to the smallest residual degree left, whose
+  // vertices are peeled right away. Only the just peeled vertices are
+  // gathered from, with selective scheduling only their tiles are fetched.
+  //
+  // The degrees of both directions have to be the same, i.e. the graph has to
+  // be symmetric, on a directed graph the decomposition is by in-degree.
+  class KCore {
+  public:
+    // In the tile responses degree counts the peeled in-neighbors instead of
+    // the residual degree, core is UINT32_MAX until the vertex is peeled.
+    struct VertexType {
+      uint32_t degree;
+      uint32_t core;
+
+      VertexType& operator=(const uint32_t& from) {
+        degree = from;
+        return *this;
+      }
+
+      bool operator==(const VertexType& other) const {
+        return degree == other.degree && core == other.core;
+      }
+      bool operator!=(const VertexType& other) const {
+        return !(*this == other);
+      }
+
+      friend std::ostream& operator<<(std::ostream& stream,
+                                      const VertexType& v);
+    };
+
+    const static bool need_active_block = false;
+    const static bool need_active_source_block = false;
+    const static bool need_active_source_input = true;
+    const static bool need_active_target_block = false;
+    const static bool need_degrees_source_block = false;
+    const static bool need_degrees_target_block = false;
+    const static bool need_vertex_block_extension_fields = false;
+    const static bool need_buckets = true;
+    const static bool need_residual = true;
+    const static bool need_transposed_tiles = false;
+
+    const static size_t max_size_extension_fields_vertex_block = 0;
+    const static size_t count_partial_sums = 0;
+
+#ifndef TARGET_ARCH_K1OM
+    constexpr const static VertexType neutral_element = {0, 0};
+#endif
+
+    KCore() = delete;
+    ~KCore() = delete;
+
+    static inline size_t
+    sizeExtensionFieldsVertexBlock(const tile_stats_t& tile_stats) {
+      // not needed
+      return 0;
+    }
+
+    static inline void fillExtensionFieldsVertexBlock(
+        void* extension_fields,
+        const volatile edge_block_index_t* edge_block_index,
+        const uint32_t* src_index, const uint32_t* tgt_index,
+        const vertex_array_t<VertexType>* vertex_array) {
+      // not applicable
+    }
+
+    static inline void gather(const VertexType& u, VertexType& v, uint16_t id,
+                              void* extension_fields) {
+      v.degree += u.degree;
+    }
+
+    static inline void
+    pullGather(const VertexType& u, VertexType& v, uint16_t id_src,
+               uint16_t id_tgt, const vertex_degree_t* src_degree,
+               const vertex_degree_t* tgt_degree, char* active_array_src,
+               char* active_array_tgt, const config_edge_processor_t& config,
+               void* extension_fields) {
+      // the source was peeled in the last round
+      ++v.degree;
+    }
+
+    static inline void pullGatherWeighted(
+        const VertexType& u, VertexType& v, const float weight, uint16_t id_src,
+        uint16_t id_tgt, const vertex_degree_t* src_degree,
+        const vertex_degree_t* tgt_degree, char* active_array_src,
+        char* active_array_tgt, const config_edge_processor_t& config,
+        void* extension_fields) {
+      // not applicable
+    }
+
+    static inline void apply(vertex_array_t<VertexType>* vertices,
+                             const uint64_t id,
+                             const config_vertex_domain_t& config,
+                             const uint32_t iteration) {
+      VertexType& vertex = vertices->next[id];
+      if (vertex.core != UINT32_MAX) {
+        return;
+      }
+      vertex_buckets_t* buckets = vertices->buckets;
+      if (eval_bool_array(vertices->active_current, id)) {
+        // peeled on advancing k, decremented its neighbors in this round
+        vertex.core = buckets->current;
+      } else if (vertex.degree <= buckets->current) {
+        vertex.core = buckets->current;
+        set_inactive(buckets->pending, id);
+        set_active(vertices->active_next, id);
+      } else {
+        buckets->bucket[id] = vertex.degree;
+      }
+    }
+
+    static inline double residual(const vertex_array_t<VertexType>* vertices,
+                                  const uint64_t id) {
+      // count of vertices peeled in this round
+      return eval_bool_array(vertices->active_next, id) ? 1 : 0;
+    }
+
+    static inline void
+    accumulatePartialSums(const vertex_array_t<VertexType>* vertices,
+                          const uint64_t id, double* partial_sums) {
+      // not applicable
+    }
+
+    static inline void
+    reduceVertex(VertexType& out, const VertexType& lhs, const VertexType& rhs,
+                 const uint64_t& id_tgt, const vertex_degree_t& degree,
+                 char* active_array, const config_vertex_domain_t& config) {
+      out.core = rhs.core;
+      out.degree = rhs.degree > lhs.degree ? rhs.degree - lhs.degree : 0;
+    }
+
+    static void init_vertices(vertex_array_t<VertexType>* vertices,
+                              void* args) {
+      sg_print("Init vertices\n");
+      vertex_buckets_t* buckets = vertices->buckets;
+      memset(vertices->active_current, 0x00,
+             vertices->size_active * sizeof(char));
+      memset(buckets->pending, (unsigned char)255,
+             vertices->size_active * sizeof(char));
+      for (size_t i = 0; i < vertices->count; ++i) {
+        vertices->current[i].degree = vertices->degrees[i].in_degree;
+        vertices->current[i].core = UINT32_MAX;
+        vertices->next[i] = vertices->current[i];
+        buckets->bucket[i] = vertices->degrees[i].in_degree;
+      }
+      // start peeling at the smallest degree
+      advanceBucket(vertices, [](size_t) {});
+    }
+
+    // reset current-array for next round
+    static void reset_vertices(vertex_array_t<VertexType>* vertices,
+                               bool* switchCurrentNext) {
+      // the current-array becomes the next-array, reduce into the latest
+      // residual degrees instead of the ones from two rounds ago
+      memcpy(vertices->current, vertices->next,
+             sizeof(VertexType) * vertices->count);
+      memset(vertices->active_current, 0x00,
+             vertices->size_active * sizeof(char));
+    }
+
+    static void pre_processing_per_round(vertex_array_t<VertexType>* vertices,
+                                         const config_vertex_domain_t& config,
+                                         const uint32_t iteration) {}
+
+    static inline void
+    reset_vertices_tile_processor(VertexType* tgt_vertices,
+                                  const size_t response_vertices) {
+      memset(tgt_vertices, 0, sizeof(VertexType) * response_vertices);
+    }
+  };
+
+#ifndef TARGET_ARCH_K1OM
+  constexpr const KCore::VertexType KCore::neutral_element;
+#endif
+
+  // only the coreness, for the text output of the results
+  std::ostream& operator<<(std::ostream& stream, const KCore::VertexType& v) {
+    return stream << v.core;
+  }
+}
+}
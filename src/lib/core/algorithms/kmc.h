@@ -1,43 +1,113 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <float.h>
 #include <limits.h>
 #include <string.h>
+#include <ostream>
 #include <core/util.h>
 #include <core/datatypes.h>
 
 #include "algorithm-common.h"
 
-#define NUM_CLUSTERS 4
+// clusters of the k-means run by the engines
+#define KMC_CLUSTERS 4
+
+// weight of the neighbors' votes against the distance to the centroids
+#define KMC_LAMBDA 0.05
 
 namespace scalable_graphs {
 namespace core {
-  class KMC {
+  // Vertex value of k-means: the feature of the vertex, its cluster and the
+  // votes of its in-neighbors for each of the K clusters.
+  template <size_t K>
+  struct kmc_vertex_t {
+    float x_cord;
+    uint32_t designated_cluster;
+    float votes[K];
 
-    struct VertexType {
-      float x_cord;
-      int designated_cluster;
-    };
+    // a vertex of the given feature in the first cluster without votes, what
+    // LFM_ConstantValue relies on
+    kmc_vertex_t& operator=(float value) {
+      x_cord = value;
+      designated_cluster = 0;
+      clearVotes();
+      return *this;
+    }
+
+    bool operator==(const kmc_vertex_t& other) const {
+      if (x_cord != other.x_cord ||
+          designated_cluster != other.designated_cluster) {
+        return false;
+      }
+      for (size_t i = 0; i < K; ++i) {
+        if (votes[i] != other.votes[i]) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    bool operator!=(const kmc_vertex_t& other) const {
+      return !(*this == other);
+    }
+
+    inline void clearVotes() {
+      for (size_t i = 0; i < K; ++i) {
+        votes[i] = 0.;
+      }
+    }
+  };
+
+  // only the cluster, for the text output of the results
+  template <size_t K>
+  std::ostream& operator<<(std::ostream& stream, const kmc_vertex_t<K>& v) {
+    return stream << v.designated_cluster;
+  }
+
+  // Graph-regularized k-means on a scalar feature per vertex, read from the
+  // features file (--features-file) or, without one, derived from the id.
+  // Every round a vertex joins the cluster minimizing the squared distance of
+  // its feature to the centroid plus KMC_LAMBDA times the share of the votes
+  // of its in-neighbors going to other clusters. A neighbor votes for its own
+  // cluster, the closer it lies to that centroid the more weight the vote
+  // has, for which the centroids ship to the edge engines in the extension
+  // fields of every tile. The VertexAppliers sum up the count and the
+  // features of the members of each cluster per thread, the centroids of the
+  // next round follow in reset_vertices. Converges once no vertex changes
+  // its cluster anymore.
+  template <size_t K>
+  class KMC {
+  public:
+    typedef kmc_vertex_t<K> VertexType;
 
     struct cluster_information_t {
-      float cord_cluster[NUM_CLUSTERS];
+      float cord_cluster[K];
     };
 
-  public:
     const static bool need_active_block = false;
     const static bool need_active_source_block = false;
     const static bool need_active_source_input = false;
     const static bool need_active_target_block = false;
     const static bool need_degrees_source_block = false;
     const static bool need_degrees_target_block = false;
-    const static bool need_vertex_block_extension_fields = false;
+    const static bool need_vertex_block_extension_fields = true;
+    const static bool need_buckets = false;
+    const static bool need_residual = true;
+    const static bool need_transposed_tiles = false;
 
-    const static size_t max_size_extension_fields_vertex_block = 0;
+    const static size_t max_size_extension_fields_vertex_block =
+        sizeof(cluster_information_t);
+    // count and sum of the features of the members of every cluster
+    const static size_t count_partial_sums = 2 * K;
 
+    // centroids of the current round, only valid on the vertex domain, the
+    // edge engines use the copy in the extension fields
     static cluster_information_t cluster_info;
 
 #ifndef TARGET_ARCH_K1OM
-    constexpr const static VertexType neutral_element = {0., 0};
+    constexpr static VertexType neutral_element = {};
 #endif
 
     KMC() = delete;
@@ -45,7 +115,7 @@ namespace core {
 
     static inline size_t
     sizeExtensionFieldsVertexBlock(const tile_stats_t& tile_stats) {
-      // not required in this case
+      return sizeof(cluster_information_t);
     }
 
     static inline void fillExtensionFieldsVertexBlock(
@@ -53,12 +123,22 @@ namespace core {
         const volatile edge_block_index_t* edge_block_index,
         const uint32_t* src_index, const uint32_t* tgt_index,
         const vertex_array_t<VertexType>* vertex_array) {
-      // not required in this case
+      memcpy(extension_fields, &cluster_info, sizeof(cluster_information_t));
+    }
+
+    // Weight of the vote of u, in (0, 1], in (0.5, 1] for features in
+    // [0, 1).
+    static inline float voteWeight(const VertexType& u,
+                                   const void* extension_fields) {
+      const cluster_information_t* centroids =
+          (const cluster_information_t*)extension_fields;
+      float centroid = centroids->cord_cluster[u.designated_cluster];
+      return 1.f / (1.f + get_distance(u.x_cord, centroid));
     }
 
     static inline void gather(const VertexType& u, VertexType& v, uint16_t id,
                               void* extension_fields) {
-      // not required in this case
+      v.votes[u.designated_cluster] += voteWeight(u, extension_fields);
     }
 
     static inline void
@@ -67,7 +147,7 @@ namespace core {
                const vertex_degree_t* tgt_degree, char* active_array_src,
                char* active_array_tgt, const config_edge_processor_t& config,
                void* extension_fields) {
-      // not required in this case
+      v.votes[u.designated_cluster] += voteWeight(u, extension_fields);
     }
 
     static inline void pullGatherWeighted(
@@ -76,7 +156,33 @@ namespace core {
         const vertex_degree_t* tgt_degree, char* active_array_src,
         char* active_array_tgt, const config_edge_processor_t& config,
         void* extension_fields) {
-      // not required in this case
+      v.votes[u.designated_cluster] +=
+          weight * voteWeight(u, extension_fields);
+    }
+
+    // Cluster minimizing the distance plus the regularization by the votes,
+    // the nearest centroid if there are no votes.
+    static inline uint32_t
+    nearestCluster(float x_cord, const float* votes,
+                   const cluster_information_t& centroids) {
+      float sum_votes = 0.;
+      for (size_t i = 0; i < K; ++i) {
+        sum_votes += votes[i];
+      }
+      float min_cost = FLT_MAX;
+      uint32_t cid = 0;
+      for (size_t i = 0; i < K; ++i) {
+        float distance = get_distance(x_cord, centroids.cord_cluster[i]);
+        float cost = distance * distance;
+        if (sum_votes > 0.) {
+          cost += KMC_LAMBDA * (1. - votes[i] / sum_votes);
+        }
+        if (cost < min_cost) {
+          min_cost = cost;
+          cid = i;
+        }
+      }
+      return cid;
     }
 
     static inline void apply(vertex_array_t<VertexType>* vertices,
@@ -84,86 +190,127 @@ namespace core {
                              const config_vertex_domain_t& config,
                              const uint32_t iteration) {
       VertexType& v = vertices->next[id];
-      float min_distance = FLT_MAX;
-      int cid = 0;
-      for (int i = 0; i < NUM_CLUSTERS; ++i) {
-        float distance =
-            get_distance(v.x_cord, KMC::cluster_info.cord_cluster[i]);
-        if (distance < min_distance) {
-          min_distance = distance;
-          cid = i;
-        }
-      }
-      v.designated_cluster = cid;
+      v.designated_cluster =
+          nearestCluster(v.x_cord, v.votes, KMC::cluster_info);
+      // every vertex votes again in the next round
+      set_active(vertices->active_next, id);
+    }
+
+    static inline double residual(const vertex_array_t<VertexType>* vertices,
+                                  const uint64_t id) {
+      // count of vertices changing their cluster
+      return vertices->next[id].designated_cluster !=
+                     vertices->current[id].designated_cluster
+                 ? 1
+                 : 0;
+    }
+
+    static inline void
+    accumulatePartialSums(const vertex_array_t<VertexType>* vertices,
+                          const uint64_t id, double* partial_sums) {
+      const VertexType& v = vertices->next[id];
+      partial_sums[2 * v.designated_cluster] += 1.;
+      partial_sums[2 * v.designated_cluster + 1] += v.x_cord;
     }
 
     static inline void
     reduceVertex(VertexType& out, const VertexType& lhs, const VertexType& rhs,
                  const uint64_t& id_tgt, const vertex_degree_t& degree,
                  char* active_array, const config_vertex_domain_t& config) {
-      // not required in this case
+      // out may be rhs, lhs only carries votes
+      VertexType sum = rhs;
+      for (size_t i = 0; i < K; ++i) {
+        sum.votes[i] += lhs.votes[i];
+      }
+      out = sum;
+    }
+
+    // Feature of a vertex in [0, 1), derived from the id, for runs without
+    // features such as the tests.
+    static inline float feature(uint64_t id) {
+      unsigned int state = (unsigned int)(id * 2654435761u + 1);
+      // 24 bits, which a float holds exactly
+      return (rand32(&state) >> 7) / (float)(1u << 24);
     }
 
     static void init_vertices(vertex_array_t<VertexType>* vertices,
                               void* args) {
       sg_print("Init vertices\n");
+      init_args_t* init_args = (init_args_t*)args;
+      const float* features = NULL;
+      if (init_args != NULL && init_args->count_features > 0) {
+        features = init_args->features;
+      }
 
-      unsigned int seed = rand32_seedless();
-      float* clusters = KMC::cluster_info.cord_cluster;
-      for (int i = 0; i < NUM_CLUSTERS; ++i) {
-        clusters[i] = (float)rand32(&seed);
+      // centroids spread evenly over the range of the features
+      float min_feature = 0.f;
+      float max_feature = 1.f;
+      if (features != NULL) {
+        min_feature = *std::min_element(features, features + vertices->count);
+        max_feature = *std::max_element(features, features + vertices->count);
+      }
+      for (size_t i = 0; i < K; ++i) {
+        cluster_info.cord_cluster[i] =
+            min_feature + (i + 0.5f) * (max_feature - min_feature) / K;
       }
 
-      for (int i = 0; i < vertices->count; ++i) {
-        vertices->current[i].x_cord = (float)rand32(&seed);
-        vertices->current[i].designated_cluster = -1;
-        vertices->next[i].x_cord = FLT_MAX;
-        vertices->next[i].designated_cluster = -1;
+      memset(vertices->current, 0, sizeof(VertexType) * vertices->count);
+      for (size_t i = 0; i < vertices->count; ++i) {
+        VertexType& v = vertices->current[i];
+        v.x_cord = features != NULL ? features[i] : feature(i);
+        v.designated_cluster = nearestCluster(v.x_cord, v.votes, cluster_info);
+        vertices->next[i] = v;
       }
       // all vertices active in the beginning
       memset(vertices->active_current, (unsigned char)255,
              vertices->size_active * sizeof(char));
+      memset(vertices->active_next, (unsigned char)255,
+             vertices->size_active * sizeof(char));
     }
 
     // reset current-array for next round
     static void reset_vertices(vertex_array_t<VertexType>* vertices,
                                bool* switchCurrentNext) {
       sg_print("Resetting vertices for next round\n");
-      // activate all vertices for next round
-
-      memset(vertices->active_next, (unsigned char)255,
+      // move the centroids to the mean of their members, empty clusters keep
+      // theirs
+      for (size_t i = 0; i < K; ++i) {
+        double count = vertices->partial_sums[2 * i];
+        if (count > 0.) {
+          cluster_info.cord_cluster[i] =
+              vertices->partial_sums[2 * i + 1] / count;
+        }
+      }
+      // the current-array becomes the next-array, which collects the votes
+      for (size_t i = 0; i < vertices->count; ++i) {
+        vertices->current[i] = vertices->next[i];
+        vertices->current[i].clearVotes();
+      }
+      memset(vertices->active_current, 0x00,
              vertices->size_active * sizeof(char));
-      // reset all values of current-array, for next round
-      *switchCurrentNext = false;
     }
 
     static void pre_processing_per_round(vertex_array_t<VertexType>* vertices,
                                          const config_vertex_domain_t& config,
-                                         const uint32_t iteration) {
-      if (iteration == 0)
-        return;
-
-      int elems_per_cluster[NUM_CLUSTERS] = {0};
-      float total_distance[NUM_CLUSTERS] = {0.};
-      VertexType* v = vertices->current;
-      for (int i = 0; i < vertices->count; ++i) {
-        int cid = v[i].designated_cluster;
-        ++elems_per_cluster[cid];
-        total_distance[cid] += v[i].x_cord;
-      }
-      for (int i = 0; i < NUM_CLUSTERS; ++i)
-        cluster_info.cord_cluster[i] = total_distance[i] / elems_per_cluster[i];
-    }
+                                         const uint32_t iteration) {}
 
     static inline void
     reset_vertices_tile_processor(VertexType* tgt_vertices,
                                   const size_t response_vertices) {
-      // not required in this case
+      memset(tgt_vertices, 0, sizeof(VertexType) * response_vertices);
     }
 
     static inline float get_distance(float x, float y) {
-      return std::sqrt((y - x) * (y - x));
+      return std::fabs(y - x);
     }
   };
+
+  template <size_t K>
+  typename KMC<K>::cluster_information_t KMC<K>::cluster_info;
+
+#ifndef TARGET_ARCH_K1OM
+  template <size_t K>
+  constexpr typename KMC<K>::VertexType KMC<K>::neutral_element;
+#endif
 }
 }
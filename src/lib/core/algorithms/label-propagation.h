@@ -0,0 +1,190 @@
+#pragma once
+
+#include <string.h>
+#include <core/util.h>
+#include <core/datatypes.h>
+#include <core/label-sketch.h>
+
+#include "algorithm-common.h"
+
+// labels tracked per vertex in the sketch of the votes of its neighbors
+#define LABEL_PROPAGATION_SKETCH_SIZE 8
+
+namespace scalable_graphs {
+namespace core {
+  // Label propagation community detection: every vertex starts with its own
+  // id as label and adopts the label most of its in-neighbors and itself
+  // hold, ties going to the smaller label. The votes of a target are counted
+  // in a bounded heavy-hitter sketch, so the state per vertex stays fixed no
+  // matter the degree. Labels only become heavy hitters once communities
+  // form, vertices with more distinct labels around them than fit into the
+  // sketch settle on an approximate majority.
+  //
+  // A target keeps the sketch of its votes from round to round in the vertex
+  // array. Only sources which changed their label in the last round vote,
+  // withdrawing their vote for the previous label and adding one for the new
+  // label, the tile responses hold these deltas, which are merged into the
+  // kept sketch on reduce. Only vertices changing their label are activated,
+  // with selective scheduling the tiles of stable sources are skipped, as
+  // they would not vote anyway. The run ends once all labels are stable.
+  template <size_t K>
+  class LabelPropagation {
+  public:
+    typedef label_sketch_t<K> VertexType;
+
+    const static bool need_active_block = false;
+    const static bool need_active_source_block = false;
+    const static bool need_active_source_input = false;
+    const static bool need_active_target_block = false;
+    const static bool need_degrees_source_block = false;
+    const static bool need_degrees_target_block = false;
+    const static bool need_vertex_block_extension_fields = false;
+    const static bool need_buckets = false;
+    const static bool need_residual = true;
+    const static bool need_transposed_tiles = false;
+
+    const static size_t max_size_extension_fields_vertex_block = 0;
+    const static size_t count_partial_sums = 0;
+
+    // previous_label of the vertices before their first vote
+    const static uint32_t no_label = UINT32_MAX;
+
+#ifndef TARGET_ARCH_K1OM
+    constexpr static VertexType neutral_element = {};
+#endif
+
+    LabelPropagation() = delete;
+    ~LabelPropagation() = delete;
+
+    static inline size_t
+    sizeExtensionFieldsVertexBlock(const tile_stats_t& tile_stats) {
+      // not needed
+      return 0;
+    }
+
+    static inline void fillExtensionFieldsVertexBlock(
+        void* extension_fields,
+        const volatile edge_block_index_t* edge_block_index,
+        const uint32_t* src_index, const uint32_t* tgt_index,
+        const vertex_array_t<VertexType>* vertex_array) {
+      // not applicable
+    }
+
+    static inline void gather(const VertexType& u, VertexType& v, uint16_t id,
+                              void* extension_fields) {
+      v.merge(u);
+    }
+
+    static inline void
+    pullGather(const VertexType& u, VertexType& v, uint16_t id_src,
+               uint16_t id_tgt, const vertex_degree_t* src_degree,
+               const vertex_degree_t* tgt_degree, char* active_array_src,
+               char* active_array_tgt, const config_edge_processor_t& config,
+               void* extension_fields) {
+      if (u.label == u.previous_label) {
+        return;
+      }
+      v.add(u.label, 1);
+      if (u.previous_label != no_label) {
+        v.add(u.previous_label, -1);
+      }
+    }
+
+    static inline void pullGatherWeighted(
+        const VertexType& u, VertexType& v, const float weight, uint16_t id_src,
+        uint16_t id_tgt, const vertex_degree_t* src_degree,
+        const vertex_degree_t* tgt_degree, char* active_array_src,
+        char* active_array_tgt, const config_edge_processor_t& config,
+        void* extension_fields) {
+      // not applicable
+    }
+
+    static inline void apply(vertex_array_t<VertexType>* vertices,
+                             const uint64_t id,
+                             const config_vertex_domain_t& config,
+                             const uint32_t iteration) {
+      VertexType& votes = vertices->next[id];
+      uint32_t label = vertices->current[id].label;
+
+      // the own vote, which is not kept
+      VertexType all_votes = votes;
+      all_votes.add(label, 1);
+
+      uint32_t majority = all_votes.majority(label);
+      if (majority != label) {
+        set_active(vertices->active_next, id);
+      }
+      votes.previous_label = label;
+      votes.label = majority;
+    }
+
+    static inline double residual(const vertex_array_t<VertexType>* vertices,
+                                  const uint64_t id) {
+      // count of vertices changing their label
+      return eval_bool_array(vertices->active_next, id) ? 1 : 0;
+    }
+
+    static inline void
+    accumulatePartialSums(const vertex_array_t<VertexType>* vertices,
+                          const uint64_t id, double* partial_sums) {
+      // not applicable
+    }
+
+    static inline void
+    reduceVertex(VertexType& out, const VertexType& lhs, const VertexType& rhs,
+                 const uint64_t& id_tgt, const vertex_degree_t& degree,
+                 char* active_array, const config_vertex_domain_t& config) {
+      // out may be rhs, the deltas of lhs go into the kept votes of rhs
+      VertexType merged = rhs;
+      merged.merge(lhs);
+      out = merged;
+    }
+
+    static void init_vertices(vertex_array_t<VertexType>* vertices,
+                              void* args) {
+      sg_print("Init vertices\n");
+      // every vertex votes for its own id in the first round
+      memset(vertices->current, 0, sizeof(VertexType) * vertices->count);
+      for (size_t i = 0; i < vertices->count; ++i) {
+        vertices->current[i].label = i;
+        vertices->current[i].previous_label = no_label;
+      }
+      memcpy(vertices->next, vertices->current,
+             sizeof(VertexType) * vertices->count);
+      // all vertices active in the beginning
+      memset(vertices->active_current, (unsigned char)255,
+             vertices->size_active * sizeof(char));
+      memset(vertices->active_next, (unsigned char)255,
+             vertices->size_active * sizeof(char));
+    }
+
+    // reset current-array for next round
+    static void reset_vertices(vertex_array_t<VertexType>* vertices,
+                               bool* switchCurrentNext) {
+      sg_print("Resetting vertices for next round\n");
+      // the current-array becomes the next-array, merge the deltas of the
+      // next round into the latest votes
+      memcpy(vertices->current, vertices->next,
+             sizeof(VertexType) * vertices->count);
+      memset(vertices->active_current, 0x00,
+             vertices->size_active * sizeof(char));
+    }
+
+    static void pre_processing_per_round(vertex_array_t<VertexType>* vertices,
+                                         const config_vertex_domain_t& config,
+                                         const uint32_t iteration) {}
+
+    static inline void
+    reset_vertices_tile_processor(VertexType* tgt_vertices,
+                                  const size_t response_vertices) {
+      memset(tgt_vertices, 0, sizeof(VertexType) * response_vertices);
+    }
+  };
+
+#ifndef TARGET_ARCH_K1OM
+  template <size_t K>
+  constexpr typename LabelPropagation<K>::VertexType
+      LabelPropagation<K>::neutral_element;
+#endif
+}
+}
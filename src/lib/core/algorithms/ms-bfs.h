@@ -0,0 +1,243 @@
+#pragma once
+
+#include <string.h>
+#include <core/util.h>
+#include <core/datatypes.h>
+
+#include "algorithm-common.h"
+
+namespace scalable_graphs {
+namespace core {
+  // Multi-source BFS, running up to 64 traversals in one pass over the tiles:
+  // Bit i of a vertex stands for the BFS from the i-th root. The frontier
+  // holds the traversals which reached the vertex in the last round, the
+  // edges propagate it by a bitwise OR. A vertex is active as long as its
+  // frontier is not empty. The level of a vertex for root i is the round in
+  // which bit i first shows up in its frontier, the levels are summed up per
+  // root in distances, for the closeness of the roots.
+  class MSBFS {
+  public:
+    static const size_t max_count_roots = 64;
+
+    // Per traversal, the count of vertices reached and the sum of their
+    // levels, the root included. Only valid on the vertex domain.
+    struct distances_t {
+      size_t count_roots;
+      uint64_t roots[max_count_roots];
+      uint32_t level;
+      uint64_t count_reached[max_count_roots];
+      double sum_distances[max_count_roots];
+    };
+
+    struct VertexType {
+      uint64_t visited;
+      uint64_t frontier;
+
+      VertexType& operator=(const uint64_t& from) {
+        frontier = from;
+        return *this;
+      }
+
+      bool operator==(const VertexType& other) const {
+        return visited == other.visited && frontier == other.frontier;
+      }
+      bool operator!=(const VertexType& other) const {
+        return !(*this == other);
+      }
+
+      friend std::ostream& operator<<(std::ostream& stream,
+                                      const VertexType& v);
+    };
+
+    const static bool need_active_block = false;
+    const static bool need_active_source_block = false;
+    const static bool need_active_source_input = true;
+    const static bool need_active_target_block = false;
+    const static bool need_degrees_source_block = false;
+    const static bool need_degrees_target_block = false;
+    const static bool need_vertex_block_extension_fields = false;
+    const static bool need_buckets = false;
+    const static bool need_residual = true;
+    const static bool need_transposed_tiles = false;
+
+    const static size_t max_size_extension_fields_vertex_block = 0;
+    // per traversal, the count of vertices reached in the round
+    const static size_t count_partial_sums = max_count_roots;
+
+    static distances_t distances;
+
+#ifndef TARGET_ARCH_K1OM
+    constexpr const static VertexType neutral_element = {0, 0};
+#endif
+
+    MSBFS() = delete;
+    ~MSBFS() = delete;
+
+    static inline size_t
+    sizeExtensionFieldsVertexBlock(const tile_stats_t& tile_stats) {
+      // not needed
+      return 0;
+    }
+
+    static inline void fillExtensionFieldsVertexBlock(
+        void* extension_fields,
+        const volatile edge_block_index_t* edge_block_index,
+        const uint32_t* src_index, const uint32_t* tgt_index,
+        const vertex_array_t<VertexType>* vertex_array) {
+      // not applicable
+    }
+
+    static inline void gather(const VertexType& u, VertexType& v, uint16_t id,
+                              void* extension_fields) {
+      v.frontier |= u.frontier;
+    }
+
+    static inline void
+    pullGather(const VertexType& u, VertexType& v, uint16_t id_src,
+               uint16_t id_tgt, const vertex_degree_t* src_degree,
+               const vertex_degree_t* tgt_degree, char* active_array_src,
+               char* active_array_tgt, const config_edge_processor_t& config,
+               void* extension_fields) {
+      // branch-free, all 64 traversals at once
+      v.frontier |= u.frontier;
+    }
+
+    static inline void pullGatherWeighted(
+        const VertexType& u, VertexType& v, const float weight, uint16_t id_src,
+        uint16_t id_tgt, const vertex_degree_t* src_degree,
+        const vertex_degree_t* tgt_degree, char* active_array_src,
+        char* active_array_tgt, const config_edge_processor_t& config,
+        void* extension_fields) {
+      // not applicable
+    }
+
+    static inline void apply(vertex_array_t<VertexType>* vertices,
+                             const uint64_t id,
+                             const config_vertex_domain_t& config,
+                             const uint32_t iteration) {
+      // only the traversals reaching this vertex for the first time continue
+      uint64_t visited = vertices->current[id].visited;
+      uint64_t frontier = vertices->next[id].frontier & ~visited;
+      vertices->next[id].visited = visited | frontier;
+      vertices->next[id].frontier = frontier;
+      if (frontier != 0) {
+        set_active(vertices->active_next, id);
+      }
+    }
+
+    static inline double residual(const vertex_array_t<VertexType>* vertices,
+                                  const uint64_t id) {
+      // count of vertices still active
+      return eval_bool_array(vertices->active_next, id) ? 1 : 0;
+    }
+
+    static inline void
+    accumulatePartialSums(const vertex_array_t<VertexType>* vertices,
+                          const uint64_t id, double* partial_sums) {
+      // the frontier holds exactly the traversals reaching the vertex now
+      uint64_t frontier = vertices->next[id].frontier;
+      while (frontier != 0) {
+        partial_sums[__builtin_ctzll(frontier)] += 1.;
+        frontier &= frontier - 1;
+      }
+    }
+
+    // Closeness centrality of the i-th root within the vertices it reaches,
+    // 0 if it reaches none.
+    static inline double closeness(size_t i) {
+      return distances.sum_distances[i] > 0.
+                 ? (distances.count_reached[i] - 1) /
+                       distances.sum_distances[i]
+                 : 0.;
+    }
+
+    static inline void
+    reduceVertex(VertexType& out, const VertexType& lhs, const VertexType& rhs,
+                 const uint64_t& id_tgt, const vertex_degree_t& degree,
+                 char* active_array, const config_vertex_domain_t& config) {
+      out.visited = rhs.visited;
+      out.frontier = lhs.frontier | rhs.frontier;
+    }
+
+    static void init_vertices(vertex_array_t<VertexType>* vertices,
+                              void* args) {
+      sg_print("Init vertices\n");
+      init_args_t* init_args = (init_args_t*)args;
+      if (init_args == NULL || init_args->count_roots == 0 ||
+          init_args->count_roots > max_count_roots) {
+        sg_err("ms-bfs needs between 1 and %lu roots\n", max_count_roots);
+        util::die(1);
+      }
+
+      memset(vertices->current, 0, sizeof(VertexType) * vertices->count);
+      memset(vertices->next, 0, sizeof(VertexType) * vertices->count);
+      memset(vertices->active_current, 0x00,
+             vertices->size_active * sizeof(char));
+      memset(vertices->active_next, 0x00,
+             vertices->size_active * sizeof(char));
+
+      // the same root may be given more than once, every bit is its own BFS
+      memset(&distances, 0, sizeof(distances));
+      distances.count_roots = init_args->count_roots;
+      for (size_t i = 0; i < init_args->count_roots; ++i) {
+        uint64_t root = init_args->roots[i];
+        vertices->current[root].visited |= 1ul << i;
+        vertices->current[root].frontier |= 1ul << i;
+        set_active(vertices->active_current, root);
+        distances.roots[i] = root;
+        distances.count_reached[i] = 1;
+      }
+      sg_log("Running %lu traversals\n", init_args->count_roots);
+    }
+
+    // reset current-array for next round
+    static void reset_vertices(vertex_array_t<VertexType>* vertices,
+                               bool* switchCurrentNext) {
+      // the vertices reached in this round are one level further out
+      ++distances.level;
+      bool reached_any = false;
+      for (size_t i = 0; i < distances.count_roots; ++i) {
+        double count_reached = vertices->partial_sums[i];
+        distances.count_reached[i] += (uint64_t)count_reached;
+        distances.sum_distances[i] += distances.level * count_reached;
+        reached_any |= count_reached > 0.;
+      }
+      if (!reached_any) {
+        for (size_t i = 0; i < distances.count_roots; ++i) {
+          sg_log("Root %lu reached %lu vertices, closeness %f\n",
+                 distances.roots[i], distances.count_reached[i],
+                 closeness(i));
+        }
+      }
+
+      // the current-array collects the frontiers of the next round, apply
+      // carried over the visited masks
+      for (size_t i = 0; i < vertices->count; ++i) {
+        vertices->current[i].frontier = 0;
+      }
+      memset(vertices->active_current, 0x00,
+             vertices->size_active * sizeof(char));
+    }
+
+    static void pre_processing_per_round(vertex_array_t<VertexType>* vertices,
+                                         const config_vertex_domain_t& config,
+                                         const uint32_t iteration) {}
+
+    static inline void
+    reset_vertices_tile_processor(VertexType* tgt_vertices,
+                                  const size_t response_vertices) {
+      memset(tgt_vertices, 0, sizeof(VertexType) * response_vertices);
+    }
+  };
+
+  MSBFS::distances_t MSBFS::distances;
+
+#ifndef TARGET_ARCH_K1OM
+  constexpr const MSBFS::VertexType MSBFS::neutral_element;
+#endif
+
+  std::ostream& operator<<(std::ostream& stream, const MSBFS::VertexType& v) {
+    return stream << std::hex << v.visited << std::dec;
+  }
+}
+}
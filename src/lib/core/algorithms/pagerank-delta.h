@@ -0,0 +1,267 @@
+#pragma once
+
+#include <cmath>
+#include <unordered_map>
+#include <string.h>
+#include <core/util.h>
+#include <core/datatypes.h>
+
+#include "algorithm-common.h"
+#include "pagerank.h"
+
+namespace scalable_graphs {
+namespace core {
+  // PageRank by residual pushing: Every vertex only pushes the change of its
+  // rank it did not push yet (delta). Vertices whose delta is below EPSILON
+  // keep it back and go inactive until more arrives. Converges to the same
+  // ranks as PageRank, but only touches the tiles of active vertices under
+  // selective scheduling, which makes it suitable to restart from a previous
+  // result after the graph changed.
+  class PageRankDelta {
+  public:
+    struct VertexType {
+      float rank;
+      float delta;
+
+      VertexType& operator=(const float& from) {
+        delta = from;
+        return *this;
+      }
+
+      bool operator==(const VertexType& other) const {
+        return rank == other.rank && delta == other.delta;
+      }
+      bool operator!=(const VertexType& other) const {
+        return !(*this == other);
+      }
+
+      friend std::ostream& operator<<(std::ostream& stream,
+                                      const VertexType& v);
+    };
+
+    const static bool need_active_block = false;
+    const static bool need_active_source_block = false;
+    const static bool need_active_source_input = true;
+    const static bool need_active_target_block = false;
+    const static bool need_degrees_source_block = true;
+    const static bool need_degrees_target_block = false;
+    const static bool need_vertex_block_extension_fields = false;
+    const static bool need_buckets = false;
+    const static bool need_residual = true;
+    const static bool need_transposed_tiles = false;
+
+    const static size_t max_size_extension_fields_vertex_block = 0;
+    const static size_t count_partial_sums = 0;
+
+#ifndef TARGET_ARCH_K1OM
+    constexpr const static VertexType neutral_element = {0., 0.};
+#endif
+
+    PageRankDelta() = delete;
+    ~PageRankDelta() = delete;
+
+    static inline size_t
+    sizeExtensionFieldsVertexBlock(const tile_stats_t& tile_stats) {
+      // not needed
+      return 0;
+    }
+
+    static inline void fillExtensionFieldsVertexBlock(
+        void* extension_fields,
+        const volatile edge_block_index_t* edge_block_index,
+        const uint32_t* src_index, const uint32_t* tgt_index,
+        const vertex_array_t<VertexType>* vertex_array) {
+      // not applicable
+    }
+
+    static inline void gather(const VertexType& u, VertexType& v, uint16_t id,
+                              void* extension_fields) {
+      v.delta = u.delta + v.delta;
+    }
+
+    static inline void
+    pullGather(const VertexType& u, VertexType& v, uint16_t id_src,
+               uint16_t id_tgt, const vertex_degree_t* src_degree,
+               const vertex_degree_t* tgt_degree, char* active_array_src,
+               char* active_array_tgt, const config_edge_processor_t& config,
+               void* extension_fields) {
+      v.delta = v.delta + (u.delta / src_degree->out_degree);
+    }
+
+    static inline void pullGatherWeighted(
+        const VertexType& u, VertexType& v, const float weight, uint16_t id_src,
+        uint16_t id_tgt, const vertex_degree_t* src_degree,
+        const vertex_degree_t* tgt_degree, char* active_array_src,
+        char* active_array_tgt, const config_edge_processor_t& config,
+        void* extension_fields) {
+      // not applicable
+    }
+
+    static inline void apply(vertex_array_t<VertexType>* vertices,
+                             const uint64_t id,
+                             const config_vertex_domain_t& config,
+                             const uint32_t iteration) {
+      float received = ALPHA * vertices->next[id].delta;
+      vertices->next[id].rank = vertices->current[id].rank + received;
+      // inactive vertices did not push their delta, carry it over
+      float delta = received;
+      if (!eval_bool_array(vertices->active_current, id)) {
+        delta += vertices->current[id].delta;
+      }
+      vertices->next[id].delta = delta;
+      if (std::abs(delta) > EPSILON) {
+        set_active(vertices->active_next, id);
+      }
+    }
+
+    static inline double residual(const vertex_array_t<VertexType>* vertices,
+                                  const uint64_t id) {
+      // count of vertices still active
+      return eval_bool_array(vertices->active_next, id) ? 1 : 0;
+    }
+
+    static inline void
+    accumulatePartialSums(const vertex_array_t<VertexType>* vertices,
+                          const uint64_t id, double* partial_sums) {
+      // not applicable
+    }
+
+    static inline void
+    reduceVertex(VertexType& out, const VertexType& lhs, const VertexType& rhs,
+                 const uint64_t& id_tgt, const vertex_degree_t& degree,
+                 char* active_array, const config_vertex_domain_t& config) {
+      out.rank = rhs.rank;
+      out.delta = lhs.delta + rhs.delta;
+    }
+
+    static void init_vertices(vertex_array_t<VertexType>* vertices,
+                              void* args) {
+      sg_print("Init vertices\n");
+      memset(vertices->next, 0, sizeof(VertexType) * vertices->count);
+      memset(vertices->active_next, 0, vertices->size_active * sizeof(char));
+
+      init_args_t* init_args = (init_args_t*)args;
+      if (init_args != NULL && init_args->incremental != NULL) {
+        init_vertices_incremental(vertices, init_args->incremental);
+        return;
+      }
+
+      // the first round pushes the teleport share of every vertex
+      for (size_t i = 0; i < vertices->count; ++i) {
+        vertices->current[i].rank = 1 - ALPHA;
+        vertices->current[i].delta = 1 - ALPHA;
+      }
+      memset(vertices->active_current, (unsigned char)255,
+             vertices->size_active * sizeof(char));
+    }
+
+    // Seeds the ranks of a previous run of PageRank or PageRankDelta and turns
+    // the changed edges into residuals: A source whose out-degree changed from
+    // d to d' owes all of its current targets r * (1/d' - 1/d), which the
+    // first round pushes through the tiles. Targets of inserted edges
+    // additionally receive r/d, targets of deleted edges lose r/d, both are
+    // applied right away.
+    static void init_vertices_incremental(vertex_array_t<VertexType>* vertices,
+                                          const incremental_args_t* args) {
+      const float* previous_ranks = NULL;
+      const VertexType* previous_vertices = NULL;
+      if (args->size_previous_vertices == sizeof(float) * vertices->count) {
+        previous_ranks = (const float*)args->previous_vertices;
+      } else if (args->size_previous_vertices ==
+                 sizeof(VertexType) * vertices->count) {
+        previous_vertices = (const VertexType*)args->previous_vertices;
+      } else {
+        sg_err("Previous result of %lu bytes does not match %lu vertices\n",
+               args->size_previous_vertices, vertices->count);
+        util::die(1);
+      }
+
+      for (size_t i = 0; i < vertices->count; ++i) {
+        vertices->current[i].rank = previous_ranks != NULL
+                                        ? previous_ranks[i]
+                                        : previous_vertices[i].rank;
+        vertices->current[i].delta = 0.;
+      }
+      memset(vertices->active_current, 0,
+             vertices->size_active * sizeof(char));
+
+      std::unordered_map<uint64_t, int64_t> degree_changes;
+      for (size_t i = 0; i < args->count_insertions; ++i) {
+        ++degree_changes[args->insertions[i].src];
+      }
+      for (size_t i = 0; i < args->count_deletions; ++i) {
+        --degree_changes[args->deletions[i].src];
+      }
+
+      // old ranks, the corrections below must not see each other
+      std::unordered_map<uint64_t, float> old_shares;
+      for (const auto& change : degree_changes) {
+        uint64_t id = change.first;
+        float rank = vertices->current[id].rank;
+        int64_t new_degree = vertices->degrees[id].out_degree;
+        int64_t old_degree = new_degree - change.second;
+
+        old_shares[id] = old_degree > 0 ? rank / old_degree : 0.;
+        if (new_degree > 0 && change.second != 0) {
+          vertices->current[id].delta +=
+              old_degree > 0 ? rank * (1. - (float)new_degree / old_degree)
+                             : rank;
+        }
+      }
+
+      for (size_t i = 0; i < args->count_insertions; ++i) {
+        applyCorrection(vertices, args->insertions[i].tgt,
+                        ALPHA * old_shares[args->insertions[i].src]);
+      }
+      for (size_t i = 0; i < args->count_deletions; ++i) {
+        applyCorrection(vertices, args->deletions[i].tgt,
+                        -ALPHA * old_shares[args->deletions[i].src]);
+      }
+
+      for (size_t i = 0; i < vertices->count; ++i) {
+        if (std::abs(vertices->current[i].delta) > EPSILON) {
+          set_active(vertices->active_current, i);
+        }
+      }
+    }
+
+    static inline void applyCorrection(vertex_array_t<VertexType>* vertices,
+                                       uint64_t id, float correction) {
+      vertices->current[id].rank += correction;
+      vertices->current[id].delta += correction;
+    }
+
+    // reset current-array for next round
+    static void reset_vertices(vertex_array_t<VertexType>* vertices,
+                               bool* switchCurrentNext) {
+      sg_print("Resetting vertices for next round\n");
+      // the current-array collects the deltas of the next round, ranks and
+      // held back deltas were carried over by apply
+      for (size_t i = 0; i < vertices->count; ++i) {
+        vertices->current[i].delta = 0.;
+      }
+      memset(vertices->active_current, 0x00,
+             vertices->size_active * sizeof(char));
+    }
+
+    static void pre_processing_per_round(vertex_array_t<VertexType>* vertices,
+                                         const config_vertex_domain_t& config,
+                                         const uint32_t iteration) {}
+
+    static inline void
+    reset_vertices_tile_processor(VertexType* tgt_vertices,
+                                  const size_t response_vertices) {
+      memset(tgt_vertices, 0, sizeof(VertexType) * response_vertices);
+    }
+  };
+
+#ifndef TARGET_ARCH_K1OM
+  constexpr const PageRankDelta::VertexType PageRankDelta::neutral_element;
+#endif
+
+  std::ostream& operator<<(std::ostream& stream,
+                           const PageRankDelta::VertexType& v) {
+    return stream << v.rank;
+  }
+}
+}
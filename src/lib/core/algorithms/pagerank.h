@@ -23,8 +23,12 @@ namespace core {
     const static bool need_degrees_source_block = true;
     const static bool need_degrees_target_block = false;
     const static bool need_vertex_block_extension_fields = false;
+    const static bool need_buckets = false;
+    const static bool need_residual = true;
+    const static bool need_transposed_tiles = false;
 
     const static size_t max_size_extension_fields_vertex_block = 0;
+    const static size_t count_partial_sums = 0;
 
     constexpr static VertexType neutral_element = 0.;
 
@@ -84,6 +88,18 @@ namespace core {
       // }
     }
 
+    static inline double residual(const vertex_array_t<VertexType>* vertices,
+                                  const uint64_t id) {
+      // the change of the rank
+      return std::abs(vertices->next[id] - vertices->current[id]);
+    }
+
+    static inline void
+    accumulatePartialSums(const vertex_array_t<VertexType>* vertices,
+                          const uint64_t id, double* partial_sums) {
+      // not applicable
+    }
+
     static inline void
     reduceVertex(VertexType& out, const VertexType& lhs, const VertexType& rhs,
                  const uint64_t& id_tgt, const vertex_degree_t& degree,
@@ -20,9 +20,13 @@ namespace core {
     const static bool need_degrees_source_block = false;
     const static bool need_degrees_target_block = false;
     const static bool need_vertex_block_extension_fields = true;
+    const static bool need_buckets = false;
+    const static bool need_residual = false;
+    const static bool need_transposed_tiles = false;
 
     const static size_t max_size_extension_fields_vertex_block =
         MAX_VERTICES_PER_TILE * sizeof(VectorType);
+    const static size_t count_partial_sums = 0;
 
     constexpr static VertexType neutral_element = 0.;
 
@@ -79,6 +83,18 @@ namespace core {
       // do nothing
     }
 
+    static inline double residual(const vertex_array_t<VertexType>* vertices,
+                                  const uint64_t id) {
+      // not applicable, runs for max_iterations
+      return 0;
+    }
+
+    static inline void
+    accumulatePartialSums(const vertex_array_t<VertexType>* vertices,
+                          const uint64_t id, double* partial_sums) {
+      // not applicable
+    }
+
     static inline void
     reduceVertex(VertexType& out, const VertexType& lhs, const VertexType& rhs,
                  const uint64_t& id_tgt, const vertex_degree_t& degree,
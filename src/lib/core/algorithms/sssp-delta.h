@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cmath>
+#include <cfloat>
+#include <limits.h>
+#include <string.h>
+#include <core/util.h>
+#include <core/datatypes.h>
+
+#include "algorithm-common.h"
+
+namespace scalable_graphs {
+namespace core {
+  // Delta-stepping SSSP: distances are grouped into buckets of
+  // config.bucket_width, and only the improved vertices of the current bucket
+  // are active. Improvements beyond it are parked in the VertexDomain's
+  // buckets until every smaller bucket is settled, which saves the repeated
+  // relaxations of Bellman-Ford on wide weight ranges. With selective
+  // scheduling only the tiles of the current bucket are fetched.
+  class SSSPDelta {
+  public:
+    typedef float VertexType;
+
+    const static bool need_active_block = false;
+    const static bool need_active_source_block = false;
+    const static bool need_active_source_input = true;
+    const static bool need_active_target_block = false;
+    const static bool need_degrees_source_block = false;
+    const static bool need_degrees_target_block = false;
+    const static bool need_vertex_block_extension_fields = false;
+    const static bool need_buckets = true;
+    const static bool need_residual = true;
+    const static bool need_transposed_tiles = false;
+
+    const static size_t max_size_extension_fields_vertex_block = 0;
+    const static size_t count_partial_sums = 0;
+
+    constexpr static VertexType neutral_element = FLT_MAX;
+
+    SSSPDelta() = delete;
+    ~SSSPDelta() = delete;
+
+    static inline size_t
+    sizeExtensionFieldsVertexBlock(const tile_stats_t& tile_stats) {
+      // not needed
+      return 0;
+    }
+
+    static inline void fillExtensionFieldsVertexBlock(
+        void* extension_fields,
+        const volatile edge_block_index_t* edge_block_index,
+        const uint32_t* src_index, const uint32_t* tgt_index,
+        const vertex_array_t<VertexType>* vertex_array) {
+      // not applicable
+    }
+
+    static inline void gather(const VertexType& u, VertexType& v, uint16_t id,
+                              void* extension_fields) {
+      v = std::min(u, v);
+    }
+
+    static inline void
+    pullGather(const VertexType& u, VertexType& v, uint16_t id_src,
+               uint16_t id_tgt, const vertex_degree_t* src_degree,
+               const vertex_degree_t* tgt_degree, char* active_array_src,
+               char* active_array_tgt, const config_edge_processor_t& config,
+               void* extension_fields) {
+      // not applicable
+    }
+
+    static inline void pullGatherWeighted(
+        const VertexType& u, VertexType& v, const float weight, uint16_t id_src,
+        uint16_t id_tgt, const vertex_degree_t* src_degree,
+        const vertex_degree_t* tgt_degree, char* active_array_src,
+        char* active_array_tgt, const config_edge_processor_t& config,
+        void* extension_fields) {
+      if (u != FLT_MAX && v > u + weight) {
+        v = u + weight;
+      }
+    }
+
+    static inline uint32_t bucketOf(const VertexType& distance,
+                                    const config_vertex_domain_t& config) {
+      // UINT32_MAX marks "nothing pending" in advanceBucket
+      double bucket = std::floor(distance / config.bucket_width);
+      return bucket < UINT32_MAX - 1 ? (uint32_t)bucket : UINT32_MAX - 1;
+    }
+
+    static inline void apply(vertex_array_t<VertexType>* vertices,
+                             const uint64_t id,
+                             const config_vertex_domain_t& config,
+                             const uint32_t iteration) {
+      // only vertices improved in this round, the rest keeps its state
+      if (!eval_bool_array(vertices->active_next, id)) {
+        return;
+      }
+      vertex_buckets_t* buckets = vertices->buckets;
+      uint32_t bucket = bucketOf(vertices->next[id], config);
+      if (bucket > buckets->current) {
+        set_inactive(vertices->active_next, id);
+        set_active(buckets->pending, id);
+        buckets->bucket[id] = bucket;
+      } else {
+        // a parked vertex may fall back into the current bucket
+        set_inactive(buckets->pending, id);
+      }
+    }
+
+    static inline double residual(const vertex_array_t<VertexType>* vertices,
+                                  const uint64_t id) {
+      // count of vertices still active
+      return eval_bool_array(vertices->active_next, id) ? 1 : 0;
+    }
+
+    static inline void
+    accumulatePartialSums(const vertex_array_t<VertexType>* vertices,
+                          const uint64_t id, double* partial_sums) {
+      // not applicable
+    }
+
+    static inline void
+    reduceVertex(VertexType& out, const VertexType& lhs, const VertexType& rhs,
+                 const uint64_t& id_tgt, const vertex_degree_t& degree,
+                 char* active_array, const config_vertex_domain_t& config) {
+      if (lhs < out) {
+        out = lhs;
+        set_active(active_array, id_tgt);
+      }
+    }
+
+    static void init_vertices(vertex_array_t<VertexType>* vertices,
+                              void* args) {
+      sg_print("Init vertices\n");
+      for (int i = 0; i < vertices->count; ++i) {
+        vertices->current[i] = FLT_MAX;
+        vertices->next[i] = FLT_MAX;
+      }
+      // Nothing active or parked in the beginning.
+      memset(vertices->active_current, 0x00,
+             vertices->size_active * sizeof(char));
+      memset(vertices->buckets->pending, 0x00,
+             vertices->size_active * sizeof(char));
+      vertices->buckets->current = 0;
+
+      // the roots are in bucket 0, vertex 100 if none given:
+      init_args_t* init_args = (init_args_t*)args;
+      if (init_args == NULL || init_args->count_roots == 0) {
+        set_root(vertices, 100);
+        return;
+      }
+      for (size_t i = 0; i < init_args->count_roots; ++i) {
+        set_root(vertices, init_args->roots[i]);
+      }
+    }
+
+    static inline void set_root(vertex_array_t<VertexType>* vertices,
+                                uint64_t root) {
+      set_active(vertices->active_current, root);
+      vertices->current[root] = 0.;
+      vertices->next[root] = 0.;
+    }
+
+    // reset current-array for next round
+    static void reset_vertices(vertex_array_t<VertexType>* vertices,
+                               bool* switchCurrentNext) {
+      // the current-array becomes the next-array, reduce into the latest
+      // distances instead of the ones from two rounds ago
+      memcpy(vertices->current, vertices->next,
+             sizeof(VertexType) * vertices->count);
+      memset(vertices->active_current, 0x00,
+             vertices->size_active * sizeof(char));
+    }
+
+    static void pre_processing_per_round(vertex_array_t<VertexType>* vertices,
+                                         const config_vertex_domain_t& config,
+                                         const uint32_t iteration) {}
+
+    static inline void
+    reset_vertices_tile_processor(VertexType* tgt_vertices,
+                                  const size_t response_vertices) {
+      for (int i = 0; i < response_vertices; ++i) {
+        tgt_vertices[i] = FLT_MAX;
+      }
+    }
+  };
+}
+}
@@ -22,8 +22,12 @@ namespace core {
     const static bool need_degrees_source_block = false;
     const static bool need_degrees_target_block = false;
     const static bool need_vertex_block_extension_fields = false;
+    const static bool need_buckets = false;
+    const static bool need_residual = true;
+    const static bool need_transposed_tiles = false;
 
     const static size_t max_size_extension_fields_vertex_block = 0;
+    const static size_t count_partial_sums = 0;
 
     constexpr static VertexType neutral_element = FLT_MAX;
 
@@ -76,6 +80,18 @@ namespace core {
       // pass, nothing to be done here
     }
 
+    static inline double residual(const vertex_array_t<VertexType>* vertices,
+                                  const uint64_t id) {
+      // count of vertices still active
+      return eval_bool_array(vertices->active_next, id) ? 1 : 0;
+    }
+
+    static inline void
+    accumulatePartialSums(const vertex_array_t<VertexType>* vertices,
+                          const uint64_t id, double* partial_sums) {
+      // not applicable
+    }
+
     static inline void
     reduceVertex(VertexType& out, const VertexType& lhs, const VertexType& rhs,
                  const uint64_t& id_tgt, const vertex_degree_t& degree,
@@ -97,17 +113,31 @@ namespace core {
       memset(vertices->active_current, 0x00,
              vertices->size_active * sizeof(char));
 
-      int start = 100;
-      set_active(vertices->active_current, start);
-      // init one vertex as the start:
-      vertices->current[start] = 0.;
-      vertices->next[start] = 0.;
+      // init the roots as the start, vertex 100 if none given:
+      init_args_t* init_args = (init_args_t*)args;
+      if (init_args == NULL || init_args->count_roots == 0) {
+        set_root(vertices, 100);
+        return;
+      }
+      for (size_t i = 0; i < init_args->count_roots; ++i) {
+        set_root(vertices, init_args->roots[i]);
+      }
+    }
+
+    static inline void set_root(vertex_array_t<VertexType>* vertices,
+                                uint64_t root) {
+      set_active(vertices->active_current, root);
+      vertices->current[root] = 0.;
+      vertices->next[root] = 0.;
     }
 
     // reset current-array for next round
     static void reset_vertices(vertex_array_t<VertexType>* vertices,
                                bool* switchCurrentNext) {
-      // activate all vertices for next round
+      // the current-array becomes the next-array, reduce into the latest
+      // distances instead of the ones from two rounds ago
+      memcpy(vertices->current, vertices->next,
+             sizeof(VertexType) * vertices->count);
       memset(vertices->active_current, 0x00,
              vertices->size_active * sizeof(char));
     }
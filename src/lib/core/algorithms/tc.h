@@ -10,6 +10,8 @@
 
 namespace scalable_graphs {
 namespace core {
+  // Randomized estimate of the triangles per vertex, for the exact total see
+  // TriangleCounter (post-grc-triangles).
   class TC {
   public:
     struct VertexType {
@@ -43,9 +45,13 @@ namespace core {
     const static bool need_degrees_source_block = true;
     const static bool need_degrees_target_block = true;
     const static bool need_vertex_block_extension_fields = true;
+    const static bool need_buckets = false;
+    const static bool need_residual = false;
+    const static bool need_transposed_tiles = false;
 
     const static size_t max_size_extension_fields_vertex_block =
         sizeof(global_information_t);
+    const static size_t count_partial_sums = 0;
 
 #ifndef TARGET_ARCH_K1OM
     constexpr const static VertexType neutral_element = {INT_MAX, 0, 0., 0.};
@@ -144,6 +150,18 @@ namespace core {
       }
     }
 
+    static inline double residual(const vertex_array_t<VertexType>* vertices,
+                                  const uint64_t id) {
+      // not applicable, runs for max_iterations
+      return 0;
+    }
+
+    static inline void
+    accumulatePartialSums(const vertex_array_t<VertexType>* vertices,
+                          const uint64_t id, double* partial_sums) {
+      // not applicable
+    }
+
     static inline void
     reduceVertex(VertexType& out, const VertexType& lhs, const VertexType& rhs,
                  const uint64_t& id_tgt, const vertex_degree_t& degree,
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <core/util.h>
+#include <core/datatypes.h>
+
+#include "cc.h"
+
+namespace scalable_graphs {
+namespace core {
+  // Weakly connected components of a directed graph: the labels of CC are
+  // propagated along the forward and the transposed tiles in every round, so
+  // the input does not have to be symmetrized before tiling. The transposed
+  // tiles are written by post-grc-transposer.
+  class WCC : public CC {
+  public:
+    const static bool need_transposed_tiles = true;
+
+    WCC() = delete;
+    ~WCC() = delete;
+
+    static void init_vertices(vertex_array_t<VertexType>* vertices,
+                              void* args) {
+      CC::init_vertices(vertices, args);
+      vertices->direction = TileDirection::TD_Both;
+    }
+  };
+}
+}
@@ -0,0 +1,254 @@
+#include <core/csr-graph.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <util/util.h>
+#include <core/tile-container.h>
+#include <core/util.h>
+
+namespace scalable_graphs {
+namespace core {
+  CsrGraph::CsrGraph() : count_vertices_(0) {}
+
+  void CsrGraph::build(uint64_t count_vertices,
+                       const std::vector<edge_t>& edges,
+                       const std::vector<float>& weights, bool with_rows) {
+    if (count_vertices > UINT32_MAX) {
+      sg_err("The CSR graph supports up to %u vertices, got %lu\n", UINT32_MAX,
+             count_vertices);
+      util::die(1);
+    }
+    count_vertices_ = count_vertices;
+    bool is_weighted = !weights.empty();
+
+    // Bucket the edges by source first, then transpose the rows into the
+    // columns, which leaves the sources of every column in ascending order.
+    rows_.offsets.assign(count_vertices + 1, 0);
+    for (const edge_t& edge : edges) {
+      if (edge.src >= count_vertices || edge.tgt >= count_vertices) {
+        sg_err("Edge (%lu, %lu) is out of range of %lu vertices\n", edge.src,
+               edge.tgt, count_vertices);
+        util::die(1);
+      }
+      ++rows_.offsets[edge.src + 1];
+    }
+    for (uint64_t i = 0; i < count_vertices; ++i) {
+      rows_.offsets[i + 1] += rows_.offsets[i];
+    }
+    rows_.neighbors.resize(edges.size());
+    rows_.weights.resize(is_weighted ? edges.size() : 0);
+    std::vector<uint64_t> cursors(rows_.offsets.begin(),
+                                  rows_.offsets.end() - 1);
+    for (size_t i = 0; i < edges.size(); ++i) {
+      uint64_t position = cursors[edges[i].src]++;
+      rows_.neighbors[position] = (uint32_t)edges[i].tgt;
+      if (is_weighted) {
+        rows_.weights[position] = weights[i];
+      }
+    }
+
+    columns_.offsets.assign(count_vertices + 1, 0);
+    for (uint32_t tgt : rows_.neighbors) {
+      ++columns_.offsets[tgt + 1];
+    }
+    for (uint64_t i = 0; i < count_vertices; ++i) {
+      columns_.offsets[i + 1] += columns_.offsets[i];
+    }
+    columns_.neighbors.resize(edges.size());
+    columns_.weights.resize(is_weighted ? edges.size() : 0);
+    cursors.assign(columns_.offsets.begin(), columns_.offsets.end() - 1);
+    for (uint64_t src = 0; src < count_vertices; ++src) {
+      for (uint64_t i = rows_.offsets[src]; i < rows_.offsets[src + 1]; ++i) {
+        uint64_t position = cursors[rows_.neighbors[i]]++;
+        columns_.neighbors[position] = (uint32_t)src;
+        if (is_weighted) {
+          columns_.weights[position] = rows_.weights[i];
+        }
+      }
+    }
+
+    degrees_.resize(count_vertices);
+    for (uint64_t i = 0; i < count_vertices; ++i) {
+      degrees_[i].in_degree = columns_.offsets[i + 1] - columns_.offsets[i];
+      degrees_[i].out_degree = rows_.offsets[i + 1] - rows_.offsets[i];
+    }
+
+    if (!with_rows) {
+      rows_ = Adjacency();
+    }
+  }
+
+  static int openFile(const std::string& file_name) {
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd == -1) {
+      sg_err("Unable to open file %s: %s\n", file_name.c_str(),
+             strerror(errno));
+      util::die(1);
+    }
+    return fd;
+  }
+
+  // Appends the edges of one tile in global ids, except the ones set in
+  // tombstones if not NULL.
+  static void appendTileEdges(const tile_stats_t& tile_stats,
+                              const edge_block_index_t* index,
+                              const edge_block_t* block, const char* tombstones,
+                              bool is_index_32_bits, bool is_weighted,
+                              std::vector<edge_t>* edges,
+                              std::vector<float>* weights) {
+    const uint32_t* src_index =
+        get_array(const uint32_t*, index, index->offset_src_index);
+    const uint32_t* tgt_index =
+        get_array(const uint32_t*, index, index->offset_tgt_index);
+    const char* src_upper_bits =
+        get_array(const char*, index, index->offset_src_index_bit_extension);
+    const char* tgt_upper_bits =
+        get_array(const char*, index, index->offset_tgt_index_bit_extension);
+    const float* weight_block =
+        is_weighted ? get_array(const float*, block, block->offset_weight)
+                    : NULL;
+    auto add = [&](uint32_t edge_id, local_vertex_id_t src,
+                   local_vertex_id_t tgt) {
+      if (tombstones != NULL && eval_bool_array(tombstones, edge_id)) {
+        return;
+      }
+      edge_t edge = {src_index[src], tgt_index[tgt]};
+      if (!is_index_32_bits) {
+        edge.src |= (uint64_t)eval_bool_array(src_upper_bits, src) << 32;
+        edge.tgt |= (uint64_t)eval_bool_array(tgt_upper_bits, tgt) << 32;
+      }
+      edges->push_back(edge);
+      if (is_weighted) {
+        weights->push_back(weight_block[edge_id]);
+      }
+    };
+
+    uint32_t count_edges = tile_stats.count_edges;
+    const local_vertex_id_t* src_block =
+        get_array(const local_vertex_id_t*, block, block->offset_src);
+    if (tile_stats.encoding == TileEncoding::TE_Bitmap) {
+      for_each_bitmap_edge(
+          get_array(const uint64_t*, block, block->offset_src),
+          get_array(const uint32_t*, block, block->offset_tgt),
+          tile_stats.count_vertex_tgt,
+          BITMAP_WORDS_PER_ROW(tile_stats.count_vertex_src), 0, count_edges,
+          add);
+    } else if (tile_stats.encoding == TileEncoding::TE_RLE) {
+      const vertex_count_t* tgt_block_rle =
+          get_array(const vertex_count_t*, block, block->offset_tgt);
+      uint32_t edge_id = 0;
+      for (size_t k = 0; edge_id < count_edges; ++k) {
+        // a count of 0 wraps around, all 65536 sources
+        size_t count = tgt_block_rle[k].count == 0 ? MAX_VERTICES_PER_TILE
+                                                   : tgt_block_rle[k].count;
+        for (size_t l = 0; l < count; ++l, ++edge_id) {
+          add(edge_id, src_block[edge_id], tgt_block_rle[k].id);
+        }
+      }
+    } else {
+      const local_vertex_id_t* tgt_block =
+          get_array(const local_vertex_id_t*, block, block->offset_tgt);
+      for (uint32_t edge_id = 0; edge_id < count_edges; ++edge_id) {
+        add(edge_id, src_block[edge_id], tgt_block[edge_id]);
+      }
+    }
+  }
+
+  // Appends the edges of all tiles of a container.
+  static void appendContainerEdges(const TileContainer& container,
+                                   const TileTombstones* tombstones,
+                                   const scenario_stats_t& stats,
+                                   std::vector<edge_t>* edges,
+                                   std::vector<float>* weights) {
+    for (size_t j = 0; j < container.countTiles(); ++j) {
+      const tile_container_entry_t& entry = container.entry(j);
+      edge_block_index_t* index = (edge_block_index_t*)malloc(entry.size_index);
+      container.readEdgeBlockIndex(j, index);
+      edge_block_t* block = (edge_block_t*)malloc(entry.size_edge_block);
+      container.readEdgeBlock(j, block);
+      appendTileEdges(entry.stats, index, block,
+                      tombstones != NULL ? tombstones->getMask(j) : NULL,
+                      stats.is_index_32_bits, stats.is_weighted_graph, edges,
+                      weights);
+      free(block);
+      free(index);
+    }
+  }
+
+  void CsrGraph::loadTiles(const config_t& config,
+                           const scenario_stats_t& stats, bool with_rows) {
+    std::vector<edge_t> edges;
+    std::vector<float> weights;
+    for (int i = 0; i < config.count_edge_processors; ++i) {
+      std::string container_file_name = getTileContainerFileName(config, i);
+      if (TileContainer::exists(container_file_name)) {
+        TileContainer container;
+        container.open(container_file_name);
+
+        // deleted edges of the base tiles, see EdgeProcessor::init()
+        TileTombstones tombstones;
+        std::string tombstones_file_name = getTileTombstonesFileName(config, i);
+        bool has_tombstones = TileTombstones::exists(tombstones_file_name);
+        if (has_tombstones) {
+          std::vector<tile_stats_t> tile_stats(container.countTiles());
+          container.copyTileStats(tile_stats.data());
+          tombstones.open(tombstones_file_name, tile_stats.data(),
+                          tile_stats.size());
+        }
+        appendContainerEdges(container, has_tombstones ? &tombstones : NULL,
+                             stats, &edges, &weights);
+
+        // delta tiles written by post-grc-delta
+        std::string delta_container_file_name =
+            getDeltaTileContainerFileName(config, i);
+        if (TileContainer::exists(delta_container_file_name)) {
+          TileContainer delta_container;
+          delta_container.open(delta_container_file_name);
+          appendContainerEdges(delta_container, NULL, stats, &edges, &weights);
+        }
+        continue;
+      }
+
+      // the blocks of the tiler are padded to PAGE_SIZE
+      size_t count_tiles = countTilesPerMic(config, i);
+      std::vector<tile_stats_t> tile_stats(count_tiles);
+      util::readDataFromFile(getGlobalTileStatsFileName(config, i),
+                             sizeof(tile_stats_t) * count_tiles,
+                             tile_stats.data());
+      int tiles_fd = openFile(getEdgeTileFileName(config, i));
+      int meta_fd = openFile(getEdgeTileIndexFileName(config, i));
+      size_t tile_offset = 0;
+      size_t meta_offset = 0;
+      for (size_t j = 0; j < count_tiles; ++j) {
+        size_t size_edge_block =
+            getSizeEdgeBlock(tile_stats[j], stats.is_weighted_graph);
+        edge_block_t* block = (edge_block_t*)malloc(size_edge_block);
+        util::readFileOffset(tiles_fd, block, size_edge_block, tile_offset);
+        tile_offset += int_ceil(size_edge_block, PAGE_SIZE);
+
+        size_t size_index =
+            getSizeEdgeBlockIndex(tile_stats[j], stats.is_index_32_bits);
+        edge_block_index_t* index = (edge_block_index_t*)malloc(size_index);
+        util::readFileOffset(meta_fd, index, size_index, meta_offset);
+        meta_offset += int_ceil(size_index, PAGE_SIZE);
+
+        appendTileEdges(tile_stats[j], index, block, NULL,
+                        stats.is_index_32_bits, stats.is_weighted_graph,
+                        &edges, &weights);
+        free(block);
+        free(index);
+      }
+      close(tiles_fd);
+      close(meta_fd);
+    }
+
+    sg_log("Loaded %lu edges of %lu vertices\n", edges.size(),
+           stats.count_vertices);
+    build(stats.count_vertices, edges, weights, with_rows);
+  }
+}
+}
@@ -7,18 +7,29 @@
 #include <pthread.h>
 #include <getopt.h>
 #include <errno.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 
 #include <util/runnable.h>
 #include <ring_buffer.h>
 #include <core/datatypes.h>
 #include <core/util.h>
-#include <core/vertex-domain.h>
-#include <core/edge-processor.h>
+#include <core/execute-engine.h>
 
 #include "algorithms/pagerank.h"
+#include "algorithms/pagerank-delta.h"
 #include "algorithms/bfs.h"
+#include "algorithms/ms-bfs.h"
 #include "algorithms/cc.h"
 #include "algorithms/sssp.h"
+#include "algorithms/sssp-delta.h"
+#include "algorithms/embedding.h"
+#include "algorithms/label-propagation.h"
+#include "algorithms/kcore.h"
+#include "algorithms/wcc.h"
 #include "algorithms/spmv.h"
 #include "algorithms/tc.h"
 #include "algorithms/bp.h"
@@ -26,9 +37,11 @@
 
 namespace core = scalable_graphs::core;
 namespace util = scalable_graphs::util;
+using core::executeEngine;
 
 static int parseOption(int argc, char* argv[], config_vertex_domain_t& config_vertex,
-                       config_edge_processor_t& config_edge) {
+                       config_edge_processor_t& config_edge,
+                       std::string& server) {
   static struct option options[] = {
       {"algorithm",                    required_argument, 0, 'a'},
       {"max-iterations",               required_argument, 0, 'b'},
@@ -63,6 +76,19 @@ static int parseOption(int argc, char* argv[], config_vertex_domain_t& config_ve
       {"tile-processor-input-mode",    required_argument, 0, 'E'},
       {"tile-processor-output-mode",   required_argument, 0, 'F'},
       {"count-followers",              required_argument, 0, 'G'},
+      {"incremental-input",            required_argument, 0, 'H'},
+      {"incremental-insertions",       required_argument, 0, 'I'},
+      {"incremental-deletions",        required_argument, 0, 'J'},
+      {"roots",                        required_argument, 0, 'K'},
+      {"roots-file",                   required_argument, 0, 'L'},
+      {"server",                       required_argument, 0, 'M'},
+      {"bucket-width",                 required_argument, 0, 'N'},
+      {"tolerance",                    required_argument, 0, 'O'},
+      {"enable-perf-counters",         required_argument, 0, 'P'},
+      {"path-metrics",                 required_argument, 0, 'Q'},
+      {"metrics-address",              required_argument, 0, 'R'},
+      {"verify-tiles",                 required_argument, 0, 'S'},
+      {"features-file",                required_argument, 0, 'T'},
       {0, 0,                                              0, 0},
   };
   int arg_cnt;
@@ -71,7 +97,7 @@ static int parseOption(int argc, char* argv[], config_vertex_domain_t& config_ve
     int c, idx = 0;
     c = getopt_long(
         argc, argv,
-        "a:b:c:d:e:f:g:h:i:j:k:l:m:n:o:p:q:r:s:t:u:v:w:x:y:z:A:B:C:D:E:F:G:",
+        "a:b:c:d:e:f:g:h:i:j:k:l:m:n:o:p:q:r:s:t:u:v:w:x:y:z:A:B:C:D:E:F:G:H:I:J:K:L:M:N:O:P:Q:R:S:T:",
         options, &idx);
     if (c == -1) {
       break;
@@ -284,6 +310,64 @@ static int parseOption(int argc, char* argv[], config_vertex_domain_t& config_ve
       case 'G':
         config_edge.count_followers = std::stoi(std::string(optarg));
         break;
+      case 'H':
+        config_vertex.path_to_incremental_input = std::string(optarg);
+        --arg_cnt;
+        break;
+      case 'I':
+        config_vertex.path_to_incremental_insertions = std::string(optarg);
+        --arg_cnt;
+        break;
+      case 'J':
+        config_vertex.path_to_incremental_deletions = std::string(optarg);
+        --arg_cnt;
+        break;
+      case 'K':
+        core::parseVertexList(std::string(optarg), &config_vertex.roots);
+        --arg_cnt;
+        break;
+      case 'L':
+        core::readVertexListFile(std::string(optarg), &config_vertex.roots);
+        --arg_cnt;
+        break;
+      case 'M':
+        server = std::string(optarg);
+        --arg_cnt;
+        break;
+      case 'N':
+        config_vertex.bucket_width = std::stof(std::string(optarg));
+        --arg_cnt;
+        break;
+      case 'O':
+        config_vertex.convergence_tolerance = std::stod(std::string(optarg));
+        --arg_cnt;
+        break;
+      case 'P':
+        config_vertex.enable_perf_counters = (
+            std::stoi(std::string(optarg)) == 1);
+        config_edge.enable_perf_counters = (
+            std::stoi(std::string(optarg)) == 1);
+        --arg_cnt;
+        break;
+      case 'Q':
+        config_vertex.path_to_metrics = util::prepareDirPath(std::string(optarg));
+        config_edge.path_to_metrics = util::prepareDirPath(std::string(optarg));
+        --arg_cnt;
+        break;
+      case 'R':
+        config_vertex.metrics_address = std::string(optarg);
+        config_edge.metrics_address = std::string(optarg);
+        --arg_cnt;
+        break;
+      case 'S':
+        config_vertex.verify_tiles = (std::stoi(std::string(optarg)) == 1);
+        config_edge.verify_tiles = (std::stoi(std::string(optarg)) == 1);
+        --arg_cnt;
+        break;
+      case 'T':
+        core::readFeatureFile(std::string(optarg), &config_vertex.features);
+        --arg_cnt;
+        break;
       default:
         return -EINVAL;
     }
@@ -344,123 +428,314 @@ static void usage(FILE* out) {
   fprintf(out, "  --local-reducer-mode  = the mode for the local reducer to "
       "run in, options are: GlobalReducer, Locking, "
       "and Atomic.\n");
-}
-
-template<class APP, typename TVertexType, typename TVertexIdType, bool is_weighted>
-static void executeEngine(config_vertex_domain_t& config_vertex,
-                          const config_edge_processor_t& config_edge) {
-  // Start up all edge engines, then start vertex engine.
-  auto edge_processors = new
-      core::EdgeProcessor <APP, TVertexType, is_weighted>*
-      [config_vertex.count_edge_processors];
-
-  // Start all edge processors.
-  for (int i = 0; i < config_vertex.count_edge_processors; ++i) {
-    config_edge_processor_t local_config_edge = config_edge;
-    local_config_edge.mic_index = i;
-    local_config_edge.paths_to_meta = {config_edge.paths_to_meta[i]};
-    local_config_edge.paths_to_tile = {config_edge.paths_to_tile[i]};
-    auto edge_processor = new core::EdgeProcessor<APP, TVertexType, is_weighted>(
-        local_config_edge);
-    edge_processors[i] = edge_processor;
-
-    edge_processor->init();
-
-    ringbuffer_config_t ringbuffer_config = edge_processor->getRingbufferConfig();
-    config_vertex.ringbuffer_configs[i] = ringbuffer_config;
-
-    sg_log("Started edge processor %d.\n", i);
-  }
-  sg_log2("Started all edge processors.\n");
-
-  core::VertexDomain <APP, TVertexType, TVertexIdType> vertex_domain(
-      config_vertex);
-  vertex_domain.init();
-  sg_log2("Init done\n");
-  vertex_domain.start();
-  sg_log2("Start done\n");
-
-  for (int i = 0; i < config_vertex.count_edge_processors; ++i) {
-    edge_processors[i]->initActiveTiles();
-    edge_processors[i]->start();
-  }
-
-  sg_log2("Started vertex processor.\n");
-
-  // Join all edge processors.
-  for (int i = 0; i < config_vertex.count_edge_processors; ++i) {
-    edge_processors[i]->join();
-  }
-  sg_log2("Joined all edge processors.\n");
-
-  vertex_domain.join();
-
-  sg_log2("Joined vertex processor.\n");
+  fprintf(out, "  --incremental-input  = (optional) vertex array of a previous "
+      "run to restart from, pagerank-delta and cc only\n");
+  fprintf(out, "  --incremental-insertions  = (optional) edges inserted since "
+      "the previous run\n");
+  fprintf(out, "  --incremental-deletions  = (optional) edges deleted since "
+      "the previous run\n");
+  fprintf(out, "  --roots  = (optional) comma-separated start vertices, bfs, "
+      "sssp, sssp-delta and ms-bfs only, ms-bfs takes up to "
+      "64\n");
+  fprintf(out, "  --roots-file  = (optional) file of whitespace-separated "
+      "start vertices, same as --roots\n");
+  fprintf(out, "  --bucket-width  = (optional) width of the distance buckets "
+      "of sssp-delta, 1 by default\n");
+  fprintf(out, "  --tolerance  = (optional) end the run once the residual of "
+      "the algorithm is at most this, 0 by default\n");
+  fprintf(out, "  --enable-perf-counters  = (optional) count cycles, "
+      "instructions, cache and TLB misses per component, needs "
+      "--enable-perf-event-collection\n");
+  fprintf(out, "  --path-metrics  = (optional) write one JSON record of "
+      "metrics per round and engine to this directory\n");
+  fprintf(out, "  --metrics-address  = (optional) serve live metrics in the "
+      "Prometheus text format on this port of 127.0.0.1 or unix socket "
+      "path\n");
+  fprintf(out, "  --verify-tiles  = (optional) check the checksums of all "
+      "tiles once when the in-memory mode maps them\n");
+  fprintf(out, "  --features-file  = (optional) file of whitespace-separated "
+      "features, one per vertex, kmc only, derived from the ids by "
+      "default\n");
+  fprintf(out, "  --server  = (optional) keep the graph loaded and run the "
+      "queries read from stdin (-) or a unix socket at this path, one per "
+      "line: <algorithm> [roots=<id>,...] [max-iterations=<n>] "
+      "[output=<file>], quit stops the server\n");
 }
 
 template<typename TVertexIdType>
-static void runUnweighted(config_vertex_domain_t& config_vertex,
-                          const config_edge_processor_t& config_edge) {
+static bool runUnweighted(config_vertex_domain_t& config_vertex,
+                          const config_edge_processor_t& config_edge,
+                          size_t* count_iterations) {
   if (config_vertex.algorithm == "pagerank") {
-    executeEngine<core::PageRank, core::PageRank::VertexType, TVertexIdType, false>(
-        config_vertex, config_edge);
+    *count_iterations = executeEngine<core::PageRank, core::PageRank::VertexType,
+                                      TVertexIdType, false>(config_vertex,
+                                                            config_edge);
+  } else if (config_vertex.algorithm == "pagerank-delta") {
+    *count_iterations =
+        executeEngine<core::PageRankDelta, core::PageRankDelta::VertexType,
+                      TVertexIdType, false>(config_vertex, config_edge);
   } else if (config_vertex.algorithm == "bfs") {
-    executeEngine<core::BFS, core::BFS::VertexType, TVertexIdType, false>(
-        config_vertex,
-        config_edge);
+    *count_iterations =
+        executeEngine<core::BFS, core::BFS::VertexType, TVertexIdType, false>(
+            config_vertex,
+            config_edge);
+  } else if (config_vertex.algorithm == "ms-bfs") {
+    *count_iterations =
+        executeEngine<core::MSBFS, core::MSBFS::VertexType, TVertexIdType,
+                      false>(config_vertex, config_edge);
   } else if (config_vertex.algorithm == "cc") {
-    executeEngine<core::CC, core::CC::VertexType, TVertexIdType, false>(
-        config_vertex,
-        config_edge);
+    *count_iterations =
+        executeEngine<core::CC, core::CC::VertexType, TVertexIdType, false>(
+            config_vertex,
+            config_edge);
   } else if (config_vertex.algorithm == "spmv") {
-    executeEngine<core::SPMV, core::SPMV::VertexType, TVertexIdType, false>(
-        config_vertex,
-        config_edge);
+    *count_iterations =
+        executeEngine<core::SPMV, core::SPMV::VertexType, TVertexIdType, false>(
+            config_vertex,
+            config_edge);
   } else if (config_vertex.algorithm == "tc") {
-    executeEngine<core::TC, core::TC::VertexType, TVertexIdType, false>(
-        config_vertex,
-        config_edge);
+    *count_iterations =
+        executeEngine<core::TC, core::TC::VertexType, TVertexIdType, false>(
+            config_vertex,
+            config_edge);
+  } else if (config_vertex.algorithm == "embedding") {
+    typedef core::Embedding<EMBEDDING_DIMENSIONS> Embedding;
+    *count_iterations =
+        executeEngine<Embedding, Embedding::VertexType, TVertexIdType, false>(
+            config_vertex, config_edge);
+  } else if (config_vertex.algorithm == "label-propagation") {
+    typedef core::LabelPropagation<LABEL_PROPAGATION_SKETCH_SIZE>
+        LabelPropagation;
+    *count_iterations =
+        executeEngine<LabelPropagation, LabelPropagation::VertexType,
+                      TVertexIdType, false>(config_vertex, config_edge);
+  } else if (config_vertex.algorithm == "kcore") {
+    *count_iterations =
+        executeEngine<core::KCore, core::KCore::VertexType, TVertexIdType,
+                      false>(config_vertex, config_edge);
+  } else if (config_vertex.algorithm == "wcc") {
+    *count_iterations =
+        executeEngine<core::WCC, core::WCC::VertexType, TVertexIdType, false>(
+            config_vertex, config_edge);
+  } else if (config_vertex.algorithm == "kmc") {
+    typedef core::KMC<KMC_CLUSTERS> KMC;
+    *count_iterations =
+        executeEngine<KMC, KMC::VertexType, TVertexIdType, false>(
+            config_vertex, config_edge);
   } else {
-    sg_log2("No algorithm selected, will exit now!\n");
+    return false;
   }
+  return true;
 }
 
 template<typename TVertexIdType>
-static void runWeighted(config_vertex_domain_t& config_vertex,
-                        const config_edge_processor_t& config_edge) {
+static bool runWeighted(config_vertex_domain_t& config_vertex,
+                        const config_edge_processor_t& config_edge,
+                        size_t* count_iterations) {
   if (config_vertex.algorithm == "sssp") {
-    executeEngine<core::SSSP, core::SSSP::VertexType, TVertexIdType, true>(
-        config_vertex,
-        config_edge);
+    *count_iterations =
+        executeEngine<core::SSSP, core::SSSP::VertexType, TVertexIdType, true>(
+            config_vertex,
+            config_edge);
+  } else if (config_vertex.algorithm == "sssp-delta") {
+    *count_iterations =
+        executeEngine<core::SSSPDelta, core::SSSPDelta::VertexType,
+                      TVertexIdType, true>(config_vertex, config_edge);
   } else if (config_vertex.algorithm == "bp") {
-    executeEngine<core::BP, core::BP::VertexType, TVertexIdType, true>(
-        config_vertex,
-        config_edge);
+    *count_iterations =
+        executeEngine<core::BP, core::BP::VertexType, TVertexIdType, true>(
+            config_vertex,
+            config_edge);
+  } else if (config_vertex.algorithm == "embedding") {
+    typedef core::Embedding<EMBEDDING_DIMENSIONS> Embedding;
+    *count_iterations =
+        executeEngine<Embedding, Embedding::VertexType, TVertexIdType, true>(
+            config_vertex, config_edge);
+  } else if (config_vertex.algorithm == "kmc") {
+    typedef core::KMC<KMC_CLUSTERS> KMC;
+    *count_iterations =
+        executeEngine<KMC, KMC::VertexType, TVertexIdType, true>(
+            config_vertex, config_edge);
   } else {
-    sg_log2("No algorithm selected, will exit now!\n");
+    return false;
   }
+  return true;
 }
 
 template<typename TVertexIdType>
-static void run(config_vertex_domain_t& config_vertex,
-                const config_edge_processor_t& config_edge) {
+static bool run(config_vertex_domain_t& config_vertex,
+                const config_edge_processor_t& config_edge,
+                size_t* count_iterations) {
   if (config_vertex.is_graph_weighted) {
-    runWeighted<TVertexIdType>(config_vertex, config_edge);
+    return runWeighted<TVertexIdType>(config_vertex, config_edge,
+                                      count_iterations);
+  } else {
+    return runUnweighted<TVertexIdType>(config_vertex, config_edge,
+                                        count_iterations);
+  }
+}
+
+// Runs one query of the server on a copy of the configuration the server was
+// started with and answers with a single line, "ok ..." or "error ...".
+// Everything but the vertex arrays of the engines stays loaded in between.
+static void runQuery(const std::string& line,
+                     const config_vertex_domain_t& server_config_vertex,
+                     const config_edge_processor_t& server_config_edge,
+                     FILE* out) {
+  query_t query;
+  std::string error;
+  if (!core::parseQuery(line, &query, &error)) {
+    fprintf(out, "error %s\n", error.c_str());
+    return;
+  }
+  // the engines die on invalid roots, check them up front
+  for (uint64_t root : query.roots) {
+    if (root >= server_config_vertex.count_vertices) {
+      fprintf(out, "error root %lu out of range of %lu vertices\n", root,
+              server_config_vertex.count_vertices);
+      return;
+    }
+  }
+  if (query.algorithm == "ms-bfs" &&
+      (query.roots.empty() ||
+       query.roots.size() > core::MSBFS::max_count_roots)) {
+    fprintf(out, "error ms-bfs needs between 1 and %lu roots\n",
+            core::MSBFS::max_count_roots);
+    return;
+  }
+
+  config_vertex_domain_t config_vertex = server_config_vertex;
+  config_edge_processor_t config_edge = server_config_edge;
+  config_vertex.algorithm = query.algorithm;
+  config_edge.algorithm = query.algorithm;
+  config_vertex.roots = query.roots;
+  config_vertex.path_to_result = query.path_to_output;
+  if (query.max_iterations > 0) {
+    config_vertex.max_iterations = query.max_iterations;
+    config_edge.max_iterations = query.max_iterations;
+  }
+
+  struct timeval start_tv, end_tv, result_time;
+  gettimeofday(&start_tv, NULL);
+  size_t count_iterations = 0;
+  bool found;
+  if (config_vertex.is_index_32_bits) {
+    found = run<uint32_t>(config_vertex, config_edge, &count_iterations);
   } else {
-    runUnweighted<TVertexIdType>(config_vertex, config_edge);
+    found = run<uint64_t>(config_vertex, config_edge, &count_iterations);
+  }
+  gettimeofday(&end_tv, NULL);
+  timersub(&end_tv, &start_tv, &result_time);
+
+  if (!found) {
+    fprintf(out, "error no %s algorithm %s\n",
+            config_vertex.is_graph_weighted ? "weighted" : "unweighted",
+            query.algorithm.c_str());
+    return;
+  }
+  fprintf(out, "ok %s iterations=%lu time=%.3fmsec\n", query.algorithm.c_str(),
+          count_iterations,
+          result_time.tv_sec * 1000 + result_time.tv_usec / 1000.0);
+}
+
+// Answers the queries of one client until it disconnects, returns true if the
+// client asked the server to quit.
+static bool serveQueries(FILE* in, FILE* out,
+                         const config_vertex_domain_t& config_vertex,
+                         const config_edge_processor_t& config_edge) {
+  char* buffer = NULL;
+  size_t size_buffer = 0;
+  bool quit = false;
+  while (getline(&buffer, &size_buffer, in) != -1) {
+    std::string line(buffer);
+    line.erase(line.find_last_not_of(" \t\r\n") + 1);
+    if (line.empty()) {
+      continue;
+    }
+    if (line == "quit") {
+      quit = true;
+      break;
+    }
+    sg_log("Query: %s\n", line.c_str());
+    runQuery(line, config_vertex, config_edge, out);
+    fflush(out);
   }
+  free(buffer);
+  return quit;
+}
+
+// Accepts one client at a time on a unix socket at path, queries run one after
+// the other.
+static void serveSocket(const std::string& path,
+                        const config_vertex_domain_t& config_vertex,
+                        const config_edge_processor_t& config_edge) {
+  struct sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address.sun_path)) {
+    sg_err("Socket path too long: %s\n", path.c_str());
+    util::die(1);
+  }
+  strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  unlink(path.c_str());
+  if (fd < 0 || bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+      listen(fd, 1) != 0) {
+    sg_err("Could not listen on %s: %s\n", path.c_str(), strerror(errno));
+    util::die(1);
+  }
+  // a client going away while we answer must not take the server down
+  signal(SIGPIPE, SIG_IGN);
+  sg_log("Waiting for queries on %s\n", path.c_str());
+
+  bool quit = false;
+  while (!quit) {
+    int client = accept(fd, NULL, NULL);
+    if (client < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      sg_err("Could not accept on %s: %s\n", path.c_str(), strerror(errno));
+      util::die(1);
+    }
+    FILE* in = fdopen(client, "r");
+    FILE* out = fdopen(dup(client), "w");
+    quit = serveQueries(in, out, config_vertex, config_edge);
+    fclose(in);
+    fclose(out);
+  }
+
+  close(fd);
+  unlink(path.c_str());
 }
 
 int main(int argc, char** argv) {
   config_vertex_domain_t config_vertex;
   config_edge_processor_t config_edge;
+  std::string server;
 
   // parse command line options
-  if (parseOption(argc, argv, config_vertex, config_edge) != 32) {
+  if (parseOption(argc, argv, config_vertex, config_edge, server) != 32) {
     usage(stderr);
     return 1;
   }
 
+  // every query of the server starts from scratch
+  if (!server.empty() && !config_vertex.path_to_incremental_input.empty()) {
+    sg_log2("Incremental mode is not supported by the server\n");
+    return 1;
+  }
+
+  // only the algorithms below know how to pick up a previous result
+  if (!config_vertex.path_to_incremental_input.empty() &&
+      config_vertex.algorithm != "pagerank-delta" &&
+      config_vertex.algorithm != "cc") {
+    sg_err("Incremental mode is not supported for %s\n",
+           config_vertex.algorithm.c_str());
+    return 1;
+  }
+
   // load graph info
   scenario_stats_t global_stats;
   std::string global_stat_file_name =
@@ -485,11 +760,33 @@ int main(int argc, char** argv) {
          global_stats.count_vertices, global_stats.count_tiles,
          global_stats.is_index_32_bits == true ? "true" : "false");
 
+  // serve queries until asked to quit, the static graph data is loaded once
+  if (!server.empty()) {
+    resident_graph_t resident_graph;
+    core::loadResidentGraph(config_vertex, &resident_graph);
+    config_vertex.resident_graph = &resident_graph;
+
+    if (server == "-") {
+      sg_log2("Waiting for queries on stdin\n");
+      serveQueries(stdin, stdout, config_vertex, config_edge);
+    } else {
+      serveSocket(server, config_vertex, config_edge);
+    }
+    core::freeResidentGraph(&resident_graph);
+    sg_log2("Exit Mosaic!\n");
+    return 0;
+  }
+
   // run!
+  size_t count_iterations;
+  bool found;
   if (global_stats.is_index_32_bits) {
-    run<uint32_t>(config_vertex, config_edge);
+    found = run<uint32_t>(config_vertex, config_edge, &count_iterations);
   } else {
-    run<uint64_t>(config_vertex, config_edge);
+    found = run<uint64_t>(config_vertex, config_edge, &count_iterations);
+  }
+  if (!found) {
+    sg_log2("No algorithm selected, will exit now!\n");
   }
 
   sg_log2("Exit Mosaic!\n");
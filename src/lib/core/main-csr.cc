@@ -0,0 +1,298 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include <util/util.h>
+#include <core/datatypes.h>
+#include <core/util.h>
+#include <core/csr-graph.h>
+#include <core/csr-engine.h>
+
+#include "algorithms/pagerank.h"
+#include "algorithms/pagerank-delta.h"
+#include "algorithms/bfs.h"
+#include "algorithms/ms-bfs.h"
+#include "algorithms/cc.h"
+#include "algorithms/sssp.h"
+#include "algorithms/sssp-delta.h"
+#include "algorithms/embedding.h"
+#include "algorithms/label-propagation.h"
+#include "algorithms/kcore.h"
+#include "algorithms/wcc.h"
+#include "algorithms/tc.h"
+#include "algorithms/bp.h"
+#include "algorithms/kmc.h"
+
+namespace core = scalable_graphs::core;
+namespace util = scalable_graphs::util;
+
+// Runs an algorithm on the same tiles as mosaic, loaded into an in-memory
+// CsrGraph up front, to see how much of a round goes into the pipeline of
+// mosaic rather than into the algorithm itself.
+static int parseOption(int argc, char* argv[], config_vertex_domain_t& config,
+                       int& count_threads) {
+  static struct option options[] = {
+      {"algorithm",                required_argument, 0, 'a'},
+      {"max-iterations",           required_argument, 0, 'b'},
+      {"paths-meta",               required_argument, 0, 'c'},
+      {"paths-tile",               required_argument, 0, 'd'},
+      {"path-globals",             required_argument, 0, 'e'},
+      {"use-selective-scheduling", required_argument, 0, 'f'},
+      {"count-threads",            required_argument, 0, 'g'},
+      {"roots",                    required_argument, 0, 'h'},
+      {"roots-file",               required_argument, 0, 'i'},
+      {"bucket-width",             required_argument, 0, 'j'},
+      {"tolerance",                required_argument, 0, 'k'},
+      {"path-metrics",             required_argument, 0, 'l'},
+      {"path-result",              required_argument, 0, 'm'},
+      {"features-file",            required_argument, 0, 'n'},
+      {0, 0,                                          0, 0},
+  };
+  int arg_cnt;
+  for (arg_cnt = 0; 1; ++arg_cnt) {
+    int c, idx = 0;
+    c = getopt_long(argc, argv, "a:b:c:d:e:f:g:h:i:j:k:l:m:n:", options, &idx);
+    if (c == -1) {
+      break;
+    }
+    switch (c) {
+      case 'a':
+        config.algorithm = std::string(optarg);
+        break;
+      case 'b':
+        config.max_iterations = std::stoi(std::string(optarg));
+        break;
+      case 'c':
+        config.paths_to_meta = util::splitDirPaths(std::string(optarg));
+        break;
+      case 'd':
+        config.paths_to_tile = util::splitDirPaths(std::string(optarg));
+        break;
+      case 'e':
+        config.path_to_globals = util::prepareDirPath(std::string(optarg));
+        break;
+      case 'f':
+        config.use_selective_scheduling = (std::stoi(std::string(optarg)) == 1);
+        break;
+      case 'g':
+        count_threads = std::stoi(std::string(optarg));
+        --arg_cnt;
+        break;
+      case 'h':
+        core::parseVertexList(std::string(optarg), &config.roots);
+        --arg_cnt;
+        break;
+      case 'i':
+        core::readVertexListFile(std::string(optarg), &config.roots);
+        --arg_cnt;
+        break;
+      case 'j':
+        config.bucket_width = std::stof(std::string(optarg));
+        --arg_cnt;
+        break;
+      case 'k':
+        config.convergence_tolerance = std::stod(std::string(optarg));
+        --arg_cnt;
+        break;
+      case 'l':
+        config.path_to_metrics = util::prepareDirPath(std::string(optarg));
+        --arg_cnt;
+        break;
+      case 'm':
+        config.path_to_result = std::string(optarg);
+        --arg_cnt;
+        break;
+      case 'n':
+        core::readFeatureFile(std::string(optarg), &config.features);
+        --arg_cnt;
+        break;
+      default:
+        return -EINVAL;
+    }
+  }
+  return arg_cnt;
+}
+
+static void usage(FILE* out) {
+  extern const char* __progname;
+  fprintf(out, "Usage: %s\n", __progname);
+  fprintf(out, "  --algorithm      = algorithm to run, all of mosaic but "
+      "spmv\n");
+  fprintf(out, "  --max-iterations       = maximum iterations\n");
+  fprintf(out, "  --paths-meta           = path to metadata\n");
+  fprintf(out, "  --paths-tile           = paths to tiledata separated by :\n");
+  fprintf(out, "  --path-globals   = path to global data\n");
+  fprintf(out, "  --use-selective-scheduling   = whether to end the run once "
+      "no vertex is active\n");
+  fprintf(out, "  --count-threads  = (optional) number of worker threads, all "
+      "online cores by default\n");
+  fprintf(out, "  --roots  = (optional) comma-separated start vertices, same "
+      "as for mosaic\n");
+  fprintf(out, "  --roots-file  = (optional) file of whitespace-separated "
+      "start vertices, same as --roots\n");
+  fprintf(out, "  --bucket-width  = (optional) width of the distance buckets "
+      "of sssp-delta, 1 by default\n");
+  fprintf(out, "  --tolerance  = (optional) end the run once the residual of "
+      "the algorithm is at most this, 0 by default\n");
+  fprintf(out, "  --path-metrics  = (optional) write one JSON record of "
+      "metrics per round to csr_engine.json in this directory\n");
+  fprintf(out, "  --path-result  = (optional) write the vertex array to this "
+      "file\n");
+  fprintf(out, "  --features-file  = (optional) file of whitespace-separated "
+      "features, one per vertex, same as for mosaic\n");
+}
+
+template <class APP, bool is_weighted>
+static size_t executeEngine(const config_vertex_domain_t& config,
+                            const config_t& config_graph,
+                            const scenario_stats_t& global_stats,
+                            int count_threads) {
+  core::CsrGraph graph;
+  uint64_t start_time = util::get_time_nsec();
+  graph.loadTiles(config_graph, global_stats, APP::need_transposed_tiles);
+  sg_log("Loading time: %.3fmsec\n",
+         (util::get_time_nsec() - start_time) / 1e6);
+
+  core::CsrEngine<APP, is_weighted> engine(config, graph, count_threads);
+  engine.init();
+  return engine.run();
+}
+
+static bool runUnweighted(const config_vertex_domain_t& config,
+                          const config_t& config_graph,
+                          const scenario_stats_t& global_stats,
+                          int count_threads, size_t* count_iterations) {
+  if (config.algorithm == "pagerank") {
+    *count_iterations = executeEngine<core::PageRank, false>(
+        config, config_graph, global_stats, count_threads);
+  } else if (config.algorithm == "pagerank-delta") {
+    *count_iterations = executeEngine<core::PageRankDelta, false>(
+        config, config_graph, global_stats, count_threads);
+  } else if (config.algorithm == "bfs") {
+    *count_iterations = executeEngine<core::BFS, false>(
+        config, config_graph, global_stats, count_threads);
+  } else if (config.algorithm == "ms-bfs") {
+    *count_iterations = executeEngine<core::MSBFS, false>(
+        config, config_graph, global_stats, count_threads);
+  } else if (config.algorithm == "cc") {
+    *count_iterations = executeEngine<core::CC, false>(
+        config, config_graph, global_stats, count_threads);
+  } else if (config.algorithm == "tc") {
+    *count_iterations = executeEngine<core::TC, false>(
+        config, config_graph, global_stats, count_threads);
+  } else if (config.algorithm == "embedding") {
+    typedef core::Embedding<EMBEDDING_DIMENSIONS> Embedding;
+    *count_iterations = executeEngine<Embedding, false>(
+        config, config_graph, global_stats, count_threads);
+  } else if (config.algorithm == "label-propagation") {
+    typedef core::LabelPropagation<LABEL_PROPAGATION_SKETCH_SIZE>
+        LabelPropagation;
+    *count_iterations = executeEngine<LabelPropagation, false>(
+        config, config_graph, global_stats, count_threads);
+  } else if (config.algorithm == "kcore") {
+    *count_iterations = executeEngine<core::KCore, false>(
+        config, config_graph, global_stats, count_threads);
+  } else if (config.algorithm == "wcc") {
+    *count_iterations = executeEngine<core::WCC, false>(
+        config, config_graph, global_stats, count_threads);
+  } else if (config.algorithm == "kmc") {
+    typedef core::KMC<KMC_CLUSTERS> KMC;
+    *count_iterations = executeEngine<KMC, false>(
+        config, config_graph, global_stats, count_threads);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+static bool runWeighted(const config_vertex_domain_t& config,
+                        const config_t& config_graph,
+                        const scenario_stats_t& global_stats,
+                        int count_threads, size_t* count_iterations) {
+  if (config.algorithm == "sssp") {
+    *count_iterations = executeEngine<core::SSSP, true>(
+        config, config_graph, global_stats, count_threads);
+  } else if (config.algorithm == "sssp-delta") {
+    *count_iterations = executeEngine<core::SSSPDelta, true>(
+        config, config_graph, global_stats, count_threads);
+  } else if (config.algorithm == "bp") {
+    *count_iterations = executeEngine<core::BP, true>(
+        config, config_graph, global_stats, count_threads);
+  } else if (config.algorithm == "embedding") {
+    typedef core::Embedding<EMBEDDING_DIMENSIONS> Embedding;
+    *count_iterations = executeEngine<Embedding, true>(
+        config, config_graph, global_stats, count_threads);
+  } else if (config.algorithm == "kmc") {
+    typedef core::KMC<KMC_CLUSTERS> KMC;
+    *count_iterations = executeEngine<KMC, true>(
+        config, config_graph, global_stats, count_threads);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  config_vertex_domain_t config;
+  int count_threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+  // parse command line options
+  if (parseOption(argc, argv, config, count_threads) != 6 ||
+      config.paths_to_meta.empty() ||
+      config.paths_to_meta.size() != config.paths_to_tile.size()) {
+    usage(stderr);
+    return 1;
+  }
+
+  // spmv reads the tile-local target ids, which a CsrGraph does not keep
+  if (config.algorithm == "spmv") {
+    sg_err("The CSR engine does not support %s\n", config.algorithm.c_str());
+    return 1;
+  }
+
+  // load graph info
+  scenario_stats_t global_stats;
+  std::string global_stat_file_name =
+      core::getGlobalStatFileName(config.paths_to_meta[0]);
+  util::readDataFromFile(global_stat_file_name, sizeof(scenario_stats_t),
+                         &global_stats);
+
+  config.count_vertices = global_stats.count_vertices;
+  config.count_tiles = global_stats.count_tiles;
+  config.is_graph_weighted = global_stats.is_weighted_graph;
+  config.is_index_32_bits = global_stats.is_index_32_bits;
+  config.count_edge_processors = config.paths_to_meta.size();
+
+  config_t config_graph;
+  config_graph.paths_to_meta = config.paths_to_meta;
+  config_graph.paths_to_tile = config.paths_to_tile;
+  config_graph.path_to_globals = config.path_to_globals;
+  config_graph.count_tiles = global_stats.count_tiles;
+  config_graph.count_edge_processors = config.count_edge_processors;
+
+  sg_log("Running with %lu vertices, %lu tiles, %d threads\n",
+         global_stats.count_vertices, global_stats.count_tiles, count_threads);
+
+  size_t count_iterations = 0;
+  bool found;
+  if (global_stats.is_weighted_graph) {
+    found = runWeighted(config, config_graph, global_stats, count_threads,
+                        &count_iterations);
+  } else {
+    found = runUnweighted(config, config_graph, global_stats, count_threads,
+                          &count_iterations);
+  }
+  if (!found) {
+    sg_err("No %s algorithm %s\n",
+           global_stats.is_weighted_graph ? "weighted" : "unweighted",
+           config.algorithm.c_str());
+    return 1;
+  }
+
+  sg_log2("Exit CSR baseline!\n");
+
+  return 0;
+}
@@ -15,9 +15,16 @@
 #include <core/edge-processor.h>
 
 #include "algorithms/pagerank.h"
+#include "algorithms/pagerank-delta.h"
 #include "algorithms/bfs.h"
+#include "algorithms/ms-bfs.h"
 #include "algorithms/cc.h"
 #include "algorithms/sssp.h"
+#include "algorithms/sssp-delta.h"
+#include "algorithms/embedding.h"
+#include "algorithms/label-propagation.h"
+#include "algorithms/kcore.h"
+#include "algorithms/wcc.h"
 #include "algorithms/spmv.h"
 #include "algorithms/tc.h"
 #include "algorithms/bp.h"
@@ -59,6 +66,10 @@ static int parseOption(int argc, char* argv[],
       {"count-vertex-fetcher", required_argument, 0, 'B'},
       {"use-smt", required_argument, 0, 'C'},
       {"count-followers", required_argument, 0, 'D'},
+      {"enable-perf-counters", required_argument, 0, 'E'},
+      {"path-metrics", required_argument, 0, 'F'},
+      {"metrics-address", required_argument, 0, 'G'},
+      {"verify-tiles", required_argument, 0, 'H'},
       {0, 0, 0, 0},
   };
   int arg_cnt;
@@ -67,7 +78,7 @@ static int parseOption(int argc, char* argv[],
     int c, idx = 0;
     c = getopt_long(
         argc, argv,
-        "a:b:c:d:e:f:g:h:i:j:k:l:m:n:o:p:q:r:s:t:u:v:w:x:y:z:A:B:C:D:", options,
+        "a:b:c:d:e:f:g:h:i:j:k:l:m:n:o:p:q:r:s:t:u:v:w:x:y:z:A:B:C:D:E:F:G:H:", options,
         &idx);
     if (c == -1)
       break;
@@ -217,6 +228,22 @@ static int parseOption(int argc, char* argv[],
     case 'D':
       config.count_followers = std::stoi(std::string(optarg));
       break;
+    case 'E':
+      config.enable_perf_counters = (std::stoi(std::string(optarg)) == 1);
+      --arg_cnt;
+      break;
+    case 'F':
+      config.path_to_metrics = util::prepareDirPath(std::string(optarg));
+      --arg_cnt;
+      break;
+    case 'G':
+      config.metrics_address = std::string(optarg);
+      --arg_cnt;
+      break;
+    case 'H':
+      config.verify_tiles = (std::stoi(std::string(optarg)) == 1);
+      --arg_cnt;
+      break;
     default:
       return -EINVAL;
     }
@@ -275,6 +302,17 @@ static void usage(FILE* out) {
                "run in, options are: Active and ConstantValue.\n");
   fprintf(out, "  --use-smt   = use smt\n");
   fprintf(out, "  --count-followers   = the number of followers to use.\n");
+  fprintf(out, "  --enable-perf-counters  = (optional) count cycles, "
+               "instructions, cache and TLB misses per component, needs "
+               "--enable-perf-event-collection\n");
+  fprintf(out, "  --path-metrics  = (optional) write one JSON record of "
+               "metrics per round to edge_processor_<mic-index>.json in this "
+               "directory\n");
+  fprintf(out, "  --metrics-address  = (optional) serve live metrics in the "
+               "Prometheus text format on this port of 127.0.0.1 or unix "
+               "socket path\n");
+  fprintf(out, "  --verify-tiles  = (optional) check the checksums of all "
+               "tiles once when the in-memory mode maps them\n");
 }
 
 template <class APP, typename TVertexType, bool is_weighted>
@@ -289,14 +327,34 @@ static void executeEngine(const config_edge_processor_t& config) {
 static void run(const config_edge_processor_t& config) {
   if (config.algorithm == "pagerank") {
     executeEngine<core::PageRank, core::PageRank::VertexType, false>(config);
+  } else if (config.algorithm == "pagerank-delta") {
+    executeEngine<core::PageRankDelta, core::PageRankDelta::VertexType, false>(
+        config);
   } else if (config.algorithm == "bfs") {
     executeEngine<core::BFS, core::BFS::VertexType, false>(config);
+  } else if (config.algorithm == "ms-bfs") {
+    executeEngine<core::MSBFS, core::MSBFS::VertexType, false>(config);
   } else if (config.algorithm == "cc") {
     executeEngine<core::CC, core::CC::VertexType, false>(config);
   } else if (config.algorithm == "spmv") {
     executeEngine<core::SPMV, core::SPMV::VertexType, false>(config);
   } else if (config.algorithm == "tc") {
     executeEngine<core::TC, core::TC::VertexType, false>(config);
+  } else if (config.algorithm == "embedding") {
+    typedef core::Embedding<EMBEDDING_DIMENSIONS> Embedding;
+    executeEngine<Embedding, Embedding::VertexType, false>(config);
+  } else if (config.algorithm == "label-propagation") {
+    typedef core::LabelPropagation<LABEL_PROPAGATION_SKETCH_SIZE>
+        LabelPropagation;
+    executeEngine<LabelPropagation, LabelPropagation::VertexType, false>(
+        config);
+  } else if (config.algorithm == "kcore") {
+    executeEngine<core::KCore, core::KCore::VertexType, false>(config);
+  } else if (config.algorithm == "wcc") {
+    executeEngine<core::WCC, core::WCC::VertexType, false>(config);
+  } else if (config.algorithm == "kmc") {
+    typedef core::KMC<KMC_CLUSTERS> KMC;
+    executeEngine<KMC, KMC::VertexType, false>(config);
   } else {
     sg_log2("No algorithm selected, will exit now!\n");
   }
@@ -305,8 +363,16 @@ static void run(const config_edge_processor_t& config) {
 static void runWeighted(const config_edge_processor_t& config) {
   if (config.algorithm == "sssp") {
     executeEngine<core::SSSP, core::SSSP::VertexType, true>(config);
+  } else if (config.algorithm == "sssp-delta") {
+    executeEngine<core::SSSPDelta, core::SSSPDelta::VertexType, true>(config);
   } else if (config.algorithm == "bp") {
     executeEngine<core::BP, core::BP::VertexType, true>(config);
+  } else if (config.algorithm == "embedding") {
+    typedef core::Embedding<EMBEDDING_DIMENSIONS> Embedding;
+    executeEngine<Embedding, Embedding::VertexType, true>(config);
+  } else if (config.algorithm == "kmc") {
+    typedef core::KMC<KMC_CLUSTERS> KMC;
+    executeEngine<KMC, KMC::VertexType, true>(config);
   } else {
     sg_log2("No algorithm selected, will exit now!\n");
   }
@@ -15,9 +15,16 @@
 #include <core/vertex-domain.h>
 
 #include "algorithms/pagerank.h"
+#include "algorithms/pagerank-delta.h"
 #include "algorithms/bfs.h"
+#include "algorithms/ms-bfs.h"
 #include "algorithms/cc.h"
 #include "algorithms/sssp.h"
+#include "algorithms/sssp-delta.h"
+#include "algorithms/embedding.h"
+#include "algorithms/label-propagation.h"
+#include "algorithms/kcore.h"
+#include "algorithms/wcc.h"
 #include "algorithms/spmv.h"
 #include "algorithms/tc.h"
 #include "algorithms/bp.h"
@@ -59,6 +66,17 @@ static int parseOption(int argc, char* argv[], config_vertex_domain_t& config) {
       {"use-smt", required_argument, 0, 'C'},
       {"host-tiles-rb-size", required_argument, 0, 'D'},
       {"local-reducer-mode", required_argument, 0, 'E'},
+      {"incremental-input", required_argument, 0, 'F'},
+      {"incremental-insertions", required_argument, 0, 'G'},
+      {"incremental-deletions", required_argument, 0, 'H'},
+      {"roots", required_argument, 0, 'I'},
+      {"roots-file", required_argument, 0, 'J'},
+      {"bucket-width", required_argument, 0, 'K'},
+      {"tolerance", required_argument, 0, 'L'},
+      {"enable-perf-counters", required_argument, 0, 'M'},
+      {"path-metrics", required_argument, 0, 'N'},
+      {"metrics-address", required_argument, 0, 'O'},
+      {"features-file", required_argument, 0, 'P'},
       {0, 0, 0, 0},
   };
   int arg_cnt;
@@ -67,7 +85,7 @@ static int parseOption(int argc, char* argv[], config_vertex_domain_t& config) {
     int c, idx = 0;
     c = getopt_long(
         argc, argv,
-        "a:b:c:d:e:f:g:h:i:j:k:l:m:n:o:p:q:r:s:t:u:v:w:x:y:z:A:B:C:D:E",
+        "a:b:c:d:e:f:g:h:i:j:k:l:m:n:o:p:q:r:s:t:u:v:w:x:y:z:A:B:C:D:E:F:G:H:I:J:K:L:M:N:O:P:",
         options, &idx);
     if (c == -1)
       break;
@@ -208,6 +226,50 @@ static int parseOption(int argc, char* argv[], config_vertex_domain_t& config) {
       }
       break;
     }
+    case 'F':
+      config.path_to_incremental_input = std::string(optarg);
+      --arg_cnt;
+      break;
+    case 'G':
+      config.path_to_incremental_insertions = std::string(optarg);
+      --arg_cnt;
+      break;
+    case 'H':
+      config.path_to_incremental_deletions = std::string(optarg);
+      --arg_cnt;
+      break;
+    case 'I':
+      core::parseVertexList(std::string(optarg), &config.roots);
+      --arg_cnt;
+      break;
+    case 'J':
+      core::readVertexListFile(std::string(optarg), &config.roots);
+      --arg_cnt;
+      break;
+    case 'K':
+      config.bucket_width = std::stof(std::string(optarg));
+      --arg_cnt;
+      break;
+    case 'L':
+      config.convergence_tolerance = std::stod(std::string(optarg));
+      --arg_cnt;
+      break;
+    case 'M':
+      config.enable_perf_counters = (std::stoi(std::string(optarg)) == 1);
+      --arg_cnt;
+      break;
+    case 'N':
+      config.path_to_metrics = util::prepareDirPath(std::string(optarg));
+      --arg_cnt;
+      break;
+    case 'O':
+      config.metrics_address = std::string(optarg);
+      --arg_cnt;
+      break;
+    case 'P':
+      core::readFeatureFile(std::string(optarg), &config.features);
+      --arg_cnt;
+      break;
     default:
       return -EINVAL;
     }
@@ -268,6 +330,32 @@ static void usage(FILE* out) {
   fprintf(out, "  --local-reducer-mode  = the mode for the local reducer to "
                "run in, options are: GlobalReducer, Locking, "
                "and Atomic.\n");
+  fprintf(out, "  --incremental-input  = (optional) vertex array of a previous "
+               "run to restart from, pagerank-delta and cc only\n");
+  fprintf(out, "  --incremental-insertions  = (optional) edges inserted since "
+               "the previous run\n");
+  fprintf(out, "  --incremental-deletions  = (optional) edges deleted since "
+               "the previous run\n");
+  fprintf(out, "  --roots  = (optional) comma-separated start vertices, bfs, "
+               "sssp, sssp-delta and ms-bfs only, ms-bfs takes up to "
+               "64\n");
+  fprintf(out, "  --roots-file  = (optional) file of whitespace-separated "
+               "start vertices, same as --roots\n");
+  fprintf(out, "  --bucket-width  = (optional) width of the distance buckets "
+               "of sssp-delta, 1 by default\n");
+  fprintf(out, "  --tolerance  = (optional) end the run once the residual of "
+               "the algorithm is at most this, 0 by default\n");
+  fprintf(out, "  --enable-perf-counters  = (optional) count cycles, "
+               "instructions, cache and TLB misses per component, needs "
+               "--enable-perf-event-collection\n");
+  fprintf(out, "  --path-metrics  = (optional) write one JSON record of "
+               "metrics per round to vertex_domain.json in this directory\n");
+  fprintf(out, "  --metrics-address  = (optional) serve live metrics in the "
+               "Prometheus text format on this port of 127.0.0.1 or unix "
+               "socket path\n");
+  fprintf(out, "  --features-file  = (optional) file of whitespace-separated "
+               "features, one per vertex, kmc only, derived from the ids by "
+               "default\n");
 }
 
 template <class APP, typename TVertexType, typename TVertexIdType>
@@ -283,18 +371,41 @@ static void run(const config_vertex_domain_t& config) {
   if (config.algorithm == "pagerank") {
     executeEngine<core::PageRank, core::PageRank::VertexType, TVertexIdType>(
         config);
+  } else if (config.algorithm == "pagerank-delta") {
+    executeEngine<core::PageRankDelta, core::PageRankDelta::VertexType,
+                  TVertexIdType>(config);
   } else if (config.algorithm == "bfs") {
     executeEngine<core::BFS, core::BFS::VertexType, TVertexIdType>(config);
+  } else if (config.algorithm == "ms-bfs") {
+    executeEngine<core::MSBFS, core::MSBFS::VertexType, TVertexIdType>(config);
   } else if (config.algorithm == "cc") {
     executeEngine<core::CC, core::CC::VertexType, TVertexIdType>(config);
   } else if (config.algorithm == "sssp") {
     executeEngine<core::SSSP, core::SSSP::VertexType, TVertexIdType>(config);
+  } else if (config.algorithm == "sssp-delta") {
+    executeEngine<core::SSSPDelta, core::SSSPDelta::VertexType, TVertexIdType>(
+        config);
   } else if (config.algorithm == "spmv") {
     executeEngine<core::SPMV, core::SPMV::VertexType, TVertexIdType>(config);
   } else if (config.algorithm == "tc") {
     executeEngine<core::TC, core::TC::VertexType, TVertexIdType>(config);
   } else if (config.algorithm == "bp") {
     executeEngine<core::BP, core::BP::VertexType, TVertexIdType>(config);
+  } else if (config.algorithm == "embedding") {
+    typedef core::Embedding<EMBEDDING_DIMENSIONS> Embedding;
+    executeEngine<Embedding, Embedding::VertexType, TVertexIdType>(config);
+  } else if (config.algorithm == "label-propagation") {
+    typedef core::LabelPropagation<LABEL_PROPAGATION_SKETCH_SIZE>
+        LabelPropagation;
+    executeEngine<LabelPropagation, LabelPropagation::VertexType,
+                  TVertexIdType>(config);
+  } else if (config.algorithm == "kcore") {
+    executeEngine<core::KCore, core::KCore::VertexType, TVertexIdType>(config);
+  } else if (config.algorithm == "wcc") {
+    executeEngine<core::WCC, core::WCC::VertexType, TVertexIdType>(config);
+  } else if (config.algorithm == "kmc") {
+    typedef core::KMC<KMC_CLUSTERS> KMC;
+    executeEngine<KMC, KMC::VertexType, TVertexIdType>(config);
   } else {
     sg_log2("No algorithm selected, will exit now!\n");
   }
@@ -308,6 +419,14 @@ int main(int argc, char** argv) {
     return 1;
   }
 
+  // only the algorithms below know how to pick up a previous result
+  if (!config.path_to_incremental_input.empty() &&
+      config.algorithm != "pagerank-delta" && config.algorithm != "cc") {
+    sg_err("Incremental mode is not supported for %s\n",
+           config.algorithm.c_str());
+    return 1;
+  }
+
   // load graph info
   scenario_stats_t global_stats;
   std::string global_stat_file_name =
@@ -0,0 +1,373 @@
+#include <core/tile-container.h>
+
+#include <algorithm>
+
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <util/arch.h>
+#include <util/util.h>
+#include <core/util.h>
+
+namespace scalable_graphs {
+namespace core {
+  static_assert(sizeof(tile_container_header_t) <= PAGE_SIZE,
+                "tile container header must fit into the first page");
+
+  static uint32_t headerChecksum(const tile_container_header_t& header) {
+    return util::crc32c(&header,
+                        offsetof(tile_container_header_t, checksum_header));
+  }
+
+  TileContainer::TileContainer()
+      : entries_(NULL), fd_(-1), direct_fd_(-1), mapping_(NULL) {
+    memset(&header_, 0, sizeof(header_));
+  }
+
+  TileContainer::~TileContainer() {
+    if (mapping_ != NULL) {
+      munmap(mapping_, header_.size_file);
+    }
+    if (fd_ != -1) {
+      ::close(fd_);
+    }
+    if (direct_fd_ != -1) {
+      ::close(direct_fd_);
+    }
+    delete[] entries_;
+  }
+
+  bool TileContainer::exists(const std::string& file_name) {
+    struct stat st;
+    return stat(file_name.c_str(), &st) == 0;
+  }
+
+  void TileContainer::open(const std::string& file_name) {
+    file_name_ = file_name;
+
+    fd_ = ::open(file_name.c_str(), O_RDONLY);
+    if (fd_ == -1) {
+      sg_err("Unable to open tile container %s: %s\n", file_name.c_str(),
+             strerror(errno));
+      util::die(1);
+    }
+
+    util::readFileOffset(fd_, &header_, sizeof(header_), 0);
+
+    if (header_.magic != TILE_CONTAINER_MAGIC ||
+        header_.checksum_header != headerChecksum(header_)) {
+      sg_err("%s is not a valid tile container\n", file_name.c_str());
+      util::die(1);
+    }
+    if (header_.version != TILE_CONTAINER_VERSION) {
+      sg_err("Tile container %s has version %u, expected %u\n",
+             file_name.c_str(), header_.version, TILE_CONTAINER_VERSION);
+      util::die(1);
+    }
+    if (header_.alignment != TILE_READ_ALIGN) {
+      sg_err("Tile container %s aligned to %u, expected %u\n",
+             file_name.c_str(), header_.alignment, TILE_READ_ALIGN);
+      util::die(1);
+    }
+
+    struct stat st;
+    if (fstat(fd_, &st) != 0 || (uint64_t)st.st_size != header_.size_file) {
+      sg_err("Tile container %s is truncated\n", file_name.c_str());
+      util::die(1);
+    }
+
+    size_t size_entries = sizeof(tile_container_entry_t) * header_.count_tiles;
+    entries_ = new tile_container_entry_t[header_.count_tiles];
+    util::readFileOffset(fd_, entries_, size_entries, header_.offset_entries);
+
+    if (util::crc32c(entries_, size_entries) != header_.checksum_entries) {
+      sg_err("Entry table of tile container %s is corrupt\n",
+             file_name.c_str());
+      util::die(1);
+    }
+
+    direct_fd_ = util::openFileDirectly(file_name);
+  }
+
+  void TileContainer::map() {
+    // Nothing writes to the tiles, the block id of a tile travels in the
+    // tile descriptors of the readers. Populating the mapping would fault in
+    // the whole container synchronously, read it ahead instead.
+    void* mapping =
+        mmap(NULL, header_.size_file, PROT_READ, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+      sg_err("Unable to map tile container %s: %s\n", file_name_.c_str(),
+             strerror(errno));
+      util::die(1);
+    }
+    mapping_ = (uint8_t*)mapping;
+    if (madvise(mapping_, header_.size_file, MADV_WILLNEED) != 0) {
+      sg_log("Unable to read ahead tile container %s: %s\n",
+             file_name_.c_str(), strerror(errno));
+    }
+  }
+
+  bool TileContainer::verifyTile(size_t tile_id) const {
+    const tile_container_entry_t& tile_entry = entries_[tile_id];
+    return util::crc32c(mapping_ + tile_entry.offset_edge_block,
+                        tile_entry.size_edge_block) ==
+               tile_entry.checksum_edge_block &&
+           util::crc32c(mapping_ + tile_entry.offset_index,
+                        tile_entry.size_index) == tile_entry.checksum_index;
+  }
+
+  void TileContainer::verify() const {
+    uint64_t start_time = util::get_time_nsec();
+    for (size_t i = 0; i < header_.count_tiles; ++i) {
+      if (!verifyTile(i)) {
+        sg_err("Checksum mismatch for tile %lu of %s\n", i,
+               file_name_.c_str());
+        util::die(1);
+      }
+    }
+    sg_log("Verified %lu tiles of %s in %.3fmsec\n", header_.count_tiles,
+           file_name_.c_str(), (util::get_time_nsec() - start_time) / 1e6);
+  }
+
+  void TileContainer::copyTileStats(tile_stats_t* tile_stats) const {
+    for (size_t i = 0; i < header_.count_tiles; ++i) {
+      tile_stats[i] = entries_[i].stats;
+    }
+  }
+
+  const edge_block_t* TileContainer::getEdgeBlock(size_t tile_id) const {
+    return (const edge_block_t*)(mapping_ +
+                                 entries_[tile_id].offset_edge_block);
+  }
+
+  const edge_block_index_t*
+  TileContainer::getEdgeBlockIndex(size_t tile_id) const {
+    return (const edge_block_index_t*)(mapping_ +
+                                       entries_[tile_id].offset_index);
+  }
+
+  void TileContainer::readEdgeBlock(size_t tile_id, void* buffer) const {
+    util::readFileOffset(fd_, buffer, entries_[tile_id].size_edge_block,
+                         entries_[tile_id].offset_edge_block);
+  }
+
+  void TileContainer::readEdgeBlockIndex(size_t tile_id, void* buffer) const {
+    util::readFileOffset(fd_, buffer, entries_[tile_id].size_index,
+                         entries_[tile_id].offset_index);
+  }
+
+  TileTombstones::TileTombstones()
+      : masks_(NULL), count_tiles_(0), count_tombstones_(0) {}
+
+  TileTombstones::~TileTombstones() {
+    for (size_t i = 0; i < count_tiles_; ++i) {
+      delete[] masks_[i];
+    }
+    delete[] masks_;
+  }
+
+  bool TileTombstones::exists(const std::string& file_name) {
+    return TileContainer::exists(file_name);
+  }
+
+  void TileTombstones::open(const std::string& file_name,
+                            const tile_stats_t* tile_stats,
+                            size_t count_tiles) {
+    std::vector<tile_tombstone_t> tombstones;
+    if (read(file_name, &tombstones) != count_tiles) {
+      sg_err("Tombstones %s do not match the %lu base tiles\n",
+             file_name.c_str(), count_tiles);
+      util::die(1);
+    }
+
+    count_tiles_ = count_tiles;
+    count_tombstones_ = tombstones.size();
+    masks_ = new char*[count_tiles];
+    memset(masks_, 0, sizeof(char*) * count_tiles);
+
+    for (const auto& tombstone : tombstones) {
+      if (tombstone.tile_id >= count_tiles ||
+          tombstone.edge_id >= tile_stats[tombstone.tile_id].count_edges) {
+        sg_err("Tombstone (%u, %u) of %s is out of range\n", tombstone.tile_id,
+               tombstone.edge_id, file_name.c_str());
+        util::die(1);
+      }
+      char*& mask = masks_[tombstone.tile_id];
+      if (mask == NULL) {
+        size_t size_mask =
+            size_bool_array(tile_stats[tombstone.tile_id].count_edges);
+        mask = new char[size_mask];
+        memset(mask, 0, size_mask);
+      }
+      set_bool_array(mask, tombstone.edge_id, true);
+    }
+  }
+
+  size_t TileTombstones::read(const std::string& file_name,
+                              std::vector<tile_tombstone_t>* tombstones) {
+    tile_tombstones_header_t header;
+    int fd = ::open(file_name.c_str(), O_RDONLY);
+    if (fd == -1) {
+      sg_err("Unable to open tombstones %s: %s\n", file_name.c_str(),
+             strerror(errno));
+      util::die(1);
+    }
+    util::readFileOffset(fd, &header, sizeof(header), 0);
+    if (header.magic != TILE_TOMBSTONES_MAGIC) {
+      sg_err("%s is not a valid tombstone file\n", file_name.c_str());
+      util::die(1);
+    }
+
+    tombstones->resize(header.count_tombstones);
+    util::readFileOffset(fd, tombstones->data(),
+                         sizeof(tile_tombstone_t) * header.count_tombstones,
+                         sizeof(header));
+    ::close(fd);
+    return header.count_tiles;
+  }
+
+  void TileTombstones::write(const std::string& file_name, size_t count_tiles,
+                             std::vector<tile_tombstone_t>* tombstones) {
+    std::sort(tombstones->begin(), tombstones->end());
+
+    tile_tombstones_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = TILE_TOMBSTONES_MAGIC;
+    header.count_tiles = count_tiles;
+    header.count_tombstones = tombstones->size();
+
+    int fd = ::open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+      sg_err("Unable to create tombstones %s: %s\n", file_name.c_str(),
+             strerror(errno));
+      util::die(1);
+    }
+    util::writeFileOffset(fd, &header, sizeof(header), 0);
+    util::writeFileOffset(fd, tombstones->data(),
+                          sizeof(tile_tombstone_t) * tombstones->size(),
+                          sizeof(header));
+    ::close(fd);
+  }
+
+  TileContainer* openTransposedTileContainer(const config_t& config,
+                                             int meta_index) {
+    std::string file_name =
+        getTransposedTileContainerFileName(config, meta_index);
+    if (!TileContainer::exists(file_name)) {
+      sg_err("Transposed tiles %s missing, run post-grc-transposer first\n",
+             file_name.c_str());
+      util::die(1);
+    }
+    TileContainer* container = new TileContainer();
+    container->open(file_name);
+    return container;
+  }
+
+  TileContainerWriter::TileContainerWriter(const std::string& file_name,
+                                           const tile_stats_t* tile_stats,
+                                           size_t count_tiles,
+                                           bool is_weighted,
+                                           bool is_index_32_bits)
+      : file_name_(file_name) {
+    memset(&header_, 0, sizeof(header_));
+    header_.magic = TILE_CONTAINER_MAGIC;
+    header_.version = TILE_CONTAINER_VERSION;
+    header_.alignment = TILE_READ_ALIGN;
+    header_.count_tiles = count_tiles;
+    header_.is_weighted_graph = is_weighted;
+    header_.is_index_32_bits = is_index_32_bits;
+
+    entries_ = new tile_container_entry_t[count_tiles];
+    memset(entries_, 0, sizeof(tile_container_entry_t) * count_tiles);
+
+    // the layout only depends on the tile stats, lay out both regions up
+    // front
+    header_.offset_entries = PAGE_SIZE;
+    size_t offset = header_.offset_entries +
+                    sizeof(tile_container_entry_t) * count_tiles;
+
+    header_.offset_edge_blocks = int_ceil(offset, TILE_READ_ALIGN);
+    offset = header_.offset_edge_blocks;
+    for (size_t i = 0; i < count_tiles; ++i) {
+      entries_[i].stats = tile_stats[i];
+      entries_[i].size_edge_block = getSizeEdgeBlock(tile_stats[i], is_weighted);
+      entries_[i].offset_edge_block = offset;
+      offset += int_ceil(entries_[i].size_edge_block, PAGE_SIZE);
+    }
+
+    header_.offset_indices = int_ceil(offset, TILE_READ_ALIGN);
+    offset = header_.offset_indices;
+    for (size_t i = 0; i < count_tiles; ++i) {
+      entries_[i].size_index =
+          getSizeEdgeBlockIndex(tile_stats[i], is_index_32_bits);
+      entries_[i].offset_index = offset;
+      offset += int_ceil(entries_[i].size_index, PAGE_SIZE);
+    }
+
+    // pad the end as well, aligned reads of the last tiles must not hit EOF
+    header_.size_file = int_ceil(offset, TILE_READ_ALIGN);
+
+    fd_ = ::open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd_ == -1) {
+      sg_err("Unable to create tile container %s: %s\n", file_name.c_str(),
+             strerror(errno));
+      util::die(1);
+    }
+    if (ftruncate(fd_, header_.size_file) != 0) {
+      sg_err("Unable to resize tile container %s: %s\n", file_name.c_str(),
+             strerror(errno));
+      util::die(1);
+    }
+  }
+
+  TileContainerWriter::~TileContainerWriter() {
+    if (fd_ != -1) {
+      ::close(fd_);
+    }
+    delete[] entries_;
+  }
+
+  void TileContainerWriter::writeEdgeBlock(size_t tile_id,
+                                           const edge_block_t* edge_block) {
+    tile_container_entry_t& tile_entry = entries_[tile_id];
+    tile_entry.checksum_edge_block =
+        util::crc32c(edge_block, tile_entry.size_edge_block);
+    util::writeFileOffset(fd_, const_cast<edge_block_t*>(edge_block),
+                          tile_entry.size_edge_block,
+                          tile_entry.offset_edge_block);
+  }
+
+  void TileContainerWriter::writeEdgeBlockIndex(
+      size_t tile_id, const edge_block_index_t* edge_block_index) {
+    tile_container_entry_t& tile_entry = entries_[tile_id];
+    tile_entry.checksum_index =
+        util::crc32c(edge_block_index, tile_entry.size_index);
+    util::writeFileOffset(fd_,
+                          const_cast<edge_block_index_t*>(edge_block_index),
+                          tile_entry.size_index, tile_entry.offset_index);
+  }
+
+  void TileContainerWriter::close() {
+    size_t size_entries = sizeof(tile_container_entry_t) * header_.count_tiles;
+    header_.checksum_entries = util::crc32c(entries_, size_entries);
+    header_.checksum_header = headerChecksum(header_);
+
+    util::writeFileOffset(fd_, entries_, size_entries, header_.offset_entries);
+    util::writeFileOffset(fd_, &header_, sizeof(header_), 0);
+
+    if (fsync(fd_) != 0) {
+      sg_err("Unable to sync tile container %s: %s\n", file_name_.c_str(),
+             strerror(errno));
+      util::die(1);
+    }
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+}
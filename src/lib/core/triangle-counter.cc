@@ -0,0 +1,478 @@
+#include <core/triangle-counter.h>
+
+#include <algorithm>
+#include <sstream>
+
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <util/arch.h>
+#include <util/runnable.h>
+#include <util/util.h>
+#include <core/tile-container.h>
+#include <core/util.h>
+
+namespace scalable_graphs {
+namespace core {
+  // edges buffered per row before appending them to its spill file
+  static const size_t COUNT_SPILL_BATCH = 1 << 16;
+
+  // vertices of row i handed to a TriangleWorker at once
+  static const uint64_t COUNT_VERTICES_CHUNK = 1024;
+
+  static bool lessEdge(const edge_t& lhs, const edge_t& rhs) {
+    return lhs.src < rhs.src || (lhs.src == rhs.src && lhs.tgt < rhs.tgt);
+  }
+
+  static bool equalEdge(const edge_t& lhs, const edge_t& rhs) {
+    return lhs.src == rhs.src && lhs.tgt == rhs.tgt;
+  }
+
+  // The tile pair (i, k) counted by the TriangleWorkers at the moment, its
+  // vertices u of row i are handed out in chunks through next_chunk.
+  struct tile_pair_t {
+    const uint64_t* offsets_i;
+    const uint32_t* neighbors_i;
+    uint64_t count_vertices_i;
+    const uint64_t* offsets_k;
+    const uint32_t* neighbors_k;
+    uint64_t first_vertex_k;
+    uint64_t last_vertex_k;
+    uint64_t count_chunks;
+    uint64_t next_chunk;
+    // no tile pair left, the workers return
+    bool done;
+  };
+
+  // Counts the triangles closed by the edges (u, v) of the tile pairs
+  // published by TriangleCounter::count, from the first barrier wait to the
+  // second one per tile pair.
+  class TriangleWorker : public util::Runnable {
+  public:
+    TriangleWorker(tile_pair_t* pair, pthread_barrier_t* barrier)
+        : pair_(pair), barrier_(barrier), count_(0) {}
+
+    inline uint64_t count() const { return count_; }
+
+    void countChunks() {
+      const tile_pair_t& pair = *pair_;
+      for (uint64_t chunk = smp_faa(&pair_->next_chunk, 1);
+           chunk < pair.count_chunks; chunk = smp_faa(&pair_->next_chunk, 1)) {
+        uint64_t start = chunk * COUNT_VERTICES_CHUNK;
+        uint64_t end =
+            std::min(start + COUNT_VERTICES_CHUNK, pair.count_vertices_i);
+        for (uint64_t u = start; u < end; ++u) {
+          const uint32_t* begin_u = pair.neighbors_i + pair.offsets_i[u];
+          const uint32_t* end_u = pair.neighbors_i + pair.offsets_i[u + 1];
+          // the neighbors v of u in row block k
+          const uint32_t* v =
+              std::lower_bound(begin_u, end_u, pair.first_vertex_k);
+          for (; v != end_u && *v < pair.last_vertex_k; ++v) {
+            uint64_t local_v = *v - pair.first_vertex_k;
+            const uint32_t* begin_v = pair.neighbors_k + pair.offsets_k[local_v];
+            const uint32_t* end_v =
+                pair.neighbors_k + pair.offsets_k[local_v + 1];
+            // all of N(v) is larger than v, so is the rest of N(u)
+            count_ += TriangleCounter::intersect(v + 1, end_u - (v + 1),
+                                                 begin_v, end_v - begin_v);
+          }
+        }
+      }
+    }
+
+  protected:
+    void run() {
+      while (true) {
+        pthread_barrier_wait(barrier_);
+        if (pair_->done) {
+          return;
+        }
+        countChunks();
+        pthread_barrier_wait(barrier_);
+      }
+    }
+
+  private:
+    tile_pair_t* pair_;
+    pthread_barrier_t* barrier_;
+    uint64_t count_;
+  };
+
+  TriangleCounter::TriangleCounter(uint64_t count_vertices,
+                                   uint64_t vertices_per_block,
+                                   size_t size_resident,
+                                   const std::string& path_to_spill,
+                                   int count_threads)
+      : count_vertices_(count_vertices),
+        vertices_per_block_(vertices_per_block),
+        count_rows_((count_vertices + vertices_per_block - 1) /
+                    vertices_per_block),
+        size_resident_(size_resident), path_to_spill_(path_to_spill),
+        count_threads_(std::max(count_threads, 1)), pending_(count_rows_),
+        count_pending_(0), spilled_(count_rows_, false), size_rows_(0),
+        count_row_loads_(0) {
+    if (count_vertices > UINT32_MAX) {
+      sg_err("Triangle counting supports up to %u vertices, got %lu\n",
+             UINT32_MAX, count_vertices);
+      util::die(1);
+    }
+  }
+
+  TriangleCounter::~TriangleCounter() {
+    for (auto& row : rows_) {
+      delete row.second;
+    }
+    for (uint64_t row = 0; row < count_rows_; ++row) {
+      if (spilled_[row]) {
+        unlink(getSpillFileName(row).c_str());
+      }
+    }
+  }
+
+  std::string TriangleCounter::getSpillFileName(uint64_t row) const {
+    std::stringstream ss;
+    ss << path_to_spill_ << "triangles-row-" << row << ".dat";
+    return ss.str();
+  }
+
+  void TriangleCounter::addEdge(uint64_t src, uint64_t tgt) {
+    if (src == tgt) {
+      return;
+    }
+    edge_t edge = {std::min(src, tgt), std::max(src, tgt)};
+    if (edge.tgt >= count_vertices_) {
+      sg_err("Edge (%lu, %lu) is out of range\n", src, tgt);
+      util::die(1);
+    }
+    uint64_t row = edge.src / vertices_per_block_;
+    pending_[row].push_back(edge);
+    ++count_pending_;
+
+    if (pending_[row].size() >= COUNT_SPILL_BATCH) {
+      flushRow(row);
+    } else if (count_pending_ * sizeof(edge_t) > size_resident_) {
+      for (uint64_t i = 0; i < count_rows_; ++i) {
+        flushRow(i);
+      }
+    }
+  }
+
+  void TriangleCounter::flushRow(uint64_t row) {
+    std::vector<edge_t>& edges = pending_[row];
+    if (edges.empty()) {
+      return;
+    }
+    util::appendDataToFile(getSpillFileName(row), edges.data(),
+                           sizeof(edge_t) * edges.size());
+    spilled_[row] = true;
+    count_pending_ -= edges.size();
+    std::vector<edge_t>().swap(edges);
+  }
+
+  void TriangleCounter::addTiles(const config_t& config,
+                                 const scenario_stats_t& stats) {
+    bool is_index_32_bits = stats.is_index_32_bits;
+    for (size_t i = 0; i < config.paths_to_tile.size(); ++i) {
+      std::string container_file_name = getTileContainerFileName(config, i);
+      if (!TileContainer::exists(container_file_name)) {
+        sg_err("Tile container %s missing, triangle counting requires the "
+               "graph to be packed by post-grc-packer\n",
+               container_file_name.c_str());
+        util::die(1);
+      }
+
+      // base tiles, without the deleted edges, then the delta tiles
+      TileContainer base_container;
+      base_container.open(container_file_name);
+      std::vector<tile_stats_t> tile_stats(base_container.countTiles());
+      base_container.copyTileStats(tile_stats.data());
+      TileTombstones tombstones;
+      std::string tombstones_file_name = getTileTombstonesFileName(config, i);
+      if (TileTombstones::exists(tombstones_file_name)) {
+        tombstones.open(tombstones_file_name, tile_stats.data(),
+                        tile_stats.size());
+      }
+      TileContainer delta_container;
+      std::string delta_file_name = getDeltaTileContainerFileName(config, i);
+      if (TileContainer::exists(delta_file_name)) {
+        delta_container.open(delta_file_name);
+      }
+
+      for (const TileContainer* container :
+           {&base_container, &delta_container}) {
+        for (size_t j = 0; j < container->countTiles(); ++j) {
+          const tile_container_entry_t& entry = container->entry(j);
+          const tile_stats_t& tile_stats = entry.stats;
+          const char* mask =
+              container == &base_container ? tombstones.getMask(j) : NULL;
+
+          edge_block_index_t* index =
+              (edge_block_index_t*)malloc(entry.size_index);
+          container->readEdgeBlockIndex(j, index);
+          edge_block_t* block = (edge_block_t*)malloc(entry.size_edge_block);
+          container->readEdgeBlock(j, block);
+
+          uint32_t* src_index =
+              get_array(uint32_t*, index, index->offset_src_index);
+          uint32_t* tgt_index =
+              get_array(uint32_t*, index, index->offset_tgt_index);
+          char* src_upper_bits =
+              get_array(char*, index, index->offset_src_index_bit_extension);
+          char* tgt_upper_bits =
+              get_array(char*, index, index->offset_tgt_index_bit_extension);
+          auto add = [&](uint32_t edge_id, local_vertex_id_t src,
+                         local_vertex_id_t tgt) {
+            if (mask != NULL && eval_bool_array(mask, edge_id)) {
+              return;
+            }
+            uint64_t src_id = src_index[src];
+            uint64_t tgt_id = tgt_index[tgt];
+            if (!is_index_32_bits) {
+              src_id |= (uint64_t)eval_bool_array(src_upper_bits, src) << 32;
+              tgt_id |= (uint64_t)eval_bool_array(tgt_upper_bits, tgt) << 32;
+            }
+            addEdge(src_id, tgt_id);
+          };
+
+          uint32_t count_edges = tile_stats.count_edges;
+          local_vertex_id_t* src_block =
+              get_array(local_vertex_id_t*, block, block->offset_src);
+          if (tile_stats.encoding == TileEncoding::TE_Bitmap) {
+            for_each_bitmap_edge(
+                get_array(uint64_t*, block, block->offset_src),
+                get_array(uint32_t*, block, block->offset_tgt),
+                tile_stats.count_vertex_tgt,
+                BITMAP_WORDS_PER_ROW(tile_stats.count_vertex_src), 0,
+                count_edges, add);
+          } else if (tile_stats.encoding == TileEncoding::TE_RLE) {
+            vertex_count_t* tgt_block_rle =
+                get_array(vertex_count_t*, block, block->offset_tgt);
+            uint32_t edge_id = 0;
+            for (size_t k = 0; edge_id < count_edges; ++k) {
+              // a count of 0 wraps around, all 65536 sources
+              size_t count = tgt_block_rle[k].count == 0
+                                 ? MAX_VERTICES_PER_TILE
+                                 : tgt_block_rle[k].count;
+              for (size_t l = 0; l < count; ++l, ++edge_id) {
+                add(edge_id, src_block[edge_id], tgt_block_rle[k].id);
+              }
+            }
+          } else {
+            local_vertex_id_t* tgt_block =
+                get_array(local_vertex_id_t*, block, block->offset_tgt);
+            for (uint32_t edge_id = 0; edge_id < count_edges; ++edge_id) {
+              add(edge_id, src_block[edge_id], tgt_block[edge_id]);
+            }
+          }
+          free(block);
+          free(index);
+        }
+      }
+    }
+  }
+
+  size_t TriangleCounter::sizeRow(const Row& row) {
+    return sizeof(uint64_t) * row.offsets.size() +
+           sizeof(uint32_t) * row.neighbors.size();
+  }
+
+  const TriangleCounter::Row* TriangleCounter::getRow(uint64_t row,
+                                                      uint64_t pinned_row) {
+    auto it = rows_.find(row);
+    if (it != rows_.end()) {
+      recently_used_.erase(
+          std::find(recently_used_.begin(), recently_used_.end(), row));
+      recently_used_.push_back(row);
+      return it->second;
+    }
+
+    std::vector<edge_t> edges;
+    if (spilled_[row]) {
+      std::string file_name = getSpillFileName(row);
+      edges.resize(util::getFileSize(file_name) / sizeof(edge_t));
+      util::readDataFromFile(file_name, sizeof(edge_t) * edges.size(),
+                             edges.data());
+    }
+    edges.insert(edges.end(), pending_[row].begin(), pending_[row].end());
+    std::sort(edges.begin(), edges.end(), lessEdge);
+    edges.erase(std::unique(edges.begin(), edges.end(), equalEdge),
+                edges.end());
+
+    Row* result = new Row();
+    result->first_vertex = row * vertices_per_block_;
+    uint64_t count_vertices = std::min(vertices_per_block_,
+                                       count_vertices_ - result->first_vertex);
+    result->offsets.resize(count_vertices + 1, 0);
+    result->neighbors.resize(edges.size());
+    for (size_t i = 0; i < edges.size(); ++i) {
+      ++result->offsets[edges[i].src - result->first_vertex + 1];
+      result->neighbors[i] = (uint32_t)edges[i].tgt;
+    }
+    for (uint64_t i = 0; i < count_vertices; ++i) {
+      result->offsets[i + 1] += result->offsets[i];
+    }
+
+    ++count_row_loads_;
+    rows_[row] = result;
+    recently_used_.push_back(row);
+    size_rows_ += sizeRow(*result);
+    evictRows(pinned_row, row);
+    return result;
+  }
+
+  void TriangleCounter::evictRows(uint64_t pinned_row, uint64_t loaded_row) {
+    // Rows before the pinned one are never needed again. Otherwise the rows
+    // k are scanned in ascending order once per row i, the most recently
+    // used row is the one needed furthest in the future.
+    while (size_rows_ > size_resident_) {
+      auto victim = recently_used_.end();
+      for (auto it = recently_used_.begin(); it != recently_used_.end(); ++it) {
+        if (*it < pinned_row) {
+          victim = it;
+          break;
+        }
+        if (*it != pinned_row && *it != loaded_row) {
+          victim = it;
+        }
+      }
+      if (victim == recently_used_.end()) {
+        return;
+      }
+      Row* row = rows_[*victim];
+      size_rows_ -= sizeRow(*row);
+      delete row;
+      rows_.erase(*victim);
+      recently_used_.erase(victim);
+    }
+  }
+
+  uint64_t TriangleCounter::count() {
+    count_row_loads_ = 0;
+
+    // The calling thread loads the rows and counts along with the workers,
+    // which live until all tile pairs are done.
+    tile_pair_t pair;
+    pair.done = false;
+    pthread_barrier_t barrier;
+    pthread_barrier_init(&barrier, NULL, count_threads_);
+    std::vector<TriangleWorker*> workers;
+    for (int t = 0; t < count_threads_; ++t) {
+      workers.push_back(new TriangleWorker(&pair, &barrier));
+    }
+    for (int t = 1; t < count_threads_; ++t) {
+      workers[t]->start();
+      workers[t]->setName("TriangleWorker_" + std::to_string(t));
+    }
+
+    for (uint64_t i = 0; i < count_rows_; ++i) {
+      const Row* row_i = getRow(i, i);
+
+      // skip the rows k without edges in tile pair (i, k)
+      std::vector<bool> has_tile(count_rows_, false);
+      for (uint32_t v : row_i->neighbors) {
+        has_tile[v / vertices_per_block_] = true;
+      }
+
+      for (uint64_t k = i; k < count_rows_; ++k) {
+        if (!has_tile[k]) {
+          continue;
+        }
+        const Row* row_k = getRow(k, i);
+        pair.offsets_i = row_i->offsets.data();
+        pair.neighbors_i = row_i->neighbors.data();
+        pair.count_vertices_i = row_i->offsets.size() - 1;
+        pair.offsets_k = row_k->offsets.data();
+        pair.neighbors_k = row_k->neighbors.data();
+        pair.first_vertex_k = row_k->first_vertex;
+        pair.last_vertex_k = row_k->first_vertex + row_k->offsets.size() - 1;
+        pair.count_chunks =
+            (pair.count_vertices_i + COUNT_VERTICES_CHUNK - 1) /
+            COUNT_VERTICES_CHUNK;
+        pair.next_chunk = 0;
+
+        // the rows stay put until all workers are done with the tile pair
+        pthread_barrier_wait(&barrier);
+        workers[0]->countChunks();
+        pthread_barrier_wait(&barrier);
+      }
+    }
+
+    pair.done = true;
+    pthread_barrier_wait(&barrier);
+    uint64_t count = 0;
+    for (int t = 0; t < count_threads_; ++t) {
+      if (t > 0) {
+        workers[t]->join();
+      }
+      count += workers[t]->count();
+      delete workers[t];
+    }
+    pthread_barrier_destroy(&barrier);
+    return count;
+  }
+
+  size_t TriangleCounter::intersect(const uint32_t* a, size_t size_a,
+                                    const uint32_t* b, size_t size_b) {
+    if (size_a > size_b) {
+      std::swap(a, b);
+      std::swap(size_a, size_b);
+    }
+    size_t count = 0;
+    size_t i = 0;
+    size_t j = 0;
+
+    // very different lengths, search the short list in the long one
+    if (size_a * 32 < size_b) {
+      for (; i < size_a; ++i) {
+        const uint32_t* it = std::lower_bound(b + j, b + size_b, a[i]);
+        j = it - b;
+        if (j == size_b) {
+          break;
+        }
+        count += *it == a[i] ? 1 : 0;
+      }
+      return count;
+    }
+
+#ifdef __SSE2__
+    // Compares blocks of four against each other in all four rotations,
+    // every element matches at most once since the lists are strictly
+    // ascending. The block with the smaller maximum is done afterwards.
+    while (i + 4 <= size_a && j + 4 <= size_b) {
+      __m128i block_a = _mm_loadu_si128((const __m128i*)(a + i));
+      __m128i block_b = _mm_loadu_si128((const __m128i*)(b + j));
+      __m128i matches = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi32(block_a, block_b),
+                       _mm_cmpeq_epi32(block_a,
+                                       _mm_shuffle_epi32(block_b, 0x39))),
+          _mm_or_si128(
+              _mm_cmpeq_epi32(block_a, _mm_shuffle_epi32(block_b, 0x4e)),
+              _mm_cmpeq_epi32(block_a, _mm_shuffle_epi32(block_b, 0x93))));
+      count +=
+          __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(matches)));
+      uint32_t max_a = a[i + 3];
+      uint32_t max_b = b[j + 3];
+      i += max_a <= max_b ? 4 : 0;
+      j += max_b <= max_a ? 4 : 0;
+    }
+#endif
+
+    while (i < size_a && j < size_b) {
+      if (a[i] < b[j]) {
+        ++i;
+      } else if (b[j] < a[i]) {
+        ++j;
+      } else {
+        ++count;
+        ++i;
+        ++j;
+      }
+    }
+    return count;
+  }
+}
+}
@@ -1,9 +1,11 @@
 #include <core/util.h>
+#include <core/tile-container.h>
 
 #include <sstream>
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <iterator>
 #include <algorithm>
 #include <stdio.h>
 #include <string.h>
@@ -129,6 +131,16 @@ namespace core {
     return getVertexToTileIndexFileName(config.path_to_globals);
   }
 
+  std::string
+  getTransposedVertexToTileCountFileName(const std::string& path_to_global) {
+    return path_to_global + "vertex_to_tile_count_transposed.dat";
+  }
+
+  std::string
+  getTransposedVertexToTileIndexFileName(const std::string& path_to_global) {
+    return path_to_global + "vertex_to_tile_index_transposed.dat";
+  }
+
   std::string getGlobalTileStatsFileName(const std::string& path_to_meta) {
     return path_to_meta + "tile_stats.dat";
   }
@@ -196,6 +208,43 @@ namespace core {
     return config.paths_to_meta[meta_index] + "meta.dat";
   }
 
+  std::string getTileContainerFileName(const std::string& path_to_tile) {
+    return path_to_tile + "tiles.mtc";
+  }
+
+  std::string getTileContainerFileName(const config_t& config,
+                                       int meta_index) {
+    return getTileContainerFileName(config.paths_to_tile[meta_index]);
+  }
+
+  std::string getDeltaTileContainerFileName(const std::string& path_to_tile) {
+    return path_to_tile + "tiles-delta.mtc";
+  }
+
+  std::string getDeltaTileContainerFileName(const config_t& config,
+                                            int meta_index) {
+    return getDeltaTileContainerFileName(config.paths_to_tile[meta_index]);
+  }
+
+  std::string getTileTombstonesFileName(const std::string& path_to_tile) {
+    return path_to_tile + "tiles-tombstones.dat";
+  }
+
+  std::string getTileTombstonesFileName(const config_t& config,
+                                        int meta_index) {
+    return getTileTombstonesFileName(config.paths_to_tile[meta_index]);
+  }
+
+  std::string
+  getTransposedTileContainerFileName(const std::string& path_to_tile) {
+    return path_to_tile + "tiles-transposed.mtc";
+  }
+
+  std::string getTransposedTileContainerFileName(const config_t& config,
+                                                 int meta_index) {
+    return getTransposedTileContainerFileName(config.paths_to_tile[meta_index]);
+  }
+
   std::string getResultFileName(const std::string& path_to_output,
                                 int iteration) {
     std::stringstream ss;
@@ -368,6 +417,81 @@ namespace core {
     return (MAX_EDGES_PER_TILE_IN_MEMORY * PARTITIONS_PER_SPARSE_FILE);
   }
 
+  size_t getSizeEdgeSrcBlock(const tile_stats_t& tile_stats) {
+    if (tile_stats.encoding == TileEncoding::TE_Bitmap) {
+      return sizeof(uint64_t) * tile_stats.count_vertex_tgt *
+             BITMAP_WORDS_PER_ROW(tile_stats.count_vertex_src);
+    }
+    return sizeof(local_vertex_id_t) * tile_stats.count_edges;
+  }
+
+  size_t getSizeEdgeTgtBlock(const tile_stats_t& tile_stats) {
+    switch (tile_stats.encoding) {
+    case TileEncoding::TE_RLE:
+      // if using rle, take the tgt-block as the size times the
+      // vertex-count-struct
+      return sizeof(vertex_count_t) * tile_stats.count_vertex_tgt;
+    case TileEncoding::TE_Bitmap:
+      return sizeof(uint32_t) * tile_stats.count_vertex_tgt;
+    default:
+      return sizeof(local_vertex_id_t) * tile_stats.count_edges;
+    }
+  }
+
+  size_t getSizeEdgeBlock(const tile_stats_t& tile_stats, bool is_weighted) {
+    // only include weight-block if necessary
+    size_t size_edge_weights_block =
+        is_weighted ? sizeof(float) * tile_stats.count_edges : 0;
+
+    return sizeof(edge_block_t) + getSizeEdgeSrcBlock(tile_stats) +
+           getSizeEdgeTgtBlock(tile_stats) + size_edge_weights_block;
+  }
+
+  TileEncoding chooseTileEncoding(uint32_t count_edges,
+                                  uint32_t count_vertex_src,
+                                  uint32_t count_vertex_tgt, bool use_rle,
+                                  bool use_bitmap) {
+    tile_stats_t tile_stats;
+    tile_stats.count_edges = count_edges;
+    tile_stats.count_vertex_src = count_vertex_src;
+    tile_stats.count_vertex_tgt = count_vertex_tgt;
+    tile_stats.encoding = TileEncoding::TE_List;
+    if (count_edges == 0) {
+      return TileEncoding::TE_List;
+    }
+
+    TileEncoding best = TileEncoding::TE_List;
+    size_t size_best = getSizeEdgeBlock(tile_stats, false);
+
+    // RLE on ties, as the tiler always did for an edge-count of exactly
+    // 2-times the tgt-count
+    tile_stats.encoding = TileEncoding::TE_RLE;
+    if (use_rle && getSizeEdgeBlock(tile_stats, false) <= size_best) {
+      best = TileEncoding::TE_RLE;
+      size_best = getSizeEdgeBlock(tile_stats, false);
+    }
+
+    tile_stats.encoding = TileEncoding::TE_Bitmap;
+    if (use_bitmap && getSizeEdgeBlock(tile_stats, false) < size_best) {
+      best = TileEncoding::TE_Bitmap;
+    }
+    return best;
+  }
+
+  size_t getSizeEdgeBlockIndex(const tile_stats_t& tile_stats,
+                               bool is_index_32_bits) {
+    size_t size_edge_index_src_extended_block =
+        is_index_32_bits ? 0 : size_bool_array(tile_stats.count_vertex_src);
+    size_t size_edge_index_tgt_extended_block =
+        is_index_32_bits ? 0 : size_bool_array(tile_stats.count_vertex_tgt);
+
+    return sizeof(edge_block_index_t) +
+           sizeof(uint32_t) * tile_stats.count_vertex_src +
+           sizeof(uint32_t) * tile_stats.count_vertex_tgt +
+           size_edge_index_src_extended_block +
+           size_edge_index_tgt_extended_block;
+  }
+
   size_t getSizeTileBlock(const vertex_edge_tiles_block_sizes_t& sizes) {
     return sizeof(vertex_edge_tiles_block_t) +
            sizes.size_active_vertex_src_block +
@@ -376,6 +500,221 @@ namespace core {
            sizes.size_extension_fields_vertex_block;
   }
 
+  void readEdgeListFile(const std::string& file_name,
+                        std::vector<edge_t>* edges) {
+    uint64_t size = util::getFileSize(file_name);
+    if (size % sizeof(edge_t) != 0) {
+      sg_err("File %s does not contain a list of edges\n", file_name.c_str());
+      util::die(1);
+    }
+    edges->resize(size / sizeof(edge_t));
+    util::readDataFromFile(file_name, size, edges->data());
+  }
+
+  void parseVertexList(const std::string& list, std::vector<uint64_t>* ids) {
+    if (!tryParseVertexList(list, ids)) {
+      sg_err("Not a list of vertex ids: %s\n", list.c_str());
+      util::die(1);
+    }
+  }
+
+  bool tryParseVertexList(const std::string& list,
+                          std::vector<uint64_t>* ids) {
+    const char* separators = ", \t\r\n";
+    size_t start = list.find_first_not_of(separators);
+    while (start != std::string::npos) {
+      size_t end = list.find_first_of(separators, start);
+      std::string token = list.substr(start, end - start);
+      if (token.find_first_not_of("0123456789") != std::string::npos ||
+          token.size() > 19) {
+        return false;
+      }
+      ids->push_back(std::stoull(token));
+      start = list.find_first_not_of(separators, end);
+    }
+    return true;
+  }
+
+  bool parseQuery(const std::string& line, query_t* query,
+                  std::string* error) {
+    std::istringstream stream(line);
+    query->roots.clear();
+    query->max_iterations = 0;
+    query->path_to_output.clear();
+    if (!(stream >> query->algorithm)) {
+      *error = "missing algorithm";
+      return false;
+    }
+
+    std::string token;
+    while (stream >> token) {
+      size_t pos = token.find('=');
+      if (pos == std::string::npos) {
+        *error = "expected key=value, got " + token;
+        return false;
+      }
+      std::string key = token.substr(0, pos);
+      std::string value = token.substr(pos + 1);
+      if (key == "roots") {
+        if (!tryParseVertexList(value, &query->roots)) {
+          *error = "not a list of vertex ids: " + value;
+          return false;
+        }
+      } else if (key == "max-iterations") {
+        if (value.empty() ||
+            value.find_first_not_of("0123456789") != std::string::npos ||
+            value.size() > 9 || std::stoi(value) == 0) {
+          *error = "not a positive number: " + value;
+          return false;
+        }
+        query->max_iterations = std::stoi(value);
+      } else if (key == "output") {
+        if (value.empty()) {
+          *error = "empty output file";
+          return false;
+        }
+        query->path_to_output = value;
+      } else {
+        *error = "unknown key " + key;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static void loadResidentTiles(const config_vertex_domain_t& config,
+                                int edge_engine_index,
+                                resident_tiles_t* tiles) {
+    memset(tiles, 0, sizeof(*tiles));
+    std::string tile_container_file_name =
+        getTileContainerFileName(config, edge_engine_index);
+    if (!TileContainer::exists(tile_container_file_name)) {
+      return;
+    }
+    tiles->tile_container = new TileContainer();
+    tiles->tile_container->open(tile_container_file_name);
+
+    std::string delta_tile_container_file_name =
+        getDeltaTileContainerFileName(config, edge_engine_index);
+    if (TileContainer::exists(delta_tile_container_file_name)) {
+      tiles->delta_tile_container = new TileContainer();
+      tiles->delta_tile_container->open(delta_tile_container_file_name);
+    }
+
+    // only needed by some algorithms, the engines check for them
+    std::string transposed_tile_container_file_name =
+        getTransposedTileContainerFileName(config, edge_engine_index);
+    if (TileContainer::exists(transposed_tile_container_file_name)) {
+      tiles->transposed_tile_container = new TileContainer();
+      tiles->transposed_tile_container->open(
+          transposed_tile_container_file_name);
+    }
+
+    std::string tombstones_file_name =
+        getTileTombstonesFileName(config, edge_engine_index);
+    if (TileTombstones::exists(tombstones_file_name)) {
+      size_t count_base_tiles = tiles->tile_container->countTiles();
+      tile_stats_t* tile_stats = new tile_stats_t[count_base_tiles];
+      tiles->tile_container->copyTileStats(tile_stats);
+      tiles->tile_tombstones = new TileTombstones();
+      tiles->tile_tombstones->open(tombstones_file_name, tile_stats,
+                                   count_base_tiles);
+      delete[] tile_stats;
+    }
+
+    // verified here only, the queries find the containers mapped already
+    if (config.in_memory_mode) {
+      for (TileContainer* container :
+           {tiles->tile_container, tiles->delta_tile_container,
+            tiles->transposed_tile_container}) {
+        if (container != NULL) {
+          container->map();
+          if (config.verify_tiles) {
+            container->verify();
+          }
+        }
+      }
+    }
+  }
+
+  void loadResidentGraph(const config_vertex_domain_t& config,
+                         resident_graph_t* graph) {
+    graph->degrees = new vertex_degree_t[config.count_vertices];
+    util::readDataFromFile(getVertexDegreeFileName(config),
+                           sizeof(vertex_degree_t) * config.count_vertices,
+                           graph->degrees);
+
+    memset(graph->tiles, 0, sizeof(graph->tiles));
+    for (int i = 0; i < config.count_edge_processors; ++i) {
+      loadResidentTiles(config, i, &graph->tiles[i]);
+    }
+
+    graph->vertex_to_tiles_offset = NULL;
+    graph->vertex_to_tiles_count = NULL;
+    graph->vertex_to_tiles_index = NULL;
+    if (!config.use_selective_scheduling) {
+      return;
+    }
+    graph->vertex_to_tiles_offset = new size_t[config.count_vertices];
+    graph->vertex_to_tiles_count = new uint32_t[config.count_vertices];
+    util::readDataFromFile(
+        getVertexToTileCountFileName(config.path_to_globals),
+        sizeof(uint32_t) * config.count_vertices,
+        graph->vertex_to_tiles_count);
+
+    size_t count_index = 0;
+    for (size_t i = 0; i < config.count_vertices; ++i) {
+      graph->vertex_to_tiles_offset[i] = count_index;
+      count_index += graph->vertex_to_tiles_count[i];
+    }
+    graph->vertex_to_tiles_index = new uint32_t[count_index];
+    util::readDataFromFile(
+        getVertexToTileIndexFileName(config.path_to_globals),
+        sizeof(uint32_t) * count_index, graph->vertex_to_tiles_index);
+  }
+
+  void freeResidentGraph(resident_graph_t* graph) {
+    delete[] graph->degrees;
+    delete[] graph->vertex_to_tiles_offset;
+    delete[] graph->vertex_to_tiles_count;
+    delete[] graph->vertex_to_tiles_index;
+    for (int i = 0; i < MAX_EDGE_ENGINES; ++i) {
+      delete graph->tiles[i].tile_container;
+      delete graph->tiles[i].delta_tile_container;
+      delete graph->tiles[i].tile_tombstones;
+      delete graph->tiles[i].transposed_tile_container;
+    }
+  }
+
+  void readVertexListFile(const std::string& file_name,
+                          std::vector<uint64_t>* ids) {
+    std::ifstream stream(file_name.c_str());
+    if (!stream.good()) {
+      sg_err("Could not open %s\n", file_name.c_str());
+      util::die(1);
+    }
+    std::string content((std::istreambuf_iterator<char>(stream)),
+                        std::istreambuf_iterator<char>());
+    parseVertexList(content, ids);
+  }
+
+  void readFeatureFile(const std::string& file_name,
+                       std::vector<float>* features) {
+    std::ifstream stream(file_name.c_str());
+    if (!stream.good()) {
+      sg_err("Could not open %s\n", file_name.c_str());
+      util::die(1);
+    }
+    float feature;
+    while (stream >> feature) {
+      features->push_back(feature);
+    }
+    if (!stream.eof()) {
+      sg_err("Not a list of features: %s\n", file_name.c_str());
+      util::die(1);
+    }
+  }
+
   void fillTileBlockHeader(vertex_edge_tiles_block_t* tile_block,
                            uint64_t block_id, const tile_stats_t& tile_stats,
                            const vertex_edge_tiles_block_sizes_t& sizes,
@@ -0,0 +1,231 @@
+#include <util/metrics-exporter.h>
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+
+#include <util/util.h>
+
+namespace scalable_graphs {
+namespace util {
+
+  // How often the exporter checks for stop().
+  static const int POLL_TIMEOUT_MS = 100;
+
+  // A client has this long to send its request.
+  static const int REQUEST_TIMEOUT_SEC = 1;
+
+  static const size_t MAX_REQUEST_SIZE = 4096;
+
+  void PrometheusText::addSample(const std::string& name, const char* type,
+                                 const std::string& help,
+                                 const std::string& labels, double value) {
+    auto it = families_.find(name);
+    if (it == families_.end()) {
+      names_.push_back(name);
+      it = families_.insert({name, family_t{type, help, ""}}).first;
+    }
+
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), " %.15g\n", value);
+    family_t& family = it->second;
+    family.samples += name;
+    if (!labels.empty()) {
+      family.samples += "{" + labels + "}";
+    }
+    family.samples += buffer;
+  }
+
+  void PrometheusText::addCounter(const std::string& name,
+                                  const std::string& help,
+                                  const std::string& labels, double value) {
+    addSample(name, "counter", help, labels, value);
+  }
+
+  void PrometheusText::addGauge(const std::string& name,
+                                const std::string& help,
+                                const std::string& labels, double value) {
+    addSample(name, "gauge", help, labels, value);
+  }
+
+  std::string PrometheusText::toString() const {
+    std::string text;
+    for (const auto& name : names_) {
+      const family_t& family = families_.at(name);
+      text += "# HELP " + name + " " + family.help + "\n";
+      text += "# TYPE " + name + " " + family.type + "\n";
+      text += family.samples;
+    }
+    return text;
+  }
+
+  MetricsExporter* MetricsExporter::instance = nullptr;
+
+  MetricsExporter* MetricsExporter::getInstance(const std::string& address) {
+    static std::mutex instance_mutex;
+    std::lock_guard<std::mutex> lock(instance_mutex);
+    if (MetricsExporter::instance == nullptr) {
+      MetricsExporter::instance = new MetricsExporter(address);
+      MetricsExporter::instance->start();
+      MetricsExporter::instance->setName("MetricsExporter");
+    } else if (MetricsExporter::instance->address_ != address) {
+      sg_log("Metrics are exported on %s already, not on %s\n",
+             MetricsExporter::instance->address_.c_str(), address.c_str());
+    }
+    return MetricsExporter::instance;
+  }
+
+  MetricsExporter::MetricsExporter(const std::string& address)
+      : address_(address), is_unix_socket_(false), fd_(-1), stop_(false),
+        next_source_id_(0) {
+    listenOn();
+  }
+
+  void MetricsExporter::listenOn() {
+    is_unix_socket_ =
+        address_.find_first_not_of("0123456789") != std::string::npos;
+
+    if (is_unix_socket_) {
+      struct sockaddr_un address;
+      memset(&address, 0, sizeof(address));
+      address.sun_family = AF_UNIX;
+      if (address_.size() >= sizeof(address.sun_path)) {
+        sg_err("Socket path too long: %s\n", address_.c_str());
+        util::die(1);
+      }
+      strncpy(address.sun_path, address_.c_str(), sizeof(address.sun_path) - 1);
+
+      fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+      unlink(address_.c_str());
+      if (fd_ < 0 ||
+          bind(fd_, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        sg_err("Could not bind to %s: %s\n", address_.c_str(),
+               strerror(errno));
+        util::die(1);
+      }
+    } else {
+      // Loopback only, the metrics are not meant to leave the machine.
+      struct sockaddr_in address;
+      memset(&address, 0, sizeof(address));
+      address.sin_family = AF_INET;
+      address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      address.sin_port = htons(std::stoi(address_));
+
+      fd_ = socket(AF_INET, SOCK_STREAM, 0);
+      int reuse = 1;
+      if (fd_ < 0 ||
+          setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) !=
+              0 ||
+          bind(fd_, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        sg_err("Could not bind to 127.0.0.1:%s: %s\n", address_.c_str(),
+               strerror(errno));
+        util::die(1);
+      }
+    }
+
+    if (listen(fd_, 8) != 0) {
+      sg_err("Could not listen on %s: %s\n", address_.c_str(),
+             strerror(errno));
+      util::die(1);
+    }
+    // a scraper going away while we answer must not take the engine down
+    signal(SIGPIPE, SIG_IGN);
+    sg_log("Exporting metrics on %s\n", address_.c_str());
+  }
+
+  int MetricsExporter::addSource(const source_t& source) {
+    std::lock_guard<std::mutex> lock(sources_mutex_);
+    int id = next_source_id_++;
+    sources_[id] = source;
+    return id;
+  }
+
+  void MetricsExporter::removeSource(int id) {
+    std::lock_guard<std::mutex> lock(sources_mutex_);
+    sources_.erase(id);
+  }
+
+  std::string MetricsExporter::scrape() {
+    PrometheusText text;
+    std::lock_guard<std::mutex> lock(sources_mutex_);
+    for (const auto& it : sources_) {
+      it.second(&text);
+    }
+    return text.toString();
+  }
+
+  void MetricsExporter::stop() { stop_ = true; }
+
+  void MetricsExporter::run() {
+    struct pollfd listener;
+    listener.fd = fd_;
+    listener.events = POLLIN;
+
+    while (!stop_) {
+      int rc = poll(&listener, 1, POLL_TIMEOUT_MS);
+      if (rc <= 0) {
+        continue;
+      }
+      int client = accept(fd_, NULL, NULL);
+      if (client < 0) {
+        continue;
+      }
+      serve(client);
+      close(client);
+    }
+
+    close(fd_);
+    if (is_unix_socket_) {
+      unlink(address_.c_str());
+    }
+  }
+
+  void MetricsExporter::serve(int client) {
+    struct timeval timeout;
+    timeout.tv_sec = REQUEST_TIMEOUT_SEC;
+    timeout.tv_usec = 0;
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    // Read up to the end of the request header, the body is ignored.
+    std::string request;
+    char buffer[512];
+    while (request.size() < MAX_REQUEST_SIZE &&
+           request.find("\r\n\r\n") == std::string::npos) {
+      ssize_t count = read(client, buffer, sizeof(buffer));
+      if (count <= 0) {
+        break;
+      }
+      request.append(buffer, count);
+    }
+
+    std::string response;
+    if (request.compare(0, 4, "GET ") == 0) {
+      std::string body = scrape();
+      response = "HTTP/1.0 200 OK\r\n"
+                 "Content-Type: text/plain; version=0.0.4\r\n"
+                 "Content-Length: " +
+                 std::to_string(body.size()) + "\r\n\r\n" + body;
+    } else {
+      response = "HTTP/1.0 400 Bad Request\r\nContent-Length: 0\r\n\r\n";
+    }
+
+    size_t written = 0;
+    while (written < response.size()) {
+      ssize_t count = write(client, response.data() + written,
+                            response.size() - written);
+      if (count <= 0) {
+        break;
+      }
+      written += count;
+    }
+  }
+}
+}
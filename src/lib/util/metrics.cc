@@ -0,0 +1,98 @@
+#include <util/metrics.h>
+
+#include <errno.h>
+#include <string.h>
+#include <cmath>
+
+#include <util/util.h>
+
+namespace scalable_graphs {
+namespace util {
+
+  static std::string quoteJson(const std::string& value) {
+    std::string quoted = "\"";
+    for (char c : value) {
+      if (c == '"' || c == '\\') {
+        quoted += '\\';
+      }
+      quoted += c;
+    }
+    quoted += "\"";
+    return quoted;
+  }
+
+  void MetricsRecord::addField(const std::string& key,
+                               const std::string& json_value) {
+    if (!fields_.empty()) {
+      fields_ += ", ";
+    }
+    fields_ += quoteJson(key) + ": " + json_value;
+  }
+
+  void MetricsRecord::addCount(const std::string& key, uint64_t value) {
+    addField(key, std::to_string(value));
+  }
+
+  void MetricsRecord::addValue(const std::string& key, double value) {
+    // JSON has no inf and nan, e.g. for the residual of a diverging run
+    if (!std::isfinite(value)) {
+      addField(key, "null");
+      return;
+    }
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.6g", value);
+    addField(key, buffer);
+  }
+
+  void MetricsRecord::addString(const std::string& key,
+                                const std::string& value) {
+    addField(key, quoteJson(value));
+  }
+
+  void MetricsRecord::addRecord(const std::string& key,
+                                const MetricsRecord& value) {
+    addField(key, value.toJson());
+  }
+
+  void MetricsRecord::addRecords(const std::string& key,
+                                 const std::vector<MetricsRecord>& values) {
+    std::string array = "[";
+    for (size_t i = 0; i < values.size(); ++i) {
+      if (i > 0) {
+        array += ", ";
+      }
+      array += values[i].toJson();
+    }
+    array += "]";
+    addField(key, array);
+  }
+
+  std::string MetricsRecord::toJson() const { return "{" + fields_ + "}"; }
+
+  MetricsWriter::MetricsWriter() : file_(NULL) {}
+
+  MetricsWriter::~MetricsWriter() {
+    if (file_) {
+      fclose(file_);
+    }
+  }
+
+  void MetricsWriter::open(const std::string& file_name) {
+    file_ = fopen(file_name.c_str(), "w");
+    if (!file_) {
+      sg_err("File %s couldn't be written: %s\n", file_name.c_str(),
+             strerror(errno));
+      util::die(1);
+    }
+  }
+
+  bool MetricsWriter::isOpen() const { return file_ != NULL; }
+
+  void MetricsWriter::write(const MetricsRecord& record) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    fprintf(file_, "%s\n", record.toJson().c_str());
+    // Keep the records of a crashed run.
+    fflush(file_);
+  }
+}
+}
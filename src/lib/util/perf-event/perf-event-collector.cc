@@ -1,13 +1,19 @@
 #include <util/perf-event/perf-event-collector.h>
 
+#include <unistd.h>
+
+#include <util/perf-event/perf-event-manager.h>
+
 namespace scalable_graphs {
 namespace util {
   namespace perf_event {
 
-    PerfEventCollector::PerfEventCollector(ring_buffer_t* new_event_rb,
+    PerfEventCollector::PerfEventCollector(PerfEventManager* manager,
+                                           ring_buffer_t* new_event_rb,
                                            const config_t& config,
                                            PerfEventMode mode, int id)
-        : new_event_rb_(new_event_rb), config_(config), mode_(mode), id_(id) {}
+        : manager_(manager), new_event_rb_(new_event_rb), config_(config),
+          mode_(mode), id_(id), time_sampled_counters_(0) {}
 
     PerfEventCollector::~PerfEventCollector() {}
 
@@ -15,9 +21,20 @@ namespace util {
       FILE* file = initFileProfilingData(config_, mode_, id_);
 
       while (true) {
+        size_t count_drained = manager_->drainTraceBuffers(file);
+        if (manager_->isCountingEnabled()) {
+          sampleCounters(file);
+        }
+
         ring_buffer_req_t req_event;
-        ring_buffer_get_req_init(&req_event, BLOCKING);
-        ring_buffer_get(new_event_rb_, &req_event);
+        ring_buffer_get_req_init(&req_event, NON_BLOCKING);
+        int rc = ring_buffer_get(new_event_rb_, &req_event);
+        if (rc == -EAGAIN) {
+          if (count_drained == 0) {
+            usleep(drain_timeout_us);
+          }
+          continue;
+        }
         sg_rb_check(&req_event);
 
         profiling_transport_t* transport =
@@ -28,18 +45,37 @@ namespace util {
           break;
         }
 
-        if (transport->data.type == ProfilingType::PT_Duration) {
-          writeProfilingDuration(transport->data, file);
-        } else if (transport->data.type == ProfilingType::PT_RingbufferSizes) {
+        if (transport->data.type == ProfilingType::PT_RingbufferSizes) {
           writeRingBufferSizes(transport->data, file);
         }
 
         ring_buffer_elm_set_done(new_event_rb_, req_event.data);
       }
 
+      // Write the events traced until the shutdown.
+      manager_->drainTraceBuffers(file);
+
       sg_dbg("Shutting down EventCollector %d\n", id_);
       fclose(file);
     }
+
+    void PerfEventCollector::sampleCounters(FILE* file) {
+      uint64_t time = get_time_nsec();
+      if (time - time_sampled_counters_ < counter_sample_timeout_ns) {
+        return;
+      }
+      time_sampled_counters_ = time;
+
+      std::map<ComponentType, profiling_counters_t> counters;
+      manager_->readCounters(&counters);
+      for (auto& it : counters) {
+        profiling_counters_t diff;
+        profiling_counters_t& previous = sampled_counters_[it.first];
+        diffPerfCounterValues(it.second, previous, &diff);
+        previous = it.second;
+        writePerfCounters(it.first, time, diff, file);
+      }
+    }
   }
 }
 }
@@ -0,0 +1,180 @@
+#include <util/perf-event/perf-event-counters.h>
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+
+#include <util/util.h>
+
+namespace scalable_graphs {
+namespace util {
+  namespace perf_event {
+
+    static int perfEventOpen(struct perf_event_attr* attr, int group_fd) {
+      // Count the calling thread on any CPU.
+      return syscall(SYS_perf_event_open, attr, 0, -1, group_fd, 0);
+    }
+
+    static uint64_t getHardwareCacheConfig(uint64_t cache, uint64_t op,
+                                           uint64_t result) {
+      return cache | (op << 8) | (result << 16);
+    }
+
+    static void initPerfEventAttr(PerfCounter counter,
+                                  struct perf_event_attr* attr) {
+      memset(attr, 0, sizeof(struct perf_event_attr));
+      attr->size = sizeof(struct perf_event_attr);
+      // User space only, works with perf_event_paranoid up to 2.
+      attr->exclude_kernel = 1;
+      attr->exclude_hv = 1;
+      attr->read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                          PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+      switch (counter) {
+      case PerfCounter::PC_Cycles:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+      case PerfCounter::PC_Instructions:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+      case PerfCounter::PC_LLCMisses:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+      case PerfCounter::PC_DTLBMisses:
+        attr->type = PERF_TYPE_HW_CACHE;
+        attr->config = getHardwareCacheConfig(PERF_COUNT_HW_CACHE_DTLB,
+                                              PERF_COUNT_HW_CACHE_OP_READ,
+                                              PERF_COUNT_HW_CACHE_RESULT_MISS);
+        break;
+      case PerfCounter::PC_NodeLoads:
+        attr->type = PERF_TYPE_HW_CACHE;
+        attr->config = getHardwareCacheConfig(
+            PERF_COUNT_HW_CACHE_NODE, PERF_COUNT_HW_CACHE_OP_READ,
+            PERF_COUNT_HW_CACHE_RESULT_ACCESS);
+        break;
+      default:
+        break;
+      }
+    }
+
+    const char* getPerfCounterName(PerfCounter counter) {
+      switch (counter) {
+      case PerfCounter::PC_Cycles:
+        return "cycles";
+      case PerfCounter::PC_Instructions:
+        return "instructions";
+      case PerfCounter::PC_LLCMisses:
+        return "llc_misses";
+      case PerfCounter::PC_DTLBMisses:
+        return "dtlb_misses";
+      case PerfCounter::PC_NodeLoads:
+        return "node_loads";
+      default:
+        return "unknown";
+      }
+    }
+
+    void resetPerfCounterValues(profiling_counters_t* values) {
+      for (int i = 0; i < COUNT_PERF_COUNTERS; ++i) {
+        values->values[i] = 0;
+        values->available[i] = false;
+      }
+    }
+
+    void addPerfCounterValues(const profiling_counters_t& from,
+                              profiling_counters_t* to) {
+      for (int i = 0; i < COUNT_PERF_COUNTERS; ++i) {
+        if (from.available[i]) {
+          to->values[i] += from.values[i];
+          to->available[i] = true;
+        }
+      }
+    }
+
+    void diffPerfCounterValues(const profiling_counters_t& current,
+                               const profiling_counters_t& previous,
+                               profiling_counters_t* diff) {
+      for (int i = 0; i < COUNT_PERF_COUNTERS; ++i) {
+        diff->available[i] = current.available[i];
+        diff->values[i] = 0;
+        // Threads may come up between two samples.
+        if (current.available[i] && current.values[i] > previous.values[i]) {
+          diff->values[i] = current.values[i] - previous.values[i];
+        }
+      }
+    }
+
+    PerfCounterGroup::PerfCounterGroup(ComponentType component)
+        : component_(component), count_opened_(0) {
+      for (int i = 0; i < COUNT_PERF_COUNTERS; ++i) {
+        fds_[i] = -1;
+        positions_[i] = -1;
+      }
+
+      // Cycles lead the group, all other counters are scheduled with it.
+      for (int i = 0; i < COUNT_PERF_COUNTERS; ++i) {
+        struct perf_event_attr attr;
+        initPerfEventAttr((PerfCounter)i, &attr);
+        int fd = perfEventOpen(&attr, fds_[0]);
+        if (fd < 0) {
+          if (i == 0) {
+            sg_dbg("Cannot count cycles, leaving counters closed: %s\n",
+                   strerror(errno));
+            return;
+          }
+          continue;
+        }
+        fds_[i] = fd;
+        positions_[i] = count_opened_++;
+      }
+    }
+
+    PerfCounterGroup::~PerfCounterGroup() {
+      // Close the leader last.
+      for (int i = COUNT_PERF_COUNTERS - 1; i >= 0; --i) {
+        if (fds_[i] >= 0) {
+          close(fds_[i]);
+        }
+      }
+    }
+
+    bool PerfCounterGroup::isOpen() const { return count_opened_ > 0; }
+
+    ComponentType PerfCounterGroup::getComponent() const { return component_; }
+
+    bool PerfCounterGroup::read(profiling_counters_t* values) const {
+      resetPerfCounterValues(values);
+      if (!isOpen()) {
+        return false;
+      }
+
+      // nr, time_enabled, time_running, then one value per counter.
+      uint64_t buffer[3 + COUNT_PERF_COUNTERS];
+      ssize_t size = ::read(fds_[0], buffer, sizeof(buffer));
+      if (size < (ssize_t)(sizeof(uint64_t) * (3 + count_opened_))) {
+        return false;
+      }
+
+      uint64_t time_enabled = buffer[1];
+      uint64_t time_running = buffer[2];
+      double scale = 1.;
+      if (time_running > 0 && time_running < time_enabled) {
+        scale = time_enabled / (double)time_running;
+      }
+
+      for (int i = 0; i < COUNT_PERF_COUNTERS; ++i) {
+        if (positions_[i] >= 0) {
+          values->values[i] = (uint64_t)(buffer[3 + positions_[i]] * scale);
+          values->available[i] = true;
+        }
+      }
+      return true;
+    }
+  }
+}
+}
@@ -1,14 +1,22 @@
 #include <util/perf-event/perf-event-manager.h>
 
+#include <algorithm>
+
 namespace scalable_graphs {
 namespace util {
   namespace perf_event {
 
     PerfEventManager* PerfEventManager::instance = nullptr;
 
+    // Trace buffer of the calling thread.
+    static __thread PerfEventTraceBuffer* trace_buffer = nullptr;
+
     PerfEventManager::PerfEventManager(const config_vertex_domain_t& config)
         : config_host_(config), config_client_(),
-          mode_(PerfEventMode::PEM_Host) {
+          mode_(PerfEventMode::PEM_Host),
+          enable_counters_(config.enable_perf_counters),
+          count_dropped_retired_(0), opened_counters_(false) {
+      pthread_key_create(&thread_exit_key_, &PerfEventManager::onThreadExit);
       int rc =
           ring_buffer_create(SIZE_EVENT_RB, L1D_CACHELINE_SIZE,
                              RING_BUFFER_BLOCKING, NULL, NULL, &new_event_rb_);
@@ -16,11 +24,16 @@ namespace util {
         sg_log("Fail to initialize ringbuffer for events: %d\n", rc);
         scalable_graphs::util::die(1);
       }
+      clock_.calibrate(CLOCK_CALIBRATION_USEC);
+      drained_events_.resize(COUNT_DRAIN_EVENTS);
     }
 
     PerfEventManager::PerfEventManager(const config_edge_processor_t& config)
         : config_host_(), config_client_(config),
-          mode_(PerfEventMode::PEM_Client) {
+          mode_(PerfEventMode::PEM_Client),
+          enable_counters_(config.enable_perf_counters),
+          count_dropped_retired_(0), opened_counters_(false) {
+      pthread_key_create(&thread_exit_key_, &PerfEventManager::onThreadExit);
       int rc =
           ring_buffer_create(SIZE_EVENT_RB, L1D_CACHELINE_SIZE,
                              RING_BUFFER_BLOCKING, NULL, NULL, &new_event_rb_);
@@ -28,13 +41,28 @@ namespace util {
         sg_log("Fail to initialize ringbuffer for events: %d\n", rc);
         scalable_graphs::util::die(1);
       }
+      clock_.calibrate(CLOCK_CALIBRATION_USEC);
+      drained_events_.resize(COUNT_DRAIN_EVENTS);
     }
 
     PerfEventManager::~PerfEventManager() {
+      pthread_key_delete(thread_exit_key_);
       ring_buffer_destroy(new_event_rb_);
       for (auto t : threads_) {
         delete t;
       }
+      for (auto b : trace_buffers_) {
+        delete b;
+      }
+      for (auto b : retired_trace_buffers_) {
+        delete b;
+      }
+      for (auto b : free_trace_buffers_) {
+        delete b;
+      }
+      for (auto c : counters_) {
+        delete c;
+      }
     }
 
     void PerfEventManager::start() {
@@ -54,7 +82,7 @@ namespace util {
         break;
       }
 
-      auto* t = new PerfEventCollector(new_event_rb_, config, mode_, id);
+      auto* t = new PerfEventCollector(this, new_event_rb_, config, mode_, id);
       t->start();
       t->setName("PECollector");
       threads_.push_back(t);
@@ -79,13 +107,128 @@ namespace util {
                           size_profiling_data);
       ring_buffer_elm_set_ready(new_event_rb_, req_event.data);
 
+      // the query server starts a new collector for every run
       for (auto& t : threads_) {
         t->join();
+        delete t;
+      }
+      threads_.clear();
+
+      uint64_t count_dropped = getCountDroppedEvents();
+      if (count_dropped > 0) {
+        sg_log("Dropped %lu trace events, the collector fell behind\n",
+               count_dropped);
       }
     }
 
     ring_buffer_t* PerfEventManager::getRingBuffer() { return new_event_rb_; }
 
+    PerfEventTraceBuffer* PerfEventManager::getTraceBuffer() {
+      if (unlikely(trace_buffer == nullptr)) {
+        {
+          std::lock_guard<std::mutex> lock(trace_buffers_mutex_);
+          if (!free_trace_buffers_.empty()) {
+            trace_buffer = free_trace_buffers_.back();
+            free_trace_buffers_.pop_back();
+          }
+        }
+        if (trace_buffer == nullptr) {
+          trace_buffer =
+              new PerfEventTraceBuffer(&names_, COUNT_TRACE_BUFFER_EVENTS);
+        } else {
+          trace_buffer->reset();
+        }
+        std::lock_guard<std::mutex> lock(trace_buffers_mutex_);
+        trace_buffers_.push_back(trace_buffer);
+        // Any non-NULL value makes the key run onThreadExit.
+        pthread_setspecific(thread_exit_key_, this);
+      }
+      return trace_buffer;
+    }
+
+    void PerfEventManager::onThreadExit(void* manager) {
+      // The thread-local storage is still there while the key destructors
+      // run.
+      PerfCounterGroup* counters = trace_buffer->getCounters();
+      if (counters != nullptr) {
+        trace_buffer->setCounters(nullptr);
+        ((PerfEventManager*)manager)->closeCounters(counters);
+      }
+      ((PerfEventManager*)manager)->retireTraceBuffer(trace_buffer);
+      trace_buffer = nullptr;
+    }
+
+    void PerfEventManager::retireTraceBuffer(
+        PerfEventTraceBuffer* trace_buffer) {
+      std::lock_guard<std::mutex> lock(trace_buffers_mutex_);
+      trace_buffers_.erase(std::find(trace_buffers_.begin(),
+                                     trace_buffers_.end(), trace_buffer));
+      retired_trace_buffers_.push_back(trace_buffer);
+    }
+
+    size_t PerfEventManager::drainTraceBuffers(FILE* file) {
+      std::lock_guard<std::mutex> drain_lock(drain_mutex_);
+      std::vector<PerfEventTraceBuffer*> trace_buffers;
+      size_t count_running;
+      {
+        std::lock_guard<std::mutex> lock(trace_buffers_mutex_);
+        trace_buffers = trace_buffers_;
+        count_running = trace_buffers.size();
+        // Nothing is appended to these anymore, after this drain they are
+        // empty.
+        trace_buffers.insert(trace_buffers.end(),
+                             retired_trace_buffers_.begin(),
+                             retired_trace_buffers_.end());
+        retired_trace_buffers_.clear();
+      }
+
+      size_t count_written = 0;
+      profiling_data_t data;
+      data.type = ProfilingType::PT_Duration;
+      data.pid = 0;
+      for (auto b : trace_buffers) {
+        size_t count_events;
+        while ((count_events = b->drain(drained_events_.data(),
+                                        drained_events_.size())) > 0) {
+          for (size_t i = 0; i < count_events; ++i) {
+            const trace_event_t& event = drained_events_[i];
+            data.component = event.component;
+            data.local_id = event.local_id;
+            data.global_id = event.global_id;
+            data.duration.time_start = clock_.toNsec(event.tsc_start);
+            data.duration.time_end = clock_.toNsec(event.tsc_end);
+            data.duration.metadata = event.metadata;
+
+            std::string name = names_.getName(event.name_id);
+            if (event.tile_id >= 0) {
+              name += "_" + std::to_string(event.tile_id);
+            }
+            writeProfilingDuration(data, name.c_str(), file);
+          }
+          count_written += count_events;
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(trace_buffers_mutex_);
+      for (size_t i = count_running; i < trace_buffers.size(); ++i) {
+        count_dropped_retired_ += trace_buffers[i]->getCountDropped();
+        free_trace_buffers_.push_back(trace_buffers[i]);
+      }
+      return count_written;
+    }
+
+    uint64_t PerfEventManager::getCountDroppedEvents() {
+      std::lock_guard<std::mutex> lock(trace_buffers_mutex_);
+      uint64_t count_dropped = count_dropped_retired_;
+      for (auto b : trace_buffers_) {
+        count_dropped += b->getCountDropped();
+      }
+      for (auto b : retired_trace_buffers_) {
+        count_dropped += b->getCountDropped();
+      }
+      return count_dropped;
+    }
+
     PerfEventManager*
     PerfEventManager::getInstance(const config_vertex_domain_t& config) {
       if (PerfEventManager::instance == nullptr) {
@@ -101,6 +244,88 @@ namespace util {
       }
       return PerfEventManager::instance;
     }
+
+    bool PerfEventManager::isCountingEnabled() const {
+      return enable_counters_;
+    }
+
+    PerfCounterGroup* PerfEventManager::openCounters(ComponentType component) {
+      auto* counters = new PerfCounterGroup(component);
+      std::lock_guard<std::mutex> lock(counters_mutex_);
+      if (!opened_counters_ && !counters->isOpen()) {
+        sg_log2("Hardware counters are not available, check "
+                "/proc/sys/kernel/perf_event_paranoid\n");
+      }
+      opened_counters_ = true;
+      counters_.push_back(counters);
+      return counters;
+    }
+
+    void PerfEventManager::closeCounters(PerfCounterGroup* counters) {
+      std::lock_guard<std::mutex> lock(counters_mutex_);
+      profiling_counters_t values;
+      if (counters->read(&values)) {
+        auto it = exited_counters_.find(counters->getComponent());
+        if (it == exited_counters_.end()) {
+          exited_counters_.insert(
+              std::make_pair(counters->getComponent(), values));
+        } else {
+          addPerfCounterValues(values, &it->second);
+        }
+      }
+      counters_.erase(
+          std::find(counters_.begin(), counters_.end(), counters));
+      delete counters;
+    }
+
+    void PerfEventManager::readCounters(
+        std::map<ComponentType, profiling_counters_t>* counters) {
+      std::lock_guard<std::mutex> lock(counters_mutex_);
+      *counters = exited_counters_;
+      for (auto c : counters_) {
+        profiling_counters_t values;
+        if (!c->read(&values)) {
+          continue;
+        }
+        auto it = counters->find(c->getComponent());
+        if (it == counters->end()) {
+          it = counters->insert(std::make_pair(c->getComponent(), values))
+                   .first;
+        } else {
+          addPerfCounterValues(values, &it->second);
+        }
+      }
+    }
+
+    void PerfEventManager::reportCounters(size_t iteration) {
+      std::map<ComponentType, profiling_counters_t> counters;
+      readCounters(&counters);
+
+      for (auto& it : counters) {
+        profiling_counters_t diff;
+        profiling_counters_t& previous = reported_counters_[it.first];
+        diffPerfCounterValues(it.second, previous, &diff);
+        previous = it.second;
+
+        const uint64_t* values = diff.values;
+        double ipc = 0.;
+        if (values[(int)PerfCounter::PC_Cycles] > 0) {
+          ipc = values[(int)PerfCounter::PC_Instructions] /
+                (double)values[(int)PerfCounter::PC_Cycles];
+        }
+        sg_log("Counters for iteration %lu, %s: cycles %lu, instructions %lu "
+               "(IPC %.2f), LLC misses %lu (%.1f MB), dTLB misses %lu, node "
+               "loads %lu\n",
+               iteration, getComponentName(it.first).c_str(),
+               values[(int)PerfCounter::PC_Cycles],
+               values[(int)PerfCounter::PC_Instructions], ipc,
+               values[(int)PerfCounter::PC_LLCMisses],
+               values[(int)PerfCounter::PC_LLCMisses] * L1D_CACHELINE_SIZE /
+                   (double)MB,
+               values[(int)PerfCounter::PC_DTLBMisses],
+               values[(int)PerfCounter::PC_NodeLoads]);
+      }
+    }
   }
 }
 }
@@ -3,107 +3,79 @@
 #include <pthread.h>
 
 #include <util/util.h>
+#include <util/perf-event/perf-event-manager.h>
 
 namespace scalable_graphs {
 namespace util {
   namespace perf_event {
 
-    PerfEventScoped::PerfEventScoped(ring_buffer_t* new_event_rb,
-                                     const std::string& name, bool active)
-        : active_(active), new_event_rb_(new_event_rb) {
+    PerfEventScoped::PerfEventScoped(PerfEventManager* manager,
+                                     const char* name, bool active)
+        : active_(active) {
       if (active) {
-        data_.type = ProfilingType::PT_Duration;
-        data_.pid = 0;
-        data_.duration.time_start = get_time_nsec();
-        data_.component = ComponentType::CT_None;
-        data_.local_id = 0;
-        data_.global_id = (int64_t)pthread_self();
-        data_.duration.metadata = 0;
-
-        name_ = name;
+        init(manager, name, ComponentType::CT_None, 0, (int64_t)pthread_self(),
+             0, -1);
       }
     }
 
-    PerfEventScoped::PerfEventScoped(ring_buffer_t* new_event_rb,
-                                     const std::string& name,
-                                     ComponentType component, int64_t global_id,
-                                     bool active)
-        : active_(active), new_event_rb_(new_event_rb) {
+    PerfEventScoped::PerfEventScoped(PerfEventManager* manager,
+                                     const char* name, ComponentType component,
+                                     int64_t global_id, bool active)
+        : active_(active) {
       if (active) {
-        data_.type = ProfilingType::PT_Duration;
-        data_.pid = 0;
-        data_.duration.time_start = get_time_nsec();
-        data_.component = component;
-        data_.local_id = 0;
-        data_.global_id = global_id;
-        data_.duration.metadata = 0;
-
-        name_ = name;
+        init(manager, name, component, 0, global_id, 0, -1);
       }
     }
 
-    PerfEventScoped::PerfEventScoped(ring_buffer_t* new_event_rb,
-                                     const std::string& name,
-                                     ComponentType component, int64_t local_id,
-                                     int64_t global_id, int tile_id,
-                                     bool active)
-        : active_(active), new_event_rb_(new_event_rb) {
+    PerfEventScoped::PerfEventScoped(PerfEventManager* manager,
+                                     const char* name, ComponentType component,
+                                     int64_t local_id, int64_t global_id,
+                                     int tile_id, bool active)
+        : active_(active) {
       if (active) {
-        data_.type = ProfilingType::PT_Duration;
-        data_.pid = 0;
-        data_.duration.time_start = get_time_nsec();
-        data_.component = component;
-        data_.local_id = local_id;
-        data_.global_id = global_id;
-        data_.duration.metadata = 0;
-
-        name_ = name + "_" + std::to_string(tile_id);
+        init(manager, name, component, local_id, global_id, 0, tile_id);
       }
     }
 
-    PerfEventScoped::PerfEventScoped(ring_buffer_t* new_event_rb,
-                                     const std::string& name,
-                                     ComponentType component, int64_t local_id,
-                                     int64_t global_id, uint64_t metadata,
-                                     int tile_id, bool active)
-        : active_(active), new_event_rb_(new_event_rb) {
+    PerfEventScoped::PerfEventScoped(PerfEventManager* manager,
+                                     const char* name, ComponentType component,
+                                     int64_t local_id, int64_t global_id,
+                                     uint64_t metadata, int tile_id,
+                                     bool active)
+        : active_(active) {
       if (active) {
-        data_.type = ProfilingType::PT_Duration;
-        data_.pid = 0;
-        data_.duration.time_start = get_time_nsec();
-        data_.component = component;
-        data_.local_id = local_id;
-        data_.global_id = global_id;
-        data_.duration.metadata = metadata;
+        init(manager, name, component, local_id, global_id, metadata,
+             tile_id);
+      }
+    }
 
-        name_ = name + "_" + std::to_string(tile_id);
+    void PerfEventScoped::init(PerfEventManager* manager, const char* name,
+                               ComponentType component, int64_t local_id,
+                               int64_t global_id, uint64_t metadata,
+                               int tile_id) {
+      trace_buffer_ = manager->getTraceBuffer();
+      // Attribute the counters of a thread to the component of its first
+      // event.
+      if (unlikely(manager->isCountingEnabled() &&
+                   trace_buffer_->getCounters() == nullptr &&
+                   component != ComponentType::CT_None)) {
+        trace_buffer_->setCounters(manager->openCounters(component));
       }
+
+      event_.name_id = trace_buffer_->internName(name);
+      event_.component = component;
+      event_.local_id = local_id;
+      event_.global_id = global_id;
+      event_.metadata = metadata;
+      event_.tile_id = tile_id;
+      // Take the timestamp last to not account for the setup.
+      event_.tsc_start = rdtsc();
     }
 
     PerfEventScoped::~PerfEventScoped() {
       if (active_) {
-        data_.duration.time_end = get_time_nsec();
-
-        // Size of name_ + 1 to account for \0.
-        size_t size_name = name_.size() + 1;
-        size_t size_profiling_data =
-            sizeof(profiling_transport_t) + sizeof(char) * size_name;
-
-        ring_buffer_req_t req_event;
-        ring_buffer_put_req_init(&req_event, BLOCKING, size_profiling_data);
-        ring_buffer_put(new_event_rb_, &req_event);
-        sg_rb_check(&req_event);
-
-        profiling_transport_t* transport =
-            (profiling_transport_t*)req_event.data;
-        transport->shutdown = false;
-        transport->data = data_;
-
-        // Copy the name.
-        copy_to_ring_buffer(new_event_rb_, transport->data.name, name_.c_str(),
-                            size_name);
-
-        ring_buffer_elm_set_ready(new_event_rb_, req_event.data);
+        event_.tsc_end = rdtsc();
+        trace_buffer_->append(event_);
       }
     }
   }
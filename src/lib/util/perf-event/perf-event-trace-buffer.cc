@@ -0,0 +1,128 @@
+#include <util/perf-event/perf-event-trace-buffer.h>
+
+#include <algorithm>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <util/util.h>
+
+namespace scalable_graphs {
+namespace util {
+  namespace perf_event {
+
+    uint32_t PerfEventNameTable::intern(const std::string& name) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = ids_.find(name);
+      if (it != ids_.end()) {
+        return it->second;
+      }
+      uint32_t id = names_.size();
+      names_.push_back(name);
+      ids_[name] = id;
+      return id;
+    }
+
+    std::string PerfEventNameTable::getName(uint32_t id) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (id >= names_.size()) {
+        return "unknown";
+      }
+      return names_[id];
+    }
+
+    PerfEventClock::PerfEventClock()
+        : tsc_base_(0), nsec_base_(0), nsec_per_tick_(0.) {}
+
+    void PerfEventClock::calibrate(uint64_t duration_usec) {
+      uint64_t nsec_start = get_time_nsec();
+      uint64_t tsc_start = rdtsc();
+      usleep(duration_usec);
+      uint64_t nsec_end = get_time_nsec();
+      uint64_t tsc_end = rdtsc();
+
+      tsc_base_ = tsc_start;
+      nsec_base_ = nsec_start;
+      nsec_per_tick_ = (nsec_end - nsec_start) / (double)(tsc_end - tsc_start);
+    }
+
+    uint64_t PerfEventClock::toNsec(uint64_t tsc) const {
+      int64_t ticks = (int64_t)(tsc - tsc_base_);
+      return nsec_base_ + (int64_t)(ticks * nsec_per_tick_);
+    }
+
+    double PerfEventClock::getTicksPerNsec() const {
+      return 1. / nsec_per_tick_;
+    }
+
+    PerfEventTraceBuffer::PerfEventTraceBuffer(PerfEventNameTable* names,
+                                               size_t count_events)
+        : names_(names), counters_(nullptr), head_(0), tail_cache_(0), count_dropped_(0),
+          tail_(0) {
+      if (count_events == 0 || (count_events & (count_events - 1)) != 0) {
+        sg_err("Size of trace buffer has to be a power of two: %lu\n",
+               count_events);
+        util::die(1);
+      }
+      mask_ = count_events - 1;
+
+      int rc = posix_memalign((void**)&events_, L1D_CACHELINE_SIZE,
+                              sizeof(trace_event_t) * count_events);
+      if (rc) {
+        sg_err("Fail to allocate trace buffer: %d\n", rc);
+        util::die(1);
+      }
+    }
+
+    PerfEventTraceBuffer::~PerfEventTraceBuffer() { free(events_); }
+
+    uint32_t PerfEventTraceBuffer::internName(const char* name) {
+      auto it = name_ids_.find(name);
+      if (it != name_ids_.end()) {
+        return it->second;
+      }
+      uint32_t id = names_->intern(name);
+      name_ids_[name] = id;
+      return id;
+    }
+
+    size_t PerfEventTraceBuffer::drain(trace_event_t* events,
+                                       size_t max_events) {
+      size_t head = head_;
+      // Read the events only after the head.
+      smp_rmb();
+
+      size_t tail = tail_;
+      size_t count_events = std::min(head - tail, max_events);
+      for (size_t i = 0; i < count_events; ++i) {
+        events[i] = events_[(tail + i) & mask_];
+      }
+
+      // Finish reading the events before handing the slots back.
+      smp_mb();
+      tail_ = tail + count_events;
+      return count_events;
+    }
+
+    uint64_t PerfEventTraceBuffer::getCountDropped() const {
+      return count_dropped_;
+    }
+
+    void PerfEventTraceBuffer::reset() {
+      counters_ = nullptr;
+      head_ = 0;
+      tail_cache_ = 0;
+      count_dropped_ = 0;
+      tail_ = 0;
+    }
+
+    PerfCounterGroup* PerfEventTraceBuffer::getCounters() const {
+      return counters_;
+    }
+
+    void PerfEventTraceBuffer::setCounters(PerfCounterGroup* counters) {
+      counters_ = counters;
+    }
+  }
+}
+}
@@ -123,6 +123,7 @@ namespace util {
       }
     }
     runnable->run();
+    return NULL;
   }
 }
 }
@@ -8,7 +8,11 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#if defined(__x86_64__) && !defined(TARGET_ARCH_K1OM)
+#include <nmmintrin.h>
+#endif
 #include <util/util.h>
+#include <util/perf-event/perf-event-counters.h>
 #include "../../util/pci-ring-buffer/lib/ring_buffer_i.h"
 
 namespace scalable_graphs {
@@ -39,6 +43,92 @@ namespace util {
     return list;
   }
 
+  // slicing-by-8: entries[k][b] is the CRC of byte b followed by k zero bytes
+  static uint32_t crc32cSoftware(const uint8_t* bytes, size_t size,
+                                 uint32_t crc) {
+    static const struct crc32c_table_t {
+      uint32_t entries[8][256];
+      crc32c_table_t() {
+        for (uint32_t i = 0; i < 256; ++i) {
+          uint32_t value = i;
+          for (int j = 0; j < 8; ++j) {
+            value = (value >> 1) ^ (0x82f63b78 & (0 - (value & 1)));
+          }
+          entries[0][i] = value;
+        }
+        for (uint32_t i = 0; i < 256; ++i) {
+          for (int k = 1; k < 8; ++k) {
+            uint32_t previous = entries[k - 1][i];
+            entries[k][i] = entries[0][previous & 0xff] ^ (previous >> 8);
+          }
+        }
+      }
+    } table;
+
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, bytes, sizeof(uint64_t));
+      word ^= crc;
+      crc = table.entries[7][word & 0xff] ^
+            table.entries[6][(word >> 8) & 0xff] ^
+            table.entries[5][(word >> 16) & 0xff] ^
+            table.entries[4][(word >> 24) & 0xff] ^
+            table.entries[3][(word >> 32) & 0xff] ^
+            table.entries[2][(word >> 40) & 0xff] ^
+            table.entries[1][(word >> 48) & 0xff] ^
+            table.entries[0][word >> 56];
+      bytes += sizeof(uint64_t);
+    }
+    for (size_t i = 0; i < size; ++i) {
+      crc = table.entries[0][(crc ^ bytes[i]) & 0xff] ^ (crc >> 8);
+    }
+    return crc;
+  }
+
+#if defined(__x86_64__) && !defined(TARGET_ARCH_K1OM)
+  // the crc32 instruction of SSE4.2 computes exactly CRC-32C
+  __attribute__((target("sse4.2"))) static uint32_t
+  crc32cHardware(const uint8_t* bytes, size_t size, uint32_t crc) {
+    uint64_t crc64 = crc;
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, bytes, sizeof(uint64_t));
+      crc64 = _mm_crc32_u64(crc64, word);
+      bytes += sizeof(uint64_t);
+    }
+    crc = (uint32_t)crc64;
+    for (size_t i = 0; i < size; ++i) {
+      crc = _mm_crc32_u8(crc, bytes[i]);
+    }
+    return crc;
+  }
+#endif
+
+  uint32_t crc32c(const void* data, size_t size, uint32_t crc) {
+    const uint8_t* bytes = (const uint8_t*)data;
+#if defined(__x86_64__) && !defined(TARGET_ARCH_K1OM)
+    static const bool has_sse42 = __builtin_cpu_supports("sse4.2");
+    if (has_sse42) {
+      return ~crc32cHardware(bytes, size, ~crc);
+    }
+#endif
+    return ~crc32cSoftware(bytes, size, ~crc);
+  }
+
+  size_t countBoolArray(const char* array, size_t size) {
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, array + i, sizeof(uint64_t));
+      count += __builtin_popcountll(word);
+    }
+    for (; i < size; ++i) {
+      count += __builtin_popcount((unsigned char)array[i]);
+    }
+    return count;
+  }
+
   std::vector<std::string> splitDirPaths(const std::string& s) {
     std::vector<std::string> path_list;
     std::stringstream ss(s);
@@ -242,41 +332,35 @@ namespace util {
     return file;
   }
 
-  std::string getThreadId(const profiling_data_t& data) {
-    // First use the Component name, then append global id and, if necessary,
-    // the local id, i.e.: VertexFetcher_2_1
-    std::string tid;
-
-    switch (data.component) {
+  std::string getComponentName(ComponentType component) {
+    switch (component) {
     case ComponentType::CT_GlobalReducer:
-      tid += "GlobalReducer";
-      break;
+      return "GlobalReducer";
     case ComponentType::CT_IndexReader:
-      tid += "IndexReader";
-      break;
+      return "IndexReader";
     case ComponentType::CT_None:
-      break;
+      return "";
     case ComponentType::CT_RingBufferSizes:
-      tid += "RingBufferSizes";
-      break;
+      return "RingBufferSizes";
     case ComponentType::CT_TileProcessor:
-      tid += "TileProcessor";
-      break;
+      return "TileProcessor";
     case ComponentType::CT_TileReader:
-      tid += "TileReader";
-      break;
+      return "TileReader";
     case ComponentType::CT_VertexApplier:
-      tid += "VertexApplier";
-      break;
+      return "VertexApplier";
     case ComponentType::CT_VertexFetcher:
-      tid += "VertexFetcher";
-      break;
+      return "VertexFetcher";
     case ComponentType::CT_VertexReducer:
-      tid += "VertexReducer";
-      break;
+      return "VertexReducer";
     default:
-      break;
+      return "";
     }
+  }
+
+  std::string getThreadId(const profiling_data_t& data) {
+    // First use the Component name, then append global id and, if necessary,
+    // the local id, i.e.: VertexFetcher_2_1
+    std::string tid = getComponentName(data.component);
 
     tid += "_" + std::to_string(data.global_id);
 
@@ -293,7 +377,8 @@ namespace util {
     return tid;
   }
 
-  void writeProfilingDuration(const profiling_data_t& data, FILE* file) {
+  void writeProfilingDuration(const profiling_data_t& data, const char* name,
+                              FILE* file) {
     std::string thread_id = getThreadId(data);
 
     double time_start_usec = data.duration.time_start / (double)1000;
@@ -302,12 +387,12 @@ namespace util {
     // Print first event ('B').
     fprintf(file, "{\"tid\": \"%s\",\"ts\": %f,\"pid\": %ld, \"name\": \"%s\", "
                   "\"ph\": \"B\", \"args\": { \"metadata\": %lu }},\n",
-            thread_id.c_str(), time_start_usec, data.pid, data.name,
+            thread_id.c_str(), time_start_usec, data.pid, name,
             data.duration.metadata);
     // Print end event ('E').
     fprintf(file, "{\"tid\": \"%s\",\"ts\": %f,\"pid\": %ld, \"name\": \"%s\", "
                   "\"ph\": \"E\", \"args\": { \"metadata\": %lu }},\n",
-            thread_id.c_str(), time_end_usec, data.pid, data.name,
+            thread_id.c_str(), time_end_usec, data.pid, name,
             data.duration.metadata);
   }
 
@@ -329,5 +414,29 @@ namespace util {
             timestamp_usec, data.pid, name.c_str(),
             data.ringbuffer_sizes.size_response_rb);
   }
+  void writePerfCounters(ComponentType component, uint64_t time,
+                         const profiling_counters_t& counters, FILE* file) {
+    std::string name = getComponentName(component);
+
+    double timestamp_usec = time / (double)1000;
+
+    std::string args;
+    for (int i = 0; i < COUNT_PERF_COUNTERS; ++i) {
+      if (!counters.available[i]) {
+        continue;
+      }
+      if (!args.empty()) {
+        args += ", ";
+      }
+      args += "\"" +
+              std::string(perf_event::getPerfCounterName((PerfCounter)i)) +
+              "\": " + std::to_string(counters.values[i]);
+    }
+
+    fprintf(file, "{\"ts\": %f,\"pid\": 0, \"name\": \"%s_counters\", "
+                  "\"ph\": \"C\", \"args\": {%s}},\n",
+            timestamp_usec, name.c_str(), args.c_str());
+  }
+
 }
 }
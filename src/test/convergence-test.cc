@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+#include <core/datatypes.h>
+#include <core/util.h>
+#include "../lib/core/algorithms/bfs.h"
+#include "../lib/core/algorithms/pagerank.h"
+#include "simulation.h"
+
+#include <random>
+#include <vector>
+
+namespace core = scalable_graphs::core;
+
+static std::vector<edge_t> getEdges(size_t count_vertices,
+                                    size_t count_edges) {
+  std::mt19937 generator(11);
+  std::uniform_int_distribution<uint64_t> vertex(0, count_vertices - 1);
+  std::vector<edge_t> edges;
+  for (size_t i = 0; i < count_edges; ++i) {
+    edges.push_back({vertex(generator), vertex(generator)});
+  }
+  return edges;
+}
+
+TEST(ConvergenceTest, PageRankStopsAtTolerance) {
+  std::vector<edge_t> edges = getEdges(200, 2000);
+  const int max_rounds = 200;
+
+  config_vertex_domain_t loose;
+  loose.convergence_tolerance = 20.;
+  Simulation<core::PageRank> loose_simulation(200, edges);
+  loose_simulation.init(NULL);
+  int loose_rounds = loose_simulation.run(max_rounds, loose);
+  ASSERT_LT(loose_rounds, max_rounds);
+  ASSERT_LE(loose_simulation.residual(), 20.);
+
+  // a tighter tolerance needs more rounds
+  config_vertex_domain_t tight;
+  tight.convergence_tolerance = 2.;
+  Simulation<core::PageRank> tight_simulation(200, edges);
+  tight_simulation.init(NULL);
+  int tight_rounds = tight_simulation.run(max_rounds, tight);
+  ASSERT_LT(tight_rounds, max_rounds);
+  ASSERT_GT(tight_rounds, loose_rounds);
+  ASSERT_LE(tight_simulation.residual(), 2.);
+}
+
+TEST(ConvergenceTest, BFSResidualCountsActiveVertices) {
+  std::vector<edge_t> edges = getEdges(100, 300);
+  Simulation<core::BFS> simulation(100, edges);
+  simulation.init(std::vector<uint64_t>{0});
+  while (simulation.run(1) == 1) {
+    ASSERT_EQ(simulation.countActive(), simulation.residual());
+  }
+  ASSERT_EQ(0, simulation.countActive());
+  ASSERT_EQ(0., simulation.residual());
+}
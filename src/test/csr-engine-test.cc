@@ -0,0 +1,270 @@
+#include "gtest/gtest.h"
+#include <core/datatypes.h>
+#include <core/csr-graph.h>
+#include <core/csr-engine.h>
+#include <core/tile-container.h>
+#include <core/util.h>
+#include <util/util.h>
+#include "../lib/core/algorithms/bfs.h"
+#include "../lib/core/algorithms/cc.h"
+#include "../lib/core/algorithms/pagerank.h"
+#include "../lib/core/algorithms/sssp.h"
+#include "../lib/core/algorithms/wcc.h"
+#include "../tools/post-grc/delta-store.h"
+#include "simulation.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace core = scalable_graphs::core;
+namespace util = scalable_graphs::util;
+namespace pg = scalable_graphs::post_grc;
+
+// more vertices than fit into a few chunks, so that all workers get some
+static const size_t count_vertices = 5000;
+static const int count_threads = 4;
+
+static std::vector<edge_t> getEdges(size_t count_edges) {
+  std::mt19937 generator(5);
+  std::uniform_int_distribution<uint64_t> vertex(0, count_vertices - 1);
+  std::vector<edge_t> edges;
+  for (size_t i = 0; i < count_edges; ++i) {
+    edges.push_back({vertex(generator), vertex(generator)});
+  }
+  return edges;
+}
+
+static std::vector<float> getWeights(size_t count_edges) {
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<float> weight(0.5f, 10.f);
+  std::vector<float> weights;
+  for (size_t i = 0; i < count_edges; ++i) {
+    weights.push_back(weight(generator));
+  }
+  return weights;
+}
+
+static config_vertex_domain_t getConfig(int max_iterations,
+                                        bool use_selective_scheduling) {
+  config_vertex_domain_t config;
+  config.max_iterations = max_iterations;
+  config.use_selective_scheduling = use_selective_scheduling;
+  return config;
+}
+
+TEST(CsrGraphTest, SortsColumnsAndRowsByNeighbor) {
+  std::vector<edge_t> edges = {{2, 0}, {1, 0}, {0, 1}, {2, 1}, {0, 2}, {1, 0}};
+  std::vector<float> weights = {1.f, 2.f, 3.f, 4.f, 5.f, 6.f};
+  core::CsrGraph graph;
+  graph.build(3, edges, weights, true);
+
+  ASSERT_EQ(6u, graph.countEdges());
+  ASSERT_TRUE(graph.isWeighted());
+  const core::CsrGraph::Adjacency& columns = graph.columns();
+  ASSERT_EQ((std::vector<uint64_t>{0, 3, 5, 6}), columns.offsets);
+  ASSERT_EQ((std::vector<uint32_t>{1, 1, 2, 0, 2, 0}), columns.neighbors);
+  ASSERT_EQ((std::vector<float>{2.f, 6.f, 1.f, 3.f, 4.f, 5.f}),
+            columns.weights);
+  const core::CsrGraph::Adjacency& rows = graph.rows();
+  ASSERT_EQ((std::vector<uint64_t>{0, 2, 4, 6}), rows.offsets);
+  ASSERT_EQ((std::vector<uint32_t>{1, 2, 0, 0, 0, 1}), rows.neighbors);
+
+  ASSERT_EQ(3u, graph.degrees()[0].in_degree);
+  ASSERT_EQ(2u, graph.degrees()[0].out_degree);
+  ASSERT_EQ(1u, graph.degrees()[2].in_degree);
+  ASSERT_EQ(2u, graph.degrees()[2].out_degree);
+}
+
+TEST(CsrGraphTest, DropsRowsUnlessAsked) {
+  core::CsrGraph graph;
+  graph.build(3, {{0, 1}, {1, 2}}, std::vector<float>(), false);
+  ASSERT_FALSE(graph.isWeighted());
+  ASSERT_TRUE(graph.rows().offsets.empty());
+  ASSERT_EQ(1u, graph.degrees()[1].out_degree);
+}
+
+TEST(CsrGraphTest, LoadsDeltaTilesAndTombstones) {
+  const int count_edge_engines = 2;
+  std::vector<std::string> dirs;
+  auto make_dir = [&dirs]() {
+    char dir_template[] = "/tmp/csr-engine-test-XXXXXX";
+    EXPECT_TRUE(mkdtemp(dir_template) != NULL);
+    dirs.push_back(dir_template);
+    return std::string(dir_template) + "/";
+  };
+  config_t config;
+  config.path_to_globals = make_dir();
+  for (int i = 0; i < count_edge_engines; ++i) {
+    config.paths_to_tile.push_back(make_dir());
+    tile_stats_t tile_stats;
+    core::TileContainerWriter writer(core::getTileContainerFileName(config, i),
+                                     &tile_stats, 0, false, true);
+    writer.close();
+  }
+  config.count_edge_processors = count_edge_engines;
+  scenario_stats_t stats;
+  stats.count_vertices = count_vertices;
+  stats.count_tiles = 0;
+  stats.is_index_32_bits = true;
+  stats.is_weighted_graph = false;
+  stats.index_33_bit_extension = false;
+  std::string stats_file_name =
+      core::getGlobalStatFileName(config.path_to_globals);
+  util::writeDataToFile(stats_file_name, &stats, sizeof(stats));
+
+  // the delta tiles of the first edges become the base tiles
+  std::vector<edge_t> edges = getEdges(6000);
+  std::vector<pg::delta_edge_t> base_edges;
+  for (size_t i = 0; i < 4000; ++i) {
+    base_edges.push_back({edges[i].src, edges[i].tgt, 0.0f});
+  }
+  {
+    pg::DeltaStore store(config, stats, grc_tile_traversals_t::Hilbert);
+    store.open();
+    store.insertEdges(base_edges);
+    store.write();
+  }
+  for (int i = 0; i < count_edge_engines; ++i) {
+    std::string delta_file_name =
+        core::getDeltaTileContainerFileName(config, i);
+    if (core::TileContainer::exists(delta_file_name)) {
+      ASSERT_EQ(0, rename(delta_file_name.c_str(),
+                          core::getTileContainerFileName(config, i).c_str()));
+    }
+  }
+  util::readDataFromFile(stats_file_name, sizeof(stats), &stats);
+
+  // delete some base edges, insert the remaining ones as delta tiles
+  std::vector<edge_t> deleted_edges(edges.begin(), edges.begin() + 1000);
+  std::vector<pg::delta_edge_t> delta_edges;
+  for (size_t i = 4000; i < edges.size(); ++i) {
+    delta_edges.push_back({edges[i].src, edges[i].tgt, 0.0f});
+  }
+  {
+    pg::DeltaStore store(config, stats, grc_tile_traversals_t::Hilbert);
+    store.open();
+    ASSERT_EQ(0u, store.deleteEdges(&deleted_edges));
+    store.insertEdges(delta_edges);
+    store.write();
+    ASSERT_EQ(1000u, store.countTombstones());
+  }
+  util::readDataFromFile(stats_file_name, sizeof(stats), &stats);
+
+  core::CsrGraph graph;
+  graph.loadTiles(config, stats, true);
+  std::multiset<std::pair<uint64_t, uint64_t> > expected_edges;
+  for (size_t i = 1000; i < edges.size(); ++i) {
+    expected_edges.insert(std::make_pair(edges[i].src, edges[i].tgt));
+  }
+  std::multiset<std::pair<uint64_t, uint64_t> > loaded_edges;
+  const core::CsrGraph::Adjacency& rows = graph.rows();
+  for (uint64_t src = 0; src < count_vertices; ++src) {
+    for (uint64_t i = rows.offsets[src]; i < rows.offsets[src + 1]; ++i) {
+      loaded_edges.insert(std::make_pair(src, rows.neighbors[i]));
+    }
+  }
+  ASSERT_EQ(expected_edges, loaded_edges);
+
+  for (const auto& dir : dirs) {
+    std::string command = "rm -rf " + dir;
+    ASSERT_EQ(0, system(command.c_str()));
+  }
+}
+
+TEST(CsrEngineTest, PageRankMatchesSimulation) {
+  std::vector<edge_t> edges = getEdges(40000);
+  Simulation<core::PageRank> simulation(count_vertices, edges);
+  simulation.init(NULL);
+  int rounds = simulation.run(100);
+
+  core::CsrGraph graph;
+  graph.build(count_vertices, edges, std::vector<float>(), false);
+  // the simulation stops once no vertex is active anymore
+  core::CsrEngine<core::PageRank, false> engine(getConfig(100, true), graph,
+                                                count_threads);
+  engine.init();
+  ASSERT_EQ((size_t)rounds, engine.run());
+  // every round gathers along all edges
+  ASSERT_EQ(rounds * edges.size(), engine.countEdges());
+  // the sums are taken in a different order
+  for (size_t i = 0; i < count_vertices; ++i) {
+    ASSERT_NEAR(simulation.current()[i], engine.current()[i],
+                1e-4 * simulation.current()[i]);
+  }
+}
+
+TEST(CsrEngineTest, BFSMatchesSimulation) {
+  std::vector<edge_t> edges = getEdges(12000);
+  Simulation<core::BFS> simulation(count_vertices, edges);
+  simulation.init(std::vector<uint64_t>{3});
+  int rounds = simulation.run(count_vertices);
+
+  core::CsrGraph graph;
+  graph.build(count_vertices, edges, std::vector<float>(), false);
+  config_vertex_domain_t config = getConfig(count_vertices, true);
+  config.roots = {3};
+  core::CsrEngine<core::BFS, false> engine(config, graph, count_threads);
+  engine.init();
+  ASSERT_EQ((size_t)rounds, engine.run());
+  for (size_t i = 0; i < count_vertices; ++i) {
+    ASSERT_EQ(simulation.current()[i], engine.current()[i]) << i;
+  }
+}
+
+TEST(CsrEngineTest, CCMatchesSimulation) {
+  std::vector<edge_t> edges = getEdges(6000);
+  Simulation<core::CC> simulation(count_vertices, edges);
+  simulation.init(std::vector<uint64_t>());
+  simulation.run(count_vertices);
+
+  core::CsrGraph graph;
+  graph.build(count_vertices, edges, std::vector<float>(), false);
+  core::CsrEngine<core::CC, false> engine(getConfig(count_vertices, true),
+                                          graph, count_threads);
+  engine.init();
+  engine.run();
+  for (size_t i = 0; i < count_vertices; ++i) {
+    ASSERT_EQ(simulation.current()[i], engine.current()[i]) << i;
+  }
+}
+
+TEST(CsrEngineTest, WeightedSSSPMatchesSimulation) {
+  std::vector<edge_t> edges = getEdges(20000);
+  std::vector<float> weights = getWeights(edges.size());
+  Simulation<core::SSSP> simulation(count_vertices, edges, weights);
+  simulation.init(std::vector<uint64_t>{0});
+  simulation.run(count_vertices);
+
+  core::CsrGraph graph;
+  graph.build(count_vertices, edges, weights, false);
+  config_vertex_domain_t config = getConfig(count_vertices, true);
+  config.roots = {0};
+  core::CsrEngine<core::SSSP, true> engine(config, graph, count_threads);
+  engine.init();
+  engine.run();
+  for (size_t i = 0; i < count_vertices; ++i) {
+    ASSERT_EQ(simulation.current()[i], engine.current()[i]) << i;
+  }
+}
+
+TEST(CsrEngineTest, WCCGathersAlongTransposedEdges) {
+  std::vector<edge_t> edges = getEdges(6000);
+  Simulation<core::WCC> simulation(count_vertices, edges);
+  simulation.init(std::vector<uint64_t>());
+  simulation.run(count_vertices);
+
+  core::CsrGraph graph;
+  graph.build(count_vertices, edges, std::vector<float>(), true);
+  core::CsrEngine<core::WCC, false> engine(getConfig(count_vertices, true),
+                                           graph, count_threads);
+  engine.init();
+  engine.run();
+  for (size_t i = 0; i < count_vertices; ++i) {
+    ASSERT_EQ(simulation.current()[i], engine.current()[i]) << i;
+  }
+}
@@ -0,0 +1,107 @@
+#include "gtest/gtest.h"
+#include <core/datatypes.h>
+#include <core/util.h>
+#include <core/vertex-vector.h>
+#include "../lib/core/algorithms/embedding.h"
+#include "simulation.h"
+
+#include <random>
+#include <vector>
+
+namespace core = scalable_graphs::core;
+
+template <size_t K>
+static void expectAddScaled() {
+  core::vertex_vector_t<K> lhs;
+  core::vertex_vector_t<K> rhs;
+  for (size_t i = 0; i < K; ++i) {
+    lhs.values[i] = i;
+    rhs.values[i] = 2. * i + 1;
+  }
+  lhs.addScaled(rhs, 0.5);
+  for (size_t i = 0; i < K; ++i) {
+    ASSERT_FLOAT_EQ(i + 0.5 * (2. * i + 1), lhs.values[i]) << K << " " << i;
+  }
+}
+
+TEST(EmbeddingTest, VectorOperations) {
+  // with and without a scalar remainder after the blocks of four
+  expectAddScaled<1>();
+  expectAddScaled<4>();
+  expectAddScaled<7>();
+  expectAddScaled<16>();
+
+  core::vertex_vector_t<3> v;
+  v = 0.5f;
+  ASSERT_EQ(0.5f, v.values[0]);
+  ASSERT_EQ(0.5f, v.values[2]);
+  core::vertex_vector_t<3> zero = {};
+  ASSERT_TRUE(zero != v);
+  ASSERT_FLOAT_EQ(1.5f, zero.distance(v));
+  v.scale(0);
+  ASSERT_TRUE(zero == v);
+}
+
+TEST(EmbeddingTest, AtomicVertexTypes) {
+  ASSERT_TRUE(core::isAtomicVertexType<float>());
+  ASSERT_TRUE(core::isAtomicVertexType<core::vertex_vector_t<2> >());
+  ASSERT_FALSE(core::isAtomicVertexType<core::vertex_vector_t<4> >());
+
+  core::vertex_vector_t<2> value = {{1, 2}};
+  core::vertex_vector_t<2> expected = {{1, 2}};
+  core::vertex_vector_t<2> swapped = {{3, 4}};
+  ASSERT_TRUE(core::casVertex(&value, expected, swapped));
+  ASSERT_TRUE(value == swapped);
+  ASSERT_FALSE(core::casVertex(&value, expected, swapped));
+}
+
+TEST(EmbeddingTest, MatchesPowerIteration) {
+  typedef core::Embedding<8> Embedding;
+  const size_t count_vertices = 50;
+  std::mt19937 generator(5);
+  std::uniform_int_distribution<uint64_t> vertex(0, count_vertices - 1);
+  std::vector<edge_t> edges;
+  for (size_t i = 0; i < 400; ++i) {
+    edges.push_back({vertex(generator), vertex(generator)});
+  }
+  std::vector<uint32_t> out_degrees(count_vertices, 0);
+  for (const auto& edge : edges) {
+    ++out_degrees[edge.src];
+  }
+
+  // every dimension on its own, as personalized PageRank
+  const int count_rounds = 5;
+  std::vector<Embedding::VertexType> expected(count_vertices);
+  for (size_t i = 0; i < count_vertices; ++i) {
+    Embedding::seed(i, &expected[i]);
+  }
+  for (int round = 0; round < count_rounds; ++round) {
+    std::vector<std::vector<double> > sums(count_vertices,
+                                           std::vector<double>(8, 0.));
+    for (const auto& edge : edges) {
+      for (size_t d = 0; d < 8; ++d) {
+        sums[edge.tgt][d] +=
+            expected[edge.src].values[d] / out_degrees[edge.src];
+      }
+    }
+    for (size_t i = 0; i < count_vertices; ++i) {
+      Embedding::VertexType restart;
+      Embedding::seed(i, &restart);
+      for (size_t d = 0; d < 8; ++d) {
+        expected[i].values[d] = EMBEDDING_ALPHA * sums[i][d] +
+                                (1 - EMBEDDING_ALPHA) * restart.values[d];
+      }
+    }
+  }
+
+  Simulation<Embedding> simulation(count_vertices, edges);
+  simulation.init(NULL);
+  ASSERT_EQ(count_rounds, simulation.run(count_rounds));
+  for (size_t i = 0; i < count_vertices; ++i) {
+    for (size_t d = 0; d < 8; ++d) {
+      ASSERT_NEAR(expected[i].values[d], simulation.current()[i].values[d],
+                  1e-4)
+          << "vertex " << i << " dimension " << d;
+    }
+  }
+}
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "gtest/gtest.h"
+#include <core/datatypes.h>
+#include <core/execute-engine.h>
+#include <core/tile-container.h>
+#include <core/util.h>
+#include <util/util.h>
+#include "../tools/post-grc/delta-store.h"
+#include "../tools/post-grc/index-reader.h"
+
+#include <stdlib.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace core = scalable_graphs::core;
+namespace util = scalable_graphs::util;
+namespace pg = scalable_graphs::post_grc;
+
+// A graph of delta tiles only, on top of empty base containers of two edge
+// engines, in the in-memory mode. run() runs an APP on a copy of the
+// configuration like the query server does, tests may change config_vertex_
+// and config_edge_ before.
+class EngineTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    config_t config;
+    config.path_to_globals = makeDir();
+    for (int i = 0; i < count_edge_engines_; ++i) {
+      config.paths_to_meta.push_back(makeDir());
+      config.paths_to_tile.push_back(makeDir());
+      tile_stats_t tile_stats;
+      core::TileContainerWriter writer(
+          core::getTileContainerFileName(config, i), &tile_stats, 0, false,
+          true);
+      writer.close();
+    }
+    config.count_edge_processors = count_edge_engines_;
+
+    scenario_stats_t stats;
+    stats.count_vertices = count_vertices_;
+    stats.count_tiles = 0;
+    stats.is_index_32_bits = true;
+    stats.is_weighted_graph = false;
+    stats.index_33_bit_extension = false;
+    util::writeDataToFile(core::getGlobalStatFileName(config.path_to_globals),
+                          &stats, sizeof(stats));
+
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<uint64_t> vertex(0, count_vertices_ - 1);
+    std::vector<pg::delta_edge_t> delta_edges;
+    std::vector<vertex_degree_t> degrees(count_vertices_);
+    for (size_t i = 0; i < count_edges_; ++i) {
+      edge_t edge = {vertex(generator), vertex(generator)};
+      edges_.push_back(edge);
+      delta_edges.push_back({edge.src, edge.tgt, 0.0f});
+      ++degrees[edge.src].out_degree;
+      ++degrees[edge.tgt].in_degree;
+    }
+    pg::DeltaStore store(config, stats, grc_tile_traversals_t::Hilbert);
+    store.open();
+    store.insertEdges(delta_edges);
+    store.write();
+    util::readDataFromFile(core::getGlobalStatFileName(config.path_to_globals),
+                           sizeof(stats), &stats);
+    util::writeDataToFile(core::getVertexDegreeFileName(config),
+                          degrees.data(),
+                          sizeof(vertex_degree_t) * degrees.size());
+    writeTileIndex(config, stats);
+
+    // the options of tools/scripts/perf_regression.py in the in-memory mode
+    setCommonConfig(config, stats, &config_vertex_);
+    setCommonConfig(config, stats, &config_edge_);
+    config_vertex_.count_vertices = count_vertices_;
+    config_vertex_.count_vertex_appliers = 2;
+    config_vertex_.enable_fault_tolerance = false;
+    config_vertex_.enable_tile_partitioning = true;
+    config_vertex_.local_reducer_mode = LocalReducerMode::LRM_GlobalReducer;
+    config_vertex_.global_fetcher_mode = GlobalFetcherMode::GFM_Active;
+    config_edge_.processed_rb_size = 64 * MB;
+    config_edge_.read_tiles_rb_size = 64 * MB;
+    config_edge_.count_followers = 0;
+    config_edge_.tile_processor_mode = TileProcessorMode::TPM_Active;
+    config_edge_.tile_processor_input_mode =
+        TileProcessorInputMode::TPIM_VertexFetcher;
+    config_edge_.tile_processor_output_mode =
+        TileProcessorOutputMode::TPOM_VertexReducer;
+  }
+
+  // The vertex to tile index of the selective scheduling, the way
+  // tile-indexer writes it.
+  static void writeTileIndex(const config_t& config,
+                             const scenario_stats_t& stats) {
+    std::vector<uint32_t> count_tiles_per_vertex(count_vertices_, 0);
+    std::vector<std::vector<uint32_t> > vertex_to_tiles(count_vertices_);
+    for (int i = 0; i < count_edge_engines_; ++i) {
+      thread_index_t thread_index;
+      thread_index.count = count_edge_engines_;
+      thread_index.id = i;
+      pg::IndexReader reader(config.path_to_globals, config.paths_to_meta,
+                             config.paths_to_tile, count_vertices_,
+                             stats.count_tiles, stats.is_index_32_bits,
+                             thread_index);
+      reader.start();
+      reader.join();
+      for (size_t id = 0; id < count_vertices_; ++id) {
+        const std::vector<uint32_t>& tiles =
+            *reader.vertex_to_tiles_index_[id];
+        vertex_to_tiles[id].insert(vertex_to_tiles[id].end(), tiles.begin(),
+                                   tiles.end());
+        count_tiles_per_vertex[id] += tiles.size();
+      }
+    }
+    std::vector<uint32_t> index;
+    for (const auto& tiles : vertex_to_tiles) {
+      index.insert(index.end(), tiles.begin(), tiles.end());
+    }
+    util::writeDataToFile(
+        core::getVertexToTileCountFileName(config.path_to_globals),
+        count_tiles_per_vertex.data(),
+        sizeof(uint32_t) * count_tiles_per_vertex.size());
+    util::writeDataToFile(
+        core::getVertexToTileIndexFileName(config.path_to_globals),
+        index.data(), sizeof(uint32_t) * index.size());
+  }
+
+  virtual void TearDown() {
+    for (const auto& dir : dirs_) {
+      std::string command = "rm -rf " + dir;
+      ASSERT_EQ(0, system(command.c_str()));
+    }
+  }
+
+  std::string makeDir() {
+    char dir_template[] = "/tmp/engine-test-XXXXXX";
+    EXPECT_TRUE(mkdtemp(dir_template) != NULL);
+    dirs_.push_back(dir_template);
+    return std::string(dir_template) + "/";
+  }
+
+  static void setCommonConfig(const config_t& graph,
+                              const scenario_stats_t& stats, config_t* config) {
+    config->path_to_globals = graph.path_to_globals;
+    config->paths_to_meta = graph.paths_to_meta;
+    config->paths_to_tile = graph.paths_to_tile;
+    config->count_tiles = stats.count_tiles;
+    config->count_edge_processors = count_edge_engines_;
+    config->count_tile_readers = 1;
+    config->count_tile_processors = 2;
+    config->count_vertex_reducers = 2;
+    // the vertex fetchers grab the tiles of the next round ahead of time,
+    // more fetchers than tiles of an edge engine would fetch a tile twice
+    config->count_vertex_fetchers = 1;
+    config->count_global_reducers = 2;
+    config->count_global_fetchers = 2;
+    config->count_index_readers = 1;
+    config->port = 0;
+    config->is_index_32_bits = stats.is_index_32_bits;
+    config->is_graph_weighted = stats.is_weighted_graph;
+    config->in_memory_mode = true;
+    config->run_on_mic = false;
+    config->use_smt = false;
+    config->use_selective_scheduling = false;
+    config->do_perfmon = false;
+    config->enable_perf_event_collection = false;
+    config->host_tiles_rb_size = 64 * MB;
+    config->local_fetcher_mode = LocalFetcherMode::LFM_DirectAccess;
+  }
+
+  // Runs APP on a copy of the configuration and returns the vertex array.
+  template <class APP>
+  std::vector<typename APP::VertexType> run(const std::string& algorithm,
+                                            int max_iterations) {
+    config_vertex_domain_t config_vertex = config_vertex_;
+    config_edge_processor_t config_edge = config_edge_;
+    config_vertex.algorithm = algorithm;
+    config_edge.algorithm = algorithm;
+    config_vertex.max_iterations = max_iterations;
+    config_edge.max_iterations = max_iterations;
+    config_vertex.path_to_result = dirs_[0] + "/" + algorithm + ".dat";
+
+    core::executeEngine<APP, typename APP::VertexType, uint32_t, false>(
+        config_vertex, config_edge);
+
+    std::vector<typename APP::VertexType> result(count_vertices_);
+    util::readDataFromFile(config_vertex.path_to_result,
+                           sizeof(result[0]) * result.size(), result.data());
+    return result;
+  }
+
+  static const int count_edge_engines_ = 2;
+  static const uint64_t count_vertices_ = 150000;
+  static const size_t count_edges_ = 600000;
+  config_vertex_domain_t config_vertex_;
+  config_edge_processor_t config_edge_;
+  std::vector<edge_t> edges_;
+  std::vector<std::string> dirs_;
+};
+
+const int EngineTest::count_edge_engines_;
+const uint64_t EngineTest::count_vertices_;
+const size_t EngineTest::count_edges_;
@@ -0,0 +1,86 @@
+#include "gtest/gtest.h"
+#include <core/datatypes.h>
+#include "../lib/core/algorithms/bfs.h"
+#include "../lib/core/algorithms/kcore.h"
+#include "../lib/core/algorithms/label-propagation.h"
+#include "engine-fixture.h"
+#include "simulation.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace core = scalable_graphs::core;
+
+TEST_F(EngineTest, BfsFinishesWithSelectiveScheduling) {
+  Simulation<core::BFS> simulation(count_vertices_, edges_);
+  simulation.init(NULL);
+  int count_rounds = simulation.run(1000);
+  ASSERT_LT(count_rounds, 1000);
+
+  // the in-memory mode reads every tile once and skips the inactive ones
+  // afterwards, it used to hang in the first round
+  config_vertex_.use_selective_scheduling = true;
+  config_edge_.use_selective_scheduling = true;
+  std::vector<core::BFS::VertexType> vertices = run<core::BFS>("bfs", 1000);
+  for (size_t i = 0; i < count_vertices_; ++i) {
+    ASSERT_EQ(simulation.current()[i], vertices[i]) << i;
+  }
+}
+
+TEST_F(EngineTest, KCoreAdvancesBuckets) {
+  Simulation<core::KCore> simulation(count_vertices_, edges_);
+  simulation.init(NULL);
+  int count_rounds = simulation.run(1000);
+  ASSERT_LT(count_rounds, 1000);
+
+  // the appliers pick the next bucket and activate it between themselves
+  config_vertex_.count_vertex_appliers = 4;
+  std::vector<core::KCore::VertexType> vertices =
+      run<core::KCore>("kcore", 1000);
+  uint32_t max_core = 0;
+  for (size_t i = 0; i < count_vertices_; ++i) {
+    ASSERT_EQ(simulation.current()[i].core, vertices[i].core) << i;
+    max_core = std::max(max_core, vertices[i].core);
+  }
+  // advanced past the first bucket at least twice
+  ASSERT_LE(2u, max_core);
+}
+
+TEST_F(EngineTest, KCoreReducesLocally) {
+  Simulation<core::KCore> simulation(count_vertices_, edges_);
+  simulation.init(NULL);
+  int count_rounds = simulation.run(1000);
+  ASSERT_LT(count_rounds, 1000);
+
+  // the global reducers only count the tiles of a round from the dummy blocks
+  for (LocalReducerMode mode :
+       {LocalReducerMode::LRM_Locking, LocalReducerMode::LRM_Atomic}) {
+    config_vertex_.local_reducer_mode = mode;
+    std::vector<core::KCore::VertexType> vertices =
+        run<core::KCore>("kcore", 1000);
+    for (size_t i = 0; i < count_vertices_; ++i) {
+      ASSERT_EQ(simulation.current()[i].core, vertices[i].core)
+          << i << ", mode " << static_cast<int>(mode);
+    }
+  }
+}
+
+TEST_F(EngineTest, LabelPropagationSkipsStableTiles) {
+  // room in the sketch for all labels around a vertex
+  typedef core::LabelPropagation<32> LabelPropagation;
+  Simulation<LabelPropagation> simulation(count_vertices_, edges_);
+  simulation.init(NULL);
+  int count_rounds = simulation.run(100);
+  ASSERT_LT(count_rounds, 100);
+
+  for (bool use_selective_scheduling : {false, true}) {
+    config_vertex_.use_selective_scheduling = use_selective_scheduling;
+    config_edge_.use_selective_scheduling = use_selective_scheduling;
+    std::vector<LabelPropagation::VertexType> vertices =
+        run<LabelPropagation>("label-propagation", count_rounds);
+    for (size_t i = 0; i < count_vertices_; ++i) {
+      ASSERT_EQ(simulation.current()[i].label, vertices[i].label)
+          << i << ", selective " << use_selective_scheduling;
+    }
+  }
+}
@@ -0,0 +1,140 @@
+#include "gtest/gtest.h"
+#include <core/datatypes.h>
+#include <core/util.h>
+#include "../lib/core/algorithms/pagerank.h"
+#include "../lib/core/algorithms/pagerank-delta.h"
+#include "../lib/core/algorithms/cc.h"
+#include "simulation.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace core = scalable_graphs::core;
+
+static const size_t count_vertices = 8;
+// both variants stop once the changes per vertex drop below EPSILON
+static const float tolerance = 10 * EPSILON;
+
+static std::vector<edge_t> getGraph() {
+  return {{0, 1}, {0, 2}, {1, 2}, {2, 0}, {3, 2}, {4, 3}, {4, 5},
+          {5, 4}, {6, 5}, {6, 7}, {7, 6}, {1, 3}, {5, 6}};
+}
+
+static std::vector<edge_t> applyChanges(std::vector<edge_t> edges,
+                                        const std::vector<edge_t>& insertions,
+                                        const std::vector<edge_t>& deletions) {
+  for (const auto& deletion : deletions) {
+    auto it = std::find_if(edges.begin(), edges.end(), [&](const edge_t& e) {
+      return e.src == deletion.src && e.tgt == deletion.tgt;
+    });
+    edges.erase(it);
+  }
+  edges.insert(edges.end(), insertions.begin(), insertions.end());
+  return edges;
+}
+
+static incremental_args_t getArgs(const void* previous, size_t size,
+                                  const std::vector<edge_t>& insertions,
+                                  const std::vector<edge_t>& deletions) {
+  incremental_args_t args;
+  args.previous_vertices = previous;
+  args.size_previous_vertices = size;
+  args.insertions = insertions.data();
+  args.count_insertions = insertions.size();
+  args.deletions = deletions.data();
+  args.count_deletions = deletions.size();
+  return args;
+}
+
+// Jacobi-PageRank, run to a fixed number of rounds, as reference.
+static std::vector<float> runPageRank(const std::vector<edge_t>& edges) {
+  Simulation<core::PageRank> simulation(count_vertices, edges);
+  simulation.init(NULL);
+  simulation.run(100);
+  return std::vector<float>(simulation.current(),
+                            simulation.current() + count_vertices);
+}
+
+TEST(IncrementalTest, PageRankDeltaFromScratch) {
+  std::vector<float> expected = runPageRank(getGraph());
+
+  Simulation<core::PageRankDelta> simulation(count_vertices, getGraph());
+  simulation.init(NULL);
+  ASSERT_LT(simulation.run(100), 100);
+  for (size_t i = 0; i < count_vertices; ++i) {
+    ASSERT_NEAR(expected[i], simulation.current()[i].rank, tolerance);
+  }
+}
+
+TEST(IncrementalTest, PageRankDeltaIncremental) {
+  std::vector<float> previous = runPageRank(getGraph());
+
+  // changes the out-degree of 0, 1 and 3, 1 loses all of its old edges
+  std::vector<edge_t> insertions = {{0, 7}, {3, 4}, {1, 0}};
+  std::vector<edge_t> deletions = {{1, 2}, {1, 3}};
+  std::vector<edge_t> edges = applyChanges(getGraph(), insertions, deletions);
+  std::vector<float> expected = runPageRank(edges);
+
+  Simulation<core::PageRankDelta> simulation(count_vertices, edges);
+  incremental_args_t args =
+      getArgs(previous.data(), sizeof(float) * previous.size(), insertions,
+              deletions);
+  simulation.init(&args);
+  // only the changed sources and the targets of changed edges start active
+  ASSERT_GT(simulation.countActive(), 0);
+  ASSERT_LE(simulation.countActive(), 6);
+  ASSERT_LT(simulation.run(100), 100);
+  for (size_t i = 0; i < count_vertices; ++i) {
+    ASSERT_NEAR(expected[i], simulation.current()[i].rank, tolerance);
+  }
+}
+
+TEST(IncrementalTest, PageRankDeltaIncrementalUnchanged) {
+  std::vector<float> previous = runPageRank(getGraph());
+
+  Simulation<core::PageRankDelta> simulation(count_vertices, getGraph());
+  std::vector<edge_t> none;
+  incremental_args_t args =
+      getArgs(previous.data(), sizeof(float) * previous.size(), none, none);
+  simulation.init(&args);
+  ASSERT_EQ(0, simulation.countActive());
+  ASSERT_EQ(0, simulation.run(100));
+}
+
+static std::vector<uint32_t> runCC(const std::vector<edge_t>& edges,
+                                   incremental_args_t* args) {
+  Simulation<core::CC> simulation(count_vertices, edges);
+  simulation.init(args);
+  simulation.run(100);
+  return std::vector<uint32_t>(simulation.current(),
+                               simulation.current() + count_vertices);
+}
+
+static std::vector<edge_t> symmetrize(std::vector<edge_t> edges) {
+  size_t count = edges.size();
+  for (size_t i = 0; i < count; ++i) {
+    edges.push_back({edges[i].tgt, edges[i].src});
+  }
+  return edges;
+}
+
+TEST(IncrementalTest, CCIncremental) {
+  std::vector<edge_t> graph = symmetrize({{0, 1}, {1, 2}, {2, 3}, {4, 5}});
+  std::vector<uint32_t> previous = runCC(graph, NULL);
+  ASSERT_EQ(0, previous[3]);
+  ASSERT_EQ(4, previous[5]);
+
+  // split {0, 1, 2, 3} into {0, 1} and {2, 3}, merge {2, 3} with {4, 5}
+  std::vector<edge_t> insertions = symmetrize({{3, 4}});
+  std::vector<edge_t> deletions = symmetrize({{1, 2}});
+  std::vector<edge_t> edges = applyChanges(graph, insertions, deletions);
+  std::vector<uint32_t> expected = runCC(edges, NULL);
+
+  incremental_args_t args =
+      getArgs(previous.data(), sizeof(uint32_t) * previous.size(), insertions,
+              deletions);
+  std::vector<uint32_t> labels = runCC(edges, &args);
+  ASSERT_EQ(expected, labels);
+  ASSERT_EQ(0, labels[1]);
+  ASSERT_EQ(2, labels[5]);
+}
@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+#include <core/datatypes.h>
+#include <core/util.h>
+#include "../lib/core/algorithms/kcore.h"
+#include "simulation.h"
+
+#include <random>
+#include <set>
+#include <vector>
+
+namespace core = scalable_graphs::core;
+
+// Symmetric random graph, without self-loops and duplicates.
+static std::vector<edge_t> getGraph(size_t count_vertices, size_t count_edges) {
+  std::mt19937 generator(13);
+  std::uniform_int_distribution<uint64_t> vertex(0, count_vertices - 1);
+  std::set<std::pair<uint64_t, uint64_t> > pairs;
+  while (pairs.size() < count_edges) {
+    uint64_t u = vertex(generator);
+    uint64_t v = vertex(generator);
+    if (u != v) {
+      pairs.insert(std::make_pair(std::min(u, v), std::max(u, v)));
+    }
+  }
+  std::vector<edge_t> edges;
+  for (const auto& pair : pairs) {
+    edges.push_back({pair.first, pair.second});
+    edges.push_back({pair.second, pair.first});
+  }
+  return edges;
+}
+
+// Sequential peeling, removing one vertex of minimal degree at a time.
+static std::vector<uint32_t> getCoreness(size_t count_vertices,
+                                         const std::vector<edge_t>& edges) {
+  std::vector<std::vector<uint64_t> > neighbors(count_vertices);
+  for (const auto& edge : edges) {
+    neighbors[edge.src].push_back(edge.tgt);
+  }
+  std::vector<uint32_t> degrees(count_vertices);
+  for (size_t i = 0; i < count_vertices; ++i) {
+    degrees[i] = neighbors[i].size();
+  }
+  std::vector<uint32_t> coreness(count_vertices, UINT32_MAX);
+  uint32_t k = 0;
+  for (size_t count_peeled = 0; count_peeled < count_vertices;
+       ++count_peeled) {
+    uint64_t min_vertex = 0;
+    uint32_t min_degree = UINT32_MAX;
+    for (size_t i = 0; i < count_vertices; ++i) {
+      if (coreness[i] == UINT32_MAX && degrees[i] < min_degree) {
+        min_vertex = i;
+        min_degree = degrees[i];
+      }
+    }
+    k = std::max(k, min_degree);
+    coreness[min_vertex] = k;
+    for (uint64_t neighbor : neighbors[min_vertex]) {
+      --degrees[neighbor];
+    }
+  }
+  return coreness;
+}
+
+TEST(KCoreTest, Clique) {
+  // K5 with a tail of two vertices
+  std::vector<edge_t> edges;
+  for (uint64_t u = 0; u < 5; ++u) {
+    for (uint64_t v = 0; v < 5; ++v) {
+      if (u != v) {
+        edges.push_back({u, v});
+      }
+    }
+  }
+  edges.push_back({4, 5});
+  edges.push_back({5, 4});
+  edges.push_back({5, 6});
+  edges.push_back({6, 5});
+
+  Simulation<core::KCore> simulation(8, edges);
+  simulation.init(NULL);
+  simulation.run(100);
+  std::vector<uint32_t> expected = {4, 4, 4, 4, 4, 1, 1, 0};
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(expected[i], simulation.current()[i].core) << "vertex " << i;
+  }
+}
+
+TEST(KCoreTest, MatchesSequentialPeeling) {
+  std::vector<edge_t> edges = getGraph(300, 2000);
+  std::vector<uint32_t> expected = getCoreness(300, edges);
+
+  Simulation<core::KCore> simulation(300, edges);
+  simulation.init(NULL);
+  int count_rounds = simulation.run(1000);
+  ASSERT_LT(count_rounds, 1000);
+  for (size_t i = 0; i < 300; ++i) {
+    ASSERT_EQ(expected[i], simulation.current()[i].core) << "vertex " << i;
+  }
+
+  // later rounds only gather along the edges of the peeled vertices, every
+  // edge once in total
+  ASSERT_EQ(edges.size(), simulation.countGathers());
+}
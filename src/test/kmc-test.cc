@@ -0,0 +1,154 @@
+#include "gtest/gtest.h"
+#include <core/datatypes.h>
+#include <core/util.h>
+#include "../lib/core/algorithms/kmc.h"
+#include "simulation.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace core = scalable_graphs::core;
+
+typedef core::KMC<2> KMC;
+
+static const size_t kCountVertices = 1000;
+
+// The features derived from the ids.
+static std::vector<float> getFeatures(size_t count_vertices) {
+  std::vector<float> features(count_vertices);
+  for (size_t i = 0; i < count_vertices; ++i) {
+    features[i] = KMC::feature(i);
+  }
+  return features;
+}
+
+// Lloyd's algorithm on the features of the vertices, from the same centroids
+// spread over [min_feature, max_feature] and summing up in the same order as
+// the engines with a single applier.
+static std::vector<uint32_t> getClusters(
+    const std::vector<float>& features, float min_feature, float max_feature,
+    KMC::cluster_information_t* centroids) {
+  for (size_t i = 0; i < 2; ++i) {
+    centroids->cord_cluster[i] =
+        min_feature + (i + 0.5f) * (max_feature - min_feature) / 2;
+  }
+  float no_votes[2] = {0., 0.};
+  size_t count_vertices = features.size();
+  std::vector<uint32_t> clusters(count_vertices);
+  bool changed = true;
+  for (size_t round = 0; changed; ++round) {
+    changed = false;
+    double sums[4] = {0., 0., 0., 0.};
+    for (size_t i = 0; i < count_vertices; ++i) {
+      float x_cord = features[i];
+      uint32_t cluster = KMC::nearestCluster(x_cord, no_votes, *centroids);
+      changed |= round == 0 || cluster != clusters[i];
+      clusters[i] = cluster;
+      sums[2 * cluster] += 1.;
+      sums[2 * cluster + 1] += x_cord;
+    }
+    for (size_t i = 0; i < 2; ++i) {
+      if (sums[2 * i] > 0.) {
+        centroids->cord_cluster[i] = sums[2 * i + 1] / sums[2 * i];
+      }
+    }
+  }
+  return clusters;
+}
+
+TEST(KMCTest, MatchesLloydWithoutEdges) {
+  KMC::cluster_information_t expected_centroids;
+  std::vector<uint32_t> expected =
+      getClusters(getFeatures(kCountVertices), 0.f, 1.f, &expected_centroids);
+
+  Simulation<KMC> simulation(kCountVertices, std::vector<edge_t>());
+  simulation.init(NULL);
+  int count_rounds = simulation.run(100);
+  ASSERT_LT(count_rounds, 100);
+  for (size_t i = 0; i < kCountVertices; ++i) {
+    ASSERT_EQ(expected[i], simulation.current()[i].designated_cluster)
+        << "vertex " << i;
+  }
+  for (size_t i = 0; i < 2; ++i) {
+    ASSERT_FLOAT_EQ(expected_centroids.cord_cluster[i],
+                    KMC::cluster_info.cord_cluster[i]);
+  }
+  // the clusters split the features around the middle
+  ASSERT_LT(KMC::cluster_info.cord_cluster[0], 0.5);
+  ASSERT_GT(KMC::cluster_info.cord_cluster[1], 0.5);
+}
+
+TEST(KMCTest, NeighborsPullVertexAcrossBoundary) {
+  KMC::cluster_information_t centroids;
+  std::vector<uint32_t> clusters =
+      getClusters(getFeatures(kCountVertices), 0.f, 1.f, &centroids);
+
+  // the member of the lower cluster closest to the upper one
+  uint64_t boundary = kCountVertices;
+  for (uint64_t i = 0; i < kCountVertices; ++i) {
+    if (clusters[i] == 0 &&
+        (boundary == kCountVertices ||
+         KMC::feature(i) > KMC::feature(boundary))) {
+      boundary = i;
+    }
+  }
+  ASSERT_LT(boundary, kCountVertices);
+
+  // in-edges from members of the upper cluster only
+  std::vector<edge_t> edges;
+  for (uint64_t i = 0; i < kCountVertices && edges.size() < 20; ++i) {
+    if (clusters[i] == 1) {
+      edges.push_back({i, boundary});
+    }
+  }
+
+  Simulation<KMC> simulation(kCountVertices, edges);
+  simulation.init(NULL);
+  int count_rounds = simulation.run(100);
+  ASSERT_LT(count_rounds, 100);
+  ASSERT_EQ(1, simulation.current()[boundary].designated_cluster);
+}
+
+TEST(KMCTest, ReadsTheFeaturesFile) {
+  // two groups of features far off the range of the ones derived from the ids
+  char file_name[] = "/tmp/kmc-test-XXXXXX";
+  int fd = mkstemp(file_name);
+  ASSERT_NE(-1, fd);
+  std::string content;
+  for (size_t i = 0; i < kCountVertices; ++i) {
+    content += std::to_string((i % 2 == 0 ? 10. : 20.) + KMC::feature(i)) +
+               (i % 10 == 9 ? "\n" : " ");
+  }
+  ASSERT_EQ((ssize_t)content.size(),
+            write(fd, content.data(), content.size()));
+  close(fd);
+  std::vector<float> features;
+  core::readFeatureFile(file_name, &features);
+  unlink(file_name);
+  ASSERT_EQ(kCountVertices, features.size());
+
+  KMC::cluster_information_t expected_centroids;
+  std::vector<uint32_t> expected = getClusters(
+      features, *std::min_element(features.begin(), features.end()),
+      *std::max_element(features.begin(), features.end()),
+      &expected_centroids);
+
+  Simulation<KMC> simulation(kCountVertices, std::vector<edge_t>());
+  simulation.initFeatures(features);
+  int count_rounds = simulation.run(100);
+  ASSERT_LT(count_rounds, 100);
+  for (size_t i = 0; i < kCountVertices; ++i) {
+    ASSERT_EQ(expected[i], simulation.current()[i].designated_cluster)
+        << "vertex " << i;
+    ASSERT_EQ(i % 2, simulation.current()[i].designated_cluster)
+        << "vertex " << i;
+  }
+  for (size_t i = 0; i < 2; ++i) {
+    ASSERT_FLOAT_EQ(expected_centroids.cord_cluster[i],
+                    KMC::cluster_info.cord_cluster[i]);
+  }
+}
@@ -0,0 +1,181 @@
+#include "gtest/gtest.h"
+#include <core/datatypes.h>
+#include <core/util.h>
+#include <core/label-sketch.h>
+#include <core/csr-graph.h>
+#include <core/csr-engine.h>
+#include "../lib/core/algorithms/label-propagation.h"
+#include "simulation.h"
+
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace core = scalable_graphs::core;
+
+TEST(LabelPropagationTest, SketchTracksHeavyHitters) {
+  // label 7 holds more than a quarter of all votes, the rest is noise
+  std::mt19937 generator(3);
+  std::uniform_int_distribution<uint32_t> noise(100, 1000);
+  core::label_sketch_t<4> sketch = {};
+  core::label_sketch_t<4> other = {};
+  std::map<uint32_t, uint32_t> counts;
+  uint32_t count_votes = 0;
+  for (int i = 0; i < 2000; ++i) {
+    uint32_t vote = i % 3 == 0 ? 7 : noise(generator);
+    (i % 2 == 0 ? sketch : other).add(vote, 1);
+    ++counts[vote];
+    ++count_votes;
+  }
+  sketch.merge(other);
+
+  uint32_t total = 0;
+  for (size_t i = 0; i < 4; ++i) {
+    total += sketch.counts[i];
+  }
+  ASSERT_EQ(count_votes, total);
+  ASSERT_EQ(7, sketch.majority(0));
+  ASSERT_GE(sketch.count(7), counts[7]);
+
+  core::label_sketch_t<4> empty = {};
+  ASSERT_EQ(42, empty.majority(42));
+  ASSERT_EQ(0, empty.count(0));
+}
+
+TEST(LabelPropagationTest, SketchWithdrawsVotes) {
+  core::label_sketch_t<4> votes = {};
+  votes.add(1, 3);
+  votes.add(2, 2);
+
+  // a delta moving two votes from label 1 to the untracked label 3
+  core::label_sketch_t<4> delta = {};
+  delta.add(1, -2);
+  delta.add(3, 2);
+  ASSERT_EQ(-2, delta.count(1));
+  votes.merge(delta);
+  ASSERT_EQ(1, votes.count(1));
+  ASSERT_EQ(2, votes.count(3));
+  ASSERT_EQ(2, votes.majority(0));
+
+  // withdrawing the last vote empties the entry
+  votes.add(1, -1);
+  ASSERT_EQ(0, votes.count(1));
+
+  // negative entries are not taken over, a withdrawn vote without an empty
+  // entry is dropped
+  core::label_sketch_t<2> full = {};
+  full.add(5, -1);
+  full.add(6, -1);
+  full.add(7, -1);
+  ASSERT_EQ(0, full.count(7));
+  full.add(8, 1);
+  ASSERT_EQ(0, full.count(8));
+}
+
+TEST(LabelPropagationTest, FindsCliques) {
+  // three cliques of ten vertices in both directions, chained by single
+  // edges, with room in the sketch for all labels around a vertex
+  typedef core::LabelPropagation<16> LabelPropagation;
+  std::vector<edge_t> edges;
+  for (uint64_t clique = 0; clique < 3; ++clique) {
+    for (uint64_t u = 0; u < 10; ++u) {
+      for (uint64_t v = 0; v < 10; ++v) {
+        if (u != v) {
+          edges.push_back({clique * 10 + u, clique * 10 + v});
+        }
+      }
+    }
+  }
+  edges.push_back({9, 10});
+  edges.push_back({10, 9});
+  edges.push_back({19, 20});
+  edges.push_back({20, 19});
+
+  Simulation<LabelPropagation> simulation(30, edges);
+  simulation.init(NULL);
+  int count_rounds = simulation.run(50);
+  ASSERT_LT(count_rounds, 50);
+  ASSERT_EQ(0, simulation.countActive());
+
+  std::set<uint32_t> communities;
+  for (uint64_t clique = 0; clique < 3; ++clique) {
+    uint32_t label = simulation.current()[clique * 10].label;
+    for (uint64_t u = 1; u < 10; ++u) {
+      ASSERT_EQ(label, simulation.current()[clique * 10 + u].label)
+          << "vertex " << clique * 10 + u;
+    }
+    communities.insert(label);
+  }
+  ASSERT_EQ(3, communities.size());
+}
+
+// Label propagation counting all votes every round.
+static std::vector<uint32_t> getLabels(size_t count_vertices,
+                                       const std::vector<edge_t>& edges,
+                                       int count_rounds) {
+  std::vector<uint32_t> labels(count_vertices);
+  for (size_t i = 0; i < count_vertices; ++i) {
+    labels[i] = i;
+  }
+  for (int round = 0; round < count_rounds; ++round) {
+    std::vector<std::map<uint32_t, int> > votes(count_vertices);
+    for (const auto& edge : edges) {
+      ++votes[edge.tgt][labels[edge.src]];
+    }
+    std::vector<uint32_t> next(count_vertices);
+    for (size_t i = 0; i < count_vertices; ++i) {
+      ++votes[i][labels[i]];
+      int best_count = 0;
+      // ascending labels, ties go to the smaller one
+      for (const auto& vote : votes[i]) {
+        if (vote.second > best_count) {
+          next[i] = vote.first;
+          best_count = vote.second;
+        }
+      }
+    }
+    labels = next;
+  }
+  return labels;
+}
+
+TEST(LabelPropagationTest, SelectiveSchedulingKeepsTheLabels) {
+  // a sparse random graph, whose labels take a few rounds to settle, with
+  // room in the sketch for all labels around a vertex, so that the order of
+  // the votes does not matter
+  typedef core::LabelPropagation<32> LabelPropagation;
+  const size_t count_vertices = 500;
+  std::mt19937 generator(11);
+  std::uniform_int_distribution<uint64_t> vertex(0, count_vertices - 1);
+  std::vector<edge_t> edges;
+  for (size_t i = 0; i < 2000; ++i) {
+    edges.push_back({vertex(generator), vertex(generator)});
+  }
+  core::CsrGraph graph;
+  graph.build(count_vertices, edges, std::vector<float>(), false);
+
+  Simulation<LabelPropagation> simulation(count_vertices, edges);
+  simulation.init(NULL);
+  int count_rounds = simulation.run(100);
+  ASSERT_LT(count_rounds, 100);
+  // the votes kept from round to round add up to all votes
+  std::vector<uint32_t> expected =
+      getLabels(count_vertices, edges, count_rounds);
+  for (size_t i = 0; i < count_vertices; ++i) {
+    ASSERT_EQ(expected[i], simulation.current()[i].label) << "vertex " << i;
+  }
+
+  for (bool use_selective_scheduling : {false, true}) {
+    config_vertex_domain_t config;
+    config.max_iterations = count_rounds;
+    config.use_selective_scheduling = use_selective_scheduling;
+    core::CsrEngine<LabelPropagation, false> engine(config, graph, 4);
+    engine.init();
+    engine.run();
+    for (size_t i = 0; i < count_vertices; ++i) {
+      ASSERT_EQ(simulation.current()[i].label, engine.current()[i].label)
+          << "vertex " << i << ", selective " << use_selective_scheduling;
+    }
+  }
+}
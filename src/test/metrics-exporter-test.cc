@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+#include <util/metrics-exporter.h>
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <thread>
+
+#include <util/seqlock.h>
+
+namespace util = scalable_graphs::util;
+
+static std::string get(const std::string& path, const std::string& request) {
+  struct sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+    close(fd);
+    return "";
+  }
+  write(fd, request.data(), request.size());
+
+  std::string response;
+  char buffer[512];
+  ssize_t count;
+  while ((count = read(fd, buffer, sizeof(buffer))) > 0) {
+    response.append(buffer, count);
+  }
+  close(fd);
+  return response;
+}
+
+TEST(MetricsExporterTest, SamplesAreGroupedByMetric) {
+  util::PrometheusText text;
+  text.addCounter("edges_total", "Edges.", "edge_engine=\"0\"", 10);
+  text.addGauge("iteration", "Rounds.", "", 3);
+  text.addCounter("edges_total", "Edges.", "edge_engine=\"1\"", 12);
+
+  ASSERT_EQ("# HELP edges_total Edges.\n"
+            "# TYPE edges_total counter\n"
+            "edges_total{edge_engine=\"0\"} 10\n"
+            "edges_total{edge_engine=\"1\"} 12\n"
+            "# HELP iteration Rounds.\n"
+            "# TYPE iteration gauge\n"
+            "iteration 3\n",
+            text.toString());
+}
+
+TEST(MetricsExporterTest, SeqLockReadsConsistentSnapshot) {
+  const uint64_t count_writes = 1000 * 1000;
+  util::SeqLock lock;
+  volatile uint64_t a = 0;
+  volatile uint64_t b = 0;
+
+  std::thread writer([&]() {
+    for (uint64_t i = 1; i <= count_writes; ++i) {
+      lock.writeBegin();
+      a = i;
+      b = i;
+      lock.writeEnd();
+    }
+  });
+
+  uint64_t last = 0;
+  while (last < count_writes) {
+    uint64_t sequence, read_a, read_b;
+    do {
+      sequence = lock.readBegin();
+      read_a = a;
+      read_b = b;
+    } while (lock.readRetry(sequence));
+    ASSERT_EQ(read_a, read_b);
+    ASSERT_GE(read_a, last);
+    last = read_a;
+  }
+  writer.join();
+}
+
+TEST(MetricsExporterTest, ServesSourcesOnUnixSocket) {
+  std::string path = "/tmp/metrics-exporter-test-" +
+                     std::to_string(getpid()) + ".sock";
+  util::MetricsExporter* exporter = util::MetricsExporter::getInstance(path);
+
+  volatile uint64_t count_edges = 42;
+  int id = exporter->addSource([&count_edges](util::PrometheusText* text) {
+    text->addCounter("mosaic_edges_total", "Edges.", "", count_edges);
+  });
+
+  std::string response = get(path, "GET /metrics HTTP/1.1\r\n\r\n");
+  ASSERT_EQ(0, response.find("HTTP/1.0 200 OK\r\n"));
+  ASSERT_NE(std::string::npos, response.find("\nmosaic_edges_total 42\n"));
+
+  // Counters are read on every scrape.
+  count_edges = 43;
+  response = get(path, "GET /metrics HTTP/1.1\r\n\r\n");
+  ASSERT_NE(std::string::npos, response.find("\nmosaic_edges_total 43\n"));
+
+  exporter->removeSource(id);
+  response = get(path, "GET /metrics HTTP/1.1\r\n\r\n");
+  ASSERT_EQ(std::string::npos, response.find("mosaic_edges_total"));
+
+  response = get(path, "POST /metrics HTTP/1.1\r\n\r\n");
+  ASSERT_EQ(0, response.find("HTTP/1.0 400 Bad Request\r\n"));
+
+  exporter->stop();
+  exporter->join();
+  ASSERT_NE(0, access(path.c_str(), F_OK));
+}
@@ -0,0 +1,66 @@
+#include "gtest/gtest.h"
+#include <util/metrics.h>
+
+#include <ring_buffer.h>
+
+namespace util = scalable_graphs::util;
+
+TEST(MetricsTest, RecordToJson) {
+  util::MetricsRecord engine;
+  engine.addCount("engine", 0);
+  engine.addValue("edges_per_sec", 1.5);
+
+  util::MetricsRecord record;
+  record.addCount("iteration", 3);
+  record.addString("name", "pr \"fast\"");
+  record.addRecords("edge_engines", {engine, engine});
+  record.addRecord("barrier_wait", util::MetricsRecord());
+
+  ASSERT_EQ("{\"iteration\": 3, \"name\": \"pr \\\"fast\\\"\", "
+            "\"edge_engines\": [{\"engine\": 0, \"edges_per_sec\": 1.5}, "
+            "{\"engine\": 0, \"edges_per_sec\": 1.5}], "
+            "\"barrier_wait\": {}}",
+            record.toJson());
+}
+
+TEST(MetricsTest, NonFiniteValueToJson) {
+  util::MetricsRecord record;
+  record.addValue("residual", 1.0 / 0.0);
+  record.addValue("ratio", 0.0 / 0.0);
+  record.addValue("time_ms", 2.25);
+
+  ASSERT_EQ("{\"residual\": null, \"ratio\": null, \"time_ms\": 2.25}",
+            record.toJson());
+}
+
+TEST(MetricsTest, RingBufferHighWater) {
+  ring_buffer_t* rb;
+  ASSERT_EQ(0, ring_buffer_create(4 * 1024, 64, RING_BUFFER_NON_BLOCKING, NULL,
+                                  NULL, &rb));
+  ASSERT_EQ(0, ring_buffer_high_water(rb));
+
+  ring_buffer_req_t reqs[4];
+  for (int i = 0; i < 4; ++i) {
+    ring_buffer_put_req_init(&reqs[i], NON_BLOCKING, 256);
+    ASSERT_EQ(0, ring_buffer_put(rb, &reqs[i]));
+    ring_buffer_elm_set_ready(rb, reqs[i].data);
+  }
+  size_t high_water = ring_buffer_high_water(rb);
+  ASSERT_GE(high_water, 4 * 256);
+
+  // Draining the buffer keeps the mark until it is reset.
+  for (int i = 0; i < 4; ++i) {
+    ring_buffer_get_req_init(&reqs[i], NON_BLOCKING);
+    ASSERT_EQ(0, ring_buffer_get(rb, &reqs[i]));
+    ring_buffer_elm_set_done(rb, reqs[i].data);
+  }
+  ASSERT_EQ(high_water, ring_buffer_high_water(rb));
+
+  ring_buffer_reset_high_water(rb);
+  ASSERT_EQ(0, ring_buffer_high_water(rb));
+  ring_buffer_put_req_init(&reqs[0], NON_BLOCKING, 256);
+  ASSERT_EQ(0, ring_buffer_put(rb, &reqs[0]));
+  ASSERT_GE(ring_buffer_high_water(rb), 256);
+
+  ring_buffer_destroy(rb);
+}
@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+#include <core/datatypes.h>
+#include <core/util.h>
+#include "../lib/core/algorithms/ms-bfs.h"
+#include "simulation.h"
+
+#include <deque>
+#include <vector>
+
+namespace core = scalable_graphs::core;
+
+static const uint32_t unreached = UINT32_MAX;
+
+// Levels of a plain single-source BFS, as reference.
+static std::vector<uint32_t> runBFS(size_t count_vertices,
+                                    const std::vector<edge_t>& edges,
+                                    uint64_t root) {
+  std::vector<uint32_t> levels(count_vertices, unreached);
+  std::deque<uint64_t> queue = {root};
+  levels[root] = 0;
+  while (!queue.empty()) {
+    uint64_t u = queue.front();
+    queue.pop_front();
+    for (const auto& edge : edges) {
+      if (edge.src == u && levels[edge.tgt] == unreached) {
+        levels[edge.tgt] = levels[u] + 1;
+        queue.push_back(edge.tgt);
+      }
+    }
+  }
+  return levels;
+}
+
+// Runs MS-BFS round by round, the level of a vertex for root i is the round
+// in which bit i first appears in its visited-mask.
+static std::vector<std::vector<uint32_t>>
+runMSBFS(size_t count_vertices, const std::vector<edge_t>& edges,
+         std::vector<uint64_t> roots) {
+  std::vector<std::vector<uint32_t>> levels(
+      roots.size(), std::vector<uint32_t>(count_vertices, unreached));
+
+  Simulation<core::MSBFS> simulation(count_vertices, edges);
+  simulation.init(roots);
+  for (uint32_t level = 0; level <= count_vertices; ++level) {
+    for (size_t v = 0; v < count_vertices; ++v) {
+      for (size_t i = 0; i < roots.size(); ++i) {
+        if ((simulation.current()[v].visited & (1ul << i)) != 0 &&
+            levels[i][v] == unreached) {
+          levels[i][v] = level;
+        }
+      }
+    }
+    if (simulation.run(1) == 0) {
+      break;
+    }
+  }
+  return levels;
+}
+
+static std::vector<edge_t> getGraph() {
+  return {{0, 1}, {0, 2}, {1, 2}, {2, 0}, {3, 2}, {4, 3}, {4, 5},
+          {5, 4}, {6, 5}, {6, 7}, {7, 6}, {1, 3}, {5, 6}};
+}
+
+TEST(MSBFSTest, MatchesSingleSourceBFS) {
+  const size_t count_vertices = 8;
+  std::vector<uint64_t> roots = {0, 4, 7, 3};
+  std::vector<std::vector<uint32_t>> levels =
+      runMSBFS(count_vertices, getGraph(), roots);
+  for (size_t i = 0; i < roots.size(); ++i) {
+    ASSERT_EQ(runBFS(count_vertices, getGraph(), roots[i]), levels[i]);
+  }
+}
+
+TEST(MSBFSTest, SixtyFourRoots) {
+  // a directed ring, root i starts at vertex i
+  const size_t count_vertices = 100;
+  std::vector<edge_t> edges;
+  for (uint32_t i = 0; i < count_vertices; ++i) {
+    edges.push_back({i, (uint32_t)((i + 1) % count_vertices)});
+  }
+  std::vector<uint64_t> roots;
+  for (uint64_t i = 0; i < core::MSBFS::max_count_roots; ++i) {
+    roots.push_back(i);
+  }
+  std::vector<std::vector<uint32_t>> levels =
+      runMSBFS(count_vertices, edges, roots);
+  for (size_t i = 0; i < roots.size(); ++i) {
+    ASSERT_EQ(runBFS(count_vertices, edges, roots[i]), levels[i]);
+  }
+}
+
+TEST(MSBFSTest, StopsWhenAllFrontiersAreEmpty) {
+  // 0 -> 1 -> 2, vertex 3 is unreachable
+  std::vector<edge_t> edges = {{0, 1}, {1, 2}};
+  Simulation<core::MSBFS> simulation(4, edges);
+  simulation.init(std::vector<uint64_t>{0, 1});
+  ASSERT_EQ(2, simulation.countActive());
+  ASSERT_EQ(3, simulation.run(100));
+  ASSERT_EQ(0x1ul, simulation.current()[0].visited);
+  ASSERT_EQ(0x3ul, simulation.current()[1].visited);
+  ASSERT_EQ(0x3ul, simulation.current()[2].visited);
+  ASSERT_EQ(0x0ul, simulation.current()[3].visited);
+}
+
+TEST(MSBFSTest, SumsTheDistancesPerRoot) {
+  const size_t count_vertices = 8;
+  std::vector<uint64_t> roots = {0, 4, 7, 3, 4};
+  Simulation<core::MSBFS> simulation(count_vertices, getGraph());
+  simulation.init(roots);
+  simulation.run(100);
+
+  for (size_t i = 0; i < roots.size(); ++i) {
+    std::vector<uint32_t> levels = runBFS(count_vertices, getGraph(), roots[i]);
+    uint64_t count_reached = 0;
+    double sum_distances = 0.;
+    for (uint32_t level : levels) {
+      if (level != unreached) {
+        ++count_reached;
+        sum_distances += level;
+      }
+    }
+    ASSERT_EQ(count_reached, core::MSBFS::distances.count_reached[i]) << i;
+    ASSERT_EQ(sum_distances, core::MSBFS::distances.sum_distances[i]) << i;
+    ASSERT_DOUBLE_EQ((count_reached - 1) / sum_distances,
+                     core::MSBFS::closeness(i));
+  }
+}
@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+#include <util/perf-event/perf-event-counters.h>
+#include <util/perf-event/perf-event-manager.h>
+#include <util/perf-event/perf-event-scoped.h>
+
+#include <dirent.h>
+
+#include <map>
+#include <thread>
+
+namespace pe = scalable_graphs::util::perf_event;
+
+static const int kCycles = (int)PerfCounter::PC_Cycles;
+static const int kInstructions = (int)PerfCounter::PC_Instructions;
+
+static uint64_t spin(uint64_t count) {
+  volatile uint64_t sum = 0;
+  for (uint64_t i = 0; i < count; ++i) {
+    sum += i;
+  }
+  return sum;
+}
+
+TEST(PerfEventCountersTest, CountsTheOpeningThread) {
+  pe::PerfCounterGroup counters(ComponentType::CT_TileProcessor);
+  ASSERT_EQ(ComponentType::CT_TileProcessor, counters.getComponent());
+
+  profiling_counters_t before;
+  if (!counters.isOpen()) {
+    // No PMU or not permitted, e.g. in a VM, every counter is unavailable.
+    ASSERT_FALSE(counters.read(&before));
+    for (int i = 0; i < COUNT_PERF_COUNTERS; ++i) {
+      ASSERT_FALSE(before.available[i]);
+    }
+    return;
+  }
+
+  ASSERT_TRUE(counters.read(&before));
+  ASSERT_TRUE(before.available[kCycles]);
+  spin(10 * 1000 * 1000);
+
+  // Read from another thread, while this thread stays idle.
+  profiling_counters_t after;
+  bool read_after = false;
+  std::thread reader([&counters, &after, &read_after]() {
+    read_after = counters.read(&after);
+  });
+  reader.join();
+  ASSERT_TRUE(read_after);
+  ASSERT_GT(after.values[kCycles], before.values[kCycles]);
+  if (after.available[kInstructions]) {
+    ASSERT_GT(after.values[kInstructions] - before.values[kInstructions],
+              10 * 1000 * 1000u);
+  }
+}
+
+static int countOpenFiles() {
+  DIR* dir = opendir("/proc/self/fd");
+  int count = 0;
+  while (readdir(dir) != NULL) {
+    ++count;
+  }
+  closedir(dir);
+  return count;
+}
+
+TEST(PerfEventCountersTest, ExitedThreadsKeepTheirCounts) {
+  config_vertex_domain_t config;
+  config.enable_perf_counters = true;
+  pe::PerfEventManager manager(config);
+  int count_open_files = countOpenFiles();
+
+  for (int i = 0; i < 2; ++i) {
+    std::thread([&manager]() {
+      pe::PerfEventScoped scoped(&manager, "spin",
+                                 ComponentType::CT_TileProcessor, 0, true);
+      spin(10 * 1000 * 1000);
+    }).join();
+    // The counters of the thread are closed with it.
+    ASSERT_EQ(count_open_files, countOpenFiles());
+  }
+
+  std::map<ComponentType, profiling_counters_t> counters;
+  manager.readCounters(&counters);
+  pe::PerfCounterGroup probe(ComponentType::CT_None);
+  if (!probe.isOpen()) {
+    ASSERT_TRUE(counters.empty());
+    return;
+  }
+  ASSERT_EQ(1u, counters.size());
+  const profiling_counters_t& values =
+      counters[ComponentType::CT_TileProcessor];
+  ASSERT_TRUE(values.available[kCycles]);
+  if (values.available[kInstructions]) {
+    ASSERT_GT(values.values[kInstructions], 2 * 10 * 1000 * 1000u);
+  }
+}
+
+TEST(PerfEventCountersTest, AddAndDiffSkipUnavailableCounters) {
+  profiling_counters_t a, b, sum, diff;
+  pe::resetPerfCounterValues(&a);
+  pe::resetPerfCounterValues(&b);
+  pe::resetPerfCounterValues(&sum);
+  a.values[kCycles] = 100;
+  a.available[kCycles] = true;
+  b.values[kCycles] = 50;
+  b.available[kCycles] = true;
+  b.values[kInstructions] = 7;
+
+  pe::addPerfCounterValues(a, &sum);
+  pe::addPerfCounterValues(b, &sum);
+  ASSERT_EQ(150u, sum.values[kCycles]);
+  ASSERT_EQ(0u, sum.values[kInstructions]);
+  ASSERT_FALSE(sum.available[kInstructions]);
+
+  pe::diffPerfCounterValues(sum, a, &diff);
+  ASSERT_EQ(50u, diff.values[kCycles]);
+  ASSERT_TRUE(diff.available[kCycles]);
+  // Never negative, e.g. when a thread has gone away.
+  pe::diffPerfCounterValues(b, a, &diff);
+  ASSERT_EQ(0u, diff.values[kCycles]);
+}
+
+TEST(PerfEventCountersTest, CounterNames) {
+  ASSERT_STREQ("cycles", pe::getPerfCounterName(PerfCounter::PC_Cycles));
+  ASSERT_STREQ("llc_misses",
+               pe::getPerfCounterName(PerfCounter::PC_LLCMisses));
+}
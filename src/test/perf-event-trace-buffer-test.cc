@@ -0,0 +1,143 @@
+#include "gtest/gtest.h"
+#include <util/perf-event/perf-event-trace-buffer.h>
+#include <util/perf-event/perf-event-manager.h>
+
+#include <stdio.h>
+
+#include <thread>
+
+#include <util/util.h>
+
+namespace pe = scalable_graphs::util::perf_event;
+
+static trace_event_t makeEvent(uint64_t i) {
+  trace_event_t event;
+  event.tsc_start = i;
+  event.tsc_end = i + 1;
+  event.metadata = i;
+  event.local_id = 0;
+  event.global_id = 0;
+  event.name_id = 0;
+  event.tile_id = -1;
+  event.component = ComponentType::CT_None;
+  return event;
+}
+
+TEST(PerfEventTraceBufferTest, NamesAreInterned) {
+  pe::PerfEventNameTable names;
+  pe::PerfEventTraceBuffer buffer_a(&names, 16);
+  pe::PerfEventTraceBuffer buffer_b(&names, 16);
+
+  uint32_t tile = buffer_a.internName("tile");
+  uint32_t apply = buffer_a.internName("apply");
+  ASSERT_NE(tile, apply);
+  ASSERT_EQ(tile, buffer_a.internName("tile"));
+  // Same id in another thread's buffer, even for another copy of the name.
+  std::string tile_copy = "tile";
+  ASSERT_EQ(tile, buffer_b.internName(tile_copy.c_str()));
+  ASSERT_EQ("tile", names.getName(tile));
+  ASSERT_EQ("apply", names.getName(apply));
+}
+
+TEST(PerfEventTraceBufferTest, DrainInAppendOrder) {
+  pe::PerfEventNameTable names;
+  pe::PerfEventTraceBuffer buffer(&names, 16);
+
+  trace_event_t events[16];
+  for (uint64_t round = 0; round < 10; ++round) {
+    for (uint64_t i = 0; i < 10; ++i) {
+      ASSERT_TRUE(buffer.append(makeEvent(round * 10 + i)));
+    }
+    ASSERT_EQ(4, buffer.drain(events, 4));
+    ASSERT_EQ(6, buffer.drain(events + 4, 16));
+    ASSERT_EQ(0, buffer.drain(events, 16));
+    for (uint64_t i = 0; i < 10; ++i) {
+      ASSERT_EQ(round * 10 + i, events[i].tsc_start);
+    }
+  }
+  ASSERT_EQ(0, buffer.getCountDropped());
+}
+
+TEST(PerfEventTraceBufferTest, FullBufferDropsEvents) {
+  pe::PerfEventNameTable names;
+  pe::PerfEventTraceBuffer buffer(&names, 8);
+
+  for (uint64_t i = 0; i < 8; ++i) {
+    ASSERT_TRUE(buffer.append(makeEvent(i)));
+  }
+  ASSERT_FALSE(buffer.append(makeEvent(8)));
+  ASSERT_FALSE(buffer.append(makeEvent(9)));
+  ASSERT_EQ(2, buffer.getCountDropped());
+
+  // Draining makes room again, the dropped events are gone.
+  trace_event_t events[8];
+  ASSERT_EQ(8, buffer.drain(events, 8));
+  ASSERT_EQ(7, events[7].tsc_start);
+  ASSERT_TRUE(buffer.append(makeEvent(10)));
+  ASSERT_EQ(1, buffer.drain(events, 8));
+  ASSERT_EQ(10, events[0].tsc_start);
+}
+
+TEST(PerfEventTraceBufferTest, ConcurrentDrainSeesAllEvents) {
+  const uint64_t count_events = 1000 * 1000;
+  pe::PerfEventNameTable names;
+  pe::PerfEventTraceBuffer buffer(&names, 1024);
+
+  std::thread producer([&buffer, count_events]() {
+    for (uint64_t i = 0; i < count_events; ++i) {
+      while (!buffer.append(makeEvent(i))) {
+      }
+    }
+  });
+
+  trace_event_t events[64];
+  uint64_t expected = 0;
+  while (expected < count_events) {
+    size_t count = buffer.drain(events, 64);
+    for (size_t i = 0; i < count; ++i, ++expected) {
+      ASSERT_EQ(expected, events[i].tsc_start);
+    }
+  }
+  producer.join();
+}
+
+TEST(PerfEventTraceBufferTest, BuffersOfExitedThreadsAreRecycled) {
+  config_vertex_domain_t config;
+  pe::PerfEventManager manager(config);
+  FILE* file = tmpfile();
+  ASSERT_TRUE(file != NULL);
+
+  pe::PerfEventTraceBuffer* first = nullptr;
+  std::thread([&manager, &first]() {
+    first = manager.getTraceBuffer();
+    ASSERT_EQ(first, manager.getTraceBuffer());
+    for (uint64_t i = 0; i < 3; ++i) {
+      ASSERT_TRUE(first->append(makeEvent(i)));
+    }
+  }).join();
+  // The events traced until the exit are still written.
+  ASSERT_EQ(3, manager.drainTraceBuffers(file));
+
+  pe::PerfEventTraceBuffer* second = nullptr;
+  std::thread([&manager, &second]() {
+    second = manager.getTraceBuffer();
+    ASSERT_TRUE(second->append(makeEvent(7)));
+  }).join();
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(1, manager.drainTraceBuffers(file));
+  ASSERT_EQ(0, manager.drainTraceBuffers(file));
+  ASSERT_EQ(0, manager.getCountDroppedEvents());
+  fclose(file);
+}
+
+TEST(PerfEventTraceBufferTest, ClockMatchesMonotonicTime) {
+  pe::PerfEventClock clock;
+  clock.calibrate(10 * 1000);
+  ASSERT_GT(clock.getTicksPerNsec(), 0.);
+
+  uint64_t tsc = rdtsc();
+  uint64_t nsec = scalable_graphs::util::get_time_nsec();
+  int64_t error_nsec = (int64_t)clock.toNsec(tsc) - (int64_t)nsec;
+  // Within 1ms of the monotonic clock.
+  ASSERT_LT(std::abs(error_nsec), 1000 * 1000);
+}
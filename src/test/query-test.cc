@@ -0,0 +1,109 @@
+#include "gtest/gtest.h"
+#include <core/datatypes.h>
+#include <core/util.h>
+#include "../lib/core/algorithms/cc.h"
+#include "../lib/core/algorithms/pagerank.h"
+#include "engine-fixture.h"
+#include "simulation.h"
+
+#include <string>
+#include <vector>
+
+namespace core = scalable_graphs::core;
+
+TEST(QueryTest, AlgorithmOnly) {
+  query_t query;
+  std::string error;
+  ASSERT_TRUE(core::parseQuery("cc", &query, &error));
+  ASSERT_EQ("cc", query.algorithm);
+  ASSERT_TRUE(query.roots.empty());
+  ASSERT_EQ(0, query.max_iterations);
+  ASSERT_TRUE(query.path_to_output.empty());
+}
+
+TEST(QueryTest, AllParameters) {
+  query_t query;
+  std::string error;
+  ASSERT_TRUE(core::parseQuery(
+      "  ms-bfs roots=3,17,42\tmax-iterations=12 output=/tmp/levels  ", &query,
+      &error));
+  ASSERT_EQ("ms-bfs", query.algorithm);
+  ASSERT_EQ(std::vector<uint64_t>({3, 17, 42}), query.roots);
+  ASSERT_EQ(12, query.max_iterations);
+  ASSERT_EQ("/tmp/levels", query.path_to_output);
+}
+
+TEST(QueryTest, ResetsPreviousQuery) {
+  query_t query;
+  std::string error;
+  ASSERT_TRUE(core::parseQuery("bfs roots=1 max-iterations=3 output=a", &query,
+                               &error));
+  ASSERT_TRUE(core::parseQuery("sssp", &query, &error));
+  ASSERT_EQ("sssp", query.algorithm);
+  ASSERT_TRUE(query.roots.empty());
+  ASSERT_EQ(0, query.max_iterations);
+  ASSERT_TRUE(query.path_to_output.empty());
+}
+
+TEST(QueryTest, Malformed) {
+  query_t query;
+  std::string error;
+  ASSERT_FALSE(core::parseQuery("", &query, &error));
+  ASSERT_FALSE(core::parseQuery("bfs 17", &query, &error));
+  ASSERT_FALSE(core::parseQuery("bfs roots=1,x", &query, &error));
+  ASSERT_FALSE(core::parseQuery("bfs roots=-1", &query, &error));
+  ASSERT_FALSE(core::parseQuery("bfs roots=123456789012345678901", &query,
+                                &error));
+  ASSERT_FALSE(core::parseQuery("bfs max-iterations=0", &query, &error));
+  ASSERT_FALSE(core::parseQuery("bfs max-iterations=", &query, &error));
+  ASSERT_FALSE(core::parseQuery("bfs output=", &query, &error));
+  ASSERT_FALSE(core::parseQuery("bfs depth=3", &query, &error));
+  ASSERT_EQ("unknown key depth", error);
+}
+
+// The engines run the queries the way the query server runs them.
+class QueryServerTest : public EngineTest {};
+
+TEST_F(QueryServerTest, RunsQueriesOnResidentGraph) {
+  resident_graph_t graph;
+  core::loadResidentGraph(config_vertex_, &graph);
+  config_vertex_.resident_graph = &graph;
+  for (int i = 0; i < count_edge_engines_; ++i) {
+    ASSERT_TRUE(graph.tiles[i].tile_container != NULL);
+    ASSERT_TRUE(graph.tiles[i].tile_container->isMapped());
+    ASSERT_TRUE(graph.tiles[i].delta_tile_container != NULL);
+    ASSERT_TRUE(graph.tiles[i].delta_tile_container->isMapped());
+  }
+
+  Simulation<core::PageRank> pagerank(count_vertices_, edges_);
+  pagerank.init(NULL);
+  int count_pagerank_rounds = pagerank.run(5);
+  Simulation<core::CC> cc(count_vertices_, edges_);
+  cc.init(std::vector<uint64_t>());
+  cc.run(30);
+
+  // two different algorithms one after the other, then the first one again,
+  // on the same containers
+  for (int k = 0; k < 2; ++k) {
+    std::vector<float> ranks =
+        run<core::PageRank>("pagerank", count_pagerank_rounds);
+    // the sums are taken in a different order
+    for (size_t i = 0; i < count_vertices_; ++i) {
+      ASSERT_NEAR(pagerank.current()[i], ranks[i],
+                  1e-4 * pagerank.current()[i])
+          << i;
+    }
+    if (k == 1) {
+      break;
+    }
+    std::vector<core::CC::VertexType> labels = run<core::CC>("cc", 30);
+    for (size_t i = 0; i < count_vertices_; ++i) {
+      ASSERT_EQ(cc.current()[i], labels[i]) << i;
+    }
+  }
+
+  for (int i = 0; i < count_edge_engines_; ++i) {
+    ASSERT_TRUE(graph.tiles[i].tile_container->isMapped());
+  }
+  core::freeResidentGraph(&graph);
+}
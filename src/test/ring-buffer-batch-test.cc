@@ -0,0 +1,90 @@
+#include "gtest/gtest.h"
+#include <ring_buffer.h>
+
+#include <string.h>
+
+static const unsigned int kCountRequests = 8;
+
+class RingBufferBatchTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    int rc = ring_buffer_create(4 * 1024, 64, RING_BUFFER_NON_BLOCKING, NULL,
+                                NULL, &rb_);
+    ASSERT_EQ(0, rc);
+  }
+
+  virtual void TearDown() { ring_buffer_destroy(rb_); }
+
+  ring_buffer_t* rb_;
+};
+
+TEST_F(RingBufferBatchTest, PutBatchThenGetBatch) {
+  ring_buffer_req_t put_reqs[kCountRequests];
+  ring_buffer_put_req_init(&put_reqs[0], NON_BLOCKING, 10);
+  for (unsigned int i = 1; i < kCountRequests; ++i) {
+    ring_buffer_put_req_init(&put_reqs[i], NON_BLOCKING, 10 + 20 * i);
+  }
+  ASSERT_EQ(0, ring_buffer_put_batch(rb_, put_reqs, kCountRequests));
+  for (unsigned int i = 0; i < kCountRequests; ++i) {
+    memset(put_reqs[i].data, i, put_reqs[i].size);
+    ring_buffer_elm_set_ready(rb_, put_reqs[i].data);
+  }
+
+  // claimed in two batches, in the order of the puts
+  ring_buffer_req_t get_reqs[kCountRequests];
+  ring_buffer_get_req_init(&get_reqs[0], NON_BLOCKING);
+  ASSERT_EQ(5, ring_buffer_get_batch(rb_, get_reqs, 5));
+  ring_buffer_get_req_init(&get_reqs[5], NON_BLOCKING);
+  ASSERT_EQ(3, ring_buffer_get_batch(rb_, &get_reqs[5], kCountRequests - 5));
+  for (unsigned int i = 0; i < kCountRequests; ++i) {
+    ASSERT_EQ(put_reqs[i].data, get_reqs[i].data);
+    ASSERT_EQ(10 + 20 * i, get_reqs[i].size);
+    ASSERT_EQ(i, ((unsigned char*)get_reqs[i].data)[get_reqs[i].size - 1]);
+    ring_buffer_elm_set_done(rb_, get_reqs[i].data);
+  }
+  ASSERT_TRUE(ring_buffer_is_empty(rb_));
+}
+
+TEST_F(RingBufferBatchTest, GetBatchStopsAtElementNotReady) {
+  ring_buffer_req_t put_reqs[3];
+  for (unsigned int i = 0; i < 3; ++i) {
+    ring_buffer_put_req_init(&put_reqs[i], NON_BLOCKING, 64);
+  }
+  ASSERT_EQ(0, ring_buffer_put_batch(rb_, put_reqs, 3));
+  ring_buffer_elm_set_ready(rb_, put_reqs[0].data);
+  ring_buffer_elm_set_ready(rb_, put_reqs[2].data);
+
+  ring_buffer_req_t get_reqs[3];
+  ring_buffer_get_req_init(&get_reqs[0], NON_BLOCKING);
+  ASSERT_EQ(1, ring_buffer_get_batch(rb_, get_reqs, 3));
+  ASSERT_EQ(put_reqs[0].data, get_reqs[0].data);
+}
+
+TEST_F(RingBufferBatchTest, GetBatchOnEmptyRingBuffer) {
+  ring_buffer_req_t get_reqs[2];
+  ring_buffer_get_req_init(&get_reqs[0], NON_BLOCKING);
+  ASSERT_EQ(-EAGAIN, ring_buffer_get_batch(rb_, get_reqs, 2));
+}
+
+TEST_F(RingBufferBatchTest, PutBatchLargerThanRingBuffer) {
+  // the ring buffer is rounded up to 8K
+  ring_buffer_req_t put_reqs[2];
+  for (unsigned int i = 0; i < 2; ++i) {
+    ring_buffer_put_req_init(&put_reqs[i], NON_BLOCKING, 5 * 1024);
+  }
+  ASSERT_EQ(-EINVAL, ring_buffer_put_batch(rb_, put_reqs, 2));
+}
+
+TEST_F(RingBufferBatchTest, PutBatchWhenRingBufferIsFull) {
+  ring_buffer_req_t put_reqs[2];
+  for (unsigned int i = 0; i < 2; ++i) {
+    ring_buffer_put_req_init(&put_reqs[i], NON_BLOCKING, 3500);
+  }
+  ASSERT_EQ(0, ring_buffer_put_batch(rb_, put_reqs, 2));
+  // less than 1K left of the 8K
+  ring_buffer_req_t full_reqs[2];
+  for (unsigned int i = 0; i < 2; ++i) {
+    ring_buffer_put_req_init(&full_reqs[i], NON_BLOCKING, 2048);
+  }
+  ASSERT_EQ(-EAGAIN, ring_buffer_put_batch(rb_, full_reqs, 2));
+}
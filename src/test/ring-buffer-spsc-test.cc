@@ -0,0 +1,83 @@
+#include "gtest/gtest.h"
+#include <ring_buffer.h>
+
+#include <stdint.h>
+#include <thread>
+
+static const uint64_t kCountElements = 100000;
+
+// A producer and a consumer thread on a small ring buffer, which wraps around
+// and runs full many times.
+static void runProducerConsumer(int flags, unsigned int batch) {
+  ring_buffer_t* rb;
+  ASSERT_EQ(0, ring_buffer_create(4 * 1024, 64, flags, NULL, NULL, &rb));
+  ASSERT_EQ((flags & RING_BUFFER_SPSC) != 0, rb->is_spsc);
+
+  std::thread producer([rb, batch]() {
+    ring_buffer_req_t reqs[4];
+    for (uint64_t i = 0; i < kCountElements; i += batch) {
+      for (unsigned int j = 0; j < batch; ++j) {
+        ring_buffer_put_req_init(&reqs[j], BLOCKING,
+                                 sizeof(uint64_t) * (1 + (i + j) % 7));
+      }
+      ASSERT_EQ(0, ring_buffer_put_batch(rb, reqs, batch));
+      for (unsigned int j = 0; j < batch; ++j) {
+        *(uint64_t*)reqs[j].data = i + j;
+        ring_buffer_elm_set_ready(rb, reqs[j].data);
+      }
+    }
+  });
+
+  ring_buffer_req_t reqs[4];
+  for (uint64_t i = 0; i < kCountElements;) {
+    ring_buffer_get_req_init(&reqs[0], BLOCKING);
+    int count = ring_buffer_get_batch(rb, reqs, 4);
+    ASSERT_GT(count, 0);
+    for (int j = 0; j < count; ++j, ++i) {
+      ASSERT_EQ(i, *(uint64_t*)reqs[j].data);
+      ASSERT_EQ(sizeof(uint64_t) * (1 + i % 7), reqs[j].size);
+      ring_buffer_elm_set_done(rb, reqs[j].data);
+    }
+  }
+
+  producer.join();
+  ASSERT_TRUE(ring_buffer_is_empty(rb));
+  ring_buffer_destroy(rb);
+}
+
+TEST(RingBufferSPSCTest, ElementsArriveInOrder) {
+  runProducerConsumer(RING_BUFFER_BLOCKING | RING_BUFFER_SPSC, 1);
+}
+
+TEST(RingBufferSPSCTest, BatchesArriveInOrder) {
+  runProducerConsumer(RING_BUFFER_BLOCKING | RING_BUFFER_SPSC, 4);
+}
+
+TEST(RingBufferSPSCTest, CombiningRingBufferAgrees) {
+  runProducerConsumer(RING_BUFFER_BLOCKING, 4);
+}
+
+TEST(RingBufferSPSCTest, NonBlockingGetOnEmptyRingBuffer) {
+  ring_buffer_t* rb;
+  ASSERT_EQ(0, ring_buffer_create(4 * 1024, 64,
+                                  RING_BUFFER_NON_BLOCKING | RING_BUFFER_SPSC,
+                                  NULL, NULL, &rb));
+  ASSERT_FALSE(rb->is_blocking);
+
+  ring_buffer_req_t req;
+  ring_buffer_get_req_init(&req, NON_BLOCKING);
+  ASSERT_EQ(-EAGAIN, ring_buffer_get(rb, &req));
+
+  ring_buffer_req_t put_req;
+  ring_buffer_put_req_init(&put_req, NON_BLOCKING, 8);
+  ASSERT_EQ(0, ring_buffer_put(rb, &put_req));
+  // not ready yet
+  ring_buffer_get_req_init(&req, NON_BLOCKING);
+  ASSERT_EQ(-EAGAIN, ring_buffer_get(rb, &req));
+  ring_buffer_elm_set_ready(rb, put_req.data);
+  ring_buffer_get_req_init(&req, NON_BLOCKING);
+  ASSERT_EQ(0, ring_buffer_get(rb, &req));
+  ASSERT_EQ(put_req.data, req.data);
+  ring_buffer_elm_set_done(rb, req.data);
+  ring_buffer_destroy(rb);
+}
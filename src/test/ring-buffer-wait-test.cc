@@ -0,0 +1,95 @@
+#include "gtest/gtest.h"
+#include <ring_buffer.h>
+#include <ring_buffer_wait.h>
+
+#include <unistd.h>
+#include <thread>
+#include <vector>
+
+TEST(RingBufferWaitTest, EventWakesSleepingWaiters) {
+  volatile int ready = RB_EVENT_UNSET;
+  int data = 0;
+
+  std::vector<std::thread> waiters;
+  for (int i = 0; i < 4; ++i) {
+    waiters.push_back(std::thread([&ready, &data]() {
+      rb_event_wait(&ready);
+      ASSERT_EQ(42, data);
+    }));
+  }
+  // long enough for the waiters to go to sleep
+  usleep(50 * 1000);
+  ASSERT_EQ(RB_EVENT_SLEEPING, ready);
+
+  data = 42;
+  rb_event_set(&ready);
+  for (auto& waiter : waiters) {
+    waiter.join();
+  }
+  ASSERT_TRUE(rb_event_is_set(&ready));
+
+  rb_event_reset(&ready);
+  ASSERT_FALSE(rb_event_is_set(&ready));
+}
+
+TEST(RingBufferWaitTest, EventSetBeforeWait) {
+  volatile int ready = RB_EVENT_UNSET;
+  rb_event_set(&ready);
+  rb_event_wait(&ready);
+  ASSERT_EQ(RB_EVENT_SET, ready);
+}
+
+TEST(RingBufferWaitTest, SlotIsHandedOverByAnotherThread) {
+  volatile int slot = RB_SLOT_FREE;
+  const int kCountRounds = 1000;
+  volatile int owner_round = -1;
+
+  // the producer takes the slot every round, the consumer frees it
+  std::thread consumer([&slot, &owner_round]() {
+    for (int i = 0; i < kCountRounds; ++i) {
+      while (owner_round != i) {
+        __rb_cpu_relax();
+      }
+      if (i % 100 == 0) {
+        // let the producer go to sleep
+        usleep(1000);
+      }
+      rb_slot_release(&slot);
+    }
+  });
+
+  for (int i = 0; i < kCountRounds; ++i) {
+    rb_slot_acquire(&slot);
+    ASSERT_NE(RB_SLOT_FREE, slot);
+    owner_round = i;
+  }
+  consumer.join();
+  ASSERT_EQ(RB_SLOT_FREE, slot);
+}
+
+TEST(RingBufferWaitTest, GetSleepsUntilTheElementIsReady) {
+  ring_buffer_t* rb;
+  ASSERT_EQ(0, ring_buffer_create(4 * 1024, 64, RING_BUFFER_BLOCKING, NULL,
+                                  NULL, &rb));
+  ring_buffer_req_t put_req;
+  ring_buffer_put_req_init(&put_req, BLOCKING, sizeof(int));
+  ASSERT_EQ(0, ring_buffer_put(rb, &put_req));
+
+  std::thread consumer([rb, &put_req]() {
+    ring_buffer_req_t get_req;
+    ring_buffer_get_req_init(&get_req, BLOCKING);
+    ASSERT_EQ(0, ring_buffer_get(rb, &get_req));
+    ASSERT_EQ(put_req.data, get_req.data);
+    ASSERT_EQ(42, *(int*)get_req.data);
+    ring_buffer_elm_set_done(rb, get_req.data);
+  });
+  // long enough for the consumer to go to sleep on the element
+  usleep(50 * 1000);
+  ASSERT_EQ(1, rb->get_nap.count_elm_sleepers);
+
+  *(int*)put_req.data = 42;
+  ring_buffer_elm_set_ready(rb, put_req.data);
+  consumer.join();
+  ASSERT_EQ(0, rb->get_nap.count_elm_sleepers);
+  ring_buffer_destroy(rb);
+}
@@ -0,0 +1,51 @@
+#include "gtest/gtest.h"
+#include "../tools/grc/rmat-stream-generator.h"
+
+#include <core/datatypes.h>
+
+namespace gl = scalable_graphs::graph_load;
+
+TEST(RMATStreamTest, RangesAreIndependent) {
+  const uint64_t count_vertices = 1ul << 15;
+  gl::RMATStreamGenerator generator(RMAT_A, RMAT_B, RMAT_C, count_vertices,
+                                    RMAT_SEED);
+
+  const size_t count = 1000;
+  uint64_t src[count], tgt[count];
+  generator.generate(0, count, src, tgt);
+
+  // any sub-range regenerates exactly the same edges
+  uint64_t src_part[count], tgt_part[count];
+  generator.generate(123, 456, src_part, tgt_part);
+  for (size_t i = 0; i < 456; ++i) {
+    ASSERT_EQ(src[123 + i], src_part[i]);
+    ASSERT_EQ(tgt[123 + i], tgt_part[i]);
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_LT(src[i], count_vertices);
+    ASSERT_LT(tgt[i], count_vertices);
+  }
+}
+
+TEST(RMATStreamTest, QuadrantDistribution) {
+  // a single level, the quadrants are hit with probabilities a, b, c, d
+  gl::RMATStreamGenerator generator(0.5, 0.25, 0.125, 2, RMAT_SEED);
+
+  const size_t count = 100000;
+  uint64_t* src = new uint64_t[count];
+  uint64_t* tgt = new uint64_t[count];
+  generator.generate(0, count, src, tgt);
+
+  size_t quadrants[4] = {0, 0, 0, 0};
+  for (size_t i = 0; i < count; ++i) {
+    ++quadrants[src[i] * 2 + tgt[i]];
+  }
+  ASSERT_NEAR(0.5, (double)quadrants[0] / count, 0.01);
+  ASSERT_NEAR(0.25, (double)quadrants[1] / count, 0.01);
+  ASSERT_NEAR(0.125, (double)quadrants[2] / count, 0.01);
+  ASSERT_NEAR(0.125, (double)quadrants[3] / count, 0.01);
+
+  delete[] src;
+  delete[] tgt;
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <core/datatypes.h>
+#include <core/util.h>
+
+#include <algorithm>
+#include <vector>
+
+// Runs the rounds of an algorithm on the host the way the engines do: gather
+// along all edges into per-target accumulators, reduce into the next-array,
+// apply to every vertex, reset and swap. APPs with need_transposed_tiles
+// gather along the edges in the direction they picked, transposed edges with
+// source and target swapped. Extension fields are filled once per round, as
+// if all edges were in one tile, which suits APPs filling them from global
+// state only.
+template <class APP>
+class Simulation {
+public:
+  typedef typename APP::VertexType VertexType;
+
+  // weights is either empty or holds the weight of every edge
+  Simulation(size_t count_vertices, const std::vector<edge_t>& edges,
+             const std::vector<float>& weights = std::vector<float>())
+      : edges_(edges), weights_(weights), current_(count_vertices),
+        next_(count_vertices), degrees_(count_vertices),
+        active_current_((size_t)size_bool_array(count_vertices)),
+        active_next_((size_t)size_bool_array(count_vertices)),
+        changed_((size_t)size_bool_array(count_vertices)),
+        pending_((size_t)size_bool_array(count_vertices)),
+        bucket_(count_vertices),
+        partial_sums_(APP::count_partial_sums),
+        extension_fields_(APP::max_size_extension_fields_vertex_block),
+        count_gathers_(0), residual_(0.) {
+    for (const auto& edge : edges_) {
+      ++degrees_[edge.src].out_degree;
+      ++degrees_[edge.tgt].in_degree;
+    }
+    vertices_.count = count_vertices;
+    vertices_.size_active = active_current_.size();
+    vertices_.degrees = degrees_.data();
+    vertices_.current = current_.data();
+    vertices_.next = next_.data();
+    vertices_.active_current = active_current_.data();
+    vertices_.active_next = active_next_.data();
+    vertices_.changed = changed_.data();
+    vertices_.buckets = NULL;
+    vertices_.direction = TileDirection::TD_Forward;
+    vertices_.partial_sums =
+        APP::count_partial_sums > 0 ? partial_sums_.data() : NULL;
+    if (APP::need_buckets) {
+      buckets_.pending = pending_.data();
+      buckets_.bucket = bucket_.data();
+      buckets_.current = 0;
+      vertices_.buckets = &buckets_;
+    }
+  }
+
+  void init(incremental_args_t* incremental) {
+    init_args_t args = {NULL, 0, incremental, NULL, 0};
+    APP::init_vertices(&vertices_, &args);
+  }
+
+  void init(std::vector<uint64_t> roots) {
+    init_args_t args = {roots.data(), roots.size(), NULL, NULL, 0};
+    APP::init_vertices(&vertices_, &args);
+  }
+
+  void initFeatures(const std::vector<float>& features) {
+    init_args_t args = {NULL, 0, NULL, features.data(), features.size()};
+    APP::init_vertices(&vertices_, &args);
+  }
+
+  // Returns the count of rounds until no vertex was active anymore or, for
+  // algorithms declaring a residual, until it fell to the tolerance.
+  int run(int max_rounds) {
+    return run(max_rounds, config_vertex_domain_t());
+  }
+
+  int run(int max_rounds, const config_vertex_domain_t& config_vertex) {
+    config_edge_processor_t config_edge;
+    int round = 0;
+    for (; round < max_rounds && countActive() > 0; ++round) {
+      std::vector<VertexType> accumulators(vertices_.count);
+      APP::reset_vertices_tile_processor(accumulators.data(),
+                                         accumulators.size());
+      std::vector<bool> touched(vertices_.count, false);
+      void* extension_fields = NULL;
+      if (APP::need_vertex_block_extension_fields) {
+        extension_fields = extension_fields_.data();
+        APP::fillExtensionFieldsVertexBlock(extension_fields, NULL, NULL,
+                                            NULL, &vertices_);
+      }
+      auto gatherAlong = [&](uint64_t src, uint64_t tgt, size_t i) {
+        if (APP::need_active_source_input &&
+            !eval_bool_array(vertices_.active_current, src)) {
+          return;
+        }
+        if (weights_.empty()) {
+          APP::pullGather(vertices_.current[src], accumulators[tgt], 0, 0,
+                          &vertices_.degrees[src], &vertices_.degrees[tgt],
+                          NULL, NULL, config_edge, extension_fields);
+        } else {
+          APP::pullGatherWeighted(vertices_.current[src], accumulators[tgt],
+                                  weights_[i], 0, 0, &vertices_.degrees[src],
+                                  &vertices_.degrees[tgt], NULL, NULL,
+                                  config_edge, extension_fields);
+        }
+        touched[tgt] = true;
+        ++count_gathers_;
+      };
+      bool forward = !APP::need_transposed_tiles ||
+                     vertices_.direction != TileDirection::TD_Transposed;
+      bool transposed = APP::need_transposed_tiles &&
+                        vertices_.direction != TileDirection::TD_Forward;
+      for (size_t i = 0; i < edges_.size(); ++i) {
+        if (forward) {
+          gatherAlong(edges_[i].src, edges_[i].tgt, i);
+        }
+        if (transposed) {
+          gatherAlong(edges_[i].tgt, edges_[i].src, i);
+        }
+      }
+      for (size_t i = 0; i < vertices_.count; ++i) {
+        if (touched[i]) {
+          APP::reduceVertex(vertices_.next[i], accumulators[i],
+                            vertices_.next[i], i, vertices_.degrees[i],
+                            vertices_.active_next, config_vertex);
+        }
+      }
+      residual_ = 0.;
+      for (size_t i = 0; i < vertices_.count; ++i) {
+        APP::apply(&vertices_, i, config_vertex, round);
+        if (APP::need_residual) {
+          residual_ += APP::residual(&vertices_, i);
+        }
+        if (APP::count_partial_sums > 0) {
+          APP::accumulatePartialSums(&vertices_, i, partial_sums_.data());
+        }
+      }
+
+      bool switch_current_next = true;
+      APP::reset_vertices(&vertices_, &switch_current_next);
+      std::fill(partial_sums_.begin(), partial_sums_.end(), 0.);
+      std::swap(vertices_.current, vertices_.next);
+      std::swap(vertices_.active_current, vertices_.active_next);
+      if (APP::need_buckets) {
+        // not converged while buckets are pending
+        residual_ +=
+            scalable_graphs::core::advanceBucket(&vertices_, [](size_t) {});
+      }
+      if (APP::need_residual &&
+          residual_ <= config_vertex.convergence_tolerance) {
+        ++round;
+        break;
+      }
+    }
+    return round;
+  }
+
+  size_t countActive() const {
+    size_t count = 0;
+    for (size_t i = 0; i < vertices_.count; ++i) {
+      count += eval_bool_array(vertices_.active_current, i) ? 1 : 0;
+    }
+    return count;
+  }
+
+  // edges gathered along so far, i.e. relaxations for SSSP
+  size_t countGathers() const { return count_gathers_; }
+
+  const VertexType* current() const { return vertices_.current; }
+
+  // residual of the last round run
+  double residual() const { return residual_; }
+
+private:
+  std::vector<edge_t> edges_;
+  std::vector<float> weights_;
+  std::vector<VertexType> current_;
+  std::vector<VertexType> next_;
+  std::vector<vertex_degree_t> degrees_;
+  std::vector<char> active_current_;
+  std::vector<char> active_next_;
+  std::vector<char> changed_;
+  std::vector<char> pending_;
+  std::vector<uint32_t> bucket_;
+  vertex_buckets_t buckets_;
+  std::vector<double> partial_sums_;
+  std::vector<char> extension_fields_;
+  size_t count_gathers_;
+  double residual_;
+  vertex_array_t<VertexType> vertices_;
+};
@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+#include <core/datatypes.h>
+#include <core/util.h>
+#include "../lib/core/algorithms/sssp.h"
+#include "../lib/core/algorithms/sssp-delta.h"
+#include "simulation.h"
+
+#include <cfloat>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace core = scalable_graphs::core;
+
+struct weighted_graph_t {
+  size_t count_vertices;
+  std::vector<edge_t> edges;
+  std::vector<float> weights;
+};
+
+// A ring, so everything is reachable, plus random chords with weights spread
+// over three orders of magnitude.
+static weighted_graph_t getGraph(size_t count_vertices, size_t count_chords) {
+  weighted_graph_t graph;
+  graph.count_vertices = count_vertices;
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<uint64_t> vertex(0, count_vertices - 1);
+  std::uniform_int_distribution<int> weight(1, 1000);
+  for (uint64_t i = 0; i < count_vertices; ++i) {
+    graph.edges.push_back({i, (i + 1) % count_vertices});
+    graph.weights.push_back(weight(generator));
+  }
+  for (size_t i = 0; i < count_chords; ++i) {
+    graph.edges.push_back({vertex(generator), vertex(generator)});
+    graph.weights.push_back(weight(generator));
+  }
+  return graph;
+}
+
+// Dijkstra, as reference.
+static std::vector<float> runDijkstra(const weighted_graph_t& graph,
+                                      uint64_t root) {
+  std::vector<float> distances(graph.count_vertices, FLT_MAX);
+  typedef std::pair<float, uint64_t> entry_t;
+  std::priority_queue<entry_t, std::vector<entry_t>, std::greater<entry_t>>
+      queue;
+  distances[root] = 0;
+  queue.push({0, root});
+  while (!queue.empty()) {
+    entry_t top = queue.top();
+    queue.pop();
+    if (top.first > distances[top.second]) {
+      continue;
+    }
+    for (size_t i = 0; i < graph.edges.size(); ++i) {
+      const edge_t& edge = graph.edges[i];
+      float distance = top.first + graph.weights[i];
+      if (edge.src == top.second && distance < distances[edge.tgt]) {
+        distances[edge.tgt] = distance;
+        queue.push({distance, edge.tgt});
+      }
+    }
+  }
+  return distances;
+}
+
+template <class APP>
+static std::vector<float> runSSSP(const weighted_graph_t& graph, uint64_t root,
+                                  float bucket_width, size_t* count_gathers) {
+  Simulation<APP> simulation(graph.count_vertices, graph.edges, graph.weights);
+  config_vertex_domain_t config;
+  config.bucket_width = bucket_width;
+  simulation.init(std::vector<uint64_t>{root});
+  EXPECT_LT(simulation.run(10000, config), 10000);
+  *count_gathers = simulation.countGathers();
+  return std::vector<float>(simulation.current(),
+                            simulation.current() + graph.count_vertices);
+}
+
+TEST(SSSPDeltaTest, MatchesDijkstra) {
+  weighted_graph_t graph = getGraph(200, 800);
+  std::vector<float> expected = runDijkstra(graph, 7);
+  for (float bucket_width : {1.0f, 50.0f, 250.0f, 1e6f}) {
+    size_t count_gathers;
+    std::vector<float> distances =
+        runSSSP<core::SSSPDelta>(graph, 7, bucket_width, &count_gathers);
+    for (size_t i = 0; i < graph.count_vertices; ++i) {
+      ASSERT_FLOAT_EQ(expected[i], distances[i]) << "vertex " << i;
+    }
+  }
+}
+
+TEST(SSSPDeltaTest, FewerRelaxationsThanBellmanFord) {
+  weighted_graph_t graph = getGraph(500, 4000);
+  size_t count_bellman_ford;
+  std::vector<float> expected =
+      runSSSP<core::SSSP>(graph, 0, 1.0f, &count_bellman_ford);
+  size_t count_delta_stepping;
+  std::vector<float> distances =
+      runSSSP<core::SSSPDelta>(graph, 0, 100.0f, &count_delta_stepping);
+  ASSERT_EQ(expected, distances);
+  ASSERT_LT(count_delta_stepping, count_bellman_ford);
+}
+
+TEST(SSSPDeltaTest, WideBucketIsBellmanFord) {
+  // with a single bucket nothing is ever parked
+  weighted_graph_t graph = getGraph(100, 300);
+  size_t count_bellman_ford;
+  runSSSP<core::SSSP>(graph, 3, 1.0f, &count_bellman_ford);
+  size_t count_delta_stepping;
+  runSSSP<core::SSSPDelta>(graph, 3, FLT_MAX, &count_delta_stepping);
+  ASSERT_EQ(count_bellman_ford, count_delta_stepping);
+}
@@ -0,0 +1,168 @@
+#include "gtest/gtest.h"
+#include <core/tile-container.h>
+#include <core/util.h>
+#include <core/datatypes.h>
+#include <util/arch.h>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <vector>
+
+namespace core = scalable_graphs::core;
+namespace util = scalable_graphs::util;
+
+class TileContainerTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    char dir_template[] = "/tmp/tile-container-test-XXXXXX";
+    ASSERT_TRUE(mkdtemp(dir_template) != NULL);
+    dir_ = std::string(dir_template) + "/";
+    file_name_ = core::getTileContainerFileName(dir_);
+
+    // one list-tile, one rle-tile and an empty one
+    tile_stats_[0] = {0, 3, 2, 4, TileEncoding::TE_List};
+    tile_stats_[1] = {1, 2, 2, 6, TileEncoding::TE_RLE};
+    tile_stats_[2] = {2, 0, 0, 0, TileEncoding::TE_List};
+
+    core::TileContainerWriter writer(file_name_, tile_stats_, count_tiles_,
+                                     false, true);
+    for (size_t i = 0; i < count_tiles_; ++i) {
+      size_t size_edge_block = core::getSizeEdgeBlock(tile_stats_[i], false);
+      edge_block_t* edge_block = (edge_block_t*)calloc(1, size_edge_block);
+      edge_block->block_id = i;
+      edge_block->offset_src = sizeof(edge_block_t);
+      memset(get_array(uint8_t*, edge_block, edge_block->offset_src), i + 1,
+             size_edge_block - sizeof(edge_block_t));
+      writer.writeEdgeBlock(i, edge_block);
+      free(edge_block);
+
+      size_t size_index = core::getSizeEdgeBlockIndex(tile_stats_[i], true);
+      edge_block_index_t* index = (edge_block_index_t*)calloc(1, size_index);
+      index->block_id = i;
+      index->count_src_vertices = tile_stats_[i].count_vertex_src;
+      index->count_tgt_vertices = tile_stats_[i].count_vertex_tgt;
+      writer.writeEdgeBlockIndex(i, index);
+      free(index);
+    }
+    writer.close();
+  }
+
+  virtual void TearDown() {
+    unlink(file_name_.c_str());
+    rmdir(dir_.c_str());
+  }
+
+  static const size_t count_tiles_ = 3;
+  tile_stats_t tile_stats_[count_tiles_];
+  std::string dir_;
+  std::string file_name_;
+};
+
+const size_t TileContainerTest::count_tiles_;
+
+TEST_F(TileContainerTest, Layout) {
+  core::TileContainer container;
+  ASSERT_TRUE(core::TileContainer::exists(file_name_));
+  container.open(file_name_);
+
+  ASSERT_EQ(count_tiles_, container.countTiles());
+  ASSERT_EQ(0, container.header().offset_edge_blocks % TILE_READ_ALIGN);
+  ASSERT_EQ(0, container.header().offset_indices % TILE_READ_ALIGN);
+  ASSERT_EQ(0, container.header().size_file % TILE_READ_ALIGN);
+
+  tile_stats_t tile_stats[count_tiles_];
+  container.copyTileStats(tile_stats);
+
+  for (size_t i = 0; i < count_tiles_; ++i) {
+    const tile_container_entry_t& entry = container.entry(i);
+    ASSERT_EQ(0, entry.offset_edge_block % PAGE_SIZE);
+    ASSERT_EQ(0, entry.offset_index % PAGE_SIZE);
+    ASSERT_EQ(tile_stats_[i].count_edges, tile_stats[i].count_edges);
+    ASSERT_EQ(tile_stats_[i].encoding, tile_stats[i].encoding);
+    ASSERT_EQ(core::getSizeEdgeBlock(tile_stats_[i], false),
+              entry.size_edge_block);
+  }
+
+  // edge blocks are contiguous in page granularity, like in tiles.dat
+  ASSERT_EQ(container.entry(0).offset_edge_block + PAGE_SIZE,
+            container.entry(1).offset_edge_block);
+}
+
+TEST_F(TileContainerTest, MapAndVerify) {
+  core::TileContainer container;
+  container.open(file_name_);
+  container.map();
+  ASSERT_TRUE(container.isMapped());
+
+  for (size_t i = 0; i < count_tiles_; ++i) {
+    ASSERT_TRUE(container.verifyTile(i));
+    ASSERT_EQ(i, container.getEdgeBlock(i)->block_id);
+    ASSERT_EQ(tile_stats_[i].count_vertex_src,
+              container.getEdgeBlockIndex(i)->count_src_vertices);
+  }
+
+  // a flipped bit in the file is detected, the mapping shares its pages
+  const edge_block_t* edge_block = container.getEdgeBlock(1);
+  uint8_t byte =
+      get_array(const uint8_t*, edge_block, edge_block->offset_src)[0] ^ 1;
+  int fd = open(file_name_.c_str(), O_WRONLY);
+  ASSERT_NE(-1, fd);
+  ASSERT_EQ(1, pwrite(fd, &byte, 1, container.entry(1).offset_edge_block +
+                                        edge_block->offset_src));
+  close(fd);
+  ASSERT_FALSE(container.verifyTile(1));
+  ASSERT_TRUE(container.verifyTile(0));
+}
+
+TEST_F(TileContainerTest, Tombstones) {
+  std::string file_name = core::getTileTombstonesFileName(dir_);
+  std::vector<tile_tombstone_t> tombstones = {{1, 5}, {0, 3}, {1, 0}};
+  core::TileTombstones::write(file_name, count_tiles_, &tombstones);
+
+  std::vector<tile_tombstone_t> read;
+  ASSERT_EQ(count_tiles_, core::TileTombstones::read(file_name, &read));
+  ASSERT_EQ(3, read.size());
+  // written sorted by tile and edge
+  ASSERT_EQ(0, read[0].tile_id);
+  ASSERT_EQ(0, read[1].edge_id);
+  ASSERT_EQ(5, read[2].edge_id);
+
+  core::TileTombstones masks;
+  masks.open(file_name, tile_stats_, count_tiles_);
+  ASSERT_EQ(3, masks.countTombstones());
+  ASSERT_TRUE(eval_bool_array(masks.getMask(0), 3));
+  ASSERT_FALSE(eval_bool_array(masks.getMask(0), 2));
+  ASSERT_TRUE(eval_bool_array(masks.getMask(1), 0));
+  ASSERT_TRUE(eval_bool_array(masks.getMask(1), 5));
+  // no deletions in the empty tile, none past the base tiles
+  ASSERT_TRUE(masks.getMask(2) == NULL);
+  ASSERT_TRUE(masks.getMask(count_tiles_) == NULL);
+
+  unlink(file_name.c_str());
+}
+
+TEST(Crc32cTest, KnownValue) {
+  const char* data = "123456789";
+  ASSERT_EQ(0xe3069283, util::crc32c(data, strlen(data)));
+  // chaining gives the same result as one pass
+  uint32_t crc = util::crc32c(data, 4);
+  ASSERT_EQ(0xe3069283, util::crc32c(data + 4, strlen(data) - 4, crc));
+}
+
+TEST(Crc32cTest, WordsMatchBytes) {
+  // the words of long buffers go through another path than the tail bytes
+  std::vector<uint8_t> data(1001);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = (uint8_t)(i * 37 + 11);
+  }
+  uint32_t crc = 0;
+  for (size_t i = 0; i < data.size(); ++i) {
+    crc = util::crc32c(&data[i], 1, crc);
+  }
+  ASSERT_EQ(crc, util::crc32c(data.data(), data.size()));
+  ASSERT_EQ(crc, util::crc32c(data.data() + 3, data.size() - 3,
+                              util::crc32c(data.data(), 3)));
+}
@@ -141,7 +141,7 @@ namespace core {
     tile_processor_.tgt_vertices_ = tgt_vertices;
 
     // Now process the edges set up.
-    tile_processor_.process_edges_range_list(0, 6);
+    tile_processor_.process_edges_range_list<false>(0, 6);
 
     // And check for the correct calculation. We use a deviation of at most
     // 10**-4 to check for double "equality".
@@ -228,7 +228,7 @@ namespace core {
     tile_processor_.tgt_vertices_ = tgt_vertices;
 
     // Now process the edges set up.
-    tile_processor_.process_edges_range_rle(0, 6);
+    tile_processor_.process_edges_range_rle<false>(0, 6);
 
     // And check for the correct calculation. We use a deviation of at most
     // 10**-4 to check for double "equality".
@@ -247,5 +247,165 @@ namespace core {
     delete[] src_vertices;
     delete[] tgt_vertices;
   }
+
+  TEST_F(TileProcessorTest, ProcessEdgesRangeBitmap) {
+    // The test-graph once more, encoded as a bitmap with one row per target.
+    edge_block_t* edge_block = (edge_block_t*)calloc(
+        1, sizeof(edge_block_t) + sizeof(uint64_t) * 4 + sizeof(uint32_t) * 4);
+    edge_block->offset_src = sizeof(edge_block_t);
+    edge_block->offset_tgt = edge_block->offset_src + sizeof(uint64_t) * 4;
+
+    uint64_t* bitmap = get_array(uint64_t*, edge_block, edge_block->offset_src);
+    uint32_t* row_offsets =
+        get_array(uint32_t*, edge_block, edge_block->offset_tgt);
+
+    local_vertex_id_t src[] = {0, 2, 0, 1, 1, 2};
+    local_vertex_id_t tgt[] = {0, 0, 1, 1, 2, 3};
+    for (int i = 0; i < 6; ++i) {
+      core::set_bitmap_edge(bitmap, 1, src[i], tgt[i]);
+    }
+    row_offsets[0] = 0;
+    row_offsets[1] = 2;
+    row_offsets[2] = 4;
+    row_offsets[3] = 5;
+
+    vertex_degree_t* src_degrees = new vertex_degree_t[3];
+    src_degrees[0].out_degree = 2;
+    src_degrees[1].out_degree = 2;
+    src_degrees[2].out_degree = 2;
+
+    float* src_vertices = new float[3];
+    float* tgt_vertices = new float[4];
+    for (int i = 0; i < 3; ++i) {
+      src_vertices[i] = 0.15;
+    }
+    for (int i = 0; i < 4; ++i) {
+      tgt_vertices[i] = 0.0;
+    }
+
+    tile_processor_.edge_block_ = edge_block;
+    tile_processor_.tile_stats_ = {0, 3, 4, 6, TileEncoding::TE_Bitmap};
+    tile_processor_.src_degrees_ = src_degrees;
+    tile_processor_.src_vertices_ = src_vertices;
+    tile_processor_.tgt_vertices_ = tgt_vertices;
+
+    // split in two ranges, the second one starts in the middle of a row
+    tile_processor_.process_edges_range_bitmap<false>(0, 3);
+    tile_processor_.process_edges_range_bitmap<false>(3, 6);
+
+    ASSERT_NEAR(0.15, tile_processor_.tgt_vertices_[0], 0.0001);
+    ASSERT_NEAR(0.15, tile_processor_.tgt_vertices_[1], 0.0001);
+    ASSERT_NEAR(0.075, tile_processor_.tgt_vertices_[2], 0.0001);
+    ASSERT_NEAR(0.075, tile_processor_.tgt_vertices_[3], 0.0001);
+
+    free(edge_block);
+    delete[] src_degrees;
+    delete[] src_vertices;
+    delete[] tgt_vertices;
+  }
+
+  TEST(TileEncodingTest, BitmapEdgeOrder) {
+    // two rows of 130 sources, i.e. three words per row
+    uint32_t words_per_row = BITMAP_WORDS_PER_ROW(130);
+    ASSERT_EQ(3, words_per_row);
+    std::vector<uint64_t> bitmap(2 * words_per_row, 0);
+    local_vertex_id_t src[] = {1, 63, 64, 129, 0, 128};
+    local_vertex_id_t tgt[] = {0, 0, 0, 0, 1, 1};
+    for (int i = 0; i < 6; ++i) {
+      core::set_bitmap_edge(bitmap.data(), words_per_row, src[i], tgt[i]);
+    }
+    uint32_t row_offsets[] = {0, 4};
+
+    for (uint32_t start = 0; start < 6; ++start) {
+      std::vector<uint32_t> edge_ids;
+      core::for_each_bitmap_edge(
+          bitmap.data(), row_offsets, 2, words_per_row, start, 6,
+          [&](uint32_t edge_id, local_vertex_id_t src_id,
+              local_vertex_id_t tgt_id) {
+            ASSERT_EQ(src[edge_id], src_id);
+            ASSERT_EQ(tgt[edge_id], tgt_id);
+            edge_ids.push_back(edge_id);
+          });
+      ASSERT_EQ(6 - start, edge_ids.size());
+      ASSERT_EQ(start, edge_ids[0]);
+    }
+  }
+
+  TEST(TileEncodingTest, ChooseTileEncoding) {
+    // sparse tiles stay lists, RLE once targets have two edges on average
+    ASSERT_EQ(TileEncoding::TE_List,
+              core::chooseTileEncoding(100, 100, 100, true, true));
+    ASSERT_EQ(TileEncoding::TE_RLE,
+              core::chooseTileEncoding(200, 200, 100, true, true));
+    ASSERT_EQ(TileEncoding::TE_List,
+              core::chooseTileEncoding(200, 200, 100, false, true));
+    // a complete block of 1024x1024 costs 1/8 byte per edge as a bitmap
+    ASSERT_EQ(TileEncoding::TE_Bitmap,
+              core::chooseTileEncoding(1024 * 1024, 1024, 1024, true, true));
+    ASSERT_EQ(TileEncoding::TE_RLE,
+              core::chooseTileEncoding(1024 * 1024, 1024, 1024, true, false));
+    ASSERT_EQ(TileEncoding::TE_List,
+              core::chooseTileEncoding(0, 0, 0, true, true));
+  }
+
+  TEST_F(TileProcessorTest, ProcessEdgesRangeTombstones) {
+    // Same tile as in ProcessEdgesRangeList, with the edges 1 and 4 deleted.
+    edge_block_t* edge_block = (edge_block_t*)malloc(
+        sizeof(edge_block_t) + sizeof(local_vertex_id_t) * 6 +
+        sizeof(local_vertex_id_t) * 6);
+    edge_block->offset_src = sizeof(edge_block_t);
+    edge_block->offset_tgt =
+        edge_block->offset_src + sizeof(local_vertex_id_t) * 6;
+
+    local_vertex_id_t* src_block =
+        get_array(local_vertex_id_t*, edge_block, edge_block->offset_src);
+    local_vertex_id_t* tgt_block =
+        get_array(local_vertex_id_t*, edge_block, edge_block->offset_tgt);
+
+    local_vertex_id_t src[] = {0, 2, 0, 1, 1, 2};
+    local_vertex_id_t tgt[] = {0, 0, 1, 1, 2, 3};
+    for (int i = 0; i < 6; ++i) {
+      src_block[i] = src[i];
+      tgt_block[i] = tgt[i];
+    }
+
+    char tombstones[1] = {0};
+    set_bool_array(tombstones, 1, true);
+    set_bool_array(tombstones, 4, true);
+
+    vertex_degree_t* src_degrees = new vertex_degree_t[3];
+    src_degrees[0].out_degree = 2;
+    src_degrees[1].out_degree = 2;
+    src_degrees[2].out_degree = 2;
+
+    float* src_vertices = new float[3];
+    float* tgt_vertices = new float[4];
+    for (int i = 0; i < 3; ++i) {
+      src_vertices[i] = 0.15;
+    }
+    for (int i = 0; i < 4; ++i) {
+      tgt_vertices[i] = 0.0;
+    }
+
+    tile_processor_.edge_block_ = edge_block;
+    tile_processor_.src_degrees_ = src_degrees;
+    tile_processor_.src_vertices_ = src_vertices;
+    tile_processor_.tgt_vertices_ = tgt_vertices;
+    tile_processor_.tombstones_ = tombstones;
+
+    tile_processor_.process_edges_range_list<true>(0, 6);
+
+    // tgt 0 only receives from src 0, tgt 2 nothing at all
+    ASSERT_NEAR(0.075, tile_processor_.tgt_vertices_[0], 0.0001);
+    ASSERT_NEAR(0.15, tile_processor_.tgt_vertices_[1], 0.0001);
+    ASSERT_NEAR(0.0, tile_processor_.tgt_vertices_[2], 0.0001);
+    ASSERT_NEAR(0.075, tile_processor_.tgt_vertices_[3], 0.0001);
+
+    tile_processor_.tombstones_ = NULL;
+    free(edge_block);
+    delete[] src_degrees;
+    delete[] src_vertices;
+    delete[] tgt_vertices;
+  }
 }
 }
@@ -0,0 +1,228 @@
+#include "gtest/gtest.h"
+#include <core/datatypes.h>
+#include <core/tile-container.h>
+#include <core/util.h>
+#include <util/arch.h>
+#include <util/util.h>
+#include "../lib/core/algorithms/wcc.h"
+#include "../tools/post-grc/delta-store.h"
+#include "simulation.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace core = scalable_graphs::core;
+namespace util = scalable_graphs::util;
+namespace pg = scalable_graphs::post_grc;
+
+// A graph of delta tiles only, on top of empty base containers of two edge
+// engines.
+class TransposerTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    config_.path_to_globals = makeDir();
+    for (int i = 0; i < count_edge_engines_; ++i) {
+      config_.paths_to_tile.push_back(makeDir());
+      tile_stats_t tile_stats;
+      core::TileContainerWriter writer(
+          core::getTileContainerFileName(config_, i), &tile_stats, 0, false,
+          true);
+      writer.close();
+    }
+    config_.count_edge_processors = count_edge_engines_;
+
+    stats_.count_vertices = count_vertices_;
+    stats_.count_tiles = 0;
+    stats_.is_index_32_bits = true;
+    stats_.is_weighted_graph = false;
+    stats_.index_33_bit_extension = false;
+    writeStats();
+
+    // more sources than fit into a single tile
+    for (uint64_t i = 0; i < count_vertices_; ++i) {
+      edges_.push_back({i, (i * 7 + 3) % count_vertices_, 0.0f});
+    }
+    pg::DeltaStore store(config_, stats_, grc_tile_traversals_t::Hilbert);
+    store.open();
+    store.insertEdges(edges_);
+    store.write();
+    util::readDataFromFile(core::getGlobalStatFileName(config_.path_to_globals),
+                           sizeof(stats_), &stats_);
+    config_.count_tiles = stats_.count_tiles;
+  }
+
+  virtual void TearDown() {
+    for (const auto& dir : dirs_) {
+      std::string command = "rm -rf " + dir;
+      ASSERT_EQ(0, system(command.c_str()));
+    }
+  }
+
+  std::string makeDir() {
+    char dir_template[] = "/tmp/transposed-tiles-test-XXXXXX";
+    EXPECT_TRUE(mkdtemp(dir_template) != NULL);
+    dirs_.push_back(dir_template);
+    return std::string(dir_template) + "/";
+  }
+
+  void writeStats() {
+    util::writeDataToFile(core::getGlobalStatFileName(config_.path_to_globals),
+                          &stats_, sizeof(stats_));
+  }
+
+  static const int count_edge_engines_ = 2;
+  static const uint64_t count_vertices_ = 150000;
+  config_t config_;
+  scenario_stats_t stats_;
+  std::vector<pg::delta_edge_t> edges_;
+  std::vector<std::string> dirs_;
+};
+
+const int TransposerTest::count_edge_engines_;
+const uint64_t TransposerTest::count_vertices_;
+
+TEST_F(TransposerTest, SwapsSourceAndTarget) {
+  ASSERT_GT(stats_.count_tiles, 2u);
+  pg::DeltaStore store(config_, stats_, grc_tile_traversals_t::Hilbert);
+  store.open();
+  store.writeTransposed();
+
+  std::vector<uint32_t> count_tiles_per_vertex(count_vertices_);
+  util::readDataFromFile(core::getTransposedVertexToTileCountFileName(
+                             config_.path_to_globals),
+                         count_vertices_ * sizeof(uint32_t),
+                         count_tiles_per_vertex.data());
+  std::vector<size_t> offsets(count_vertices_ + 1, 0);
+  for (uint64_t i = 0; i < count_vertices_; ++i) {
+    offsets[i + 1] = offsets[i] + count_tiles_per_vertex[i];
+  }
+  std::vector<uint32_t> index(offsets.back());
+  util::readDataFromFile(core::getTransposedVertexToTileIndexFileName(
+                             config_.path_to_globals),
+                         index.size() * sizeof(uint32_t), index.data());
+
+  // the engines see the transposed tiles after the forward ones
+  config_t transposed_config = core::withTransposedTiles(config_);
+  std::multiset<std::pair<uint64_t, uint64_t> > transposed_edges;
+  for (int i = 0; i < count_edge_engines_; ++i) {
+    core::TileContainer forward;
+    forward.open(core::getDeltaTileContainerFileName(config_, i));
+    core::TileContainer* transposed =
+        core::openTransposedTileContainer(config_, i);
+    ASSERT_EQ(core::countTilesPerMic(transposed_config, i),
+              forward.countTiles() + transposed->countTiles());
+
+    for (size_t j = 0; j < transposed->countTiles(); ++j) {
+      const tile_container_entry_t& entry = transposed->entry(j);
+      std::vector<char> block(entry.size_edge_block);
+      std::vector<char> index_block(entry.size_index);
+      transposed->readEdgeBlock(j, block.data());
+      transposed->readEdgeBlockIndex(j, index_block.data());
+      edge_block_t* edge_block = (edge_block_t*)block.data();
+      edge_block_index_t* edge_block_index =
+          (edge_block_index_t*)index_block.data();
+      ASSERT_EQ(forward.countTiles() + j, edge_block->block_id);
+      ASSERT_EQ(TileEncoding::TE_List, entry.stats.encoding);
+
+      uint64_t global_tile_id =
+          (forward.countTiles() + j) * count_edge_engines_ + i;
+      ASSERT_GE(global_tile_id, stats_.count_tiles);
+      local_vertex_id_t* src =
+          get_array(local_vertex_id_t*, edge_block, edge_block->offset_src);
+      local_vertex_id_t* tgt =
+          get_array(local_vertex_id_t*, edge_block, edge_block->offset_tgt);
+      uint32_t* src_index = get_array(uint32_t*, edge_block_index,
+                                      edge_block_index->offset_src_index);
+      uint32_t* tgt_index = get_array(uint32_t*, edge_block_index,
+                                      edge_block_index->offset_tgt_index);
+      for (uint32_t k = 0; k < entry.stats.count_edges; ++k) {
+        uint64_t src_id = src_index[src[k]];
+        transposed_edges.insert(std::make_pair(src_id, tgt_index[tgt[k]]));
+        // the tile is indexed for its source
+        ASSERT_TRUE(std::find(index.begin() + offsets[src_id],
+                              index.begin() + offsets[src_id + 1],
+                              global_tile_id) !=
+                    index.begin() + offsets[src_id + 1]);
+      }
+    }
+    delete transposed;
+  }
+
+  std::multiset<std::pair<uint64_t, uint64_t> > expected_edges;
+  for (const auto& edge : edges_) {
+    expected_edges.insert(std::make_pair(edge.tgt, edge.src));
+  }
+  ASSERT_EQ(expected_edges, transposed_edges);
+  ASSERT_EQ(edges_.size(), index.size());
+}
+
+TEST_F(TransposerTest, UpdatesRemoveTransposedTiles) {
+  pg::DeltaStore store(config_, stats_, grc_tile_traversals_t::Hilbert);
+  store.open();
+  store.writeTransposed();
+  ASSERT_TRUE(core::TileContainer::exists(
+      core::getTransposedTileContainerFileName(config_, 0)));
+
+  store.insertEdges({{0, 1, 0.0f}});
+  store.write();
+  for (int i = 0; i < count_edge_engines_; ++i) {
+    ASSERT_FALSE(core::TileContainer::exists(
+        core::getTransposedTileContainerFileName(config_, i)));
+  }
+  ASSERT_NE(0, access(core::getTransposedVertexToTileCountFileName(
+                          config_.path_to_globals)
+                          .c_str(),
+                      F_OK));
+}
+
+static uint64_t find(std::vector<uint64_t>& parents, uint64_t id) {
+  while (parents[id] != id) {
+    parents[id] = parents[parents[id]];
+    id = parents[id];
+  }
+  return id;
+}
+
+TEST(WCCTest, WeakComponentsOfDirectedGraph) {
+  const size_t count_vertices = 400;
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<uint64_t> vertex(0, count_vertices - 1);
+  std::vector<edge_t> edges;
+  for (size_t i = 0; i < 300; ++i) {
+    edges.push_back({vertex(generator), vertex(generator)});
+  }
+
+  std::vector<uint64_t> parents(count_vertices);
+  for (size_t i = 0; i < count_vertices; ++i) {
+    parents[i] = i;
+  }
+  for (const auto& edge : edges) {
+    uint64_t lhs = find(parents, edge.src);
+    uint64_t rhs = find(parents, edge.tgt);
+    parents[std::max(lhs, rhs)] = std::min(lhs, rhs);
+  }
+
+  Simulation<core::WCC> wcc(count_vertices, edges);
+  wcc.init(std::vector<uint64_t>());
+  wcc.run(count_vertices);
+  ASSERT_EQ(0u, wcc.countActive());
+
+  // along the forward edges only, the labels do not reach all vertices of a
+  // weak component
+  Simulation<core::CC> cc(count_vertices, edges);
+  cc.init(std::vector<uint64_t>());
+  cc.run(count_vertices);
+
+  size_t count_cc_differing = 0;
+  for (size_t i = 0; i < count_vertices; ++i) {
+    // union-find keeps the smallest id as root
+    ASSERT_EQ(find(parents, i), wcc.current()[i]) << "vertex " << i;
+    count_cc_differing += cc.current()[i] != wcc.current()[i];
+  }
+  ASSERT_GT(count_cc_differing, 0u);
+}
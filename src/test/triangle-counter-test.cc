@@ -0,0 +1,146 @@
+#include "gtest/gtest.h"
+#include <core/triangle-counter.h>
+#include <core/datatypes.h>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace core = scalable_graphs::core;
+
+class TriangleCounterTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    char dir_template[] = "/tmp/triangle-counter-test-XXXXXX";
+    ASSERT_TRUE(mkdtemp(dir_template) != NULL);
+    dir_ = std::string(dir_template) + "/";
+  }
+
+  virtual void TearDown() { rmdir(dir_.c_str()); }
+
+  // Random edges, including self-loops, duplicates and both directions.
+  static std::vector<edge_t> getEdges(size_t count_vertices,
+                                      size_t count_edges) {
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<uint64_t> vertex(0, count_vertices - 1);
+    std::vector<edge_t> edges;
+    for (size_t i = 0; i < count_edges; ++i) {
+      edges.push_back({vertex(generator), vertex(generator)});
+    }
+    return edges;
+  }
+
+  static uint64_t countBruteForce(size_t count_vertices,
+                                  const std::vector<edge_t>& edges) {
+    std::vector<std::set<uint64_t> > neighbors(count_vertices);
+    for (const auto& edge : edges) {
+      if (edge.src != edge.tgt) {
+        neighbors[edge.src].insert(edge.tgt);
+        neighbors[edge.tgt].insert(edge.src);
+      }
+    }
+    uint64_t count = 0;
+    for (uint64_t u = 0; u < count_vertices; ++u) {
+      for (uint64_t v : neighbors[u]) {
+        for (uint64_t w : neighbors[v]) {
+          count += u < v && v < w && neighbors[u].count(w) ? 1 : 0;
+        }
+      }
+    }
+    return count;
+  }
+
+  uint64_t count(size_t count_vertices, const std::vector<edge_t>& edges,
+                 uint64_t vertices_per_block, size_t size_resident,
+                 int count_threads, size_t* count_row_loads) {
+    core::TriangleCounter counter(count_vertices, vertices_per_block,
+                                  size_resident, dir_, count_threads);
+    for (const auto& edge : edges) {
+      counter.addEdge(edge.src, edge.tgt);
+    }
+    uint64_t count = counter.count();
+    *count_row_loads = counter.countRowLoads();
+    return count;
+  }
+
+  std::string dir_;
+};
+
+TEST_F(TriangleCounterTest, Intersect) {
+  std::mt19937 generator(3);
+  for (size_t size_a : {0, 1, 3, 4, 17, 64, 1000}) {
+    for (size_t size_b : {0, 2, 4, 9, 64, 5000}) {
+      std::set<uint32_t> a;
+      std::set<uint32_t> b;
+      std::uniform_int_distribution<uint32_t> value(0, 3 * (size_a + size_b));
+      while (a.size() < size_a) {
+        a.insert(value(generator));
+      }
+      while (b.size() < size_b) {
+        b.insert(value(generator));
+      }
+      std::vector<uint32_t> list_a(a.begin(), a.end());
+      std::vector<uint32_t> list_b(b.begin(), b.end());
+      std::vector<uint32_t> expected;
+      std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                            std::back_inserter(expected));
+      ASSERT_EQ(expected.size(),
+                core::TriangleCounter::intersect(list_a.data(), size_a,
+                                                 list_b.data(), size_b))
+          << size_a << " x " << size_b;
+    }
+  }
+}
+
+TEST_F(TriangleCounterTest, Clique) {
+  // K5 holds 10 triangles, given in both directions and twice
+  std::vector<edge_t> edges;
+  for (uint64_t u = 0; u < 5; ++u) {
+    for (uint64_t v = 0; v < 5; ++v) {
+      edges.push_back({u, v});
+      edges.push_back({v, u});
+    }
+  }
+  size_t count_row_loads;
+  ASSERT_EQ(10, count(5, edges, 2, 1 << 20, 1, &count_row_loads));
+}
+
+TEST_F(TriangleCounterTest, MatchesBruteForce) {
+  std::vector<edge_t> edges = getEdges(300, 4000);
+  uint64_t expected = countBruteForce(300, edges);
+  size_t count_row_loads;
+  for (uint64_t vertices_per_block : {7, 64, 300}) {
+    ASSERT_EQ(expected, count(300, edges, vertices_per_block, 1 << 20, 1,
+                              &count_row_loads))
+        << vertices_per_block;
+    ASSERT_EQ((300 + vertices_per_block - 1) / vertices_per_block,
+              count_row_loads);
+  }
+}
+
+TEST_F(TriangleCounterTest, SpillsAndStreamsRows) {
+  // barely more than one row fits, rows are spilled and loaded repeatedly
+  std::vector<edge_t> edges = getEdges(500, 10000);
+  uint64_t expected = countBruteForce(500, edges);
+  size_t count_row_loads;
+  ASSERT_EQ(expected, count(500, edges, 50, 8 * 1024, 3, &count_row_loads));
+  ASSERT_GT(count_row_loads, 10);
+}
+
+TEST_F(TriangleCounterTest, WorkersShareTheTilePairs) {
+  // rows of several chunks, handed out to the workers one at a time
+  std::vector<edge_t> edges = getEdges(4000, 60000);
+  uint64_t expected = countBruteForce(4000, edges);
+  ASSERT_LT(0, expected);
+  size_t count_row_loads;
+  for (int count_threads : {1, 4}) {
+    ASSERT_EQ(expected, count(4000, edges, 2500, 1 << 24, count_threads,
+                              &count_row_loads))
+        << count_threads;
+  }
+}
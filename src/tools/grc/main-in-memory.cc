@@ -26,6 +26,7 @@ struct command_line_args_t : public command_line_args_grc_t {
   uint64_t rmat_count_edges;
   bool output_weighted;
   bool use_rle;
+  bool use_bitmap;
   bool use_original_ids;
 };
 
@@ -49,6 +50,7 @@ static int parseOption(int argc,
       {"use-original-ids",        required_argument, 0, 'n'},
       {"traversal",               required_argument, 0, 'o'},
       {"delimiter",               required_argument, 0, 'p'},
+      {"use-bitmap-encoding",     required_argument, 0, 'q'},
       {0, 0,                                         0, 0},
   };
   int arg_cnt;
@@ -122,6 +124,11 @@ static int parseOption(int argc,
       case 'p':
         cmd_args.delimiter = std::string(optarg);
         break;
+      case 'q':
+        cmd_args.use_bitmap =
+            (std::stoi(std::string(optarg)) == 1) ? true : false;
+        --arg_cnt;
+        break;
       default:
         return -EINVAL;
     }
@@ -270,6 +277,8 @@ static void usage(FILE* out) {
           "  --output-weighted         = whether to generate a weighted graph\n");
   fprintf(out,
           "  --use-run-length-encoding = whether to generate tiles using rle\n");
+  fprintf(out, "  --use-bitmap-encoding = (optional) whether to store dense "
+      "tiles as adjacency bitmaps\n");
   fprintf(out, "  --rmat-count-edges    = count edges for rmat-generator\n");
   fprintf(out, "  --use-original-ids    = use the original id's of the file\n");
   fprintf(out, "  --traversal = whether to use the hilbert ordering or a "
@@ -279,6 +288,7 @@ static void usage(FILE* out) {
 int main(int argc,
          char** argv) {
   command_line_args_t cmd_args;
+  cmd_args.use_bitmap = false;
 
   // Parse command line options, return if not correct count.
   if (parseOption(argc, argv, cmd_args) != 16) {
@@ -326,6 +336,7 @@ int main(int argc,
   config_tiler.paths_to_meta = cmd_args.paths_to_meta;
   config_tiler.paths_to_tile = cmd_args.paths_to_tile;
   config_tiler.use_rle = cmd_args.use_rle;
+  config_tiler.use_bitmap = cmd_args.use_bitmap;
   config_tiler.traversal = cmd_args.traversal;
   config_tiler.partition_mode = PartitionMode::PM_InMemoryMode;
 
@@ -0,0 +1,259 @@
+#define __STDC_FORMAT_MACROS
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+#include <errno.h>
+
+#include <core/datatypes.h>
+#include <core/util.h>
+
+#include "tile-manager.h"
+#include "rmat-stream-generator.h"
+#include "stream-partition-manager.h"
+
+namespace gl = scalable_graphs::graph_load;
+namespace util = scalable_graphs::util;
+namespace core = scalable_graphs::core;
+
+// Host-only RMAT-tiler: Generates the edges on the fly and streams them
+// straight into the tile-builder, without writing or keeping partitions of the
+// whole graph. A first pass computes the vertex-degrees and the size of every
+// partition, the tiles are then built in rounds over windows of partitions.
+struct command_line_args_t : public command_line_args_grc_t {
+  std::vector<std::string> paths_to_meta;
+  std::vector<std::string> paths_to_tile;
+  grc_tile_traversals_t traversal;
+  uint64_t count_edges;
+  uint64_t max_edges_per_round;
+  bool output_weighted;
+  bool use_rle;
+  bool use_bitmap;
+};
+
+static int parseOption(int argc, char* argv[], command_line_args_t& cmd_args) {
+  static struct option options[] = {
+      {"count-vertices", required_argument, 0, 'v'},
+      {"count-edges", required_argument, 0, 'e'},
+      {"graphname", required_argument, 0, 'n'},
+      {"path-globals", required_argument, 0, 'l'},
+      {"paths-meta", required_argument, 0, 'm'},
+      {"paths-tile", required_argument, 0, 't'},
+      {"nthreads", required_argument, 0, 's'},
+      {"max-edges-per-round", required_argument, 0, 'r'},
+      {"output-weighted", required_argument, 0, 'w'},
+      {"use-run-length-encoding", required_argument, 0, 'c'},
+      {"use-bitmap-encoding", required_argument, 0, 'b'},
+      {"traversal", required_argument, 0, 'o'},
+      {0, 0, 0, 0},
+  };
+  int arg_cnt;
+
+  for (arg_cnt = 0; 1; ++arg_cnt) {
+    int c, idx = 0;
+    c = getopt_long(argc, argv, "v:e:n:l:m:t:s:r:w:c:b:o:", options, &idx);
+    if (c == -1)
+      break;
+
+    switch (c) {
+    case 'v':
+      cmd_args.count_vertices = std::stoull(std::string(optarg));
+      break;
+    case 'e':
+      cmd_args.count_edges = std::stoull(std::string(optarg));
+      break;
+    case 'n':
+      cmd_args.graphname = std::string(optarg);
+      break;
+    case 'l':
+      cmd_args.path_to_globals = util::prepareDirPath(std::string(optarg));
+      break;
+    case 'm':
+      cmd_args.paths_to_meta = util::splitDirPaths(std::string(optarg));
+      break;
+    case 't':
+      cmd_args.paths_to_tile = util::splitDirPaths(std::string(optarg));
+      break;
+    case 's':
+      cmd_args.nthreads = std::stoull(std::string(optarg));
+      break;
+    case 'r':
+      cmd_args.max_edges_per_round = std::stoull(std::string(optarg));
+      break;
+    case 'w':
+      cmd_args.output_weighted =
+          (std::stoi(std::string(optarg)) == 1) ? true : false;
+      break;
+    case 'c':
+      cmd_args.use_rle = (std::stoi(std::string(optarg)) == 1) ? true : false;
+      break;
+    case 'b':
+      cmd_args.use_bitmap =
+          (std::stoi(std::string(optarg)) == 1) ? true : false;
+      --arg_cnt;
+      break;
+    case 'o':
+      if (std::string(optarg) == "hilbert") {
+        cmd_args.traversal = grc_tile_traversals_t::Hilbert;
+      } else if (std::string(optarg) == "column_first") {
+        cmd_args.traversal = grc_tile_traversals_t::ColumnFirst;
+      } else if (std::string(optarg) == "row_first") {
+        cmd_args.traversal = grc_tile_traversals_t::RowFirst;
+      } else {
+        sg_log("Wrong traversal supplied: %s", optarg);
+        util::die(1);
+      }
+      break;
+    default:
+      return -EINVAL;
+    }
+  }
+  return arg_cnt;
+}
+
+static void usage(FILE* out) {
+  extern const char* __progname;
+
+  fprintf(out, "Usage: %s\n", __progname);
+  fprintf(out, "  --graphname               = graph name\n");
+  fprintf(out, "  --count-vertices          = count vertices, a power of two\n");
+  fprintf(out, "  --count-edges             = count edges\n");
+  fprintf(out, "  --path-globals            = path to global data\n");
+  fprintf(out, "  --paths-meta              = output paths to metadata\n");
+  fprintf(out, "  --paths-tile              = output paths to tiledata\n");
+  fprintf(out, "  --nthreads                = number of concurrent threads\n");
+  fprintf(out, "  --max-edges-per-round     = upper bound of edges buffered "
+               "per tiling round\n");
+  fprintf(out, "  --output-weighted         = whether to generate a weighted "
+               "graph\n");
+  fprintf(out, "  --use-run-length-encoding = whether to generate tiles using "
+               "rle\n");
+  fprintf(out, "  --use-bitmap-encoding     = (optional) whether to store "
+               "dense tiles as adjacency bitmaps\n");
+  fprintf(out, "  --traversal = whether to use the hilbert ordering or a "
+               "column_first or the row_first approach.\n");
+}
+
+template <typename TVertexIdType, typename TLocalEdgeType>
+static void runTiling(const gl::tile_manager_arguments_t& arguments,
+                      gl::StreamPartitionManager* partition_manager,
+                      const command_line_args_t& cmd_args) {
+  gl::TileManager<TVertexIdType, TLocalEdgeType, edge_t> tl(arguments);
+
+  int64_t count_partitions = arguments.config.count_rows_partitions *
+                             arguments.config.count_rows_partitions;
+  int64_t start = 0;
+  int round = 0;
+  while (start < count_partitions) {
+    int64_t end =
+        partition_manager->getEndOfRound(start, cmd_args.max_edges_per_round);
+    sg_log("Round %d: partitions [%ld, %ld) of %ld\n", round, start, end,
+           count_partitions);
+
+    partition_manager->fillRound(cmd_args.nthreads, start, end);
+    tl.generateTiles(cmd_args.nthreads, start, end);
+
+    start = end;
+    ++round;
+  }
+  tl.writeStatistics();
+}
+
+template <typename TVertexIdType>
+static void outerRunTiling(const gl::tile_manager_arguments_t& arguments,
+                           gl::StreamPartitionManager* partition_manager,
+                           const command_line_args_t& cmd_args) {
+  if (cmd_args.output_weighted) {
+    sg_log2("Generating weighted graph\n");
+    runTiling<TVertexIdType, local_edge_weighted_t>(
+        arguments, partition_manager, cmd_args);
+  } else {
+    sg_log2("Generating non-weighted graph\n");
+    runTiling<TVertexIdType, local_edge_t>(arguments, partition_manager,
+                                           cmd_args);
+  }
+}
+
+int main(int argc, char** argv) {
+  command_line_args_t cmd_args;
+  cmd_args.use_bitmap = false;
+
+  // parse command line options
+  if (parseOption(argc, argv, cmd_args) != 11) {
+    usage(stderr);
+    return 1;
+  }
+
+  // everything lives in one partition-manager
+  cmd_args.count_partition_managers = 1;
+  cmd_args.input_weighted = false;
+
+  config_tiler_t config;
+  core::initGrcConfig(&config, cmd_args.count_vertices, cmd_args);
+  config.output_weighted = cmd_args.output_weighted;
+  config.paths_to_meta = cmd_args.paths_to_meta;
+  config.paths_to_tile = cmd_args.paths_to_tile;
+  config.use_rle = cmd_args.use_rle;
+  config.use_bitmap = cmd_args.use_bitmap;
+  config.traversal = cmd_args.traversal;
+  config.partition_mode = PartitionMode::PM_InMemoryMode;
+
+  gl::RMATStreamGenerator generator(RMAT_A, RMAT_B, RMAT_C,
+                                    cmd_args.count_vertices, RMAT_SEED);
+
+  partition_manager_arguments_t arguments =
+      core::getPartitionManagerArguments(0, config);
+  gl::StreamPartitionManager* partition_manager =
+      new gl::StreamPartitionManager(config, arguments, generator,
+                                     cmd_args.count_edges);
+
+  sg_log("Generating RMAT-graph with %lu vertices and %lu edges\n",
+         cmd_args.count_vertices, cmd_args.count_edges);
+
+  // 1) vertex-degrees and partition-sizes
+  uint64_t start_time = util::get_time_nsec();
+
+  vertex_degree_t* vertex_degrees = (vertex_degree_t*)calloc(
+      sizeof(vertex_degree_t), cmd_args.count_vertices);
+  partition_manager->countEdges(cmd_args.nthreads, vertex_degrees);
+
+  util::writeDataToFile(core::getVertexDegreeFileName(config),
+                        reinterpret_cast<const void*>(vertex_degrees),
+                        sizeof(vertex_degree_t) * cmd_args.count_vertices);
+  free(vertex_degrees);
+
+  // the tiler picks up the count of vertices from the global stats
+  scenario_stats_t stat;
+  memset(&stat, 0, sizeof(stat));
+  stat.count_vertices = cmd_args.count_vertices;
+  util::writeDataToFile(core::getGlobalStatFileName(config),
+                        reinterpret_cast<const void*>(&stat), sizeof(stat));
+
+  double diff = (double)(util::get_time_nsec() - start_time) / 1000000000L;
+  sg_log("Counting time: %f\n", diff);
+
+  // 2) tiles, round by round
+  gl::AbstractPartitionManager* partition_managers[] = {partition_manager};
+  gl::tile_manager_arguments_t tile_manager_arguments;
+  tile_manager_arguments.partition_managers = partition_managers;
+  tile_manager_arguments.config = config;
+
+  // deterministic seed for the weights of weighted edges
+  srand(0);
+
+  start_time = util::get_time_nsec();
+  if (cmd_args.count_vertices < UINT32_MAX) {
+    outerRunTiling<uint32_t>(tile_manager_arguments, partition_manager,
+                             cmd_args);
+  } else {
+    outerRunTiling<uint64_t>(tile_manager_arguments, partition_manager,
+                             cmd_args);
+  }
+  diff = (double)(util::get_time_nsec() - start_time) / 1000000000L;
+  sg_log("Tiling time: %f\n", diff);
+
+  delete partition_manager;
+
+  return 0;
+}
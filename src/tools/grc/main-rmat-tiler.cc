@@ -31,6 +31,7 @@ static int parseOption(int argc, char* argv[], config_rmat_tiler_t& config) {
       {"paths-tile", required_argument, 0, 't'},
       {"paths-partition", required_argument, 0, 'q'},
       {"use-run-length-encoding", required_argument, 0, 'c'},
+      {"use-bitmap-encoding", required_argument, 0, 'b'},
       {"generator-phase", required_argument, 0, 'a'},
       {"run-on-mic", required_argument, 0, 'i'},
       {0, 0, 0, 0},
@@ -39,7 +40,7 @@ static int parseOption(int argc, char* argv[], config_rmat_tiler_t& config) {
 
   for (arg_cnt = 0; 1; ++arg_cnt) {
     int c, idx = 0;
-    c = getopt_long(argc, argv, "v:e:g:p:s:r:o:n:l:w:m:t:q:c:a:i:", options,
+    c = getopt_long(argc, argv, "v:e:g:p:s:r:o:n:l:w:m:t:q:c:b:a:i:", options,
                     &idx);
     if (c == -1)
       break;
@@ -81,6 +82,10 @@ static int parseOption(int argc, char* argv[], config_rmat_tiler_t& config) {
     case 'c':
       config.use_rle = (std::stoi(std::string(optarg)) == 1) ? true : false;
       break;
+    case 'b':
+      config.use_bitmap = (std::stoi(std::string(optarg)) == 1) ? true : false;
+      --arg_cnt;
+      break;
     case 'a': {
       std::string gen_phase = std::string(optarg);
       if (gen_phase == "generate_tiles") {
@@ -126,10 +131,13 @@ static void usage(FILE* out) {
                "generators\n");
   fprintf(out, "  --use-run-length-encoding = whether to generate tiles using "
                "rle\n");
+  fprintf(out, "  --use-bitmap-encoding     = (optional) whether to store "
+               "dense tiles as adjacency bitmaps\n");
 }
 
 int main(int argc, char** argv) {
   config_rmat_tiler_t config;
+  config.use_bitmap = false;
 
   // parse command line options
   if (parseOption(argc, argv, config) != 14) {
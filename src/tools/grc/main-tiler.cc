@@ -26,6 +26,7 @@ struct command_line_args_t : public command_line_args_grc_t {
   grc_tile_traversals_t traversal;
   bool output_weighted;
   bool use_rle;
+  bool use_bitmap;
 };
 
 static int parseOption(int argc, char* argv[], command_line_args_t& cmd_args) {
@@ -41,6 +42,7 @@ static int parseOption(int argc, char* argv[], command_line_args_t& cmd_args) {
       {"input-weighted", required_argument, 0, 'i'},
       {"output-weighted", required_argument, 0, 'o'},
       {"use-run-length-encoding", required_argument, 0, 'r'},
+      {"use-bitmap-encoding", required_argument, 0, 'b'},
       {"traversal", required_argument, 0, 'e'},
       {0, 0, 0, 0},
   };
@@ -48,7 +50,7 @@ static int parseOption(int argc, char* argv[], command_line_args_t& cmd_args) {
 
   for (arg_cnt = 0; 1; ++arg_cnt) {
     int c, idx = 0;
-    c = getopt_long(argc, argv, "g:p:l:m:t:n:a:i:o:r:v:e:", options, &idx);
+    c = getopt_long(argc, argv, "g:p:l:m:t:n:a:i:o:r:b:v:e:", options, &idx);
     if (c == -1)
       break;
 
@@ -85,6 +87,11 @@ static int parseOption(int argc, char* argv[], command_line_args_t& cmd_args) {
     case 'r':
       cmd_args.use_rle = (std::stoi(std::string(optarg)) == 1) ? true : false;
       break;
+    case 'b':
+      cmd_args.use_bitmap =
+          (std::stoi(std::string(optarg)) == 1) ? true : false;
+      --arg_cnt;
+      break;
     case 'v':
       cmd_args.count_vertices = std::stoull(std::string(optarg));
       break;
@@ -157,12 +164,15 @@ static void usage(FILE* out) {
   fprintf(
       out,
       "  --use-run-length-encoding = whether to generate tiles using rle\n");
+  fprintf(out, "  --use-bitmap-encoding     = (optional) whether to store "
+               "dense tiles as adjacency bitmaps\n");
   fprintf(out, "  --traversal = whether to use the hilbert ordering or a "
                "column_first or the row_first approach.\n");
 }
 
 int main(int argc, char** argv) {
   command_line_args_t cmd_args;
+  cmd_args.use_bitmap = false;
 
   // parse command line options
   if (parseOption(argc, argv, cmd_args) != 12) {
@@ -179,6 +189,7 @@ int main(int argc, char** argv) {
   config.paths_to_meta = cmd_args.paths_to_meta;
   config.paths_to_tile = cmd_args.paths_to_tile;
   config.use_rle = cmd_args.use_rle;
+  config.use_bitmap = cmd_args.use_bitmap;
   config.traversal = cmd_args.traversal;
   config.partition_mode = PartitionMode::PM_FileBackedMode;
 
@@ -0,0 +1,88 @@
+#include "rmat-stream-generator.h"
+
+#include <util/util.h>
+
+namespace scalable_graphs {
+namespace graph_load {
+
+  static inline uint64_t mix(uint64_t z) {
+    // splitmix64-finalizer, a bijection with full avalanche
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ul;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebul;
+    return z ^ (z >> 31);
+  }
+
+  static inline uint32_t toThreshold(double p) {
+    if (p >= 1.0) {
+      return UINT32_MAX;
+    }
+    return (uint32_t)(p * 4294967296.0);
+  }
+
+  RMATStreamGenerator::RMATStreamGenerator(double a, double b, double c,
+                                           uint64_t count_vertices,
+                                           uint64_t seed)
+      : a_threshold_(toThreshold(a)), ab_threshold_(toThreshold(a + b)),
+        abc_threshold_(toThreshold(a + b + c)),
+        count_vertices_(count_vertices), count_levels_(0),
+        key_(util::hash(seed)) {
+    if (count_vertices == 0 || (count_vertices & (count_vertices - 1)) != 0) {
+      sg_err("RMAT-stream-generator needs a power of two vertices, got %lu\n",
+             count_vertices);
+      util::die(1);
+    }
+    while ((1ul << count_levels_) < count_vertices) {
+      ++count_levels_;
+    }
+  }
+
+  void RMATStreamGenerator::generate(uint64_t first_edge_id, size_t count,
+                                     uint64_t* src, uint64_t* tgt) const {
+    const uint32_t a = a_threshold_;
+    const uint32_t ab = ab_threshold_;
+    const uint32_t abc = abc_threshold_;
+    const uint64_t key = key_;
+
+    for (size_t i = 0; i < count; ++i) {
+      src[i] = 0;
+      tgt[i] = 0;
+    }
+
+    // Every hash yields two 32-bit draws, i.e. two levels of the recursion.
+    // Levels run in the outer loop so the inner loop is a plain sweep over the
+    // batch. Quadrants are [0, a) -> (0, 0), [a, ab) -> (0, 1),
+    // [ab, abc) -> (1, 0) and [abc, 1) -> (1, 1), computed without branches.
+    int level = 0;
+    for (; level + 1 < count_levels_; level += 2) {
+      const uint64_t salt = (uint64_t)level;
+      for (size_t i = 0; i < count; ++i) {
+        uint64_t h = mix((((first_edge_id + i) << 6) | salt) ^ key);
+        uint32_t r0 = (uint32_t)h;
+        uint32_t r1 = (uint32_t)(h >> 32);
+
+        uint64_t src_bit0 = r0 >= ab;
+        uint64_t tgt_bit0 = (r0 >= a) ^ src_bit0 ^ (r0 >= abc);
+        uint64_t src_bit1 = r1 >= ab;
+        uint64_t tgt_bit1 = (r1 >= a) ^ src_bit1 ^ (r1 >= abc);
+
+        src[i] = (src[i] << 2) | (src_bit0 << 1) | src_bit1;
+        tgt[i] = (tgt[i] << 2) | (tgt_bit0 << 1) | tgt_bit1;
+      }
+    }
+
+    // odd number of levels, one draw left
+    if (level < count_levels_) {
+      const uint64_t salt = (uint64_t)level;
+      for (size_t i = 0; i < count; ++i) {
+        uint32_t r = (uint32_t)mix((((first_edge_id + i) << 6) | salt) ^ key);
+
+        uint64_t src_bit = r >= ab;
+        uint64_t tgt_bit = (r >= a) ^ src_bit ^ (r >= abc);
+
+        src[i] = (src[i] << 1) | src_bit;
+        tgt[i] = (tgt[i] << 1) | tgt_bit;
+      }
+    }
+  }
+}
+}
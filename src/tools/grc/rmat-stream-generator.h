@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace scalable_graphs {
+namespace graph_load {
+
+  // Counter-based RMAT-generator: Edge i only depends on (seed, i), so any
+  // thread can regenerate any range of edges at any time without state. Edges
+  // are produced in batches as separate src/tgt arrays, the per-edge work is
+  // branchless and independent which lets the compiler vectorize the loops.
+  class RMATStreamGenerator {
+  public:
+    RMATStreamGenerator(double a, double b, double c, uint64_t count_vertices,
+                        uint64_t seed);
+
+    // Generates the edges [first_edge_id, first_edge_id + count) into src and
+    // tgt, both have to hold count elements.
+    void generate(uint64_t first_edge_id, size_t count, uint64_t* src,
+                  uint64_t* tgt) const;
+
+    inline uint64_t countVertices() const { return count_vertices_; }
+
+  public:
+    const static size_t batch_size_ = 4096;
+
+  private:
+    // quadrant thresholds, scaled to 32 bits
+    uint32_t a_threshold_;
+    uint32_t ab_threshold_;
+    uint32_t abc_threshold_;
+
+    uint64_t count_vertices_;
+    int count_levels_;
+    uint64_t key_;
+  };
+}
+}
@@ -444,18 +444,34 @@ namespace graph_load {
     sg_assert(src_size <= MAX_VERTICES_PER_TILE, "");
     sg_assert(tgt_size <= MAX_VERTICES_PER_TILE, "");
 
-    // only use RLE if the edge-count is larger then 2-times the tgt-count,
-    // otherwise the RLE will actually increase the tile-size!
-    bool use_rle = config_.use_rle && (edge_count >= 2 * tgt_size);
+    // a bitmap can hold every edge only once
+    bool has_duplicates = false;
+    if (config_.use_bitmap) {
+      for (size_t i = 1; i < edge_count && !has_duplicates; ++i) {
+        has_duplicates = !(ctx.edge_set_[i - 1] < ctx.edge_set_[i]);
+      }
+    }
+
+    // pick the smallest encoding, e.g. RLE only pays off if the edge-count is
+    // larger then 2-times the tgt-count and a bitmap only for dense tiles
+    TileEncoding encoding =
+        core::chooseTileEncoding(edge_count, src_size, tgt_size, config_.use_rle,
+                                 config_.use_bitmap && !has_duplicates);
 
     size_t size_edge_src_block = sizeof(local_vertex_id_t) * edge_count;
     size_t size_edge_tgt_block = size_edge_src_block;
+    uint32_t words_per_row = BITMAP_WORDS_PER_ROW(src_size);
 
     // if using rle, take the tgt-block as the size times the
     // vertex-count-struct
-    if (use_rle) {
+    if (encoding == TileEncoding::TE_RLE) {
       size_edge_tgt_block = sizeof(vertex_count_t) * tgt_size;
     }
+    // a bitmap replaces the src-block, the tgt-block holds its row offsets
+    else if (encoding == TileEncoding::TE_Bitmap) {
+      size_edge_src_block = sizeof(uint64_t) * tgt_size * words_per_row;
+      size_edge_tgt_block = sizeof(uint32_t) * tgt_size;
+    }
 
     // only include weight-block if necessary
     size_t size_edge_weights_block = 0;
@@ -463,7 +479,8 @@ namespace graph_load {
                                     size_edge_tgt_block +
                                     size_edge_weights_block;
 
-    edge_block_t* block = (edge_block_t*)malloc(malloc_edge_block_size);
+    // zeroed for the bitmap
+    edge_block_t* block = (edge_block_t*)calloc(1, malloc_edge_block_size);
 
     block->block_id = ctx.block_id;
     block->offset_src = sizeof(edge_block_t);
@@ -474,13 +491,15 @@ namespace graph_load {
     local_vertex_id_t* edge_src_block =
         get_array(local_vertex_id_t*, block, block->offset_src);
 
-    // two different representations of the tgt-block, once with and without
-    // the
-    // rle-representation
+    // three different representations of the src/tgt-blocks, as lists, with
+    // the rle-representation of the tgt-block or as a bitmap
     local_vertex_id_t* edge_tgt_block =
         get_array(local_vertex_id_t*, block, block->offset_tgt);
     vertex_count_t* edge_tgt_block_rle =
         get_array(vertex_count_t*, block, block->offset_tgt);
+    uint64_t* edge_bitmap = get_array(uint64_t*, block, block->offset_src);
+    uint32_t* edge_row_offsets =
+        get_array(uint32_t*, block, block->offset_tgt);
 
     local_vertex_id_t active_tgt = ctx.edge_set_[0].tgt;
     uint32_t current_count = 0;
@@ -488,8 +507,15 @@ namespace graph_load {
     size_t rle_position = 0;
 
     for (size_t i = 0; i < edge_count; ++i) {
-      edge_src_block[i] = ctx.edge_set_[i].src;
-      if (use_rle) {
+      if (encoding == TileEncoding::TE_Bitmap) {
+        local_vertex_id_t current_tgt = ctx.edge_set_[i].tgt;
+        core::set_bitmap_edge(edge_bitmap, words_per_row, ctx.edge_set_[i].src,
+                              current_tgt);
+        if (i == 0 || current_tgt != ctx.edge_set_[i - 1].tgt) {
+          edge_row_offsets[current_tgt] = i;
+        }
+      } else if (encoding == TileEncoding::TE_RLE) {
+        edge_src_block[i] = ctx.edge_set_[i].src;
         local_vertex_id_t current_tgt = ctx.edge_set_[i].tgt;
         // check if we need to either increment the current count
         if (current_tgt == active_tgt) {
@@ -504,6 +530,7 @@ namespace graph_load {
         edge_tgt_block_rle[rle_position].count = current_count;
         edge_tgt_block_rle[rle_position].id = current_tgt;
       } else {
+        edge_src_block[i] = ctx.edge_set_[i].src;
         edge_tgt_block[i] = ctx.edge_set_[i].tgt;
       }
     }
@@ -514,9 +541,12 @@ namespace graph_load {
 #ifdef SCALABLE_GRAPHS_DEBUG
     // check if calculated correctly:
     for (size_t i = 0; i < edge_count; ++i) {
+      if (encoding == TileEncoding::TE_Bitmap) {
+        continue;
+      }
       local_vertex_id_t src = edge_src_block[i];
       sg_assert(src == ctx.edge_set_[i].src, "");
-      if (!use_rle) {
+      if (encoding == TileEncoding::TE_List) {
         local_vertex_id_t tgt = edge_tgt_block[i];
         sg_assert(tgt == ctx.edge_set_[i].tgt, "");
       }
@@ -619,7 +649,7 @@ namespace graph_load {
     stat->count_vertex_src = src_size;
     stat->count_vertex_tgt = tgt_size;
     stat->block_id = block->block_id;
-    stat->use_rle = use_rle;
+    stat->encoding = encoding;
 
     std::string stat_file_name =
         core::getEdgeTileStatFileName(config_, block->block_id);
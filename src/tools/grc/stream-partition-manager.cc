@@ -0,0 +1,281 @@
+#include "stream-partition-manager.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <util/hilbert.h>
+#include <util/column_first.h>
+#include <util/row_first.h>
+#include <core/datatypes.h>
+#include <util/util.h>
+#include <util/arch.h>
+#include <core/util.h>
+
+namespace scalable_graphs {
+namespace graph_load {
+
+  static bool compareEdges(const edge_t& lhs, const edge_t& rhs) {
+    if (lhs.src != rhs.src) {
+      return lhs.src < rhs.src;
+    }
+    return lhs.tgt < rhs.tgt;
+  }
+
+  StreamPartitionManager::StreamPartitionManager(
+      const config_tiler_t& config,
+      const partition_manager_arguments_t& arguments,
+      const RMATStreamGenerator& generator, uint64_t count_edges)
+      : AbstractPartitionManager(config, arguments), config_tiler_(config),
+        generator_(generator), count_edges_(count_edges),
+        count_partitions_(config.count_rows_partitions *
+                          config.count_rows_partitions),
+        round_start_(0), round_end_(0), round_offsets_(NULL),
+        round_cursors_(NULL), round_edges_(NULL), round_capacity_(0) {
+    partition_counts_ =
+        (uint64_t*)calloc(count_partitions_, sizeof(uint64_t));
+    pthread_spin_init(&lock_, PTHREAD_PROCESS_PRIVATE);
+  }
+
+  void StreamPartitionManager::initRead() {}
+
+  // all work is driven by the tiler, nothing to do in the background
+  void StreamPartitionManager::run() {}
+
+  int64_t StreamPartitionManager::getTraversalIndex(uint64_t i,
+                                                    uint64_t j) const {
+    switch (config_tiler_.traversal) {
+    case grc_tile_traversals_t::Hilbert:
+      return ::traversal::hilbert::xy2d(config_tiler_.count_rows_partitions, i,
+                                        j);
+    case grc_tile_traversals_t::ColumnFirst:
+      return ::traversal::column_first::xy2d(
+          config_tiler_.count_rows_partitions, i, j);
+    case grc_tile_traversals_t::RowFirst:
+      return ::traversal::row_first::xy2d(config_tiler_.count_rows_partitions,
+                                          i, j);
+    default:
+      sg_log("Wrong traveral given: %d\n", config_tiler_.traversal);
+      util::die(1);
+    }
+    return -1;
+  }
+
+  void StreamPartitionManager::runThreads(int count_threads,
+                                          void* (*thread_main)(void*),
+                                          vertex_degree_t* vertex_degrees) {
+    std::vector<ThreadInfo*> threads;
+    uint64_t edges_per_thread = int_ceil(count_edges_, count_threads) /
+                                count_threads;
+    for (int i = 0; i < count_threads; ++i) {
+      ThreadInfo* ti = new ThreadInfo;
+      ti->pm = this;
+      ti->edge_start = std::min(count_edges_, i * edges_per_thread);
+      ti->edge_end = std::min(count_edges_, (i + 1) * edges_per_thread);
+      ti->vertex_degrees = vertex_degrees;
+      ti->partition_counts = NULL;
+
+      int rc = pthread_create(&ti->thr, NULL, thread_main, ti);
+      if (rc) {
+        sg_err("Unable to create generator thread: %d\n", rc);
+        util::die(1);
+      }
+      threads.push_back(ti);
+    }
+
+    for (const auto& ti : threads) {
+      pthread_join(ti->thr, NULL);
+      delete ti;
+    }
+  }
+
+  void* StreamPartitionManager::countThreadMain(void* arg) {
+    ThreadInfo* ti = static_cast<ThreadInfo*>(arg);
+    ti->pm->countEdgesInRange(ti);
+    return NULL;
+  }
+
+  void* StreamPartitionManager::fillThreadMain(void* arg) {
+    ThreadInfo* ti = static_cast<ThreadInfo*>(arg);
+    ti->pm->fillEdgesInRange(ti);
+    return NULL;
+  }
+
+  void StreamPartitionManager::countEdges(int count_threads,
+                                          vertex_degree_t* vertex_degrees) {
+    runThreads(count_threads, countThreadMain, vertex_degrees);
+  }
+
+  void StreamPartitionManager::countEdgesInRange(ThreadInfo* ti) {
+    const size_t batch_size = RMATStreamGenerator::batch_size_;
+    uint64_t* src = new uint64_t[batch_size];
+    uint64_t* tgt = new uint64_t[batch_size];
+    // thread-local counts, the partition-matrix is small compared to the
+    // vertices
+    uint64_t* partition_counts =
+        (uint64_t*)calloc(count_partitions_, sizeof(uint64_t));
+
+    for (uint64_t start = ti->edge_start; start < ti->edge_end;
+         start += batch_size) {
+      size_t count = std::min((uint64_t)batch_size, ti->edge_end - start);
+      generator_.generate(start, count, src, tgt);
+
+      for (size_t i = 0; i < count; ++i) {
+        smp_faa(&ti->vertex_degrees[src[i]].out_degree, 1);
+        smp_faa(&ti->vertex_degrees[tgt[i]].in_degree, 1);
+        ++partition_counts[getTraversalIndex(src[i] / MAX_VERTICES_PER_TILE,
+                                             tgt[i] / MAX_VERTICES_PER_TILE)];
+      }
+    }
+
+    pthread_spin_lock(&lock_);
+    for (size_t i = 0; i < count_partitions_; ++i) {
+      partition_counts_[i] += partition_counts[i];
+    }
+    pthread_spin_unlock(&lock_);
+
+    free(partition_counts);
+    delete[] src;
+    delete[] tgt;
+  }
+
+  int64_t StreamPartitionManager::getEndOfRound(int64_t start,
+                                                size_t max_edges) const {
+    int64_t end = start;
+    size_t count_edges = 0;
+    while (end < (int64_t)count_partitions_) {
+      if (end > start && count_edges + partition_counts_[end] > max_edges) {
+        break;
+      }
+      count_edges += partition_counts_[end];
+      ++end;
+    }
+    return end;
+  }
+
+  void StreamPartitionManager::fillRound(int count_threads, int64_t start,
+                                         int64_t end) {
+    size_t count_round_partitions = end - start;
+
+    free(round_offsets_);
+    free(round_cursors_);
+    round_offsets_ =
+        (uint64_t*)malloc(sizeof(uint64_t) * (count_round_partitions + 1));
+    round_cursors_ =
+        (uint64_t*)calloc(count_round_partitions, sizeof(uint64_t));
+
+    round_offsets_[0] = 0;
+    for (size_t i = 0; i < count_round_partitions; ++i) {
+      if (partition_counts_[start + i] > UINT32_MAX) {
+        sg_err("Partition %lu holds %lu edges, more than supported\n",
+               start + i, partition_counts_[start + i]);
+        util::die(1);
+      }
+      round_offsets_[i + 1] = round_offsets_[i] + partition_counts_[start + i];
+    }
+
+    size_t count_round_edges = round_offsets_[count_round_partitions];
+    if (count_round_edges > round_capacity_) {
+      free(round_edges_);
+      round_edges_ = (edge_t*)malloc(sizeof(edge_t) * count_round_edges);
+      round_capacity_ = count_round_edges;
+    }
+
+    round_start_ = start;
+    round_end_ = end;
+
+    runThreads(count_threads, fillThreadMain, NULL);
+
+    for (size_t i = 0; i < count_round_partitions; ++i) {
+      sg_assert(round_cursors_[i] == partition_counts_[start + i],
+                "regenerated edges have to match the counted ones");
+    }
+  }
+
+  void StreamPartitionManager::fillEdgesInRange(const ThreadInfo* ti) {
+    const size_t batch_size = RMATStreamGenerator::batch_size_;
+    uint64_t* src = new uint64_t[batch_size];
+    uint64_t* tgt = new uint64_t[batch_size];
+    // (round-local partition, position in batch)
+    std::vector<std::pair<uint64_t, uint32_t> > selected;
+    selected.reserve(batch_size);
+
+    for (uint64_t start = ti->edge_start; start < ti->edge_end;
+         start += batch_size) {
+      size_t count = std::min((uint64_t)batch_size, ti->edge_end - start);
+      generator_.generate(start, count, src, tgt);
+
+      selected.clear();
+      for (size_t i = 0; i < count; ++i) {
+        int64_t index = getTraversalIndex(src[i] / MAX_VERTICES_PER_TILE,
+                                          tgt[i] / MAX_VERTICES_PER_TILE);
+        if (index >= round_start_ && index < round_end_) {
+          selected.push_back(std::make_pair(index - round_start_, (uint32_t)i));
+        }
+      }
+
+      // group the batch by partition, one reservation per partition and
+      // batch instead of one per edge
+      std::sort(selected.begin(), selected.end());
+      size_t run_start = 0;
+      while (run_start < selected.size()) {
+        uint64_t local_index = selected[run_start].first;
+        size_t run_end = run_start + 1;
+        while (run_end < selected.size() &&
+               selected[run_end].first == local_index) {
+          ++run_end;
+        }
+
+        uint64_t position =
+            round_offsets_[local_index] +
+            smp_faa(&round_cursors_[local_index], run_end - run_start);
+        for (size_t k = run_start; k < run_end; ++k, ++position) {
+          round_edges_[position].src = src[selected[k].second];
+          round_edges_[position].tgt = tgt[selected[k].second];
+        }
+        run_start = run_end;
+      }
+    }
+
+    delete[] src;
+    delete[] tgt;
+  }
+
+  partition_edge_t*
+  StreamPartitionManager::getPartition(const partition_t& partition) {
+    int64_t index = getTraversalIndex(partition.i, partition.j);
+    sg_assert(index >= round_start_ && index < round_end_,
+              "partition requested outside of the current round");
+
+    uint64_t local_index = index - round_start_;
+    edge_t* begin = round_edges_ + round_offsets_[local_index];
+    edge_t* end = round_edges_ + round_offsets_[local_index + 1];
+
+    // the order of insertion depends on thread-timing, sort to get the same
+    // tiles on every run
+    std::sort(begin, end, compareEdges);
+
+    // the edges stay owned by the round, the tiler only frees the header
+    partition_edge_t* edges =
+        (partition_edge_t*)malloc(sizeof(partition_edge_t));
+    edges->count_edges = end - begin;
+    edges->edges = begin;
+    return edges;
+  }
+
+  size_t StreamPartitionManager::getSize(const partition_t& partition) {
+    return partition_counts_[getTraversalIndex(partition.i, partition.j)];
+  }
+
+  StreamPartitionManager::~StreamPartitionManager() {
+    free(partition_counts_);
+    free(round_offsets_);
+    free(round_cursors_);
+    free(round_edges_);
+    pthread_spin_destroy(&lock_);
+  }
+}
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+#include <pthread.h>
+
+#include <core/datatypes.h>
+
+#include "abstract-partition-manager.h"
+#include "rmat-stream-generator.h"
+
+namespace scalable_graphs {
+namespace graph_load {
+
+  // Partition-manager without any intermediate partitions: The edges are
+  // regenerated from the counter-based generator and bucketed directly in
+  // memory. The first pass counts vertex-degrees and edges per partition, each
+  // following pass (round) keeps only the edges of a window of consecutive
+  // partitions in traversal-order, which bounds the memory footprint by the
+  // window instead of the graph.
+  class StreamPartitionManager : public AbstractPartitionManager {
+  public:
+    StreamPartitionManager(const config_tiler_t& config,
+                           const partition_manager_arguments_t& arguments,
+                           const RMATStreamGenerator& generator,
+                           uint64_t count_edges);
+
+    virtual void initRead();
+
+    virtual void run();
+
+    // Generates all edges once, accumulates the vertex-degrees and the count
+    // of edges per partition.
+    void countEdges(int count_threads, vertex_degree_t* vertex_degrees);
+
+    // Returns the end of the round starting at the traversal index start,
+    // bounded by max_edges, a round always spans at least one partition.
+    int64_t getEndOfRound(int64_t start, size_t max_edges) const;
+
+    // Regenerates all edges, keeps the ones of the partitions in the
+    // traversal-range [start, end).
+    void fillRound(int count_threads, int64_t start, int64_t end);
+
+    virtual partition_edge_t* getPartition(const partition_t& partition);
+
+    virtual size_t getSize(const partition_t& partition);
+
+    virtual ~StreamPartitionManager();
+
+  private:
+    struct ThreadInfo {
+      pthread_t thr;
+      StreamPartitionManager* pm;
+      uint64_t edge_start;
+      uint64_t edge_end;
+      vertex_degree_t* vertex_degrees;
+      uint64_t* partition_counts;
+    };
+
+    static void* countThreadMain(void* arg);
+    static void* fillThreadMain(void* arg);
+
+    void runThreads(int count_threads, void* (*thread_main)(void*),
+                    vertex_degree_t* vertex_degrees);
+
+    void countEdgesInRange(ThreadInfo* ti);
+    void fillEdgesInRange(const ThreadInfo* ti);
+
+    int64_t getTraversalIndex(uint64_t i, uint64_t j) const;
+
+  private:
+    config_tiler_t config_tiler_;
+    const RMATStreamGenerator& generator_;
+    uint64_t count_edges_;
+    size_t count_partitions_;
+
+    // edges per partition, indexed by traversal index
+    uint64_t* partition_counts_;
+
+    // state of the current round
+    int64_t round_start_;
+    int64_t round_end_;
+    uint64_t* round_offsets_;
+    uint64_t* round_cursors_;
+    edge_t* round_edges_;
+    size_t round_capacity_;
+
+    pthread_spinlock_t lock_;
+  };
+}
+}
@@ -74,7 +74,8 @@ namespace graph_load {
   TileManager<TVertexIdType, TLocalEdgeType, TEdgeType>::TileManager(
       const tile_manager_arguments_t& arguments)
       : partition_managers_(arguments.partition_managers),
-        config_(arguments.config), partition_range_per_thread_(NULL) {
+        config_(arguments.config), count_tiles_(0), count_edges_(0),
+        partition_range_per_thread_(NULL) {
     vertex_to_tiles_per_vertices_ =
         (uint32_t*)calloc(1, sizeof(uint32_t) * config_.count_vertices);
     pthread_spin_init(&gv_lock, PTHREAD_PROCESS_PRIVATE);
@@ -201,6 +202,29 @@ namespace graph_load {
     return partition_managers_[offset_partition_manager]->getSize(partition);
   }
 
+  template <typename TVertexIdType, typename TLocalEdgeType, typename TEdgeType>
+  void TileManager<TVertexIdType, TLocalEdgeType, TEdgeType>::
+      getPartitionOfTraversalIndex(int64_t index, int64_t* x, int64_t* y) {
+    switch (config_.traversal) {
+    case grc_tile_traversals_t::Hilbert: {
+      ::traversal::hilbert::d2xy(config_.count_rows_partitions, index, x, y);
+      break;
+    }
+    case grc_tile_traversals_t::ColumnFirst: {
+      ::traversal::column_first::d2xy(config_.count_rows_partitions, index, x,
+                                      y);
+      break;
+    }
+    case grc_tile_traversals_t::RowFirst: {
+      ::traversal::row_first::d2xy(config_.count_rows_partitions, index, x, y);
+      break;
+    }
+    default:
+      sg_log("Wrong traveral given: %d\n", config_.traversal);
+      util::die(1);
+    }
+  }
+
   template <typename TVertexIdType, typename TLocalEdgeType, typename TEdgeType>
   void TileManager<TVertexIdType, TLocalEdgeType,
                    TEdgeType>::processPartitionsInRange(int64_t start,
@@ -214,24 +238,7 @@ namespace graph_load {
     // tiling a range in a Hilbert order
     for (int64_t i = start; i < end; ++i) {
       int64_t x, y;
-      switch (config_.traversal) {
-      case grc_tile_traversals_t::Hilbert: {
-        ::traversal::hilbert::d2xy(config_.count_rows_partitions, i, &x, &y);
-        break;
-      }
-      case grc_tile_traversals_t::ColumnFirst: {
-        ::traversal::column_first::d2xy(config_.count_rows_partitions, i, &x,
-                                        &y);
-        break;
-      }
-      case grc_tile_traversals_t::RowFirst: {
-        ::traversal::row_first::d2xy(config_.count_rows_partitions, i, &x, &y);
-        break;
-      }
-      default:
-        sg_log("Wrong traveral given: %d\n", config_.traversal);
-        util::die(1);
-      }
+      getPartitionOfTraversalIndex(i, &x, &y);
       processPartition(ctx, x, y);
     }
 
@@ -256,11 +263,12 @@ namespace graph_load {
 
   template <typename TVertexIdType, typename TLocalEdgeType, typename TEdgeType>
   int TileManager<TVertexIdType, TLocalEdgeType,
-                  TEdgeType>::calcProperNumThreads(int max_thread) {
-    size_t p2 = config_.count_rows_partitions * config_.count_rows_partitions;
-    size_t num_chunk = p2 / 4L;
+                  TEdgeType>::calcProperNumThreads(int max_thread,
+                                                   int64_t count_partitions) {
+    size_t num_chunk = count_partitions / 4L;
     int nthread = (int) std::min(num_chunk, (const size_t&) max_thread);
-    return nthread;
+    // small ranges still need one thread
+    return std::max(nthread, 1);
   }
 
   template <typename TVertexIdType, typename TLocalEdgeType, typename TEdgeType>
@@ -271,22 +279,25 @@ namespace graph_load {
   }
 
   template<typename TVertexIdType, typename TLocalEdgeType, typename TEdgeType>
-  size_t TileManager<TVertexIdType, TLocalEdgeType, TEdgeType>::getCountEdges() {
+  size_t TileManager<TVertexIdType, TLocalEdgeType, TEdgeType>::getCountEdges(
+      int64_t start, int64_t end) {
     size_t count_edges = 0;
-    for (int x = 0; x < config_.count_rows_partitions; ++x) {
-      for (int y = 0; y < config_.count_rows_partitions; ++y) {
-        count_edges += getSize({(uint64_t) x, (uint64_t) y});
-      }
+    for (int64_t i = start; i < end; ++i) {
+      int64_t x, y;
+      getPartitionOfTraversalIndex(i, &x, &y);
+      count_edges += getSize({(uint64_t) x, (uint64_t) y});
     }
     return count_edges;
   }
 
   template<typename TVertexIdType, typename TLocalEdgeType, typename TEdgeType>
-  void TileManager<TVertexIdType, TLocalEdgeType, TEdgeType>::computePartitionsPerThread(int num_threads) {
+  void TileManager<TVertexIdType, TLocalEdgeType, TEdgeType>::computePartitionsPerThread(
+      int num_threads, int64_t start, int64_t end) {
+    delete[] partition_range_per_thread_;
     partition_range_per_thread_ = new partition_range_per_thread[num_threads];
 
     uint64_t time_start = util::get_time_nsec();
-    size_t count_edges = this->getCountEdges();
+    size_t count_edges = this->getCountEdges(start, end);
     sg_log("Time taken for count Edges: %f\n", ((double) util::get_time_nsec() - time_start) / 1000000000.);
 
     size_t max_edges_per_thread = count_edges / num_threads;
@@ -295,31 +306,13 @@ namespace graph_load {
 
     size_t edges_processed = 0;
     size_t edges_current_thread = 0;
-    size_t current_start = 0;
+    size_t current_start = start;
     uint32_t current_thread = 0;
     uint64_t current_partition_count = 0;
 
-    size_t p2 = (size_t) pow(config_.count_rows_partitions, 2);
-
-    for (size_t i = 0; i < p2; ++i) {
+    for (int64_t i = start; i < end; ++i) {
       int64_t x = 0, y = 0;
-      switch (config_.traversal) {
-        case grc_tile_traversals_t::Hilbert: {
-          ::traversal::hilbert::d2xy(config_.count_rows_partitions, i, &x, &y);
-          break;
-        }
-        case grc_tile_traversals_t::ColumnFirst: {
-          ::traversal::column_first::d2xy(config_.count_rows_partitions, i, &x, &y);
-          break;
-        }
-        case grc_tile_traversals_t::RowFirst: {
-          ::traversal::row_first::d2xy(config_.count_rows_partitions, i, &x, &y);
-          break;
-        }
-        default:
-          sg_log("Wrong traveral given: %d\n", config_.traversal);
-          util::die(1);
-      }
+      getPartitionOfTraversalIndex(i, &x, &y);
       size_t edges_partition = getSize({(uint64_t) x, (uint64_t) y});
       edges_processed += edges_partition;
 
@@ -356,7 +349,7 @@ namespace graph_load {
 
     // Assign left-over partitions to last thread.
     partition_range_per_thread_[current_thread].start = current_start;
-    partition_range_per_thread_[current_thread].end = p2;
+    partition_range_per_thread_[current_thread].end = end;
     sg_log("Thread %d: Start %lu, End %lu, Edges %lu\n",
            current_thread,
            partition_range_per_thread_[current_thread].start,
@@ -374,10 +367,18 @@ namespace graph_load {
   void
   TileManager<TVertexIdType, TLocalEdgeType, TEdgeType>::generateAndWriteTiles(
       int max_thread) {
-    int nthread = calcProperNumThreads(max_thread);
+    int64_t p2 = config_.count_rows_partitions * config_.count_rows_partitions;
+    generateTiles(max_thread, 0, p2);
+    writeStatistics();
+  }
+
+  template <typename TVertexIdType, typename TLocalEdgeType, typename TEdgeType>
+  void TileManager<TVertexIdType, TLocalEdgeType, TEdgeType>::generateTiles(
+      int max_thread, int64_t start, int64_t end) {
+    int nthread = calcProperNumThreads(max_thread, end - start);
 
     uint64_t time_start = util::get_time_nsec();
-    this->computePartitionsPerThread(nthread);
+    this->computePartitionsPerThread(nthread, start, end);
     sg_log("Time taken for compute Partitions: %f\n", ((double) util::get_time_nsec() - time_start) / 1000000000.);
 
     sg_log("Generating tiles with %d threads concurrently.\n", nthread);
@@ -432,6 +433,13 @@ namespace graph_load {
     if (rc)
       util::die(1);
 
+    count_tiles_ += count_tiles;
+    count_edges_ += count_edges;
+  }
+
+  template <typename TVertexIdType, typename TLocalEdgeType, typename TEdgeType>
+  void
+  TileManager<TVertexIdType, TLocalEdgeType, TEdgeType>::writeStatistics() {
     // write the vertex -> tile-count file:
     std::string vertex_to_tile_count_file_name =
         core::getVertexToTileCountFileName(config_);
@@ -452,7 +460,7 @@ namespace graph_load {
 
     sg_log("Count vertex-to-tiles: %lu\n", count_vertex_to_tiles);
     sg_log("Size Index: %lu\n", index_size);
-    sg_log("Count Edges: %lu\n", count_edges);
+    sg_log("Count Edges: %lu\n", count_edges_);
 
     // first, read the global stats file from the partitioner:
     std::string partitioner_global_stats_file_name =
@@ -466,7 +474,8 @@ namespace graph_load {
     std::string global_stats_file_name = core::getGlobalStatFileName(config_);
 
     scenario_stats_t stat;
-    stat.count_tiles = count_tiles;
+    memset(&stat, 0, sizeof(stat));
+    stat.count_tiles = count_tiles_;
     stat.count_vertices = partitioner_stats.count_vertices;
     stat.is_weighted_graph = config_.output_weighted;
 
@@ -543,18 +552,34 @@ namespace graph_load {
     sg_assert(src_size <= MAX_VERTICES_PER_TILE, "");
     sg_assert(tgt_size <= MAX_VERTICES_PER_TILE, "");
 
-    // only use RLE if the edge-count is larger then 2-times the tgt-count,
-    // otherwise the RLE will actually increase the tile-size!
-    bool use_rle = config_.use_rle && (edge_count >= 2 * tgt_size);
+    // a bitmap can hold every edge only once
+    bool has_duplicates = false;
+    if (config_.use_bitmap) {
+      for (size_t i = 1; i < edge_count && !has_duplicates; ++i) {
+        has_duplicates = !(ctx.edge_set_[i - 1] < ctx.edge_set_[i]);
+      }
+    }
+
+    // pick the smallest encoding, e.g. RLE only pays off if the edge-count is
+    // larger then 2-times the tgt-count and a bitmap only for dense tiles
+    TileEncoding encoding =
+        core::chooseTileEncoding(edge_count, src_size, tgt_size, config_.use_rle,
+                                 config_.use_bitmap && !has_duplicates);
 
     size_t size_edge_src_block = sizeof(local_vertex_id_t) * edge_count;
     size_t size_edge_tgt_block = size_edge_src_block;
+    uint32_t words_per_row = BITMAP_WORDS_PER_ROW(src_size);
 
     // if using rle, take the tgt-block as the size times the
     // vertex-count-struct
-    if (use_rle) {
+    if (encoding == TileEncoding::TE_RLE) {
       size_edge_tgt_block = sizeof(vertex_count_t) * tgt_size;
     }
+    // a bitmap replaces the src-block, the tgt-block holds its row offsets
+    else if (encoding == TileEncoding::TE_Bitmap) {
+      size_edge_src_block = sizeof(uint64_t) * tgt_size * words_per_row;
+      size_edge_tgt_block = sizeof(uint32_t) * tgt_size;
+    }
 
     // only include weight-block if necessary
     size_t size_edge_weights_block = 0;
@@ -566,7 +591,8 @@ namespace graph_load {
                                     size_edge_tgt_block +
                                     size_edge_weights_block;
 
-    edge_block_t* block = (edge_block_t*)malloc(malloc_edge_block_size);
+    // zeroed for the bitmap
+    edge_block_t* block = (edge_block_t*)calloc(1, malloc_edge_block_size);
 
     block->block_id = ctx.block_id;
     block->offset_src = sizeof(edge_block_t);
@@ -577,12 +603,15 @@ namespace graph_load {
     local_vertex_id_t* edge_src_block =
         get_array(local_vertex_id_t*, block, block->offset_src);
 
-    // two different representations of the tgt-block, once with and without
-    // the rle-representation
+    // three different representations of the src/tgt-blocks, as lists, with
+    // the rle-representation of the tgt-block or as a bitmap
     local_vertex_id_t* edge_tgt_block =
         get_array(local_vertex_id_t*, block, block->offset_tgt);
     vertex_count_t* edge_tgt_block_rle =
         get_array(vertex_count_t*, block, block->offset_tgt);
+    uint64_t* edge_bitmap = get_array(uint64_t*, block, block->offset_src);
+    uint32_t* edge_row_offsets =
+        get_array(uint32_t*, block, block->offset_tgt);
 
     // only include weight if this graph shall be output as a weighted version
     float* edge_weight_block =
@@ -595,8 +624,15 @@ namespace graph_load {
     size_t rle_position = 0;
 
     for (size_t i = 0; i < edge_count; ++i) {
-      edge_src_block[i] = ctx.edge_set_[i].src;
-      if (use_rle) {
+      if (encoding == TileEncoding::TE_Bitmap) {
+        local_vertex_id_t current_tgt = ctx.edge_set_[i].tgt;
+        core::set_bitmap_edge(edge_bitmap, words_per_row, ctx.edge_set_[i].src,
+                              current_tgt);
+        if (i == 0 || current_tgt != ctx.edge_set_[i - 1].tgt) {
+          edge_row_offsets[current_tgt] = i;
+        }
+      } else if (encoding == TileEncoding::TE_RLE) {
+        edge_src_block[i] = ctx.edge_set_[i].src;
         local_vertex_id_t current_tgt = ctx.edge_set_[i].tgt;
         // check if we need to either increment the current count
         if (current_tgt == active_tgt) {
@@ -611,6 +647,7 @@ namespace graph_load {
         edge_tgt_block_rle[rle_position].count = current_count;
         edge_tgt_block_rle[rle_position].id = current_tgt;
       } else {
+        edge_src_block[i] = ctx.edge_set_[i].src;
         edge_tgt_block[i] = ctx.edge_set_[i].tgt;
       }
 
@@ -626,9 +663,12 @@ namespace graph_load {
 #ifdef SCALABLE_GRAPHS_DEBUG
     // check if calculated correctly:
     for (size_t i = 0; i < edge_count; ++i) {
+      if (encoding == TileEncoding::TE_Bitmap) {
+        continue;
+      }
       local_vertex_id_t src = edge_src_block[i];
       sg_assert(src == ctx.edge_set_[i].src, "");
-      if (!use_rle) {
+      if (encoding == TileEncoding::TE_List) {
         local_vertex_id_t tgt = edge_tgt_block[i];
         sg_assert(tgt == ctx.edge_set_[i].tgt, "");
       }
@@ -731,7 +771,7 @@ namespace graph_load {
     stat->count_vertex_src = src_size;
     stat->count_vertex_tgt = tgt_size;
     stat->block_id = block->block_id;
-    stat->use_rle = use_rle;
+    stat->encoding = encoding;
 
     std::string stat_file_name =
         core::getEdgeTileStatFileName(config_, block->block_id);
@@ -765,7 +805,7 @@ namespace graph_load {
   TileManager<TVertexIdType, TLocalEdgeType, TEdgeType>::~TileManager() {
     pthread_spin_destroy(&gv_lock);
     if (partition_range_per_thread_ != NULL) {
-      delete partition_range_per_thread_;
+      delete[] partition_range_per_thread_;
     }
   }
 }
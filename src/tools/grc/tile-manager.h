@@ -27,6 +27,13 @@ namespace graph_load {
 
     void generateAndWriteTiles(int max_thread);
 
+    // Tiles the partitions [start, end) of the traversal order. Can be called
+    // repeatedly with consecutive ranges, followed by one writeStatistics().
+    void generateTiles(int max_thread, int64_t start, int64_t end);
+
+    // Writes the vertex -> tile-count file and the global stats file.
+    void writeStatistics();
+
     ~TileManager();
 
   private:
@@ -68,11 +75,13 @@ namespace graph_load {
 
     size_t getSize(const partition_t& partition);
 
-    size_t getCountEdges();
+    size_t getCountEdges(int64_t start, int64_t end);
+
+    void getPartitionOfTraversalIndex(int64_t index, int64_t* x, int64_t* y);
 
     void processPartition(Context& ctx, int src, int tgt);
 
-    int calcProperNumThreads(int max_thread);
+    int calcProperNumThreads(int max_thread, int64_t count_partitions);
 
     bool needToStartNewEdgeBlock(
         TileManager<TVertexIdType, TLocalEdgeType, TEdgeType>::Context& ctx,
@@ -80,11 +89,13 @@ namespace graph_load {
 
     void writeTile(Context& ctx);
 
-    void computePartitionsPerThread(int num_threads);
+    void computePartitionsPerThread(int num_threads, int64_t start,
+                                    int64_t end);
 
     static void* threadMain(void* arg);
 
     int64_t count_tiles_;
+    int64_t count_edges_;
 
     partition_range_per_thread* partition_range_per_thread_;
 
@@ -0,0 +1,1003 @@
+#include "delta-store.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <util/hilbert.h>
+#include <util/column_first.h>
+#include <util/row_first.h>
+#include <core/util.h>
+#include <util/util.h>
+#include <util/arch.h>
+
+namespace scalable_graphs {
+namespace post_grc {
+
+  DeltaStore::DeltaStore(const config_t& config,
+                         const scenario_stats_t& global_stats,
+                         grc_tile_traversals_t traversal)
+      : config_(config), global_stats_(global_stats), traversal_(traversal),
+        count_edge_engines_(config.paths_to_tile.size()), count_partitions_(1),
+        use_rle_(false), use_bitmap_(false), count_base_tiles_(0) {
+    // same as the tiler: power of two partitions per row
+    while (count_partitions_ * MAX_VERTICES_PER_TILE <
+           global_stats_.count_vertices) {
+      count_partitions_ *= 2;
+    }
+    config_.count_edge_processors = count_edge_engines_;
+  }
+
+  DeltaStore::~DeltaStore() {
+    for (auto container : base_containers_) {
+      delete container;
+    }
+  }
+
+  void DeltaStore::open() {
+    for (int i = 0; i < count_edge_engines_; ++i) {
+      std::string container_file_name =
+          core::getTileContainerFileName(config_, i);
+      if (!core::TileContainer::exists(container_file_name)) {
+        sg_err("Tile container %s missing, delta tiles require the graph to "
+               "be packed by post-grc-packer\n",
+               container_file_name.c_str());
+        util::die(1);
+      }
+      core::TileContainer* container = new core::TileContainer();
+      container->open(container_file_name);
+
+      const tile_container_header_t& header = container->header();
+      if (header.is_weighted_graph != global_stats_.is_weighted_graph ||
+          header.is_index_32_bits != global_stats_.is_index_32_bits) {
+        sg_err("Tile container %s does not match the graph\n",
+               container_file_name.c_str());
+        util::die(1);
+      }
+      for (size_t j = 0; j < container->countTiles(); ++j) {
+        TileEncoding encoding = container->entry(j).stats.encoding;
+        use_rle_ |= encoding == TileEncoding::TE_RLE;
+        use_bitmap_ |= encoding == TileEncoding::TE_Bitmap;
+      }
+
+      count_base_tiles_ += container->countTiles();
+      base_containers_.push_back(container);
+    }
+
+    // the tiles are distributed round-robin in the order of their traversal
+    // index
+    base_block_ids_.resize(count_base_tiles_);
+    for (int i = 0; i < count_edge_engines_; ++i) {
+      uint64_t expected_count_tiles =
+          (count_base_tiles_ + count_edge_engines_ - 1 - i) /
+          count_edge_engines_;
+      if (base_containers_[i]->countTiles() != expected_count_tiles) {
+        sg_err("Edge engine %d holds %lu base tiles, expected %lu\n", i,
+               base_containers_[i]->countTiles(), expected_count_tiles);
+        util::die(1);
+      }
+    }
+    for (uint64_t global_tile_id = 0; global_tile_id < count_base_tiles_;
+         ++global_tile_id) {
+      size_t local_tile_id;
+      const core::TileContainer& container =
+          getContainer(global_tile_id, &local_tile_id);
+      base_block_ids_[global_tile_id] =
+          container.entry(local_tile_id).stats.block_id;
+      if (global_tile_id > 0 &&
+          base_block_ids_[global_tile_id] <=
+              base_block_ids_[global_tile_id - 1]) {
+        sg_err("Base tile %lu is out of traversal order\n", global_tile_id);
+        util::die(1);
+      }
+    }
+
+    tombstones_.resize(count_edge_engines_);
+    size_t count_delta_tiles = 0;
+    for (int i = 0; i < count_edge_engines_; ++i) {
+      std::string tombstones_file_name =
+          core::getTileTombstonesFileName(config_, i);
+      if (core::TileTombstones::exists(tombstones_file_name)) {
+        std::vector<tile_tombstone_t> tombstones;
+        if (core::TileTombstones::read(tombstones_file_name, &tombstones) !=
+            base_containers_[i]->countTiles()) {
+          sg_err("Tombstones %s do not match the base tiles\n",
+                 tombstones_file_name.c_str());
+          util::die(1);
+        }
+        tombstones_[i].insert(tombstones.begin(), tombstones.end());
+      }
+
+      std::string delta_file_name =
+          core::getDeltaTileContainerFileName(config_, i);
+      if (core::TileContainer::exists(delta_file_name)) {
+        core::TileContainer delta_container;
+        delta_container.open(delta_file_name);
+        count_delta_tiles += delta_container.countTiles();
+
+        Tile tile;
+        for (size_t j = 0; j < delta_container.countTiles(); ++j) {
+          readTile(delta_container, j, true, &tile);
+          for (size_t k = 0; k < tile.src.size(); ++k) {
+            delta_edges_.insert(std::make_pair(
+                std::make_pair(tile.src_ids[tile.src[k]],
+                               tile.tgt_ids[tile.tgt[k]]),
+                global_stats_.is_weighted_graph ? tile.weights[k] : 0.0f));
+          }
+        }
+      }
+    }
+
+    if (global_stats_.count_tiles != count_base_tiles_ + count_delta_tiles) {
+      sg_err("Global stats count %lu tiles, the containers hold %lu + %lu\n",
+             global_stats_.count_tiles, count_base_tiles_, count_delta_tiles);
+      util::die(1);
+    }
+
+    sg_log("Opened %lu base tiles, %lu delta edges and %lu tombstones\n",
+           count_base_tiles_, delta_edges_.size(), countTombstones());
+  }
+
+  size_t DeltaStore::countTombstones() const {
+    size_t count = 0;
+    for (const auto& tombstones : tombstones_) {
+      count += tombstones.size();
+    }
+    return count;
+  }
+
+  const core::TileContainer&
+  DeltaStore::getContainer(uint64_t global_tile_id,
+                           size_t* local_tile_id) const {
+    *local_tile_id = global_tile_id / count_edge_engines_;
+    return *base_containers_[global_tile_id % count_edge_engines_];
+  }
+
+  void DeltaStore::readTile(const core::TileContainer& container,
+                            size_t tile_id, bool with_edges,
+                            Tile* tile) const {
+    const tile_container_entry_t& entry = container.entry(tile_id);
+    tile->stats = entry.stats;
+
+    edge_block_index_t* index =
+        (edge_block_index_t*)malloc(entry.size_index);
+    container.readEdgeBlockIndex(tile_id, index);
+
+    uint32_t* src_index = get_array(uint32_t*, index, index->offset_src_index);
+    uint32_t* tgt_index = get_array(uint32_t*, index, index->offset_tgt_index);
+    char* src_upper_bits =
+        get_array(char*, index, index->offset_src_index_bit_extension);
+    char* tgt_upper_bits =
+        get_array(char*, index, index->offset_tgt_index_bit_extension);
+
+    tile->src_ids.resize(tile->stats.count_vertex_src);
+    tile->src_local.clear();
+    for (uint32_t i = 0; i < tile->stats.count_vertex_src; ++i) {
+      uint64_t id = src_index[i];
+      if (!global_stats_.is_index_32_bits) {
+        id |= (uint64_t)eval_bool_array(src_upper_bits, i) << 32;
+      }
+      tile->src_ids[i] = id;
+      tile->src_local[id] = i;
+    }
+    tile->tgt_ids.resize(tile->stats.count_vertex_tgt);
+    tile->tgt_local.clear();
+    for (uint32_t i = 0; i < tile->stats.count_vertex_tgt; ++i) {
+      uint64_t id = tgt_index[i];
+      if (!global_stats_.is_index_32_bits) {
+        id |= (uint64_t)eval_bool_array(tgt_upper_bits, i) << 32;
+      }
+      tile->tgt_ids[i] = id;
+      tile->tgt_local[id] = i;
+    }
+    free(index);
+
+    tile->src.clear();
+    tile->tgt.clear();
+    tile->weights.clear();
+    if (!with_edges) {
+      return;
+    }
+
+    edge_block_t* block = (edge_block_t*)malloc(entry.size_edge_block);
+    container.readEdgeBlock(tile_id, block);
+
+    uint32_t count_edges = tile->stats.count_edges;
+    local_vertex_id_t* src_block =
+        get_array(local_vertex_id_t*, block, block->offset_src);
+
+    if (tile->stats.encoding == TileEncoding::TE_Bitmap) {
+      tile->src.resize(count_edges);
+      tile->tgt.resize(count_edges);
+      core::for_each_bitmap_edge(
+          get_array(uint64_t*, block, block->offset_src),
+          get_array(uint32_t*, block, block->offset_tgt),
+          tile->stats.count_vertex_tgt,
+          BITMAP_WORDS_PER_ROW(tile->stats.count_vertex_src), 0, count_edges,
+          [&](uint32_t edge_id, local_vertex_id_t src, local_vertex_id_t tgt) {
+            tile->src[edge_id] = src;
+            tile->tgt[edge_id] = tgt;
+          });
+    } else if (tile->stats.encoding == TileEncoding::TE_RLE) {
+      tile->src.assign(src_block, src_block + count_edges);
+      vertex_count_t* tgt_block_rle =
+          get_array(vertex_count_t*, block, block->offset_tgt);
+      for (size_t i = 0; tile->tgt.size() < count_edges; ++i) {
+        // a count of 0 wraps around, all 65536 sources
+        size_t count = tgt_block_rle[i].count == 0 ? MAX_VERTICES_PER_TILE
+                                                   : tgt_block_rle[i].count;
+        tile->tgt.insert(tile->tgt.end(), count, tgt_block_rle[i].id);
+      }
+    } else {
+      tile->src.assign(src_block, src_block + count_edges);
+      local_vertex_id_t* tgt_block =
+          get_array(local_vertex_id_t*, block, block->offset_tgt);
+      tile->tgt.assign(tgt_block, tgt_block + count_edges);
+    }
+
+    if (global_stats_.is_weighted_graph) {
+      float* weight_block = get_array(float*, block, block->offset_weight);
+      tile->weights.assign(weight_block, weight_block + count_edges);
+    }
+    free(block);
+  }
+
+  int64_t DeltaStore::getTraversalIndex(uint64_t src, uint64_t tgt) const {
+    int64_t x = src / MAX_VERTICES_PER_TILE;
+    int64_t y = tgt / MAX_VERTICES_PER_TILE;
+    switch (traversal_) {
+    case grc_tile_traversals_t::Hilbert:
+      return ::traversal::hilbert::xy2d(count_partitions_, x, y);
+    case grc_tile_traversals_t::ColumnFirst:
+      return ::traversal::column_first::xy2d(count_partitions_, x, y);
+    case grc_tile_traversals_t::RowFirst:
+      return ::traversal::row_first::xy2d(count_partitions_, x, y);
+    default:
+      sg_log("Wrong traveral given: %d\n", traversal_);
+      util::die(1);
+    }
+    return -1;
+  }
+
+  void DeltaStore::getCandidateTiles(int64_t traversal_index,
+                                     std::vector<uint64_t>* tiles) const {
+    tiles->clear();
+    auto it = std::upper_bound(base_block_ids_.begin(), base_block_ids_.end(),
+                               (uint64_t)traversal_index);
+    if (it == base_block_ids_.begin()) {
+      return;
+    }
+    uint64_t last = (it - base_block_ids_.begin()) - 1;
+    // a tile starting at the partition may have a predecessor ending in it
+    if (base_block_ids_[last] == (uint64_t)traversal_index && last > 0) {
+      tiles->push_back(last - 1);
+    }
+    tiles->push_back(last);
+  }
+
+  size_t DeltaStore::deleteEdges(std::vector<edge_t>* edges) {
+    // Go in traversal order, the candidate tiles only move forward, which
+    // bounds the decoded tiles to a small window.
+    std::vector<std::pair<int64_t, edge_t> > ordered;
+    ordered.reserve(edges->size());
+    for (const auto& edge : *edges) {
+      ordered.push_back(
+          std::make_pair(getTraversalIndex(edge.src, edge.tgt), edge));
+    }
+    std::sort(ordered.begin(), ordered.end(),
+              [](const std::pair<int64_t, edge_t>& lhs,
+                 const std::pair<int64_t, edge_t>& rhs) {
+                return lhs.first < rhs.first;
+              });
+
+    std::map<uint64_t, Tile*> tiles;
+    std::vector<uint64_t> candidates;
+    edges->clear();
+
+    for (const auto& item : ordered) {
+      const edge_t& edge = item.second;
+
+      auto delta_edge = delta_edges_.find(std::make_pair(edge.src, edge.tgt));
+      if (delta_edge != delta_edges_.end()) {
+        delta_edges_.erase(delta_edge);
+        edges->push_back(edge);
+        continue;
+      }
+
+      getCandidateTiles(item.first, &candidates);
+      if (candidates.empty()) {
+        continue;
+      }
+      while (!tiles.empty() && tiles.begin()->first < candidates.front()) {
+        delete tiles.begin()->second;
+        tiles.erase(tiles.begin());
+      }
+
+      bool found = false;
+      for (uint64_t global_tile_id : candidates) {
+        size_t local_tile_id;
+        const core::TileContainer& container =
+            getContainer(global_tile_id, &local_tile_id);
+
+        Tile*& tile = tiles[global_tile_id];
+        if (tile == NULL) {
+          tile = new Tile();
+          readTile(container, local_tile_id, true, tile);
+        }
+
+        auto src_local = tile->src_local.find(edge.src);
+        auto tgt_local = tile->tgt_local.find(edge.tgt);
+        if (src_local == tile->src_local.end() ||
+            tgt_local == tile->tgt_local.end()) {
+          continue;
+        }
+
+        // the edges of a tile are sorted by (tgt, src)
+        uint32_t lower = 0;
+        uint32_t upper = tile->src.size();
+        while (lower < upper) {
+          uint32_t middle = lower + (upper - lower) / 2;
+          if (tile->tgt[middle] < tgt_local->second ||
+              (tile->tgt[middle] == tgt_local->second &&
+               tile->src[middle] < src_local->second)) {
+            lower = middle + 1;
+          } else {
+            upper = middle;
+          }
+        }
+
+        std::set<tile_tombstone_t>& tombstones =
+            tombstones_[global_tile_id % count_edge_engines_];
+        for (uint32_t i = lower;
+             i < tile->src.size() && tile->tgt[i] == tgt_local->second &&
+             tile->src[i] == src_local->second;
+             ++i) {
+          tile_tombstone_t tombstone = {(uint32_t)local_tile_id, i};
+          if (tombstones.insert(tombstone).second) {
+            found = true;
+            break;
+          }
+        }
+        if (found) {
+          edges->push_back(edge);
+          break;
+        }
+      }
+    }
+
+    for (const auto& tile : tiles) {
+      delete tile.second;
+    }
+    return ordered.size() - edges->size();
+  }
+
+  void DeltaStore::insertEdges(const std::vector<delta_edge_t>& edges) {
+    for (const auto& edge : edges) {
+      if (edge.src >= global_stats_.count_vertices ||
+          edge.tgt >= global_stats_.count_vertices) {
+        sg_err("Edge (%lu, %lu) is out of the %lu vertices of the graph\n",
+               edge.src, edge.tgt, global_stats_.count_vertices);
+        util::die(1);
+      }
+      delta_edges_.insert(
+          std::make_pair(std::make_pair(edge.src, edge.tgt), edge.weight));
+    }
+  }
+
+  void DeltaStore::buildTile(const std::vector<delta_edge_t>& edges,
+                             uint64_t block_id, tile_stats_t* stats,
+                             edge_block_t** edge_block,
+                             edge_block_index_t** index) const {
+    std::unordered_map<uint64_t, local_vertex_id_t> src_global_to_local;
+    std::unordered_map<uint64_t, local_vertex_id_t> tgt_global_to_local;
+    std::vector<uint64_t> src_local_to_global;
+    std::vector<uint64_t> tgt_local_to_global;
+    std::vector<local_edge_weighted_t> local_edges(edges.size());
+
+    for (size_t i = 0; i < edges.size(); ++i) {
+      auto src = src_global_to_local.find(edges[i].src);
+      if (src == src_global_to_local.end()) {
+        src = src_global_to_local
+                  .insert(std::make_pair(edges[i].src,
+                                         src_local_to_global.size()))
+                  .first;
+        src_local_to_global.push_back(edges[i].src);
+      }
+      auto tgt = tgt_global_to_local.find(edges[i].tgt);
+      if (tgt == tgt_global_to_local.end()) {
+        tgt = tgt_global_to_local
+                  .insert(std::make_pair(edges[i].tgt,
+                                         tgt_local_to_global.size()))
+                  .first;
+        tgt_local_to_global.push_back(edges[i].tgt);
+      }
+      local_edges[i].src = src->second;
+      local_edges[i].tgt = tgt->second;
+      local_edges[i].weight = edges[i].weight;
+    }
+    sg_assert(src_local_to_global.size() <= MAX_VERTICES_PER_TILE, "");
+    sg_assert(tgt_local_to_global.size() <= MAX_VERTICES_PER_TILE, "");
+
+    // sort by tgt, then by src
+    std::sort(local_edges.begin(), local_edges.end());
+
+    size_t edge_count = local_edges.size();
+    size_t src_size = src_local_to_global.size();
+    size_t tgt_size = tgt_local_to_global.size();
+
+    stats->block_id = block_id;
+    stats->count_vertex_src = src_size;
+    stats->count_vertex_tgt = tgt_size;
+    stats->count_edges = edge_count;
+    // a bitmap can hold every edge only once
+    bool has_duplicates = false;
+    for (size_t i = 1; i < edge_count && !has_duplicates; ++i) {
+      has_duplicates = local_edges[i - 1].src == local_edges[i].src &&
+                       local_edges[i - 1].tgt == local_edges[i].tgt;
+    }
+    // only use encodings that actually shrink the tile, see the tiler
+    stats->encoding =
+        core::chooseTileEncoding(edge_count, src_size, tgt_size, use_rle_,
+                                 use_bitmap_ && !has_duplicates);
+
+    bool is_weighted = global_stats_.is_weighted_graph;
+    size_t size_edge_src_block = core::getSizeEdgeSrcBlock(*stats);
+    size_t size_edge_tgt_block = core::getSizeEdgeTgtBlock(*stats);
+    uint32_t words_per_row = BITMAP_WORDS_PER_ROW(src_size);
+
+    edge_block_t* block =
+        (edge_block_t*)calloc(1, core::getSizeEdgeBlock(*stats, is_weighted));
+    block->block_id = block_id;
+    block->offset_src = sizeof(edge_block_t);
+    block->offset_tgt = block->offset_src + size_edge_src_block;
+    block->offset_weight = block->offset_tgt + size_edge_tgt_block;
+
+    local_vertex_id_t* edge_src_block =
+        get_array(local_vertex_id_t*, block, block->offset_src);
+    local_vertex_id_t* edge_tgt_block =
+        get_array(local_vertex_id_t*, block, block->offset_tgt);
+    vertex_count_t* edge_tgt_block_rle =
+        get_array(vertex_count_t*, block, block->offset_tgt);
+    uint64_t* edge_bitmap = get_array(uint64_t*, block, block->offset_src);
+    uint32_t* edge_row_offsets = get_array(uint32_t*, block, block->offset_tgt);
+    float* edge_weight_block =
+        is_weighted ? get_array(float*, block, block->offset_weight) : NULL;
+
+    local_vertex_id_t active_tgt = edge_count > 0 ? local_edges[0].tgt : 0;
+    uint32_t current_count = 0;
+    size_t rle_position = 0;
+    for (size_t i = 0; i < edge_count; ++i) {
+      if (stats->encoding == TileEncoding::TE_Bitmap) {
+        local_vertex_id_t current_tgt = local_edges[i].tgt;
+        core::set_bitmap_edge(edge_bitmap, words_per_row, local_edges[i].src,
+                              current_tgt);
+        if (i == 0 || current_tgt != local_edges[i - 1].tgt) {
+          edge_row_offsets[current_tgt] = i;
+        }
+      } else if (stats->encoding == TileEncoding::TE_RLE) {
+        edge_src_block[i] = local_edges[i].src;
+        local_vertex_id_t current_tgt = local_edges[i].tgt;
+        if (current_tgt == active_tgt) {
+          ++current_count;
+        } else {
+          active_tgt = current_tgt;
+          current_count = 1;
+          ++rle_position;
+        }
+        edge_tgt_block_rle[rle_position].count = current_count;
+        edge_tgt_block_rle[rle_position].id = current_tgt;
+      } else {
+        edge_src_block[i] = local_edges[i].src;
+        edge_tgt_block[i] = local_edges[i].tgt;
+      }
+      if (is_weighted) {
+        edge_weight_block[i] = local_edges[i].weight;
+      }
+    }
+
+    bool is_index_32_bits = global_stats_.is_index_32_bits;
+    size_t src_size_bytes = src_size * sizeof(uint32_t);
+    size_t tgt_size_bytes = tgt_size * sizeof(uint32_t);
+    size_t src_extended_size_bytes =
+        is_index_32_bits ? 0 : size_bool_array(src_size);
+
+    edge_block_index_t* block_index = (edge_block_index_t*)calloc(
+        1, core::getSizeEdgeBlockIndex(*stats, is_index_32_bits));
+    block_index->block_id = block_id;
+    block_index->count_src_vertices = src_size;
+    block_index->count_tgt_vertices = tgt_size;
+    block_index->offset_src_index = sizeof(edge_block_index_t);
+    block_index->offset_tgt_index =
+        block_index->offset_src_index + src_size_bytes;
+    block_index->offset_src_index_bit_extension =
+        block_index->offset_tgt_index + tgt_size_bytes;
+    block_index->offset_tgt_index_bit_extension =
+        block_index->offset_src_index_bit_extension + src_extended_size_bytes;
+
+    uint32_t* src_index_block =
+        get_array(uint32_t*, block_index, block_index->offset_src_index);
+    uint32_t* tgt_index_block =
+        get_array(uint32_t*, block_index, block_index->offset_tgt_index);
+    char* src_index_extended_block = get_array(
+        char*, block_index, block_index->offset_src_index_bit_extension);
+    char* tgt_index_extended_block = get_array(
+        char*, block_index, block_index->offset_tgt_index_bit_extension);
+
+    for (size_t i = 0; i < src_size; ++i) {
+      src_index_block[i] = src_local_to_global[i] & UINT32_MAX;
+      if (!is_index_32_bits) {
+        set_bool_array(src_index_extended_block, i,
+                       (src_local_to_global[i] & (1ul << 32)));
+      }
+    }
+    for (size_t i = 0; i < tgt_size; ++i) {
+      tgt_index_block[i] = tgt_local_to_global[i] & UINT32_MAX;
+      if (!is_index_32_bits) {
+        set_bool_array(tgt_index_extended_block, i,
+                       (tgt_local_to_global[i] & (1ul << 32)));
+      }
+    }
+
+    *edge_block = block;
+    *index = block_index;
+  }
+
+  void DeltaStore::compact() {
+    // route every delta edge to a base tile with room for its vertices
+    std::vector<std::pair<int64_t, edge_map_t::const_iterator> > ordered;
+    ordered.reserve(delta_edges_.size());
+    for (auto it = delta_edges_.begin(); it != delta_edges_.end(); ++it) {
+      ordered.push_back(std::make_pair(
+          getTraversalIndex(it->first.first, it->first.second), it));
+    }
+    std::stable_sort(
+        ordered.begin(), ordered.end(),
+        [](const std::pair<int64_t, edge_map_t::const_iterator>& lhs,
+           const std::pair<int64_t, edge_map_t::const_iterator>& rhs) {
+          return lhs.first < rhs.first;
+        });
+
+    struct RoutedTile {
+      Tile tile;
+      std::unordered_set<uint64_t> new_src;
+      std::unordered_set<uint64_t> new_tgt;
+    };
+    std::map<uint64_t, RoutedTile*> tiles;
+    std::map<uint64_t, std::vector<delta_edge_t> > merged_edges;
+    edge_map_t remaining_edges;
+    std::vector<uint64_t> candidates;
+
+    for (const auto& item : ordered) {
+      delta_edge_t edge = {item.second->first.first, item.second->first.second,
+                           item.second->second};
+
+      getCandidateTiles(item.first, &candidates);
+      while (!tiles.empty() && !candidates.empty() &&
+             tiles.begin()->first < candidates.front()) {
+        delete tiles.begin()->second;
+        tiles.erase(tiles.begin());
+      }
+
+      bool merged = false;
+      for (uint64_t global_tile_id : candidates) {
+        RoutedTile*& routed = tiles[global_tile_id];
+        if (routed == NULL) {
+          routed = new RoutedTile();
+          size_t local_tile_id;
+          const core::TileContainer& container =
+              getContainer(global_tile_id, &local_tile_id);
+          readTile(container, local_tile_id, false, &routed->tile);
+        }
+
+        bool has_src = routed->tile.src_local.count(edge.src) > 0 ||
+                       routed->new_src.count(edge.src) > 0;
+        bool has_tgt = routed->tile.tgt_local.count(edge.tgt) > 0 ||
+                       routed->new_tgt.count(edge.tgt) > 0;
+        if ((!has_src && routed->tile.src_ids.size() +
+                                 routed->new_src.size() >=
+                             MAX_VERTICES_PER_TILE) ||
+            (!has_tgt && routed->tile.tgt_ids.size() +
+                                 routed->new_tgt.size() >=
+                             MAX_VERTICES_PER_TILE)) {
+          continue;
+        }
+
+        if (!has_src) {
+          routed->new_src.insert(edge.src);
+        }
+        if (!has_tgt) {
+          routed->new_tgt.insert(edge.tgt);
+        }
+        merged_edges[global_tile_id].push_back(edge);
+        merged = true;
+        break;
+      }
+
+      if (!merged) {
+        remaining_edges.insert(*item.second);
+      }
+    }
+    for (const auto& tile : tiles) {
+      delete tile.second;
+    }
+
+    sg_log("Merging %lu delta edges into base tiles, %lu stay in delta "
+           "tiles\n",
+           delta_edges_.size() - remaining_edges.size(),
+           remaining_edges.size());
+
+    for (int i = 0; i < count_edge_engines_; ++i) {
+      compactEdgeEngine(i, merged_edges);
+      tombstones_[i].clear();
+    }
+    delta_edges_.swap(remaining_edges);
+  }
+
+  void DeltaStore::compactEdgeEngine(
+      int edge_engine_index,
+      const std::map<uint64_t, std::vector<delta_edge_t> >& merged_edges) {
+    core::TileContainer* container = base_containers_[edge_engine_index];
+    size_t count_tiles = container->countTiles();
+
+    // deleted edges per local tile
+    std::map<uint32_t, std::vector<uint32_t> > deleted_edges;
+    for (const auto& tombstone : tombstones_[edge_engine_index]) {
+      deleted_edges[tombstone.tile_id].push_back(tombstone.edge_id);
+    }
+
+    std::vector<delta_edge_t> edges;
+    Tile tile;
+    // Collects the edges of a changed tile, returns false if the tile can be
+    // copied as is.
+    auto collectEdges = [&](size_t tile_id) {
+      uint64_t global_tile_id = tile_id * count_edge_engines_ + edge_engine_index;
+      auto merged = merged_edges.find(global_tile_id);
+      auto deleted = deleted_edges.find(tile_id);
+      if (merged == merged_edges.end() && deleted == deleted_edges.end()) {
+        return false;
+      }
+
+      readTile(*container, tile_id, true, &tile);
+      edges.clear();
+      auto deleted_edge = deleted != deleted_edges.end()
+                              ? deleted->second.begin()
+                              : std::vector<uint32_t>::const_iterator();
+      for (uint32_t i = 0; i < tile.src.size(); ++i) {
+        if (deleted != deleted_edges.end() &&
+            deleted_edge != deleted->second.end() && *deleted_edge == i) {
+          ++deleted_edge;
+          continue;
+        }
+        delta_edge_t edge = {tile.src_ids[tile.src[i]],
+                             tile.tgt_ids[tile.tgt[i]],
+                             tile.weights.empty() ? 0.0f : tile.weights[i]};
+        edges.push_back(edge);
+      }
+      if (merged != merged_edges.end()) {
+        edges.insert(edges.end(), merged->second.begin(),
+                     merged->second.end());
+      }
+      return true;
+    };
+
+    // the layout of the container depends on the stats, so the changed
+    // tiles are built twice, once for their stats and once for writing
+    tile_stats_t* tile_stats = new tile_stats_t[count_tiles];
+    for (size_t j = 0; j < count_tiles; ++j) {
+      tile_stats[j] = container->entry(j).stats;
+      if (collectEdges(j)) {
+        edge_block_t* edge_block;
+        edge_block_index_t* index;
+        buildTile(edges, tile_stats[j].block_id, &tile_stats[j], &edge_block,
+                  &index);
+        free(edge_block);
+        free(index);
+      }
+    }
+
+    std::string container_file_name =
+        core::getTileContainerFileName(config_, edge_engine_index);
+    std::string compacted_file_name = container_file_name + ".compact";
+    core::TileContainerWriter writer(
+        compacted_file_name, tile_stats, count_tiles,
+        global_stats_.is_weighted_graph, global_stats_.is_index_32_bits);
+
+    for (size_t j = 0; j < count_tiles; ++j) {
+      edge_block_t* edge_block;
+      edge_block_index_t* index;
+      if (collectEdges(j)) {
+        tile_stats_t stats;
+        buildTile(edges, tile_stats[j].block_id, &stats, &edge_block, &index);
+      } else {
+        const tile_container_entry_t& entry = container->entry(j);
+        edge_block = (edge_block_t*)malloc(entry.size_edge_block);
+        index = (edge_block_index_t*)malloc(entry.size_index);
+        container->readEdgeBlock(j, edge_block);
+        container->readEdgeBlockIndex(j, index);
+      }
+      // store the local tile id, like the packer
+      edge_block->block_id = j;
+      writer.writeEdgeBlock(j, edge_block);
+      writer.writeEdgeBlockIndex(j, index);
+      free(edge_block);
+      free(index);
+    }
+    writer.close();
+    delete[] tile_stats;
+
+    delete container;
+    if (rename(compacted_file_name.c_str(), container_file_name.c_str()) !=
+        0) {
+      sg_err("Unable to replace %s: %s\n", container_file_name.c_str(),
+             strerror(errno));
+      util::die(1);
+    }
+    base_containers_[edge_engine_index] = new core::TileContainer();
+    base_containers_[edge_engine_index]->open(container_file_name);
+
+    sg_log("Compacted %lu tiles of edge engine %d\n", count_tiles,
+           edge_engine_index);
+  }
+
+  void DeltaStore::write() {
+    // cut the delta edges into tiles in traversal order, like the tiler
+    std::vector<std::pair<int64_t, delta_edge_t> > ordered;
+    ordered.reserve(delta_edges_.size());
+    for (const auto& item : delta_edges_) {
+      delta_edge_t edge = {item.first.first, item.first.second, item.second};
+      ordered.push_back(
+          std::make_pair(getTraversalIndex(edge.src, edge.tgt), edge));
+    }
+    std::stable_sort(ordered.begin(), ordered.end(),
+                     [](const std::pair<int64_t, delta_edge_t>& lhs,
+                        const std::pair<int64_t, delta_edge_t>& rhs) {
+                       return lhs.first < rhs.first;
+                     });
+
+    std::vector<std::vector<delta_edge_t> > delta_tiles;
+    std::vector<uint64_t> delta_block_ids;
+    std::unordered_set<uint64_t> src_set;
+    std::unordered_set<uint64_t> tgt_set;
+    for (const auto& item : ordered) {
+      const delta_edge_t& edge = item.second;
+      size_t src_size = src_set.size() + (src_set.count(edge.src) == 0);
+      size_t tgt_size = tgt_set.size() + (tgt_set.count(edge.tgt) == 0);
+      if (delta_tiles.empty() || src_size > MAX_VERTICES_PER_TILE ||
+          tgt_size > MAX_VERTICES_PER_TILE) {
+        delta_tiles.push_back(std::vector<delta_edge_t>());
+        delta_block_ids.push_back(item.first);
+        src_set.clear();
+        tgt_set.clear();
+      }
+      src_set.insert(edge.src);
+      tgt_set.insert(edge.tgt);
+      delta_tiles.back().push_back(edge);
+    }
+
+    for (int i = 0; i < count_edge_engines_; ++i) {
+      // delta tile k has the global id count_base_tiles_ + k
+      std::vector<size_t> engine_tiles;
+      for (size_t k = 0; k < delta_tiles.size(); ++k) {
+        if ((count_base_tiles_ + k) % count_edge_engines_ == (uint64_t)i) {
+          engine_tiles.push_back(k);
+        }
+      }
+
+      std::string delta_file_name =
+          core::getDeltaTileContainerFileName(config_, i);
+      if (engine_tiles.empty()) {
+        unlink(delta_file_name.c_str());
+      } else {
+        size_t count_tiles = engine_tiles.size();
+        tile_stats_t* tile_stats = new tile_stats_t[count_tiles];
+        std::vector<edge_block_t*> edge_blocks(count_tiles);
+        std::vector<edge_block_index_t*> indices(count_tiles);
+        for (size_t j = 0; j < count_tiles; ++j) {
+          size_t k = engine_tiles[j];
+          buildTile(delta_tiles[k], delta_block_ids[k], &tile_stats[j],
+                    &edge_blocks[j], &indices[j]);
+          // the engine-local tile id, following the base tiles
+          edge_blocks[j]->block_id = base_containers_[i]->countTiles() + j;
+        }
+
+        core::TileContainerWriter writer(
+            delta_file_name, tile_stats, count_tiles,
+            global_stats_.is_weighted_graph, global_stats_.is_index_32_bits);
+        for (size_t j = 0; j < count_tiles; ++j) {
+          writer.writeEdgeBlock(j, edge_blocks[j]);
+          writer.writeEdgeBlockIndex(j, indices[j]);
+          free(edge_blocks[j]);
+          free(indices[j]);
+        }
+        writer.close();
+        delete[] tile_stats;
+      }
+
+      std::string tombstones_file_name =
+          core::getTileTombstonesFileName(config_, i);
+      if (tombstones_[i].empty()) {
+        unlink(tombstones_file_name.c_str());
+      } else {
+        std::vector<tile_tombstone_t> tombstones(tombstones_[i].begin(),
+                                                 tombstones_[i].end());
+        core::TileTombstones::write(tombstones_file_name,
+                                    base_containers_[i]->countTiles(),
+                                    &tombstones);
+      }
+    }
+
+    // the engines take the count of tiles from the global stats, which are
+    // copied to every meta directory
+    global_stats_.count_tiles = count_base_tiles_ + delta_tiles.size();
+    util::writeDataToFile(core::getGlobalStatFileName(config_.path_to_globals),
+                          &global_stats_, sizeof(global_stats_));
+    for (const auto& path_to_meta : config_.paths_to_meta) {
+      std::string stat_file_name = core::getGlobalStatFileName(path_to_meta);
+      if (access(stat_file_name.c_str(), F_OK) == 0) {
+        util::writeDataToFile(stat_file_name, &global_stats_,
+                              sizeof(global_stats_));
+      }
+    }
+
+    // the transposed tiles are derived from the forward ones
+    bool removed_transposed = false;
+    for (int i = 0; i < count_edge_engines_; ++i) {
+      std::string transposed_file_name =
+          core::getTransposedTileContainerFileName(config_, i);
+      if (core::TileContainer::exists(transposed_file_name)) {
+        unlink(transposed_file_name.c_str());
+        removed_transposed = true;
+      }
+    }
+    if (removed_transposed) {
+      unlink(core::getTransposedVertexToTileCountFileName(
+                 config_.path_to_globals)
+                 .c_str());
+      unlink(core::getTransposedVertexToTileIndexFileName(
+                 config_.path_to_globals)
+                 .c_str());
+      sg_log2("Removed the outdated transposed tiles, rerun "
+              "post-grc-transposer\n");
+    }
+
+    sg_log("Wrote %lu delta tiles with %lu edges and %lu tombstones\n",
+           delta_tiles.size(), delta_edges_.size(), countTombstones());
+  }
+
+  void DeltaStore::writeTransposed() {
+    std::vector<core::TileContainer*> delta_containers(count_edge_engines_,
+                                                       NULL);
+    for (int i = 0; i < count_edge_engines_; ++i) {
+      std::string delta_file_name =
+          core::getDeltaTileContainerFileName(config_, i);
+      if (core::TileContainer::exists(delta_file_name)) {
+        delta_containers[i] = new core::TileContainer();
+        delta_containers[i]->open(delta_file_name);
+      }
+    }
+
+    uint64_t count_forward_tiles = global_stats_.count_tiles;
+    std::vector<delta_edge_t> edges;
+    Tile tile;
+    // Collects the edges of forward tile g with source and target swapped,
+    // without the deleted ones, returns the traversal index of the tile.
+    auto collectTransposedEdges = [&](uint64_t global_tile_id) {
+      int edge_engine_index = global_tile_id % count_edge_engines_;
+      size_t local_tile_id = global_tile_id / count_edge_engines_;
+      const core::TileContainer* container =
+          base_containers_[edge_engine_index];
+      bool is_base_tile = local_tile_id < container->countTiles();
+      if (!is_base_tile) {
+        local_tile_id -= container->countTiles();
+        container = delta_containers[edge_engine_index];
+      }
+
+      readTile(*container, local_tile_id, true, &tile);
+      edges.clear();
+      for (uint32_t i = 0; i < tile.src.size(); ++i) {
+        tile_tombstone_t tombstone = {(uint32_t)local_tile_id, i};
+        if (is_base_tile &&
+            tombstones_[edge_engine_index].count(tombstone) > 0) {
+          continue;
+        }
+        delta_edge_t edge = {tile.tgt_ids[tile.tgt[i]],
+                             tile.src_ids[tile.src[i]],
+                             tile.weights.empty() ? 0.0f : tile.weights[i]};
+        edges.push_back(edge);
+      }
+      return tile.stats.block_id;
+    };
+
+    std::vector<std::vector<uint32_t> > vertex_to_tiles(
+        global_stats_.count_vertices);
+    std::unordered_set<uint64_t> src_set;
+    size_t count_edges = 0;
+    for (int i = 0; i < count_edge_engines_; ++i) {
+      // transposed tile count_forward_tiles + g is the copy of forward tile g
+      std::vector<uint64_t> engine_tiles;
+      for (uint64_t tile_id = count_forward_tiles;
+           tile_id < 2 * count_forward_tiles; ++tile_id) {
+        if (tile_id % count_edge_engines_ == (uint64_t)i) {
+          engine_tiles.push_back(tile_id);
+        }
+      }
+      size_t count_forward_engine_tiles =
+          base_containers_[i]->countTiles() +
+          (delta_containers[i] != NULL ? delta_containers[i]->countTiles()
+                                       : 0);
+
+      // the layout of the container depends on the stats, so the tiles are
+      // built twice, once for their stats and once for writing
+      size_t count_tiles = engine_tiles.size();
+      tile_stats_t* tile_stats = new tile_stats_t[count_tiles];
+      for (size_t j = 0; j < count_tiles; ++j) {
+        uint64_t block_id =
+            collectTransposedEdges(engine_tiles[j] - count_forward_tiles);
+        edge_block_t* edge_block;
+        edge_block_index_t* index;
+        buildTile(edges, block_id, &tile_stats[j], &edge_block, &index);
+        free(edge_block);
+        free(index);
+
+        src_set.clear();
+        for (const auto& edge : edges) {
+          if (src_set.insert(edge.src).second) {
+            vertex_to_tiles[edge.src].push_back(engine_tiles[j]);
+          }
+        }
+        count_edges += edges.size();
+      }
+
+      core::TileContainerWriter writer(
+          core::getTransposedTileContainerFileName(config_, i), tile_stats,
+          count_tiles, global_stats_.is_weighted_graph,
+          global_stats_.is_index_32_bits);
+      for (size_t j = 0; j < count_tiles; ++j) {
+        uint64_t block_id =
+            collectTransposedEdges(engine_tiles[j] - count_forward_tiles);
+        edge_block_t* edge_block;
+        edge_block_index_t* index;
+        tile_stats_t stats;
+        buildTile(edges, block_id, &stats, &edge_block, &index);
+        // the engine-local tile id, following the forward tiles
+        edge_block->block_id = count_forward_engine_tiles + j;
+        writer.writeEdgeBlock(j, edge_block);
+        writer.writeEdgeBlockIndex(j, index);
+        free(edge_block);
+        free(index);
+      }
+      writer.close();
+      delete[] tile_stats;
+    }
+
+    for (auto container : delta_containers) {
+      delete container;
+    }
+
+    // the vertex-to-tile index of the transposed tiles, laid out like the
+    // one of post-grc-indexer
+    std::vector<uint32_t> count_tiles_per_vertex(global_stats_.count_vertices);
+    std::vector<uint32_t> index;
+    for (size_t i = 0; i < global_stats_.count_vertices; ++i) {
+      count_tiles_per_vertex[i] = vertex_to_tiles[i].size();
+      index.insert(index.end(), vertex_to_tiles[i].begin(),
+                   vertex_to_tiles[i].end());
+    }
+    util::writeDataToFile(
+        core::getTransposedVertexToTileCountFileName(config_.path_to_globals),
+        count_tiles_per_vertex.data(),
+        count_tiles_per_vertex.size() * sizeof(uint32_t));
+    util::writeDataToFile(
+        core::getTransposedVertexToTileIndexFileName(config_.path_to_globals),
+        index.data(), index.size() * sizeof(uint32_t));
+
+    sg_log("Wrote %lu transposed tiles with %lu edges\n", count_forward_tiles,
+           count_edges);
+  }
+}
+}
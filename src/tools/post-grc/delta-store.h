@@ -0,0 +1,132 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <core/datatypes.h>
+#include <core/tile-container.h>
+
+namespace scalable_graphs {
+namespace post_grc {
+  struct delta_edge_t {
+    uint64_t src;
+    uint64_t tgt;
+    float weight;
+  };
+
+  // Edge updates on top of a graph packed into tile containers.
+  //
+  // Deleted edges of the base tiles become tombstones, inserted edges are
+  // kept in delta tiles. The delta tiles are appended to the global tile
+  // numbering (global id count_base_tiles + k lives on edge engine
+  // (count_base_tiles + k) % count_edge_engines), so the engines simply see
+  // more tiles. Both are stored next to the tile container of every edge
+  // engine until compact() folds them back into the base tiles.
+  //
+  // Edges are routed to the base tiles through the traversal index of their
+  // partition: The base tiles are sorted by the traversal index of the
+  // partition they start in, a partition always fits into a single tile, so
+  // the edges of partition h are in the last tile starting at or before h or,
+  // if that one starts at h, in its predecessor.
+  class DeltaStore {
+  public:
+    DeltaStore(const config_t& config, const scenario_stats_t& global_stats,
+               grc_tile_traversals_t traversal);
+
+    ~DeltaStore();
+
+    // Opens the base containers, loads the edges of existing delta tiles and
+    // the existing tombstones.
+    void open();
+
+    // Deletes one instance of every edge, from the delta edges if present,
+    // from the base tiles otherwise. Returns the count of edges not found.
+    size_t deleteEdges(std::vector<edge_t>* edges);
+
+    void insertEdges(const std::vector<delta_edge_t>& edges);
+
+    // Rewrites the base containers without the deleted edges and with all
+    // delta edges their base tile has room for, the remaining delta edges
+    // stay in delta tiles.
+    void compact();
+
+    // Writes delta containers and tombstones of all edge engines and the
+    // resulting count of tiles to the global stats. Removes the transposed
+    // tiles, which no longer match.
+    void write();
+
+    // Writes the transposed tiles of the tiles on disk: forward tile g, base
+    // or delta tile, becomes tile count_tiles + g with source and target
+    // swapped and without the deleted edges. They are stored in one more
+    // container per edge engine, together with their vertex-to-tile index in
+    // the global directory.
+    void writeTransposed();
+
+    inline size_t countDeltaEdges() const { return delta_edges_.size(); }
+
+    size_t countTombstones() const;
+
+    inline uint64_t countBaseTiles() const { return count_base_tiles_; }
+
+  private:
+    struct Tile {
+      tile_stats_t stats;
+      std::vector<uint64_t> src_ids;
+      std::vector<uint64_t> tgt_ids;
+      std::unordered_map<uint64_t, local_vertex_id_t> src_local;
+      std::unordered_map<uint64_t, local_vertex_id_t> tgt_local;
+      // edges in tile order, sorted by (tgt, src)
+      std::vector<local_vertex_id_t> src;
+      std::vector<local_vertex_id_t> tgt;
+      std::vector<float> weights;
+    };
+
+    typedef std::multimap<std::pair<uint64_t, uint64_t>, float> edge_map_t;
+
+    const core::TileContainer& getContainer(uint64_t global_tile_id,
+                                            size_t* local_tile_id) const;
+
+    void readTile(const core::TileContainer& container, size_t tile_id,
+                  bool with_edges, Tile* tile) const;
+
+    int64_t getTraversalIndex(uint64_t src, uint64_t tgt) const;
+
+    // Returns the base tiles that may hold edges of the partition.
+    void getCandidateTiles(int64_t traversal_index,
+                           std::vector<uint64_t>* tiles) const;
+
+    // Assigns local ids in order of appearance and encodes the tile like the
+    // tiler does, edge_block and index are malloc'ed.
+    void buildTile(const std::vector<delta_edge_t>& edges, uint64_t block_id,
+                   tile_stats_t* stats, edge_block_t** edge_block,
+                   edge_block_index_t** index) const;
+
+    void compactEdgeEngine(
+        int edge_engine_index,
+        const std::map<uint64_t, std::vector<delta_edge_t> >& merged_edges);
+
+  private:
+    config_t config_;
+    scenario_stats_t global_stats_;
+    grc_tile_traversals_t traversal_;
+    int count_edge_engines_;
+    uint64_t count_partitions_;
+    // RLE and bitmaps are used for new tiles if the base was tiled with them
+    bool use_rle_;
+    bool use_bitmap_;
+
+    std::vector<core::TileContainer*> base_containers_;
+    uint64_t count_base_tiles_;
+    // traversal index of the first partition of every base tile, by global id
+    std::vector<uint64_t> base_block_ids_;
+
+    edge_map_t delta_edges_;
+    // per edge engine
+    std::vector<std::set<tile_tombstone_t> > tombstones_;
+  };
+}
+}
@@ -11,15 +11,25 @@ namespace scalable_graphs {
 namespace post_grc {
   IndexReader::IndexReader(const std::string& path_to_globals,
                            const std::vector<std::string>& paths_to_meta,
+                           const std::vector<std::string>& paths_to_tile,
                            size_t count_vertices, int count_tiles,
                            bool is_index_32_bits,
                            const thread_index_t& thread_index)
       : path_to_globals_(path_to_globals), paths_to_meta_(paths_to_meta),
-        count_vertices_(count_vertices), count_tiles_(count_tiles),
+        paths_to_tile_(paths_to_tile), count_vertices_(count_vertices),
+        count_tiles_(count_tiles), meta_fd_(-1), delta_meta_fd_(-1),
+        count_base_tiles_(SIZE_MAX), tile_container_(NULL),
+        delta_tile_container_(NULL),
         is_index_32_bits_(is_index_32_bits), thread_index_(thread_index),
         count(0) {}
 
   IndexReader::~IndexReader() {
+    if (tile_container_ != NULL) {
+      delete tile_container_;
+      delete delta_tile_container_;
+    } else if (meta_fd_ != -1) {
+      close(meta_fd_);
+    }
     delete tile_stats_;
     delete tile_offsets_;
     for (size_t i = 0; i < count_vertices_; ++i) {
@@ -34,15 +44,34 @@ namespace post_grc {
     config.count_tiles = count_tiles_;
     config.count_edge_processors = thread_index_.count;
 
+    config.paths_to_tile = paths_to_tile_;
+
     count_tiles_for_current_mic_ =
         core::countTilesPerMic(config, thread_index_.id);
 
+    tile_stats_ = new tile_stats_t[count_tiles_for_current_mic_];
+    tile_offsets_ = new size_t[count_tiles_for_current_mic_];
+
+    vertex_to_tiles_index_ = new std::vector<uint32_t>*[count_vertices_];
+    for (size_t i = 0; i < count_vertices_; ++i) {
+      vertex_to_tiles_index_[i] = new std::vector<uint32_t>();
+    }
+    sg_log("Tiles for reader %lu: %lu\n", thread_index_.id,
+           count_tiles_for_current_mic_);
+
+    // with tile containers, the delta tiles written by post-grc-delta are
+    // indexed as well
+    if (!paths_to_tile_.empty() &&
+        core::TileContainer::exists(
+            core::getTileContainerFileName(config, thread_index_.id))) {
+      initFromTileContainer(config);
+      return;
+    }
+
     std::string meta_file_name =
         core::getEdgeTileIndexFileName(config, thread_index_.id);
     meta_fd_ = util::openFileDirectly(meta_file_name);
 
-    tile_stats_ = new tile_stats_t[count_tiles_for_current_mic_];
-
     std::string global_tile_stats_file_name =
         core::getGlobalTileStatsFileName(config, thread_index_.id);
 
@@ -51,7 +80,6 @@ namespace post_grc {
     util::readDataFromFile(global_tile_stats_file_name, size_tile_stats,
                            tile_stats_);
 
-    tile_offsets_ = new size_t[count_tiles_for_current_mic_];
     tile_offsets_[0] = 0;
 
     for (int i = 1; i < count_tiles_for_current_mic_; ++i) {
@@ -76,13 +104,45 @@ namespace post_grc {
       size_t size_rb_block = int_ceil(size_index_block, PAGE_SIZE);
       tile_offsets_[i] = tile_offsets_[i - 1] + size_rb_block;
     }
+  }
 
-    vertex_to_tiles_index_ = new std::vector<uint32_t>*[count_vertices_];
-    for (size_t i = 0; i < count_vertices_; ++i) {
-      vertex_to_tiles_index_[i] = new std::vector<uint32_t>();
+  void IndexReader::initFromTileContainer(const config_t& config) {
+    tile_container_ = new core::TileContainer();
+    tile_container_->open(
+        core::getTileContainerFileName(config, thread_index_.id));
+    meta_fd_ = tile_container_->fd();
+
+    std::string delta_tile_container_file_name =
+        core::getDeltaTileContainerFileName(config, thread_index_.id);
+    if (core::TileContainer::exists(delta_tile_container_file_name)) {
+      delta_tile_container_ = new core::TileContainer();
+      delta_tile_container_->open(delta_tile_container_file_name);
+      delta_meta_fd_ = delta_tile_container_->fd();
+    }
+
+    count_base_tiles_ = tile_container_->countTiles();
+    size_t count_delta_tiles = delta_tile_container_ != NULL
+                                   ? delta_tile_container_->countTiles()
+                                   : 0;
+    if (count_base_tiles_ + count_delta_tiles != count_tiles_for_current_mic_) {
+      sg_err("Tile containers of edge engine %lu hold %lu + %lu tiles, "
+             "expected %lu\n",
+             thread_index_.id, count_base_tiles_, count_delta_tiles,
+             count_tiles_for_current_mic_);
+      util::die(1);
+    }
+
+    tile_container_->copyTileStats(tile_stats_);
+    for (size_t i = 0; i < count_base_tiles_; ++i) {
+      tile_offsets_[i] = tile_container_->entry(i).offset_index;
+    }
+    if (delta_tile_container_ != NULL) {
+      delta_tile_container_->copyTileStats(tile_stats_ + count_base_tiles_);
+      for (size_t i = 0; i < count_delta_tiles; ++i) {
+        tile_offsets_[count_base_tiles_ + i] =
+            delta_tile_container_->entry(i).offset_index;
+      }
     }
-    sg_log("Tiles for reader %lu: %lu\n", thread_index_.id,
-           count_tiles_for_current_mic_);
   }
 
   void IndexReader::run() {
@@ -132,7 +192,8 @@ namespace post_grc {
       size_t size_rb_block = int_ceil(size_index_block, PAGE_SIZE);
 
       // step 4: read indices
-      util::readFileOffset(meta_fd_, index, size_rb_block,
+      int fd = current_tile < count_base_tiles_ ? meta_fd_ : delta_meta_fd_;
+      util::readFileOffset(fd, index, size_rb_block,
                            tile_offsets_[current_tile]);
 
       sg_dbg("Index %lu read (reader_id: %lu)\n", current_tile,
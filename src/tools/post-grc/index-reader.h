@@ -10,6 +10,7 @@
 #include <util/runnable.h>
 #include <core/datatypes.h>
 #include <core/util.h>
+#include <core/tile-container.h>
 
 namespace scalable_graphs {
 namespace post_grc {
@@ -17,6 +18,7 @@ namespace post_grc {
   public:
     IndexReader(const std::string& path_to_globals,
                 const std::vector<std::string>& path_to_meta,
+                const std::vector<std::string>& paths_to_tile,
                 size_t count_vertices, int count_tiles, bool is_index_32_bits,
                 const thread_index_t& thread_index);
 
@@ -31,13 +33,22 @@ namespace post_grc {
   private:
     virtual void run();
 
+    void initFromTileContainer(const config_t& config);
+
   private:
     std::string path_to_globals_;
     std::vector<std::string> paths_to_meta_;
+    std::vector<std::string> paths_to_tile_;
     size_t count_vertices_;
     int count_tiles_;
     size_t count_tiles_for_current_mic_;
     int meta_fd_;
+    // delta tiles, local ids from count_base_tiles_ on
+    int delta_meta_fd_;
+    size_t count_base_tiles_;
+    // set if the tiles are stored in a tile container
+    core::TileContainer* tile_container_;
+    core::TileContainer* delta_tile_container_;
     tile_stats_t* tile_stats_;
     size_t* tile_offsets_;
     bool is_index_32_bits_;
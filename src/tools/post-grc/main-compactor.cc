@@ -0,0 +1,130 @@
+#define __STDC_FORMAT_MACROS
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <getopt.h>
+#include <errno.h>
+
+#include <core/datatypes.h>
+#include <core/util.h>
+#include <util/arch.h>
+#include <util/util.h>
+
+#include "delta-store.h"
+
+namespace util = scalable_graphs::util;
+namespace core = scalable_graphs::core;
+namespace pg = scalable_graphs::post_grc;
+
+// Folds the tombstones and delta tiles written by post-grc-delta back into the
+// base tile containers. Delta edges whose base tile is full stay in delta
+// tiles, the vertex-to-tile index has to be rebuilt by running
+// post-grc-indexer with --paths-tile afterwards.
+struct command_line_args_t {
+  std::vector<std::string> paths_to_meta;
+  std::vector<std::string> paths_to_tile;
+  std::string path_to_global;
+  grc_tile_traversals_t traversal;
+};
+
+static int parseOption(int argc, char* argv[], command_line_args_t& cmd_args) {
+  static struct option options[] = {
+      {"path-globals", required_argument, 0, 'g'},
+      {"paths-meta", required_argument, 0, 'm'},
+      {"paths-tile", required_argument, 0, 't'},
+      {"traversal", required_argument, 0, 'o'},
+      {0, 0, 0, 0},
+  };
+  int arg_cnt;
+
+  for (arg_cnt = 0; 1; ++arg_cnt) {
+    int c, idx = 0;
+    c = getopt_long(argc, argv, "g:m:t:o:", options, &idx);
+    if (c == -1)
+      break;
+
+    switch (c) {
+    case 'g':
+      cmd_args.path_to_global = util::prepareDirPath(std::string(optarg));
+      break;
+    case 'm':
+      cmd_args.paths_to_meta = util::splitDirPaths(std::string(optarg));
+      break;
+    case 't':
+      cmd_args.paths_to_tile = util::splitDirPaths(std::string(optarg));
+      break;
+    case 'o':
+      if (std::string(optarg) == "hilbert") {
+        cmd_args.traversal = grc_tile_traversals_t::Hilbert;
+      } else if (std::string(optarg) == "column_first") {
+        cmd_args.traversal = grc_tile_traversals_t::ColumnFirst;
+      } else if (std::string(optarg) == "row_first") {
+        cmd_args.traversal = grc_tile_traversals_t::RowFirst;
+      } else {
+        sg_log("Wrong traversal supplied: %s", optarg);
+        util::die(1);
+      }
+      break;
+    default:
+      return -EINVAL;
+    }
+  }
+  return arg_cnt;
+}
+
+static void usage(FILE* out) {
+  extern const char* __progname;
+
+  fprintf(out, "Usage: %s\n", __progname);
+  fprintf(out, "  --path-globals            = path to global data\n");
+  fprintf(out, "  --paths-meta              = paths to metadata, one per "
+               "edge engine\n");
+  fprintf(out, "  --paths-tile              = paths to tiledata, one per "
+               "edge engine\n");
+  fprintf(out, "  --traversal               = traversal the graph was tiled "
+               "with, hilbert, column_first or row_first\n");
+}
+
+int main(int argc, char** argv) {
+  command_line_args_t cmd_args;
+
+  // parse command line options
+  if (parseOption(argc, argv, cmd_args) != 4 || cmd_args.paths_to_tile.empty() ||
+      cmd_args.paths_to_meta.size() != cmd_args.paths_to_tile.size()) {
+    usage(stderr);
+    return 1;
+  }
+
+  // load graph info
+  scenario_stats_t global_stats;
+  util::readDataFromFile(core::getGlobalStatFileName(cmd_args.path_to_global),
+                         sizeof(scenario_stats_t), &global_stats);
+
+  config_t config;
+  config.path_to_globals = cmd_args.path_to_global;
+  config.paths_to_meta = cmd_args.paths_to_meta;
+  config.paths_to_tile = cmd_args.paths_to_tile;
+  config.count_tiles = global_stats.count_tiles;
+  config.count_edge_processors = cmd_args.paths_to_tile.size();
+
+  pg::DeltaStore store(config, global_stats, cmd_args.traversal);
+  store.open();
+
+  uint64_t start_time = util::get_time_nsec();
+  store.compact();
+  store.write();
+  double diff = (double)(util::get_time_nsec() - start_time) / 1000000000L;
+  sg_log("Compaction time: %f\n", diff);
+
+  sg_log("Graph holds %lu base tiles, %lu delta edges and %lu tombstones, "
+         "rerun post-grc-indexer with --paths-tile\n",
+         store.countBaseTiles(), store.countDeltaEdges(),
+         store.countTombstones());
+
+  return 0;
+}
@@ -0,0 +1,187 @@
+#define __STDC_FORMAT_MACROS
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <getopt.h>
+#include <errno.h>
+
+#include <core/datatypes.h>
+#include <core/util.h>
+#include <util/arch.h>
+
+#include "delta-store.h"
+
+namespace util = scalable_graphs::util;
+namespace core = scalable_graphs::core;
+namespace pg = scalable_graphs::post_grc;
+
+// Applies edge insertions and deletions to a graph packed by post-grc-packer
+// without retiling it: Deleted base edges become tombstones, inserted edges
+// are collected in delta tiles. Both files contain raw edge_t records with
+// global vertex ids. Vertex degrees and the count of tiles are updated in
+// place, the vertex-to-tile index has to be rebuilt by running
+// post-grc-indexer with --paths-tile afterwards.
+struct command_line_args_t {
+  std::vector<std::string> paths_to_meta;
+  std::vector<std::string> paths_to_tile;
+  std::string path_to_global;
+  std::string insertions;
+  std::string deletions;
+  grc_tile_traversals_t traversal;
+};
+
+static int parseOption(int argc, char* argv[], command_line_args_t& cmd_args) {
+  static struct option options[] = {
+      {"path-globals", required_argument, 0, 'g'},
+      {"paths-meta", required_argument, 0, 'm'},
+      {"paths-tile", required_argument, 0, 't'},
+      {"traversal", required_argument, 0, 'o'},
+      {"insertions", required_argument, 0, 'i'},
+      {"deletions", required_argument, 0, 'd'},
+      {0, 0, 0, 0},
+  };
+  int arg_cnt;
+
+  for (arg_cnt = 0; 1; ++arg_cnt) {
+    int c, idx = 0;
+    c = getopt_long(argc, argv, "g:m:t:o:i:d:", options, &idx);
+    if (c == -1)
+      break;
+
+    switch (c) {
+    case 'g':
+      cmd_args.path_to_global = util::prepareDirPath(std::string(optarg));
+      break;
+    case 'm':
+      cmd_args.paths_to_meta = util::splitDirPaths(std::string(optarg));
+      break;
+    case 't':
+      cmd_args.paths_to_tile = util::splitDirPaths(std::string(optarg));
+      break;
+    case 'o':
+      if (std::string(optarg) == "hilbert") {
+        cmd_args.traversal = grc_tile_traversals_t::Hilbert;
+      } else if (std::string(optarg) == "column_first") {
+        cmd_args.traversal = grc_tile_traversals_t::ColumnFirst;
+      } else if (std::string(optarg) == "row_first") {
+        cmd_args.traversal = grc_tile_traversals_t::RowFirst;
+      } else {
+        sg_log("Wrong traversal supplied: %s", optarg);
+        util::die(1);
+      }
+      break;
+    case 'i':
+      cmd_args.insertions = std::string(optarg);
+      break;
+    case 'd':
+      cmd_args.deletions = std::string(optarg);
+      break;
+    default:
+      return -EINVAL;
+    }
+  }
+  return arg_cnt;
+}
+
+static void usage(FILE* out) {
+  extern const char* __progname;
+
+  fprintf(out, "Usage: %s\n", __progname);
+  fprintf(out, "  --path-globals            = path to global data\n");
+  fprintf(out, "  --paths-meta              = paths to metadata, one per "
+               "edge engine\n");
+  fprintf(out, "  --paths-tile              = paths to tiledata, one per "
+               "edge engine\n");
+  fprintf(out, "  --traversal               = traversal the graph was tiled "
+               "with, hilbert, column_first or row_first\n");
+  fprintf(out, "  --insertions              = (optional) file of edges to "
+               "insert\n");
+  fprintf(out, "  --deletions               = (optional) file of edges to "
+               "delete\n");
+}
+
+int main(int argc, char** argv) {
+  command_line_args_t cmd_args;
+
+  // parse command line options
+  int arg_cnt = parseOption(argc, argv, cmd_args);
+  if (arg_cnt < 4 || arg_cnt > 6 || cmd_args.paths_to_tile.empty() ||
+      cmd_args.paths_to_meta.size() != cmd_args.paths_to_tile.size()) {
+    usage(stderr);
+    return 1;
+  }
+
+  // load graph info
+  scenario_stats_t global_stats;
+  util::readDataFromFile(core::getGlobalStatFileName(cmd_args.path_to_global),
+                         sizeof(scenario_stats_t), &global_stats);
+
+  config_t config;
+  config.path_to_globals = cmd_args.path_to_global;
+  config.paths_to_meta = cmd_args.paths_to_meta;
+  config.paths_to_tile = cmd_args.paths_to_tile;
+  config.count_tiles = global_stats.count_tiles;
+  config.count_edge_processors = cmd_args.paths_to_tile.size();
+
+  pg::DeltaStore store(config, global_stats, cmd_args.traversal);
+  store.open();
+
+  vertex_degree_t* vertex_degrees = (vertex_degree_t*)malloc(
+      sizeof(vertex_degree_t) * global_stats.count_vertices);
+  util::readDataFromFile(core::getVertexDegreeFileName(config),
+                         sizeof(vertex_degree_t) * global_stats.count_vertices,
+                         vertex_degrees);
+
+  if (!cmd_args.deletions.empty()) {
+    std::vector<edge_t> edges;
+    core::readEdgeListFile(cmd_args.deletions, &edges);
+    size_t count_requested = edges.size();
+    size_t count_missing = store.deleteEdges(&edges);
+    for (const auto& edge : edges) {
+      --vertex_degrees[edge.src].out_degree;
+      --vertex_degrees[edge.tgt].in_degree;
+    }
+    sg_log("Deleted %lu of %lu edges, %lu not found\n", edges.size(),
+           count_requested, count_missing);
+  }
+
+  if (!cmd_args.insertions.empty()) {
+    std::vector<edge_t> edges;
+    core::readEdgeListFile(cmd_args.insertions, &edges);
+
+    // weights like the tiler
+    unsigned int seed = rand32_seedless();
+    std::vector<pg::delta_edge_t> delta_edges(edges.size());
+    for (size_t i = 0; i < edges.size(); ++i) {
+      delta_edges[i].src = edges[i].src;
+      delta_edges[i].tgt = edges[i].tgt;
+      delta_edges[i].weight = global_stats.is_weighted_graph
+                                  ? rand32(&seed) / (float)UINT32_MAX
+                                  : 0.0f;
+    }
+    store.insertEdges(delta_edges);
+    for (const auto& edge : edges) {
+      ++vertex_degrees[edge.src].out_degree;
+      ++vertex_degrees[edge.tgt].in_degree;
+    }
+    sg_log("Inserted %lu edges\n", edges.size());
+  }
+
+  store.write();
+
+  util::writeDataToFile(core::getVertexDegreeFileName(config), vertex_degrees,
+                        sizeof(vertex_degree_t) * global_stats.count_vertices);
+  free(vertex_degrees);
+
+  sg_log("Graph holds %lu base tiles, %lu delta edges and %lu tombstones, "
+         "rerun post-grc-indexer with --paths-tile\n",
+         store.countBaseTiles(), store.countDeltaEdges(),
+         store.countTombstones());
+
+  return 0;
+}
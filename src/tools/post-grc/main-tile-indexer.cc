@@ -21,6 +21,7 @@ namespace core = scalable_graphs::core;
 
 struct command_line_args_t {
   std::vector<std::string> paths_to_meta;
+  std::vector<std::string> paths_to_tile;
   std::string path_to_global;
   int nthreads;
 };
@@ -30,13 +31,14 @@ static int parseOption(int argc, char* argv[], command_line_args_t& cmd_args) {
       {"path-globals", required_argument, 0, 'g'},
       {"paths-meta", required_argument, 0, 'm'},
       {"nthreads", required_argument, 0, 'n'},
+      {"paths-tile", required_argument, 0, 't'},
       {0, 0, 0, 0},
   };
   int arg_cnt;
 
   for (arg_cnt = 0; 1; ++arg_cnt) {
     int c, idx = 0;
-    c = getopt_long(argc, argv, "g:m:n:", options, &idx);
+    c = getopt_long(argc, argv, "g:m:n:t:", options, &idx);
     if (c == -1)
       break;
 
@@ -50,6 +52,9 @@ static int parseOption(int argc, char* argv[], command_line_args_t& cmd_args) {
     case 'n':
       cmd_args.nthreads = std::stoi(std::string(optarg));
       break;
+    case 't':
+      cmd_args.paths_to_tile = util::splitDirPaths(std::string(optarg));
+      break;
     default:
       return -EINVAL;
     }
@@ -64,13 +69,16 @@ static void usage(FILE* out) {
   fprintf(out, "  --path-global             = path to global data\n");
   fprintf(out, "  --paths-meta              = output paths to metadata\n");
   fprintf(out, "  --nthreads                = number of concurrent threads\n");
+  fprintf(out, "  --paths-tile              = (optional) paths to tiledata, "
+               "indexes tile containers including delta tiles\n");
 }
 
 int main(int argc, char** argv) {
   command_line_args_t cmd_args;
 
   // parse command line options
-  if (parseOption(argc, argv, cmd_args) != 3) {
+  int count_args = parseOption(argc, argv, cmd_args);
+  if (count_args != 3 && count_args != 4) {
     usage(stderr);
     return 1;
   }
@@ -108,8 +116,8 @@ int main(int argc, char** argv) {
     ti.id = i;
     post_grc::IndexReader* ir = new post_grc::IndexReader(
         cmd_args.path_to_global, cmd_args.paths_to_meta,
-        global_stats.count_vertices, global_stats.count_tiles,
-        global_stats.is_index_32_bits, ti);
+        cmd_args.paths_to_tile, global_stats.count_vertices,
+        global_stats.count_tiles, global_stats.is_index_32_bits, ti);
 
     index_readers.push_back(ir);
     ir->start();
@@ -136,8 +144,8 @@ int main(int argc, char** argv) {
     ti.id = i;
     post_grc::IndexReader* ir = new post_grc::IndexReader(
         cmd_args.path_to_global, cmd_args.paths_to_meta,
-        global_stats.count_vertices, global_stats.count_tiles,
-        global_stats.is_index_32_bits, ti);
+        cmd_args.paths_to_tile, global_stats.count_vertices,
+        global_stats.count_tiles, global_stats.is_index_32_bits, ti);
 
     ir->start();
     index_readers.push_back(ir);
@@ -171,7 +179,7 @@ int main(int argc, char** argv) {
 
   for (size_t i = 1; i < global_stats.count_vertices; ++i) {
     tiles_per_vertex_offset[i] =
-        tiles_per_vertex_offset[i - 1] + count_tiles_per_vertex[i];
+        tiles_per_vertex_offset[i - 1] + count_tiles_per_vertex[i - 1];
   }
 
   uint32_t* vertex_to_tiles_index =
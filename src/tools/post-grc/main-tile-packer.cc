@@ -0,0 +1,171 @@
+#define __STDC_FORMAT_MACROS
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <getopt.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <core/datatypes.h>
+#include <core/util.h>
+#include <core/tile-container.h>
+#include <util/arch.h>
+
+namespace util = scalable_graphs::util;
+namespace core = scalable_graphs::core;
+
+// Packs the per-edge-engine tiles.dat, meta.dat and tile_stats.dat generated
+// by the post-grc scripts into a single tile container (tiles.mtc) placed next
+// to tiles.dat. The engines pick up the container automatically.
+struct command_line_args_t {
+  std::vector<std::string> paths_to_meta;
+  std::vector<std::string> paths_to_tile;
+  std::string path_to_global;
+};
+
+static int parseOption(int argc, char* argv[], command_line_args_t& cmd_args) {
+  static struct option options[] = {
+      {"path-globals", required_argument, 0, 'g'},
+      {"paths-meta", required_argument, 0, 'm'},
+      {"paths-tile", required_argument, 0, 't'},
+      {0, 0, 0, 0},
+  };
+  int arg_cnt;
+
+  for (arg_cnt = 0; 1; ++arg_cnt) {
+    int c, idx = 0;
+    c = getopt_long(argc, argv, "g:m:t:", options, &idx);
+    if (c == -1)
+      break;
+
+    switch (c) {
+    case 'g':
+      cmd_args.path_to_global = util::prepareDirPath(std::string(optarg));
+      break;
+    case 'm':
+      cmd_args.paths_to_meta = util::splitDirPaths(std::string(optarg));
+      break;
+    case 't':
+      cmd_args.paths_to_tile = util::splitDirPaths(std::string(optarg));
+      break;
+    default:
+      return -EINVAL;
+    }
+  }
+  return arg_cnt;
+}
+
+static void usage(FILE* out) {
+  extern const char* __progname;
+
+  fprintf(out, "Usage: %s\n", __progname);
+  fprintf(out, "  --path-globals            = path to global data\n");
+  fprintf(out, "  --paths-meta              = paths to metadata, one per "
+               "edge engine\n");
+  fprintf(out, "  --paths-tile              = paths to tiledata, one per "
+               "edge engine\n");
+}
+
+static int openFile(const std::string& file_name) {
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd == -1) {
+    sg_err("Unable to open file %s: %s\n", file_name.c_str(), strerror(errno));
+    util::die(1);
+  }
+  return fd;
+}
+
+static void packEdgeEngine(const config_t& config,
+                           const scenario_stats_t& global_stats,
+                           int edge_engine_index) {
+  size_t count_tiles = core::countTilesPerMic(config, edge_engine_index);
+
+  tile_stats_t* tile_stats = new tile_stats_t[count_tiles];
+  util::readDataFromFile(
+      core::getGlobalTileStatsFileName(config, edge_engine_index),
+      sizeof(tile_stats_t) * count_tiles, tile_stats);
+
+  int tiles_fd = openFile(core::getEdgeTileFileName(config, edge_engine_index));
+  int meta_fd =
+      openFile(core::getEdgeTileIndexFileName(config, edge_engine_index));
+
+  std::string container_file_name =
+      core::getTileContainerFileName(config, edge_engine_index);
+  core::TileContainerWriter writer(
+      container_file_name, tile_stats, count_tiles,
+      global_stats.is_weighted_graph, global_stats.is_index_32_bits);
+
+  // one buffer large enough for the biggest block of both kinds
+  size_t max_size_block = 0;
+  for (size_t i = 0; i < count_tiles; ++i) {
+    max_size_block = std::max(
+        max_size_block,
+        core::getSizeEdgeBlock(tile_stats[i], global_stats.is_weighted_graph));
+    max_size_block = std::max(
+        max_size_block, core::getSizeEdgeBlockIndex(
+                            tile_stats[i], global_stats.is_index_32_bits));
+  }
+  uint8_t* block = (uint8_t*)malloc(max_size_block);
+
+  size_t tile_offset = 0;
+  size_t meta_offset = 0;
+  for (size_t i = 0; i < count_tiles; ++i) {
+    size_t size_edge_block =
+        core::getSizeEdgeBlock(tile_stats[i], global_stats.is_weighted_graph);
+    util::readFileOffset(tiles_fd, block, size_edge_block, tile_offset);
+    // store the local tile id, saves the tile readers from patching it
+    ((edge_block_t*)block)->block_id = i;
+    writer.writeEdgeBlock(i, (edge_block_t*)block);
+    tile_offset += int_ceil(size_edge_block, PAGE_SIZE);
+
+    size_t size_index = core::getSizeEdgeBlockIndex(
+        tile_stats[i], global_stats.is_index_32_bits);
+    util::readFileOffset(meta_fd, block, size_index, meta_offset);
+    writer.writeEdgeBlockIndex(i, (edge_block_index_t*)block);
+    meta_offset += int_ceil(size_index, PAGE_SIZE);
+  }
+  writer.close();
+
+  sg_log("Packed %lu tiles into %s\n", count_tiles,
+         container_file_name.c_str());
+
+  free(block);
+  close(tiles_fd);
+  close(meta_fd);
+  delete[] tile_stats;
+}
+
+int main(int argc, char** argv) {
+  command_line_args_t cmd_args;
+
+  // parse command line options
+  if (parseOption(argc, argv, cmd_args) != 3 ||
+      cmd_args.paths_to_meta.size() != cmd_args.paths_to_tile.size()) {
+    usage(stderr);
+    return 1;
+  }
+
+  // load graph info
+  scenario_stats_t global_stats;
+  util::readDataFromFile(core::getGlobalStatFileName(cmd_args.path_to_global),
+                         sizeof(scenario_stats_t), &global_stats);
+
+  config_t config;
+  config.paths_to_meta = cmd_args.paths_to_meta;
+  config.paths_to_tile = cmd_args.paths_to_tile;
+  config.count_tiles = global_stats.count_tiles;
+  config.count_edge_processors = cmd_args.paths_to_meta.size();
+
+  for (int i = 0; i < config.count_edge_processors; ++i) {
+    packEdgeEngine(config, global_stats, i);
+  }
+
+  return 0;
+}
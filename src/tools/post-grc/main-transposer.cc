@@ -0,0 +1,102 @@
+#define __STDC_FORMAT_MACROS
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <getopt.h>
+#include <errno.h>
+
+#include <core/datatypes.h>
+#include <core/util.h>
+#include <util/arch.h>
+#include <util/util.h>
+
+#include "delta-store.h"
+
+namespace util = scalable_graphs::util;
+namespace core = scalable_graphs::core;
+namespace pg = scalable_graphs::post_grc;
+
+// Writes the transposed copy of a graph packed by post-grc-packer, including
+// the delta tiles and without the edges deleted by post-grc-delta. Algorithms
+// gathering along in-edges (need_transposed_tiles) read both tile sets in one
+// run, the transposed tiles follow the forward ones in the global tile
+// numbering. Updating the graph afterwards removes the transposed tiles again.
+struct command_line_args_t {
+  std::vector<std::string> paths_to_tile;
+  std::string path_to_global;
+};
+
+static int parseOption(int argc, char* argv[], command_line_args_t& cmd_args) {
+  static struct option options[] = {
+      {"path-globals", required_argument, 0, 'g'},
+      {"paths-tile", required_argument, 0, 't'},
+      {0, 0, 0, 0},
+  };
+  int arg_cnt;
+
+  for (arg_cnt = 0; 1; ++arg_cnt) {
+    int c, idx = 0;
+    c = getopt_long(argc, argv, "g:t:", options, &idx);
+    if (c == -1)
+      break;
+
+    switch (c) {
+    case 'g':
+      cmd_args.path_to_global = util::prepareDirPath(std::string(optarg));
+      break;
+    case 't':
+      cmd_args.paths_to_tile = util::splitDirPaths(std::string(optarg));
+      break;
+    default:
+      return -EINVAL;
+    }
+  }
+  return arg_cnt;
+}
+
+static void usage(FILE* out) {
+  extern const char* __progname;
+
+  fprintf(out, "Usage: %s\n", __progname);
+  fprintf(out, "  --path-globals            = path to global data\n");
+  fprintf(out, "  --paths-tile              = paths to tiledata, one per "
+               "edge engine\n");
+}
+
+int main(int argc, char** argv) {
+  command_line_args_t cmd_args;
+
+  // parse command line options
+  if (parseOption(argc, argv, cmd_args) != 2 ||
+      cmd_args.paths_to_tile.empty()) {
+    usage(stderr);
+    return 1;
+  }
+
+  // load graph info
+  scenario_stats_t global_stats;
+  util::readDataFromFile(core::getGlobalStatFileName(cmd_args.path_to_global),
+                         sizeof(scenario_stats_t), &global_stats);
+
+  config_t config;
+  config.path_to_globals = cmd_args.path_to_global;
+  config.paths_to_tile = cmd_args.paths_to_tile;
+  config.count_tiles = global_stats.count_tiles;
+  config.count_edge_processors = cmd_args.paths_to_tile.size();
+
+  // the traversal only routes updated edges, none are routed here
+  pg::DeltaStore store(config, global_stats, grc_tile_traversals_t::Hilbert);
+  store.open();
+
+  uint64_t start_time = util::get_time_nsec();
+  store.writeTransposed();
+  double diff = (double)(util::get_time_nsec() - start_time) / 1000000000L;
+  sg_log("Transposition time: %f\n", diff);
+
+  return 0;
+}
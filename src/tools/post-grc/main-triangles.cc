@@ -0,0 +1,145 @@
+#define __STDC_FORMAT_MACROS
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <getopt.h>
+#include <errno.h>
+
+#include <core/datatypes.h>
+#include <core/util.h>
+#include <core/triangle-counter.h>
+#include <util/arch.h>
+#include <util/util.h>
+
+namespace util = scalable_graphs::util;
+namespace core = scalable_graphs::core;
+
+// Counts the triangles of a graph packed into tile containers exactly, see
+// core::TriangleCounter. Delta tiles and tombstones written by post-grc-delta
+// are taken into account.
+struct command_line_args_t {
+  std::vector<std::string> paths_to_tile;
+  std::string path_to_global;
+  std::string path_to_spill;
+  size_t size_resident_mb;
+  uint64_t vertices_per_block;
+  int count_threads;
+};
+
+static int parseOption(int argc, char* argv[], command_line_args_t& cmd_args) {
+  static struct option options[] = {
+      {"path-globals", required_argument, 0, 'g'},
+      {"paths-tile", required_argument, 0, 't'},
+      {"path-spill", required_argument, 0, 's'},
+      {"resident-mb", required_argument, 0, 'r'},
+      {"block-vertices", required_argument, 0, 'b'},
+      {"threads", required_argument, 0, 'n'},
+      {0, 0, 0, 0},
+  };
+  int arg_cnt;
+
+  for (arg_cnt = 0; 1; ++arg_cnt) {
+    int c, idx = 0;
+    c = getopt_long(argc, argv, "g:t:s:r:b:n:", options, &idx);
+    if (c == -1)
+      break;
+
+    switch (c) {
+    case 'g':
+      cmd_args.path_to_global = util::prepareDirPath(std::string(optarg));
+      break;
+    case 't':
+      cmd_args.paths_to_tile = util::splitDirPaths(std::string(optarg));
+      break;
+    case 's':
+      cmd_args.path_to_spill = util::prepareDirPath(std::string(optarg));
+      --arg_cnt;
+      break;
+    case 'r':
+      cmd_args.size_resident_mb = std::stoul(std::string(optarg));
+      --arg_cnt;
+      break;
+    case 'b':
+      cmd_args.vertices_per_block = std::stoul(std::string(optarg));
+      --arg_cnt;
+      break;
+    case 'n':
+      cmd_args.count_threads = std::stoi(std::string(optarg));
+      --arg_cnt;
+      break;
+    default:
+      return -EINVAL;
+    }
+  }
+  return arg_cnt;
+}
+
+static void usage(FILE* out) {
+  extern const char* __progname;
+
+  fprintf(out, "Usage: %s\n", __progname);
+  fprintf(out, "  --path-globals            = path to global data\n");
+  fprintf(out, "  --paths-tile              = paths to tiledata, one per "
+               "edge engine\n");
+  fprintf(out, "  --path-spill              = directory for the row spill "
+               "files, optional, defaults to the global data\n");
+  fprintf(out, "  --resident-mb             = memory for resident rows and "
+               "buffered edges, optional, defaults to 1024\n");
+  fprintf(out, "  --block-vertices          = vertices per row block, "
+               "optional, defaults to %d\n",
+          MAX_VERTICES_PER_TILE);
+  fprintf(out, "  --threads                 = threads intersecting, "
+               "optional, defaults to 1\n");
+}
+
+int main(int argc, char** argv) {
+  command_line_args_t cmd_args;
+  cmd_args.size_resident_mb = 1024;
+  cmd_args.vertices_per_block = MAX_VERTICES_PER_TILE;
+  cmd_args.count_threads = 1;
+
+  // parse command line options
+  if (parseOption(argc, argv, cmd_args) != 2 ||
+      cmd_args.paths_to_tile.empty() || cmd_args.vertices_per_block == 0) {
+    usage(stderr);
+    return 1;
+  }
+  if (cmd_args.path_to_spill.empty()) {
+    cmd_args.path_to_spill = cmd_args.path_to_global;
+  }
+
+  // load graph info
+  scenario_stats_t global_stats;
+  util::readDataFromFile(core::getGlobalStatFileName(cmd_args.path_to_global),
+                         sizeof(scenario_stats_t), &global_stats);
+
+  config_t config;
+  config.path_to_globals = cmd_args.path_to_global;
+  config.paths_to_tile = cmd_args.paths_to_tile;
+  config.count_tiles = global_stats.count_tiles;
+  config.count_edge_processors = cmd_args.paths_to_tile.size();
+
+  core::TriangleCounter counter(
+      global_stats.count_vertices, cmd_args.vertices_per_block,
+      cmd_args.size_resident_mb * 1024 * 1024, cmd_args.path_to_spill,
+      cmd_args.count_threads);
+
+  uint64_t start_time = util::get_time_nsec();
+  counter.addTiles(config, global_stats);
+  double diff = (double)(util::get_time_nsec() - start_time) / 1000000000L;
+  sg_log("Loading time: %f\n", diff);
+
+  start_time = util::get_time_nsec();
+  uint64_t count_triangles = counter.count();
+  diff = (double)(util::get_time_nsec() - start_time) / 1000000000L;
+  sg_log("Counting time: %f, %lu rows loaded\n", diff,
+         counter.countRowLoads());
+
+  printf("%" PRIu64 "\n", count_triangles);
+  return 0;
+}
@@ -149,6 +149,61 @@ def generate_graph(opts):
 
     utils.run(opts.print_only, "time", "sudo", *args_rmat_tiler);
     
+def generate_graph_stream(opts):
+    # host-only, generates degrees and tiles in one go without partitions
+    if opts.debug:
+        grc_tiler = conf.DBIN_RMAT_STREAM_TILER
+    else:
+        grc_tiler = conf.RBIN_RMAT_STREAM_TILER
+
+    num_dir = conf.SG_NUM_HASH_DIRS
+
+    meta_dirs = []
+    tile_dirs = []
+    global_dir = conf.getGlobalsDir(opts.dataset, False)
+
+    shutil.rmtree(global_dir, True)
+    utils.mkdirp(global_dir, conf.FILE_GROUP)
+
+    for i in range(0, len(conf.SG_GRC_PARTITION_DIRS)):
+        meta_dir = conf.getGrcMetaDir(opts.dataset, i, False)
+        tile_dir = conf.getGrcTileDir(opts.dataset, i, False)
+
+        shutil.rmtree(meta_dir, True)
+        shutil.rmtree(tile_dir, True)
+
+        utils.mkdirp(meta_dir, conf.FILE_GROUP)
+        utils.mkdirp(tile_dir, conf.FILE_GROUP)
+
+        utils.populate_hash_dirs(num_dir, meta_dir)
+        utils.populate_hash_dirs(num_dir, tile_dir)
+
+        meta_dirs.append(meta_dir)
+        tile_dirs.append(tile_dir)
+
+    use_rle_int = 0
+    if opts.use_rle:
+        use_rle_int = 1
+
+    args_rmat_tiler = [
+            grc_tiler,
+            "--graphname", opts.dataset,
+            "--count-vertices", conf.SG_GRAPH_SETTINGS_RMAT[opts.dataset]["count_vertices"],
+            "--count-edges", conf.SG_GRAPH_SETTINGS_RMAT[opts.dataset]["count_edges"],
+            "--nthreads", opts.count_threads,
+            "--max-edges-per-round", opts.max_edges_per_round,
+            "--path-globals", global_dir,
+            "--paths-meta", ":".join(meta_dirs),
+            "--paths-tile", ":".join(tile_dirs),
+            "--output-weighted", 0,
+            "--use-run-length-encoding", use_rle_int,
+            "--traversal", "hilbert"
+        ]
+    if opts.gdb_tiler:
+        args_rmat_tiler = ["gdb", "--args"] + args_rmat_tiler
+
+    utils.run(opts.print_only, "time", *args_rmat_tiler);
+
 
 if __name__ == "__main__":
     # parse options
@@ -170,8 +225,18 @@ if __name__ == "__main__":
     parser.add_option("--base-port", default=conf.SG_GRC_RMAT_PORT)
     parser.add_option("--count-generator-threads", default=conf.SG_GRC_RMAT_GEN_THREADS)
     parser.add_option("--phase")
+    parser.add_option("--stream", dest="stream",
+                      action="store_true", default=conf.SG_GRC_RMAT_STREAM)
+    parser.add_option("--max-edges-per-round",
+                      default=conf.SG_GRC_RMAT_STREAM_MAX_EDGES_PER_ROUND)
     (opts, args) = parser.parse_args()
 
+    if opts.stream:
+        print("# Generating graph (streaming)")
+        build.build(False, False)
+        generate_graph_stream(opts)
+        exit(0)
+
     if not (opts.phase == "generate_vertex_degrees" or opts.phase == "generate_tiles" or opts.phase == "all"):
         print("Wrong phase passed %s!" % (opts.phase))
         parser.print_help()
@@ -0,0 +1,561 @@
+#!/usr/bin/env python3
+#
+# End-to-end performance regression harness.
+#
+# Generates RMAT graphs at several scales into a scratch directory, tiles and
+# indexes them, then runs every algorithm with mosaic in the in-memory and in
+# the out-of-core mode. Records the edges per second, the time of every round
+# and the peak RSS of each run and compares them against a stored baseline.
+#
+# The csr mode runs the same algorithms on csr-baseline, the tiles loaded into
+# an in-memory CSR graph. Next to the in-memory mode, it tells how much of a
+# round goes into the pipeline of mosaic rather than into the algorithm.
+#
+# Needs nothing but the Release build, no host config and no datasets:
+#
+#   $ ./perf_regression.py --baseline perf-baseline.json --update-baseline
+#   ... change the engine, rebuild ...
+#   $ ./perf_regression.py --baseline perf-baseline.json
+#
+# Exits with 1 if a run failed or regressed beyond the tolerances.
+
+import os
+import sys
+import glob
+import json
+import math
+import optparse
+import resource
+import shutil
+import signal
+import subprocess
+import tempfile
+import time
+
+ROOT = os.path.abspath(os.path.dirname(__file__))
+DEFAULT_BUILD_DIR = os.path.join(ROOT, "../../../build/Release-x86_64")
+
+# the grc spreads the meta and tile files over this many hash dirs, see
+# num_dir in lib/core/util.cc
+COUNT_HASH_DIRS = 512
+
+# reads of tiles and indices are aligned to TILE_READ_ALIGN, the files are
+# padded to it so that the reads of the last tiles do not hit EOF
+TILE_READ_ALIGN = 128 * 1024
+PAGE_SIZE = 4096
+
+# sizeof(tile_stats_t)
+SIZE_TILE_STATS = 24
+
+ALGORITHMS_WEIGHTED = {"sssp", "bp"}
+ALGORITHMS_SELECTIVE_SCHEDULING = {"bfs", "cc", "sssp"}
+
+MODES = {"in-memory": 1, "out-of-core": 0}
+# runs csr-baseline instead of mosaic
+MODE_CSR = "csr"
+
+MB = 1024 * 1024
+
+# engine threads, small enough for any box
+COUNT_APPLIERS = 2
+COUNT_GLOBAL_REDUCERS = 2
+COUNT_GLOBAL_FETCHERS = 2
+COUNT_INDEX_READERS = 1
+COUNT_VERTEX_REDUCERS = 2
+COUNT_VERTEX_FETCHERS = 2
+COUNT_TILE_READERS = 1
+COUNT_TILE_PROCESSORS = 2
+
+
+def run(args, log_file):
+    with open(log_file, "w") as log:
+        rc = subprocess.call([str(a) for a in args], stdout=log,
+                             stderr=subprocess.STDOUT)
+    if rc != 0:
+        print("Failed (%d): %s, see %s" % (rc, " ".join(map(str, args)),
+                                           log_file))
+        sys.exit(1)
+
+
+def align(size, alignment):
+    return ((size + alignment - 1) // alignment) * alignment
+
+
+def concat_files(files, output_file, alignment):
+    with open(output_file, "wb") as out:
+        for single_file in files:
+            with open(single_file, "rb") as f:
+                shutil.copyfileobj(f, out)
+            if alignment:
+                out.truncate(align(out.tell(), alignment))
+                out.seek(0, os.SEEK_END)
+        if alignment:
+            out.truncate(align(out.tell(), TILE_READ_ALIGN))
+
+
+def reshuffle_files(original_dir, prefix, output_file, alignment):
+    # same layout as post_grc.py for a single edge engine
+    files = glob.glob(os.path.join(original_dir, "*", prefix + "*"))
+    files.sort(key=os.path.basename)
+    concat_files(files, output_file, alignment)
+
+
+class Graph(object):
+    def __init__(self, work_dir, scale, edge_factor, weighted):
+        self.name = "rmat-%d%s" % (scale, "-weighted" if weighted else "")
+        self.count_vertices = 2 ** scale
+        self.count_edges = edge_factor * self.count_vertices
+        self.weighted = weighted
+        self.dir = os.path.join(work_dir, self.name)
+        self.globals_dir = os.path.join(self.dir, "globals")
+        self.meta_dir = os.path.join(self.dir, "meta")
+        self.tile_dir = os.path.join(self.dir, "tile")
+
+    def countTiles(self):
+        size = os.path.getsize(os.path.join(self.meta_dir, "tile_stats.dat"))
+        return size // SIZE_TILE_STATS
+
+    def sizeTiles(self):
+        return os.path.getsize(os.path.join(self.tile_dir, "tiles.dat"))
+
+    def generate(self, build_dir, nthreads):
+        grc_meta_dir = os.path.join(self.dir, "grc", "meta")
+        grc_tile_dir = os.path.join(self.dir, "grc", "tile")
+        for d in [grc_meta_dir, grc_tile_dir]:
+            for i in range(COUNT_HASH_DIRS):
+                os.makedirs(os.path.join(d, "%03x" % i))
+        for d in [self.globals_dir, self.meta_dir, self.tile_dir]:
+            os.makedirs(d)
+
+        # the RMAT generator is seeded with a constant, the graph of a scale
+        # is the same for every run
+        print("# Generating %s (%d vertices, %d edges)" %
+              (self.name, self.count_vertices, self.count_edges))
+        run([os.path.join(build_dir, "tools/grc/grc-rmat-stream-tiler"),
+             "--graphname", self.name,
+             "--count-vertices", self.count_vertices,
+             "--count-edges", self.count_edges,
+             "--path-globals", self.globals_dir,
+             "--paths-meta", grc_meta_dir,
+             "--paths-tile", grc_tile_dir,
+             "--nthreads", nthreads,
+             "--max-edges-per-round", 16 * MB,
+             "--output-weighted", 1 if self.weighted else 0,
+             "--use-run-length-encoding", 1,
+             "--traversal", "hilbert"],
+            os.path.join(self.dir, "grc.log"))
+
+        reshuffle_files(grc_tile_dir, "eb-",
+                        os.path.join(self.tile_dir, "tiles.dat"), PAGE_SIZE)
+        reshuffle_files(grc_meta_dir, "ebi-",
+                        os.path.join(self.meta_dir, "meta.dat"), PAGE_SIZE)
+        reshuffle_files(grc_meta_dir, "ebs-",
+                        os.path.join(self.meta_dir, "tile_stats.dat"), 0)
+        shutil.copy(os.path.join(self.globals_dir, "stat.dat"), self.meta_dir)
+        shutil.rmtree(os.path.join(self.dir, "grc"))
+
+        # vertex to tile index of the selective scheduling
+        run([os.path.join(build_dir, "tools/post-grc/post-grc-indexer"),
+             "--path-global", self.globals_dir,
+             "--paths-meta", self.meta_dir,
+             "--nthreads", nthreads],
+            os.path.join(self.dir, "indexer.log"))
+        print("# %s: %d tiles, %.1f MB" %
+              (self.name, self.countTiles(), self.sizeTiles() / float(MB)))
+
+
+def wait_with_rusage(process, timeout):
+    # os.wait4 returns the rusage of exactly this child, the peak RSS of the
+    # harness and of other children does not leak in
+    deadline = time.time() + timeout
+    while True:
+        pid, status, rusage = os.wait4(process.pid, os.WNOHANG)
+        if pid != 0:
+            process.returncode = os.waitstatus_to_exitcode(status) \
+                if hasattr(os, "waitstatus_to_exitcode") else status
+            return process.returncode, rusage
+        if time.time() > deadline:
+            os.killpg(process.pid, signal.SIGKILL)
+            pid, status, rusage = os.wait4(process.pid, 0)
+            process.returncode = None
+            return None, rusage
+        time.sleep(0.05)
+
+
+def read_rounds(metrics_dir, file_name="vertex_domain.json"):
+    rounds = []
+    with open(os.path.join(metrics_dir, file_name)) as f:
+        for line in f:
+            if line.strip():
+                rounds.append(json.loads(line))
+    return rounds
+
+
+def runMosaic(opts, graph, algorithm, mode, run_dir):
+    metrics_dir = os.path.join(run_dir, "metrics")
+    fault_tolerance_dir = os.path.join(run_dir, "fault-tolerance")
+    perf_events_dir = os.path.join(run_dir, "perf-events")
+    for d in [metrics_dir, fault_tolerance_dir, perf_events_dir]:
+        os.makedirs(d)
+
+    # the vertex fetchers grab the tiles of the next round ahead of time,
+    # more fetchers than tiles would fetch a tile twice per round
+    count_vertex_fetchers = min(COUNT_VERTEX_FETCHERS, graph.countTiles())
+
+    # in the in-memory mode, all tiles stay in the read tiles rb
+    read_tiles_rb_size = opts.rb_size * MB
+    if MODES[mode]:
+        read_tiles_rb_size = max(read_tiles_rb_size,
+                                 align(2 * graph.sizeTiles(), MB))
+
+    use_selective_scheduling = algorithm in ALGORITHMS_SELECTIVE_SCHEDULING
+    args = [
+        os.path.join(opts.build_dir, "lib/core/mosaic"),
+        "--algorithm", algorithm,
+        "--max-iterations", opts.max_iterations,
+        "--nmic", 1,
+        "--count-applier", COUNT_APPLIERS,
+        "--count-globalreducer", COUNT_GLOBAL_REDUCERS,
+        "--count-globalfetcher", COUNT_GLOBAL_FETCHERS,
+        "--count-indexreader", COUNT_INDEX_READERS,
+        "--count-vertex-reducer", COUNT_VERTEX_REDUCERS,
+        "--count-vertex-fetcher", count_vertex_fetchers,
+        "--in-memory-mode", MODES[mode],
+        "--paths-meta", graph.meta_dir,
+        "--paths-tile", graph.tile_dir,
+        "--path-globals", graph.globals_dir,
+        "--use-selective-scheduling", 1 if use_selective_scheduling else 0,
+        "--path-fault-tolerance-output", fault_tolerance_dir,
+        "--enable-fault-tolerance", 0,
+        "--enable-tile-partitioning", 1,
+        "--count-tile-reader", COUNT_TILE_READERS,
+        "--local-fetcher-mode", "DirectAccess",
+        "--global-fetcher-mode", "Active",
+        "--enable-perf-event-collection", 0,
+        "--path-perf-events", perf_events_dir,
+        "--count-tile-processors", COUNT_TILE_PROCESSORS,
+        "--use-smt", 0,
+        "--host-tiles-rb-size", opts.rb_size * MB,
+        "--local-reducer-mode", "GlobalReducer",
+        "--processed-rb-size", opts.rb_size * MB,
+        "--read-tiles-rb-size", read_tiles_rb_size,
+        "--tile-processor-mode", "Active",
+        "--tile-processor-input-mode", "VertexFetcher",
+        "--tile-processor-output-mode", "VertexReducer",
+        "--count-followers", 0,
+        "--path-metrics", metrics_dir,
+    ]
+
+    log_file = os.path.join(run_dir, "mosaic.log")
+    with open(log_file, "w") as log:
+        start = time.time()
+        process = subprocess.Popen([str(a) for a in args], stdout=log,
+                                   stderr=subprocess.STDOUT,
+                                   start_new_session=True)
+        rc, rusage = wait_with_rusage(process, opts.timeout)
+        wall_s = time.time() - start
+
+    result = {"wall_s": round(wall_s, 3), "peak_rss_kb": rusage.ru_maxrss}
+    if rc is None:
+        result["status"] = "timeout"
+        return result
+    if rc != 0:
+        result["status"] = "failed (%d)" % rc
+        return result
+
+    rounds = read_rounds(metrics_dir)
+    round_ms = [r["time_ms"] for r in rounds]
+    edges = sum(e["edges"] for r in rounds for e in r["edge_engines"])
+    time_ms = sum(round_ms)
+    result.update({
+        "status": "ok",
+        "iterations": len(rounds),
+        "round_ms": round_ms,
+        "time_ms": round(time_ms, 3),
+        "edges": edges,
+        "edges_per_sec": edges / (time_ms / 1e3) if time_ms > 0 else 0.,
+    })
+    return result
+
+
+def runCsr(opts, graph, algorithm, run_dir):
+    metrics_dir = os.path.join(run_dir, "metrics")
+    os.makedirs(metrics_dir)
+
+    use_selective_scheduling = algorithm in ALGORITHMS_SELECTIVE_SCHEDULING
+    args = [
+        os.path.join(opts.build_dir, "lib/core/csr-baseline"),
+        "--algorithm", algorithm,
+        "--max-iterations", opts.max_iterations,
+        "--paths-meta", graph.meta_dir,
+        "--paths-tile", graph.tile_dir,
+        "--path-globals", graph.globals_dir,
+        "--use-selective-scheduling", 1 if use_selective_scheduling else 0,
+        "--path-metrics", metrics_dir,
+    ]
+
+    log_file = os.path.join(run_dir, "csr.log")
+    with open(log_file, "w") as log:
+        start = time.time()
+        process = subprocess.Popen([str(a) for a in args], stdout=log,
+                                   stderr=subprocess.STDOUT,
+                                   start_new_session=True)
+        rc, rusage = wait_with_rusage(process, opts.timeout)
+        wall_s = time.time() - start
+
+    result = {"wall_s": round(wall_s, 3), "peak_rss_kb": rusage.ru_maxrss}
+    if rc is None:
+        result["status"] = "timeout"
+        return result
+    if rc != 0:
+        result["status"] = "failed (%d)" % rc
+        return result
+
+    # edges are all in-edges of the targets gathered, sources skipped for
+    # being inactive included
+    rounds = read_rounds(metrics_dir, "csr_engine.json")
+    round_ms = [r["time_ms"] for r in rounds]
+    edges = sum(r["edges"] for r in rounds)
+    time_ms = sum(round_ms)
+    result.update({
+        "status": "ok",
+        "iterations": len(rounds),
+        "round_ms": round_ms,
+        "time_ms": round(time_ms, 3),
+        "gather_ms": round(sum(r["gather_ms"] for r in rounds), 3),
+        "apply_ms": round(sum(r["apply_ms"] for r in rounds), 3),
+        "edges": edges,
+        "edges_per_sec": edges / (time_ms / 1e3) if time_ms > 0 else 0.,
+    })
+    return result
+
+
+def median_run(results):
+    # the run of median time, all of its numbers come from the same run
+    ok = [r for r in results if r["status"] == "ok"]
+    if len(ok) < len(results):
+        return [r for r in results if r["status"] != "ok"][0]
+    ok.sort(key=lambda r: r["time_ms"])
+    result = ok[len(ok) // 2]
+    result["repetitions_ms"] = [r["time_ms"] for r in results]
+    return result
+
+
+def compare(runs, baseline, tolerance, rss_tolerance):
+    # returns the list of failures and regressions, in readable form
+    problems = []
+    print("")
+    print("%-36s %12s %12s %10s %10s  %s" %
+          ("run", "edges/s", "baseline", "rss [MB]", "baseline", "verdict"))
+    for key in sorted(runs):
+        current = runs[key]
+        base = baseline.get(key)
+        verdicts = []
+        notes = []
+        if current["status"] != "ok":
+            verdicts.append(current["status"])
+        elif base is not None and base.get("status") == "ok":
+            # the rounds until convergence vary between runs, the vertices of
+            # a round see the updates of the same round racily, the edges/s
+            # are per processed edge and stay comparable
+            if current["iterations"] != base["iterations"]:
+                notes.append("iterations %d, baseline %d" %
+                             (current["iterations"], base["iterations"]))
+            if current["edges_per_sec"] < \
+                    base["edges_per_sec"] * (1. - tolerance):
+                verdicts.append("edges/s -%.1f%%" %
+                                (100. * (1. - current["edges_per_sec"] /
+                                         base["edges_per_sec"])))
+            if current["peak_rss_kb"] > \
+                    base["peak_rss_kb"] * (1. + rss_tolerance):
+                verdicts.append("peak RSS +%.1f%%" %
+                                (100. * (current["peak_rss_kb"] /
+                                         float(base["peak_rss_kb"]) - 1.)))
+
+        if verdicts:
+            problems.append("%s: %s" % (key, ", ".join(verdicts)))
+        elif base is None:
+            verdicts.append("new")
+        else:
+            verdicts.append("ok")
+        verdicts += notes
+
+        print("%-36s %12s %12s %10s %10s  %s" % (
+            key,
+            "%.3g" % current["edges_per_sec"] if "edges_per_sec" in current
+            else "-",
+            "%.3g" % base["edges_per_sec"] if base and "edges_per_sec" in base
+            else "-",
+            "%.1f" % (current["peak_rss_kb"] / 1024.),
+            "%.1f" % (base["peak_rss_kb"] / 1024.) if base else "-",
+            ", ".join(verdicts)))
+
+    for key in sorted(set(baseline) - set(runs)):
+        print("%-36s not run" % key)
+    return problems
+
+
+def overhead(runs):
+    # Per round rather than per edge, the engines count the edges of a round
+    # differently. The edge phase of csr-baseline is the gather and reduce of
+    # all edges, the apply phase the apply of all vertices, whatever mosaic
+    # spends on top of both is its overhead.
+    rows = []
+    for key in sorted(runs):
+        graph_algorithm, mode = key.rsplit("/", 1)
+        if mode != MODE_CSR:
+            continue
+        csr = runs[key]
+        mosaic = runs.get("%s/in-memory" % graph_algorithm)
+        if mosaic is None or csr["status"] != "ok" or \
+                mosaic["status"] != "ok":
+            continue
+        mosaic_ms = mosaic["time_ms"] / mosaic["iterations"]
+        csr_ms = csr["time_ms"] / csr["iterations"]
+        rows.append((graph_algorithm, mosaic_ms, csr_ms,
+                     csr["gather_ms"] / csr["iterations"],
+                     csr["apply_ms"] / csr["iterations"]))
+    if not rows:
+        return
+
+    print("")
+    print("%-28s %12s %12s %10s %10s %12s %8s" %
+          ("ms per round", "in-memory", "csr", "edge", "apply", "overhead",
+           "factor"))
+    for graph_algorithm, mosaic_ms, csr_ms, gather_ms, apply_ms in rows:
+        print("%-28s %12.3f %12.3f %10.3f %10.3f %12.3f %8s" % (
+            graph_algorithm, mosaic_ms, csr_ms, gather_ms, apply_ms,
+            mosaic_ms - csr_ms,
+            "%.2fx" % (mosaic_ms / csr_ms) if csr_ms > 0 else "-"))
+
+
+if __name__ == "__main__":
+    parser = optparse.OptionParser()
+    parser.add_option("--build-dir", default=DEFAULT_BUILD_DIR,
+                      help="Release build to measure [%default]")
+    parser.add_option("--work-dir",
+                      help="scratch dir for the graphs and the runs, a "
+                      "temporary one by default")
+    parser.add_option("--keep", action="store_true", default=False,
+                      help="keep the scratch dir")
+    parser.add_option("--scales", default="18,19,20",
+                      help="comma-separated RMAT scales [%default]")
+    parser.add_option("--edge-factor", type="int", default=16,
+                      help="edges per vertex [%default]")
+    parser.add_option("--algorithms", default="pagerank,bfs,cc,sssp",
+                      help="comma-separated algorithms [%default]")
+    parser.add_option("--modes", default="in-memory,out-of-core,csr",
+                      help="comma-separated modes, csr runs csr-baseline "
+                      "[%default]")
+    parser.add_option("--max-iterations", type="int", default=10,
+                      help="[%default]")
+    parser.add_option("--repetitions", type="int", default=3,
+                      help="runs per algorithm and mode, the median counts "
+                      "[%default]")
+    parser.add_option("--timeout", type="int", default=600,
+                      help="seconds per run [%default]")
+    parser.add_option("--rb-size", type="int", default=256,
+                      help="size of the ring buffers in MB [%default]")
+    parser.add_option("--nthreads", type="int", default=2,
+                      help="threads of the grc and the indexer [%default]")
+    parser.add_option("--baseline", help="baseline to compare against")
+    parser.add_option("--update-baseline", action="store_true",
+                      default=False,
+                      help="store the results as the new baseline")
+    parser.add_option("--tolerance", type="float", default=0.1,
+                      help="allowed drop of the edges/s [%default]")
+    parser.add_option("--rss-tolerance", type="float", default=0.1,
+                      help="allowed growth of the peak RSS [%default]")
+    parser.add_option("--output", help="write the results to this file")
+    (opts, args) = parser.parse_args()
+
+    opts.build_dir = os.path.abspath(opts.build_dir)
+    for mode in opts.modes.split(","):
+        if mode not in MODES and mode != MODE_CSR:
+            print("Unknown mode %s, one of %s" %
+                  (mode, ", ".join(list(MODES) + [MODE_CSR])))
+            sys.exit(1)
+        binary = "csr-baseline" if mode == MODE_CSR else "mosaic"
+        if not os.path.exists(os.path.join(opts.build_dir, "lib/core",
+                                           binary)):
+            print("No %s in %s, build the Release first" %
+                  (binary, opts.build_dir))
+            sys.exit(1)
+
+    work_dir = opts.work_dir
+    if work_dir is None:
+        work_dir = tempfile.mkdtemp(prefix="mosaic-perf-")
+    else:
+        work_dir = os.path.abspath(work_dir)
+        os.makedirs(work_dir)
+    print("# Scratch dir %s" % work_dir)
+
+    algorithms = opts.algorithms.split(",")
+    runs = {}
+    try:
+        for scale in [int(s) for s in opts.scales.split(",")]:
+            for weighted in [False, True]:
+                graph_algorithms = [
+                    a for a in algorithms
+                    if (a in ALGORITHMS_WEIGHTED) == weighted]
+                if not graph_algorithms:
+                    continue
+                graph = Graph(work_dir, scale, opts.edge_factor, weighted)
+                graph.generate(opts.build_dir, opts.nthreads)
+
+                for algorithm in graph_algorithms:
+                    for mode in opts.modes.split(","):
+                        key = "%s/%s/%s" % (graph.name, algorithm, mode)
+                        results = []
+                        for i in range(opts.repetitions):
+                            run_dir = os.path.join(work_dir, "runs",
+                                                   key.replace("/", "-"),
+                                                   str(i))
+                            if mode == MODE_CSR:
+                                results.append(runCsr(opts, graph, algorithm,
+                                                      run_dir))
+                            else:
+                                results.append(runMosaic(opts, graph,
+                                                         algorithm, mode,
+                                                         run_dir))
+                            print("# %s #%d: %s" %
+                                  (key, i, results[-1]["status"]))
+                            if results[-1]["status"] != "ok":
+                                break
+                        runs[key] = median_run(results)
+    finally:
+        if not opts.keep:
+            shutil.rmtree(work_dir, True)
+
+    baseline = {}
+    if opts.baseline and os.path.exists(opts.baseline) and \
+            not opts.update_baseline:
+        with open(opts.baseline) as f:
+            baseline = json.load(f)["runs"]
+
+    problems = compare(runs, baseline, opts.tolerance, opts.rss_tolerance)
+    overhead(runs)
+
+    report = {
+        "scales": opts.scales,
+        "edge_factor": opts.edge_factor,
+        "max_iterations": opts.max_iterations,
+        "repetitions": opts.repetitions,
+        "runs": runs,
+    }
+    if opts.output:
+        with open(opts.output, "w") as f:
+            json.dump(report, f, indent=2, sort_keys=True)
+    if opts.update_baseline:
+        if not opts.baseline:
+            print("--update-baseline needs --baseline")
+            sys.exit(1)
+        with open(opts.baseline, "w") as f:
+            json.dump(report, f, indent=2, sort_keys=True)
+        print("# Stored the baseline in %s" % opts.baseline)
+
+    if problems:
+        print("")
+        for problem in problems:
+            print("REGRESSION %s" % problem)
+        sys.exit(1)
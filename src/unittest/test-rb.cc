@@ -1,88 +1,77 @@
 #include <assert.h>
 #include <stdlib.h>
+#include <pthread.h>
 
-#include <util/ring_buffer.h>
+#include <ring_buffer.h>
+#include <util/util.h>
 #include <core/util.h>
 
 #include "test.h"
 
-static size_t calc_rb_size() { return 1024 * 1024 * 1024; }
+namespace util = scalable_graphs::util;
 
-static int init_ring_buffer(ring_buffer_t** rb) {
-  int size = calc_rb_size();
-  int rc, i;
+static const size_t count_elements = 10 * 1000 * 1000;
+static const size_t size_element = 64;
 
-  int blocking = RING_BUFFER_REQ_BLOCKING;
+static size_t calc_rb_size() { return 1024 * 1024; }
 
-  rc = ring_buffer_create(size,               // XXX
-                          L1D_CACHELINE_SIZE, // XXX: DISK_BLOCK_SIZE
-                          blocking, rb);
+static int init_ring_buffer(int flags, ring_buffer_t** rb) {
+  int rc = ring_buffer_create(calc_rb_size(), L1D_CACHELINE_SIZE, flags, NULL,
+                              NULL, rb);
   if (rc) {
     sg_dbg("Init ringbuffer failed with %d\n", rc);
-    goto out;
   }
-  sg_dbg("rb-size_init %lu\n", (*rb)->size);
-
-out:
   return rc;
 }
 
-int main(int argc, char** argv) {
-
-  int count_elements = 100;
-  ring_buffer_t* rb = new ring_buffer_t;
-  init_ring_buffer(&rb);
-
-  size_t size = sizeof(int) * count_elements;
-
-  ring_buffer_req_t* req = new ring_buffer_req_t;
-  do {
-    ring_buffer_put_req_init(req, BLOCKING, size);
-    ring_buffer_put(rb, req);
-  } while (req->rc == -EAGAIN);
-
-  sg_rb_check(req);
-
-  int* a1 = (int*)req->data;
-  for (int i = 0; i < count_elements; ++i) {
-    a1[i] = i;
+static void* produce(void* arg) {
+  ring_buffer_t* rb = (ring_buffer_t*)arg;
+  ring_buffer_req_t req;
+  for (size_t i = 0; i < count_elements; ++i) {
+    ring_buffer_put_req_init(&req, BLOCKING, size_element);
+    ring_buffer_put(rb, &req);
+    sg_rb_check(&req);
+    *(size_t*)req.data = i;
+    ring_buffer_elm_set_ready(rb, req.data);
   }
-  ring_buffer_elm_set_ready(rb, a1);
-
-  do {
-    ring_buffer_put_req_init(req, BLOCKING, size);
-    ring_buffer_put(rb, req);
-  } while (req->rc == -EAGAIN);
-
-  sg_rb_check(req);
+  return NULL;
+}
 
-  int* a2 = (int*)req->data;
-  for (int i = 0; i < count_elements; ++i) {
-    a2[i] = i + 1;
+// Streams count_elements from a producer to a consumer thread, returns the
+// elements per second, or 0 if they arrive out of order.
+static double run(int flags) {
+  ring_buffer_t* rb;
+  if (init_ring_buffer(flags, &rb)) {
+    return 0.;
   }
-  ring_buffer_elm_set_ready(rb, a2);
 
-  do {
-    ring_buffer_put_req_init(req, BLOCKING, size);
-    ring_buffer_put(rb, req);
-  } while (req->rc == -EAGAIN);
+  uint64_t start = util::get_time_nsec();
+  pthread_t producer;
+  pthread_create(&producer, NULL, produce, rb);
+
+  bool in_order = true;
+  ring_buffer_req_t req;
+  for (size_t i = 0; i < count_elements; ++i) {
+    ring_buffer_get_req_init(&req, BLOCKING);
+    ring_buffer_get(rb, &req);
+    sg_rb_check(&req);
+    in_order &= *(size_t*)req.data == i;
+    ring_buffer_elm_set_done(rb, req.data);
+  }
+  pthread_join(producer, NULL);
+  uint64_t end = util::get_time_nsec();
 
-  sg_rb_check(req);
+  ring_buffer_destroy(rb);
+  return in_order ? count_elements / ((end - start) / 1e9) : 0.;
+}
 
-  int* a3 = (int*)req->data;
-  for (int i = 0; i < count_elements; ++i) {
-    a3[i] = i + 2;
-  }
-  ring_buffer_elm_set_ready(rb, a3);
+int main(int argc, char** argv) {
+  double rate_combining = run(RING_BUFFER_BLOCKING);
+  double rate_spsc = run(RING_BUFFER_BLOCKING | RING_BUFFER_SPSC);
 
-  // assert content
-  for (int i = 0; i < count_elements; ++i) {
-    sg_test(a1[i] == i, "a1");
-    sg_test(a2[i] == i + 1, "a2");
-    sg_test(a3[i] == i + 2, "a3");
-  }
-  ring_buffer_elm_set_done(rb, a1);
-  ring_buffer_elm_set_done(rb, a2);
-  ring_buffer_elm_set_done(rb, a3);
+  sg_log("combining: %.2f M elements/s\n", rate_combining / 1e6);
+  sg_log("spsc:      %.2f M elements/s\n", rate_spsc / 1e6);
+  sg_test(rate_combining > 0., "combining in order");
+  sg_test(rate_spsc > 0., "spsc in order");
   return 0;
 }
@@ -8,6 +8,7 @@ extern "C" {
 #include <linux/limits.h>
 #include <arch.h>
 #include <ring_buffer_common.h>
+#include <ring_buffer_wait.h>
 
 /*
  * configurations for lock-based version
@@ -40,8 +41,8 @@ struct ring_buffer_nap_info_t {
 	int                                monitoring_status;
 	volatile struct ring_buffer_elm_t *monitoring_elm;
 #ifndef RING_BUFFER_CONF_KERNEL
-	pthread_mutex_t                    mutex;
-	pthread_cond_t                     wait;
+	volatile int                       count_sleepers; /* futex() on is_nap_time */
+	volatile int                       count_elm_sleepers; /* futex() on monitoring_elm */
 #else
 	struct mutex                       mutex;
 	wait_queue_head_t                  wait;
@@ -53,6 +54,7 @@ struct ring_buffer_t {
 	size_t align_mask;                          /* data alignment mask */
 	void *buff;                                 /* start of ring buffer */
 	int  is_blocking;                           /* blocking or non-blocking */
+	int  is_spsc;                               /* single producer and consumer */
 	ring_buffer_reap_cb_t reap_cb;              /* user-defined reap callback */
 	void* reap_cb_arg;                          /* user-defined reap callback argument */
 	ring_buffer_is_healthy_t is_healthy;        /* health check function */
@@ -60,8 +62,10 @@ struct ring_buffer_t {
 
 	volatile size_t head  ____cacheline_aligned2; /* byte offset */
 	volatile size_t tail2;                      /* byte offset */
+	size_t high_water;                          /* max. bytes in use, producer only */
 
 	volatile size_t tail  ____cacheline_aligned2; /* byte offset */
+	size_t head_cache;                          /* consumer's copy of head, SPSC only */
 
 #ifndef RING_BUFFER_TWO_LOCK
 	volatile struct ring_buffer_req_t *put_req ____cacheline_aligned2;
@@ -96,6 +100,10 @@ void ring_buffer_destroy(struct ring_buffer_t *rb);
 int  ring_buffer_put(struct ring_buffer_t *rb, struct ring_buffer_req_t *req);
 int  ring_buffer_get(struct ring_buffer_t *rb, struct ring_buffer_req_t *req);
 int  ring_buffer_put_nolock(struct ring_buffer_t *rb, struct ring_buffer_req_t *req);
+int  ring_buffer_put_batch(struct ring_buffer_t *rb,
+			   struct ring_buffer_req_t *reqs, unsigned int n);
+int  ring_buffer_get_batch(struct ring_buffer_t *rb,
+			   struct ring_buffer_req_t *reqs, unsigned int n);
 int  ring_buffer_get_nolock(struct ring_buffer_t *rb, struct ring_buffer_req_t *req);
 
 void ring_buffer_elm_set_ready(struct ring_buffer_t *rb, void *data);
@@ -109,6 +117,8 @@ unsigned int ring_buffer_get_compat_vector(void);
 int    ring_buffer_is_empty(struct ring_buffer_t *rb);
 int    ring_buffer_is_full(struct ring_buffer_t *rb);
 size_t ring_buffer_free_space(struct ring_buffer_t *rb);
+size_t ring_buffer_high_water(struct ring_buffer_t *rb);
+void ring_buffer_reset_high_water(struct ring_buffer_t *rb);
 #ifdef __cplusplus
 }
 #endif
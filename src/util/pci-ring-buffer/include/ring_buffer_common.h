@@ -46,6 +46,8 @@ extern "C" {
  */
 #define RING_BUFFER_NON_BLOCKING    0x0
 #define RING_BUFFER_BLOCKING        0x1
+#define RING_BUFFER_SPSC            0x2 /* or-ed, single producer and
+					 * single consumer at a time */
 
 
 /*
@@ -80,11 +82,14 @@ struct ring_buffer_req_t {
 	void *data;          /* [out] pointer to the buffer element */
 	volatile int rc;     /* [out] return code */
 	volatile int flag;   /* [in, out] operation mode */
+	unsigned int __count; /* [internal] requests in a batch */
+	unsigned int __done;  /* [internal] requests of a batch served */
 } ____cacheline_aligned;     /* aligned to a cacheline
 			      * for a combiner to reduce cache access */
 
 #define RING_BUFFER_REQ_BLOCKING       0x0001
 #define RING_BUFFER_REQ_NON_BLOCKING   0x0002
+#define RING_BUFFER_REQ_BATCH          0x0100
 #define RING_BUFFER_REQ_COMBINER       0x4000
 #define RING_BUFFER_REQ_DONE           0x8000
 
@@ -88,6 +88,10 @@ int  ring_buffer_scif_put_nolock(struct ring_buffer_scif_t *rbs,
 				 struct ring_buffer_req_t *req);
 int  ring_buffer_scif_get_nolock(struct ring_buffer_scif_t *rbs,
 				 struct ring_buffer_req_t *req);
+int  ring_buffer_scif_put_batch(struct ring_buffer_scif_t *rbs,
+				struct ring_buffer_req_t *reqs, unsigned int n);
+int  ring_buffer_scif_get_batch(struct ring_buffer_scif_t *rbs,
+				struct ring_buffer_req_t *reqs, unsigned int n);
 
 void ring_buffer_scif_elm_set_ready(struct ring_buffer_scif_t *rbs,
 				    void *data);
@@ -102,6 +106,8 @@ int  copy_to_ring_buffer_scif(struct ring_buffer_scif_t *rbs,
 int    ring_buffer_scif_is_empty(struct ring_buffer_scif_t *rbs);
 int    ring_buffer_scif_is_full(struct ring_buffer_scif_t *rbs);
 size_t ring_buffer_scif_free_space(struct ring_buffer_scif_t *rbs);
+size_t ring_buffer_scif_high_water(struct ring_buffer_scif_t *rbs);
+void ring_buffer_scif_reset_high_water(struct ring_buffer_scif_t *rbs);
 #ifdef __cplusplus
 }
 #endif
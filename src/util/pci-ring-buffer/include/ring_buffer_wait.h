@@ -0,0 +1,146 @@
+#ifndef _RING_BUFFER_WAIT_H_
+#define _RING_BUFFER_WAIT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <arch.h>
+
+/*
+ * adaptive wait on a 32-bit word
+ * - a waiter spins for a while, then sleeps on the word with futex().
+ * - a waker enters the kernel only if somebody announced to sleep.
+ */
+#define RB_WAIT_SPIN_COUNT 4096
+
+#ifndef RING_BUFFER_CONF_KERNEL
+# include <limits.h>
+# include <time.h>
+# include <unistd.h>
+# include <sys/syscall.h>
+# include <linux/futex.h>
+
+static inline void __rb_cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	__asm__ __volatile__("pause":::"memory");
+#else
+	__asm__ __volatile__("":::"memory");
+#endif
+}
+
+/* sleep as long as *word is val */
+static inline void rb_futex_wait(volatile int *word, int val)
+{
+	syscall(SYS_futex, (int *)word, FUTEX_WAIT_PRIVATE, val,
+		NULL, NULL, 0);
+}
+
+/* sleep as long as *word is val, at most usec microseconds */
+static inline void rb_futex_wait_timeout(volatile int *word, int val,
+					 long usec)
+{
+	struct timespec timeout = {usec / 1000000, (usec % 1000000) * 1000};
+
+	syscall(SYS_futex, (int *)word, FUTEX_WAIT_PRIVATE, val,
+		&timeout, NULL, 0);
+}
+
+/* wake up to count sleepers on word */
+static inline void rb_futex_wake(volatile int *word, int count)
+{
+	syscall(SYS_futex, (int *)word, FUTEX_WAKE_PRIVATE, count,
+		NULL, NULL, 0);
+}
+
+/*
+ * event: a flag a thread sets once its data is ready, e.g.,
+ * a readiness flag of a pointer offset table.
+ * - waiters spin, then sleep until the event is set.
+ * - a set wakes all sleepers, a reset only happens when nobody waits.
+ */
+#define RB_EVENT_UNSET     0
+#define RB_EVENT_SET       1
+#define RB_EVENT_SLEEPING  2 /* unset, with sleepers */
+
+static inline int rb_event_is_set(volatile int *ev)
+{
+	return *ev == RB_EVENT_SET;
+}
+
+static inline void rb_event_wait(volatile int *ev)
+{
+	int i, val;
+
+	/* spin for a while */
+	for (i = 0; i < RB_WAIT_SPIN_COUNT; ++i) {
+		if (*ev == RB_EVENT_SET)
+			goto out;
+		__rb_cpu_relax();
+	}
+
+	/* announce a sleeper, then sleep until the event is set */
+	while ((val = *ev) != RB_EVENT_SET) {
+		if (val == RB_EVENT_UNSET &&
+		    !smp_cas(ev, RB_EVENT_UNSET, RB_EVENT_SLEEPING))
+			continue;
+		rb_futex_wait(ev, RB_EVENT_SLEEPING);
+	}
+out:
+	smp_rmb();
+}
+
+static inline void rb_event_set(volatile int *ev)
+{
+	/* publish the data before the event */
+	smp_wmb();
+	if (smp_swap(ev, RB_EVENT_SET) == RB_EVENT_SLEEPING)
+		rb_futex_wake(ev, INT_MAX);
+}
+
+static inline void rb_event_reset(volatile int *ev)
+{
+	*ev = RB_EVENT_UNSET;
+}
+
+/*
+ * slot: a word owned by one thread at a time, e.g., an entry of
+ * a pointer offset table which a reader fills and a consumer frees.
+ * - the owner may be another thread than the one which acquired it.
+ * - a release wakes a single sleeper.
+ */
+#define RB_SLOT_FREE       0
+#define RB_SLOT_TAKEN      1
+#define RB_SLOT_CONTENDED  2 /* taken, with sleepers */
+
+static inline void rb_slot_acquire(volatile int *slot)
+{
+	int i;
+
+	/* spin for a while */
+	for (i = 0; i < RB_WAIT_SPIN_COUNT; ++i) {
+		if (*slot == RB_SLOT_FREE &&
+		    smp_cas(slot, RB_SLOT_FREE, RB_SLOT_TAKEN))
+			return;
+		__rb_cpu_relax();
+	}
+
+	/* mark contended, then sleep until the slot is free */
+	while (smp_swap(slot, RB_SLOT_CONTENDED) != RB_SLOT_FREE)
+		rb_futex_wait(slot, RB_SLOT_CONTENDED);
+}
+
+static inline void rb_slot_release(volatile int *slot)
+{
+	smp_wmb();
+	if (smp_swap(slot, RB_SLOT_FREE) == RB_SLOT_CONTENDED)
+		rb_futex_wake(slot, 1);
+}
+#else  /* RING_BUFFER_CONF_KERNEL */
+# define __rb_cpu_relax() cpu_relax()
+#endif /* RING_BUFFER_CONF_KERNEL */
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _RING_BUFFER_WAIT_H_ */
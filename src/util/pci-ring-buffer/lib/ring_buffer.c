@@ -35,6 +35,14 @@ int _ring_buffer_init_nap_time(struct ring_buffer_t *rb)
 	if (!rb->is_blocking)
 		return 0;
 
+#ifndef RING_BUFFER_CONF_KERNEL
+	/* sleepers wait on is_nap_time with futex() */
+	for (i = 0; i < 2; ++i) {
+		nap[i]->count_sleepers = 0;
+		nap[i]->count_elm_sleepers = 0;
+	}
+	rc = 0;
+#else
 	/* init the nap lock and condtion variable */
 	for (i = 0; i < 2; ++i) {
 		rc = __rb_mutex_init(&(nap[i])->mutex);
@@ -45,6 +53,7 @@ int _ring_buffer_init_nap_time(struct ring_buffer_t *rb)
 			goto out;
 	}
 out:
+#endif /* RING_BUFFER_CONF_KERNEL */
 	return rc;
 }
 
@@ -54,12 +63,14 @@ void _ring_buffer_deinit_nap_time(struct ring_buffer_t *rb)
 		&rb->put_nap, &rb->get_nap};
 	int i;
 
+#ifdef RING_BUFFER_CONF_KERNEL
 	if (rb->is_blocking) {
 		for (i = 0; i < 2; ++i) {
 			__rb_wait_destroy(&(nap[i])->wait);
 			__rb_mutex_destroy(&(nap[i])->mutex);
 		}
 	}
+#endif /* RING_BUFFER_CONF_KERNEL */
 }
 
 static inline
@@ -82,10 +93,18 @@ void _nap_wake_up_all_waiters(struct ring_buffer_t *rb, int op_type,
 
 		/* then, wake up waiters */
 		nap->is_nap_time = 0;
+#ifndef RING_BUFFER_CONF_KERNEL
+		/* only enter the kernel if somebody sleeps,
+		 * pairs with smp_mb() in _nap_doze() */
+		smp_mb();
+		if (nap->count_sleepers)
+			rb_futex_wake(&nap->is_nap_time, INT_MAX);
+#else
 		smp_wmb();
 		__rb_mutex_lock(&nap->mutex); {
 			__rb_wait_wake_up_all(&nap->wait);
 		} __rb_mutex_unlock(&nap->mutex);
+#endif /* RING_BUFFER_CONF_KERNEL */
 	}
 	nap->monitoring_elm = NULL;
 }
@@ -105,11 +124,66 @@ void _nap_wake_up_all_waiters_nolock(struct ring_buffer_t *rb, int op_type,
 	nap->monitoring_elm = NULL;
 }
 
+#ifndef RING_BUFFER_CONF_KERNEL
+/* a status change of an element is not always set by this process,
+ * e.g., a remote peer over PCIe, so a sleeper wakes up regularly */
+#define RB_ELM_SLEEP_USEC 1000
+
+/* the aligned 32-bit word of padding and status after the size of an
+ * element, to sleep on */
+static inline
+volatile int *_elm_status_word(volatile struct ring_buffer_elm_t *elm)
+{
+	return (volatile int *)((volatile char *)elm + sizeof(elm->__size));
+}
+
+static
+void _nap_wait_elm(struct ring_buffer_nap_info_t *nap)
+{
+	volatile struct ring_buffer_elm_t *elm = nap->monitoring_elm;
+	int word;
+
+	/* announce a sleeper, then sleep until the status changes,
+	 * pairs with smp_mb() in _nap_wake_up_elm_waiters() */
+	smp_faa(&nap->count_elm_sleepers, 1);
+	smp_mb();
+	for (word = *_elm_status_word(elm);
+	     !(elm->status & nap->monitoring_status);
+	     word = *_elm_status_word(elm)) {
+		rb_futex_wait_timeout(_elm_status_word(elm), word,
+				      RB_ELM_SLEEP_USEC);
+		smp_rmb();
+	}
+	smp_faa(&nap->count_elm_sleepers, -1);
+}
+
+static inline
+void _nap_wake_up_elm_waiters(struct ring_buffer_t *rb,
+			      struct ring_buffer_nap_info_t *nap)
+{
+	volatile struct ring_buffer_elm_t *elm;
+
+	/* only enter the kernel if a combiner sleeps on an element */
+	if (!rb->is_blocking)
+		return;
+	smp_mb();
+	elm = nap->monitoring_elm;
+	if (unlikely(nap->count_elm_sleepers) && elm)
+		rb_futex_wake(_elm_status_word(elm), INT_MAX);
+}
+#else
+static inline
+void _nap_wake_up_elm_waiters(struct ring_buffer_t *rb,
+			      struct ring_buffer_nap_info_t *nap)
+{
+}
+#endif /* RING_BUFFER_CONF_KERNEL */
+
 static
 int  _nap_peek(struct ring_buffer_t *rb, int op_type,
 	       struct ring_buffer_nap_info_t *nap)
 {
-	int rc = 0;
+	int rc = 0, i;
 
 	/* check if this ring buffer is healthy or not */
 	if (rb->is_healthy) {
@@ -141,10 +215,22 @@ int  _nap_peek(struct ring_buffer_t *rb, int op_type,
 	}
 
 	/* case 2
-	 * - idle-polling for the change of status of a monitoring element */
-	while ( !(nap->monitoring_elm->status & nap->monitoring_status) ) {
+	 * - wait for the change of status of a monitoring element,
+	 *   spin for a while before sleeping */
+	for (i = 0;
+	     !(nap->monitoring_elm->status & nap->monitoring_status); ++i) {
+		if (i < RB_WAIT_SPIN_COUNT) {
+			__rb_cpu_relax();
+			smp_rmb();
+			continue;
+		}
+#ifndef RING_BUFFER_CONF_KERNEL
+		_nap_wait_elm(nap);
+		break;
+#else
 		__rb_yield();
 		smp_rmb();
+#endif /* RING_BUFFER_CONF_KERNEL */
 	}
 
 wake_up_out:
@@ -168,6 +254,26 @@ static
 void _nap_doze(struct ring_buffer_nap_info_t *nap,
 	       struct ring_buffer_req_t *req)
 {
+#ifndef RING_BUFFER_CONF_KERNEL
+	int i;
+
+	/* spin for a while */
+	for (i = 0; i < RB_WAIT_SPIN_COUNT; ++i) {
+		if ( !_nap_need_doze(nap, req))
+			return;
+		__rb_cpu_relax();
+	}
+
+	/* announce a sleeper, then sleep on is_nap_time with futex()
+	 * until a combiner ends the nap time */
+	smp_faa(&nap->count_sleepers, 1);
+	smp_mb();
+	while ( _nap_need_doze(nap, req)) {
+		rb_futex_wait(&nap->is_nap_time, 1);
+		smp_rmb();
+	}
+	smp_faa(&nap->count_sleepers, -1);
+#else
 	/* triple-check locking optimization */
 	/* - save rmb() here */
 	if ( _nap_need_doze(nap, req)) {
@@ -188,6 +294,7 @@ void _nap_doze(struct ring_buffer_nap_info_t *nap,
 			} __rb_mutex_unlock(&nap->mutex);
 		}
 	}
+#endif /* RING_BUFFER_CONF_KERNEL */
 }
 
 static
@@ -416,9 +523,12 @@ int  __ring_buffer_create(const char *where, unsigned int line,
 	rb->head     = start_offset;
 	rb->tail     = start_offset;
 	rb->tail2    = start_offset;
+	rb->head_cache = start_offset;
+	rb->high_water = 0;
 
 	/* init nap time */
-	rb->is_blocking = is_blocking;
+	rb->is_blocking = is_blocking & RING_BUFFER_BLOCKING;
+	rb->is_spsc     = !!(is_blocking & RING_BUFFER_SPSC);
 	rc = _ring_buffer_init_nap_time(rb);
 	if (rc)
 		goto err_out;
@@ -732,6 +842,24 @@ size_t ring_buffer_free_space(struct ring_buffer_t *rb)
 }
 EXPORT_SYMBOL(ring_buffer_free_space);
 
+/*
+ * high-water mark
+ * - the most bytes in use right after a put since the last reset,
+ *   tracked on the producer side only.
+ * - a reset races with a concurrent put, which is fine for statistics.
+ */
+size_t ring_buffer_high_water(struct ring_buffer_t *rb)
+{
+	return rb->high_water;
+}
+EXPORT_SYMBOL(ring_buffer_high_water);
+
+void ring_buffer_reset_high_water(struct ring_buffer_t *rb)
+{
+	rb->high_water = 0;
+}
+EXPORT_SYMBOL(ring_buffer_reset_high_water);
+
 static
 size_t _secure_free_space(struct ring_buffer_t *rb, size_t n)
 {
@@ -828,14 +956,15 @@ void __ring_buffer_put(struct ring_buffer_t *rb, struct ring_buffer_req_t *req)
 	struct ring_buffer_elm_t *elm_addr, elm;
 	unsigned short elm_status;
 	unsigned short elm_init_status = RING_BUFFER_ELM_STATUS_INIT;
-	size_t rb_head;
+	size_t rb_head, free_size, used_size;
 	int rc = 0;
 
 	goto start; /* to make compiler happy */
 start:
 	/* check whether there is enough free space */
 	elm_status = elm_init_status;
-	if ( _secure_free_space(rb, req->__size) < req->__size ) {
+	free_size = _secure_free_space(rb, req->__size);
+	if ( free_size < req->__size ) {
 		rb->put_nap.monitoring_elm = rb->buff + rb->tail2;
 		rb->put_nap.monitoring_status = RING_BUFFER_ELM_STATUS_DONE;
 		rc = -EAGAIN;
@@ -885,6 +1014,11 @@ start:
 	/* leave fingerprint */
 	_leave_fingerprint(req->data);
 
+	/* track the high-water mark */
+	used_size = rb->size - (free_size - req->__size);
+	if (unlikely(used_size > rb->high_water))
+		rb->high_water = used_size;
+
 	/* Publish new head
 	 * Make sure that the elm is published before the head, otherwise the head
 	 * might move on before the element is filled. */
@@ -906,6 +1040,21 @@ int ring_buffer_is_empty(struct ring_buffer_t *rb)
 }
 EXPORT_SYMBOL(ring_buffer_is_empty);
 
+static inline
+int _ring_buffer_is_empty_cached(struct ring_buffer_t *rb)
+{
+	/* the only consumer re-reads head, which is written by the producer,
+	 * once it caught up with the head it saw last time */
+	if (rb->tail == rb->head_cache) {
+		rb_rmb(rb, RING_BUFFER_OP_GET);
+		rb->head_cache = rb->head;
+		if (rb->tail == rb->head_cache) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
 static
 void __ring_buffer_get(struct ring_buffer_t *rb, struct ring_buffer_req_t *req)
 {
@@ -916,7 +1065,8 @@ void __ring_buffer_get(struct ring_buffer_t *rb, struct ring_buffer_req_t *req)
 	goto start; /* to make compiler happy */
 start:
 	/* check whether it is empty */
-	if (ring_buffer_is_empty(rb)) {
+	if (rb->is_spsc ? _ring_buffer_is_empty_cached(rb) :
+			  ring_buffer_is_empty(rb)) {
 		rc = -EAGAIN;
 		goto out;
 	}
@@ -973,6 +1123,52 @@ out:
 	req->rc = rc;
 }
 
+static
+void __ring_buffer_put_batch(struct ring_buffer_t *rb,
+			     struct ring_buffer_req_t *reqs)
+{
+	struct ring_buffer_req_t *r;
+	size_t batch_size = 0;
+	unsigned int i;
+
+	/* reap once for all pending elements of the batch
+	 * instead of once per element */
+	for (i = reqs->__done; i < reqs->__count; ++i)
+		batch_size += reqs[i].__size;
+	_secure_free_space(rb, batch_size);
+
+	/* reserve elements back-to-back.
+	 * if the ring buffer runs full, the batch is retried
+	 * from the first element not reserved yet. */
+	for (; reqs->__done < reqs->__count; ++reqs->__done) {
+		r = &reqs[reqs->__done];
+		__ring_buffer_put(rb, r);
+		if (r->rc)
+			break;
+	}
+
+	/* the first request carries the result of the batch */
+	reqs->rc = (reqs->__done == reqs->__count) ? 0 : -EAGAIN;
+}
+
+static
+void __ring_buffer_get_batch(struct ring_buffer_t *rb,
+			     struct ring_buffer_req_t *reqs)
+{
+	struct ring_buffer_req_t *r;
+
+	/* claim ready elements until the batch is full */
+	for (; reqs->__done < reqs->__count; ++reqs->__done) {
+		r = &reqs[reqs->__done];
+		__ring_buffer_get(rb, r);
+		if (r->rc)
+			break;
+	}
+
+	/* a batch is served as soon as one element is claimed */
+	reqs->rc = (reqs->__done > 0) ? 0 : -EAGAIN;
+}
+
 static
 int ask_request(volatile struct ring_buffer_req_t **tail,
 		struct ring_buffer_req_t *req)
@@ -1033,6 +1229,14 @@ static inline
 void exec_op(struct ring_buffer_t *rb, int op_type,
 	     struct ring_buffer_req_t *req)
 {
+	if (unlikely(req->flag & RING_BUFFER_REQ_BATCH)) {
+		if (op_type == RING_BUFFER_OP_PUT)
+			__ring_buffer_put_batch(rb, req);
+		else
+			__ring_buffer_get_batch(rb, req);
+		return;
+	}
+
 	if (op_type == RING_BUFFER_OP_PUT)
 		__ring_buffer_put(rb, req);
 	else
@@ -1045,6 +1249,49 @@ int need_peek(struct ring_buffer_req_t *r)
 	return r->rc == -EAGAIN && r->flag & RING_BUFFER_REQ_BLOCKING;
 }
 
+/*
+ * SPSC fast path
+ * - a ring buffer created with RING_BUFFER_SPSC has at most one producer
+ *   and one consumer at a time, so a request is executed right away
+ *   instead of going through the combining protocol.
+ * - the producer only writes head and tail2, the consumer tail and
+ *   head_cache, so the two sides do not bounce their cachelines.
+ */
+static
+int ring_buffer_op_spsc(struct ring_buffer_t *rb, int op_type,
+			struct ring_buffer_req_t *req)
+{
+	exec_op(rb, op_type, req);
+
+	/* for blocking ring buffer */
+	if (rb->is_blocking) {
+		int blocked = 0;
+		struct ring_buffer_nap_info_t *nap;
+		nap =_rb_get_nap_info(rb, op_type);
+
+		/* need peek? */
+		while ( need_peek(req) ) {
+			/* if something goes wrong, break */
+			if ( _nap_peek(rb, op_type, nap) < 0)
+				break;
+
+			/* retry operation */
+			exec_op(rb, op_type, req);
+
+			blocked = 1;
+		}
+
+		/* wake up path */
+		if (blocked)
+			_nap_wake_up_all_waiters_nolock(rb, op_type, nap);
+	}
+
+	/* reflect my updates */
+	rb_wmb(rb, op_type);
+	req->flag |= RING_BUFFER_REQ_DONE;
+	return req->rc;
+}
+
 #ifndef RING_BUFFER_TWO_LOCK
 static
 void ring_buffer_op(struct ring_buffer_t *rb,
@@ -1168,6 +1415,10 @@ int ring_buffer_put(struct ring_buffer_t *rb, struct ring_buffer_req_t *req)
 	if (__ring_buffer_put_align_size(rb, req))
 		goto out;
 
+	/* a single producer does not need to combine */
+	if (rb->is_spsc)
+		return ring_buffer_op_spsc(rb, RING_BUFFER_OP_PUT, req);
+
 	/* perform a put operation */
 #ifndef RING_BUFFER_TWO_LOCK
 	ring_buffer_op(rb, &rb->put_req, RING_BUFFER_OP_PUT, req);
@@ -1236,6 +1487,10 @@ EXPORT_SYMBOL(ring_buffer_put_nolock);
 
 int ring_buffer_get(struct ring_buffer_t *rb, struct ring_buffer_req_t *req)
 {
+	/* a single consumer does not need to combine */
+	if (rb->is_spsc)
+		return ring_buffer_op_spsc(rb, RING_BUFFER_OP_GET, req);
+
 	/* perform a get operation */
 #ifndef RING_BUFFER_TWO_LOCK
 	ring_buffer_op(rb, &rb->get_req, RING_BUFFER_OP_GET, req);
@@ -1254,12 +1509,87 @@ int ring_buffer_get_nolock(struct ring_buffer_t *rb, struct ring_buffer_req_t *r
 }
 EXPORT_SYMBOL(ring_buffer_get_nolock);
 
+/*
+ * batch API
+ * - reqs[0] is initialized by ring_buffer_{put,get}_req_init()
+ *   and decides the operation mode for the whole batch.
+ * - all n requests are served by a single put() or get() operation,
+ *   i.e., one pass through the combining lock.
+ */
+int ring_buffer_put_batch(struct ring_buffer_t *rb,
+			  struct ring_buffer_req_t *reqs, unsigned int n)
+{
+	size_t batch_size = 0;
+	unsigned int i;
+
+	if (n == 0)
+		return 0;
+
+	/* align request sizes,
+	 * the batch has to fit into the ring buffer at once */
+	for (i = 0; i < n; ++i) {
+		if (__ring_buffer_put_align_size(rb, &reqs[i])) {
+			reqs->rc = reqs[i].rc;
+			goto out;
+		}
+		batch_size += reqs[i].__size;
+	}
+	if ( unlikely(rb->size < batch_size) ) {
+		reqs->rc = -EINVAL;
+		goto out;
+	}
+
+	/* perform a put operation for all elements */
+	reqs->flag   |= RING_BUFFER_REQ_BATCH;
+	reqs->__count = n;
+	reqs->__done  = 0;
+	if (rb->is_spsc)
+		return ring_buffer_op_spsc(rb, RING_BUFFER_OP_PUT, reqs);
+#ifndef RING_BUFFER_TWO_LOCK
+	ring_buffer_op(rb, &rb->put_req, RING_BUFFER_OP_PUT, reqs);
+#else
+	spinlock_lock(&rb->put_lock); {
+		__ring_buffer_put_batch(rb, reqs);
+	} spinlock_unlock(&rb->put_lock);
+#endif
+out:
+	return reqs->rc;
+}
+EXPORT_SYMBOL(ring_buffer_put_batch);
+
+int ring_buffer_get_batch(struct ring_buffer_t *rb,
+			  struct ring_buffer_req_t *reqs, unsigned int n)
+{
+	if (n == 0)
+		return 0;
+
+	/* perform a get operation for up to n elements */
+	reqs->flag   |= RING_BUFFER_REQ_BATCH;
+	reqs->__count = n;
+	reqs->__done  = 0;
+	if (rb->is_spsc)
+		ring_buffer_op_spsc(rb, RING_BUFFER_OP_GET, reqs);
+	else {
+#ifndef RING_BUFFER_TWO_LOCK
+		ring_buffer_op(rb, &rb->get_req, RING_BUFFER_OP_GET, reqs);
+#else
+		spinlock_lock(&rb->get_lock); {
+			__ring_buffer_get_batch(rb, reqs);
+		} spinlock_unlock(&rb->get_lock);
+#endif
+	}
+
+	/* the number of claimed elements */
+	if (reqs->rc)
+		return reqs->rc;
+	return (int)reqs->__done;
+}
+EXPORT_SYMBOL(ring_buffer_get_batch);
+
 void ring_buffer_elm_set_ready(struct ring_buffer_t *rb, void *data)
 {
 	struct ring_buffer_elm_t *elm;
 
-	rb = rb; /* to make compiler happy */
-
 	/* check whether you pass the right data pointer */
 	_check_fingerprint(data);
 
@@ -1278,6 +1608,9 @@ void ring_buffer_elm_set_ready(struct ring_buffer_t *rb, void *data)
 		elm->status  = RING_BUFFER_ELM_STATUS_READY;
 #endif /* RING_BUFFER_CONF_NO_DOUBLE_MMAP */
 	} smp_wmb_tso();
+
+	/* a get combiner may sleep on this element */
+	_nap_wake_up_elm_waiters(rb, &rb->get_nap);
 }
 EXPORT_SYMBOL(ring_buffer_elm_set_ready);
 
@@ -1285,8 +1618,6 @@ void ring_buffer_elm_set_done(struct ring_buffer_t *rb, void *data)
 {
 	struct ring_buffer_elm_t *elm;
 
-	rb = rb; /* to make compiler happy */
-
 	/* check whether you pass the right data pointer */
 	_check_fingerprint(data);
 
@@ -1314,6 +1645,9 @@ void ring_buffer_elm_set_done(struct ring_buffer_t *rb, void *data)
 			  "a tombstone cannot be set done");
 		elm->status = RING_BUFFER_ELM_STATUS_DONE;
 	} smp_wmb_tso();
+
+	/* a put combiner may sleep on this element */
+	_nap_wake_up_elm_waiters(rb, &rb->put_nap);
 }
 EXPORT_SYMBOL(ring_buffer_elm_set_done);
 
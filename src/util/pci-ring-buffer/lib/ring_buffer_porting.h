@@ -69,60 +69,6 @@ void *__rb_calloc(size_t nmemb, size_t size)
         return calloc(nmemb, size);
 }
 
-static inline
-int __rb_mutex_init(pthread_mutex_t *mutex)
-{
-	return pthread_mutex_init(mutex, NULL);
-}
-
-static inline
-int __rb_mutex_destroy(pthread_mutex_t *mutex)
-{
-	return pthread_mutex_destroy(mutex);
-}
-
-static inline
-int __rb_mutex_lock(pthread_mutex_t *mutex)
-{
-	return pthread_mutex_lock(mutex);
-}
-
-static inline
-int __rb_mutex_unlock(pthread_mutex_t *mutex)
-{
-	return pthread_mutex_unlock(mutex);
-}
-
-static inline
-int __rb_wait_init(pthread_cond_t *wait)
-{
-	return pthread_cond_init(wait, NULL);
-}
-
-static inline
-int __rb_wait_destroy(pthread_cond_t *wait)
-{
-	return pthread_cond_destroy(wait);
-}
-
-static inline
-int __rb_wait_wake_up(pthread_cond_t *wait)
-{
-	return pthread_cond_signal(wait);
-}
-
-static inline
-int __rb_wait_wake_up_all(pthread_cond_t *wait)
-{
-	return pthread_cond_broadcast(wait);
-}
-
-static inline
-int __rb_wait_sleep_on(pthread_cond_t *wait, pthread_mutex_t *mutex)
-{
-	return pthread_cond_wait(wait, mutex);
-}
-
 static inline
 void __rb_yield(void)
 {
@@ -568,7 +568,10 @@ int __ring_buffer_scif_create_shadow(
 	rbs->rb->head          = remote_rb->head;
 	rbs->rb->tail          = remote_rb->tail;
 	rbs->rb->tail2         = remote_rb->tail2;
+	rbs->rb->head_cache    = remote_rb->head;
+	rbs->rb->high_water    = 0;
 	rbs->rb->is_blocking   = remote_rb->is_blocking;
+	rbs->rb->is_spsc       = remote_rb->is_spsc;
 	rbs->rb->private_value = rbs;
 
 	/* init nap time */
@@ -685,6 +688,30 @@ int  ring_buffer_scif_get_nolock(struct ring_buffer_scif_t *rbs,
 }
 EXPORT_SYMBOL(ring_buffer_scif_get_nolock);
 
+int  ring_buffer_scif_put_batch(struct ring_buffer_scif_t *rbs,
+				struct ring_buffer_req_t *reqs, unsigned int n)
+{
+	/* sanity check */
+	if ( unlikely(rbs->scif[0].type != RING_BUFFER_SCIF_PRODUCER) )
+		return -EOPNOTSUPP;
+
+	/* ring buffer operation */
+	return ring_buffer_put_batch(rbs->rb, reqs, n);
+}
+EXPORT_SYMBOL(ring_buffer_scif_put_batch);
+
+int  ring_buffer_scif_get_batch(struct ring_buffer_scif_t *rbs,
+				struct ring_buffer_req_t *reqs, unsigned int n)
+{
+	/* sanity check */
+	if ( unlikely(rbs->scif[0].type != RING_BUFFER_SCIF_CONSUMER) )
+		return -EOPNOTSUPP;
+
+	/* ring buffer operation */
+	return ring_buffer_get_batch(rbs->rb, reqs, n);
+}
+EXPORT_SYMBOL(ring_buffer_scif_get_batch);
+
 void ring_buffer_scif_elm_set_ready(struct ring_buffer_scif_t *rbs,
 				    void *data)
 {
@@ -876,3 +903,15 @@ size_t ring_buffer_scif_free_space(struct ring_buffer_scif_t *rbs)
 	return ring_buffer_free_space(rbs->rb);
 }
 EXPORT_SYMBOL(ring_buffer_scif_free_space);
+
+size_t ring_buffer_scif_high_water(struct ring_buffer_scif_t *rbs)
+{
+	return ring_buffer_high_water(rbs->rb);
+}
+EXPORT_SYMBOL(ring_buffer_scif_high_water);
+
+void ring_buffer_scif_reset_high_water(struct ring_buffer_scif_t *rbs)
+{
+	ring_buffer_reset_high_water(rbs->rb);
+}
+EXPORT_SYMBOL(ring_buffer_scif_reset_high_water);